@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+'''
+This script solves Stokes and steady state heat problems with threaded and with
+serial assembly, and checks that the solutions agree. The Stokes viscosity is a
+material swarm variable, evaluated both via voronoi integration (which may be
+threaded) and via gauss integration (where the swarm is mapped to the gauss
+points, and the constitutive term must fall back to serial assembly). Set
+OMP_NUM_THREADS to choose the thread count.
+'''
+
+import numpy as np
+import underworld as uw
+from mpi4py import MPI
+from underworld import function as fn
+
+mesh = uw.mesh.FeMesh_Cartesian("Q1/dQ0", (16,16), (0.,0.), (1.,1.))
+swarm = uw.swarm.Swarm(mesh)
+swarm.populate_using_layout(uw.swarm.layouts.PerCellSpaceFillerLayout(swarm, particlesPerCell=12))
+material = swarm.add_variable("int", 1)
+coord = fn.input()
+material.data[:] = 0
+material.data[fn.math.dot(coord-(0.5,0.6), coord-(0.5,0.6)).evaluate(swarm) < 0.04] = 1
+viscosity = fn.branching.map(fn_key=material, mapping={0: 1., 1: 100.})
+density = fn.branching.map(fn_key=material, mapping={0: 0., 1: 1.})
+
+def solve_stokes(threaded, voronoi):
+    velocityField = uw.mesh.MeshVariable(mesh,2)
+    velocityField.data[:] = (0.,0.)
+    pressureField = uw.mesh.MeshVariable(mesh.subMesh,1)
+    pressureField.data[:] = 0.
+    walls = mesh.specialSets["AllWalls_VertexSet"]
+    conditions = uw.conditions.DirichletCondition(velocityField, (walls, walls))
+    stokesSystem = uw.systems.Stokes(velocityField, pressureField, viscosity, density*(0.,-1.),
+                                     voronoi_swarm=swarm if voronoi else None, conditions=conditions,
+                                     threaded_assembly=threaded)
+    uw.systems.Solver(stokesSystem).solve()
+    return velocityField.data.copy()
+
+def solve_heat(threaded):
+    temperatureField = uw.mesh.MeshVariable(mesh,1)
+    temperatureField.data[:] = 0.
+    top = mesh.specialSets["MaxJ_VertexSet"]
+    bottom = mesh.specialSets["MinJ_VertexSet"]
+    temperatureField.data[bottom.data] = 1.
+    conditions = uw.conditions.DirichletCondition(temperatureField, top + bottom)
+    heatSystem = uw.systems.SteadyStateHeat(temperatureField, fn_diffusivity=1.+coord[0]*coord[1],
+                                            fn_heating=fn.math.sin(3.*coord[0]), conditions=conditions,
+                                            threaded_assembly=threaded)
+    uw.systems.Solver(heatSystem).solve()
+    return temperatureField.data.copy()
+
+def check(name, serial, threaded):
+    vmax = uw.mpi.comm.allreduce(np.abs(serial).max(), op=MPI.MAX)
+    diff = uw.mpi.comm.allreduce(np.abs(serial - threaded).max(), op=MPI.MAX)
+    if diff > 1.0e-10*vmax:
+        raise RuntimeError("Threaded assembly {} solution differs from serial assembly solution. "
+                           "Max difference = {}, max value = {}.".format(name, diff, vmax))
+
+for voronoi in (True, False):
+    check("voronoi Stokes" if voronoi else "gauss Stokes", solve_stokes(False, voronoi), solve_stokes(True, voronoi))
+check("heat", solve_heat(False), solve_heat(True))
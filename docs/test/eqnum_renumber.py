@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+'''
+This script checks equation renumbering after boundary conditions change
+(`EqNumber.renumber()`). A steady state heat problem is solved, a wall is then added to
+its Dirichlet index set, and the equations are renumbered and the problem solved again.
+The solution must match that of a problem built with the final conditions from the start,
+both where conditions are removed from the system and where they are retained. In parallel,
+processes whose domains do not include the added wall only shift their equation numbers.
+The script runs serially, and then reruns itself on two processes.
+'''
+import sys
+import subprocess
+import numpy as np
+import underworld as uw
+from mpi4py import MPI
+from inspect import getsourcefile
+
+mesh = uw.mesh.FeMesh_Cartesian("Q1", (12,12), (0.,0.), (1.,1.))
+bottom = mesh.specialSets["MinJ_VertexSet"]
+left   = mesh.specialSets["MinI_VertexSet"]
+
+def set_values(temperatureField, walls):
+    temperatureField.data[walls.data,0] = 1. + mesh.data[walls.data,1]
+
+def build(walls, removeBCs):
+    temperatureField = mesh.add_variable(1)
+    temperatureField.data[:] = 0.
+    set_values(temperatureField, walls)
+    conditions = uw.conditions.DirichletCondition(temperatureField, walls)
+    heat = uw.systems.SteadyStateHeat(temperatureField, fn_diffusivity=1., fn_heating=1.,
+                                      conditions=conditions, _removeBCs=removeBCs)
+    return temperatureField, heat, uw.systems.Solver(heat)
+
+def check():
+    for removeBCs in (True, False):
+        walls = mesh.specialSets["MinJ_VertexSet"]
+        temperatureField, heat, solver = build(walls, removeBCs)
+        solver.solve()
+        walls += left
+        set_values(temperatureField, walls)
+        if not heat._tEqNums.renumber():
+            raise RuntimeError("Renumbering did not report a change of numbering after conditions were added.")
+        solver.solve()
+
+        freshField, _, freshSolver = build(bottom + left, removeBCs)
+        freshSolver.solve()
+
+        tmax = uw.mpi.comm.allreduce(np.abs(freshField.data).max(), op=MPI.MAX)
+        diff = uw.mpi.comm.allreduce(np.abs(temperatureField.data - freshField.data).max(), op=MPI.MAX)
+        if diff > 1.0e-10*tmax:
+            raise RuntimeError("Solution after renumbering (removeBCs={}) differs from that of a fresh build. "
+                               "Max difference = {}, max temperature = {}.".format(removeBCs, diff, tmax))
+
+if __name__ == '__main__':
+    check()
+    if len(sys.argv) == 1 and uw.mpi.size == 1:
+        result = subprocess.run("mpirun -np 2 {} {} parallel".format(sys.executable, getsourcefile(lambda:0)), shell=True)
+        if result.returncode != 0:
+            raise RuntimeError("Parallel renumbering check failed.")
@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+'''
+This script checks global point lookup and evaluation (`FeMesh.find_processes()`,
+`Function.evaluate_global()` and the sparse exchange they route points with) against
+analytic values. A linear field is evaluated at coordinates on the boundaries of every
+process's part of the mesh, at random interior coordinates and at coordinates outside the
+domain, with `gather` both True and False. The mesh is then stretched, so that the process
+directory must be rebuilt, and the evaluations repeated. The script runs serially, and then
+reruns itself on four processes.
+'''
+import sys
+import subprocess
+import numpy as np
+import underworld as uw
+from mpi4py import MPI
+from inspect import getsourcefile
+
+def analytic(coords, stretch):
+    return coords[:,0]/stretch + 2.*coords[:,1]
+
+def check_sparse_exchange():
+    rank, size = uw.mpi.rank, uw.mpi.size
+    dests = set([(rank+1)%size, (rank+3)%size])
+    sends = { dest: np.full(dest+1, 10.*rank + dest) for dest in dests }
+    received = uw.mpi._sparse_exchange(sends, tag=7401)
+    sources = set([ source for source in range(size) if rank in ((source+1)%size, (source+3)%size) ])
+    if set(received.keys()) != sources:
+        raise RuntimeError("Sparse exchange on process {} received from {}, expected {}.".format(
+                           rank, sorted(received.keys()), sorted(sources)))
+    for source, buf in received.items():
+        if not np.array_equal(buf, np.full(rank+1, 10.*source + rank)):
+            raise RuntimeError("Sparse exchange on process {} received incorrect values from {}.".format(rank, source))
+
+def boundary_coords(mesh):
+    # corners and edge midpoints of every process's bounding box of local nodes
+    local = mesh.data[:mesh.nodesLocal]
+    lo, hi = local.min(axis=0), local.max(axis=0)
+    coords = [ (x, y) for x in (lo[0], 0.5*(lo[0]+hi[0]), hi[0]) for y in (lo[1], 0.5*(lo[1]+hi[1]), hi[1]) ]
+    return np.concatenate(uw.mpi.comm.allgather(np.array(coords)))
+
+def check_find_processes(mesh, coords, outside):
+    procs = mesh.find_processes(np.concatenate((coords, outside)))
+    elements = np.empty(len(coords), dtype=np.int32)
+    uw.libUnderworld.StgDomain.Mesh_FindLocalElements(mesh._cself, np.ascontiguousarray(coords), elements)
+    owners = np.array(uw.mpi.comm.allgather(elements >= 0))
+    for ii in range(len(coords)):
+        if not set(np.nonzero(owners[:,ii])[0]).issubset(procs[ii]):
+            raise RuntimeError("Processes {} own coordinate {}, but only {} were found as candidates.".format(
+                               np.nonzero(owners[:,ii])[0].tolist(), coords[ii], procs[ii].tolist()))
+    if not (procs[len(coords):] == -1).all():
+        raise RuntimeError("Processes were found for coordinates outside the domain.")
+
+def check_evaluate(var, coords, outside, stretch):
+    allcoords = np.concatenate((coords, outside))
+    expected = np.concatenate((analytic(coords, stretch), np.zeros(len(outside))))
+
+    results = var.evaluate_global(allcoords, gather=True)
+    if uw.mpi.rank == 0:
+        if not np.allclose(results[:,0], expected):
+            raise RuntimeError("Gathered global evaluation differs from analytic values (stretch {}).".format(stretch))
+    elif results is not None:
+        raise RuntimeError("Gathered global evaluation returned results on a process other than the root.")
+
+    # each process evaluates its own coordinates, mostly held elsewhere
+    mine = np.random.RandomState(uw.mpi.rank).random_sample((100,2))*(stretch,1.)
+    mine = np.concatenate((mine, outside))
+    results = var.evaluate_global(mine, gather=False)
+    expected = np.concatenate((analytic(mine[:100], stretch), np.zeros(len(outside))))
+    if not np.allclose(results[:,0], expected):
+        raise RuntimeError("Global evaluation on process {} differs from analytic values (stretch {}).".format(uw.mpi.rank, stretch))
+
+def check():
+    check_sparse_exchange()
+    mesh = uw.mesh.FeMesh_Cartesian("Q1", (16,16), (0.,0.), (1.,1.))
+    var = mesh.add_variable(1)
+    var.data[:,0] = analytic(mesh.data, 1.)
+    outside = np.array([[-1.,0.5], [0.5,3.], [5.,5.]])
+
+    coords = boundary_coords(mesh)
+    check_find_processes(mesh, coords, outside)
+    check_evaluate(var, coords, outside, 1.)
+
+    # stretching moves every process's box, so stale directories give wrong owners
+    with mesh.deform_mesh():
+        mesh.data[:,0] *= 2.
+    coords = boundary_coords(mesh)
+    check_find_processes(mesh, coords, outside)
+    check_evaluate(var, coords, outside, 2.)
+
+if __name__ == '__main__':
+    check()
+    if len(sys.argv) == 1 and uw.mpi.size == 1:
+        result = subprocess.run("mpirun -np 4 {} {} parallel".format(sys.executable, getsourcefile(lambda:0)), shell=True)
+        if result.returncode != 0:
+            raise RuntimeError("Parallel global evaluation check failed.")
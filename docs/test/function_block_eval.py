@@ -0,0 +1,69 @@
+'''
+This script checks that batched function evaluation (as used for numpy, mesh
+and swarm inputs, and during assembly/integration) returns identical results
+to the expected point-wise values, in particular for `map` and `conditional`
+functions where inputs are grouped across branches.
+'''
+import underworld as uw
+import underworld.function as fn
+import numpy as np
+
+mesh = uw.mesh.FeMesh_Cartesian(elementRes=(8,8), minCoord=(0.,0.), maxCoord=(1.,1.))
+meshvar = uw.mesh.MeshVariable(mesh,1)
+meshvar.data[:,0] = mesh.data[:,0]*mesh.data[:,1]
+
+swarm = uw.swarm.Swarm(mesh)
+swarm.populate_using_layout(uw.swarm.layouts.PerCellGaussLayout(swarm,3))
+matvar = swarm.add_variable("int",1)
+matvar.data[:,0] = (4.*swarm.data[:,0]).astype(int)   # four materials, mixed within some elements
+dblvar = swarm.add_variable("double",1)
+dblvar.data[:,0] = swarm.data[:,1]
+
+coord = fn.input()
+# build up expression exercising binary, unary, constant, map and conditional ops
+fn_cond = fn.branching.conditional( [ ( coord[0] < 0.3, 2.*coord[1]        ),
+                                      ( coord[0] < 0.6, fn.math.exp(coord[0]) ),
+                                      ( True          , coord[0]**2.         ) ] )
+fn_map  = fn.branching.map( fn_key=matvar, mapping={ 0:1.*dblvar, 1:dblvar+1., 2:dblvar*dblvar }, fn_default=fn.misc.constant(-1.) )
+
+def expected_cond(x):
+    return np.where( x[:,0]<0.3, 2.*x[:,1], np.where( x[:,0]<0.6, np.exp(x[:,0]), x[:,0]**2 ) )
+
+# numpy input, larger than the batch size to check block boundaries
+arr = np.random.RandomState(0).rand(1001,2)
+result = (fn_cond*meshvar).evaluate(arr)[:,0]
+if not np.allclose( result, expected_cond(arr)*arr[:,0]*arr[:,1] ):
+    raise RuntimeError("Batched evaluation of conditional function on numpy input does not return expected results.")
+
+# swarm input
+coords = swarm.data
+mat = matvar.data[:,0]
+dbl = dblvar.data[:,0]
+expected_map = np.select( [mat==0, mat==1, mat==2], [dbl, dbl+1., dbl*dbl], default=-1. )
+if not np.allclose( fn_map.evaluate(swarm)[:,0], expected_map ):
+    raise RuntimeError("Batched evaluation of map function on swarm input does not return expected results.")
+
+# integration, where the map is evaluated per element block. The material particles sit at
+# the 3x3 Gauss points used for integration, so the integral is the Gauss quadrature sum of
+# the map evaluated point by point at the particles.
+integral = uw.utils.Integral( fn_map, mesh ).evaluate()[0]
+h = 1./8.
+xi = 2.*np.mod(coords,h)/h - 1.
+weights = np.prod( np.where( np.abs(xi)<1.e-6, 8./9., 5./9. ), axis=1 )
+pointwise = np.array( [ fn_map.evaluate(coords[i:i+1])[0,0] for i in range(len(coords)) ] )
+expect = uw.mpi.comm.allreduce( np.sum( weights*pointwise )*(h/2.)**2 )
+if not np.isclose( integral, expect ):
+    raise RuntimeError("Integral of mapped function ({}) does not match point-wise quadrature ({}).".format(integral, expect))
+
+# compiled evaluation, where the constant is folded into the compiled program
+# and so the program must be rebuilt when its value is modified.
+const = fn.misc.constant(2.)
+fn_expr = const*meshvar + fn.math.sqrt(const*meshvar)
+integrator = uw.utils.Integral( fn_expr, mesh )
+first = integrator.evaluate()[0]
+const.value = 0.
+if not np.isclose( integrator.evaluate()[0], 0. ):
+    raise RuntimeError("Compiled function does not appear to reflect modified constant value.")
+const.value = 2.
+if not np.isclose( integrator.evaluate()[0], first ):
+    raise RuntimeError("Compiled function does not return consistent result after constant modification.")
@@ -0,0 +1,54 @@
+#!/usr/bin/env python3
+'''
+This script checks the per type accounting of native memory (see uw.utils.memory_info).
+The totals must equal the sums across types, peaks must bound current usage, memory
+recorded for a mesh and swarm must be released when they are deleted, and allocations
+made while accounting is disabled must not be recorded.
+'''
+
+import gc
+import underworld as uw
+
+def check_totals(info):
+    if info["current"] != sum(item[1] for item in info["types"]):
+        raise RuntimeError("Total current bytes ({}) differ from the sum across types.".format(info["current"]))
+    if info["peak"] < info["current"]:
+        raise RuntimeError("Total peak bytes are less than current bytes.")
+    for name, current, peak, count in info["types"]:
+        if peak < current or count == 0:
+            raise RuntimeError("Inconsistent accounting for type '{}': current {}, peak {}, "
+                               "allocations {}.".format(name, current, peak, count))
+
+uw.utils.memory_accounting(True)
+before = uw.utils.memory_info(top=None)
+check_totals(before)
+
+# the swarm is grown by reallocation as it is populated
+mesh = uw.mesh.FeMesh_Cartesian(elementRes=(16,16))
+swarm = uw.swarm.Swarm(mesh)
+swarm.populate_using_layout(uw.swarm.layouts.PerCellSpaceFillerLayout(swarm, particlesPerCell=20))
+during = uw.utils.memory_info(top=None)
+check_totals(during)
+if during["current"] <= before["current"]:
+    raise RuntimeError("No memory was recorded for the mesh and swarm.")
+if len(uw.utils.memory_info(top=3)["types"]) > 3:
+    raise RuntimeError("More types were reported than requested.")
+
+del swarm, mesh
+gc.collect()
+after = uw.utils.memory_info(top=None, reset_peaks=True)
+check_totals(after)
+if after["current"] >= during["current"]:
+    raise RuntimeError("Memory recorded for the mesh and swarm was not released on deletion.")
+
+reset = uw.utils.memory_info(top=None)
+if reset["peak"] != reset["current"]:
+    raise RuntimeError("Peak bytes ({}) were not reset to current bytes ({}).".format(reset["peak"], reset["current"]))
+
+# allocations made while disabled are not recorded
+uw.utils.memory_accounting(False)
+if uw.utils.memory_info()["enabled"]:
+    raise RuntimeError("Accounting was not disabled.")
+mesh = uw.mesh.FeMesh_Cartesian(elementRes=(16,16))
+if uw.utils.memory_info()["current"] > reset["current"]:
+    raise RuntimeError("Allocations were recorded while accounting was disabled.")
@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+'''
+This script rebalances a mesh whose particles are clustered in one corner of the
+domain. A balanced decomposition is computed from the particle-weighted element
+costs, a new mesh and swarm are built with it, and mesh and swarm data are moved
+across. The data is checked to be unchanged, the global element and node counts
+preserved, and the per-process load imbalance measured on the new mesh is checked
+against that predicted, and to have dropped. The imbalance is reported. Serially
+there is nothing to balance, so the script reruns itself on two and four processes.
+'''
+import sys
+import subprocess
+import numpy as np
+import underworld as uw
+from mpi4py import MPI
+from inspect import getsourcefile
+
+def imbalance(mesh, swarm):
+    # measured from the costs of each process's own elements
+    rankCosts = np.array(uw.mpi.comm.allgather(mesh.element_costs(swarm).sum()))
+    return rankCosts.max()/rankCosts.mean()
+
+def check():
+    res = (16,16)
+    mesh = uw.mesh.FeMesh_Cartesian("Q1/dQ0", res, (0.,0.), (1.,1.))
+    with mesh.deform_mesh():
+        mesh.data[:,1] += 0.01*np.sin(np.pi*mesh.data[:,0])
+    temperature = mesh.add_variable(1)
+    temperature.data[:,0] = mesh.data[:,0] + 2.*mesh.data[:,1]
+    pressure = mesh.subMesh.add_variable(1)
+    pressure.data[:,0] = mesh.subMesh.data_nodegId
+
+    # a swarm with a heavy cluster of particles in the bottom left quarter
+    swarm = uw.swarm.Swarm(mesh)
+    swarm.populate_using_layout(uw.swarm.layouts.PerCellGaussLayout(swarm,2))
+    cluster = np.random.RandomState(uw.mpi.rank).uniform(0.,0.5,size=(2000,2))
+    cluster[:,1] *= 0.9
+    swarm.add_particles_with_coordinates(cluster)
+    material = swarm.add_variable("double",1)
+    material.data[:,0] = swarm.particleCoordinates.data[:,0]*swarm.particleCoordinates.data[:,1]
+
+    costs = mesh.element_costs(swarm)
+    decomposition, info = mesh.balanced_decomposition(costs)
+    if info["imbalance_after"] > info["imbalance_before"] + 1.0e-12:
+        raise RuntimeError("Balanced decomposition predicts a worse imbalance than the current one.")
+    if abs(imbalance(mesh, swarm) - info["imbalance_before"]) > 1.0e-10:
+        raise RuntimeError("Reported imbalance differs from that measured on the current mesh.")
+
+    newMesh = uw.mesh.FeMesh_Cartesian("Q1/dQ0", res, (0.,0.), (1.,1.), decomposition=decomposition)
+    if newMesh.decomposition != decomposition or newMesh._current_decomposition() != decomposition:
+        raise RuntimeError("New mesh does not use the requested decomposition.")
+    for before, after in ((mesh, newMesh), (mesh.subMesh, newMesh.subMesh)):
+        elements = uw.mpi.comm.allreduce(after.elementsLocal, op=MPI.SUM)
+        nodes    = uw.mpi.comm.allreduce(after.nodesLocal, op=MPI.SUM)
+        if (after.elementsGlobal, after.nodesGlobal, elements, nodes) != (before.elementsGlobal, before.nodesGlobal)*2:
+            raise RuntimeError("Rebalanced mesh has {} elements and {} nodes ({} and {} locally owned), expected "
+                               "{} and {}.".format(after.elementsGlobal, after.nodesGlobal, elements, nodes,
+                                                   before.elementsGlobal, before.nodesGlobal))
+    uw.utils.redistribute_meshvariable(mesh, newMesh)
+    newTemperature = newMesh.add_variable(1)
+    uw.utils.redistribute_meshvariable(temperature, newTemperature)
+    newPressure = newMesh.subMesh.add_variable(1)
+    uw.utils.redistribute_meshvariable(pressure, newPressure)
+
+    if not np.allclose(newTemperature.data[:,0], newMesh.data[:,0] + 2.*newMesh.data[:,1]):
+        raise RuntimeError("Mesh variable values changed during redistribution.")
+    if not np.allclose(newPressure.data[:,0], newMesh.subMesh.data_nodegId):
+        raise RuntimeError("Sub-mesh variable values changed during redistribution.")
+
+    newSwarm = uw.swarm.Swarm(newMesh)
+    newMaterial = newSwarm.add_variable("double",1)
+    lost = uw.utils.redistribute_swarm(swarm, newSwarm, [(material,newMaterial),])
+    if lost != 0:
+        raise RuntimeError("{} particles were lost during redistribution.".format(lost))
+    total    = uw.mpi.comm.allreduce(swarm.particleLocalCount, op=MPI.SUM)
+    newTotal = uw.mpi.comm.allreduce(newSwarm.particleLocalCount, op=MPI.SUM)
+    if total != newTotal:
+        raise RuntimeError("Particle count changed during redistribution ({} -> {}).".format(total,newTotal))
+    coords = newSwarm.particleCoordinates.data
+    if not np.allclose(newMaterial.data[:,0], coords[:,0]*coords[:,1]):
+        raise RuntimeError("Swarm variable values changed during redistribution.")
+
+    measured = imbalance(newMesh, newSwarm)
+    if uw.mpi.rank == 0:
+        print("{} processes, decomposition {}, imbalance {:.3f} -> {:.3f} (predicted {:.3f})".format(
+              uw.mpi.size, decomposition, info["imbalance_before"], measured, info["imbalance_after"]))
+    if abs(measured - info["imbalance_after"]) > 0.01*info["imbalance_after"]:
+        raise RuntimeError("Measured imbalance {} differs from the predicted {}.".format(measured, info["imbalance_after"]))
+    if uw.mpi.size > 1 and not measured < info["imbalance_before"]:
+        raise RuntimeError("Rebalancing did not reduce the imbalance ({} -> {}).".format(info["imbalance_before"], measured))
+
+if __name__ == '__main__':
+    check()
+    if len(sys.argv) == 1 and uw.mpi.size == 1:
+        for nprocs in (2, 4):
+            result = subprocess.run("mpirun -np {} {} {} parallel".format(nprocs, sys.executable, getsourcefile(lambda:0)), shell=True)
+            if result.returncode != 0:
+                raise RuntimeError("Parallel rebalancing check failed on {} processes.".format(nprocs))
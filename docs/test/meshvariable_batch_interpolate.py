@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+'''
+This script checks that batched mesh variable interpolation (FeVariable_InterpolateValuesAt,
+used when a mesh variable is evaluated at an array of coordinates) returns identical results
+to point-wise interpolation (_FeVariable_InterpolateValueAt, used where the mesh variable is
+wrapped by a function without a batched path, such as SafeMaths). Coordinates span the entire
+domain on each process, so that some lie outside the local domain. The script runs serially,
+and then reruns itself on two processes.
+'''
+import sys
+import subprocess
+import numpy as np
+import underworld as uw
+import underworld.function as fn
+from inspect import getsourcefile
+
+def check():
+    mesh = uw.mesh.FeMesh_Cartesian("Q2/dPc1", (8,8), (0.,0.), (1.,1.))
+    # deform the mesh, so that elements are found by search rather than by their regular layout
+    with mesh.deform_mesh():
+        mesh.data[:,1] += 0.03*np.sin(np.pi*mesh.data[:,0])*np.sin(np.pi*mesh.data[:,1])
+    meshvar = mesh.add_variable(2)
+    meshvar.data[:,0] = np.cos(3.*mesh.data[:,0])*mesh.data[:,1]
+    meshvar.data[:,1] = mesh.data[:,0]**3
+
+    coords = np.random.RandomState(1).rand(1200,2)
+    pointwise_fn = fn.exception.SafeMaths(meshvar)
+
+    # point-wise interpolation, recording which coordinates are found locally
+    found = np.zeros(len(coords), dtype=bool)
+    pointwise = np.zeros((len(coords),2))
+    for i in range(len(coords)):
+        try:
+            pointwise[i] = pointwise_fn.evaluate(coords[i:i+1])[0]
+            found[i] = True
+        except Exception:
+            pass
+
+    # batched interpolation over all found coordinates
+    batched = meshvar.evaluate(coords[found])
+    if not np.allclose(batched, pointwise[found], rtol=1.e-12, atol=1.e-14):
+        diff = np.abs(batched - pointwise[found]).max()
+        raise RuntimeError("Batched interpolation differs from point-wise interpolation. Max difference = {}.".format(diff))
+
+    # batches including coordinates outside the local domain must fail as the point-wise path does
+    for i in np.nonzero(~found)[0][:10]:
+        try:
+            meshvar.evaluate(np.concatenate((coords[found][:5], coords[i:i+1], coords[found][5:10])))
+        except Exception:
+            continue
+        raise RuntimeError("Batched interpolation did not fail for coordinate {}, which point-wise interpolation "
+                           "did not find locally.".format(coords[i]))
+
+    if uw.mpi.size > 1 and np.all(found):
+        raise RuntimeError("Expected some coordinates to lie outside the local domain.")
+
+if __name__ == '__main__':
+    check()
+    if len(sys.argv) == 1 and uw.mpi.size == 1:
+        result = subprocess.run("mpirun -np 2 {} {} parallel".format(sys.executable, getsourcefile(lambda:0)), shell=True)
+        if result.returncode != 0:
+            raise RuntimeError("Parallel batched interpolation check failed.")
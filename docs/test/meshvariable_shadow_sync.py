@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+'''
+This script checks the shadow value syncs of mesh variables, which reuse cached
+exchange plans and have every component of a variable in flight together
+(Sync_SyncArrayBegin/Sync_SyncArrayEnd). Local node values are set from the node
+coordinates and shadow values are cleared, and after syncing the shadow values must
+equal those set by their owning processes. Syncs are repeated, so that the cached
+plans are reused, for variables of one and of three components. The time per sync
+is reported along with the range of neighbour counts over processes. The script
+reruns itself on two, three and four processes, so that the decompositions give
+differing numbers of neighbours.
+'''
+import sys
+import time
+import subprocess
+import numpy as np
+import underworld as uw
+from mpi4py import MPI
+from inspect import getsourcefile
+
+def expected(coords, ncomps):
+    return np.stack([coords[:,0] + 10.*coords[:,1] + 100.*comp for comp in range(ncomps)], axis=1)
+
+def check():
+    mesh = uw.mesh.FeMesh_Cartesian("Q2/dPc1", (16,16), (0.,0.), (1.,1.))
+    nLocal = mesh.nodesLocal
+    StgDomain = uw.libUnderworld.StgDomain
+    nbrs = uw.mpi.comm.allgather(StgDomain.Mesh_GetNumNeighbours(mesh._cself, StgDomain.MT_VERTEX))
+    for ncomps in (1, 3):
+        meshvar = mesh.add_variable(ncomps)
+        values = expected(mesh.data, ncomps)
+        for rep in range(3):
+            meshvar.data[:nLocal] = values[:nLocal]
+            meshvar.data[nLocal:] = -1.
+            meshvar.syncronise()
+            if not np.array_equal(meshvar.data, values):
+                raise RuntimeError("Synced shadow values of {} component variable differ from owned values "
+                                   "on sync {}.".format(ncomps, rep))
+
+        meshvar.data[nLocal:] = -1.
+        count = 100
+        uw.mpi.barrier()
+        start = time.time()
+        for rep in range(count):
+            meshvar.syncronise()
+        spent = uw.mpi.comm.allreduce(time.time() - start, op=MPI.MAX)
+        if uw.mpi.rank == 0:
+            print("Shadow sync, {} components, {} processes, {}-{} neighbours: {:.4g} us/sync".format(
+                  ncomps, uw.mpi.size, min(nbrs), max(nbrs), 1.e6*spent/count))
+        if not np.array_equal(meshvar.data, values):
+            raise RuntimeError("Repeated syncs of {} component variable give incorrect shadow values.".format(ncomps))
+
+if __name__ == '__main__':
+    check()
+    if len(sys.argv) == 1 and uw.mpi.size == 1:
+        for nprocs in (2, 3, 4):
+            result = subprocess.run("mpirun -np {} {} {} parallel".format(nprocs, sys.executable, getsourcefile(lambda:0)), shell=True)
+            if result.returncode != 0:
+                raise RuntimeError("Parallel shadow sync check failed on {} processes.".format(nprocs))
@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+'''
+This script solves the same 3D Stokes problem with assembled and with matrix-free
+velocity operators, and checks that the two agree. Wall time and peak memory of each
+solve are reported. Set UW_RESOLUTION to change the problem size.
+'''
+
+import os
+import time
+import resource
+import numpy as np
+import underworld as uw
+from mpi4py import MPI
+from underworld import function as fn
+
+res = int(os.environ.get("UW_RESOLUTION", 8))
+
+def solve(matrix_free):
+    mesh = uw.mesh.FeMesh_Cartesian("Q1/dQ0", (res,res,res), (0.,0.,0.), (1.,1.,1.))
+    velocityField = uw.mesh.MeshVariable(mesh,3)
+    velocityField.data[:] = (0.,0.,0.)
+    pressureField = uw.mesh.MeshVariable(mesh.subMesh,1)
+    pressureField.data[:] = 0.
+
+    # freeslip
+    IWalls = mesh.specialSets["MinI_VertexSet"] + mesh.specialSets["MaxI_VertexSet"]
+    JWalls = mesh.specialSets["MinJ_VertexSet"] + mesh.specialSets["MaxJ_VertexSet"]
+    KWalls = mesh.specialSets["MinK_VertexSet"] + mesh.specialSets["MaxK_VertexSet"]
+    freeslip = uw.conditions.DirichletCondition(velocityField, (IWalls, JWalls, KWalls))
+
+    # a buoyant blob in a layered viscosity
+    coord = fn.input()
+    density = fn.math.exp(-20.*fn.math.dot(coord-(0.5,0.5,0.3), coord-(0.5,0.5,0.3)))
+    viscosity = fn.branching.conditional([(coord[2] > 0.5, 10.), (True, 1.)])
+    stokesSystem = uw.systems.Stokes(velocityField, pressureField, viscosity, (0.,0.,1.)*density,
+                                     conditions=[freeslip,], matrix_free=matrix_free)
+    solver = uw.systems.Solver(stokesSystem)
+
+    start = time.time()
+    solver.solve()
+    walltime = uw.mpi.comm.allreduce(time.time() - start, op=MPI.MAX)
+    # ru_maxrss is the peak for the process so far, so this is only meaningful for the first solve
+    maxrss = uw.mpi.comm.allreduce(resource.getrusage(resource.RUSAGE_SELF).ru_maxrss, op=MPI.MAX)
+    if uw.mpi.rank == 0:
+        print("matrix_free={}: solve took {:.3f}s, peak memory {} kB".format(matrix_free, walltime, maxrss))
+    return velocityField.data.copy()
+
+# do the matrix-free solve first, so the peak memory it reports is its own
+matrixfree = solve(True)
+assembled  = solve(False)
+
+vmax = uw.mpi.comm.allreduce(np.abs(assembled).max(), op=MPI.MAX)
+diff = uw.mpi.comm.allreduce(np.abs(assembled - matrixfree).max(), op=MPI.MAX)
+if diff > 1.0e-4*vmax:
+    raise RuntimeError("Matrix-free velocity differs from assembled velocity. Max difference = {}, max velocity = {}.".format(diff, vmax))
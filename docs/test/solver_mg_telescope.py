@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+'''
+This script compares multigrid solves with and without coarse level telescoping
+(`solver.options.mg.telescope_rows`), for a sinker with a 10^6 viscosity contrast.
+Telescoping only moves the coarse levels onto fewer processes, so the solves must take
+the same number of velocity iterations (to within one), and give the same velocity.
+Iterations and wall time of each solve are reported. Serially there is nothing to
+telescope, so the script reruns itself on four processes.
+'''
+import sys
+import subprocess
+import numpy as np
+import underworld as uw
+from mpi4py import MPI
+from underworld import function as fn
+from inspect import getsourcefile
+
+def solve(telescope_rows):
+    mesh = uw.mesh.FeMesh_Cartesian("Q1/dQ0", (64,64), (0.,0.), (1.,1.))
+    velocityField = uw.mesh.MeshVariable(mesh,2)
+    velocityField.data[:] = (0.,0.)
+    pressureField = uw.mesh.MeshVariable(mesh.subMesh,1)
+    pressureField.data[:] = 0.
+
+    swarm = uw.swarm.Swarm(mesh)
+    swarm.populate_using_layout(uw.swarm.layouts.PerCellSpaceFillerLayout(swarm, particlesPerCell=20))
+    material = swarm.add_variable("int", 1)
+    coord = fn.input()
+    material.data[:] = 0
+    material.data[fn.math.dot(coord-(0.5,0.6), coord-(0.5,0.6)).evaluate(swarm) < 0.01] = 1
+
+    viscosity = fn.branching.map(fn_key=material, mapping={0: 1., 1: 1.0e6})
+    density = fn.branching.map(fn_key=material, mapping={0: 0., 1: 1.})
+    walls = mesh.specialSets["AllWalls_VertexSet"]
+    conditions = uw.conditions.DirichletCondition(velocityField, (walls, walls))
+    stokesSystem = uw.systems.Stokes(velocityField, pressureField, viscosity, density*(0.,-1.),
+                                     voronoi_swarm=swarm, conditions=conditions)
+    solver = uw.systems.Solver(stokesSystem)
+    solver.options.mg.telescope_rows = telescope_rows
+
+    walltime = MPI.Wtime()
+    solver.solve()
+    walltime = uw.mpi.comm.allreduce(MPI.Wtime() - walltime, op=MPI.MAX)
+    its = solver._cself.stats.velocity_total_its
+    if uw.mpi.rank == 0:
+        print("Telescope rows {}, {} processes: {} velocity iterations, {:.3f}s".format(
+              telescope_rows, uw.mpi.size, its, walltime))
+    return velocityField.data.copy(), its
+
+def check():
+    plain, plainIts = solve(0)
+    telescoped, telescopedIts = solve(400)
+    if abs(telescopedIts - plainIts) > 1:
+        raise RuntimeError("Telescoped multigrid took {} velocity iterations, but multigrid without telescoping "
+                           "took {}.".format(telescopedIts, plainIts))
+    vmax = uw.mpi.comm.allreduce(np.abs(plain).max(), op=MPI.MAX)
+    diff = uw.mpi.comm.allreduce(np.abs(plain - telescoped).max(), op=MPI.MAX)
+    if diff > 1.0e-6*vmax:
+        raise RuntimeError("Telescoped multigrid velocity differs from that without telescoping. "
+                           "Max difference = {}, max velocity = {}.".format(diff, vmax))
+
+if __name__ == '__main__':
+    if len(sys.argv) == 1 and uw.mpi.size == 1:
+        result = subprocess.run("mpirun -np 4 {} {} parallel".format(sys.executable, getsourcefile(lambda:0)), shell=True)
+        if result.returncode != 0:
+            raise RuntimeError("Parallel telescoped multigrid check failed.")
+    else:
+        check()
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+'''
+This script solves the same yielding Stokes problem with plain Picard iterations and
+with Anderson accelerated iterations, and checks that both converge to the same
+velocity, and that acceleration reduces the number of non linear iterations (as
+reported by `get_nonLinearStats()`). Non linear iterations and wall time of each solve
+are reported.
+'''
+
+import numpy as np
+import underworld as uw
+from mpi4py import MPI
+from underworld import function as fn
+
+def solve(depth):
+    mesh = uw.mesh.FeMesh_Cartesian("Q1/dQ0", (32,16), (0.,0.), (2.,1.))
+    velocityField = uw.mesh.MeshVariable(mesh,2)
+    velocityField.data[:] = (0.,0.)
+    pressureField = uw.mesh.MeshVariable(mesh.subMesh,1)
+    pressureField.data[:] = 0.
+
+    # shortening, with a free slip base
+    coord = fn.input()
+    IWalls = mesh.specialSets["MinI_VertexSet"] + mesh.specialSets["MaxI_VertexSet"]
+    JWalls = mesh.specialSets["MinJ_VertexSet"]
+    velocityField.data[mesh.specialSets["MinI_VertexSet"].data,0] =  1.
+    velocityField.data[mesh.specialSets["MaxI_VertexSet"].data,0] = -1.
+    conditions = uw.conditions.DirichletCondition(velocityField, (IWalls, JWalls))
+
+    # a weak inclusion within a yielding layer
+    strainRate = fn.tensor.second_invariant(fn.tensor.symmetric(velocityField.fn_gradient))
+    weak = fn.math.dot(coord-(1.,0.), coord-(1.,0.)) < 0.01
+    viscosity = fn.branching.conditional([(weak, 0.01),
+                                          (True, fn.misc.min(100., 1./(2.*(strainRate + 1.0e-12))))])
+    stokesSystem = uw.systems.Stokes(velocityField, pressureField, viscosity, (0.,-1.), conditions=conditions)
+    solver = uw.systems.Solver(stokesSystem)
+
+    maxIterations = 200
+    solver.solve(nonLinearIterate=True, nonLinearTolerance=1.0e-4, nonLinearMaxIterations=maxIterations,
+                 nonLinearAndersonDepth=depth)
+    stats = solver.get_nonLinearStats()
+    if stats.anderson_depth != depth:
+        raise RuntimeError("Solve recorded Anderson depth {}, but depth {} was requested.".format(stats.anderson_depth, depth))
+    if stats.picard_iterations >= maxIterations:
+        raise RuntimeError("Solve with Anderson depth {} did not converge within {} iterations.".format(depth, maxIterations))
+    walltime = uw.mpi.comm.allreduce(stats.picard_walltime, op=MPI.MAX)
+    if uw.mpi.rank == 0:
+        print("anderson depth {}: {} iterations, {:.3f}s, {} restarts".format(depth, stats.picard_iterations,
+                                                                              walltime, stats.anderson_restarts))
+    return velocityField.data.copy(), stats.picard_iterations, walltime
+
+picard, picardIts, picardTime = solve(0)
+anderson, andersonIts, andersonTime = solve(5)
+
+if uw.mpi.rank == 0:
+    print("Anderson acceleration saved {} iterations and {:.3f}s".format(picardIts - andersonIts, picardTime - andersonTime))
+
+if andersonIts >= picardIts:
+    raise RuntimeError("Anderson acceleration did not reduce the non linear iterations ({} accelerated, {} Picard).".format(andersonIts, picardIts))
+
+vmax = uw.mpi.comm.allreduce(np.abs(picard).max(), op=MPI.MAX)
+diff = uw.mpi.comm.allreduce(np.abs(picard - anderson).max(), op=MPI.MAX)
+if diff > 1.0e-2*vmax:
+    raise RuntimeError("Accelerated velocity differs from Picard velocity. Max difference = {}, max velocity = {}.".format(diff, vmax))
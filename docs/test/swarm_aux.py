@@ -90,6 +90,102 @@ def swarm_save_load(swarmtype):
         os.remove( "saved_swarm_variable3.h5" )
 
 
+def swarm_contiguous_variables():
+    '''
+    This test checks that contiguously stored swarm variables remain in sync with the
+    particle data as particles are migrated, deleted and shadowed.
+    '''
+    mesh = uw.mesh.FeMesh_Cartesian( elementType='Q1/dQ0', elementRes=(16,16), minCoord=(0.,0.), maxCoord=(1.,1.) )
+    swarm = uw.swarm.Swarm(mesh, particleEscape=True)
+    svar  = swarm.add_variable("double",2)
+    cvar1 = swarm.add_variable("double",2,contiguous=True)
+    cvar2 = swarm.add_variable("int",1,contiguous=True)
+    swarm.populate_using_layout(uw.swarm.layouts.PerCellGaussLayout(swarm,2))
+    # also add one after population
+    cvar3 = swarm.add_variable("float",1,contiguous=True)
+
+    svar.data[:]      = swarm.particleCoordinates.data[:]
+    cvar1.data[:]     = swarm.particleCoordinates.data[:]
+    cvar2.data[:,0]   = (1000.*swarm.particleCoordinates.data[:,0]).astype(int)
+    cvar3.data[:,0]   = swarm.particleCoordinates.data[:,1]
+
+    # shift particles across cells (and processors), with some leaving the domain
+    with swarm.deform_swarm():
+        swarm.particleCoordinates.data[:,0] += 0.3
+
+    def check(svardata, cvar1data, cvar2data, cvar3data):
+        if not np.allclose(svardata, cvar1data):
+            raise RuntimeError("Contiguous variable data does not appear to have followed its particles.")
+        if not np.allclose(cvar2data[:,0], (1000.*svardata[:,0]).astype(int)):
+            raise RuntimeError("Contiguous int variable data does not appear to have followed its particles.")
+        if not np.allclose(cvar3data[:,0], svardata[:,1], rtol=1e-6):
+            raise RuntimeError("Contiguous float variable data does not appear to have followed its particles.")
+
+    check(svar.data, cvar1.data, cvar2.data, cvar3.data)
+    swarm.shadow_particles_fetch()
+    check(svar.data_shadow, cvar1.data_shadow, cvar2.data_shadow, cvar3.data_shadow)
+
+def swarm_nearest_particles():
+    '''
+    This test checks nearest particle and radius queries against a brute force search as the
+    swarm is deformed, and reports the cost of incremental index updates against full rebuilds.
+    '''
+    import time
+    mesh = uw.mesh.FeMesh_Cartesian( elementType='Q1/dQ0', elementRes=(32,32), minCoord=(0.,0.), maxCoord=(1.,1.) )
+    swarm = uw.swarm.Swarm(mesh, particleEscape=True)
+    swarm.populate_using_layout(uw.swarm.layouts.PerCellSpaceFillerLayout(swarm,20))
+    queries = np.random.RandomState(0).random_sample((200,2))*1.2 - 0.1
+
+    def check():
+        indices, distances = swarm.nearest_particles(queries, k=3)
+        found = swarm.particles_within_radius(queries, 0.02)
+        for ii, query in enumerate(queries):
+            brute = np.sqrt(((swarm.data - query)**2).sum(axis=1))
+            if not np.allclose(distances[ii], np.sort(brute)[:3]):
+                raise RuntimeError("Nearest particle query does not match brute force search.")
+            if not np.allclose(brute[indices[ii]], distances[ii]):
+                raise RuntimeError("Nearest particle indices do not match returned distances.")
+            if set(found[ii]) != set(np.where(brute <= 0.02)[0]):
+                raise RuntimeError("Radius query does not match brute force search.")
+
+    check()
+    for step in range(3):
+        with swarm.deform_swarm():
+            swarm.data[:] += 0.01*np.sin(4.*np.pi*swarm.data[:,::-1])
+        check()
+
+    # compare the cost of bringing the index up to date against rebuilding it
+    with swarm.deform_swarm():
+        swarm.data[:] += 0.002
+    ts = time.time()
+    uw.libUnderworld.PICellerator.GeneralSwarm_UpdateIndex(swarm._cself)
+    update_time = time.time() - ts
+    ts = time.time()
+    uw.libUnderworld.PICellerator.GeneralSwarm_RebuildIndex(swarm._cself)
+    rebuild_time = time.time() - ts
+    check()
+    if uw.mpi.rank == 0:
+        print("Particle index: incremental update {:.3e}s, full rebuild {:.3e}s".format(update_time, rebuild_time))
+
+def swarm_nearest_particles_flat():
+    '''
+    This test checks nearest particle queries of a nearly flat 3D swarm, whose thin direction
+    must not shrink the index bins of the others into more bins than there are particles.
+    '''
+    mesh = uw.mesh.FeMesh_Cartesian( elementType='Q1/dQ0', elementRes=(8,8,8), minCoord=(0.,0.,0.), maxCoord=(1.,1.,1.) )
+    swarm = uw.swarm.Swarm(mesh)
+    coords = np.random.RandomState(1).random_sample((20000,3))
+    coords[:,2] = 0.5 + 1.e-9*coords[:,2]
+    swarm.add_particles_with_coordinates(coords)
+    queries = np.random.RandomState(2).random_sample((50,3))
+    queries[:,2] = 0.5
+
+    indices, distances = swarm.nearest_particles(queries, k=2)
+    for ii, query in enumerate(queries):
+        brute = np.sqrt(((swarm.data - query)**2).sum(axis=1))
+        if not np.allclose(distances[ii], np.sort(brute)[:2]):
+            raise RuntimeError("Nearest particle query of flat swarm does not match brute force search.")
+
 if __name__ == '__main__':
     import underworld as uw
     uw.utils._io.PATTERN=1 # sequential
@@ -98,3 +194,6 @@ if __name__ == '__main__':
     uw.utils._io.PATTERN=2 # collective
     swarm_save_load('global')
     swarm_save_load('passivetracer')
+    swarm_contiguous_variables()
+    swarm_nearest_particles()
+    swarm_nearest_particles_flat()
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+'''
+This script checks that a swarm checkpoint (Swarm.save_checkpoint()) may be restarted on
+a different number of processes than it was saved with. A swarm is saved serially and
+reloaded on two processes, and then saved on two processes and reloaded serially. The
+particles occupy only a corner of the domain, so that when run in parallel one process
+reads no blocks of particles at all, but must still take part in the collective reads.
+Small blocks are used, so that processes read differing numbers of blocks.
+'''
+import os
+import sys
+import subprocess
+import numpy as np
+import underworld as uw
+from inspect import getsourcefile
+
+serialfile   = os.path.abspath("swarm_checkpoint_restart_serial.h5")
+parallelfile = os.path.abspath("swarm_checkpoint_restart_parallel.h5")
+count = 2000
+
+def build():
+    mesh = uw.mesh.FeMesh_Cartesian("Q1/dQ0", (16,16), (0.,0.), (1.,1.))
+    swarm = uw.swarm.Swarm(mesh)
+    dblvar = swarm.add_variable("double", 2)
+    intvar = swarm.add_variable("int", 1)
+    return swarm, dblvar, intvar
+
+def fill(swarm, dblvar, intvar):
+    coords = 0.3*np.random.RandomState(2).rand(count,2)
+    swarm.add_particles_with_coordinates(coords)
+    set_values(swarm, dblvar, intvar)
+
+def set_values(swarm, dblvar, intvar):
+    coords = swarm.data
+    dblvar.data[:,0] = coords[:,0] + 2.*coords[:,1]
+    dblvar.data[:,1] = np.sin(coords[:,0])
+    intvar.data[:,0] = (1000.*coords[:,0]).astype(int)
+
+def load_and_check(filename):
+    swarm, dblvar, intvar = build()
+    expected = build()
+    unplaced = swarm.load_checkpoint(filename)
+    if unplaced != 0:
+        raise RuntimeError("{} particles could not be placed on restart from '{}'.".format(unplaced, filename))
+    if swarm.particleGlobalCount != count:
+        raise RuntimeError("Restart from '{}' gave {} particles, expected {}.".format(filename, swarm.particleGlobalCount, count))
+    expected_swarm, expected_dbl, expected_int = expected
+    expected_swarm.add_particles_with_coordinates(swarm.data)
+    set_values(expected_swarm, expected_dbl, expected_int)
+    if not (np.array_equal(dblvar.data, expected_dbl.data) and np.array_equal(intvar.data, expected_int.data)):
+        raise RuntimeError("Variables restarted from '{}' differ from those saved.".format(filename))
+    return swarm
+
+if __name__ == '__main__':
+    if len(sys.argv) == 1 and uw.mpi.size == 1:
+        swarm, dblvar, intvar = build()
+        fill(swarm, dblvar, intvar)
+        swarm.save_checkpoint(serialfile, blockSize=64)
+
+        result = subprocess.run("mpirun -np 2 {} {} parallel".format(sys.executable, getsourcefile(lambda:0)), shell=True)
+        if result.returncode != 0:
+            raise RuntimeError("Parallel swarm checkpoint restart failed.")
+
+        load_and_check(parallelfile)
+        os.remove(serialfile)
+        os.remove(parallelfile)
+    else:
+        swarm = load_and_check(serialfile)
+        if uw.mpi.comm.allreduce(int(swarm.particleLocalCount == 0)) == 0:
+            raise RuntimeError("Expected a process without particles.")
+        swarm.save_checkpoint(parallelfile, blockSize=64)
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+'''
+This script checks that a voronoi integration swarm sharing the cell tables of its
+material swarm remains valid where the material swarm is advected and population
+controlled, and the Stokes system is then solved without reinitialisation (so the
+integration swarm is not repopulated). The velocity must match that obtained where
+the integration swarm keeps its own cell tables. After each population control step
+(which splits and deletes particles of both swarms), the integration swarm's cell tables
+must list exactly the particles owned by each cell.
+'''
+
+import numpy as np
+import underworld as uw
+from mpi4py import MPI
+from underworld import function as fn
+from underworld import libUnderworld
+
+def check_cell_tables(vswarm, step):
+    cells = vswarm.owningCell.data[:,0].astype(int)
+    counts = np.bincount(cells, minlength=vswarm.mesh.elementsDomain)
+    indices = np.array([ libUnderworld.StgDomain.Swarm_GetParticleIndexWithinCell(vswarm._cself, int(cell), particle)
+                         for particle, cell in enumerate(cells) ], dtype=int)
+    # each particle must be found within its cell's table, at a distinct position
+    if np.any(indices >= counts[cells]) or len(np.unique(cells*(counts.max()+1) + indices)) != len(cells):
+        raise RuntimeError("Integration swarm cell tables do not match particle owning cells after population "
+                           "control step {}.".format(step))
+
+def run(share_cell_tables):
+    mesh = uw.mesh.FeMesh_Cartesian("Q1/dQ0", (16,16), (0.,0.), (1.,1.))
+    velocityField = uw.mesh.MeshVariable(mesh,2)
+    velocityField.data[:] = (0.,0.)
+    pressureField = uw.mesh.MeshVariable(mesh.subMesh,1)
+    pressureField.data[:] = 0.
+
+    swarm = uw.swarm.Swarm(mesh)
+    swarm._voronoi_swarm_private = uw.swarm.VoronoiIntegrationSwarm(swarm, share_cell_tables=share_cell_tables)
+    swarm.populate_using_layout(uw.swarm.layouts.PerCellSpaceFillerLayout(swarm, particlesPerCell=12))
+    material = swarm.add_variable("int", 1)
+    coord = fn.input()
+    material.data[:] = 0
+    material.data[fn.math.dot(coord-(0.5,0.4), coord-(0.5,0.4)).evaluate(swarm) < 0.04] = 1
+    population_control = uw.swarm.PopulationControl(swarm, aggressive=True, particlesPerCell=12)
+
+    viscosity = fn.branching.map(fn_key=material, mapping={0: 1., 1: 10.})
+    density = fn.branching.map(fn_key=material, mapping={0: 0., 1: 1.})
+    walls = mesh.specialSets["AllWalls_VertexSet"]
+    conditions = uw.conditions.DirichletCondition(velocityField, (walls, walls))
+    stokesSystem = uw.systems.Stokes(velocityField, pressureField, viscosity, density*(0.,-1.),
+                                     voronoi_swarm=swarm, conditions=conditions)
+    solver = uw.systems.Solver(stokesSystem)
+    solver.solve()
+
+    # advect well beyond a cell, so that particles change cells and population control adds and removes particles
+    advector = uw.systems.SwarmAdvector(velocityField, swarm, order=2)
+    for step in range(5):
+        advector.integrate(4.*advector.get_max_dt())
+        population_control.repopulate()
+        check_cell_tables(swarm._voronoi_swarm, step)
+    advector.integrate(4.*advector.get_max_dt())
+
+    solver.solve(reinitialise=False)
+    return velocityField.data.copy()
+
+shared = run(True)
+unshared = run(False)
+
+vmax = uw.mpi.comm.allreduce(np.abs(unshared).max(), op=MPI.MAX)
+diff = uw.mpi.comm.allreduce(np.abs(shared - unshared).max(), op=MPI.MAX)
+if diff > 1.0e-10*vmax:
+    raise RuntimeError("Velocity with shared cell tables differs from velocity with unshared cell tables. "
+                       "Max difference = {}, max velocity = {}.".format(diff, vmax))
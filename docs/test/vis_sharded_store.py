@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+'''
+This script writes a decimated swarm to a sharded visualisation store, merges the
+shards, and checks the merged database holds about the requested number of points.
+The manifest must list one shard per writing process (every process, or with aggregate
+the first process of each node), and the points held by the listed shards must total
+those of the merged database. The script runs serially, and then reruns itself on four
+processes, both with and without aggregation.
+'''
+import os
+import sys
+import glob
+import sqlite3
+import subprocess
+import underworld as uw
+import underworld.visualisation as vis
+from mpi4py import MPI
+from inspect import getsourcefile
+
+# lucPointType vertices, three floats per point
+pointsSQL = "select sum(count) from geometry where type=1 and data_type=0"
+
+def check(aggregate):
+    mesh = uw.mesh.FeMesh_Cartesian("Q1", (32,32), (0.,0.), (1.,1.))
+    swarm = uw.swarm.Swarm(mesh)
+    swarm.populate_using_layout(uw.swarm.layouts.PerCellGaussLayout(swarm, gaussPointCount=4))
+
+    maxPoints = 2000
+    store = vis.Store('sharded_aggregate' if aggregate else 'sharded', sharded=True, aggregate=aggregate)
+    fig = vis.Figure(store, name="points")
+    fig.append(vis.objects.Points(swarm, maxPoints=maxPoints, colourBar=False))
+    merged = fig.save_database('sharded_merged')
+
+    # writers are every process, or the first process on each node when aggregating
+    if aggregate:
+        nodeComm = uw.mpi.comm.Split_type(MPI.COMM_TYPE_SHARED)
+        writers = uw.mpi.comm.allreduce(int(nodeComm.rank == 0))
+        nodeComm.Free()
+    else:
+        writers = uw.mpi.size
+
+    if uw.mpi.rank == 0:
+        db = sqlite3.connect(merged)
+        points = db.execute(pointsSQL).fetchone()[0] // 3
+        rows = db.execute("select rank, path from shard").fetchall()
+        db.close()
+        if points > maxPoints or points < maxPoints//2:
+            raise RuntimeError("Expected about {} points in the merged store, found {}.".format(maxPoints, points))
+        if len(rows) != writers or len(set(rank for rank, path in rows)) != writers:
+            raise RuntimeError("Expected {} shards in the manifest (aggregate={}), found {}.".format(writers, aggregate, len(rows)))
+        # shard paths are relative to the manifest
+        folder = os.path.dirname(store._db.path)
+        shardPoints = 0
+        for rank, path in rows:
+            db = sqlite3.connect(os.path.join(folder, path))
+            shardPoints += (db.execute(pointsSQL).fetchone()[0] or 0) // 3
+            db.close()
+        if shardPoints != points:
+            raise RuntimeError("Manifest shards hold {} points, but the merged store holds {} (aggregate={}).".format(
+                               shardPoints, points, aggregate))
+
+    uw.mpi.barrier()
+    if uw.mpi.rank == 0:
+        for filename in glob.glob("sharded*.gldb"):
+            os.remove(filename)
+    uw.mpi.barrier()
+
+if __name__ == '__main__':
+    check(False)
+    check(True)
+    if len(sys.argv) == 1 and uw.mpi.size == 1:
+        result = subprocess.run("mpirun -np 4 {} {} parallel".format(sys.executable, getsourcefile(lambda:0)), shell=True)
+        if result.returncode != 0:
+            raise RuntimeError("Parallel sharded store check failed.")
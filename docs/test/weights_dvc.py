@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+'''
+This script checks the discrete voronoi cell (DVC) weights of randomly populated 3D
+elements, at voronoi grid resolutions of 10, 20 and 40. The weights of each element
+must sum to the element's local volume, and weights calculated concurrently
+(`threadedCalculation`) must be identical to those calculated serially. Where a single
+particle is moved, only its element's weights may be recalculated, and all other
+weights must be unchanged. The rate of calculation is reported. Set OMP_NUM_THREADS to
+choose the thread count.
+'''
+
+import time
+import numpy as np
+import underworld as uw
+
+mesh = uw.mesh.FeMesh_Cartesian("Q1", (4,4,4), (0.,0.,0.), (1.,1.,1.))
+swarm = uw.swarm.Swarm(mesh)
+swarm.populate_using_layout(uw.swarm.layouts.PerCellRandomLayout(swarm, particlesPerCell=27, seed=1))
+nElements = mesh.elementsLocal
+
+def calculate(resolution, threaded):
+    vswarm = uw.swarm.VoronoiIntegrationSwarm(swarm)
+    calculator = uw.swarm._weights.DVC(resolution, resolution, resolution, threadedCalculation=threaded)
+    start = time.time()
+    vswarm.repopulate(weights_calculator=calculator)
+    spent = time.time() - start
+    weights = vswarm.particleWeights.data[:,0].copy()
+    cells = vswarm.owningCell.data[:,0].copy()
+    if uw.mpi.rank == 0:
+        print("DVC weights, resolution {}{}: {:.4g} weights/s".format(resolution, ", threaded" if threaded else "", len(weights)/spent))
+    return vswarm, calculator, weights, cells
+
+for resolution in (10, 20, 40):
+    vswarm, calculator, serial, cells = calculate(resolution, False)
+
+    # the voronoi cells tile the local element [-1,1]^3 exactly
+    volumes = np.bincount(cells, weights=serial, minlength=nElements)
+    if not np.allclose(volumes, 8., rtol=0., atol=1.e-10):
+        raise RuntimeError("DVC weights at resolution {} do not sum to the element volume. "
+                           "Max error = {}.".format(resolution, np.abs(volumes-8.).max()))
+
+    _, _, threaded, threaded_cells = calculate(resolution, True)
+    if not (np.array_equal(cells, threaded_cells) and np.array_equal(serial, threaded)):
+        raise RuntimeError("Threaded DVC weights at resolution {} differ from serial weights.".format(resolution))
+
+    # move a single particle within its element, so only that element is recalculated
+    calculator.calculation_info(reset=True)
+    moved_cell = cells[0]
+    original = swarm.data[0].copy()
+    with swarm.deform_swarm():
+        swarm.data[0] += 0.01*(0.5/4. - np.mod(swarm.data[0], 1./4.))
+    vswarm.repopulate(weights_calculator=calculator)
+    info = calculator.calculation_info(reset=True)
+    if (info["calculated"], info["reused"]) != (1, nElements-1):
+        raise RuntimeError("Expected a single element to be recalculated at resolution {}, "
+                           "but found {}.".format(resolution, info))
+    moved = vswarm.particleWeights.data[:,0]
+    unchanged = vswarm.owningCell.data[:,0] != moved_cell
+    if not np.array_equal(moved[unchanged], serial[unchanged]):
+        raise RuntimeError("Reused DVC weights at resolution {} differ from those calculated.".format(resolution))
+    with swarm.deform_swarm():
+        swarm.data[0] = original
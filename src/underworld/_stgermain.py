@@ -433,3 +433,27 @@ def GetLiveComponent(compName):
     except:
         print("Component \'%s\' not found in the live component register." % compName)
         return None
+
+def ReadStats( cself, counters, resetter, reset=False, fraction=None ):
+    """
+       Reads the local statistics counters of a native object, as returned by the various
+       `*_info()` methods.
+
+       Args:
+       cself (Swig Ptr):  The native object.
+       counters (dict):  Maps each statistic name to the libUnderworld function returning its count.
+       resetter (function):  libUnderworld function zeroing the counts.
+       reset (bool):  If True, the counts are zeroed after being read.
+       fraction (tuple):  Optional (name, names) pair. The count of 'name' as a fraction of the
+                          summed counts of 'names' is added as 'fraction' (0. where the sum is 0).
+       Returns:
+       info (dict):  The statistics.
+    """
+    info = { name: counter(cself) for name, counter in counters.items() }
+    if fraction is not None:
+        part, wholes = fraction
+        total = sum( info[name] for name in wholes )
+        info["fraction"] = float(info[part])/total if total else 0.
+    if reset:
+        resetter(cself)
+    return info
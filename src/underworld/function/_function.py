@@ -651,113 +651,142 @@ class Function(underworld._stgermain.LeftOverParamsChecker, metaclass = ABCMeta)
         """
         return at(self,index)
 
-    def evaluate_global(self, inputData, inputType=None):
+    def _routing_mesh(self):
         """
-        This method attempts to evalute inputData across all processes, and 
-        then consolide the results on the root processor. This is most useful
-        where you wish to evalute your functions using global coordinates 
-        which may span processes in a parallel simulation.
-        
+        Returns the mesh used to route global evaluations, or None where the
+        function has no mesh based dependencies. Where there are several
+        meshes, one is chosen consistently across processes.
+        """
+        meshes = {}
+        for item in self._underlyingDataItems:
+            mesh = getattr(item, "mesh", None)
+            if isinstance(mesh, uw.mesh.FeMesh):
+                meshes[mesh._cself.name] = mesh
+        if not meshes:
+            return None
+        return meshes[sorted(meshes.keys())[0]]
+
+    def evaluate_global(self, inputData, inputType=None, gather=True):
+        """
+        This method evaluates the function at coordinates which may lie
+        anywhere in the (parallel) domain. Each coordinate is sent to the
+        processes whose part of the mesh may contain it (found via the mesh's
+        directory of process bounding boxes, see `FeMesh.find_processes`),
+        evaluated there, and the result returned.
+
         Note that this method does not currently support 'FunctionInput' class
         input data.
-        
-        Due to the communications required for this method, a significant 
-        performance overhead may be encountered. The standard `evaluate` method 
-        should be used instead wherever possible.
 
-        Please see `evaluate` method for parameter details.
+        Due to the communications required for this method, a performance
+        overhead may be encountered. The standard `evaluate` method should be
+        used instead wherever possible.
+
+        Please see `evaluate` method for remaining parameter details.
+
+        Parameters
+        ----------
+        gather : bool
+            If True, the root process's `inputData` is evaluated, and the
+            results returned on the root process only (other processes'
+            `inputData` is ignored). If False, each process's own `inputData`
+            is evaluated and the results returned to that process.
 
         Notes
         -----
         This method must be called collectively by all processes.
-        
+
         Returns
         -------
-        Only the root process gets the final results array. All other processes
-        are returned None.
+        numpy.ndarray
+            The results, or None on processes other than the root where
+            `gather` is True. Results for coordinates found on no process
+            are zero.
+
+        Example
+        -------
+        >>> import underworld as uw
+        >>> import numpy as np
+        >>> mesh = uw.mesh.FeMesh_Cartesian(elementRes=(8,8))
+        >>> var = mesh.add_variable(1)
+        >>> var.data[:,0] = mesh.data[:,0] + 2.*mesh.data[:,1]
+        >>> coords = np.array([[0.1,0.2],[0.95,0.5],[0.5,0.999]])
+        >>> results = var.evaluate_global(coords, gather=False)
+        >>> np.allclose(results[:,0], coords[:,0] + 2.*coords[:,1])
+        True
 
         """
         from mpi4py import MPI
-        comm = MPI.COMM_WORLD
-        rank = comm.Get_rank()
-        nprocs = comm.Get_size()
+        comm = uw.mpi.comm
+        rank = uw.mpi.rank
 
         if isinstance(inputData, FunctionInput):
             raise TypeError("This 'inputData' type is not currently supported for global function evaluation.")
-        # go through the inputData and fill elements where the data is available
+        if not isinstance(gather, bool):
+            raise TypeError("'gather' must be of type 'bool'.")
         if not isinstance(inputData, np.ndarray):
             inputData = self._evaluate_data_convert_to_ndarray(inputData)
-        arrayLength = len(inputData)
-        local =  np.zeros(arrayLength, dtype=bool)
-        local_output = None
-        for i in range(arrayLength):
-            try:
-                # get result
-                output = self.evaluate(inputData[i:i+1], inputType)
-                # flag as result found
-                local[i]  = True
-                # if not created, create
-                if not isinstance(local_output, np.ndarray):
-                    local_output =  np.zeros( (arrayLength, output.shape[1]), dtype=output.dtype)
-                local_output[i] = output
-            except ValueError:
-                # ValueError is only raised for outside domain, which suggests that the
-                # evaluation probably occurred on another process.
-                pass
-            except:
-                # if a different error was raise, we should reraise
-                raise
-
-        # distill results down to local only
-        local_result_count = np.count_nonzero(local)
-        if local_result_count:
-            local_output_distilled = np.zeros( (local_result_count, local_output.shape[1]), dtype=local_output.dtype)
-            array_positions        = np.zeros(local_result_count, dtype=int)
-            j=0
-            for i,val in enumerate(local):
-                if val:
-                    array_positions[j]=i
-                    local_output_distilled[j] = local_output[i]
-                    j+=1
-
-        # data sending
-        total_output = None
-        if(rank!=0):
-            # send count
-            comm.send(local_result_count, dest=0, tag=0)
-            if local_result_count:
-                # next send position array
-                comm.send(array_positions, dest=0, tag=1)
-                # finally send actual data
-                comm.send(local_output_distilled,    dest=0, tag=2)
-        else:
-            # have output already from rank=0 proc; and lots of empties to fill in from others
-            # some data IS available two multiple processors - e.g. edges
-            for iProc in range(1,nprocs):
-                incoming_count = comm.recv(source=iProc, tag=0)
-                if incoming_count:
-                    incoming_positions = comm.recv(source=iProc, tag=1)
-                    incoming_data      = comm.recv(source=iProc, tag=2)
-                    # create array if not done already
-                    if not isinstance(total_output, np.ndarray):
-                        total_output =  np.zeros( (arrayLength, incoming_data.shape[1]), dtype=incoming_data.dtype)
-                    total_output[incoming_positions] = incoming_data
-
-        # finally copy our local results into the output
-        if (rank==0) and local_result_count:
-            if not isinstance(total_output,np.ndarray):
-                total_output =  np.zeros( (arrayLength,local_output_distilled.shape[1]), dtype=local_output_distilled.dtype)
-            total_output[array_positions] = local_output_distilled
-
-        if (rank==0) and (isinstance(total_output,np.ndarray)==False):
-            # if total_output is still non-existent, no results were found
-            raise RuntimeError("No results were found anywhere in the domain for provided input.")
-
-        if rank == 0:
-            return total_output
-        else:
-            # all other procs return None
+        if gather and rank != 0:
+            inputData = inputData[0:0]
+
+        mesh = self._routing_mesh()
+        if mesh is None:
+            # no mesh dependencies, so evaluate anywhere
+            if gather and rank != 0:
+                return None
+            return self.evaluate(inputData, inputType)
+        if inputData.ndim != 2 or inputData.shape[1] != mesh.dim:
+            raise ValueError("'inputData' must be an array of {} dimensional coordinates.".format(mesh.dim))
+
+        # send each coordinate to all its candidate owners, keeping a record of the indices sent
+        coords = np.ascontiguousarray(inputData, dtype=np.float64)
+        procs = mesh.find_processes(coords)
+        sends = {}
+        indices = {}
+        for dest in np.unique(procs[procs >= 0]):
+            index = np.nonzero(np.any(procs == dest, axis=1))[0]
+            indices[int(dest)] = index
+            sends[int(dest)] = coords[index].reshape(-1)
+        received = uw.mpi._sparse_exchange(sends, tag=7391)
+
+        # evaluate the coordinates within my local elements, and reply to each requester
+        requests = []
+        replies = {}
+        for source, buf in received.items():
+            points = buf.reshape(-1, mesh.dim)
+            elements = np.empty(len(points), dtype=np.int32)
+            uw.libUnderworld.StgDomain.Mesh_FindLocalElements(mesh._cself, points, elements)
+            owned = np.nonzero(elements >= 0)[0]
+            values = self.evaluate(points[owned], inputType) if len(owned) else None
+            if source == rank:
+                replies[source] = (owned, values)
+            else:
+                requests.append( comm.isend((owned, values), dest=source, tag=7392) )
+        for dest in sends.keys():
+            if dest != rank:
+                replies[dest] = comm.recv(source=dest, tag=7392)
+        MPI.Request.Waitall(requests)
+
+        # take the first result for each coordinate
+        output = None
+        found = np.zeros(len(coords), dtype=bool)
+        for dest in sorted(replies.keys()):
+            owned, values = replies[dest]
+            if values is None:
+                continue
+            if output is None:
+                output = np.zeros((len(coords), values.shape[1]), dtype=values.dtype)
+            index = indices[dest][owned]
+            new = ~found[index]
+            output[index[new]] = values[new]
+            found[index] = True
+
+        if gather and rank != 0:
             return None
+        if output is None:
+            if len(coords) == 0:
+                return self.evaluate(np.zeros((0, mesh.dim)), inputType)
+            raise RuntimeError("No results were found anywhere in the domain for provided input.")
+        return output
 
 
     def _evaluate_data_convert_to_ndarray( self, inputData ):
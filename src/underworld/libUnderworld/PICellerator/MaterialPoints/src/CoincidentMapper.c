@@ -42,7 +42,20 @@ void* _CoincidentMapper_DefaultNew( Name name ) {
 }
 
 CoincidentMapper* _CoincidentMapper_New(  COINCIDENTMAPPER_DEFARGS  ) {
-	return (CoincidentMapper*)_Stg_Component_New(  STG_COMPONENT_PASSARGS  );
+	CoincidentMapper* self = (CoincidentMapper*)_Stg_Component_New(  STG_COMPONENT_PASSARGS  );
+
+	self->shareCellTables = True;
+	self->mappedCoords = NULL;
+	self->mappedXis = NULL;
+	self->mappedCells = NULL;
+	self->mappedCount = 0;
+	self->mappedSize = 0;
+	self->mappedDeformVersion = 0;
+	self->mappedValid = False;
+	self->mapCount = 0;
+	self->remapCount = 0;
+
+	return self;
 }
 
 void _CoincidentMapper_AssignFromXML( void* mapper, Stg_ComponentFactory* cf, void* data ) {
@@ -53,11 +66,17 @@ void _CoincidentMapper_AssignFromXML( void* mapper, Stg_ComponentFactory* cf, vo
     
     self->integrationSwarm->mirroredSwarm = (Swarm*) self->materialSwarm;
     self->materialSwarm->mirroredSwarm    = (Swarm*) self->integrationSwarm;
+
+	self->shareCellTables = Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"ShareCellTables", True  );
 }
 
 void _CoincidentMapper_Delete( void* mapper ) {
 	CoincidentMapper* self = (CoincidentMapper*)mapper;
 
+	FreeArray( self->mappedCoords );
+	FreeArray( self->mappedXis );
+	FreeArray( self->mappedCells );
+
 	_Stg_Component_Delete( self );
 }
 
@@ -82,14 +101,47 @@ void _CoincidentMapper_Map( void* mapper ) {
 	FeMesh*						mesh = integrationSwarm->mesh;
 	Particle_Index				particle_lI;
 	Particle_Index				particle_cI;
+	unsigned					dim = materialSwarm->dim;
+	Bool						reuse;
+	double*						mappedCoord;
+	double*						mappedXi;
+	unsigned long				remapped = 0;
     
 	Cell_Index					cell_dI;
 
+	/* Integration points coincide index for index with the material points, so the integration
+	 * swarm's cell tables would be an exact copy of the material swarm's. */
+	if( self->shareCellTables )
+		Swarm_ShareCellTables( integrationSwarm, materialSwarm );
+
 	integrationSwarm->particleLocalCount = materialSwarm->particleLocalCount;
 	Swarm_Realloc( integrationSwarm );
 
-	for( cell_dI = 0; cell_dI < integrationSwarm->cellDomainCount; cell_dI++ )
-		integrationSwarm->cellParticleCountTbl[cell_dI] = 0;
+	/* Stored local coordinates are only valid for the mesh geometry they were computed on. */
+	if( self->mappedValid && self->mappedDeformVersion != mesh->deformVersion )
+		self->mappedValid = False;
+	if( !self->mappedValid )
+		self->mappedCount = 0;
+	if( self->mappedCount > materialSwarm->particleLocalCount )
+		self->mappedCount = materialSwarm->particleLocalCount;
+	if( materialSwarm->particleLocalCount > self->mappedSize ) {
+		unsigned	nEntries;
+
+		self->mappedSize = materialSwarm->particleLocalCount;
+		nEntries = self->mappedSize * dim;
+		self->mappedCoords = ReallocArray( self->mappedCoords, double, nEntries );
+		self->mappedXis = ReallocArray( self->mappedXis, double, nEntries );
+		self->mappedCells = ReallocArray( self->mappedCells, Cell_Index, self->mappedSize );
+	}
+	/* New particles (or all of them, if invalidated) have nothing stored yet. */
+	for( particle_lI = self->mappedCount; particle_lI < materialSwarm->particleLocalCount; particle_lI++ )
+		self->mappedCells[particle_lI] = (Cell_Index)-1;
+
+	/* Shared cell tables are maintained by the material swarm. */
+	if( !integrationSwarm->cellTablesOwner ) {
+		for( cell_dI = 0; cell_dI < integrationSwarm->cellDomainCount; cell_dI++ )
+			integrationSwarm->cellParticleCountTbl[cell_dI] = 0;
+	}
 
 	/* Map each point */
     for( cell_dI = 0; cell_dI < materialSwarm->cellDomainCount; cell_dI++ ) {
@@ -98,8 +150,24 @@ void _CoincidentMapper_Map( void* mapper ) {
 
             materialPoint    =   (GlobalParticle*) Swarm_ParticleAt(    materialSwarm, particle_lI );
             integrationPoint = (IntegrationPoint*) Swarm_ParticleAt( integrationSwarm, particle_lI );
-
-            Swarm_AddParticleToCell( integrationSwarm, cell_dI, particle_lI );
+            mappedCoord      = self->mappedCoords + particle_lI * dim;
+            mappedXi         = self->mappedXis + particle_lI * dim;
+
+            /* Adding to shared tables would first give the integration swarm its own copy of them. */
+            if( integrationSwarm->cellTablesOwner )
+                integrationPoint->owningCell = cell_dI;
+            else
+                Swarm_AddParticleToCell( integrationSwarm, cell_dI, particle_lI );
+
+            /* Particles are compared by value rather than flagged when moved, as coordinates are also
+             * written directly from Python. The integration point xi cannot be trusted as the cached
+             * value, since weights calculators overwrite it with cell centroids. */
+            reuse = self->mappedCells[particle_lI] == cell_dI &&
+                    memcmp( mappedCoord, materialPoint->coord, dim * sizeof(double) ) == 0;
+            if( reuse ) {
+                memcpy( integrationPoint->xi, mappedXi, dim * sizeof(double) );
+                continue;
+            }
 
             /* Convert global to local coordinates */
             ElementType_ConvertGlobalCoordToElLocal(
@@ -109,6 +177,11 @@ void _CoincidentMapper_Map( void* mapper ) {
                 materialPoint->coord,
                 integrationPoint->xi );
 
+            memcpy( mappedCoord, materialPoint->coord, dim * sizeof(double) );
+            memcpy( mappedXi, integrationPoint->xi, dim * sizeof(double) );
+            self->mappedCells[particle_lI] = cell_dI;
+            remapped++;
+
 #ifdef DEBUG
             /* Check the result is between -1 to 1 in all dimensions : if not, something is stuffed */
             Index dim_I;
@@ -129,6 +202,31 @@ void _CoincidentMapper_Map( void* mapper ) {
 #endif
         }
     }
+
+	self->mappedCount = materialSwarm->particleLocalCount;
+	self->mappedDeformVersion = mesh->deformVersion;
+	self->mappedValid = True;
+	self->mapCount += materialSwarm->particleLocalCount;
+	self->remapCount += remapped;
 }
 
+void CoincidentMapper_Invalidate( void* mapper ) {
+	CoincidentMapper* self = (CoincidentMapper*)mapper;
 
+	self->mappedValid = False;
+}
+
+unsigned long CoincidentMapper_GetMapCount( void* mapper ) {
+	return ((CoincidentMapper*)mapper)->mapCount;
+}
+
+unsigned long CoincidentMapper_GetRemapCount( void* mapper ) {
+	return ((CoincidentMapper*)mapper)->remapCount;
+}
+
+void CoincidentMapper_ResetStats( void* mapper ) {
+	CoincidentMapper* self = (CoincidentMapper*)mapper;
+
+	self->mapCount = 0;
+	self->remapCount = 0;
+}
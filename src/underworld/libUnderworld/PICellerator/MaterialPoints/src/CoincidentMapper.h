@@ -18,6 +18,20 @@
 		__Stg_Component \
 		IntegrationPointsSwarm*												integrationSwarm; \
 		GeneralSwarm*	materialSwarm; \
+		/* If True, the integration swarm uses the material swarm's cell particle tables. */ \
+		Bool			shareCellTables; \
+		/* Coordinate, cell and local coordinate of each particle at its last mapping. Particles \
+		 * whose coordinate and cell are unchanged reuse the stored local coordinate, unless the \
+		 * mesh has been deformed since (Mesh::deformVersion). */ \
+		double*			mappedCoords; \
+		double*			mappedXis; \
+		Cell_Index*		mappedCells; \
+		Particle_Index	mappedCount; \
+		Particle_Index	mappedSize; \
+		unsigned		mappedDeformVersion; \
+		Bool			mappedValid; \
+		unsigned long	mapCount; \
+		unsigned long	remapCount; \
 
 	struct CoincidentMapper { __CoincidentMapper };
 
@@ -49,6 +63,14 @@
 	void _CoincidentMapper_Initialise( void* mapper, void* data );
 
 	void _CoincidentMapper_Map( void* mapper );
+
+	/* Discards the stored local coordinates, so the next map inverts every particle. */
+	void CoincidentMapper_Invalidate( void* mapper );
+
+	/* Total particles mapped, and how many of those required a new local coordinate inversion. */
+	unsigned long CoincidentMapper_GetMapCount( void* mapper );
+	unsigned long CoincidentMapper_GetRemapCount( void* mapper );
+	void CoincidentMapper_ResetStats( void* mapper );
 	
 #endif
 
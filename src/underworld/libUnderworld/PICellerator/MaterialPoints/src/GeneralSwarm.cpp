@@ -24,7 +24,8 @@ extern "C" {
 
 #include "MaterialPoints.h"
 }
-#include "nanoflann.hpp"
+#include <vector>
+#include <algorithm>
 
 /* Textual name of this class */
 const Type GeneralSwarm_Type = (char*) "GeneralSwarm";
@@ -42,7 +43,7 @@ GeneralSwarm* _GeneralSwarm_New(  GENERALSWARM_DEFARGS  )
 
    self = (GeneralSwarm*)_Swarm_New(  SWARM_PASSARGS  );
    self->index = NULL;
-   self->index_int = NULL;
+   self->indexStale = False;
    
    return self;
 }
@@ -442,110 +443,489 @@ void GeneralSwarm_ClearSwarmMaps( void* swarm ) {
     }
 }
 
-struct GeneralSwarm_nanoflann_interface
+/* Spatial index over the local particles. Particles are bucketed into a uniform
+   grid of bins spanning their bounding box at build time. Coordinates are read
+   directly from the swarm, so the index is brought up to date by a single pass
+   that moves only those particles whose bin has changed (or whose local index
+   has appeared or disappeared), rather than by rebuilding from scratch.
+   Particles which later leave the original bounding box are clamped into the
+   boundary bins, which keeps queries exact. The bin grid is only rebuilt where
+   this happens for a large fraction of particles, or the particle count
+   changes substantially. */
+class GeneralSwarm_ParticleIndex
 {
-    GeneralSwarm* swarm;
-    // Must return the number of data points
-    inline size_t kdtree_get_point_count() const { return swarm->particleLocalCount; }
-
-    // Returns the dim'th component of the idx'th point in the class:
-    // Since this is inlined and the "dim" argument is typically an immediate value, the
-    //  "if/else's" are actually solved at compile time.
-    inline double kdtree_get_pt(const size_t idx, const size_t dim) const
-    {
-        return (((GlobalParticle*)Swarm_ParticleAt( swarm, idx ))->coord)[dim];
+public:
+    GeneralSwarm_ParticleIndex( GeneralSwarm* swarm ) : swarm(swarm), dim(swarm->dim), builtCount(0) {}
+
+    void rebuild();
+    void update();
+    unsigned nearest( const double* coord, unsigned k, int* indices, double* distSqrs ) const;
+    void withinRadius( const double* coord, double radius, std::vector< std::pair<double,int> >& found ) const;
+
+private:
+    GeneralSwarm*                   swarm;
+    unsigned                        dim;
+    unsigned                        builtCount;
+    double                          min[3];
+    double                          width[3];
+    int                             nBins[3];
+    std::vector< std::vector<int> > bins;
+    std::vector<int>                binOf;      /* bin containing each particle */
+    std::vector<int>                slotOf;     /* position of each particle within its bin */
+
+    inline const double* coordOf( int particle_I ) const {
+        return ((GlobalParticle*)Swarm_ParticleAt( swarm, particle_I ))->coord;
     }
+    int binIndex( const double* coord, int* ijk, bool* clamped ) const;
+    void insert( int particle_I, int bin );
+    void remove( int particle_I );
+    void searchBlock( const double* coord, const int* lo, const int* hi, const int* skipLo, const int* skipHi,
+                      unsigned k, std::vector< std::pair<double,int> >& heap ) const;
+};
 
-    // Optional bounding-box computation: return false to default to a standard bbox computation loop.
-    //   Return true if the BBOX was already computed by the class and returned in "bb" so it can be avoided to redo it again.
-    //   Look at bb.size() to find out the expected dimensionality (e.g. 2 or 3 for point clouds)
-    template <class BBOX>
-    bool kdtree_get_bbox(BBOX &bb) const
-    {
-    //    bb[0].low = 0.; bb[0].high = 10.;  // 0th dimension limits
-    //    bb[2].low = 0.; bb[1].high = 10.;  // 1th dimension limits
-    //    bb[1].low = 0.; bb[2].high = 10.;  // 2th dimension limits
-    return false;
+/* Target mean particle count per bin */
+static const double GENERALSWARM_INDEX_BIN_OCCUPANCY = 8.0;
+
+int GeneralSwarm_ParticleIndex::binIndex( const double* coord, int* ijk, bool* clamped ) const
+{
+    int bin = 0;
+
+    *clamped = false;
+    for( int d_i=dim-1; d_i>=0; d_i-- ) {
+        double pos = floor( (coord[d_i] - min[d_i]) / width[d_i] );
+        int ind;
+        if( !(pos >= 0.0) ) {  /* also catches nan */
+            ind = 0;
+            *clamped = true;
+        }
+        else if( pos > (double)(nBins[d_i] - 1) ) {
+            ind = nBins[d_i] - 1;
+            *clamped = true;
+        }
+        else
+            ind = (int)pos;
+        ijk[d_i] = ind;
+        bin = bin*nBins[d_i] + ind;
     }
-};
+    return bin;
+}
 
-// construct a kd-tree index
-typedef nanoflann::KDTreeSingleIndexAdaptor<
-    nanoflann::L2_Simple_Adaptor<double, GeneralSwarm_nanoflann_interface > ,
-    GeneralSwarm_nanoflann_interface,
-    2 /* dim */
-    > my_kd_tree_t_2d;
-typedef nanoflann::KDTreeSingleIndexAdaptor<
-    nanoflann::L2_Simple_Adaptor<double, GeneralSwarm_nanoflann_interface > ,
-    GeneralSwarm_nanoflann_interface,
-    3 /* dim */
-    > my_kd_tree_t_3d;
+void GeneralSwarm_ParticleIndex::insert( int particle_I, int bin )
+{
+    binOf[particle_I]  = bin;
+    slotOf[particle_I] = bins[bin].size();
+    bins[bin].push_back( particle_I );
+}
 
+void GeneralSwarm_ParticleIndex::remove( int particle_I )
+{
+    std::vector<int>& bin = bins[binOf[particle_I]];
+    int slot = slotOf[particle_I];
+
+    /* swap last entry into the hole */
+    bin[slot] = bin.back();
+    slotOf[bin[slot]] = slot;
+    bin.pop_back();
+    binOf[particle_I] = -1;
+}
 
-void GeneralSwarm_DeleteIndex( void* swarm ) {
-    GeneralSwarm* self = (GeneralSwarm*) swarm;
+void GeneralSwarm_ParticleIndex::rebuild()
+{
+    unsigned count = swarm->particleLocalCount;
+    double   max[3];
+    double   volume = 1.;
+    unsigned nActive = 0;
+    size_t   nTotal = 1;
+    int      ijk[3];
+    bool     clamped;
+
+    for( unsigned d_i=0; d_i<dim; d_i++ ) {
+        min[d_i] =  DBL_MAX;
+        max[d_i] = -DBL_MAX;
+    }
+    for( unsigned p_i=0; p_i<count; p_i++ ) {
+        const double* coord = coordOf( p_i );
+        for( unsigned d_i=0; d_i<dim; d_i++ ) {
+            if( coord[d_i] < min[d_i] ) min[d_i] = coord[d_i];
+            if( coord[d_i] > max[d_i] ) max[d_i] = coord[d_i];
+        }
+    }
+    /* size bins so that each holds roughly GENERALSWARM_INDEX_BIN_OCCUPANCY particles. Directions no wider than a
+       bin (including those of nearly flat swarms) are given a single bin, and left out of the sizing, as otherwise
+       their thinness shrinks the bins of every other direction. */
+    bool active[3];
+    for( unsigned d_i=0; d_i<dim; d_i++ ) {
+        active[d_i] = count && max[d_i] > min[d_i];
+        if( !active[d_i] ) {
+            min[d_i] = count ? min[d_i] : 0.;
+            max[d_i] = min[d_i];
+        }
+    }
+    double binWidth = 1.;
+    for( bool changed=true; changed; ) {
+        volume = 1.;
+        nActive = 0;
+        for( unsigned d_i=0; d_i<dim; d_i++ ) {
+            if( active[d_i] ) {
+                volume *= max[d_i] - min[d_i];
+                nActive++;
+            }
+        }
+        if( !nActive )
+            break;
+        binWidth = pow( volume*GENERALSWARM_INDEX_BIN_OCCUPANCY/(double)count, 1./(double)nActive );
+        changed = false;
+        for( unsigned d_i=0; d_i<dim; d_i++ ) {
+            if( active[d_i] && max[d_i] - min[d_i] <= binWidth ) {
+                active[d_i] = false;
+                changed = true;
+            }
+        }
+    }
+    /* rounding bin counts up may still give more bins than particles, so widen the bins of all directions
+       together until it doesn't */
+    for( ;; ) {
+        nTotal = 1;
+        for( unsigned d_i=0; d_i<dim; d_i++ ) {
+            nBins[d_i] = active[d_i] ? (int)ceil( (max[d_i] - min[d_i]) / binWidth ) : 1;
+            if( nBins[d_i] < 1 ) nBins[d_i] = 1;
+            nTotal *= nBins[d_i];
+        }
+        if( nTotal <= std::max( count, 1u ) )
+            break;
+        binWidth *= std::max( pow( (double)nTotal/(double)count, 1./(double)nActive ), 1.01 );
+    }
+    for( unsigned d_i=0; d_i<dim; d_i++ ) {
+        double extent = max[d_i] - min[d_i];
+        width[d_i] = 1.;
+        if( extent > 0. ) {
+            width[d_i] = extent / (double)nBins[d_i];
+            /* guard against the maximum coordinate landing beyond the last bin */
+            width[d_i] *= 1. + 1e-12;
+        }
+    }
 
-    if(self->dim==2)
-    {
-        my_kd_tree_t_2d* index = (my_kd_tree_t_2d*)self->index;
-        if(index!=NULL)
-            delete(index);
+    bins.assign( nTotal, std::vector<int>() );
+    binOf.assign( count, -1 );
+    slotOf.assign( count, -1 );
+    for( unsigned p_i=0; p_i<count; p_i++ )
+        insert( p_i, binIndex( coordOf( p_i ), ijk, &clamped ) );
+    builtCount = count;
+}
+
+void GeneralSwarm_ParticleIndex::update()
+{
+    unsigned count = swarm->particleLocalCount;
+    unsigned oldCount = binOf.size();
+    unsigned nClamped = 0;
+    int      ijk[3];
+    bool     clamped;
+
+    if( bins.empty() || count > 2*builtCount || 2*count < builtCount ) {
+        rebuild();
+        return;
     }
-    else
-    {
-        my_kd_tree_t_3d* index = (my_kd_tree_t_3d*)self->index;
-        if(index!=NULL)
-            delete(index);
+
+    /* local indices beyond the current count no longer exist */
+    for( unsigned p_i=count; p_i<oldCount; p_i++ )
+        remove( p_i );
+    binOf.resize( count, -1 );
+    slotOf.resize( count, -1 );
+
+    for( unsigned p_i=0; p_i<count; p_i++ ) {
+        int bin = binIndex( coordOf( p_i ), ijk, &clamped );
+        if( clamped ) nClamped++;
+        if( bin == binOf[p_i] )
+            continue;
+        if( binOf[p_i] >= 0 )
+            remove( p_i );
+        insert( p_i, bin );
+    }
+
+    /* the bin grid no longer reflects the particle distribution, so start again */
+    if( nClamped > count/10 )
+        rebuild();
+}
+
+/* Search the bins in [lo,hi], skipping those in [skipLo,skipHi] (already searched),
+   maintaining 'heap' as a max-heap of the k closest particles found. */
+void GeneralSwarm_ParticleIndex::searchBlock( const double* coord, const int* lo, const int* hi, const int* skipLo, const int* skipHi,
+                                              unsigned k, std::vector< std::pair<double,int> >& heap ) const
+{
+    int ijk[3] = { 0, 0, 0 };
+    int top[3] = { 0, 0, 0 };
+    int bot[3] = { 0, 0, 0 };
+
+    for( unsigned d_i=0; d_i<dim; d_i++ ) {
+        bot[d_i] = lo[d_i];
+        top[d_i] = hi[d_i];
+    }
+    for( ijk[2]=bot[2]; ijk[2]<=top[2]; ijk[2]++ ) {
+        for( ijk[1]=bot[1]; ijk[1]<=top[1]; ijk[1]++ ) {
+            for( ijk[0]=bot[0]; ijk[0]<=top[0]; ijk[0]++ ) {
+                if( skipLo ) {
+                    bool inside = true;
+                    for( unsigned d_i=0; d_i<dim; d_i++ )
+                        inside = inside && ijk[d_i] >= skipLo[d_i] && ijk[d_i] <= skipHi[d_i];
+                    if( inside ) continue;
+                }
+                int bin = 0;
+                for( int d_i=dim-1; d_i>=0; d_i-- )
+                    bin = bin*nBins[d_i] + ijk[d_i];
+                const std::vector<int>& particles = bins[bin];
+                for( size_t b_i=0; b_i<particles.size(); b_i++ ) {
+                    const double* pcoord = coordOf( particles[b_i] );
+                    double distSqr = 0.;
+                    for( unsigned d_i=0; d_i<dim; d_i++ )
+                        distSqr += (pcoord[d_i]-coord[d_i])*(pcoord[d_i]-coord[d_i]);
+                    std::pair<double,int> entry( distSqr, particles[b_i] );
+                    if( heap.size() < k ) {
+                        heap.push_back( entry );
+                        std::push_heap( heap.begin(), heap.end() );
+                    }
+                    else if( entry < heap.front() ) {
+                        std::pop_heap( heap.begin(), heap.end() );
+                        heap.back() = entry;
+                        std::push_heap( heap.begin(), heap.end() );
+                    }
+                }
+            }
+        }
+    }
+}
+
+unsigned GeneralSwarm_ParticleIndex::nearest( const double* coord, unsigned k, int* indices, double* distSqrs ) const
+{
+    std::vector< std::pair<double,int> > heap;
+    int  centre[3], lo[3], hi[3], prevLo[3], prevHi[3];
+    bool clamped;
+
+    if( k == 0 || binOf.empty() )
+        return 0;
+    heap.reserve( k );
+
+    binIndex( coord, centre, &clamped );
+    for( unsigned d_i=0; d_i<dim; d_i++ )
+        lo[d_i] = hi[d_i] = centre[d_i];
+    searchBlock( coord, lo, hi, NULL, NULL, k, heap );
+
+    /* grow the searched block one bin at a time in each direction until no unsearched
+       bin can hold a closer particle than the current k-th closest */
+    for( ;; ) {
+        bool   complete = true;
+        double bound = DBL_MAX;
+
+        for( unsigned d_i=0; d_i<dim; d_i++ ) {
+            if( lo[d_i] > 0 ) {
+                bound = std::min( bound, coord[d_i] - (min[d_i] + lo[d_i]*width[d_i]) );
+                complete = false;
+            }
+            if( hi[d_i] < nBins[d_i]-1 ) {
+                bound = std::min( bound, (min[d_i] + (hi[d_i]+1)*width[d_i]) - coord[d_i] );
+                complete = false;
+            }
+        }
+        if( complete )
+            break;
+        if( heap.size() == k && bound >= 0. && heap.front().first <= bound*bound )
+            break;
+
+        for( unsigned d_i=0; d_i<dim; d_i++ ) {
+            prevLo[d_i] = lo[d_i];
+            prevHi[d_i] = hi[d_i];
+            if( lo[d_i] > 0 ) lo[d_i]--;
+            if( hi[d_i] < nBins[d_i]-1 ) hi[d_i]++;
+        }
+        searchBlock( coord, lo, hi, prevLo, prevHi, k, heap );
     }
+
+    std::sort_heap( heap.begin(), heap.end() );
+    for( size_t n_i=0; n_i<heap.size(); n_i++ ) {
+        indices[n_i] = heap[n_i].second;
+        if( distSqrs ) distSqrs[n_i] = heap[n_i].first;
+    }
+    return heap.size();
+}
+
+void GeneralSwarm_ParticleIndex::withinRadius( const double* coord, double radius, std::vector< std::pair<double,int> >& found ) const
+{
+    int  lo[3], hi[3];
+    bool clamped;
+
+    found.clear();
+    if( binOf.empty() || !(radius >= 0.) )
+        return;
+
+    double corner[3] = { 0., 0., 0. };
+    for( unsigned d_i=0; d_i<dim; d_i++ )
+        corner[d_i] = coord[d_i] - radius;
+    binIndex( corner, lo, &clamped );
+    for( unsigned d_i=0; d_i<dim; d_i++ )
+        corner[d_i] = coord[d_i] + radius;
+    binIndex( corner, hi, &clamped );
+
+    double radiusSqr = radius*radius;
+    int    ijk[3] = { 0, 0, 0 };
+    int    top[3] = { 0, 0, 0 };
+    int    bot[3] = { 0, 0, 0 };
+    for( unsigned d_i=0; d_i<dim; d_i++ ) {
+        bot[d_i] = lo[d_i];
+        top[d_i] = hi[d_i];
+    }
+    for( ijk[2]=bot[2]; ijk[2]<=top[2]; ijk[2]++ ) {
+        for( ijk[1]=bot[1]; ijk[1]<=top[1]; ijk[1]++ ) {
+            for( ijk[0]=bot[0]; ijk[0]<=top[0]; ijk[0]++ ) {
+                int bin = 0;
+                for( int d_i=dim-1; d_i>=0; d_i-- )
+                    bin = bin*nBins[d_i] + ijk[d_i];
+                const std::vector<int>& particles = bins[bin];
+                for( size_t b_i=0; b_i<particles.size(); b_i++ ) {
+                    const double* pcoord = coordOf( particles[b_i] );
+                    double distSqr = 0.;
+                    for( unsigned d_i=0; d_i<dim; d_i++ )
+                        distSqr += (pcoord[d_i]-coord[d_i])*(pcoord[d_i]-coord[d_i]);
+                    if( distSqr <= radiusSqr )
+                        found.push_back( std::pair<double,int>( distSqr, particles[b_i] ) );
+                }
+            }
+        }
+    }
+    std::sort( found.begin(), found.end() );
+}
+
+/* Returns the swarm's index, creating it or bringing it up to date as required */
+static GeneralSwarm_ParticleIndex* _GeneralSwarm_GetIndex( GeneralSwarm* self )
+{
+    GeneralSwarm_ParticleIndex* index = (GeneralSwarm_ParticleIndex*)self->index;
+
+    if( index == NULL ) {
+        index = new GeneralSwarm_ParticleIndex( self );
+        index->rebuild();
+        self->index = (void*)index;
+        self->indexStale = False;
+    }
+    else if( self->indexStale ) {
+        index->update();
+        self->indexStale = False;
+    }
+    return index;
+}
+
+void GeneralSwarm_DeleteIndex( void* swarm ) {
+    GeneralSwarm* self = (GeneralSwarm*) swarm;
+
+    delete (GeneralSwarm_ParticleIndex*)self->index;
     self->index = NULL;
+    self->indexStale = False;
+}
+
+void GeneralSwarm_InvalidateIndex( void* swarm ) {
+    GeneralSwarm* self = (GeneralSwarm*) swarm;
+
+    self->indexStale = True;
+}
+
+void GeneralSwarm_UpdateIndex( void* swarm ) {
+    GeneralSwarm* self = (GeneralSwarm*) swarm;
+
+    self->indexStale = True;
+    _GeneralSwarm_GetIndex( self );
+}
 
-    GeneralSwarm_nanoflann_interface* cloud = (GeneralSwarm_nanoflann_interface*) self->index_int;
-    delete(cloud);
-    self->index_int = NULL;
+void GeneralSwarm_RebuildIndex( void* swarm ) {
+    GeneralSwarm* self = (GeneralSwarm*) swarm;
 
+    _GeneralSwarm_GetIndex( self )->rebuild();
+    self->indexStale = False;
 }
 
 size_t GeneralSwarm_GetClosestParticles( void* swarm, const double* coord, int num_parts ){
     GeneralSwarm* self = (GeneralSwarm*) swarm;
-    
-    if(self->index==NULL)
-    {
-        GeneralSwarm_nanoflann_interface* cloud = new(GeneralSwarm_nanoflann_interface);
-        cloud->swarm = self;
-        self->index_int = (void*) cloud;
-
-        if(self->dim==2)
-        {
-            my_kd_tree_t_2d* index = new(my_kd_tree_t_2d)(self->dim, *cloud, nanoflann::KDTreeSingleIndexAdaptorParams(10 /* max leaf */) );
-            index->buildIndex();
-            self->index = (void*)index;
-        }
-        else
-        {
-            my_kd_tree_t_3d* index = new(my_kd_tree_t_3d)(self->dim, *cloud, nanoflann::KDTreeSingleIndexAdaptorParams(10 /* max leaf */) );
-            index->buildIndex();
-            self->index = (void*)index;
-        }	
-    }
+    std::vector<int> indices( num_parts > 0 ? num_parts : 1 );
+    unsigned found;
 
-    size_t ret_index;
-    double out_dist_sqr;
-    nanoflann::KNNResultSet<double> resultSet(num_parts);
-    resultSet.init(&ret_index, &out_dist_sqr );
-    bool found;
+    found = _GeneralSwarm_GetIndex( self )->nearest( coord, num_parts, &indices[0], NULL );
     if(self->dim==2)
-    {
-        my_kd_tree_t_2d* index = (my_kd_tree_t_2d*)self->index;
-        found = index->findNeighbors(resultSet, &coord[0], nanoflann::SearchParams(10)); // note that I believe the value 10 here is ignored.. i'll retain it as it's used in the examples
         Journal_Firewall( found, NULL, (char*) "Unable to find any particles near coordinate (%f,%f).", coord[0], coord[1]);
-    }
     else
-    {
-        my_kd_tree_t_3d* index = (my_kd_tree_t_3d*)self->index;
-        found = index->findNeighbors(resultSet, &coord[0], nanoflann::SearchParams(10)); 
         Journal_Firewall( found, NULL, (char*) "Unable to find any particles near coordinate (%f,%f,%f).", coord[0], coord[1], coord[2]);
+
+    return indices[0];
+}
+
+/* Wraps a malloc'd array as a numpy array which takes ownership of it */
+static PyObject* _GeneralSwarm_NewOwnedArray( int nd, npy_intp* dims, int typenum, void* data )
+{
+    PyObject* pyobj = PyArray_New(&PyArray_Type, nd, dims, typenum, NULL, data, 0, 0, NULL);
+    /* enable the owndata flag.. this tells numpy to dealloc the data when it is finished with it */
+#if NPY_API_VERSION < 0x00000007
+    (((PyArrayObject*)pyobj)->flags) |= NPY_ARRAY_OWNDATA;
+#else
+    PyArray_ENABLEFLAGS((PyArrayObject*)pyobj, NPY_ARRAY_OWNDATA);
+#endif
+    return pyobj;
+}
+
+PyObject* GeneralSwarm_GetClosestParticlesBatch( void* swarm, Index count, Index dim, double* array, int num_parts )
+{
+    GeneralSwarm* self = (GeneralSwarm*)swarm;
+    GeneralSwarm_ParticleIndex* index = _GeneralSwarm_GetIndex( self );
+    unsigned k = num_parts > 0 ? num_parts : 0;
+    int*    indices  = (int*)   malloc( (count*k > 0 ? count*k : 1)*sizeof(int) );
+    double* distSqrs = (double*)malloc( (count*k > 0 ? count*k : 1)*sizeof(double) );
+
+    Journal_Firewall( dim == self->dim, NULL, (char*) "Error in %s: provided coordinates are of dimension %u, but swarm is of dimension %u.",
+                      __func__, dim, self->dim );
+
+    for( Index ii=0; ii<count; ii++ ) {
+        unsigned found = index->nearest( array + ii*dim, k, indices + ii*k, distSqrs + ii*k );
+        /* flag entries which do not exist as there are fewer than k local particles */
+        for( unsigned jj=found; jj<k; jj++ ) {
+            indices [ii*k+jj] = -1;
+            distSqrs[ii*k+jj] = HUGE_VAL;
+        }
+        for( unsigned jj=0; jj<found; jj++ )
+            distSqrs[ii*k+jj] = sqrt( distSqrs[ii*k+jj] );
     }
 
+    npy_intp dims[2] = { count, k };
+    PyObject* pyind  = _GeneralSwarm_NewOwnedArray( 2, dims, NPY_INT,    (void*)indices  );
+    PyObject* pydist = _GeneralSwarm_NewOwnedArray( 2, dims, NPY_DOUBLE, (void*)distSqrs );
+    PyObject* ret = PyTuple_Pack( 2, pyind, pydist );
+    Py_DECREF( pyind );
+    Py_DECREF( pydist );
+    return ret;
+}
+
+PyObject* GeneralSwarm_GetParticlesWithinRadius( void* swarm, Index count, Index dim, double* array, double radius )
+{
+    GeneralSwarm* self = (GeneralSwarm*)swarm;
+    GeneralSwarm_ParticleIndex* index = _GeneralSwarm_GetIndex( self );
+    std::vector< std::pair<double,int> > found;
+    std::vector<int> all;
+    int* offsets = (int*)malloc( (count+1)*sizeof(int) );
+
+    Journal_Firewall( dim == self->dim, NULL, (char*) "Error in %s: provided coordinates are of dimension %u, but swarm is of dimension %u.",
+                      __func__, dim, self->dim );
+
+    offsets[0] = 0;
+    for( Index ii=0; ii<count; ii++ ) {
+        index->withinRadius( array + ii*dim, radius, found );
+        for( size_t jj=0; jj<found.size(); jj++ )
+            all.push_back( found[jj].second );
+        offsets[ii+1] = all.size();
+    }
 
-    return ret_index;
+    int* indices = (int*)malloc( (all.size() ? all.size() : 1)*sizeof(int) );
+    if( all.size() )
+        memcpy( indices, &all[0], all.size()*sizeof(int) );
+
+    npy_intp offdims[1] = { count+1 };
+    npy_intp inddims[1] = { (npy_intp)all.size() };
+    PyObject* pyoff = _GeneralSwarm_NewOwnedArray( 1, offdims, NPY_INT, (void*)offsets );
+    PyObject* pyind = _GeneralSwarm_NewOwnedArray( 1, inddims, NPY_INT, (void*)indices );
+    PyObject* ret = PyTuple_Pack( 2, pyoff, pyind );
+    Py_DECREF( pyoff );
+    Py_DECREF( pyind );
+    return ret;
 }
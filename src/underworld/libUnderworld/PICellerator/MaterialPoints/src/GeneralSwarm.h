@@ -38,8 +38,8 @@ extern const Type GeneralSwarm_Type;
       SwarmVariable*                        particleCoordVariable; /** Set only if a global coord system swarm. */ \
       SwarmMap*                             previousIntSwarmMap; \
       List*                                 intSwarmMapList;  \
-      void*                                 index;            \
-      void*                                 index_int; 
+      void*                                 index;      /** Spatial index for nearest particle queries, built on demand. */ \
+      Bool                                  indexStale; /** Set where particles have changed since the index was last updated. */
  
 struct GeneralSwarm
 {
@@ -95,6 +95,21 @@ unsigned GeneralSwarm_IntegrationPointMap( void* _self, void* intSwarm, unsigned
 
 void GeneralSwarm_ClearSwarmMaps( void* swarm ) ;
 
+/** Marks the particle index as requiring update. The update itself is incremental and deferred until the next query. */
+void GeneralSwarm_InvalidateIndex( void* swarm );
+
+/** Immediately brings the particle index up to date (incrementally), or rebuilds it from scratch. */
+void GeneralSwarm_UpdateIndex( void* swarm );
+void GeneralSwarm_RebuildIndex( void* swarm );
+
+/** Returns a tuple of (indices,distances) arrays, each of shape (count,num_parts), for the num_parts
+ *  closest local particles to each provided coordinate. Missing entries have index -1. */
+PyObject* GeneralSwarm_GetClosestParticlesBatch( void* swarm, Index count, Index dim, double* array, int num_parts );
+
+/** Returns a tuple of (offsets,indices) arrays, where the local particles within the given radius of
+ *  coordinate i are indices[offsets[i]:offsets[i+1]], ordered by distance. */
+PyObject* GeneralSwarm_GetParticlesWithinRadius( void* swarm, Index count, Index dim, double* array, double radius );
+
 #ifdef __cplusplus
 }
 #endif
@@ -60,6 +60,7 @@ SwarmAdvector* _SwarmAdvector_New(  SWARMADVECTOR_DEFARGS  )
 	/* General info */
 
 	/* Virtual Info */
+	self->_calculateTimeDerivs = _SwarmAdvector_TimeDerivs;
 
 	return self;
 }
@@ -311,6 +312,44 @@ Bool _SwarmAdvector_TimeDeriv( void* swarmAdvector, Index array_I, double* timeD
   return True;
 }
 
+void _SwarmAdvector_TimeDerivs( void* swarmAdvector, Index arrayCount, double* timeDerivs, Bool* successFlags ) {
+  SwarmAdvector*       self           = (SwarmAdvector*) swarmAdvector;
+  GeneralSwarm*        swarm          = self->swarm;
+  FeVariable*          velocityField  = (FeVariable*) self->velocityField;
+  Index                componentCount = *self->variable->dataTypeCounts;
+  double*              coords;
+  InterpolationResult* results;
+  Index                array_I;
+
+  // irregular meshes with an ElementCellLayout already use the particle's owning cell as a search hint
+  if( !velocityField->feMesh->isRegular &&
+      Stg_Class_IsInstance(swarm->cellLayout, ElementCellLayout_Type) )
+  {
+    for( array_I = 0; array_I < arrayCount; array_I++ )
+      successFlags[array_I] = _SwarmAdvector_TimeDeriv( self, array_I, timeDerivs + array_I * componentCount );
+    return;
+  }
+
+  // otherwise interpolate the velocity at all particle coordinates in one batch
+  coords  = Memory_Alloc_Array( double, arrayCount * swarm->dim, "coords" );
+  results = Memory_Alloc_Array( InterpolationResult, arrayCount, "results" );
+  for( array_I = 0; array_I < arrayCount; array_I++ )
+    memcpy( coords + array_I * swarm->dim, StgVariable_GetPtrDouble( self->variable, array_I ), swarm->dim * sizeof(double) );
+
+  FeVariable_InterpolateValuesAt( velocityField, arrayCount, coords, timeDerivs, componentCount, results );
+
+  // failures are re-evaluated point-wise by the integrand, which also reports the error
+  for( array_I = 0; array_I < arrayCount; array_I++ ) {
+    double* timeDeriv = timeDerivs + array_I * componentCount;
+
+    successFlags[array_I] = !( results[array_I] == OTHER_PROC || results[array_I] == OUTSIDE_GLOBAL ||
+                               isinf(timeDeriv[0]) || isinf(timeDeriv[1]) || ( swarm->dim == 3 && isinf(timeDeriv[2]) ) );
+  }
+
+  Memory_Free( coords );
+  Memory_Free( results );
+}
+
 Bool _SwarmAdvector_TimeDeriv_Quicker4IrregularMesh( void* swarmAdvector, Index array_I, double* timeDeriv ) {
    SwarmAdvector*      self          = (SwarmAdvector*) swarmAdvector;
    FeVariable*      velocityField = (FeVariable*) self->velocityField;
@@ -72,6 +72,7 @@ void _SwarmAdvector_AssignFromXML( void* shape, Stg_ComponentFactory* cf, void*
 	void _SwarmAdvector_Execute( void* materialSwarm, void* data );
 	void _SwarmAdvector_Destroy( void* materialSwarm, void* data ) ;
 	Bool _SwarmAdvector_TimeDeriv( void* swarmAdvector, Index array_I, double* timeDeriv ) ;
+	void _SwarmAdvector_TimeDerivs( void* swarmAdvector, Index arrayCount, double* timeDerivs, Bool* successFlags ) ;
    Bool _SwarmAdvector_TimeDeriv_Quicker4IrregularMesh( void* swarmAdvector, Index array_I, double* timeDeriv );
 	void _SwarmAdvector_Intermediate( void* swarmAdvector, Index array_I ) ;
 	
@@ -219,14 +219,14 @@ void EscapedRoutine_RemoveParticles( void* escapedRoutine, void* _swarm ) {
 	EscapedRoutine*		self = (EscapedRoutine*) escapedRoutine;
     Swarm*              swarm = (Swarm*) _swarm;
 	Index                 array_I;
-	StandardParticle*     particleToRemove;
 	Particle_Index        particleToRemove_I;
 	
 	StandardParticle*     lastParticle;
 	Cell_Index            lastParticle_CellIndex;
 	Particle_Index        lastParticle_I;
 	Particle_InCellIndex  lastParticle_IndexWithinCell;
-	SizeT                 particleSize        = swarm->particleExtensionMgr->finalSize;
+
+	Swarm_ReleaseCellTables( swarm );
 
 	#if DEBUG
 	if ( Stream_IsPrintableLevel( self->debug, 2 ) ) {
@@ -253,7 +253,6 @@ void EscapedRoutine_RemoveParticles( void* escapedRoutine, void* _swarm ) {
 
 	for ( array_I = self->particlesToRemoveCount - 1 ; array_I < self->particlesToRemoveCount ; array_I-- ) {
 		particleToRemove_I = self->particlesToRemoveList[ array_I ];
-		particleToRemove = Swarm_ParticleAt( swarm, particleToRemove_I );
 
 		Journal_DPrintfL( self->debug, 2, "Removing particle %u\n", particleToRemove_I );
 		
@@ -270,14 +269,14 @@ void EscapedRoutine_RemoveParticles( void* escapedRoutine, void* _swarm ) {
 					particleToRemove_I, lastParticle_I, lastParticle_CellIndex, lastParticle_IndexWithinCell );
 
 			/* Copy over particle */
-			memcpy( particleToRemove, lastParticle, particleSize );
+			Swarm_CopyParticleWithinSwarm( swarm, particleToRemove_I, lastParticle_I );
 			
 			/* Change value in cell particle table to point to new index in array */
 			swarm->cellParticleTbl[lastParticle_CellIndex][ lastParticle_IndexWithinCell ] = particleToRemove_I;
 		}
 
 		/* Initialise memory to zero so it is clear that it's been deleted */
-		memset( lastParticle, 0, particleSize );
+		Swarm_ZeroParticle( swarm, lastParticle_I );
 		swarm->particleLocalCount--;
 	}
 
@@ -88,12 +88,21 @@ PCDVC* _PCDVC_New(  PCDVC_DEFARGS  ) {
     /* Initialise the parent class. Every class has a parent, bar Stg_Component, which needs to be called */
     self = (PCDVC*)_DVCWeights_New(  DVCWEIGHTS_PASSARGS  );
 
-    /* set this to zero here */
-    self->pcdvcvisited = 0;
-
     /* General info */
+    self->vcSize = NULL;
+    self->vcCount = NULL;
+    self->vcList = NULL;
+    self->vcCells = NULL;
+    self->vcParticleSize = 0;
+    self->vcCellsSize = 0;
+    self->deleteList = NULL;
+    self->splitList = NULL;
+    self->listSize = 0;
 
     /* Virtual Info */
+    /* Population control modifies the swarms as it goes, so cells must be done in order, by a single thread */
+    self->_prepare   = NULL;
+    self->threadSafe = False;
 
     return self;
 }
@@ -124,6 +133,14 @@ void _PCDVC_Init( void* pcdvc, GeneralSwarm* mps, double upT, double lowT,
 
 void _PCDVC_Delete( void* pcdvc ) {
     PCDVC* self = (PCDVC*)pcdvc;
+
+    FreeArray( self->vcSize );
+    FreeArray( self->vcCount );
+    FreeArray( self->vcList );
+    FreeArray( self->vcCells );
+    FreeArray( self->deleteList );
+    FreeArray( self->splitList );
+
     /* Delete parent */
     _DVCWeights_Delete( self );
 }
@@ -262,8 +279,8 @@ void splitIntParticleByIndexWithinCell( IntegrationPointsSwarm*  intSwarm, Gener
     IntegrationPoint* intNewParticle;
     GlobalParticle*   matNewParticle;
     Particle_Index    intNewParticle_IndexWithinCell;/* the number of the particle within the cell */
-    IntegrationPoint* intParticleToSplit;
-    GlobalParticle*   matParticleToSplit;
+    Particle_Index    intParticleToSplit_IndexOnCPU;
+    Particle_Index    matParticleToSplit_IndexOnCPU;
     Coord             newCoord;
 
     FeMesh*  mesh = (FeMesh*)((ElementCellLayout*)matSwarm->cellLayout)->mesh;
@@ -273,11 +290,11 @@ void splitIntParticleByIndexWithinCell( IntegrationPointsSwarm*  intSwarm, Gener
     matNewParticle     = (GlobalParticle*)   Swarm_CreateNewParticle( matSwarm, &matNewParticle_IndexOnCPU );
 
     /* Copy particle information */
-    intParticleToSplit = (IntegrationPoint*) Swarm_ParticleInCellAt( intSwarm, lCell_I, intParticleToSplit_IndexWithinCell );
-    matParticleToSplit = (  GlobalParticle*) Swarm_ParticleInCellAt( matSwarm, lCell_I, intParticleToSplit_IndexWithinCell );
+    intParticleToSplit_IndexOnCPU = Swarm_ParticleCellIDtoLocalID( intSwarm, lCell_I, intParticleToSplit_IndexWithinCell );
+    matParticleToSplit_IndexOnCPU = Swarm_ParticleCellIDtoLocalID( matSwarm, lCell_I, intParticleToSplit_IndexWithinCell );
 
-    memcpy( intNewParticle, intParticleToSplit, intSwarm->particleExtensionMgr->finalSize );
-    memcpy( matNewParticle, matParticleToSplit, matSwarm->particleExtensionMgr->finalSize );
+    Swarm_CopyParticleWithinSwarm( intSwarm, intNewParticle_IndexOnCPU, intParticleToSplit_IndexOnCPU );
+    Swarm_CopyParticleWithinSwarm( matSwarm, matNewParticle_IndexOnCPU, matParticleToSplit_IndexOnCPU );
 
     Swarm_AddParticleToCell( intSwarm, lCell_I, intNewParticle_IndexOnCPU );
     Swarm_AddParticleToCell( matSwarm, lCell_I, matNewParticle_IndexOnCPU );
@@ -308,6 +325,57 @@ int compare_ints(const void * _A, const void * _B){
     int *B = (int *) _B;
     if(*A > *B) return 1; else return -1;
 }
+/* Builds, for each particle, the list of grid cells which make up its Voronoi cell. The lists
+   are held in scratch space, and remain valid until the next call. */
+int** _PCDVC_GetVoronoiCellLists( PCDVC* self, struct cell* cells, struct particle* pList, int nump, int nCells, double da, int** VCsize ) {
+    int oneOda = (int)(1.0/da + 0.5);
+    int *count; // count of how many cells each particle owns in the Voronoi diagram.
+    int total;
+    int i;
+
+    if( nump > self->vcParticleSize ){
+        self->vcSize  = ReallocArray( self->vcSize, int, nump );
+        self->vcCount = ReallocArray( self->vcCount, int, nump );
+        self->vcList  = ReallocArray( self->vcList, int*, nump );
+        self->vcParticleSize = nump;
+    }
+    count = self->vcCount;
+    total = 0;
+    for(i=0;i<nump;i++){
+        count[i] = (int)( pList[i].w*oneOda +0.5 ); // add the 0.5 so we don't lose anything from rounding down accidentally
+        self->vcSize[i] = count[i];
+        total += 1 + count[i];
+    }
+    if( total > self->vcCellsSize ){
+        self->vcCells = ReallocArray( self->vcCells, int, total );
+        self->vcCellsSize = total;
+    }
+    total = 0;
+    for(i=0;i<nump;i++){
+        self->vcList[i] = self->vcCells + total;// [i][j] is jth cell owned by particle i
+        total += 1 + count[i];
+    }
+    for(i=0;i<nCells;i++){// traverse the grid
+        /** for total volume of a cell i.e. how many cells a particle owns .. this is actually calculated
+            internally in the Centroids function and could be also accessed by dividing the weight of a particle by 'da'. **/
+        if( count[cells[i].p] > 0 ){// it's possible for the total count to be a little off...this can cause a negative index
+            self->vcList[ cells[i].p ][ count[cells[i].p]-1 ] = i;
+            count[cells[i].p] = count[cells[i].p] - 1;//decrement the count to insert i value into correct slot.
+        }
+    }
+    *VCsize = self->vcSize;
+    return self->vcList;
+}
+
+/* Size the lists of particles to split and delete */
+void _PCDVC_InitialiseLists( PCDVC* self, int nump ) {
+    if( nump > self->listSize ){
+        self->deleteList = ReallocArray( self->deleteList, struct deleteParticle, nump );
+        self->splitList  = ReallocArray( self->splitList, Particle_Index, nump );
+        self->listSize = nump;
+    }
+}
+
 /* Calculate the integration weights for each particle by contructing
    a voronoi diagram in an element in 3D*/
 void _PCDVC_Calculate3D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
@@ -317,9 +385,10 @@ void _PCDVC_Calculate3D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
     /* CoincidentMapper is a special case of the one to one mapper */
     //CoincidentMapper* mapper  = (CoincidentMapper*)(intSwarm->mapper); /* need the mapper after-all to update the material ref */
     Particle_InCellIndex         cParticleCount;
+    DVCWeights_Workspace*        workspace = _DVCWeights_GetWorkspace( (DVCWeights*)self, 0 );
     IntegrationPoint**           particle;
     double dx,dy,dz,da;
-    static struct cell *cells;// the connected grid
+    struct cell *cells;// the connected grid
     struct particle *pList;// particle List
     struct chain *bchain;//boundary chain
     int nump_orig,nump,numx,numy,numz;
@@ -373,28 +442,17 @@ void _PCDVC_Calculate3D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
     dz = (BBZMAX - BBZMIN)/numz;
     da = dx*dy*dz;
 
-    // Construct the grid for the Voronoi cells only once.
-    // If we wanted to call this function again during a job with a different resolution
-    // then we should destroy the grid once we have looped through the whole mesh.
-    // I am assuming we are not going to do that for now.
-    // Easy to implement this anyway, if needed.
-    if(!self->pcdvcvisited){
-        /* The PCDVC class should really be a class the next level up here */
-        /* We should be able to swap out the WeightsCalculator_CalculateAll instead of just setting
-           a pointer inside that function */
-        self->pcdvcvisited++;
-        _DVCWeights_ConstructGrid(&cells,numz,numy,numx,BBXMIN,BBYMIN,BBZMIN,BBXMAX,BBYMAX,BBZMAX);
-    }
+    // The grid and data structures are those of the first (serial) workspace, and are reused between cells.
+    cells = _DVCWeights_GetGrid( (DVCWeights*)self, workspace, 3 );
 
     // init the data structures
     _DVCWeights_InitialiseStructs( (DVCWeights*)self, nump );
     pList = self->pList;
     bchain = self->bchain;
+    particle = workspace->particle;
 
     _DVCWeights_ResetGrid3D(cells,numz*numy*numx);
 
-    particle = (IntegrationPoint**)malloc( (nump)*sizeof(IntegrationPoint*));
-
     // initialize the particle positions to be the local coordinates of the material swarm particles
     // I am assuming the xi's (local coords) are precalculated somewhere and get reset based on material
     // positions each time step.
@@ -444,7 +502,6 @@ void _PCDVC_Calculate3D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
     }
     int *VCsize;
     int **particleVoronoiCellList;
-    int *count; // count of how many cells each particle owns in the Voronoi diagram.
     int flag =0;
     double FEMCEllspan = BBXMAX - BBXMIN;
     /* LOGIC HERE IS BOGUS.  NEED TO HAVE A CLOSER LOOK. DISABLE FOR NOW */
@@ -457,28 +514,9 @@ void _PCDVC_Calculate3D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
 //
 //    }
     if(Inflow && (  ((1.0*nump_orig)/ParticlesPerCell < Thresh) || flag  ) ){
-        int oneOda = (int)(1.0/da + 0.5);
-        int *VCsize=(int *)malloc(sizeof(int)*nump);
         int j;
         int delNum;
-        VCsize=(int *)malloc(sizeof(int)*nump_orig);
-        count=(int *)malloc(sizeof(int)*nump_orig);
         splitCount = 0;
-        particleVoronoiCellList = (int **)malloc(nump_orig * sizeof(int *));// [i][j] is jth cell owned by particle i
-        for(i=0;i<nump_orig;i++){
-            count[i] = (int)( pList[i].w*oneOda +0.5 ); // add the 0.5 so we don't lose anything from rounding down accidentally
-            VCsize[i] = count[i];
-            particleVoronoiCellList[i] = (int *)malloc( ( 1 + count[i] ) * sizeof(int));
-        }
-        for(i=0;i<numx*numy*numz;i++){// traverse the grid
-            /** for total volume of a cell i.e. how many cells a particle owns .. this is actually calculated
-                internally in the Centroids function and could be also accessed by dividing the weight of a particle by 'da'. **/
-            if( count[cells[i].p] > 0 ){// it's possible for the total count to be a little off...this can cause a negative index
-                particleVoronoiCellList[ cells[i].p ][ count[cells[i].p]-1 ] = i;
-                count[cells[i].p] = count[cells[i].p] - 1;//decrement the count to insert i value into correct slot.
-                //countSum++;
-            }
-        }
         // we now have a list of cells from the grid belonging to each particle that make up each Voronoi cell in the Voronoi diagram
         // next lets compare how far our centroids are from the particle positions.
         // this is my criteria for a voronoi cell having a weird shape...too stretched out for example.
@@ -493,11 +531,6 @@ void _PCDVC_Calculate3D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
             splitIntParticleByIndexWithinCell( intSwarm, matSwarm, lCell_I, cells[j].p, xi );
             nump++; splitCount++;
         }
-        for(i=0;i<nump_orig;i++){
-            free(particleVoronoiCellList[i]);
-        }
-        free(particleVoronoiCellList);
-        free(VCsize); free(count);
         //if(splitCount) printf("\n\e[32mnump is now %d splitCount = %d\n",nump,splitCount);
         delNum = nump - ParticlesPerCell;
         if(delNum > 5){
@@ -509,7 +542,6 @@ void _PCDVC_Calculate3D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
             }
         }
         if(splitCount){// then redo Voronoi diagram.
-            free(particle);
 
             if(nump < 3){
                 PCDVC_Firewall( nump, lCell_I, __func__ );
@@ -519,8 +551,7 @@ void _PCDVC_Calculate3D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
             _DVCWeights_InitialiseStructs( (DVCWeights*)self, nump );
             pList = self->pList;
             bchain = self->bchain;
-
-            particle = (IntegrationPoint**)malloc( (nump)*sizeof(IntegrationPoint*));
+            particle = workspace->particle;
 
             // re-initialize the particle positions to be the local coordinates of the material swarm particles
             // could do better here..instead of completely destroying these lists I could append to them I suppose.
@@ -540,31 +571,8 @@ void _PCDVC_Calculate3D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
         nump_orig = nump;
     }// if Inflow && ...
     if(Inflow){
-        int oneOda = (int)(1.0/da + 0.5);
         //recreate the lists.
-        particleVoronoiCellList = (int **)malloc(nump * sizeof(int *));// [i][j] is jth cell owned by particle i
-        //VCsize = (int*)realloc(VCsize,nump_orig);
-        //count = (int*)realloc(count,nump_orig);
-        VCsize=(int *)malloc(sizeof(int)*nump);
-        count=(int *)malloc(sizeof(int)*nump);
-
-        for(i=0;i<nump;i++){
-            count[i] = (int)( pList[i].w*oneOda +0.5 ); // add the 0.5 so we don't lose anything from rounding down accidentally
-            VCsize[i] = count[i];
-            particleVoronoiCellList[i] = (int *)malloc( ( 1 + count[i] ) * sizeof(int));
-        }
-        for(i=0;i<numx*numy*numz;i++){// traverse the grid
-            //count[ cells[i].p ]++;
-            /** for total volume of a cell i.e. how many cells a particle owns .. this is actually calculated
-                internally in the Centroids function and could be also accessed by dividing the weight of a particle by 'da'. **/
-            //if(VCsize[cells[i].p] != 0){// in case a particle is unresolved
-            if( count[cells[i].p] > 0 ){// it's possible for the total count to be a little off...this can cause a negative index
-                particleVoronoiCellList[ cells[i].p ][ count[cells[i].p]-1 ] = i;
-                count[cells[i].p] = count[cells[i].p] - 1;//decrement the count to insert i value into correct slot.
-                //countSum++;
-            }
-            //}
-        }
+        particleVoronoiCellList = _PCDVC_GetVoronoiCellLists( self, cells, pList, nump, numx*numy*numz, da, &VCsize );
     }//if Inflow
     /**************************************/
     /**************************************/
@@ -587,8 +595,9 @@ void _PCDVC_Calculate3D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
 
     /* need a struct for the deleteList because we must sort it by indexOnCPU and delete in reverse order
        so we don't have the potential problem of  deleting a particle from the list that points to the last particle on the swarm */
-    deleteList = (struct deleteParticle*)malloc(nump*sizeof(struct deleteParticle));/* I don't think I am going to let you delete more than half the particles in a given cell */
-    splitList  = (Particle_Index*)malloc(nump*sizeof(Particle_Index));
+    _PCDVC_InitialiseLists( self, nump );
+    deleteList = self->deleteList;
+    splitList  = self->splitList;
     for(i=0;i<nump;i++){
         if(pList[i].w > maxW){ /* maxW = pList[i].w; maxI = i;*/ splitList[splitCount] = i; splitCount++;}
         if(pList[i].w < minW){
@@ -626,14 +635,6 @@ void _PCDVC_Calculate3D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
         splitIntParticleByIndexWithinCell( intSwarm, matSwarm, lCell_I, maxI, xi );
     }
 
-    if(Inflow){
-        for(i=0;i<nump_orig;i++){
-            free(particleVoronoiCellList[i]);
-        }
-        free(particleVoronoiCellList);
-        free(VCsize);
-        free(count);
-    }
     Count = maxDeletions > deleteCount ? deleteCount : maxDeletions;
     for(i=0;i<Count;i++){
         minI = deleteList[i].indexOnCPU;
@@ -644,8 +645,6 @@ void _PCDVC_Calculate3D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
 
     if(delete_flag || split_flag ){/* then we need to redo the Voronoi diagram */
 
-        free(particle);
-
         if(nump < 3){
             PCDVC_Firewall( nump, lCell_I, __func__ );
             Journal_Printf(Journal_Register( Info_Type, (Name)intSwarm->type  ),"WARNING in %s: There are only %d particles in cell (Cell Id=%d)",__func__, nump, lCell_I);
@@ -654,10 +653,9 @@ void _PCDVC_Calculate3D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
         _DVCWeights_InitialiseStructs( (DVCWeights*)self, nump );
         pList = self->pList;
         bchain = self->bchain;
+        particle = workspace->particle;
         //_DVCWeights_ResetGrid3D(&cells,numz*numy*numx);
 
-        particle = (IntegrationPoint**)malloc( (nump)*sizeof(IntegrationPoint*));
-
         // re-initialize the particle positions to be the local coordinates of the material swarm particles
         for(i=0;i<nump;i++){
 
@@ -692,10 +690,6 @@ void _PCDVC_Calculate3D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
 
     }
 
-    free(particle);
-    free(deleteList);
-    free(splitList);
-
 }
 
 /* Calculate the integration weighting for each particle by contructing
@@ -705,10 +699,11 @@ void _PCDVC_Calculate2D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
     IntegrationPointsSwarm*      intSwarm  = (IntegrationPointsSwarm*) _swarm;
     GeneralSwarm*                matSwarm  = (GeneralSwarm*)           self->materialPointsSwarm;
     Particle_InCellIndex         cParticleCount;
+    DVCWeights_Workspace*        workspace = _DVCWeights_GetWorkspace( (DVCWeights*)self, 0 );
     IntegrationPoint**           particle;
 
     double dx,dy,da;
-    static struct cell *cells;// the connected grid
+    struct cell *cells;// the connected grid
     struct particle *pList;
     struct chain *bchain;
     int nump_orig,nump,numx,numy;
@@ -757,29 +752,17 @@ void _PCDVC_Calculate2D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
     dy = (BBYMAX - BBYMIN)/numy;
     da = dx*dy;
 
-    // Construct the grid for the Voronoi cells only once.
-    // If we wanted to call this function again during a job with a different resolution
-    // then we should destroy the grid once we have looped through the whole mesh.
-    // I am assuming we are not going to do that for now.
-    // Easy to implement this anyway, if needed.
-    if(!self->pcdvcvisited){
-        /* The PCDVC class should really be a class the next level up here */
-        /* We should be able to swap out the WeightsCalculator_CalculateAll instead of just setting
-           a pointer inside that function */
-        self->pcdvcvisited++;
-        _DVCWeights_ConstructGrid2D(&cells,numy,numx,BBXMIN,BBYMIN,BBXMAX,BBYMAX);
-    }
-
+    // The grid and data structures are those of the first (serial) workspace, and are reused between cells.
+    cells = _DVCWeights_GetGrid( (DVCWeights*)self, workspace, 2 );
 
     // init the data structures
     _DVCWeights_InitialiseStructs2D( (DVCWeights*)self, nump);
     bchain = self->bchain;
     pList  = self->pList;
+    particle = workspace->particle;
 
     _DVCWeights_ResetGrid2D(cells,numy*numx);
 
-    particle = (IntegrationPoint**)malloc((nump)*sizeof(IntegrationPoint*));
-
     // initialize the particle positions to be the local coordinates of the material swarm particles
     // I am assuming the xi's (local coords) are precalculated somewhere and get reset based on material
     // positions each time step.
@@ -825,7 +808,6 @@ void _PCDVC_Calculate2D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
 //	if(0){
     int *VCsize;
     int **particleVoronoiCellList;
-    int *count; // count of how many cells each particle owns in the Voronoi diagram.
     int flag =0;
     double FEMCEllspan = BBXMAX - BBXMIN;
     /* LOGIC HERE IS BOGUS.  NEED TO HAVE A CLOSER LOOK. DISABLE FOR NOW */
@@ -838,30 +820,10 @@ void _PCDVC_Calculate2D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
 //
 //    }
     if(Inflow && (  ((1.0*nump_orig)/ParticlesPerCell < Thresh) || flag  ) ){
-        int oneOda = (int)(1.0/da + 0.5);
         int j;
         int delNum;
 
-        VCsize=(int *)malloc(sizeof(int)*nump_orig);
-        count=(int *)malloc(sizeof(int)*nump_orig);
         splitCount = 0;
-        particleVoronoiCellList = (int **)malloc(nump_orig * sizeof(int *));// [i][j] is jth cell owned by particle i
-        for(i=0;i<nump_orig;i++){
-            count[i] = (int)( pList[i].w*oneOda +0.5 ); // add the 0.5 so we don't lose anything from rounding down accidentally
-            VCsize[i] = count[i];
-            particleVoronoiCellList[i] = (int *)malloc( ( 1 + count[i] ) * sizeof(int));
-        }
-        for(i=0;i<numx*numy;i++){// traverse the grid
-            //count[ cells[i].p ]++;
-            /** for total volume of a cell i.e. how many cells a particle owns .. this is actually calculated
-                internally in the Centroids function and could be also accessed by dividing the weight of a particle by 'da'. **/
-            if( count[cells[i].p] > 0 ){// it's possible for the total count to be a little off...this can cause a negative index
-                particleVoronoiCellList[ cells[i].p ][ count[cells[i].p]-1 ] = i;
-                count[cells[i].p] = count[cells[i].p] - 1;//decrement the count to insert i value into correct slot.
-                //countSum++;
-            }
-        }
-        //printf("countSum = %d\n",countSum);
         // we now have a list of cells from the grid belonging to each particle that make up each Voronoi cell in the Voronoi diagram
         // next lets compare how far our centroids are from the particle positions.
         // this is my criteria for a voronoi cell having a weird shape...too stretched out for example.
@@ -875,11 +837,6 @@ void _PCDVC_Calculate2D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
             splitIntParticleByIndexWithinCell( intSwarm, matSwarm, lCell_I, cells[j].p, xi );
             nump++; splitCount++;
         }
-        for(i=0;i<nump_orig;i++){
-            free(particleVoronoiCellList[i]);
-        }
-        free(particleVoronoiCellList);
-        free(VCsize); free(count);
         //if(splitCount) printf("\n\e[32mnump is now %d splitCount = %d\n",nump,splitCount);
         delNum = nump - ParticlesPerCell;
         if(delNum > 5){
@@ -892,7 +849,6 @@ void _PCDVC_Calculate2D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
         }
 
         if(splitCount){// then redo Voronoi diagram.
-            free(particle);
 
             if(nump < 3){
                 PCDVC_Firewall( nump, lCell_I, __func__ );
@@ -902,7 +858,7 @@ void _PCDVC_Calculate2D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
             _DVCWeights_InitialiseStructs2D( (DVCWeights*)self, nump);
             pList  = self->pList;
             bchain = self->bchain;
-            particle = (IntegrationPoint**)malloc( (nump)*sizeof(IntegrationPoint*));
+            particle = workspace->particle;
             // re-initialize the particle positions to be the local coordinates of the material swarm particles
             // could do better here..instead of completely destroying these lists I could append to them I suppose.
             for(i=0;i<nump;i++){
@@ -917,25 +873,8 @@ void _PCDVC_Calculate2D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
         nump_orig = nump;
     }// if Inflow && ...
     if(Inflow){
-        int oneOda = (int)(1.0/da + 0.5);
         //recreate the lists.
-        particleVoronoiCellList = (int **)malloc(nump * sizeof(int *));// [i][j] is jth cell owned by particle i
-        VCsize=(int *)malloc(sizeof(int)*nump);
-        count=(int *)malloc(sizeof(int)*nump);
-
-        for(i=0;i<nump;i++){
-            count[i] = (int)( pList[i].w*oneOda +0.5 ); // add the 0.5 so we don't lose anything from rounding down accidentally
-            VCsize[i] = count[i];
-            particleVoronoiCellList[i] = (int *)malloc( ( 1 + count[i] ) * sizeof(int));
-        }
-        for(i=0;i<numx*numy;i++){// traverse the grid
-            /** for total volume of a cell i.e. how many cells a particle owns .. this is actually calculated
-                internally in the Centroids function and could be also accessed by dividing the weight of a particle by 'da'. **/
-            if( count[cells[i].p] > 0 ){// it's possible for the total count to be a little off...this can cause a negative index
-                particleVoronoiCellList[ cells[i].p ][ count[cells[i].p]-1 ] = i;
-                count[cells[i].p] = count[cells[i].p] - 1;//decrement the count to insert i value into correct slot.
-            }
-        }
+        particleVoronoiCellList = _PCDVC_GetVoronoiCellLists( self, cells, pList, nump, numx*numy, da, &VCsize );
     }//if Inflow
     /************************************/
     /************************************/
@@ -959,8 +898,9 @@ void _PCDVC_Calculate2D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
 
     /* need a struct for the deleteList because we must sort it by indexOnCPU and delete in reverse order
        so we don't have the potential problem of  deleting a particle from the list that points to the last particle on the swarm */
-    splitList  = (Particle_Index*)malloc(nump*sizeof(Particle_Index));
-    deleteList = (struct deleteParticle*)malloc(nump*sizeof(struct deleteParticle));/* I don't think I am going to let you delete more than half the particles in a given cell */
+    _PCDVC_InitialiseLists( self, nump );
+    splitList  = self->splitList;
+    deleteList = self->deleteList;
     for(i=0;i<nump;i++){
         if(pList[i].w > maxW){ /* maxW = pList[i].w; maxI = i;*/ splitList[splitCount] = i; splitCount++;}
         if(pList[i].w < minW){
@@ -1005,15 +945,6 @@ void _PCDVC_Calculate2D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
         splitIntParticleByIndexWithinCell( intSwarm, matSwarm, lCell_I, maxI, xi );
     }
 
-    if(Inflow){
-        for(i=0;i<nump_orig;i++){
-            free(particleVoronoiCellList[i]);
-        }
-        free(particleVoronoiCellList);
-        free(VCsize);
-        free(count);
-    }
-
     Count = maxDeletions > deleteCount ? deleteCount : maxDeletions;
     for(i=0;i<Count;i++){
         minI = deleteList[i].indexOnCPU;
@@ -1024,15 +955,14 @@ void _PCDVC_Calculate2D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
     //printf("pList[maxI].w = %lf particle num = %d : %d\n", pList[maxI].w, pList[maxI].index,maxI);
     //printf("pList[minI].w = %lf particle num = %d : %d\n", pList[minI].w, pList[minI].index,minI);
     if(delete_flag || split_flag ){/* then we need to redo the Voronoi diagram */
-        free(particle);
         if(nump < 3){
             PCDVC_Firewall( nump, lCell_I, __func__ );
         }
-        particle = (IntegrationPoint**)malloc((nump)*sizeof(IntegrationPoint*));
         // init the data structures
         _DVCWeights_InitialiseStructs2D( (DVCWeights*)self, nump);
         pList  = self->pList;
         bchain = self->bchain;
+        particle = workspace->particle;
         // re-initialize the particle positions to be the local coordinates of the material swarm particles
         for(i=0;i<nump;i++){
 
@@ -1070,9 +1000,6 @@ void _PCDVC_Calculate2D( void* pcdvc, void* _swarm, Cell_LocalIndex lCell_I ) {
     /* for(k=0;k<nump;k++){ */
 /* 	  printf("::In %s O(%10.7lf %10.7lf) C(%10.7lf %10.7lf) W(%.4lf)\n", __func__, pList[k].x, pList[k].y, pList[k].cx, pList[k].cy, pList[k].w); */
 /*     } */
-    free(particle);
-    free(deleteList);
-    free(splitList);
     /*
       FILE *fp;
       fp=fopen("nump.txt","a");
@@ -50,7 +50,16 @@ extern const Type PCDVC_Type;
     double                CentPosRatio;                                 \
     int                   ParticlesPerCell;                             \
     double                Threshold;                                    \
-    int                   pcdvcvisited;
+    /* scratch space, reused between cells */                          \
+    int*                  vcSize;                                       \
+    int*                  vcCount;                                      \
+    int**                 vcList;                                       \
+    int*                  vcCells;                                      \
+    unsigned              vcParticleSize;                               \
+    unsigned              vcCellsSize;                                  \
+    struct deleteParticle* deleteList;                                  \
+    Particle_Index*       splitList;                                    \
+    unsigned              listSize;
 
 
 struct PCDVC { __PCDVC };
@@ -64,12 +64,25 @@ DVCWeights* _DVCWeights_New(  DVCWEIGHTS_DEFARGS  ) {
     /* General info */
 
     /* Virtual Info */
-    self->visiteddvcweights = 0;
+    self->_prepare   = _DVCWeights_Prepare;
+    self->threadSafe = True;
+
     self->pList = NULL;
     self->bchain  = NULL;
     self->plistSize  = 0;
     self->bchainSize = 0;
 
+    self->workspaceCount = 0;
+    self->workspaces = NULL;
+    _DVCWeights_InitialiseWorkspaces( self, Threads_GetMaxCount() );
+
+    self->reuseUnchangedCells = True;
+    self->cacheSwarm = NULL;
+    self->particleCache = NULL;
+    self->particleCacheSize = 0;
+    self->cellCache = NULL;
+    self->cellCacheSize = 0;
+
     return self;
 }
 
@@ -80,40 +93,53 @@ void _DVCWeights_Init( void* dvcWeights, int *res ) {
     self->resY = res[J_AXIS];
     self->resZ = res[K_AXIS];
 
+    /* Cached results are only valid for the resolution they were calculated at */
+    DVCWeights_InvalidateCache( self );
 }
 
 /*------------------------------------------------------------------------------------------------------------------------
 ** Virtual functions
 */
 
-void _DVCWeights_Delete_bchain( DVCWeights* dvcWeights ) {
-    DVCWeights* self = (DVCWeights*)dvcWeights;
-    if (self->bchain) {
+void _DVCWeights_Delete_bchain( DVCWeights_Workspace* workspace ) {
+    if (workspace->bchain) {
         int i;
-        for(i=0;i<self->bchainSize;i++){
-            free((self->bchain)[i].new_claimed_cells);
-            free((self->bchain)[i].new_bound_cells);
+        for(i=0;i<workspace->bchainSize;i++){
+            free((workspace->bchain)[i].new_claimed_cells);
+            free((workspace->bchain)[i].new_bound_cells);
         }
-        self->bchainSize = 0;
-        free(self->bchain);
-        self->bchain = NULL;
+        workspace->bchainSize = 0;
+        free(workspace->bchain);
+        workspace->bchain = NULL;
     }
 }
-void _DVCWeights_Delete_plist( DVCWeights* dvcWeights ) {
-    DVCWeights* self = (DVCWeights*)dvcWeights;
-    if (self->pList) {
-        free(self->pList);
-        self->pList = NULL;
+void _DVCWeights_Delete_plist( DVCWeights_Workspace* workspace ) {
+    if (workspace->pList) {
+        free(workspace->pList);
+        workspace->pList = NULL;
     }
-    self->plistSize  = 0;
+    workspace->plistSize  = 0;
 }
 
 void _DVCWeights_Delete( void* dvcWeights ) {
     DVCWeights* self = (DVCWeights*)dvcWeights;
-    self->visiteddvcweights = 0;
-    
-    _DVCWeights_Delete_bchain(self);
-    _DVCWeights_Delete_plist(self);
+    unsigned    w_i;
+
+    for( w_i = 0; w_i < self->workspaceCount; w_i++ ) {
+        DVCWeights_Workspace* workspace = &self->workspaces[w_i];
+
+        _DVCWeights_Delete_bchain(workspace);
+        _DVCWeights_Delete_plist(workspace);
+        if( workspace->cells )
+            free( workspace->cells );
+        if( workspace->particle )
+            free( workspace->particle );
+    }
+    FreeArray( self->workspaces );
+    FreeArray( self->particleCache );
+    FreeArray( self->cellCache );
+    self->pList = NULL;
+    self->bchain = NULL;
 
     /* Delete parent */
     _WeightsCalculator_Delete( self );
@@ -168,6 +194,7 @@ void _DVCWeights_AssignFromXML( void* dvcWeights, Stg_ComponentFactory* cf, void
     resolution[ I_AXIS ] = Stg_ComponentFactory_GetUnsignedInt( cf, self->name, (Dictionary_Entry_Key)"resolutionX", defaultResolution  );
     resolution[ J_AXIS ] = Stg_ComponentFactory_GetUnsignedInt( cf, self->name, (Dictionary_Entry_Key)"resolutionY", defaultResolution  );
     resolution[ K_AXIS ] = Stg_ComponentFactory_GetUnsignedInt( cf, self->name, (Dictionary_Entry_Key)"resolutionZ", defaultResolution  );
+    self->reuseUnchangedCells = Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"reuseUnchangedCells", True );
        
     _DVCWeights_Init( self, resolution );
 }
@@ -198,12 +225,11 @@ void _DVCWeights_Destroy( void* dvcWeights, void* data ) {
 void _DVCWeights_GetCentroids3D( struct cell *cells,struct particle *pList,
                                int n, int m, int l,int nump,double vol){
     int i;
-    int *count;
-
-    count=(int *)malloc(sizeof(int)*nump);
+    double count;
 
+    /* The weight holds the count of grid cells owned by each particle, until scaled by the volume below */
     for(i=0;i<nump;i++){
-        count[i] = 0;
+        pList[ i ].w = 0.0;
         pList[ i ].cx = 0.0;
         pList[ i ].cy = 0.0;
         pList[ i ].cz = 0.0;    
@@ -212,44 +238,43 @@ void _DVCWeights_GetCentroids3D( struct cell *cells,struct particle *pList,
         pList[ cells[i].p ].cx += cells[i].x;
         pList[ cells[i].p ].cy += cells[i].y;
         pList[ cells[i].p ].cz += cells[i].z;
-        count[ cells[i].p ]++;//for total volume of a cell
+        pList[ cells[i].p ].w += 1.0;//for total volume of a cell
     }
     for(i=0;i<nump;i++){
-        pList[ i ].w = count[i]*vol;
-        if(count[i] != 0){
-            pList[ i ].cx /= count[i];
-            pList[ i ].cy /= count[i];
-            pList[ i ].cz /= count[i];
+        count = pList[ i ].w;
+        pList[ i ].w = count*vol;
+        if(count != 0){
+            pList[ i ].cx /= count;
+            pList[ i ].cy /= count;
+            pList[ i ].cz /= count;
         } 
     }
-    free(count);
 }
 /** Get centroids of each voronoi region in 2D*/
 void _DVCWeights_GetCentroids2D( struct cell *cells,struct particle *pList,
                                  int n, int m, int nump,double vol){
     int i;
-    int *count;
+    double count;
 
-    count=(int *)malloc(sizeof(int)*nump);
-  
+    /* The weight holds the count of grid cells owned by each particle, until scaled by the volume below */
     for(i=0;i<nump;i++){
-        count[i] = 0;
+        pList[ i ].w = 0.0;
         pList[ i ].cx = 0.0;
         pList[ i ].cy = 0.0;
     }
     for(i=0;i<n*m;i++){
         pList[ cells[i].p ].cx += cells[i].x;
         pList[ cells[i].p ].cy += cells[i].y;
-        count[ cells[i].p ]++;//for total volume of a cell
+        pList[ cells[i].p ].w += 1.0;//for total volume of a cell
     }
     for(i=0;i<nump;i++){
-        pList[ i ].w = count[i]*vol;
-        if(count[i] != 0){
-            pList[ i ].cx /= count[i];
-            pList[ i ].cy /= count[i];
+        count = pList[ i ].w;
+        pList[ i ].w = count*vol;
+        if(count != 0){
+            pList[ i ].cx /= count;
+            pList[ i ].cy /= count;
         } 
     }  
-    free(count);
 }
 
 /** Claim a cell for a particle in the list */
@@ -598,76 +623,104 @@ double _DVCWeights_DistanceTest2D(double x0, double y0, double x1, double y1,dou
 double _DVCWeights_DistanceTest(double x0, double y0, double z0, double x1, double y1, double z1, double x2, double y2, double z2){
     return (x1+x2-x0-x0)*(x1-x2) + (y1+y2-y0-y0)*(y1-y2) + (z1+z2-z0-z0)*(z1-z2);
 }
-/** Allocate the internal structs for the bchain (boundary chain) and the plist (particle list) */
-void _DVCWeights_InitialiseStructs( DVCWeights* self, int nump){
+/** Allocate (or grow) the workspaces, one per thread. Must be called outside of thread parallel regions. */
+void _DVCWeights_InitialiseWorkspaces( DVCWeights* self, unsigned count ) {
+    if (count <= self->workspaceCount)
+        return;
+
+    self->workspaces = ReallocArray( self->workspaces, DVCWeights_Workspace, count );
+    memset( self->workspaces + self->workspaceCount, 0, (count - self->workspaceCount)*sizeof(DVCWeights_Workspace) );
+    self->workspaceCount = count;
+}
+
+/** The workspace used by the given thread */
+DVCWeights_Workspace* _DVCWeights_GetWorkspace( DVCWeights* self, unsigned thread_I ) {
+    Journal_Firewall( thread_I < self->workspaceCount, Journal_Register( Error_Type, (Name)"DVC_Weights" ),
+                      "Error in %s: no workspace allocated for thread %u (%u available)\n", __func__, thread_I, self->workspaceCount );
+    return &self->workspaces[thread_I];
+}
+
+/** The connected grid of the workspace. This is constructed on first use, and reconstructed
+    only if the dimension changes. */
+struct cell* _DVCWeights_GetGrid( DVCWeights* self, DVCWeights_Workspace* workspace, Dimension_Index dim ) {
+    double BBXMIN = -1.0; // the ranges of the local coordinates of a FEM cell.
+    double BBXMAX = 1.0;
+    double BBYMIN = -1.0;
+    double BBYMAX = 1.0;
+    double BBZMIN = -1.0;
+    double BBZMAX = 1.0;
+
+    if (workspace->cells && workspace->cellsDim == dim)
+        return workspace->cells;
+
+    if (workspace->cells)
+        free(workspace->cells);
+    if (dim == 3)
+        _DVCWeights_ConstructGrid(&workspace->cells,self->resZ,self->resY,self->resX,BBXMIN,BBYMIN,BBZMIN,BBXMAX,BBYMAX,BBZMAX);
+    else
+        _DVCWeights_ConstructGrid2D(&workspace->cells,self->resY,self->resX,BBXMIN,BBYMIN,BBXMAX,BBYMAX);
+    workspace->cellsDim = dim;
+
+    return workspace->cells;
+}
+
+/** Allocate the internal structs for the bchain (boundary chain), the plist (particle list) and the
+    particle pointers of a workspace. Only plain malloc is used here, as this may be called from
+    within thread parallel regions. */
+void _DVCWeights_InitialiseWorkspace( DVCWeights_Workspace* workspace, int nump ){
     int i;
-    if (nump > self->bchainSize) {
-        _DVCWeights_Delete_bchain(self);
-        if( (self->bchain = (struct chain *)malloc( nump*sizeof(struct chain ) )) == 0){
+    if (nump > workspace->bchainSize) {
+        _DVCWeights_Delete_bchain(workspace);
+        if( (workspace->bchain = (struct chain *)malloc( nump*sizeof(struct chain ) )) == 0){
             Journal_Firewall( 0 , Journal_Register( Error_Type, (Name)"DVC_Weights" ),
                               "No memory for bchain in '%s'\nCannot continue.\n", __func__);
         }
         for(i=0;i<nump;i++){
-            (self->bchain)[i].new_claimed_cells = (int *)malloc(DVC_INC*sizeof(int));
-            (self->bchain)[i].new_bound_cells = (int *)malloc(DVC_INC*sizeof(int));
-            (self->bchain)[i].new_claimed_cells_malloced = DVC_INC;
-            (self->bchain)[i].new_bound_cells_malloced = DVC_INC;
+            (workspace->bchain)[i].new_claimed_cells = (int *)malloc(DVC_INC*sizeof(int));
+            (workspace->bchain)[i].new_bound_cells = (int *)malloc(DVC_INC*sizeof(int));
+            (workspace->bchain)[i].new_claimed_cells_malloced = DVC_INC;
+            (workspace->bchain)[i].new_bound_cells_malloced = DVC_INC;
         }
-        self->bchainSize = nump;
+        workspace->bchainSize = nump;
     }
 
-    if (nump > self->plistSize) {
-        _DVCWeights_Delete_plist(self);
-        if( (self->pList = (struct particle *)malloc( nump*sizeof(struct particle ) )) == 0){
+    if (nump > workspace->plistSize) {
+        _DVCWeights_Delete_plist(workspace);
+        if( (workspace->pList = (struct particle *)malloc( nump*sizeof(struct particle ) )) == 0){
             Journal_Firewall( 0 , Journal_Register( Error_Type, (Name)"DVC_Weights" ),
                               "No memory for pList in '%s'\nCannot continue.\n", __func__);
         }
-        self->plistSize = nump;
+        workspace->plistSize = nump;
     }
 
-    /* Initialise all particle values to zero */
-    for (i = 0; i < nump; i++) {
-        (self->pList)[i].x  = 0; (self->pList)[i].y  = 0; (self->pList)[i].z  = 0;
-        (self->pList)[i].cx = 0; (self->pList)[i].cy = 0; (self->pList)[i].cz = 0;
-        (self->pList)[i].w = 0;
-        (self->pList)[i].index = 0;
-    }
-}
-/** Allocate the internal structs for the bchain (boundary chain) and the plist (particle list) */
-void _DVCWeights_InitialiseStructs2D( DVCWeights* self, int nump){
-    int i;
-    if (nump > self->bchainSize) {
-        _DVCWeights_Delete_bchain(self);
-        if( (self->bchain = (struct chain *)malloc( nump*sizeof(struct chain ) )) == 0){
+    if (nump > workspace->particleSize) {
+        if (workspace->particle)
+            free(workspace->particle);
+        if( (workspace->particle = (IntegrationPoint **)malloc( nump*sizeof(IntegrationPoint*) )) == 0){
             Journal_Firewall( 0 , Journal_Register( Error_Type, (Name)"DVC_Weights" ),
-                              "No memory for bchain in '%s'\nCannot continue.\n", __func__);
+                              "No memory for particle pointers in '%s'\nCannot continue.\n", __func__);
         }
-        //
-        for(i=0;i<nump;i++){
-            (self->bchain)[i].new_claimed_cells = (int *)malloc(DVC_INC*sizeof(int));
-            (self->bchain)[i].new_bound_cells = (int *)malloc(DVC_INC*sizeof(int));
-            (self->bchain)[i].new_claimed_cells_malloced = DVC_INC;
-            (self->bchain)[i].new_bound_cells_malloced = DVC_INC;
-        }
-        self->bchainSize = nump;
-    }
-    
-    if (nump > self->plistSize) {
-        _DVCWeights_Delete_plist(self);
-        if( (self->pList = (struct particle *)malloc( nump*sizeof(struct particle ) )) == 0){
-            Journal_Firewall( 0 , Journal_Register( Error_Type, (Name)"DVC_Weights" ),
-                              "No memory for pList in '%s'\nCannot continue.\n", __func__);
-        }
-        self->plistSize = nump;
+        workspace->particleSize = nump;
     }
 
     /* Initialise all particle values to zero */
-    for (i = 0; i < nump; i++) {
-        (self->pList)[i].x  = 0; (self->pList)[i].y  = 0;
-        (self->pList)[i].cx = 0; (self->pList)[i].cy = 0;
-        (self->pList)[i].w = 0;
-        (self->pList)[i].index = 0;
-    }
+    memset( workspace->pList, 0, nump*sizeof(struct particle) );
+}
+
+/** Allocate the internal structs for the bchain (boundary chain) and the plist (particle list)
+    of the first (serial) workspace. */
+void _DVCWeights_InitialiseStructs( DVCWeights* self, int nump){
+    DVCWeights_Workspace* workspace = _DVCWeights_GetWorkspace( self, 0 );
+
+    _DVCWeights_InitialiseWorkspace( workspace, nump );
+    self->pList      = workspace->pList;
+    self->bchain     = workspace->bchain;
+    self->plistSize  = workspace->plistSize;
+    self->bchainSize = workspace->bchainSize;
+}
+/** Allocate the internal structs for the bchain (boundary chain) and the plist (particle list) */
+void _DVCWeights_InitialiseStructs2D( DVCWeights* self, int nump){
+    _DVCWeights_InitialiseStructs( self, nump );
 }
 
 /** Create the Voronoi diagram by growing the voronoi cells from the particle locations.
@@ -772,10 +825,11 @@ void _DVCWeights_CreateVoronoi2D( struct chain *bchain, struct particle *pList,
 void _DVCWeights_Calculate3D( void* dvcWeights, void* _swarm, Cell_LocalIndex lCell_I ) {
     DVCWeights*             self            = (DVCWeights*)  dvcWeights;
     Swarm*                       swarm           = (Swarm*) _swarm;
+    DVCWeights_Workspace*        workspace       = _DVCWeights_GetWorkspace( self, Threads_GetIndex() );
     Particle_InCellIndex         cParticleCount;
     IntegrationPoint**           particle;
     double dx,dy,dz,da;
-    static struct cell *cells;// the connected grid
+    struct cell *cells;// the connected grid
     struct particle *pList;// particle List
     struct chain *bchain;//boundary chain
     int nump,numx,numy,numz;
@@ -800,28 +854,15 @@ void _DVCWeights_Calculate3D( void* dvcWeights, void* _swarm, Cell_LocalIndex lC
     dz = (BBZMAX - BBZMIN)/numz;
     da = dx*dy*dz;
         
-    // Construct the grid for the Voronoi cells only once.
-    // If we wanted to call this function again during a job with a different resolution
-    // then we should destroy the grid once we have looped through the whole mesh.
-    // I am assuming we are not going to do that for now.
-    // Easy to implement this anyway, if needed.
-    if(!self->visiteddvcweights){
-        /* The DVCWeights class should really be a class the next level up here */
-        /* We should be able to swap out the WeightsCalculator_CalculateAll instead of just setting
-           a pointer inside that function */
-        self->visiteddvcweights++;
-        _DVCWeights_ConstructGrid(&cells,numz,numy,numx,BBXMIN,BBYMIN,BBZMIN,BBXMAX,BBYMAX,BBZMAX);
-    }
-        
-        
-    // init the data structures
-    _DVCWeights_InitialiseStructs( self, nump );
-    bchain = self->bchain;
-    pList  = self->pList;
+    // The grid and data structures belong to the workspace of the calling thread, and are reused
+    // between cells. The grid is constructed once per workspace.
+    cells = _DVCWeights_GetGrid( self, workspace, 3 );
+    _DVCWeights_InitialiseWorkspace( workspace, nump );
+    bchain   = workspace->bchain;
+    pList    = workspace->pList;
+    particle = workspace->particle;
     _DVCWeights_ResetGrid3D(cells,numz*numy*numx);
         
-    particle = (IntegrationPoint**)malloc(nump*sizeof(IntegrationPoint*));
-        
     // initialize the particle positions to be the local coordinates of the material swarm particles
     // I am assuming the xi's (local coords) are precalculated somewhere and get reset based on material
     // positions each time step.
@@ -845,7 +886,6 @@ void _DVCWeights_Calculate3D( void* dvcWeights, void* _swarm, Cell_LocalIndex lC
         particle[i]->weight = pList[i].w;
 
     }   
-    free(particle);
 }
 
 /* Calculate the integration weighting for each particle by contructing
@@ -853,10 +893,11 @@ void _DVCWeights_Calculate3D( void* dvcWeights, void* _swarm, Cell_LocalIndex lC
 void _DVCWeights_Calculate2D( void* dvcWeights, void* _swarm, Cell_LocalIndex lCell_I ) {
     DVCWeights*             self            = (DVCWeights*)  dvcWeights;
     Swarm*                       swarm           = (Swarm*) _swarm;
+    DVCWeights_Workspace*        workspace       = _DVCWeights_GetWorkspace( self, Threads_GetIndex() );
     Particle_InCellIndex         cParticleCount;
     IntegrationPoint**           particle;
     double dx,dy,da;
-    static struct cell *cells;// the connected grid
+    struct cell *cells;// the connected grid
     struct particle *pList;
     struct chain *bchain;
     int nump,numx,numy;
@@ -877,29 +918,16 @@ void _DVCWeights_Calculate2D( void* dvcWeights, void* _swarm, Cell_LocalIndex lC
     dy = (BBYMAX - BBYMIN)/numy;
     da = dx*dy;
         
-    // Construct the grid for the Voronoi cells only once.
-    // If we wanted to call this function again during a job with a different resolution
-    // then we should destroy the grid once we have looped through the whole mesh.
-    // I am assuming we are not going to do that for now.
-    // Easy to implement this anyway, if needed.
-    if(!self->visiteddvcweights){
-        /* The DVCWeights class should really be a class the next level up here */
-        /* We should be able to swap out the WeightsCalculator_CalculateAll instead of just setting
-           a pointer inside that function */
-        self->visiteddvcweights++;
-        _DVCWeights_ConstructGrid2D(&cells,numy,numx,BBXMIN,BBYMIN,BBXMAX,BBYMAX);
-    }
-        
-        
-    // init the data structures
-    _DVCWeights_InitialiseStructs2D( self, nump );
-    bchain = self->bchain;
-    pList  = self->pList;
+    // The grid and data structures belong to the workspace of the calling thread, and are reused
+    // between cells. The grid is constructed once per workspace.
+    cells = _DVCWeights_GetGrid( self, workspace, 2 );
+    _DVCWeights_InitialiseWorkspace( workspace, nump );
+    bchain   = workspace->bchain;
+    pList    = workspace->pList;
+    particle = workspace->particle;
 
     _DVCWeights_ResetGrid2D(cells,numy*numx);
         
-    particle = (IntegrationPoint**)malloc(nump*sizeof(IntegrationPoint*));
-        
     // initialize the particle positions to be the local coordinates of the material swarm particles
     // I am assuming the xi's (local coords) are precalculated somewhere and get reset based on material
     // positions each time step.
@@ -921,13 +949,119 @@ void _DVCWeights_Calculate2D( void* dvcWeights, void* _swarm, Cell_LocalIndex lC
         particle[i]->weight = pList[i].w;
 
     }   
+}
+
+/* Size the result cache for the swarm. Cached results are discarded if the swarm differs from the
+   one they were calculated for. */
+void _DVCWeights_InitialiseCache( DVCWeights* self, Swarm* swarm ) {
+    unsigned particleCount = swarm->particleLocalCount;
+    unsigned cellCount     = swarm->cellLocalCount;
+    unsigned i;
+
+    if (self->cacheSwarm != (void*)swarm) {
+        DVCWeights_InvalidateCache( self );
+        self->cacheSwarm = swarm;
+    }
+    if (particleCount > self->particleCacheSize) {
+        self->particleCache = ReallocArray( self->particleCache, DVCWeights_ParticleCache, particleCount );
+        for (i = self->particleCacheSize; i < particleCount; i++)
+            self->particleCache[i].cell = (Cell_LocalIndex)-1;
+        self->particleCacheSize = particleCount;
+    }
+    if (cellCount > self->cellCacheSize) {
+        self->cellCache = ReallocArray( self->cellCache, DVCWeights_CellCache, cellCount );
+        memset( self->cellCache + self->cellCacheSize, 0, (cellCount - self->cellCacheSize)*sizeof(DVCWeights_CellCache) );
+        self->cellCacheSize = cellCount;
+    }
+}
+
+/* If the particles of the cell, their order and their local coordinates are exactly those of the
+   previous calculation of the cell, the previous results are restored and True is returned. */
+Bool _DVCWeights_ReuseCell( DVCWeights* self, Swarm* swarm, Cell_LocalIndex lCell_I ) {
+    Particle_InCellIndex      nump = swarm->cellParticleCountTbl[lCell_I];
+    DVCWeights_CellCache*     cellCache;
+    DVCWeights_ParticleCache* entry;
+    Particle_Index            lParticle_I;
+    IntegrationPoint*         particle;
+    unsigned                  i;
+
+    if (lCell_I >= self->cellCacheSize)
+        return False;
+    cellCache = &self->cellCache[lCell_I];
+    if (cellCache->stamp == 0 || cellCache->count != nump)
+        return False;
+
+    for (i = 0; i < nump; i++) {
+        lParticle_I = swarm->cellParticleTbl[lCell_I][i];
+        if (lParticle_I >= self->particleCacheSize)
+            return False;
+        entry = &self->particleCache[lParticle_I];
+        particle = (IntegrationPoint*)Swarm_ParticleAt( swarm, lParticle_I );
+        if (entry->cell != lCell_I || entry->position != i || entry->stamp != cellCache->stamp ||
+            memcmp( entry->inXi, particle->xi, swarm->dim*sizeof(double) ) != 0)
+            return False;
+    }
+
+    for (i = 0; i < nump; i++) {
+        lParticle_I = swarm->cellParticleTbl[lCell_I][i];
+        entry = &self->particleCache[lParticle_I];
+        particle = (IntegrationPoint*)Swarm_ParticleAt( swarm, lParticle_I );
+        memcpy( particle->xi, entry->outXi, swarm->dim*sizeof(double) );
+        particle->weight = entry->weight;
+    }
+    return True;
+}
 
-    free(particle);
+/* Record the inputs and results of the calculation just performed for the cell, which remain in
+   the particle list of the workspace. */
+void _DVCWeights_StoreCell( DVCWeights* self, DVCWeights_Workspace* workspace, Swarm* swarm, Cell_LocalIndex lCell_I ) {
+    Particle_InCellIndex      nump = swarm->cellParticleCountTbl[lCell_I];
+    DVCWeights_CellCache*     cellCache;
+    DVCWeights_ParticleCache* entry;
+    Particle_Index            lParticle_I;
+    struct particle*          p;
+    unsigned                  i;
+
+    if (lCell_I >= self->cellCacheSize)
+        return;
+    cellCache = &self->cellCache[lCell_I];
+    cellCache->count = nump;
+    /* Only particles recorded in this calculation carry the new stamp. Zero is reserved for cells never calculated. */
+    if (++cellCache->stamp == 0)
+        cellCache->stamp = 1;
 
+    for (i = 0; i < nump; i++) {
+        lParticle_I = swarm->cellParticleTbl[lCell_I][i];
+        if (lParticle_I >= self->particleCacheSize) {
+            /* Can't be reused, as one of its particles has no entry */
+            cellCache->count = 0;
+            continue;
+        }
+        entry = &self->particleCache[lParticle_I];
+        p = &workspace->pList[i];
+        entry->inXi[0] = p->x;  entry->inXi[1] = p->y;  entry->inXi[2] = p->z;
+        entry->outXi[0] = p->cx; entry->outXi[1] = p->cy; entry->outXi[2] = p->cz;
+        entry->weight = p->w;
+        entry->cell = lCell_I;
+        entry->position = i;
+        entry->stamp = cellCache->stamp;
+    }
 }
 
 void _DVCWeights_Calculate( void* dvcWeights, void* _swarm, Cell_LocalIndex lCell_I ){
-    Swarm* swarm = (Swarm*) _swarm;
+    DVCWeights*           self      = (DVCWeights*) dvcWeights;
+    Swarm*                swarm     = (Swarm*) _swarm;
+    DVCWeights_Workspace* workspace = _DVCWeights_GetWorkspace( self, Threads_GetIndex() );
+
+    if (self->reuseUnchangedCells) {
+        /* Normally sized by _DVCWeights_Prepare, prior to any threaded loop over cells. */
+        if (self->cacheSwarm != _swarm || swarm->particleLocalCount > self->particleCacheSize || swarm->cellLocalCount > self->cellCacheSize)
+            _DVCWeights_InitialiseCache( self, swarm );
+        if (_DVCWeights_ReuseCell( self, swarm, lCell_I )) {
+            workspace->reusedCount++;
+            return;
+        }
+    }
 
     if(swarm->dim == 3){
         _DVCWeights_Calculate3D( dvcWeights, _swarm, lCell_I);
@@ -935,9 +1069,74 @@ void _DVCWeights_Calculate( void* dvcWeights, void* _swarm, Cell_LocalIndex lCel
     else {
         _DVCWeights_Calculate2D( dvcWeights, _swarm, lCell_I);
     }
+    workspace->calculatedCount++;
+
+    if (self->reuseUnchangedCells)
+        _DVCWeights_StoreCell( self, workspace, swarm, lCell_I );
+}
+
+/* Called (serially) before a loop over all cells. All shared state is sized here, so that cells may
+   then be calculated concurrently. */
+void _DVCWeights_Prepare( void* dvcWeights, void* _swarm ) {
+    DVCWeights*          self  = (DVCWeights*) dvcWeights;
+    Swarm*               swarm = (Swarm*) _swarm;
+    Particle_InCellIndex maxCount = 0;
+    Cell_LocalIndex      lCell_I;
+    unsigned             w_i;
+
+    for ( lCell_I = 0 ; lCell_I < swarm->cellLocalCount ; lCell_I++ ) {
+        Journal_Firewall( swarm->cellParticleCountTbl[lCell_I], Journal_Register( Error_Type, (Name)"DVC_Weights" ),
+                          "Error in %s: Problem has an under resolved cell (Cell Id = %d), add more particles to your model\n", __func__, lCell_I );
+        if ( swarm->cellParticleCountTbl[lCell_I] > maxCount )
+            maxCount = swarm->cellParticleCountTbl[lCell_I];
+    }
+
+    _DVCWeights_InitialiseWorkspaces( self, Threads_GetMaxCount() );
+    for ( w_i = 0; w_i < self->workspaceCount; w_i++ )
+        _DVCWeights_InitialiseWorkspace( &self->workspaces[w_i], maxCount );
+
+    if (self->reuseUnchangedCells)
+        _DVCWeights_InitialiseCache( self, swarm );
 }
+
 /*-------------------------------------------------------------------------------------------------------------------------
 ** Public Functions
 */
 
+void DVCWeights_InvalidateCache( void* dvcWeights ) {
+    DVCWeights* self = (DVCWeights*) dvcWeights;
+
+    if (self->cellCache)
+        memset( self->cellCache, 0, self->cellCacheSize*sizeof(DVCWeights_CellCache) );
+    self->cacheSwarm = NULL;
+}
+
+unsigned long DVCWeights_GetCalculatedCellCount( void* dvcWeights ) {
+    DVCWeights*   self  = (DVCWeights*) dvcWeights;
+    unsigned long count = 0;
+    unsigned      w_i;
+
+    for ( w_i = 0; w_i < self->workspaceCount; w_i++ )
+        count += self->workspaces[w_i].calculatedCount;
+    return count;
+}
+
+unsigned long DVCWeights_GetReusedCellCount( void* dvcWeights ) {
+    DVCWeights*   self  = (DVCWeights*) dvcWeights;
+    unsigned long count = 0;
+    unsigned      w_i;
+
+    for ( w_i = 0; w_i < self->workspaceCount; w_i++ )
+        count += self->workspaces[w_i].reusedCount;
+    return count;
+}
+
+void DVCWeights_ResetStats( void* dvcWeights ) {
+    DVCWeights* self = (DVCWeights*) dvcWeights;
+    unsigned    w_i;
 
+    for ( w_i = 0; w_i < self->workspaceCount; w_i++ ) {
+        self->workspaces[w_i].calculatedCount = 0;
+        self->workspaces[w_i].reusedCount = 0;
+    }
+}
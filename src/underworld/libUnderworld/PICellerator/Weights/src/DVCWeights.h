@@ -16,6 +16,37 @@
 /* Textual name of this class */
 extern const Type DVCWeights_Type;
 
+/* Scratch space used by a single thread while computing the weights of a cell. Each thread
+   uses its own workspace, so that cells may be computed concurrently. */
+typedef struct {
+    struct particle   *pList;
+    struct chain      *bchain;
+    unsigned          plistSize;
+    unsigned          bchainSize;
+    struct cell       *cells;        /* the connected grid, constructed on first use */
+    Dimension_Index   cellsDim;      /* dimension the grid was constructed for */
+    IntegrationPoint  **particle;
+    unsigned          particleSize;
+    unsigned long     calculatedCount;
+    unsigned long     reusedCount;
+} DVCWeights_Workspace;
+
+/* Inputs and results of the most recent calculation for each particle, used to skip cells
+   whose particles (and their local coordinates) have not changed. */
+typedef struct {
+    double               inXi[3];
+    double               outXi[3];
+    double               weight;
+    Cell_LocalIndex      cell;
+    Particle_InCellIndex position;
+    unsigned             stamp;
+} DVCWeights_ParticleCache;
+
+typedef struct {
+    Particle_InCellIndex count;
+    unsigned             stamp;
+} DVCWeights_CellCache;
+
 /* DVCWeights information */
 #define __DVCWeights                            \
     /* General info */                          \
@@ -30,7 +61,7 @@ extern const Type DVCWeights_Type;
     double dx; \
     double dy; \
     double dz; \
-    int visiteddvcweights;                      \
+    /* pList and bchain alias those of the first (serial) workspace */ \
     struct particle   *pList;                   \
     struct chain      *bchain;                  \
     struct cell       *cells;                   \
@@ -38,6 +69,14 @@ extern const Type DVCWeights_Type;
     unsigned    bchainSize;                     \
     double      bbmin;                          \
     double      bbmax;                          \
+    DVCWeights_Workspace*      workspaces;      \
+    unsigned                   workspaceCount;  \
+    Bool                       reuseUnchangedCells; \
+    void*                      cacheSwarm;      \
+    DVCWeights_ParticleCache*  particleCache;   \
+    unsigned                   particleCacheSize; \
+    DVCWeights_CellCache*      cellCache;       \
+    unsigned                   cellCacheSize;   \
 
 struct DVCWeights { __DVCWeights };
         
@@ -113,6 +152,10 @@ void   _DVCWeights_ConstructGrid(
     double x0, double y0, double z0,
     double x1, double y1, double z1);
 void   _DVCWeights_InitialiseStructs( DVCWeights* self, int nump);
+void   _DVCWeights_InitialiseWorkspaces( DVCWeights* self, unsigned count );
+DVCWeights_Workspace* _DVCWeights_GetWorkspace( DVCWeights* self, unsigned thread_I );
+void   _DVCWeights_InitialiseWorkspace( DVCWeights_Workspace* workspace, int nump );
+struct cell* _DVCWeights_GetGrid( DVCWeights* self, DVCWeights_Workspace* workspace, Dimension_Index dim );
 void   _DVCWeights_CreateVoronoi3D( 
     struct chain *bchain, 
     struct particle *pList, 
@@ -214,6 +257,19 @@ void _DVCWeights_Execute( void* dvcWeights, void* data );
 void _DVCWeights_Destroy( void* dvcWeights, void* data );
                 
 void _DVCWeights_Calculate( void* dvcWeights, void* _swarm, Cell_LocalIndex lCell_I ) ;
+void _DVCWeights_Prepare( void* dvcWeights, void* _swarm ) ;
+
+/*---------------------------------------------------------------------------------------------------------------------
+** Public functions
+*/
+
+/** Forgets all cached cell results, so that every cell is recalculated on the next pass. */
+void DVCWeights_InvalidateCache( void* dvcWeights );
+
+/** Number of cells whose Voronoi diagram was calculated, and number reused from the previous pass. */
+unsigned long DVCWeights_GetCalculatedCellCount( void* dvcWeights );
+unsigned long DVCWeights_GetReusedCellCount( void* dvcWeights );
+void DVCWeights_ResetStats( void* dvcWeights );
 
 #endif
 
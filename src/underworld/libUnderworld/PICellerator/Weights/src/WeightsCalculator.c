@@ -38,6 +38,10 @@ WeightsCalculator* _WeightsCalculator_New(  WEIGHTSCALCULATOR_DEFARGS  ) {
 
     /* Virtual Info */
     self->_calculate      = _calculate;
+    self->_prepare        = NULL;
+
+    self->threadSafe          = False;
+    self->threadedCalculation = False;
 
     return self;
 }
@@ -73,7 +77,11 @@ void* _WeightsCalculator_Copy( void* weightsCalculator, void* dest, Bool deep, N
 
 
 
-void _WeightsCalculator_AssignFromXML( void* weightsCalculator, Stg_ComponentFactory* cf, void* data ) {}
+void _WeightsCalculator_AssignFromXML( void* weightsCalculator, Stg_ComponentFactory* cf, void* data ) {
+    WeightsCalculator*  self = (WeightsCalculator*)weightsCalculator;
+
+    self->threadedCalculation = Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"threadedCalculation", False );
+}
 
 void _WeightsCalculator_Build( void* weightsCalculator, void* data ) {
 /*      WeightsCalculator*      self = (WeightsCalculator*)weightsCalculator; */
@@ -111,6 +119,18 @@ void WeightsCalculator_CalculateCell( void* weightsCalculator, void* swarm, Cell
 */
 
 
+/* Arguments of _WeightsCalculator_CalculateCellOf, which calculates cells over threads. */
+typedef struct {
+    WeightsCalculator* self;
+    Swarm*             swarm;
+} WeightsCalculator_CellLoop;
+
+static void _WeightsCalculator_CalculateCellOf( void* data, int cell_I ) {
+    WeightsCalculator_CellLoop* loop = (WeightsCalculator_CellLoop*)data;
+
+    WeightsCalculator_CalculateCell( loop->self, loop->swarm, cell_I );
+}
+
 void WeightsCalculator_CalculateAll( void* weightsCalculator, void* _swarm ) {
     WeightsCalculator*   self           = (WeightsCalculator*)weightsCalculator;
     Swarm*               swarm          = (Swarm*) _swarm;
@@ -122,19 +142,34 @@ void WeightsCalculator_CalculateAll( void* weightsCalculator, void* _swarm ) {
     Cell_Index           nextCompletedCellCountToPrint=0;
     Cell_Index           nextPlusOneCompletedCellCountToPrint=0;
     Stream*              stream = Journal_Register( Info_Type, (Name)self->type  );
+    Bool                 threaded;
 
     Journal_RPrintf( stream, "In func %s(): for swarm \"%s\"\n", __func__, swarm->name );
     Stream_Indent( stream );
     Stream_SetPrintingRank( stream, 0 );
 
+    if ( self->_prepare )
+        self->_prepare( self, swarm );
+
     nextCompletionRatioToPrint = completionRatioIncrement;
     nextCompletedCellCountToPrint = ceil(cellLocalCount * nextCompletionRatioToPrint - 0.001 );
 
+    /* Only thread where requested, and where the calculator allows it. */
+    threaded = False;
+#ifdef HAVE_OPENMP
+    threaded = self->threadedCalculation && self->threadSafe && Threads_GetMaxCount() > 1;
+    if ( threaded ) {
+        WeightsCalculator_CellLoop loop = { self, swarm };
+
+        Threads_ParallelFor( (int)cellLocalCount, Threads_GetMaxCount(), _WeightsCalculator_CalculateCellOf, &loop );
+        Journal_Printf( stream, "done 100%% (%u cells)...\n", cellLocalCount );
+    }
+    else
+#endif
     /* Loop over all local cells */
     for ( lCell_I = 0 ; lCell_I < cellLocalCount ; lCell_I++ ) {
 /*              WeightsCalculator_CheckEmptyCell( self, swarm, lCell_I );*/
         WeightsCalculator_CalculateCell( self, swarm, lCell_I );
-/*               TODO: parallelise */
 
         if ( (lCell_I+1) >= nextCompletedCellCountToPrint ) {
             nextPlusOneCompletedCellCountToPrint = ceil(( cellLocalCount
@@ -12,6 +12,7 @@
 #define __PICellerator_Weights_WeightsCalculator_h__
 
 typedef void (WeightsCalculator_CalculateFunction)( void* self, void* swarm, Cell_LocalIndex lCell_I );
+typedef void (WeightsCalculator_PrepareFunction)( void* self, void* swarm );
 
 /* Textual name of this class */
 extern const Type WeightsCalculator_Type;
@@ -24,7 +25,12 @@ extern const Type WeightsCalculator_Type;
 	/* Virtual Info */ \
 	FiniteElementContext*						context; \
 	WeightsCalculator_CalculateFunction*  _calculate; \
-	/* Other Info */ 
+	/* Optional, called before calculating all cells. Must leave _calculate safe to call concurrently \
+	   where threadSafe is set. */ \
+	WeightsCalculator_PrepareFunction*    _prepare; \
+	/* Other Info */ \
+	Bool                                  threadSafe; \
+	Bool                                  threadedCalculation;
 
 	struct WeightsCalculator { __WeightsCalculator };
         
@@ -198,6 +198,8 @@ PetscErrorCode  KSPSolve_BSSCR(KSP ksp)
     }
 
     if( (bsscr->k2type != 0) ){
+      if( SLE->kStiffMat->matrixFree )
+            Stg_SETERRQ( PETSC_ERR_SUP, "Augmented lagrangian (penalty) terms need an assembled K, not a matrix-free one" );
       if(bsscr->buildK2 != PETSC_NULL) {
             (*bsscr->buildK2)(ksp); /* building K2 from scaled version of stokes operators: K2 lives on bsscr struct = ksp->data */
         }
@@ -230,7 +232,19 @@ PetscErrorCode  KSPSolve_BSSCR(KSP ksp)
     /***** END SOLVE!! ****************************************/
     /**********************************************************/
     if( bsscr->do_scaling ){
-        (*bsscr->unscale)(ksp);  }
+        (*bsscr->unscale)(ksp);
+        /* Scaling then unscaling in place does not restore the values exactly, so operators which
+           would otherwise reuse their values (assembleOnce) are reassembled on the next solve, rather
+           than accumulating round-off across solves. */
+        StiffnessMatrix_SetValuesModified( SLE->kStiffMat );
+        StiffnessMatrix_SetValuesModified( SLE->gStiffMat );
+        if( SLE->dStiffMat )
+            StiffnessMatrix_SetValuesModified( SLE->dStiffMat );
+        if( SLE->cStiffMat )
+            StiffnessMatrix_SetValuesModified( SLE->cStiffMat );
+        if( ((StokesBlockKSPInterface*)SLE->solver)->preconditioner )
+            StiffnessMatrix_SetValuesModified( ((StokesBlockKSPInterface*)SLE->solver)->preconditioner );
+    }
     if( (bsscr->k2type != 0) && bsscr->K2 != PETSC_NULL ){
         if(bsscr->k2type != K2_SLE){/* don't destroy here, as in this case, K2 is just pointing to an existing matrix on the SLE */
             Stg_MatDestroy(&bsscr->K2 );
@@ -350,6 +364,10 @@ PetscErrorCode KSPSetUp_BSSCR(KSP ksp)
         PetscPrintf( PETSC_COMM_WORLD, "\t* Not applying scaling to matrices as MatGetRowMax operation not defined for MATAIJMUMPS matrix type \n");
         scale = PETSC_FALSE;
     }
+    if(stokesSLE->kStiffMat->matrixFree && scale){
+        PetscPrintf( PETSC_COMM_WORLD, "\t* Not applying scaling to matrices as row and column operations are not defined for a matrix-free K \n");
+        scale = PETSC_FALSE;
+    }
     if( scale ) {
         bsscr->scale       = KSPScale_BSSCR;
         bsscr->unscale     = KSPUnscale_BSSCR;
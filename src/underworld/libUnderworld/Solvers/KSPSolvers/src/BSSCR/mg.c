@@ -70,11 +70,21 @@ PetscErrorCode MG_inner_solver_pcmg_setup(KSP_BSSCR *bsscrp_self,
   // PCMGSetType(pc_MG, PC_MG_MULTIPLICATIVE); /* Breaks the accelrating MG */
 
   PCMGSetType(pc_MG, PC_MG_KASKADE);
+  /* A matrix-free K has no entries for PETSc to form the coarse operators
+     from, so they are built from its elements below instead. */
+  if (StiffnessMatrix_GetMatrixFreeOwner(K)) {
+#if ((PETSC_VERSION_MAJOR == 3) && (PETSC_VERSION_MINOR >= 8))
+    PCMGSetGalerkin(pc_MG, PC_MG_GALERKIN_NONE);
+#elif ((PETSC_VERSION_MAJOR == 3) && (PETSC_VERSION_MINOR >= 2))
+    PCMGSetGalerkin(pc_MG, PETSC_FALSE);
+#endif
+  } else {
 #if ((PETSC_VERSION_MAJOR == 3) && (PETSC_VERSION_MINOR >= 2))
-  PCMGSetGalerkin(pc_MG, PETSC_TRUE);
+    PCMGSetGalerkin(pc_MG, PETSC_TRUE);
 #else
-  PCMGSetGalerkin(pc_MG);
+    PCMGSetGalerkin(pc_MG);
 #endif
+  }
   PCSetFromOptions(pc_MG);
 
   Stg_KSPSetOperators(ksp_inner, K, K, DIFFERENT_NONZERO_PATTERN);
@@ -85,6 +95,11 @@ PetscErrorCode MG_inner_solver_pcmg_setup(KSP_BSSCR *bsscrp_self,
   mgCtx->pc = pc_MG;
 
   PETScMGSolver_UpdateOps(bsscrp_self->mg);
+  if (StiffnessMatrix_GetMatrixFreeOwner(K)) {
+    bsscrp_self->mg->mgData->matrix = K;
+    PETScMGSolver_UpdateMatrices(bsscrp_self->mg);
+  }
+  PETScMGSolver_UpdateTelescoping(bsscrp_self->mg);
 
   /* If we are using dynamically adjusting smoother settings then
      this is implemented as a KSPMonitor (with side-effects)*/
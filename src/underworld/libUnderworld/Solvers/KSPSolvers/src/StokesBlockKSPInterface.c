@@ -323,7 +323,13 @@ PetscErrorCode _BlockSolve( void* solver, void* _stokesSLE ) {
 
   /* create Gt */
   if( !D ) {
-    ierr = MatTranspose( G, MAT_INITIAL_MATRIX, &Gt);CHKERRQ(ierr);
+    /* A matrix-free G has no entries to transpose, but applies its transpose directly. */
+    if( StiffnessMatrix_GetMatrixFreeOwner( G ) ) {
+      ierr = MatCreateTranspose( G, &Gt);CHKERRQ(ierr);
+    }
+    else {
+      ierr = MatTranspose( G, MAT_INITIAL_MATRIX, &Gt);CHKERRQ(ierr);
+    }
     sym = PETSC_TRUE;
     Solver->DIsSym = sym;
   }
@@ -241,6 +241,112 @@ void MPIArray_Alltoall( unsigned* arraySizes, void** arrays,
 	FreeArray( tmpDstArray1D );
 }
 
+/* The count of sparse exchanges made on each communicator, cached as an attribute. */
+static int MPIArray_SparseKey = MPI_KEYVAL_INVALID;
+
+static int _MPIArray_SparseDelete( MPI_Comm comm, int key, void* attr, void* extra ) {
+	free( attr );
+	return MPI_SUCCESS;
+}
+
+/* Successive exchanges on a communicator alternate between two tags. A processor may leave the barrier and
+ * start the next exchange before others have noticed the barrier complete, but can get no further ahead. */
+static int _MPIArray_SparseTag( MPI_Comm comm ) {
+	void*	attr;
+	int	found;
+	int*	count;
+
+	if( MPIArray_SparseKey == MPI_KEYVAL_INVALID )
+		MPI_Comm_create_keyval( MPI_COMM_NULL_COPY_FN, _MPIArray_SparseDelete, &MPIArray_SparseKey, NULL );
+	MPI_Comm_get_attr( comm, MPIArray_SparseKey, &attr, &found );
+	if( found )
+		count = (int*)attr;
+	else {
+		/* not from the Memory module, as the attribute may outlive it */
+		count = (int*)malloc( sizeof(int) );
+		*count = 0;
+		MPI_Comm_set_attr( comm, MPIArray_SparseKey, count );
+	}
+	(*count)++;
+	return 4004 + (*count & 1);
+}
+
+void MPIArray_SparseExchange( unsigned nDsts, const int* dstRanks, unsigned* arraySizes, void** arrays, 
+			      unsigned* nSrcs, int** srcRanks, unsigned** srcSizes, void*** srcArrays, 
+			      size_t itemSize, MPI_Comm comm )
+{
+	int		tag = _MPIArray_SparseTag( comm );
+	MPI_Request*	sends;
+	MPI_Request	barrier;
+	Bool		barrierActive = False;
+	MPI_Status	status;
+	unsigned	nRecvd = 0, maxRecvd = 0;
+	int		flag, nBytes;
+	unsigned	d_i, s_i, s_j;
+
+	assert( !nDsts || (dstRanks && arraySizes && arrays) );
+	assert( nSrcs && srcRanks && srcSizes && srcArrays && itemSize );
+
+	*srcRanks = NULL;
+	*srcSizes = NULL;
+	*srcArrays = NULL;
+
+	/* A synchronous send completes only once matched, so once this processor's sends are done and every
+	   processor has entered the barrier, nothing remains in flight. */
+	sends = Memory_Alloc_Array_Unnamed( MPI_Request, nDsts + 1 );
+	for( d_i = 0; d_i < nDsts; d_i++ ) {
+		MPI_Issend( arrays[d_i], (int)(arraySizes[d_i] * itemSize), MPI_BYTE, dstRanks[d_i], tag, 
+			    comm, sends + d_i );
+	}
+	for( ;; ) {
+		MPI_Iprobe( MPI_ANY_SOURCE, tag, comm, &flag, &status );
+		if( flag ) {
+			if( nRecvd == maxRecvd ) {
+				maxRecvd = maxRecvd ? 2 * maxRecvd : 8;
+				*srcRanks = Memory_Realloc_Array( *srcRanks, int, maxRecvd );
+				*srcSizes = Memory_Realloc_Array( *srcSizes, unsigned, maxRecvd );
+				*srcArrays = Memory_Realloc_Array( *srcArrays, void*, maxRecvd );
+			}
+			MPI_Get_count( &status, MPI_BYTE, &nBytes );
+			(*srcRanks)[nRecvd] = status.MPI_SOURCE;
+			(*srcSizes)[nRecvd] = (unsigned)(nBytes / itemSize);
+			(*srcArrays)[nRecvd] = Memory_Alloc_Bytes_Unnamed( nBytes ? nBytes : 1, "unknown" );
+			MPI_Recv( (*srcArrays)[nRecvd], nBytes, MPI_BYTE, status.MPI_SOURCE, tag, comm, MPI_STATUS_IGNORE );
+			nRecvd++;
+		}
+		if( !barrierActive ) {
+			MPI_Testall( (int)nDsts, sends, &flag, MPI_STATUSES_IGNORE );
+			if( flag ) {
+				MPI_Ibarrier( comm, &barrier );
+				barrierActive = True;
+			}
+		}
+		else {
+			MPI_Test( &barrier, &flag, MPI_STATUS_IGNORE );
+			if( flag )
+				break;
+		}
+	}
+	FreeArray( sends );
+
+	/* Order by source, as arrival order varies from run to run. */
+	for( s_i = 1; s_i < nRecvd; s_i++ ) {
+		int		rank = (*srcRanks)[s_i];
+		unsigned	size = (*srcSizes)[s_i];
+		void*		array = (*srcArrays)[s_i];
+
+		for( s_j = s_i; s_j > 0 && (*srcRanks)[s_j - 1] > rank; s_j-- ) {
+			(*srcRanks)[s_j] = (*srcRanks)[s_j - 1];
+			(*srcSizes)[s_j] = (*srcSizes)[s_j - 1];
+			(*srcArrays)[s_j] = (*srcArrays)[s_j - 1];
+		}
+		(*srcRanks)[s_j] = rank;
+		(*srcSizes)[s_j] = size;
+		(*srcArrays)[s_j] = array;
+	}
+	*nSrcs = nRecvd;
+}
+
 void Array_1DTo2D( unsigned nBlocks, unsigned* sizes, void* srcArray, 
 		   void*** dstArrays, size_t itemSize )
 {
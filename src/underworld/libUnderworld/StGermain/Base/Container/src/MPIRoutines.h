@@ -26,6 +26,14 @@ void MPIArray_Alltoall( unsigned* arraySizes, void** arrays,
 			unsigned** dstSizes, void*** dstArrays, 
 			size_t itemSize, MPI_Comm comm );
 
+/* Sends arrays[d] (arraySizes[d] items) to processor dstRanks[d], for each of nDsts destinations, and
+ * receives whatever other processors send here. Sources need not be known in advance; they are found with
+ * synchronous sends and a non-blocking barrier, so no array of size nProcs is needed. The received arrays
+ * are returned in ascending order of source rank, each allocated separately. Must be called collectively. */
+void MPIArray_SparseExchange( unsigned nDsts, const int* dstRanks, unsigned* arraySizes, void** arrays, 
+			      unsigned* nSrcs, int** srcRanks, unsigned** srcSizes, void*** srcArrays, 
+			      size_t itemSize, MPI_Comm comm );
+
 void Array_1DTo2D( unsigned nBlocks, unsigned* sizes, void* srcArray, 
 		   void*** dstArrays, size_t itemSize );
 
@@ -85,6 +85,26 @@ unsigned int StG_IntegerLength( int number ) {
 	
 
 
+unsigned long long StG_MortonKey( unsigned nDims, const unsigned* inds ) {
+	unsigned long long key = 0;
+	unsigned nBits;
+	unsigned b_i, d_i;
+
+	assert( nDims >= 1 && nDims <= 3 );
+	assert( inds );
+
+	nBits = 64 / nDims;
+	if( nBits > 32 )
+		nBits = 32;
+	for( b_i = 0; b_i < nBits; b_i++ ) {
+		for( d_i = 0; d_i < nDims; d_i++ )
+			key |= ((unsigned long long)((inds[d_i] >> b_i) & 1u)) << (b_i * nDims + d_i);
+	}
+
+	return key;
+}
+
+
 char* StG_Strdup( const char* const str ) {
 	int length;
 	char* result;
@@ -24,6 +24,10 @@
 	/** Counts the number of characters required to display the given base 10 value. */
 	unsigned int StG_IntegerLength( int number );
 
+	/** Computes the Morton (Z-order) space-filling-curve key of a 2D or 3D integer index by interleaving its bits.
+	 *  Only the lowest 32 bits (2D) or 21 bits (3D) of each index contribute to the key. */
+	unsigned long long StG_MortonKey( unsigned nDims, const unsigned* inds );
+
 	/** StGermain's version of strdup() which uses Memory Module */
 	char* StG_Strdup( const char* const str );
 
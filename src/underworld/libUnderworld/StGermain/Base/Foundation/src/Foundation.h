@@ -16,6 +16,7 @@
 	#include "debug.h"
 	#include "CommonRoutines.h"
 	#include "Memory.h"
+	#include "MemoryAccounting.h"
 	#include "Class.h"
 	#include "Object.h"
 	#include "ObjectAdaptor.h"
@@ -23,6 +24,7 @@
 	#include "NamedObject_Register.h"
 	#include "TimeMonitor.h"
 	#include "Numerics.h"
+	#include "Threads.h"
 	#include "Init.h"
 	#include "Finalise.h"
 	#include "Log.h"
@@ -9,7 +9,9 @@
 
 #include "types.h"
 #include "Memory.h"
+#include "MemoryAccounting.h"
 #include "TimeMonitor.h"
+#include "Threads.h"
 #include "Init.h"
 
 #include <stdio.h>
@@ -22,6 +24,8 @@ const int DEFAULT_LIST_DELTA = 8;
 Bool BaseFoundation_Init( int* argc, char** argv[] ) {
 
 	Stg_TimeMonitor_Initialise();
+	Threads_Initialise();
+	MemoryAccounting_Initialise();
 	
 	return True;
 }
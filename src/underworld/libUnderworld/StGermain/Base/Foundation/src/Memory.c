@@ -19,6 +19,7 @@
 #include "forwardDecl.h"
 
 #include "Memory.h"
+#include "MemoryAccounting.h"
 
 
 #ifndef MAX
@@ -66,6 +67,13 @@ void Memory_Relocate_3DArrayData(
 	Index newY,
 	Index newZ );
 
+/** Allocates, recording the block against the given type when accounting is enabled. */
+static void* _Memory_TypedMalloc( SizeT size, Type type );
+
+/** Reallocates, keeping any record of the block up to date. A block not yet recorded is recorded against the
+ * given type when accounting is enabled. */
+static void* _Memory_TypedRealloc( void* ptr, SizeT size, Type type );
+
 void* _Memory_Alloc_Func(
 	SizeT size,
 	Type type,
@@ -76,7 +84,7 @@ void* _Memory_Alloc_Func(
 {
 	Pointer result;
 	
-	result = _Memory_InternalMalloc( size );
+	result = _Memory_TypedMalloc( size, type );
 	
 	return result;
 }
@@ -94,7 +102,7 @@ void* _Memory_Alloc_Array_Func(
 	SizeT size;
 	
 	size = Memory_Length_1DArray( itemSize, arrayLength );
-	result = _Memory_InternalMalloc( size );
+	result = _Memory_TypedMalloc( size, type );
 	
 	return result;
 }
@@ -113,7 +121,7 @@ void* _Memory_Alloc_2DArray_Func(
 	SizeT size;
 		
 	size = Memory_Length_2DArray( itemSize, xLength, yLength );
-	result = _Memory_InternalMalloc( size );
+	result = _Memory_TypedMalloc( size, type );
 	
 	
 	Memory_SetupPointer_2DArray( result, itemSize, xLength, yLength );
@@ -136,7 +144,7 @@ void* _Memory_Alloc_3DArray_Func(
 	SizeT size;
 	
 	size = Memory_Length_3DArray( itemSize, xLength, yLength, zLength );
-	result = _Memory_InternalMalloc( size );
+	result = _Memory_TypedMalloc( size, type );
 	
 	Memory_SetupPointer_3DArray( result, itemSize, xLength, yLength, zLength );
 
@@ -166,7 +174,7 @@ void* _Memory_Alloc_4DArray_Func(
 	int ySize, yzProduct, yzwProduct, zwProduct;
 		
 	size = Memory_Length_4DArray( itemSize, xLength, yLength, zLength, wLength );
-	result = _Memory_InternalMalloc( size );
+	result = _Memory_TypedMalloc( size, type );
 	
 	ptrHeader1 = sizeof(Pointer) * xLength;
 	ptrHeader2 = sizeof(Pointer) * xLength * yLength;
@@ -229,7 +237,7 @@ void* _Memory_Alloc_2DArrayAs1D_Func(
 	SizeT size;
 		
 	size = Memory_Length_2DAs1D( itemSize, xLength, yLength );
-	result = _Memory_InternalMalloc( size );
+	result = _Memory_TypedMalloc( size, type );
 	
 	return result;
 }
@@ -249,7 +257,7 @@ void* _Memory_Alloc_3DArrayAs1D_Func(
 	SizeT size;
 		
 	size = Memory_Length_3DAs1D( itemSize, xLength, yLength, zLength );
-	result = _Memory_InternalMalloc( size );
+	result = _Memory_TypedMalloc( size, type );
 		
 	return result;
 }
@@ -270,7 +278,7 @@ void* _Memory_Alloc_4DArrayAs1D_Func(
 	SizeT size;
 		
 	size = Memory_Length_4DAs1D( itemSize, xLength, yLength, zLength, wLength );
-	result = _Memory_InternalMalloc( size );
+	result = _Memory_TypedMalloc( size, type );
 	
 	return result;
 }
@@ -295,7 +303,7 @@ void* _Memory_Alloc_2DComplex_Func(
 	if ( 0 == size )
 		return NULL;
 	
-	result = _Memory_InternalMalloc( size );
+	result = _Memory_TypedMalloc( size, type );
 	
 	
 	array = (Pointer*) result;
@@ -348,7 +356,7 @@ void* _Memory_Alloc_3DComplex_Func(
 	ArithPointer startPos, diffSize;
 
 	size = Memory_Length_3DComplex( itemSize, xLength, yLengths, zLengths );
-	result = _Memory_InternalMalloc( size );
+	result = _Memory_TypedMalloc( size, type );
 		
 	array1 = (Pointer*) result;
 	
@@ -391,7 +399,7 @@ void* _Memory_Realloc_Func(
 {
 	Pointer result = NULL;
 
-	result = _Memory_InternalRealloc( ptr, newSize );
+	result = _Memory_TypedRealloc( ptr, newSize, type );
 		
 	return result;
 }
@@ -411,7 +419,7 @@ void* _Memory_Realloc_Array_Func(
 	Pointer result = NULL;
 		
 	newSize = itemSize * newLength;
-	result = _Memory_InternalRealloc( ptr, newSize );
+	result = _Memory_TypedRealloc( ptr, newSize, type );
 	
 	return result;
 }
@@ -440,7 +448,7 @@ void* _Memory_Realloc_2DArray_Func(
 	}
 	
 	newSize = Memory_Length_2DArray( itemSize, newX, newY );
-	result = _Memory_InternalRealloc( ptr, newSize );
+	result = _Memory_TypedRealloc( ptr, newSize, type );
 	
 	if ( ptr != NULL ) {
 		Memory_Relocate_2DArrayData( (Pointer)( (ArithPointer)result + (newX * sizeof(Pointer)) ),
@@ -481,7 +489,7 @@ void* _Memory_Realloc_3DArray_Func(
 	}
 	
 	newSize = Memory_Length_3DArray( itemSize, newX, newY, newZ );
-	result = _Memory_InternalRealloc( ptr, newSize );
+	result = _Memory_TypedRealloc( ptr, newSize, type );
 	
 	if ( ptr != NULL ) {
 		Memory_Relocate_3DArrayData( (Pointer)( (ArithPointer)result + ( (newX + (newX * newY)) * sizeof(Pointer) ) ),
@@ -510,7 +518,7 @@ void* _Memory_Realloc_2DArrayAs1D_Func(
 	Pointer result = NULL;
 	
 	newSize = itemSize * newX * newY;
-	result = _Memory_InternalRealloc( ptr, newSize );
+	result = _Memory_TypedRealloc( ptr, newSize, type );
 	
 	if ( ptr != NULL )
 	{
@@ -537,7 +545,7 @@ void* _Memory_Realloc_3DArrayAs1D_Func(
 	Pointer result = NULL;
 	
 	newSize = itemSize * newX * newY * newZ;
-	result = _Memory_InternalRealloc( ptr, newSize );
+	result = _Memory_TypedRealloc( ptr, newSize, type );
 	
 	if ( ptr != NULL ) {
 		Memory_Relocate_3DArrayData( result, result, itemSize, oldX, oldY, oldZ, newX, newY, newZ );
@@ -751,7 +759,7 @@ void Memory_Relocate_3DArrayData(
 	}
 }
 
-void* _Memory_InternalMalloc( SizeT size ) {
+static void* _Memory_TypedMalloc( SizeT size, Type type ) {
 	void* result;
 
 	if( !size )
@@ -759,20 +767,49 @@ void* _Memory_InternalMalloc( SizeT size ) {
 
 	result = malloc( size );
 
-	return result;
+	if( result && MemoryAccounting_IsEnabled() )
+		_MemoryAccounting_Add( result, size, _MemoryAccounting_GetTypeIndex( type ) );
 
+	return result;
 }
 
-void* _Memory_InternalRealloc( void* ptr, SizeT size ) {
-	void* result;
+static void* _Memory_TypedRealloc( void* ptr, SizeT size, Type type ) {
+	void*		result;
+	SizeT		oldSize;
+	unsigned	type_I;
+	Bool		recorded = False;
+
+	/* The record is removed before the block may be released, as its address may be reused by another thread. */
+	if( ptr && _MemoryAccounting_IsActive() )
+		recorded = _MemoryAccounting_Remove( ptr, &oldSize, &type_I );
 
 	result =  realloc( ptr, size );
 
+	if( result ) {
+		if( recorded )
+			_MemoryAccounting_Add( result, size, type_I );
+		else if( MemoryAccounting_IsEnabled() )
+			_MemoryAccounting_Add( result, size, _MemoryAccounting_GetTypeIndex( type ) );
+	}
+	else if( recorded && size ) {
+		/* failed, so the original block remains */
+		_MemoryAccounting_Add( ptr, oldSize, type_I );
+	}
+
 	return result;
 }
 
+void* _Memory_InternalMalloc( SizeT size ) {
+	return _Memory_TypedMalloc( size, Type_Invalid );
+}
+
+void* _Memory_InternalRealloc( void* ptr, SizeT size ) {
+	return _Memory_TypedRealloc( ptr, size, Type_Invalid );
+}
+
 void _Memory_InternalFree( void* ptr ) {
 	if( !ptr ) return;
+	if( _MemoryAccounting_IsActive() )
+		_MemoryAccounting_Remove( ptr, NULL, NULL );
 	free( ptr );
 }
-
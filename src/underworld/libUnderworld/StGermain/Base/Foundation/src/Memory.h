@@ -41,6 +41,8 @@
 **	(and third) dimensions to have varying lengths. For example, a 2D complex array may have 3 rows, where the length of each
 **	row is 4, 2 and 3 respectively.
 **
+**	Usage by type may be recorded by enabling accounting, see MemoryAccounting.h.
+**
 **~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 #ifndef __StGermain_Base_Foundation_Memory_h__
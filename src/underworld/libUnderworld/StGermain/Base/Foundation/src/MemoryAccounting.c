@@ -0,0 +1,339 @@
+/*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*
+**                                                                                  **
+** This file forms part of the Underworld geophysics modelling application.         **
+**                                                                                  **
+** For full license and copyright information, please refer to the LICENSE.md file  **
+** located at the project root, or contact the authors.                             **
+**                                                                                  **
+**~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "types.h"
+#include "forwardDecl.h"
+
+#include "MemoryAccounting.h"
+
+
+/* Types beyond the first MemoryAccounting_MaxTypes are grouped together in record zero. The type hash table
+ * is kept at most half full, so probes always terminate. */
+#define MemoryAccounting_MaxTypes	1024
+#define MemoryAccounting_TypeSlots	( 2 * MemoryAccounting_MaxTypes )
+#define MemoryAccounting_ShardCount	64
+#define MemoryAccounting_UntypedName	"(untyped)"
+
+typedef struct {
+	char*		name;
+	unsigned long	hash;
+	SizeT		current;
+	SizeT		peak;
+	unsigned long	allocations;
+} MemoryAccounting_Record;
+
+typedef struct {
+	void*		ptr;
+	SizeT		size;
+	unsigned	type_I;
+} MemoryAccounting_Block;
+
+/* Blocks are spread over shards by address, each an open addressed table with its own lock, so that threads
+ * rarely contend. */
+typedef struct {
+	char			lock;
+	MemoryAccounting_Block*	blocks;
+	unsigned		size;
+	unsigned		count;
+} MemoryAccounting_Shard;
+
+static Bool				MemoryAccounting_Enabled = False;
+static unsigned long			MemoryAccounting_BlockCount = 0;
+static MemoryAccounting_Record		MemoryAccounting_Total = { "(total)", 0, 0, 0, 0 };
+static MemoryAccounting_Record		MemoryAccounting_Records[MemoryAccounting_MaxTypes] = { { "(other)", 0, 0, 0, 0 } };
+static unsigned				MemoryAccounting_RecordCount = 1;
+static unsigned				MemoryAccounting_TypeTable[MemoryAccounting_TypeSlots];
+static char				MemoryAccounting_TypeLock = 0;
+static MemoryAccounting_Shard		MemoryAccounting_Shards[MemoryAccounting_ShardCount];
+
+
+static void MemoryAccounting_Lock( char* lock ) {
+	while( __atomic_test_and_set( lock, __ATOMIC_ACQUIRE ) )
+		;
+}
+
+static void MemoryAccounting_Unlock( char* lock ) {
+	__atomic_clear( lock, __ATOMIC_RELEASE );
+}
+
+static unsigned long MemoryAccounting_HashName( const char* name ) {
+	unsigned long hash = 14695981039346656037UL;
+
+	for( ; *name; name++ ) {
+		hash ^= (unsigned char)*name;
+		hash *= 1099511628211UL;
+	}
+	return hash;
+}
+
+static unsigned long MemoryAccounting_HashPointer( void* ptr ) {
+	unsigned long hash = (unsigned long)ptr >> 4;
+
+	hash ^= hash >> 17;
+	hash *= 0x9E3779B97F4A7C15UL;
+	return hash ^ ( hash >> 29 );
+}
+
+static void MemoryAccounting_Increase( MemoryAccounting_Record* record, SizeT size ) {
+	SizeT current, peak;
+
+	current = __atomic_add_fetch( &record->current, size, __ATOMIC_RELAXED );
+	__atomic_add_fetch( &record->allocations, 1, __ATOMIC_RELAXED );
+	peak = __atomic_load_n( &record->peak, __ATOMIC_RELAXED );
+	while( current > peak &&
+	       !__atomic_compare_exchange_n( &record->peak, &peak, current, True, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+		;
+}
+
+static void MemoryAccounting_Decrease( MemoryAccounting_Record* record, SizeT size ) {
+	__atomic_sub_fetch( &record->current, size, __ATOMIC_RELAXED );
+}
+
+static MemoryAccounting_Record* MemoryAccounting_GetRecord( unsigned type_I ) {
+	if( type_I >= __atomic_load_n( &MemoryAccounting_RecordCount, __ATOMIC_ACQUIRE ) )
+		return NULL;
+	return MemoryAccounting_Records + type_I;
+}
+
+
+void MemoryAccounting_Initialise( void ) {
+#ifdef STG_MEMORY_ACCOUNTING
+	MemoryAccounting_Enable( True );
+#endif
+	if( getenv( "UW_MEMORY_ACCOUNTING" ) )
+		MemoryAccounting_Enable( True );
+}
+
+void MemoryAccounting_Enable( Bool enable ) {
+	__atomic_store_n( &MemoryAccounting_Enabled, enable, __ATOMIC_RELAXED );
+}
+
+Bool MemoryAccounting_IsEnabled( void ) {
+	return __atomic_load_n( &MemoryAccounting_Enabled, __ATOMIC_RELAXED );
+}
+
+SizeT MemoryAccounting_GetCurrentBytes( void ) {
+	return __atomic_load_n( &MemoryAccounting_Total.current, __ATOMIC_RELAXED );
+}
+
+SizeT MemoryAccounting_GetPeakBytes( void ) {
+	return __atomic_load_n( &MemoryAccounting_Total.peak, __ATOMIC_RELAXED );
+}
+
+unsigned MemoryAccounting_GetTypeCount( void ) {
+	return __atomic_load_n( &MemoryAccounting_RecordCount, __ATOMIC_ACQUIRE );
+}
+
+const char* MemoryAccounting_GetTypeName( unsigned type_I ) {
+	MemoryAccounting_Record* record = MemoryAccounting_GetRecord( type_I );
+
+	return record ? record->name : NULL;
+}
+
+SizeT MemoryAccounting_GetTypeCurrentBytes( unsigned type_I ) {
+	MemoryAccounting_Record* record = MemoryAccounting_GetRecord( type_I );
+
+	return record ? __atomic_load_n( &record->current, __ATOMIC_RELAXED ) : 0;
+}
+
+SizeT MemoryAccounting_GetTypePeakBytes( unsigned type_I ) {
+	MemoryAccounting_Record* record = MemoryAccounting_GetRecord( type_I );
+
+	return record ? __atomic_load_n( &record->peak, __ATOMIC_RELAXED ) : 0;
+}
+
+unsigned long MemoryAccounting_GetTypeAllocationCount( unsigned type_I ) {
+	MemoryAccounting_Record* record = MemoryAccounting_GetRecord( type_I );
+
+	return record ? __atomic_load_n( &record->allocations, __ATOMIC_RELAXED ) : 0;
+}
+
+void MemoryAccounting_ResetPeaks( void ) {
+	unsigned	nRecords = MemoryAccounting_GetTypeCount();
+	unsigned	type_I;
+
+	for( type_I = 0; type_I < nRecords; type_I++ ) {
+		MemoryAccounting_Record* record = MemoryAccounting_Records + type_I;
+
+		__atomic_store_n( &record->peak, __atomic_load_n( &record->current, __ATOMIC_RELAXED ), __ATOMIC_RELAXED );
+	}
+	__atomic_store_n( &MemoryAccounting_Total.peak, MemoryAccounting_GetCurrentBytes(), __ATOMIC_RELAXED );
+}
+
+void MemoryAccounting_PrintTop( unsigned count ) {
+	Stream*		stream = Journal_Register( Info_Type, "MemoryAccounting" );
+	unsigned	nRecords = MemoryAccounting_GetTypeCount();
+	unsigned*	order;
+	unsigned	type_I, order_I, printed = 0;
+
+	order = (unsigned*)malloc( nRecords * sizeof(unsigned) );
+	for( type_I = 0; type_I < nRecords; type_I++ ) {
+		SizeT	current = MemoryAccounting_GetTypeCurrentBytes( type_I );
+		int	pos = type_I;
+
+		/* insertion sort, largest first */
+		while( pos > 0 && MemoryAccounting_GetTypeCurrentBytes( order[pos - 1] ) < current ) {
+			order[pos] = order[pos - 1];
+			pos--;
+		}
+		order[pos] = type_I;
+	}
+
+	Journal_Printf( stream, "Memory accounting: %lu bytes current, %lu bytes peak\n",
+		MemoryAccounting_GetCurrentBytes(), MemoryAccounting_GetPeakBytes() );
+	Journal_Printf( stream, "%-40s %16s %16s %12s\n", "Type", "Current", "Peak", "Allocations" );
+	for( order_I = 0; order_I < nRecords && printed < count; order_I++ ) {
+		type_I = order[order_I];
+		if( !MemoryAccounting_GetTypePeakBytes( type_I ) )
+			continue;
+		printed++;
+		Journal_Printf( stream, "%-40s %16lu %16lu %12lu\n", MemoryAccounting_GetTypeName( type_I ),
+			MemoryAccounting_GetTypeCurrentBytes( type_I ), MemoryAccounting_GetTypePeakBytes( type_I ),
+			MemoryAccounting_GetTypeAllocationCount( type_I ) );
+	}
+	free( order );
+}
+
+Bool _MemoryAccounting_IsActive( void ) {
+	return MemoryAccounting_IsEnabled() || __atomic_load_n( &MemoryAccounting_BlockCount, __ATOMIC_RELAXED );
+}
+
+unsigned _MemoryAccounting_GetTypeIndex( Type type ) {
+	const char*	name = type ? type : MemoryAccounting_UntypedName;
+	unsigned long	hash = MemoryAccounting_HashName( name );
+	unsigned	slot, type_I;
+
+	/* Published types are never modified, so may be found without taking the lock. */
+	slot = hash % MemoryAccounting_TypeSlots;
+	while( (type_I = __atomic_load_n( &MemoryAccounting_TypeTable[slot], __ATOMIC_ACQUIRE )) ) {
+		if( MemoryAccounting_Records[type_I].hash == hash && !strcmp( MemoryAccounting_Records[type_I].name, name ) )
+			return type_I;
+		slot = ( slot + 1 ) % MemoryAccounting_TypeSlots;
+	}
+
+	MemoryAccounting_Lock( &MemoryAccounting_TypeLock );
+	/* Another thread may have added the type, and any it added sit before the first empty slot. */
+	slot = hash % MemoryAccounting_TypeSlots;
+	while( (type_I = MemoryAccounting_TypeTable[slot]) ) {
+		if( MemoryAccounting_Records[type_I].hash == hash && !strcmp( MemoryAccounting_Records[type_I].name, name ) )
+			break;
+		slot = ( slot + 1 ) % MemoryAccounting_TypeSlots;
+	}
+	if( !type_I && MemoryAccounting_RecordCount < MemoryAccounting_MaxTypes ) {
+		MemoryAccounting_Record* record;
+
+		type_I = MemoryAccounting_RecordCount;
+		record = MemoryAccounting_Records + type_I;
+		record->name = (char*)malloc( strlen( name ) + 1 );
+		strcpy( record->name, name );
+		record->hash = hash;
+		__atomic_store_n( &MemoryAccounting_RecordCount, type_I + 1, __ATOMIC_RELEASE );
+		__atomic_store_n( &MemoryAccounting_TypeTable[slot], type_I, __ATOMIC_RELEASE );
+	}
+	MemoryAccounting_Unlock( &MemoryAccounting_TypeLock );
+
+	return type_I;
+}
+
+/* Returns the slot holding ptr, or the empty slot where it would go. The shard must be locked and non-empty. */
+static unsigned MemoryAccounting_FindBlock( MemoryAccounting_Shard* shard, void* ptr, unsigned long hash ) {
+	unsigned mask = shard->size - 1;
+	unsigned slot = ( hash / MemoryAccounting_ShardCount ) & mask;
+
+	while( shard->blocks[slot].ptr && shard->blocks[slot].ptr != ptr )
+		slot = ( slot + 1 ) & mask;
+	return slot;
+}
+
+static void MemoryAccounting_GrowShard( MemoryAccounting_Shard* shard ) {
+	MemoryAccounting_Block*	oldBlocks = shard->blocks;
+	unsigned		oldSize = shard->size;
+	unsigned		block_I;
+
+	shard->size = oldSize ? 2 * oldSize : 256;
+	shard->blocks = (MemoryAccounting_Block*)calloc( shard->size, sizeof(MemoryAccounting_Block) );
+	for( block_I = 0; block_I < oldSize; block_I++ ) {
+		void* ptr = oldBlocks[block_I].ptr;
+
+		if( ptr )
+			shard->blocks[MemoryAccounting_FindBlock( shard, ptr, MemoryAccounting_HashPointer( ptr ) )] = oldBlocks[block_I];
+	}
+	free( oldBlocks );
+}
+
+void _MemoryAccounting_Add( void* ptr, SizeT size, unsigned type_I ) {
+	unsigned long		hash = MemoryAccounting_HashPointer( ptr );
+	MemoryAccounting_Shard*	shard = MemoryAccounting_Shards + hash % MemoryAccounting_ShardCount;
+	MemoryAccounting_Block*	block;
+
+	MemoryAccounting_Lock( &shard->lock );
+	if( 2 * ( shard->count + 1 ) > shard->size )
+		MemoryAccounting_GrowShard( shard );
+	block = shard->blocks + MemoryAccounting_FindBlock( shard, ptr, hash );
+	if( block->ptr ) {
+		MemoryAccounting_Decrease( MemoryAccounting_Records + block->type_I, block->size );
+		MemoryAccounting_Decrease( &MemoryAccounting_Total, block->size );
+	}
+	else {
+		shard->count++;
+		__atomic_add_fetch( &MemoryAccounting_BlockCount, 1, __ATOMIC_RELAXED );
+	}
+	block->ptr = ptr;
+	block->size = size;
+	block->type_I = type_I;
+	MemoryAccounting_Unlock( &shard->lock );
+
+	MemoryAccounting_Increase( MemoryAccounting_Records + type_I, size );
+	MemoryAccounting_Increase( &MemoryAccounting_Total, size );
+}
+
+Bool _MemoryAccounting_Remove( void* ptr, SizeT* size, unsigned* type_I ) {
+	unsigned long		hash = MemoryAccounting_HashPointer( ptr );
+	MemoryAccounting_Shard*	shard = MemoryAccounting_Shards + hash % MemoryAccounting_ShardCount;
+	MemoryAccounting_Block	removed;
+	unsigned		mask, slot, next;
+
+	MemoryAccounting_Lock( &shard->lock );
+	if( !shard->count ) {
+		MemoryAccounting_Unlock( &shard->lock );
+		return False;
+	}
+	slot = MemoryAccounting_FindBlock( shard, ptr, hash );
+	removed = shard->blocks[slot];
+	if( !removed.ptr ) {
+		MemoryAccounting_Unlock( &shard->lock );
+		return False;
+	}
+
+	/* Backward shift deletion, so that linear probes need no tombstones. */
+	mask = shard->size - 1;
+	for( next = ( slot + 1 ) & mask; shard->blocks[next].ptr; next = ( next + 1 ) & mask ) {
+		unsigned home = ( MemoryAccounting_HashPointer( shard->blocks[next].ptr ) / MemoryAccounting_ShardCount ) & mask;
+
+		if( ( ( next - home ) & mask ) >= ( ( next - slot ) & mask ) ) {
+			shard->blocks[slot] = shard->blocks[next];
+			slot = next;
+		}
+	}
+	shard->blocks[slot].ptr = NULL;
+	shard->count--;
+	__atomic_sub_fetch( &MemoryAccounting_BlockCount, 1, __ATOMIC_RELAXED );
+	MemoryAccounting_Unlock( &shard->lock );
+
+	MemoryAccounting_Decrease( MemoryAccounting_Records + removed.type_I, removed.size );
+	MemoryAccounting_Decrease( &MemoryAccounting_Total, removed.size );
+	if( size ) *size = removed.size;
+	if( type_I ) *type_I = removed.type_I;
+	return True;
+}
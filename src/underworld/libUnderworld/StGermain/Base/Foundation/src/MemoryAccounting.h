@@ -0,0 +1,68 @@
+/*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*
+**                                                                                  **
+** This file forms part of the Underworld geophysics modelling application.         **
+**                                                                                  **
+** For full license and copyright information, please refer to the LICENSE.md file  **
+** located at the project root, or contact the authors.                             **
+**                                                                                  **
+**~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**	Optional accounting of the allocations made through the Memory module, grouped by allocation type.
+**
+** <b>Description</b>
+**	When enabled, each block allocated through the Memory module is recorded against its type (the textual type
+**	passed to Memory_Alloc and friends, which for objects is the class type). Current bytes, high-water bytes and
+**	allocation counts are kept for each type and in total. Blocks are recorded in a table keyed by address rather
+**	than in a header in front of the block, so blocks may still be released with free() (and malloc() blocks with
+**	Memory_Free) without harm, although a block released with free() stays counted until its address is reused.
+**	Counters are updated atomically, and the module may be used from within thread parallel regions.
+**
+**	Accounting is disabled by default. It is enabled at startup when built with STG_MEMORY_ACCOUNTING, or when the
+**	UW_MEMORY_ACCOUNTING environment variable is set, and may be switched at any time with MemoryAccounting_Enable().
+**	Blocks allocated while disabled are not recorded, and releasing them has no effect on the counts.
+**
+**~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#ifndef __StGermain_Base_Foundation_MemoryAccounting_h__
+#define __StGermain_Base_Foundation_MemoryAccounting_h__
+
+	/** Enables accounting if requested at build time or through the environment. Called from BaseFoundation_Init(). */
+	void MemoryAccounting_Initialise( void );
+
+	/** Switches the recording of new allocations. Blocks already recorded are still accounted for when released. */
+	void MemoryAccounting_Enable( Bool enable );
+
+	Bool MemoryAccounting_IsEnabled( void );
+
+	/** Bytes currently recorded, and the high-water mark since accounting began or peaks were last reset. */
+	SizeT MemoryAccounting_GetCurrentBytes( void );
+	SizeT MemoryAccounting_GetPeakBytes( void );
+
+	/** Number of types seen, for use with the per type queries below. Types are indexed in the order first seen. */
+	unsigned MemoryAccounting_GetTypeCount( void );
+	const char* MemoryAccounting_GetTypeName( unsigned type_I );
+	SizeT MemoryAccounting_GetTypeCurrentBytes( unsigned type_I );
+	SizeT MemoryAccounting_GetTypePeakBytes( unsigned type_I );
+	unsigned long MemoryAccounting_GetTypeAllocationCount( unsigned type_I );
+
+	/** Sets each high-water mark to the bytes currently recorded. */
+	void MemoryAccounting_ResetPeaks( void );
+
+	/** Prints the types holding the most memory, largest first. Types never used are omitted. */
+	void MemoryAccounting_PrintTop( unsigned count );
+
+	/* Hooks for the Memory module. Only to be called when _MemoryAccounting_IsActive() is true. */
+
+	/** True when enabled, or when any blocks remain recorded. */
+	Bool _MemoryAccounting_IsActive( void );
+
+	unsigned _MemoryAccounting_GetTypeIndex( Type type );
+
+	/** Records a block. An existing record at the same address (a block released with free()) is replaced. */
+	void _MemoryAccounting_Add( void* ptr, SizeT size, unsigned type_I );
+
+	/** Removes the record of a block, returning False if it was not recorded. Size and type may be NULL. */
+	Bool _MemoryAccounting_Remove( void* ptr, SizeT* size, unsigned* type_I );
+
+#endif /* __StGermain_Base_Foundation_MemoryAccounting_h__ */
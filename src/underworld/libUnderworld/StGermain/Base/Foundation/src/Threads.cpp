@@ -0,0 +1,64 @@
+/*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*
+**                                                                                  **
+** This file forms part of the Underworld geophysics modelling application.         **
+**                                                                                  **
+** For full license and copyright information, please refer to the LICENSE.md file  **
+** located at the project root, or contact the authors.                             **
+**                                                                                  **
+**~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*/
+
+
+#include <exception>
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
+extern "C" {
+#include "types.h"
+#include "Threads.h"
+}
+
+
+static unsigned Threads_MaxCount = 1;
+
+void Threads_Initialise( void ) {
+#ifdef HAVE_OPENMP
+	Threads_MaxCount = (unsigned)omp_get_max_threads();
+#endif
+}
+
+unsigned Threads_GetMaxCount( void ) {
+	return Threads_MaxCount;
+}
+
+unsigned Threads_GetIndex( void ) {
+#ifdef HAVE_OPENMP
+	return (unsigned)omp_get_thread_num();
+#else
+	return 0;
+#endif
+}
+
+void Threads_ParallelFor( int count, unsigned nThreads, Threads_LoopFunction* func, void* data ) {
+	/* Exceptions may not leave a parallel region, so each is caught within its iteration. */
+	std::exception_ptr error;
+	int                i;
+
+#ifdef HAVE_OPENMP
+	#pragma omp parallel for num_threads( nThreads ) schedule( dynamic, 4 )
+#endif
+	for( i = 0; i < count; i++ ) {
+		try {
+			func( data, i );
+		}
+		catch( ... ) {
+#ifdef HAVE_OPENMP
+			#pragma omp critical( Threads_ParallelFor )
+#endif
+			if( !error )
+				error = std::current_exception();
+		}
+	}
+	if( error )
+		std::rethrow_exception( error );
+}
@@ -0,0 +1,34 @@
+/*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*
+**                                                                                  **
+** This file forms part of the Underworld geophysics modelling application.         **
+**                                                                                  **
+** For full license and copyright information, please refer to the LICENSE.md file  **
+** located at the project root, or contact the authors.                             **
+**                                                                                  **
+**~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*/
+
+
+#ifndef __StGermain_Base_Foundation_Threads_h__
+#define __StGermain_Base_Foundation_Threads_h__
+
+	/* Threads are only available when built with OpenMP support (HAVE_OPENMP). Otherwise
+	 * these report a single thread, and per thread workspaces reduce to a single instance. */
+
+	/** Records the maximum thread count. Called once, from BaseFoundation_Init(). */
+	void Threads_Initialise( void );
+
+	/** Maximum number of threads used within thread parallel regions. This is fixed at
+	 *  initialisation, so that it may be safely used to size per thread workspaces. */
+	unsigned Threads_GetMaxCount( void );
+
+	/** Index of the calling thread within the current thread parallel region, zero outside. */
+	unsigned Threads_GetIndex( void );
+
+	typedef void (Threads_LoopFunction)( void* data, int index );
+
+	/** Calls func( data, i ) for each i in [0, count), over up to nThreads threads. An exception raised by any
+	 *  call (e.g. by a Journal_Firewall) is rethrown once all calls have completed, as it may not leave the
+	 *  thread parallel region. Where several calls raise, the first caught is rethrown. */
+	void Threads_ParallelFor( int count, unsigned nThreads, Threads_LoopFunction* func, void* data );
+
+#endif /* __StGermain_Base_Foundation_Threads_h__ */
@@ -0,0 +1,291 @@
+/*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*
+**                                                                                  **
+** This file forms part of the Underworld geophysics modelling application.         **
+**                                                                                  **
+** For full license and copyright information, please refer to the LICENSE.md file  **
+** located at the project root, or contact the authors.                             **
+**                                                                                  **
+**~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <mpi.h>
+
+#include "StGermain/Base/Foundation/src/Foundation.h"
+
+#include "types.h"
+#include "AsyncWriter.h"
+
+typedef struct AsyncWriter_Job {
+	char*			path;
+	unsigned char*		data;
+	SizeT			size;
+	long*			offsets;
+	long*			lengths;
+	int			nSegments;
+	struct AsyncWriter_Job*	next;
+} AsyncWriter_Job;
+
+static pthread_mutex_t	AsyncWriter_Lock = PTHREAD_MUTEX_INITIALIZER;
+/* Signalled when a job is queued, or the thread is to stop. */
+static pthread_cond_t	AsyncWriter_Queued = PTHREAD_COND_INITIALIZER;
+/* Signalled when a job has been written, and its staging released. */
+static pthread_cond_t	AsyncWriter_Done = PTHREAD_COND_INITIALIZER;
+static pthread_t	AsyncWriter_Thread;
+static Bool		AsyncWriter_Started = False;
+static Bool		AsyncWriter_Stopping = False;
+static AsyncWriter_Job*	AsyncWriter_Head = NULL;
+static AsyncWriter_Job*	AsyncWriter_Tail = NULL;
+static AsyncWriter_Job*	AsyncWriter_Current = NULL;
+static SizeT		AsyncWriter_Capacity = (SizeT)1 << 30;
+static SizeT		AsyncWriter_Staged = 0;
+static unsigned		AsyncWriter_Pending = 0;
+static int		AsyncWriter_Errors = 0;
+static SizeT		AsyncWriter_Written = 0;
+static double		AsyncWriter_Blocked = 0.0;
+
+
+static Bool _AsyncWriter_WriteJob( AsyncWriter_Job* job ) {
+	unsigned char*	data = job->data;
+	int		fd;
+	int		seg_I;
+	Bool		ok = True;
+
+	fd = open( job->path, O_WRONLY | O_CREAT, 0644 );
+	if( fd < 0 )
+		return False;
+	for( seg_I = 0; seg_I < job->nSegments && ok; seg_I++ ) {
+		off_t	offset = (off_t)job->offsets[seg_I];
+		SizeT	remaining = (SizeT)job->lengths[seg_I];
+
+		while( remaining > 0 ) {
+			ssize_t written = pwrite( fd, data, remaining, offset );
+
+			if( written < 0 && errno == EINTR )
+				continue;
+			if( written <= 0 ) {
+				ok = False;
+				break;
+			}
+			data += written;
+			offset += written;
+			remaining -= (SizeT)written;
+		}
+	}
+	if( close( fd ) != 0 )
+		ok = False;
+	return ok;
+}
+
+
+static void* _AsyncWriter_Run( void* arg ) {
+	AsyncWriter_Job*	job;
+	Bool			ok;
+
+	for( ;; ) {
+		pthread_mutex_lock( &AsyncWriter_Lock );
+		while( !AsyncWriter_Head && !AsyncWriter_Stopping )
+			pthread_cond_wait( &AsyncWriter_Queued, &AsyncWriter_Lock );
+		if( !AsyncWriter_Head ) {
+			pthread_mutex_unlock( &AsyncWriter_Lock );
+			break;
+		}
+		job = AsyncWriter_Head;
+		AsyncWriter_Head = job->next;
+		if( !AsyncWriter_Head )
+			AsyncWriter_Tail = NULL;
+		AsyncWriter_Current = job;
+		pthread_mutex_unlock( &AsyncWriter_Lock );
+
+		ok = _AsyncWriter_WriteJob( job );
+
+		pthread_mutex_lock( &AsyncWriter_Lock );
+		AsyncWriter_Current = NULL;
+		AsyncWriter_Staged -= job->size;
+		AsyncWriter_Pending--;
+		if( ok )
+			AsyncWriter_Written += job->size;
+		else
+			AsyncWriter_Errors++;
+		pthread_cond_broadcast( &AsyncWriter_Done );
+		pthread_mutex_unlock( &AsyncWriter_Lock );
+
+		Memory_Free( job->data );
+		Memory_Free( job->offsets );
+		Memory_Free( job->lengths );
+		Memory_Free( job->path );
+		Memory_Free( job );
+	}
+	return NULL;
+}
+
+
+/* Whether any job staged or being written targets path. Called with the lock held. */
+static Bool _AsyncWriter_HasPath( const char* path ) {
+	AsyncWriter_Job* job;
+
+	if( AsyncWriter_Current && !strcmp( AsyncWriter_Current->path, path ) )
+		return True;
+	for( job = AsyncWriter_Head; job; job = job->next ) {
+		if( !strcmp( job->path, path ) )
+			return True;
+	}
+	return False;
+}
+
+
+void AsyncWriter_SetCapacity( SizeT capacity ) {
+	pthread_mutex_lock( &AsyncWriter_Lock );
+	AsyncWriter_Capacity = capacity;
+	/* a larger capacity may release blocked writers */
+	pthread_cond_broadcast( &AsyncWriter_Done );
+	pthread_mutex_unlock( &AsyncWriter_Lock );
+}
+
+
+SizeT AsyncWriter_GetCapacity( void ) {
+	return AsyncWriter_Capacity;
+}
+
+
+Bool AsyncWriter_Write( const char* path, unsigned char* data, int size, long* offsets, int nOffsets, long* lengths, int nLengths ) {
+	AsyncWriter_Job*	job;
+	long			total = 0;
+	double			start;
+	int			seg_I;
+
+	if( !path || size < 0 || nOffsets != nLengths )
+		return False;
+	for( seg_I = 0; seg_I < nLengths; seg_I++ ) {
+		if( offsets[seg_I] < 0 || lengths[seg_I] < 0 )
+			return False;
+		total += lengths[seg_I];
+	}
+	if( total != size )
+		return False;
+
+	/* reserve staging space, waiting for earlier writes to drain if full */
+	pthread_mutex_lock( &AsyncWriter_Lock );
+	if( !AsyncWriter_Started ) {
+		AsyncWriter_Stopping = False;
+		if( pthread_create( &AsyncWriter_Thread, NULL, _AsyncWriter_Run, NULL ) != 0 ) {
+			pthread_mutex_unlock( &AsyncWriter_Lock );
+			return False;
+		}
+		AsyncWriter_Started = True;
+	}
+	start = MPI_Wtime();
+	while( AsyncWriter_Staged > 0 && AsyncWriter_Staged + (SizeT)size > AsyncWriter_Capacity )
+		pthread_cond_wait( &AsyncWriter_Done, &AsyncWriter_Lock );
+	AsyncWriter_Blocked += MPI_Wtime() - start;
+	AsyncWriter_Staged += (SizeT)size;
+	AsyncWriter_Pending++;
+	pthread_mutex_unlock( &AsyncWriter_Lock );
+
+	job = Memory_Alloc_Unnamed( AsyncWriter_Job );
+	job->path = StG_Strdup( path );
+	job->size = (SizeT)size;
+	job->nSegments = nLengths;
+	job->data = (unsigned char*)Memory_Alloc_Bytes_Unnamed( size > 0 ? size : 1, "AsyncWriter" );
+	job->offsets = Memory_Alloc_Array_Unnamed( long, nLengths > 0 ? nLengths : 1 );
+	job->lengths = Memory_Alloc_Array_Unnamed( long, nLengths > 0 ? nLengths : 1 );
+	memcpy( job->data, data, (SizeT)size );
+	memcpy( job->offsets, offsets, nLengths * sizeof(long) );
+	memcpy( job->lengths, lengths, nLengths * sizeof(long) );
+	job->next = NULL;
+
+	pthread_mutex_lock( &AsyncWriter_Lock );
+	if( AsyncWriter_Tail )
+		AsyncWriter_Tail->next = job;
+	else
+		AsyncWriter_Head = job;
+	AsyncWriter_Tail = job;
+	pthread_cond_signal( &AsyncWriter_Queued );
+	pthread_mutex_unlock( &AsyncWriter_Lock );
+
+	return True;
+}
+
+
+int AsyncWriter_Wait( void ) {
+	int errors;
+
+	pthread_mutex_lock( &AsyncWriter_Lock );
+	while( AsyncWriter_Pending > 0 )
+		pthread_cond_wait( &AsyncWriter_Done, &AsyncWriter_Lock );
+	errors = AsyncWriter_Errors;
+	AsyncWriter_Errors = 0;
+	pthread_mutex_unlock( &AsyncWriter_Lock );
+
+	return errors;
+}
+
+
+void AsyncWriter_WaitFor( const char* path ) {
+	pthread_mutex_lock( &AsyncWriter_Lock );
+	while( _AsyncWriter_HasPath( path ) )
+		pthread_cond_wait( &AsyncWriter_Done, &AsyncWriter_Lock );
+	pthread_mutex_unlock( &AsyncWriter_Lock );
+}
+
+
+SizeT AsyncWriter_GetStagedBytes( void ) {
+	SizeT staged;
+
+	pthread_mutex_lock( &AsyncWriter_Lock );
+	staged = AsyncWriter_Staged;
+	pthread_mutex_unlock( &AsyncWriter_Lock );
+	return staged;
+}
+
+
+unsigned AsyncWriter_GetPendingCount( void ) {
+	unsigned pending;
+
+	pthread_mutex_lock( &AsyncWriter_Lock );
+	pending = AsyncWriter_Pending;
+	pthread_mutex_unlock( &AsyncWriter_Lock );
+	return pending;
+}
+
+
+SizeT AsyncWriter_GetWrittenBytes( void ) {
+	SizeT written;
+
+	pthread_mutex_lock( &AsyncWriter_Lock );
+	written = AsyncWriter_Written;
+	pthread_mutex_unlock( &AsyncWriter_Lock );
+	return written;
+}
+
+
+double AsyncWriter_GetBlockedTime( void ) {
+	return AsyncWriter_Blocked;
+}
+
+
+void AsyncWriter_ResetStats( void ) {
+	pthread_mutex_lock( &AsyncWriter_Lock );
+	AsyncWriter_Written = 0;
+	AsyncWriter_Blocked = 0.0;
+	pthread_mutex_unlock( &AsyncWriter_Lock );
+}
+
+
+void AsyncWriter_Finalise( void ) {
+	if( !AsyncWriter_Started )
+		return;
+	AsyncWriter_Wait();
+
+	pthread_mutex_lock( &AsyncWriter_Lock );
+	AsyncWriter_Stopping = True;
+	pthread_cond_signal( &AsyncWriter_Queued );
+	pthread_mutex_unlock( &AsyncWriter_Lock );
+
+	pthread_join( AsyncWriter_Thread, NULL );
+	AsyncWriter_Started = False;
+}
@@ -0,0 +1,57 @@
+/*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*
+**                                                                                  **
+** This file forms part of the Underworld geophysics modelling application.         **
+**                                                                                  **
+** For full license and copyright information, please refer to the LICENSE.md file  **
+** located at the project root, or contact the authors.                             **
+**                                                                                  **
+**~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**	Background writing of data blocks into existing files.
+**
+** <b>Description</b>
+**	A write copies its data into a staging area and returns immediately. A single background thread, started on the
+**	first write, then writes the staged blocks in the order submitted, each as a list of (file offset, length)
+**	segments filled consecutively from the data. Files are opened without truncation, so blocks may be written into
+**	the space reserved for a dataset in a file created beforehand, while computation continues.
+**
+**	Staged bytes are limited by a capacity. A write which would exceed the capacity waits until earlier blocks have
+**	been written, unless nothing is staged, so a single block larger than the capacity still proceeds. Writes are
+**	completed with AsyncWriter_Wait(), which should be called before any staged file is read or recreated. The
+**	background thread makes no MPI or Journal calls.
+**
+**~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#ifndef __StGermain_Base_IO_AsyncWriter_h__
+#define __StGermain_Base_IO_AsyncWriter_h__
+
+	/** Sets the maximum number of staged bytes. The default is 1GB. */
+	void AsyncWriter_SetCapacity( SizeT capacity );
+	SizeT AsyncWriter_GetCapacity( void );
+
+	/** Stages a block for writing to path. The data is written in turn to each of the nSegments (offsets[i], lengths[i])
+	 * ranges of the file, and the lengths must sum to size. Returns False, without staging, if the arguments do not
+	 * agree. */
+	Bool AsyncWriter_Write( const char* path, unsigned char* data, int size, long* offsets, int nOffsets, long* lengths, int nLengths );
+
+	/** Waits for all staged blocks to be written. Returns the number of blocks which failed to write since the last
+	 * call, and resets that count. */
+	int AsyncWriter_Wait( void );
+
+	/** Waits for the staged blocks destined for path to be written. Failures are left to AsyncWriter_Wait(). */
+	void AsyncWriter_WaitFor( const char* path );
+
+	/** Bytes currently staged, and blocks staged or being written. */
+	SizeT AsyncWriter_GetStagedBytes( void );
+	unsigned AsyncWriter_GetPendingCount( void );
+
+	/** Bytes written, and seconds spent waiting for staging capacity, since startup or the last reset. */
+	SizeT AsyncWriter_GetWrittenBytes( void );
+	double AsyncWriter_GetBlockedTime( void );
+	void AsyncWriter_ResetStats( void );
+
+	/** Completes all staged writes and stops the background thread. Called from BaseIO_Finalise(). */
+	void AsyncWriter_Finalise( void );
+
+#endif /* __StGermain_Base_IO_AsyncWriter_h__ */
@@ -22,6 +22,10 @@
 Bool BaseIO_Finalise( void )
 {
 	Stream* stream;
+
+	/* complete any background writes before the journal goes */
+	AsyncWriter_Finalise();
+
 	if ( stJournal->flushCount > 0 ) {
 		stream = Journal_Register( Debug_Type, (char*)__func__ );
 		Journal_Printf( stream, "StGermain IO Report - File Flush called %d times.\n", stJournal->flushCount );
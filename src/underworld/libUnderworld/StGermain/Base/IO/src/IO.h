@@ -34,6 +34,7 @@
 	#include "RankFormatter.h"
 	#include "PathUtils.h"
 	#include "CmdLineArgs.h"
+	#include "AsyncWriter.h"
 	#include "Finalise.h"
 
 #endif /* __StGermain_Base_IO_h__ */
@@ -120,9 +120,12 @@ void _CartesianGenerator_Init( CartesianGenerator* self ) {
 	self->comm = NULL;
 	self->regular = True;
 	memset( self->periodic, 0, 3 * sizeof(Bool) );
+	self->sfcElementOrdering = False;
 	self->maxDecompDims = 0;
 	self->minDecomp = NULL;
 	self->maxDecomp = NULL;
+	memset( self->decompStarts, 0, 3 * sizeof(unsigned*) );
+	memset( self->nDecompStarts, 0, 3 * sizeof(unsigned) );
 	self->shadowDepth = 1;
 	self->crdMin = NULL;
 	self->crdMax = NULL;
@@ -134,6 +137,7 @@ void _CartesianGenerator_Init( CartesianGenerator* self ) {
 	self->range = NULL;
 	self->vertOrigin = NULL;
 	self->vertRange = NULL;
+	memset( self->stageTimes, 0, CartesianGenerator_NumStages * sizeof(double) );
    
 }
 
@@ -246,6 +250,20 @@ void _CartesianGenerator_AssignFromXML( void* meshGenerator, Stg_ComponentFactor
 
 	if( maxDecomp ) memcpy(self->maxDecomp, maxDecomp, self->nDims*sizeof(unsigned) );
 
+	/* Read explicit processor slab boundaries, which override the even decomposition. */
+	for( d_i = 0; d_i < self->nDims; d_i++ ) {
+		const char*	startKeys[3] = { "decompositionStarts_x", "decompositionStarts_y", "decompositionStarts_z" };
+		unsigned	s_i;
+
+		minList = Dictionary_Get( dict, (Dictionary_Entry_Key)startKeys[d_i] );
+		if( !minList )
+			continue;
+		self->nDecompStarts[d_i] = Dictionary_Entry_Value_GetCount( minList );
+		self->decompStarts[d_i] = AllocArray( unsigned, self->nDecompStarts[d_i] );
+		for( s_i = 0; s_i < self->nDecompStarts[d_i]; s_i++ )
+			self->decompStarts[d_i][s_i] = Dictionary_Entry_Value_AsUnsignedInt( Dictionary_Entry_Value_GetElement( minList, s_i ) );
+	}
+
 	/* Initial setup. */
 	self->elGrid = Grid_New();
 	Grid_SetNumDims( self->elGrid, self->nDims );
@@ -315,6 +333,9 @@ void _CartesianGenerator_AssignFromXML( void* meshGenerator, Stg_ComponentFactor
 	self->periodic[1] = Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"periodic_y", False  );
 	self->periodic[2] = Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"periodic_z", False  );
 
+	/* Read local element ordering flag. */
+	self->sfcElementOrdering = Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"sfcElementOrdering", False  );
+
 	/* Free stuff. */
 	FreeArray( size );
 }
@@ -387,6 +408,7 @@ void CartesianGenerator_Generate( void* meshGenerator, void* _mesh, void* data )
 	Grid**			grid;
 	unsigned		*localRange, *localOrigin;
 	Bool			*periodic;
+	double			startTime;
 	
     /* this generator doesn't rely on a parent mesh */
     mesh->parentMesh = mesh;
@@ -421,10 +443,17 @@ void CartesianGenerator_Generate( void* meshGenerator, void* _mesh, void* data )
 		CartesianGenerator_GenTopo( self, (IGraph*)mesh->topo );
 
 		/* Fill geometric values. */
+		startTime = MPI_Wtime();
 		CartesianGenerator_GenGeom( self, mesh, data );
 
 		/* Fill element types. */
 		CartesianGenerator_GenElementTypes( self, mesh );
+		self->stageTimes[CartesianGenerator_GeometryStage] = MPI_Wtime() - startTime;
+
+		Journal_Printf( stream, "Generation times (s):" );
+		for( d_i = 0; d_i < CartesianGenerator_NumStages; d_i++ )
+			Journal_Printf( stream, " %s %.3g", CartesianGenerator_GetStageName( d_i ), self->stageTimes[d_i] );
+		Journal_Printf( stream, "\n" );
 	}
 	else {
 		MeshTopology_SetNumDims( mesh->topo, 0 );
@@ -462,6 +491,7 @@ void CartesianGenerator_Generate( void* meshGenerator, void* _mesh, void* data )
 
 void _CartesianGenerator_SetTopologyParams( void* meshGenerator, unsigned* sizes, unsigned maxDecompDims, unsigned* minDecomp, unsigned* maxDecomp ) {
 	CartesianGenerator*	self = (CartesianGenerator*)meshGenerator;
+	double			startTime;
 	unsigned		d_i;
 
 	/* Sanity check. */
@@ -500,7 +530,9 @@ void _CartesianGenerator_SetTopologyParams( void* meshGenerator, unsigned* sizes
 	self->maxDecompDims = maxDecompDims;
 
 	/* As soon as we know the topology, we can decompose. */
+	startTime = MPI_Wtime();
 	CartesianGenerator_BuildDecomp( self );
+	self->stageTimes[CartesianGenerator_DecompStage] = MPI_Wtime() - startTime;
 }
 
 void _CartesianGenerator_GenElements( void* meshGenerator, IGraph* topo, Grid*** grids ) {
@@ -537,6 +569,12 @@ void _CartesianGenerator_GenElements( void* meshGenerator, IGraph* topo, Grid***
 		els[e_i] = Grid_Project( self->elGrid, dimInds );
 	}
 
+	/* Optionally renumber the local elements along a Morton curve so that
+	   elements adjacent in memory are also adjacent in space. Global
+	   numbering is untouched, only the local (domain) order changes. */
+	if( self->sfcElementOrdering )
+		CartesianGenerator_SortElementsAlongCurve( self, grid, nEls, els );
+
 	IGraph_SetLocalElements( topo, grid->nDims, nEls, els );
 	FreeArray( els );
 	FreeArray( dimInds );
@@ -1263,6 +1301,21 @@ void CartesianGenerator_SetShadowDepth( void* meshGenerator, unsigned depth ) {
 	self->shadowDepth = depth;
 }
 
+double CartesianGenerator_GetStageTime( void* meshGenerator, unsigned stage ) {
+	CartesianGenerator*	self = (CartesianGenerator*)meshGenerator;
+
+	assert( self && stage < CartesianGenerator_NumStages );
+	return self->stageTimes[stage];
+}
+
+const char* CartesianGenerator_GetStageName( unsigned stage ) {
+	static const char*	names[CartesianGenerator_NumStages] = {
+		"decomposition", "entities", "incidence", "shadow", "complete", "geometry" };
+
+	assert( stage < CartesianGenerator_NumStages );
+	return names[stage];
+}
+
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ** Private Functions
@@ -1275,9 +1328,7 @@ void CartesianGenerator_BuildDecomp( CartesianGenerator* self ) {
 	unsigned*	tmpSubDomains;
 	double		bestRatio;
 	unsigned	bestPos;
-	unsigned	*myRankInds, *rankInds;
-	unsigned	nNbrs, *nbrs;
-	unsigned	p_i, d_i, r_i;
+	unsigned	p_i, d_i;
    Stream*  errorStream = Journal_Register( Error_Type, (Name)self->type  );
 
 	/* Sanity check. */
@@ -1287,6 +1338,12 @@ void CartesianGenerator_BuildDecomp( CartesianGenerator* self ) {
 	MPI_Comm_size( self->mpiComm, (int*)&nProcs );
 	MPI_Comm_rank( self->mpiComm, (int*)&rank );
 
+	/* Slab boundaries may be given explicitly, for example by a load balancer. */
+	if( self->decompStarts[0] ) {
+		CartesianGenerator_BuildGivenDecomp( self );
+		return;
+	}
+
 	/* Allocate for possible sub-domains. */
 	tmpSubDomains = Memory_Alloc_Array( unsigned, self->elGrid->nDims, "" );
 
@@ -1372,28 +1429,105 @@ void CartesianGenerator_BuildDecomp( CartesianGenerator* self ) {
 		self->vertRange[d_i] = self->range[d_i] + 1;
 	}
 
-	/* Build the comm topology. */
-	myRankInds = AllocArray( unsigned, Grid_GetNumDims( self->procGrid ) );
-	rankInds = AllocArray( unsigned, Grid_GetNumDims( self->procGrid ) );
+	CartesianGenerator_BuildDecompComm( self );
+}
+
+void CartesianGenerator_BuildGivenDecomp( CartesianGenerator* self ) {
+	unsigned	nProcs, rank;
+	unsigned	nSubDomains[3];
+	unsigned	nSDs = 1;
+	unsigned	d_i, s_i;
+	Stream*		errorStream = Journal_Register( Error_Type, (Name)self->type  );
+
+	assert( self );
+
+	MPI_Comm_size( self->mpiComm, (int*)&nProcs );
+	MPI_Comm_rank( self->mpiComm, (int*)&rank );
+
+	for( d_i = 0; d_i < self->elGrid->nDims; d_i++ ) {
+		Journal_Firewall( self->decompStarts[d_i] && self->decompStarts[d_i][0] == 0, errorStream,
+			"\nError in %s for %s '%s'\n\n"
+			"Decomposition slab starts must be given for every dimension, and start at element 0.\n\n",
+			__func__, self->type, self->name );
+		for( s_i = 1; s_i < self->nDecompStarts[d_i]; s_i++ ) {
+			Journal_Firewall( self->decompStarts[d_i][s_i] > self->decompStarts[d_i][s_i - 1] &&
+					  self->decompStarts[d_i][s_i] < self->elGrid->sizes[d_i], errorStream,
+				"\nError in %s for %s '%s'\n\n"
+				"Decomposition slab starts along dimension %u must be increasing, and within the %u elements.\n\n",
+				__func__, self->type, self->name, d_i, self->elGrid->sizes[d_i] );
+		}
+		nSubDomains[d_i] = self->nDecompStarts[d_i];
+		nSDs *= nSubDomains[d_i];
+	}
+	Journal_Firewall( nSDs == nProcs, errorStream,
+		"\nError in %s for %s '%s'\n\n"
+		"The given decomposition has %u slabs, but there are %u processors.\n\n",
+		__func__, self->type, self->name, nSDs, nProcs );
+
+	self->origin = Memory_Alloc_Array( unsigned, self->elGrid->nDims, "CartesianGenerator::origin" );
+	self->range = Memory_Alloc_Array( unsigned, self->elGrid->nDims, "CartesianGenerator::range" );
+
+	self->procGrid = Grid_New();
+	Grid_SetNumDims( self->procGrid, self->elGrid->nDims );
+	Grid_SetSizes( self->procGrid, nSubDomains );
+
+	/* Ranks map onto slabs as for the even decomposition. */
+	Grid_Lift( self->procGrid, rank, self->origin );
+	for( d_i = 0; d_i < self->elGrid->nDims; d_i++ ) {
+		s_i = self->origin[d_i];
+		self->origin[d_i] = self->decompStarts[d_i][s_i];
+		if( s_i + 1 < nSubDomains[d_i] )
+			self->range[d_i] = self->decompStarts[d_i][s_i + 1] - self->origin[d_i];
+		else
+			self->range[d_i] = self->elGrid->sizes[d_i] - self->origin[d_i];
+
+		/* Shadows may only come from neighbouring slabs. */
+		Journal_Firewall( self->range[d_i] >= self->shadowDepth, errorStream,
+			"\nError in %s for %s '%s'\n\n"
+			"Decomposition slabs must be at least the shadow depth (%u) wide.\n\n",
+			__func__, self->type, self->name, self->shadowDepth );
+	}
+
+	self->vertOrigin = AllocArray( unsigned, self->elGrid->nDims );
+	self->vertRange = AllocArray( unsigned, self->elGrid->nDims );
+	for( d_i = 0; d_i < self->elGrid->nDims; d_i++ ) {
+		self->vertOrigin[d_i] = self->origin[d_i];
+		self->vertRange[d_i] = self->range[d_i] + 1;
+	}
+
+	CartesianGenerator_BuildDecompComm( self );
+}
+
+void CartesianGenerator_BuildDecompComm( CartesianGenerator* self ) {
+	unsigned	rank;
+	unsigned	*myRankInds, *rankInds;
+	unsigned	nNbrs, *nbrs;
+	unsigned	nDims, nOffs;
+	unsigned	d_i, o_i, off;
+
+	MPI_Comm_rank( self->mpiComm, (int*)&rank );
+
+	/* Build the comm topology. Neighbours are the processors adjacent in the processor grid, so visit only
+	   those, rather than testing every rank. */
+	nDims = Grid_GetNumDims( self->procGrid );
+	myRankInds = AllocArray( unsigned, nDims );
+	rankInds = AllocArray( unsigned, nDims );
 	Grid_Lift( self->procGrid, rank, myRankInds );
+	for( nOffs = 1, d_i = 0; d_i < nDims; d_i++ )
+		nOffs *= 3;
 	nNbrs = 0;
-	nbrs = NULL;
-	for( r_i = 0; r_i < Grid_GetNumPoints( self->procGrid ); r_i++ ) {
-		if( r_i == rank )
-			continue;
-
-		Grid_Lift( self->procGrid, r_i, rankInds );
-		for( d_i = 0; d_i < Grid_GetNumDims( self->procGrid ); d_i++ ) {
-			if( (myRankInds[d_i] > 0 && rankInds[d_i] < myRankInds[d_i] - 1) || 
-			    (myRankInds[d_i] < self->procGrid->sizes[d_i] - 1 && rankInds[d_i] > myRankInds[d_i] + 1) )
+	nbrs = AllocArray( unsigned, nOffs );
+	for( o_i = 0; o_i < nOffs; o_i++ ) {
+		for( off = o_i, d_i = 0; d_i < nDims; d_i++, off /= 3 ) {
+			if( (off % 3 == 0 && myRankInds[d_i] == 0) || 
+			    (off % 3 == 2 && myRankInds[d_i] == self->procGrid->sizes[d_i] - 1) )
 			{
 				break;
 			}
+			rankInds[d_i] = myRankInds[d_i] + off % 3 - 1;
 		}
-		if( d_i == Grid_GetNumDims( self->procGrid ) ) {
-			nbrs = ReallocArray( nbrs, unsigned, nNbrs + 1 );
-			nbrs[nNbrs++] = r_i;
-		}
+		if( d_i == nDims && Grid_Project( self->procGrid, rankInds ) != rank )
+			nbrs[nNbrs++] = Grid_Project( self->procGrid, rankInds );
 	}
 
 	FreeArray( myRankInds );
@@ -1403,7 +1537,7 @@ void CartesianGenerator_BuildDecomp( CartesianGenerator* self ) {
 	self->comm = Comm_New();
 	Stg_Class_AddRef( self->comm );
 	Comm_SetMPIComm( self->comm, self->mpiComm );
-	Comm_SetNeighbours( self->comm, nNbrs, nbrs );
+	Comm_SetNeighbours( self->comm, nNbrs, (int*)nbrs );
 	FreeArray( nbrs );
 }
 
@@ -1475,6 +1609,7 @@ void CartesianGenerator_RecurseDecomps( CartesianGenerator* self,
 void CartesianGenerator_GenTopo( CartesianGenerator* self, IGraph* topo ) {
 	Grid***		grids;
 	const Comm* comm;
+	double		startTime;
 	unsigned	d_i, d_j;
 
 	assert( self );
@@ -1549,6 +1684,7 @@ void CartesianGenerator_GenTopo( CartesianGenerator* self, IGraph* topo ) {
 	}
 
 	/* Generate topological elements. */
+	startTime = MPI_Wtime();
 	if( self->enabledDims[0] )
 		CartesianGenerator_GenVertices( self, topo, grids );
 	if( self->enabledDims[self->nDims] )
@@ -1562,7 +1698,10 @@ void CartesianGenerator_GenTopo( CartesianGenerator* self, IGraph* topo ) {
 		}
 	}
 
+	self->stageTimes[CartesianGenerator_EntitiesStage] = MPI_Wtime() - startTime;
+
 	/* Generate topological incidence. */
+	startTime = MPI_Wtime();
 	if( self->enabledInc[self->nDims][0] )
 		CartesianGenerator_GenElementVertexInc( self, topo, grids );
 	if( topo->nDims >= 2 ) {
@@ -1580,7 +1719,10 @@ void CartesianGenerator_GenTopo( CartesianGenerator* self, IGraph* topo ) {
 		}
 	}
 
+	self->stageTimes[CartesianGenerator_IncidenceStage] = MPI_Wtime() - startTime;
+
 	/* Set the shadow depth and correct incidence. */
+	startTime = MPI_Wtime();
 	comm = MeshTopology_GetComm( topo );
 	if( self->shadowDepth && Comm_GetNumNeighbours( comm ) > 0 ) {
 		/* Build enough incidence to set shadow depth. */
@@ -1595,7 +1737,10 @@ void CartesianGenerator_GenTopo( CartesianGenerator* self, IGraph* topo ) {
 		IGraph_RemoveIncidence( topo, 0, topo->nDims );
 	}
 
+	self->stageTimes[CartesianGenerator_ShadowStage] = MPI_Wtime() - startTime;
+
 	/* Complete all required relations. */
+	startTime = MPI_Wtime();
 	for( d_i = 0; d_i < self->nDims; d_i++ ) {
 		for( d_j = d_i + 1; d_j <= self->nDims; d_j++ ) {
 			if( !self->enabledInc[d_i][d_j] )
@@ -1616,6 +1761,7 @@ void CartesianGenerator_GenTopo( CartesianGenerator* self, IGraph* topo ) {
 
 	/* Generate any boundary elements required. */
 	CartesianGenerator_GenBndVerts( self, topo, grids );
+	self->stageTimes[CartesianGenerator_CompleteStage] = MPI_Wtime() - startTime;
 
 	/* Free allocated grids. */
 	grids[topo->nDims][0] = NULL;
@@ -1964,6 +2110,52 @@ void CartesianGenerator_MapToDomain( CartesianGenerator* self, Sync* sync,
 		incEls[inc_i] = Sync_GlobalToDomain( sync, incEls[inc_i] );
 }
 
+typedef struct {
+	unsigned long long	key;
+	unsigned		el;
+} CartesianGenerator_CurveKey;
+
+static int CartesianGenerator_CmpCurveKey( const void* l, const void* r ) {
+	const CartesianGenerator_CurveKey*	left = (const CartesianGenerator_CurveKey*)l;
+	const CartesianGenerator_CurveKey*	right = (const CartesianGenerator_CurveKey*)r;
+
+	if( left->key < right->key ) return -1;
+	if( left->key > right->key ) return 1;
+	return 0;
+}
+
+void CartesianGenerator_SortElementsAlongCurve( CartesianGenerator* self, Grid* grid, 
+						unsigned nEls, unsigned* els )
+{
+	CartesianGenerator_CurveKey*	keys;
+	unsigned*			dimInds;
+	unsigned			e_i;
+
+	assert( self );
+	assert( grid );
+	assert( !nEls || els );
+
+	if( nEls < 2 )
+		return;
+
+	/* Keys are built from the local grid indices so the curve starts at this
+	   processor's origin, and 'els' is assumed to be in local lexicographic order. */
+	keys = Memory_Alloc_Array_Unnamed( CartesianGenerator_CurveKey, nEls );
+	dimInds = Memory_Alloc_Array_Unnamed( unsigned, grid->nDims );
+	for( e_i = 0; e_i < nEls; e_i++ ) {
+		Grid_Lift( grid, e_i, dimInds );
+		keys[e_i].key = StG_MortonKey( grid->nDims, dimInds );
+		keys[e_i].el = els[e_i];
+	}
+
+	qsort( keys, nEls, sizeof(CartesianGenerator_CurveKey), CartesianGenerator_CmpCurveKey );
+	for( e_i = 0; e_i < nEls; e_i++ )
+		els[e_i] = keys[e_i].el;
+
+	FreeArray( keys );
+	FreeArray( dimInds );
+}
+
 #define MAX_LINE_LENGTH 1024
 void CartesianGenerator_GenGeom( void* _self, void* _mesh, void* data ) {
 	CartesianGenerator* self = (CartesianGenerator*)_self;
@@ -2046,6 +2238,9 @@ void CartesianGenerator_Destruct( CartesianGenerator* self ) {
 	CartesianGenerator_DestructGeometry( self );
 	KillArray( self->minDecomp );
 	KillArray( self->maxDecomp );
+	KillArray( self->decompStarts[0] );
+	KillArray( self->decompStarts[1] );
+	KillArray( self->decompStarts[2] );
 	Stg_Class_RemoveRef( self->comm );
 }
 
@@ -30,6 +30,17 @@
 	typedef void (CartesianGenerator_GenElementTypesFunc)( void* meshGenerator, Mesh* mesh );
 	typedef void (CartesianGenerator_CalcGeomFunc) (void* meshGenerator, Mesh* mesh, Sync* sync, Grid* grid, unsigned* inds, double* steps );
 
+	/** Stages of mesh generation, each timed for CartesianGenerator_GetStageTime(). */
+	typedef enum {
+		CartesianGenerator_DecompStage,		/* processor decomposition and neighbours */
+		CartesianGenerator_EntitiesStage,	/* local and shadow vertices, edges, faces and elements */
+		CartesianGenerator_IncidenceStage,
+		CartesianGenerator_ShadowStage,		/* extending the shadow depth */
+		CartesianGenerator_CompleteStage,	/* remaining relations and boundaries */
+		CartesianGenerator_GeometryStage,	/* coordinates and element types */
+		CartesianGenerator_NumStages
+	} CartesianGenerator_Stage;
+
 	/** CartesianGenerator class contents */
 	#define __CartesianGenerator								\
 		/* General info */								\
@@ -54,9 +65,12 @@
 		Comm*		comm;								\
 		Bool		regular;							\
 		Bool		periodic[3];							\
+		Bool		sfcElementOrdering;	/* Number local elements along a Morton curve */ \
 		unsigned	maxDecompDims;							\
 		unsigned*	minDecomp;							\
 		unsigned*	maxDecomp;							\
+		unsigned*	decompStarts[3];	/* Optional first element of each processor slab, per dimension */ \
+		unsigned	nDecompStarts[3];						\
 		unsigned	shadowDepth;							\
 		double*		crdMin;								\
 		double*		crdMax;								\
@@ -69,7 +83,8 @@
 		unsigned*	vertOrigin;	/* Local node grid origin for this processor */ \
 		unsigned*	vertRange;  /* Local node grid range for this processor */ \
         int             contactDepth[3][2];                     \
-        double          contactGeom[3];
+        double          contactGeom[3];                         \
+		double		stageTimes[CartesianGenerator_NumStages];	/* seconds spent in each stage */
 
 	struct CartesianGenerator { __CartesianGenerator };
 
@@ -182,11 +197,17 @@
 	void CartesianGenerator_SetGeometryParams( void* meshGenerator, double* min, double* max );
 	void CartesianGenerator_SetShadowDepth( void* meshGenerator, unsigned depth );
 
+	/** Seconds spent by this processor in a stage of the last generation, and the stage's name. */
+	double CartesianGenerator_GetStageTime( void* meshGenerator, unsigned stage );
+	const char* CartesianGenerator_GetStageName( unsigned stage );
+
 	/*--------------------------------------------------------------------------------------------------------------------------
 	** Private Member functions
 	*/
 
 	void CartesianGenerator_BuildDecomp( CartesianGenerator* self );
+	void CartesianGenerator_BuildGivenDecomp( CartesianGenerator* self );
+	void CartesianGenerator_BuildDecompComm( CartesianGenerator* self );
 	void CartesianGenerator_RecurseDecomps( CartesianGenerator* self, 
 						unsigned dim, unsigned max, 
 						unsigned* nSubDomains, 
@@ -198,6 +219,8 @@
 	void CartesianGenerator_CompleteVertexNeighbours( CartesianGenerator* self, IGraph* topo, Grid*** grids );
 	void CartesianGenerator_MapToDomain( CartesianGenerator* self, Sync* sync, 
 					     unsigned nIncEls, unsigned* incEls );
+	void CartesianGenerator_SortElementsAlongCurve( CartesianGenerator* self, Grid* grid, 
+							unsigned nEls, unsigned* els );
 	void CartesianGenerator_GenGeom( void* _self, void* _mesh, void* data );
 	void CartesianGenerator_CalcGeom( void* _self, Mesh* mesh, Sync* sync, Grid* grid, unsigned* inds, double* steps );
 	void CartesianGenerator_Destruct( CartesianGenerator* self );
@@ -219,13 +219,14 @@ void Decomp_FindOwners( const void* _self, int nGlobals, const int* globals,
 {
    const Decomp* self = (Decomp*)_self;
    IMap ordMapObj, *ordMap = &ordMapObj;
-   int rangeSize;
    int *ord;
-   int **ptrs, *sizes;
+   int nDsts, *dsts, **ptrs, *sizes;
    int begin, end, len, pos, ind;
-   int *recvSizes, **recvArrays;
-   int *remSizes, **remRanks;
-   int nRanks, rank;
+   unsigned nSrcs, *recvSizes;
+   int *srcs, **recvArrays;
+   unsigned nReps, *remSizes;
+   int *reps, **remRanks;
+   int nRanks, rank, owner;
    int g_i, r_i, i_i;
 
    assert( !nGlobals || globals );
@@ -242,65 +243,48 @@ void Decomp_FindOwners( const void* _self, int nGlobals, const int* globals,
    memcpy( ord, globals, nGlobals * sizeof(int) );
    qsort( ord, nGlobals, sizeof(int), stgCmpIntNE );
 
-   ptrs = AllocArray( int*, nRanks );
-   sizes = AllocArray( int, nRanks );
-
-   rangeSize = self->nGlobals / nRanks;
-   if( rank < self->nGlobals % nRanks )
-      rangeSize++;
-
-   pos = 0;
-   begin = end = 0;
-   for( r_i = 0; r_i < nRanks; r_i++ ) {
-      end += self->nGlobals / nRanks;
-      if( r_i < self->nGlobals % nRanks )
-	 end++;
-
-      if( pos < nGlobals && ord[pos] >= begin && ord[pos] < end ) {
-	 len = 0;
-	 while( pos + len < nGlobals && ord[pos + len] < end ) {
-	    if( r_i == rank ) {
-	       ind = IMap_Map( ordMap, ord[pos + len] );
-	       ranks[ind] = IMap_Map( self->owners, ord[pos + len] );
-	    }
-	    len++;
-	 }
-	 if( r_i != rank ) {
-	    ptrs[r_i] = ord + pos;
-	    sizes[r_i] = len;
-	 }
-	 else {
-	    ptrs[r_i] = NULL;
-	    sizes[r_i] = 0;
+   /* Ask the processor holding each global's range for its owner, answering my own range directly. */
+   dsts = AllocArray( int, nGlobals );
+   ptrs = AllocArray( int*, nGlobals );
+   sizes = AllocArray( int, nGlobals );
+   nDsts = 0;
+   for( pos = 0; pos < nGlobals; pos += len ) {
+      owner = Decomp_RangeOwner( self, ord[pos], &begin, &end );
+      for( len = 0; pos + len < nGlobals && ord[pos + len] < end; len++ ) {
+	 if( owner == rank ) {
+	    ind = IMap_Map( ordMap, ord[pos + len] );
+	    ranks[ind] = IMap_Map( self->owners, ord[pos + len] );
 	 }
-	 pos += len;
       }
-      else {
-	 ptrs[r_i] = NULL;
-	 sizes[r_i] = 0;
+      if( owner != rank ) {
+	 dsts[nDsts] = owner;
+	 ptrs[nDsts] = ord + pos;
+	 sizes[nDsts++] = len;
       }
-
-      begin = end;
    }
 
-   MPIArray_Alltoall( (unsigned*)sizes, (void**)ptrs, 
-		      (unsigned**)&recvSizes, (void***)&recvArrays, 
-		      sizeof(int), self->mpiComm );
+   MPIArray_SparseExchange( nDsts, dsts, (unsigned*)sizes, (void**)ptrs, 
+			    &nSrcs, &srcs, &recvSizes, (void***)&recvArrays, 
+			    sizeof(int), self->mpiComm );
 
-   for( r_i = 0; r_i < nRanks; r_i++ ) {
+   for( r_i = 0; r_i < nSrcs; r_i++ ) {
       for( i_i = 0; i_i < recvSizes[r_i]; i_i++ )
 	 recvArrays[r_i][i_i] = IMap_Map( self->owners, recvArrays[r_i][i_i] );
    }
 
-   MPIArray_Alltoall( (unsigned*)recvSizes, (void**)recvArrays, 
-		      (unsigned**)&remSizes, (void***)&remRanks, 
-		      sizeof(int), self->mpiComm );
-   MemFree( recvSizes );
-   for( r_i = 0; r_i < nRanks; r_i++ )
+   MPIArray_SparseExchange( nSrcs, srcs, recvSizes, (void**)recvArrays, 
+			    &nReps, &reps, &remSizes, (void***)&remRanks, 
+			    sizeof(int), self->mpiComm );
+   for( r_i = 0; r_i < nSrcs; r_i++ )
       MemFree( recvArrays[r_i] );
    MemFree( recvArrays );
+   MemFree( recvSizes );
+   MemFree( srcs );
 
-   for( r_i = 0; r_i < nRanks; r_i++ ) {
+   /* Replies come from the processors asked, in the same ascending order. */
+   assert( nReps == nDsts );
+   for( r_i = 0; r_i < nReps; r_i++ ) {
+      assert( reps[r_i] == dsts[r_i] && remSizes[r_i] == sizes[r_i] );
       for( i_i = 0; i_i < remSizes[r_i]; i_i++ ) {
 	 ind = IMap_Map( ordMap, ptrs[r_i][i_i] );
 	 ranks[ind] = remRanks[r_i][i_i];
@@ -310,6 +294,8 @@ void Decomp_FindOwners( const void* _self, int nGlobals, const int* globals,
    IMap_Destruct( ordMap );
    MemFree( remRanks );
    MemFree( remSizes );
+   MemFree( reps );
+   FreeArray( dsts );
    FreeArray( sizes );
    FreeArray( ptrs );
    FreeArray( ord );
@@ -331,17 +317,16 @@ void Decomp_Update( Decomp* self ) {
 }
 
 void Decomp_UpdateOwnerMap( Decomp* self ) {
-   int rangeSize;
    int nLocals;
    const int *locals;
    int *ord;
-   int **ptrs, *sizes;
+   int nDsts, *dsts, **ptrs, *sizes;
    int begin, end, len, pos;
-   int *recvSizes, **recvArrays;
-   int nRanks, rank;
+   unsigned nSrcs, *recvSizes;
+   int *srcs, **recvArrays;
+   int rank, owner;
    int r_i, i_i;
 
-   insist( MPI_Comm_size( self->mpiComm, &nRanks ), == MPI_SUCCESS );
    insist( MPI_Comm_rank( self->mpiComm, &rank ), == MPI_SUCCESS );
 
    IArray_GetArray( self->locals, &nLocals, &locals );
@@ -349,65 +334,66 @@ void Decomp_UpdateOwnerMap( Decomp* self ) {
    memcpy( ord, locals, nLocals * sizeof(int) );
    qsort( ord, nLocals, sizeof(int), stgCmpIntNE );
 
-   ptrs = AllocArray( int*, nRanks );
-   sizes = AllocArray( int, nRanks );
-
-   rangeSize = self->nGlobals / nRanks;
-   if( rank < self->nGlobals % nRanks )
-      rangeSize++;
+   Decomp_RangeOwner( self, -1, &self->rngBegin, &self->rngEnd );
    IMap_Clear( self->owners );
-   IMap_SetMaxSize( self->owners, rangeSize );
-
-   pos = 0;
-   begin = end = 0;
-   for( r_i = 0; r_i < nRanks; r_i++ ) {
-      end += self->nGlobals / nRanks;
-      if( r_i < self->nGlobals % nRanks )
-	 end++;
-      if( r_i == rank ) {
-	 self->rngBegin = begin;
-	 self->rngEnd = end;
-      }
-
-      if( pos < nLocals && ord[pos] >= begin && ord[pos] < end ) {
-	 len = 0;
-	 while( pos + len < nLocals && ord[pos + len] < end ) {
-	    if( r_i == rank )
-	       IMap_Insert( self->owners, ord[pos + len], r_i );
-	    len++;
-	 }
-	 if( r_i != rank ) {
-	    ptrs[r_i] = ord + pos;
-	    sizes[r_i] = len;
-	 }
-	 else {
-	    ptrs[r_i] = NULL;
-	    sizes[r_i] = 0;
-	 }
-	 pos += len;
+   IMap_SetMaxSize( self->owners, self->rngEnd - self->rngBegin );
+
+   /* Tell the processor holding each range which of its globals I own. */
+   dsts = AllocArray( int, nLocals );
+   ptrs = AllocArray( int*, nLocals );
+   sizes = AllocArray( int, nLocals );
+   nDsts = 0;
+   for( pos = 0; pos < nLocals; pos += len ) {
+      owner = Decomp_RangeOwner( self, ord[pos], &begin, &end );
+      for( len = 0; pos + len < nLocals && ord[pos + len] < end; len++ ) {
+	 if( owner == rank )
+	    IMap_Insert( self->owners, ord[pos + len], rank );
       }
-      else {
-	 ptrs[r_i] = NULL;
-	 sizes[r_i] = 0;
+      if( owner != rank ) {
+	 dsts[nDsts] = owner;
+	 ptrs[nDsts] = ord + pos;
+	 sizes[nDsts++] = len;
       }
-
-      begin = end;
    }
 
-   MPIArray_Alltoall( (unsigned*)sizes, (void**)ptrs, 
-		      (unsigned**)&recvSizes, (void***)&recvArrays, 
-		      sizeof(int), self->mpiComm );
+   MPIArray_SparseExchange( nDsts, dsts, (unsigned*)sizes, (void**)ptrs, 
+			    &nSrcs, &srcs, &recvSizes, (void***)&recvArrays, 
+			    sizeof(int), self->mpiComm );
+   FreeArray( dsts );
    FreeArray( sizes );
    FreeArray( ptrs );
    FreeArray( ord );
 
-   for( r_i = 0; r_i < nRanks; r_i++ ) {
+   for( r_i = 0; r_i < nSrcs; r_i++ ) {
       for( i_i = 0; i_i < recvSizes[r_i]; i_i++ )
-	 IMap_Insert( self->owners, recvArrays[r_i][i_i], r_i );
+	 IMap_Insert( self->owners, recvArrays[r_i][i_i], srcs[r_i] );
       MemFree( recvArrays[r_i] );
    }
+   MemFree( srcs );
    MemFree( recvSizes );
    MemFree( recvArrays );
 }
 
+/* Globals are split into contiguous ranges, one per processor, with the first nGlobals % nRanks ranges one
+ * larger. Returns the processor whose range holds global (or, if global is negative, this processor) and
+ * the range's bounds. */
+int Decomp_RangeOwner( const Decomp* self, int global, int* begin, int* end ) {
+   int nRanks, rank;
+   int size, nLarger;
+
+   insist( MPI_Comm_size( self->mpiComm, &nRanks ), == MPI_SUCCESS );
+   size = self->nGlobals / nRanks;
+   nLarger = self->nGlobals % nRanks;
+   if( global < 0 )
+      insist( MPI_Comm_rank( self->mpiComm, &rank ), == MPI_SUCCESS );
+   else if( global < nLarger * (size + 1) )
+      rank = global / (size + 1);
+   else
+      rank = nLarger + (global - nLarger * (size + 1)) / size;
+
+   *begin = rank * size + (rank < nLarger ? rank : nLarger);
+   *end = *begin + size + (rank < nLarger ? 1 : 0);
+   return rank;
+}
+
 
@@ -87,4 +87,6 @@ void Decomp_Update( Decomp* self );
 
 void Decomp_UpdateOwnerMap( Decomp* self );
 
+int Decomp_RangeOwner( const Decomp* self, int global, int* begin, int* end );
+
 #endif /* __StgDomain_Mesh_Decomp_h__ */
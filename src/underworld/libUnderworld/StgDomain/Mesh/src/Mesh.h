@@ -35,6 +35,7 @@
 #include "CartesianGenerator.h"
 #include "MeshVariable.h"
 #include "SpatialTree.h"
+#include "ProcDirectory.h"
 #include "Remesher.h"
 
 #include "Init.h"
@@ -64,6 +64,8 @@ Mesh* _Mesh_New(  MESH_DEFARGS  ) {
     self->enMapVar = NULL;
     self->elgid = NULL;
     self->eGlobalIdsVar = NULL;
+    self->deformVersion = 0;
+    self->procDirectory = NULL;
 
 
 	self->minSep = 0.0;
@@ -336,6 +338,15 @@ unsigned Mesh_GetSharedSize( void* mesh, MeshTopology_Dim topodim ) {
 	return Sync_GetNumShared( IGraph_GetDomain( self->topo, topodim ) );
 }
 
+unsigned Mesh_GetNumNeighbours( void* mesh, MeshTopology_Dim topodim ) {
+	Mesh*	self = (Mesh*)mesh;
+
+	assert( self );
+	assert( self->topo );
+
+	return Comm_GetNumNeighbours( Sync_GetComm( IGraph_GetDomain( self->topo, topodim ) ) );
+}
+
 MeshTopology* Mesh_GetTopology( void* mesh ) {
 	Mesh*	self = (Mesh*)mesh;
 
@@ -608,6 +619,7 @@ void Mesh_DeformationUpdate( void* mesh ) {
 
 	assert( self );
 
+	self->deformVersion++;
 	if( Mesh_GetDomainSize( self, 0 ) ) {
 		self->minSep = Mesh_Algorithms_GetMinimumSeparation( self->algorithms, self->minAxialSep );
 		Mesh_Algorithms_GetLocalCoordRange( self->algorithms, self->minLocalCrd, self->maxLocalCrd );
@@ -819,6 +831,8 @@ void Mesh_Destruct( Mesh* self ) {
     KillArray( self->elgid );
     Stg_Component_Destroy(self->eGlobalIdsVar, NULL, False);
     self->eGlobalIdsVar = NULL;
+    ProcDirectory_Delete( self->procDirectory );
+    self->procDirectory = NULL;
 
 	self->generator = NULL;
 	self->emReg = NULL;
@@ -68,6 +68,11 @@
 		MeshGenerator*			generator;	\
 		/* determines if mesh requires storing (it may already have been stored) */ \
 		Bool                            isDeforming;        \
+		/* incremented whenever the vertices move (see Mesh_DeformationUpdate()), so that \
+		   geometry derived data may be cached against it */ \
+		unsigned                        deformVersion;      \
+		/* owners of each part of the mesh, see Mesh_GetProcDirectory() */ \
+		ProcDirectory*                  procDirectory;      \
 		ExtensionManager_Register*	emReg;                  \
         Mesh*             parentMesh;  /* If this mesh is generated based on a 'parent' mesh, record here. */
                                        /* Else record self */
@@ -124,6 +129,7 @@
 	unsigned Mesh_GetRemoteSize( void* mesh, MeshTopology_Dim dim );
 	unsigned Mesh_GetDomainSize( void* mesh, MeshTopology_Dim dim );
 	unsigned Mesh_GetSharedSize( void* mesh, MeshTopology_Dim dim );
+	unsigned Mesh_GetNumNeighbours( void* mesh, MeshTopology_Dim dim );
 	MeshTopology* Mesh_GetTopology( void* mesh );
 	Sync* Mesh_GetSync( void* mesh, MeshTopology_Dim dim );
 
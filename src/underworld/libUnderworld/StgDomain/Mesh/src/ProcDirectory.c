@@ -0,0 +1,273 @@
+/*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*
+**                                                                                  **
+** This file forms part of the Underworld geophysics modelling application.         **
+**                                                                                  **
+** For full license and copyright information, please refer to the LICENSE.md file  **
+** located at the project root, or contact the authors.                             **
+**                                                                                  **
+**~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <assert.h>
+#include <mpi.h>
+#include <StGermain/libStGermain/src/StGermain.h>
+#include "types.h"
+#include "Mesh.h"
+#include "ProcDirectory.h"
+
+/* Boxes are padded by this fraction of their extent, as higher order elements may bulge past their nodes. */
+#define ProcDirectory_Pad	1e-2
+/* Bins per processor, and the most bins along any one axis. */
+#define ProcDirectory_BinsPerProc	2
+#define ProcDirectory_MaxBins		256
+
+
+ProcDirectory* ProcDirectory_New( void ) {
+	ProcDirectory* self = Memory_Alloc_Unnamed( ProcDirectory );
+
+	memset( self, 0, sizeof(ProcDirectory) );
+	self->version = (unsigned)-1;
+	return self;
+}
+
+
+void ProcDirectory_Delete( ProcDirectory* self ) {
+	if( !self )
+		return;
+	FreeArray( self->boxes );
+	FreeArray( self->binOffsets );
+	FreeArray( self->binProcs );
+	Memory_Free( self );
+}
+
+
+/* The range of bins along each axis overlapped by [min, max]. */
+static void _ProcDirectory_BinRange( ProcDirectory* self, double* min, double* max, unsigned* lower, unsigned* upper ) {
+	unsigned d_i;
+
+	for( d_i = 0; d_i < self->dim; d_i++ ) {
+		double lo = floor( ( min[d_i] - self->min[d_i] ) / self->binWidth[d_i] );
+		double hi = floor( ( max[d_i] - self->min[d_i] ) / self->binWidth[d_i] );
+
+		lower[d_i] = lo < 0.0 ? 0 : ( lo >= self->nBins[d_i] ? self->nBins[d_i] - 1 : (unsigned)lo );
+		upper[d_i] = hi < 0.0 ? 0 : ( hi >= self->nBins[d_i] ? self->nBins[d_i] - 1 : (unsigned)hi );
+	}
+	for( ; d_i < 3; d_i++ ) {
+		lower[d_i] = 0;
+		upper[d_i] = 0;
+	}
+}
+
+
+void ProcDirectory_Build( ProcDirectory* self, unsigned dim, double* localMin, double* localMax, MPI_Comm comm ) {
+	double		localBox[6];
+	unsigned	nBinsTotal, perAxis;
+	unsigned	lower[3], upper[3];
+	unsigned	p_i, d_i, b_i, i, j, k;
+	Bool		any = False;
+	int		nProcs;
+
+	assert( self );
+	assert( dim >= 1 && dim <= 3 );
+
+	(void)MPI_Comm_size( comm, &nProcs );
+	self->dim = dim;
+	self->nProcs = nProcs;
+	memcpy( localBox, localMin, dim * sizeof(double) );
+	memcpy( localBox + dim, localMax, dim * sizeof(double) );
+	FreeArray( self->boxes );
+	self->boxes = Memory_Alloc_Array_Unnamed( double, 2 * dim * nProcs );
+	(void)MPI_Allgather( localBox, 2 * dim, MPI_DOUBLE, self->boxes, 2 * dim, MPI_DOUBLE, comm );
+
+	/* pad each box, and find the extent of them all */
+	for( d_i = 0; d_i < dim; d_i++ ) {
+		self->min[d_i] = DBL_MAX;
+		self->max[d_i] = -DBL_MAX;
+	}
+	for( p_i = 0; p_i < self->nProcs; p_i++ ) {
+		double* min = self->boxes + 2 * dim * p_i;
+		double* max = min + dim;
+
+		if( min[0] > max[0] )
+			continue;
+		for( d_i = 0; d_i < dim; d_i++ ) {
+			double pad = ProcDirectory_Pad * ( max[d_i] - min[d_i] );
+
+			min[d_i] -= pad;
+			max[d_i] += pad;
+			self->min[d_i] = min[d_i] < self->min[d_i] ? min[d_i] : self->min[d_i];
+			self->max[d_i] = max[d_i] > self->max[d_i] ? max[d_i] : self->max[d_i];
+		}
+		any = True;
+	}
+	if( !any ) {
+		for( d_i = 0; d_i < dim; d_i++ ) {
+			self->min[d_i] = 0.0;
+			self->max[d_i] = 0.0;
+		}
+	}
+
+	/* a grid of roughly ProcDirectory_BinsPerProc bins per processor */
+	perAxis = (unsigned)ceil( pow( (double)( ProcDirectory_BinsPerProc * self->nProcs ), 1.0 / dim ) );
+	perAxis = perAxis < 1 ? 1 : ( perAxis > ProcDirectory_MaxBins ? ProcDirectory_MaxBins : perAxis );
+	nBinsTotal = 1;
+	for( d_i = 0; d_i < 3; d_i++ ) {
+		self->nBins[d_i] = d_i < dim ? perAxis : 1;
+		self->binWidth[d_i] = 1.0;
+		if( d_i < dim && self->max[d_i] > self->min[d_i] )
+			self->binWidth[d_i] = ( self->max[d_i] - self->min[d_i] ) / perAxis;
+		nBinsTotal *= self->nBins[d_i];
+	}
+
+	/* count, then list, the processors overlapping each bin */
+	FreeArray( self->binOffsets );
+	self->binOffsets = AllocArray( unsigned, nBinsTotal + 1 );
+	memset( self->binOffsets, 0, ( nBinsTotal + 1 ) * sizeof(unsigned) );
+	for( p_i = 0; p_i < self->nProcs; p_i++ ) {
+		double* min = self->boxes + 2 * dim * p_i;
+
+		if( min[0] > min[dim] )
+			continue;
+		_ProcDirectory_BinRange( self, min, min + dim, lower, upper );
+		for( k = lower[2]; k <= upper[2]; k++ )
+			for( j = lower[1]; j <= upper[1]; j++ )
+				for( i = lower[0]; i <= upper[0]; i++ )
+					self->binOffsets[1 + i + self->nBins[0] * ( j + self->nBins[1] * k )]++;
+	}
+	self->maxCandidates = 0;
+	for( b_i = 0; b_i < nBinsTotal; b_i++ ) {
+		if( self->binOffsets[b_i + 1] > self->maxCandidates )
+			self->maxCandidates = self->binOffsets[b_i + 1];
+		self->binOffsets[b_i + 1] += self->binOffsets[b_i];
+	}
+	FreeArray( self->binProcs );
+	self->binProcs = AllocArray( unsigned, self->binOffsets[nBinsTotal] > 0 ? self->binOffsets[nBinsTotal] : 1 );
+	for( p_i = 0; p_i < self->nProcs; p_i++ ) {
+		double* min = self->boxes + 2 * dim * p_i;
+
+		if( min[0] > min[dim] )
+			continue;
+		_ProcDirectory_BinRange( self, min, min + dim, lower, upper );
+		for( k = lower[2]; k <= upper[2]; k++ )
+			for( j = lower[1]; j <= upper[1]; j++ )
+				for( i = lower[0]; i <= upper[0]; i++ )
+					self->binProcs[self->binOffsets[i + self->nBins[0] * ( j + self->nBins[1] * k )]++] = p_i;
+	}
+	/* filling advanced each offset to the next bin's start */
+	for( b_i = nBinsTotal; b_i > 0; b_i-- )
+		self->binOffsets[b_i] = self->binOffsets[b_i - 1];
+	self->binOffsets[0] = 0;
+
+	self->buildCount++;
+}
+
+
+unsigned ProcDirectory_Find( ProcDirectory* self, const double* point, unsigned* procs, unsigned maxProcs ) {
+	unsigned	dim = self->dim;
+	unsigned	bin[3] = { 0, 0, 0 };
+	unsigned	b_i, c_i, d_i;
+	unsigned	nFound = 0;
+
+	for( d_i = 0; d_i < dim; d_i++ ) {
+		double cell;
+
+		if( point[d_i] < self->min[d_i] || point[d_i] > self->max[d_i] )
+			return 0;
+		cell = floor( ( point[d_i] - self->min[d_i] ) / self->binWidth[d_i] );
+		bin[d_i] = cell >= self->nBins[d_i] ? self->nBins[d_i] - 1 : (unsigned)cell;
+	}
+	b_i = bin[0] + self->nBins[0] * ( bin[1] + self->nBins[1] * bin[2] );
+
+	for( c_i = self->binOffsets[b_i]; c_i < self->binOffsets[b_i + 1]; c_i++ ) {
+		unsigned	p_i = self->binProcs[c_i];
+		double*		min = self->boxes + 2 * dim * p_i;
+		double*		max = min + dim;
+
+		for( d_i = 0; d_i < dim; d_i++ ) {
+			if( point[d_i] < min[d_i] || point[d_i] > max[d_i] )
+				break;
+		}
+		if( d_i < dim )
+			continue;
+		if( nFound < maxProcs )
+			procs[nFound] = p_i;
+		nFound++;
+	}
+	return nFound;
+}
+
+
+ProcDirectory* Mesh_GetProcDirectory( void* mesh ) {
+	Mesh*		self = (Mesh*)mesh;
+	MPI_Comm	comm = Comm_GetMPIComm( Mesh_GetCommTopology( self, MT_VERTEX ) );
+	int		stale, anyStale;
+
+	assert( self );
+
+	/* deformation is usually, but need not be, collective */
+	stale = !self->procDirectory || self->procDirectory->version != self->deformVersion;
+	(void)MPI_Allreduce( &stale, &anyStale, 1, MPI_INT, MPI_LOR, comm );
+	if( anyStale ) {
+		unsigned	dim = Mesh_GetDimSize( self );
+		double		min[3], max[3];
+
+		if( !self->procDirectory )
+			self->procDirectory = ProcDirectory_New();
+		if( Mesh_GetLocalSize( self, Mesh_GetDimSize( self ) ) > 0 ) {
+			Mesh_GetLocalCoordRange( self, min, max );
+		}
+		else {
+			/* an empty box */
+			min[0] = 1.0;
+			max[0] = 0.0;
+			min[1] = min[2] = max[1] = max[2] = 0.0;
+		}
+		ProcDirectory_Build( self->procDirectory, dim, min, max, comm );
+		self->procDirectory->version = self->deformVersion;
+	}
+	return self->procDirectory;
+}
+
+
+unsigned Mesh_FindProcs( void* mesh, double* coords, int nCoords, int dim, int* procs, int nRows, int maxProcs ) {
+	ProcDirectory*	dir = Mesh_GetProcDirectory( mesh );
+	unsigned*	found;
+	unsigned	nFound, maxFound = 0;
+	int		c_i, p_i;
+
+	Journal_Firewall( dim == (int)Mesh_GetDimSize( mesh ) && nRows == nCoords, Journal_Register( Error_Type, (Name)((Mesh*)mesh)->type ),
+		"Error - in %s(): coordinates must be %u dimensional, with one row of processors per coordinate.\n",
+		__func__, Mesh_GetDimSize( mesh ) );
+
+	found = AllocArray( unsigned, maxProcs > 0 ? maxProcs : 1 );
+	for( c_i = 0; c_i < nCoords; c_i++ ) {
+		nFound = ProcDirectory_Find( dir, coords + c_i * dim, found, maxProcs );
+		for( p_i = 0; p_i < maxProcs; p_i++ )
+			procs[c_i * maxProcs + p_i] = p_i < (int)nFound ? (int)found[p_i] : -1;
+		maxFound = nFound > maxFound ? nFound : maxFound;
+	}
+	FreeArray( found );
+	return maxFound;
+}
+
+
+void Mesh_FindLocalElements( void* mesh, double* coords, int nCoords, int dim, int* elements, int nElements ) {
+	Mesh*		self = (Mesh*)mesh;
+	unsigned	nLocal = Mesh_GetLocalSize( self, Mesh_GetDimSize( self ) );
+	unsigned	element;
+	int		c_i;
+
+	Journal_Firewall( dim == (int)Mesh_GetDimSize( self ) && nElements == nCoords, Journal_Register( Error_Type, (Name)self->type ),
+		"Error - in %s(): coordinates must be %u dimensional, with one element per coordinate.\n",
+		__func__, Mesh_GetDimSize( self ) );
+
+	for( c_i = 0; c_i < nCoords; c_i++ ) {
+		if( nLocal > 0 && Mesh_SearchElements( self, coords + c_i * dim, &element ) && element < nLocal )
+			elements[c_i] = (int)element;
+		else
+			elements[c_i] = -1;
+	}
+}
@@ -0,0 +1,66 @@
+/*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*
+**                                                                                  **
+** This file forms part of the Underworld geophysics modelling application.         **
+**                                                                                  **
+** For full license and copyright information, please refer to the LICENSE.md file  **
+** located at the project root, or contact the authors.                             **
+**                                                                                  **
+**~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+**	A directory of the processors owning each part of a mesh.
+**
+** <b>Description</b>
+**	Each processor's bounding box of its local elements (see Mesh_GetLocalCoordRange()) is shared, padded slightly, and
+**	binned over a uniform grid covering the mesh. The processors which may own a point are then found by testing the
+**	boxes listed in the point's bin only. The directory is built on first use, and rebuilt once the mesh is deformed.
+**
+**	Boxes may overlap, so a point may have several candidates, and a candidate need not actually own the point (for
+**	instance, a box is a loose fit to a deformed or irregular mesh). Callers should try the candidates in turn.
+**
+**~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#ifndef __StgDomain_Mesh_ProcDirectory_h__
+#define __StgDomain_Mesh_ProcDirectory_h__
+
+	struct ProcDirectory {
+		unsigned	dim;
+		unsigned	nProcs;
+		double*		boxes;		/* padded min then max of each processor, 2 * dim values each */
+		double		min[3];		/* extent of the bin grid */
+		double		max[3];
+		unsigned	nBins[3];
+		double		binWidth[3];
+		unsigned*	binOffsets;	/* processors overlapping bin b are binProcs[binOffsets[b]:binOffsets[b+1]] */
+		unsigned*	binProcs;
+		unsigned	maxCandidates;	/* largest number of processors listed in any bin */
+		unsigned	version;	/* mesh deformVersion the directory was built for */
+		unsigned	buildCount;
+	};
+
+	ProcDirectory* ProcDirectory_New( void );
+	void ProcDirectory_Delete( ProcDirectory* self );
+
+	/** Gathers each processor's box from comm and bins them. Processors with an empty box (min > max) own nothing.
+	 * Must be called collectively. */
+	void ProcDirectory_Build( ProcDirectory* self, unsigned dim, double* localMin, double* localMax, MPI_Comm comm );
+
+	/** Finds the processors whose box contains point, in ascending order. At most maxProcs are written to procs,
+	 * and the total number found is returned. */
+	unsigned ProcDirectory_Find( ProcDirectory* self, const double* point, unsigned* procs, unsigned maxProcs );
+
+	/** Returns the mesh's directory, first building or rebuilding it should the mesh have been deformed on any
+	 * processor since it was last built. Must be called collectively. */
+	ProcDirectory* Mesh_GetProcDirectory( void* mesh );
+
+	/* Array forms for the Python interface. */
+
+	/** Writes the candidate processors of each coordinate to the corresponding row of procs, padded with -1. Returns
+	 * the largest number of candidates of any coordinate, which may exceed maxProcs. Must be called collectively. */
+	unsigned Mesh_FindProcs( void* mesh, double* coords, int nCoords, int dim, int* procs, int nRows, int maxProcs );
+
+	/** Writes the local element containing each coordinate, or -1 where the coordinate is not within a local
+	 * element. */
+	void Mesh_FindLocalElements( void* mesh, double* coords, int nCoords, int dim, int* elements, int nElements );
+
+#endif /* __StgDomain_Mesh_ProcDirectory_h__ */
@@ -24,6 +24,8 @@ void Sync_UpdateOwners( Sync* self );
 void Sync_ClearTables( Sync* self );
 void Sync_ClearShared( Sync* self );
 void Sync_ClearOwners( Sync* self );
+void Sync_ClearPlans( Sync* self );
+SyncPlan* Sync_GetPlan( Sync* self, size_t itmSize );
 
 
 Sync* Sync_New() {
@@ -72,6 +74,7 @@ void _Sync_Init( void* _self ) {
    self->srcs = NULL;
    self->nSnks = NULL;
    self->snks = NULL;
+   self->plans = NULL;
 }
 
 void Sync_Destruct( Sync* self ) {
@@ -132,16 +135,13 @@ void Sync_FindRemotes( void* _self, int nRemotes, const int* remotes ) {
    ISet nbrSetObj, *nbrSet = &nbrSetObj;
    Comm* comm;
    int nNbrs, *nbrs;
-   int nRanks;
-   Bool *sendFlags, *recvFlags;
-   MPI_Comm mpiComm;
+   unsigned *sizes, nSrcs, *srcSizes;
+   int *srcs;
+   void **arrays, **srcArrays;
    int r_i;
 
    assert( !nRemotes || remotes );
 
-   mpiComm = Decomp_GetMPIComm( self->decomp );
-   insist( MPI_Comm_size( mpiComm, &nRanks ), == MPI_SUCCESS );
-
    owners = AllocArray( int, nRemotes );
    Decomp_FindOwners( self->decomp, nRemotes, remotes, owners );
    ISet_Init( nbrSet );
@@ -150,19 +150,30 @@ void Sync_FindRemotes( void* _self, int nRemotes, const int* remotes ) {
       ISet_TryInsert( nbrSet, owners[r_i] );
    FreeArray( owners );
 
-   sendFlags = AllocArray( Bool, nRanks );
-   recvFlags = AllocArray( Bool, nRanks );
-   for( r_i = 0; r_i < nRanks; r_i++ )
-      sendFlags[r_i] = ISet_Has( nbrSet, r_i );
-   insist( MPI_Alltoall( sendFlags, 1, MPI_INT, 
-			 recvFlags, 1, MPI_INT, 
-			 mpiComm ), == MPI_SUCCESS );
-   FreeArray( sendFlags );
-   for( r_i = 0; r_i < nRanks; r_i++ ) {
-      if( recvFlags[r_i] )
-	 ISet_TryInsert( nbrSet, r_i );
+   /* Neighbours are mutual, so tell each owner, and add those who tell me. */
+   nNbrs = ISet_GetSize( nbrSet );
+   nbrs = AllocArray( int, nNbrs );
+   ISet_GetArray( nbrSet, nbrs );
+   sizes = AllocArray( unsigned, nNbrs );
+   arrays = AllocArray( void*, nNbrs );
+   for( r_i = 0; r_i < nNbrs; r_i++ ) {
+      sizes[r_i] = 0;
+      arrays[r_i] = NULL;
    }
-   FreeArray( recvFlags );
+   MPIArray_SparseExchange( nNbrs, nbrs, sizes, arrays, 
+			    &nSrcs, &srcs, &srcSizes, &srcArrays, 
+			    sizeof(int), Decomp_GetMPIComm( self->decomp ) );
+   FreeArray( nbrs );
+   FreeArray( sizes );
+   FreeArray( arrays );
+   ISet_SetMaxSize( nbrSet, nNbrs + nSrcs );
+   for( r_i = 0; r_i < nSrcs; r_i++ ) {
+      ISet_TryInsert( nbrSet, srcs[r_i] );
+      MemFree( srcArrays[r_i] );
+   }
+   MemFree( srcs );
+   MemFree( srcSizes );
+   MemFree( srcArrays );
 
    nNbrs = ISet_GetSize( nbrSet );
    nbrs = AllocArray( int, nNbrs );
@@ -428,46 +439,115 @@ void Sync_SyncArray( const void* _self,
 		     const void* local, size_t localStride, 
 		     const void* remote, size_t remoteStride, 
 		     size_t itmSize )
+{
+   SyncPlan* plan;
+
+   plan = Sync_SyncArrayBegin( _self, local, localStride, remote, remoteStride, itmSize );
+   Sync_SyncArrayEnd( _self, plan );
+}
+
+SyncPlan* Sync_SyncArrayBegin( const void* _self,
+			       const void* local, size_t localStride,
+			       const void* remote, size_t remoteStride,
+			       size_t itmSize )
 {
    Sync* self = (Sync*)_self;
+   SyncPlan* plan;
+   stgByte* snk;
    int nNbrs;
-   int* nSrcs;
-   stgByte **srcs, **snks;
    int n_i, s_i;
 
    assert( self );
-   nNbrs = Comm_GetNumNeighbours( self->comm );
-   snks = AllocArray( stgByte*, nNbrs );
+   plan = Sync_GetPlan( self, itmSize );
+   plan->active = True;
+   plan->remote = (void*)remote;
+   plan->remoteStride = remoteStride;
+
+   /* post the receives before packing, so early sends from neighbours find them */
+   nNbrs = plan->nNbrs;
+   if( nNbrs )
+      insist( MPI_Startall( nNbrs, plan->reqs ), == MPI_SUCCESS );
+   snk = plan->sendBuf;
    for( n_i = 0; n_i < nNbrs; n_i++ ) {
-      snks[n_i] = AllocArray( stgByte, self->nSnks[n_i] * itmSize );
       for( s_i = 0; s_i < self->nSnks[n_i]; s_i++ ) {
-	 memcpy( snks[n_i] + s_i * itmSize, 
-		 (stgByte*)local + self->snks[n_i][s_i] * localStride, 
-		 itmSize );
+	 memcpy( snk, (stgByte*)local + self->snks[n_i][s_i] * localStride, itmSize );
+	 snk += itmSize;
       }
    }
+   if( nNbrs )
+      insist( MPI_Startall( nNbrs, plan->reqs + nNbrs ), == MPI_SUCCESS );
 
-   nSrcs = AllocArray( int, nNbrs );
-   Comm_AlltoallInit( self->comm, self->nSnks, nSrcs, itmSize );
-   srcs = AllocArray( stgByte*, nNbrs );
-   for( n_i = 0; n_i < nNbrs; n_i++ )
-      srcs[n_i] = AllocArray( stgByte, nSrcs[n_i] * itmSize );
-   Comm_AlltoallBegin( self->comm, (const void**)snks, (void**)srcs );
-   Comm_AlltoallEnd( self->comm );
-   FreeArray( nSrcs );
-   for( n_i = 0; n_i < nNbrs; n_i++ )
-      FreeArray( snks[n_i] );
-   FreeArray( snks );
+   return plan;
+}
+
+void Sync_SyncArrayEnd( const void* _self, SyncPlan* plan ) {
+   Sync* self = (Sync*)_self;
+   stgByte* src;
+   int nNbrs;
+   int n_i, s_i;
+
+   assert( self && plan && plan->active );
+   nNbrs = plan->nNbrs;
+   if( nNbrs )
+      insist( MPI_Waitall( 2 * nNbrs, plan->reqs, MPI_STATUSES_IGNORE ), == MPI_SUCCESS );
 
+   src = plan->recvBuf;
    for( n_i = 0; n_i < nNbrs; n_i++ ) {
       for( s_i = 0; s_i < self->nSrcs[n_i]; s_i++ ) {
-	 memcpy( (stgByte*)remote + self->srcs[n_i][s_i] * remoteStride, 
-		 srcs[n_i] + s_i * itmSize, 
-		 itmSize );
+	 memcpy( (stgByte*)plan->remote + self->srcs[n_i][s_i] * plan->remoteStride, src, plan->itmSize );
+	 src += plan->itmSize;
       }
-      FreeArray( srcs[n_i] );
    }
-   FreeArray( srcs );
+   plan->active = False;
+   plan->remote = NULL;
+}
+
+/* Returns an inactive plan for items of the given size, building one if there is none. The
+ * tables are fixed until the remotes change, so the message sizes are known locally. */
+SyncPlan* Sync_GetPlan( Sync* self, size_t itmSize ) {
+   const int dataTag = 3003;
+   SyncPlan* plan;
+   MPI_Comm mpiComm;
+   const int* nbrs;
+   int nNbrs;
+   int nSnks = 0, nSrcs = 0;
+   int snkOffs = 0, srcOffs = 0;
+   int n_i;
+
+   assert( self && self->comm && itmSize );
+   for( plan = self->plans; plan; plan = plan->next ) {
+      if( plan->itmSize == itmSize && !plan->active )
+	 return plan;
+   }
+
+   Comm_GetNeighbours( self->comm, &nNbrs, &nbrs );
+   mpiComm = Comm_GetMPIComm( self->comm );
+   for( n_i = 0; n_i < nNbrs; n_i++ ) {
+      nSnks += self->nSnks[n_i];
+      nSrcs += self->nSrcs[n_i];
+   }
+
+   plan = Memory_Alloc_Unnamed( SyncPlan );
+   plan->itmSize = itmSize;
+   plan->nNbrs = nNbrs;
+   plan->sendBuf = Memory_Alloc_Array_Unnamed( stgByte, nSnks * itmSize + 1 );
+   plan->recvBuf = Memory_Alloc_Array_Unnamed( stgByte, nSrcs * itmSize + 1 );
+   plan->reqs = Memory_Alloc_Array_Unnamed( MPI_Request, 2 * nNbrs + 1 );
+   for( n_i = 0; n_i < nNbrs; n_i++ ) {
+      insist( MPI_Recv_init( plan->recvBuf + srcOffs, (int)(self->nSrcs[n_i] * itmSize), MPI_BYTE, 
+			     nbrs[n_i], dataTag, mpiComm, plan->reqs + n_i ), == MPI_SUCCESS );
+      insist( MPI_Send_init( plan->sendBuf + snkOffs, (int)(self->nSnks[n_i] * itmSize), MPI_BYTE, 
+			     nbrs[n_i], dataTag, mpiComm, plan->reqs + nNbrs + n_i ), == MPI_SUCCESS );
+      srcOffs += self->nSrcs[n_i] * itmSize;
+      snkOffs += self->nSnks[n_i] * itmSize;
+   }
+   plan->active = False;
+   plan->remote = NULL;
+   plan->remoteStride = 0;
+   plan->next = self->plans;
+   self->plans = plan;
+
+   return plan;
 }
 
 void Sync_UpdateTables( Sync* self ) {
@@ -604,6 +684,7 @@ void Sync_ClearTables( Sync* self ) {
    int n_i;
 
    assert( self );
+   Sync_ClearPlans( self );
    if( self->decomp ) {
       if( self->comm ) {
 	 for( n_i = 0; n_i < Comm_GetNumNeighbours( self->comm ); n_i++ ) {
@@ -645,4 +726,28 @@ void Sync_ClearOwners( Sync* self ) {
    self->owners = NULL;
 }
 
+void Sync_ClearPlans( Sync* self ) {
+   SyncPlan* plan;
+   int finalised;
+   int r_i;
 
+   assert( self );
+   if( !self->plans )
+      return;
+   MPI_Finalized( &finalised );
+   while( self->plans ) {
+      plan = self->plans;
+      self->plans = plan->next;
+      Journal_Firewall( !plan->active, Journal_Register( Error_Type, (Name)self->type ),
+         "\n\nError in %s for %s: a sync begun with Sync_SyncArrayBegin() was not ended before "
+         "the sync's tables changed.\n", __func__, self->type );
+      if( !finalised ) {
+         for( r_i = 0; r_i < 2 * plan->nNbrs; r_i++ )
+            MPI_Request_free( plan->reqs + r_i );
+      }
+      Memory_Free( plan->sendBuf );
+      Memory_Free( plan->recvBuf );
+      Memory_Free( plan->reqs );
+      Memory_Free( plan );
+   }
+}
@@ -12,6 +12,20 @@
 #define __StgDomain_Mesh_Sync_h__
 
 extern const Type Sync_Type;
+
+/* A cached exchange of items of one size with every neighbour: persistent MPI requests
+ * and packing buffers, built on first use and reused by each later sync. */
+struct SyncPlan {
+   size_t itmSize;
+   stgByte* sendBuf;                            /* items packed for each neighbour, consecutively */
+   stgByte* recvBuf;
+   int nNbrs;
+   MPI_Request* reqs;                           /* receives from each neighbour, then sends */
+   Bool active;                                 /* begun and not yet ended */
+   void* remote;                                /* destination of the active sync */
+   size_t remoteStride;
+   SyncPlan* next;
+};
         
 #define __Sync                                  \
    __Stg_Class                                  \
@@ -32,7 +46,8 @@ extern const Type Sync_Type;
    int* nSrcs;                                  \
    int** srcs;                                  \
    int* nSnks;                                  \
-   int** snks;
+   int** snks;                                  \
+   SyncPlan* plans;
 
 struct Sync { __Sync };
 
@@ -123,4 +138,15 @@ void Sync_SyncArray( const void* _self,
 		     const void* remote, size_t remoteStride, 
 		     size_t itmSize );
 
+/* Starts a sync of the remote items from their owners, returning once the local items to send
+ * are packed, so other work may proceed while messages are in flight. The remote array must
+ * not be accessed until Sync_SyncArrayEnd() is called with the returned plan. Several syncs
+ * may be active at once, provided every process begins them in the same order. */
+SyncPlan* Sync_SyncArrayBegin( const void* _self,
+			       const void* local, size_t localStride,
+			       const void* remote, size_t remoteStride,
+			       size_t itmSize );
+
+void Sync_SyncArrayEnd( const void* _self, SyncPlan* plan );
+
 #endif /* __StgDomain_Mesh_Sync_h__ */
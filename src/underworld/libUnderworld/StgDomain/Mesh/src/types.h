@@ -14,9 +14,11 @@
 typedef struct Grid Grid;
 typedef struct Decomp Decomp;
 typedef struct Sync Sync;
+typedef struct SyncPlan SyncPlan;
 typedef struct MeshTopology MeshTopology;
 typedef struct IGraph IGraph;
 typedef struct SpatialTree SpatialTree;
+typedef struct ProcDirectory ProcDirectory;
 
 typedef enum {
    MT_VERTEX, 
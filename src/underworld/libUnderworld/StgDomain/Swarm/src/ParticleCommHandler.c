@@ -82,6 +82,7 @@ void _ParticleCommHandler_Init(
 	self->debug = Stream_RegisterChild( Swarm_Debug, self->type );
 
 	_ParticleCommHandler_ZeroShadowCommStrategyCounters( self );
+	_ParticleCommHandler_ZeroGlobalCommStats( self );
 
 	self->shadowParticlesLeavingMeIndices = NULL;
 	self->shadowParticlesLeavingMeCountsPerCell = NULL;
@@ -183,7 +184,7 @@ void _ParticleCommHandler_AllocateOutgoingParticlesArrays( ParticleCommHandler*
 		else {
 			self->shadowParticlesLeavingMeHandles[nbr_I] = Memory_Alloc( MPI_Request,
 				"ParticleCommHandler->shadowParticlesLeavingMeHandles[]" );
-			particlesArrayBytes = self->swarm->particleExtensionMgr->finalSize * 
+			particlesArrayBytes = Swarm_PackedParticleSize( self->swarm ) * 
 				self->shadowParticlesLeavingMeTotalCounts[nbr_I];
 			self->shadowParticlesLeavingMe[nbr_I] = Memory_Alloc_Bytes( particlesArrayBytes,
 				"Particle", "ParticleCommHandler->shadowParticlesLeavingMe[]" );
@@ -266,7 +267,7 @@ void _ParticleCommHandler_AllocateIncomingParticlesArrays( ParticleCommHandler*
 					"ParticleCommHandler->particlesArrivingFromNbrShadowCellsHandles[]" );
 
 			/* allocate particles recv array to right size */
-			incomingViaShadowArrayBytes = self->swarm->particleExtensionMgr->finalSize * 
+			incomingViaShadowArrayBytes = Swarm_PackedParticleSize( self->swarm ) * 
 				self->particlesArrivingFromNbrShadowCellsTotalCounts[nbr_I];
 			self->particlesArrivingFromNbrShadowCells[nbr_I] = Memory_Alloc_Bytes( incomingViaShadowArrayBytes,
 				"Particle", "particleCommHandler->particlesArrivingFromNbrShadowCells[]" );
@@ -287,7 +288,7 @@ void _ParticleCommHandler_BeginReceiveOfIncomingParticles( ParticleCommHandler*
 			proc_I = procNbrInfo->procNbrTbl[nbr_I];
 
 			/* start non-blocking recv of particles */
-			incomingViaShadowArrayBytes = self->swarm->particleExtensionMgr->finalSize * 
+			incomingViaShadowArrayBytes = Swarm_PackedParticleSize( self->swarm ) * 
 				self->particlesArrivingFromNbrShadowCellsTotalCounts[nbr_I];
 			(void)MPI_Irecv( self->particlesArrivingFromNbrShadowCells[nbr_I], incomingViaShadowArrayBytes, MPI_BYTE,
 				proc_I, SHADOW_PARTICLES, self->swarm->comm,
@@ -597,7 +598,7 @@ void _ParticleCommHandler_BeginSendingParticlesInShadowCellsToNbrs( ParticleComm
 
 			/* non blocking send out particles */
 			MPI_Issend( self->shadowParticlesLeavingMe[nbr_I],
-				self->shadowParticlesLeavingMeTotalCounts[nbr_I] * self->swarm->particleExtensionMgr->finalSize,
+				self->shadowParticlesLeavingMeTotalCounts[nbr_I] * Swarm_PackedParticleSize( self->swarm ),
 				MPI_BYTE, proc_I, SHADOW_PARTICLES, self->swarm->comm,
 				self->shadowParticlesLeavingMeHandles[nbr_I] );
 		}
@@ -612,19 +613,34 @@ void _ParticleCommHandler_BeginSendingParticlesInShadowCellsToNbrs( ParticleComm
 /* +++ Statistics Printing +++ */
 
 
+void _ParticleCommHandler_ZeroGlobalCommStats( ParticleCommHandler* self ) {
+	self->globalParticlesSentCount = 0;
+	self->globalParticlesRecvdCount = 0;
+	self->globalCommDestCount = 0;
+	self->globalCommBytesSent = 0;
+	self->globalCommBytesRecvd = 0;
+}
+
+
 void _ParticleCommHandler_PrintCommunicationVolumeStats( ParticleCommHandler* self, double startTime, Stream* stream )
 {
 	double                  myProcTime = 0;
-	double*                 procTimes = NULL;
 	double                  maxProcTime = 0;
 	Particle_Index          totalParticlesRecvdViaShadowFromNbrs = 0;
 	ShadowInfo*             cellShadowInfo = CellLayout_GetShadowInfo( self->swarm->cellLayout );
 	Processor_Index         proc_I = 0;
 	ProcNbrInfo*            procNbrInfo = cellShadowInfo->procNbrInfo;
 	Neighbour_Index         nbrCount = procNbrInfo->procNbrCnt;
+	/* shadow sent, shadow recvd, global sent, global recvd, global dest procs, global bytes sent, global bytes recvd */
+	double                  myStats[7];
+	double                  sumStats[7];
+	double                  maxStats[7];
 
-	myProcTime = MPI_Wtime() - startTime;
+	/* These stats require collective communication, so skip entirely unless they are to be printed */
+	if ( !Stream_IsPrintableLevel( stream, 2 ) )
+		return;
 
+	myProcTime = MPI_Wtime() - startTime;
 
 	totalParticlesRecvdViaShadowFromNbrs = 0;
 
@@ -639,34 +655,49 @@ void _ParticleCommHandler_PrintCommunicationVolumeStats( ParticleCommHandler* se
 		}	
 	}
 
-	for ( proc_I = 0; proc_I < self->swarm->nProc; proc_I++ ) {
-		MPI_Barrier( self->swarm->comm );
-
-		if ( self->swarm->myRank == proc_I ) {			
-			Journal_PrintfL( stream, 2, "...proc %d finished particle communication:\n", self->swarm->myRank );
-			Stream_Indent( stream );
-			Journal_PrintfL( stream, 2, "- Particle comm totals via shadow cells (%d nbr procs):"
-				" sent %d, recvd %d\n",
-				nbrCount, self->shadowParticlesLeavingMeTotalCount,
-				totalParticlesRecvdViaShadowFromNbrs );
-			Journal_PrintfL( stream, 2, "- time taken = %.2f (secs)\n", myProcTime );
-			Stream_UnIndent( stream );
+	/* Per proc reporting serialises all procs, so is only done at a higher level */
+	if ( Stream_IsPrintableLevel( stream, 3 ) ) {
+		for ( proc_I = 0; proc_I < self->swarm->nProc; proc_I++ ) {
+			MPI_Barrier( self->swarm->comm );
+
+			if ( self->swarm->myRank == proc_I ) {			
+				Journal_PrintfL( stream, 3, "...proc %d finished particle communication:\n", self->swarm->myRank );
+				Stream_Indent( stream );
+				Journal_PrintfL( stream, 3, "- Particle comm totals via shadow cells (%d nbr procs):"
+					" sent %d, recvd %d\n",
+					nbrCount, self->shadowParticlesLeavingMeTotalCount,
+					totalParticlesRecvdViaShadowFromNbrs );
+				Journal_PrintfL( stream, 3, "- Particle comm totals outside shadow cells (%d dest procs):"
+					" sent %d (%lu bytes), recvd %d (%lu bytes)\n",
+					self->globalCommDestCount, self->globalParticlesSentCount,
+					(unsigned long)self->globalCommBytesSent, self->globalParticlesRecvdCount,
+					(unsigned long)self->globalCommBytesRecvd );
+				Journal_PrintfL( stream, 3, "- time taken = %.2f (secs)\n", myProcTime );
+				Stream_UnIndent( stream );
+			}
 		}
+		MPI_Barrier( self->swarm->comm );
 	}
-	MPI_Barrier( self->swarm->comm );
 
-	procTimes = Memory_Alloc_Array( double, self->swarm->nProc, "procTimes" );
-	(void)MPI_Gather( &myProcTime, 1, MPI_DOUBLE, procTimes, 1, MPI_DOUBLE, 0, self->swarm->comm );
+	myStats[0] = self->shadowParticlesLeavingMeTotalCount;
+	myStats[1] = totalParticlesRecvdViaShadowFromNbrs;
+	myStats[2] = self->globalParticlesSentCount;
+	myStats[3] = self->globalParticlesRecvdCount;
+	myStats[4] = self->globalCommDestCount;
+	myStats[5] = self->globalCommBytesSent;
+	myStats[6] = self->globalCommBytesRecvd;
+	(void)MPI_Reduce( myStats, sumStats, 7, MPI_DOUBLE, MPI_SUM, 0, self->swarm->comm );
+	(void)MPI_Reduce( myStats, maxStats, 7, MPI_DOUBLE, MPI_MAX, 0, self->swarm->comm );
+	(void)MPI_Reduce( &myProcTime, &maxProcTime, 1, MPI_DOUBLE, MPI_MAX, 0, self->swarm->comm );
 	if (self->swarm->myRank == 0 ) {
-		for ( proc_I = 0; proc_I < self->swarm->nProc; proc_I++ ) {
-			if ( procTimes[proc_I] > maxProcTime ) {
-				maxProcTime = procTimes[proc_I];
-			}
-		}
-		// TODO: print some stats on max particles sent/recvd and total sent/recvd
+		Journal_PrintfL( stream, 2, "...Particle comm via shadow cells: sent %.0f in total (max %.0f by any proc), "
+			"recvd max %.0f by any proc\n", sumStats[0], maxStats[0], maxStats[1] );
+		Journal_PrintfL( stream, 2, "...Particle comm outside shadow cells: sent %.0f in total (%.3g MB), "
+			"max by any proc sent %.0f to %.0f procs, recvd %.0f (%.3g MB)\n",
+			sumStats[2], sumStats[5] / 1048576.0, maxStats[2], maxStats[4], maxStats[3],
+			maxStats[6] / 1048576.0 );
 		Journal_PrintfL( stream, 2, "...Max Communication time by any proc was %.2f (secs)\n", maxProcTime );
 	}
-	Memory_Free( procTimes );
 }
 
 
@@ -79,7 +79,13 @@
 		Particle_Index*			particlesArrivingFromNbrShadowCellsTotalCounts; \
 		/** transfer array [nbr] of particles to recv */ \
 		Particle**			particlesArrivingFromNbrShadowCells; \
-		MPI_Request**			particlesArrivingFromNbrShadowCellsHandles;
+		MPI_Request**			particlesArrivingFromNbrShadowCellsHandles; \
+		/** statistics on particles sent/recvd outside of the shadow cell exchange, for the current step */ \
+		Particle_Index			globalParticlesSentCount; \
+		Particle_Index			globalParticlesRecvdCount; \
+		Processor_Index			globalCommDestCount; \
+		SizeT				globalCommBytesSent; \
+		SizeT				globalCommBytesRecvd;
 
 	struct ParticleCommHandler { __ParticleCommHandler };	
 
@@ -190,6 +196,8 @@
 
 
 	/* +++ Statistics Printing +++ */
+	void _ParticleCommHandler_ZeroGlobalCommStats( ParticleCommHandler* self );
+
 	void _ParticleCommHandler_PrintCommunicationVolumeStats( ParticleCommHandler* self, double startTime, Stream* info );
 
 #endif
@@ -33,6 +33,9 @@
 
 const Type ParticleMovementHandler_Type = "ParticleMovementHandler";
 
+/* Tag for particles sent outside of the shadow cell exchange */
+static const int GLOBAL_PARTICLES = 21;
+
 void *ParticleMovementHandler_DefaultNew( Name name )
 {
 	/* Variables set in this function */
@@ -235,6 +238,7 @@ void ParticleMovementHandler_HandleParticleMovementBetweenProcs( ParticleCommHan
 	Stream_IndentBranch( Swarm_Debug );
 
 	startTime = MPI_Wtime();
+	_ParticleCommHandler_ZeroGlobalCommStats( (ParticleCommHandler*)self );
 
 	if ( self->swarm->cellShadowCount > 0 ) {
 		/* Allocate the recv count arrays and handles */
@@ -313,10 +317,19 @@ void ParticleMovementHandler_DoGlobalFallbackCommunication( ParticleMovementHand
 
 	ParticleMovementHandler_FindParticlesThatHaveMovedOutsideMyDomain( self );
 
-	ParticleMovementHandler_ShareAndUpdateParticlesThatHaveMovedOutsideDomains(
-		self,
-		&self->globalParticlesArrivingMyDomainCount,
-		&self->globalParticlesOutsideDomainTotal );
+	/* Where we know the domain of each proc, particles need only be sent to those procs which may own them */
+	if ( Stg_Class_IsInstance( self->swarm->cellLayout, ElementCellLayout_Type ) ) {
+		ParticleMovementHandler_ShareAndUpdateParticlesThatHaveMovedOutsideDomainsSparse(
+			self,
+			&self->globalParticlesArrivingMyDomainCount,
+			&self->globalParticlesOutsideDomainTotal );
+	}
+	else {
+		ParticleMovementHandler_ShareAndUpdateParticlesThatHaveMovedOutsideDomains(
+			self,
+			&self->globalParticlesArrivingMyDomainCount,
+			&self->globalParticlesOutsideDomainTotal );
+	}
 
 }
 
@@ -411,7 +424,7 @@ void ParticleMovementHandler_ShareAndUpdateParticlesThatHaveMovedOutsideDomains(
 		Particle_Index		currProcParticlesOutsideDomainCount = 0;
 		Particle_Index		currProcOffset = 0;
 
-		particlesLeavingDomainSizeBytes = self->swarm->particleExtensionMgr->finalSize
+		particlesLeavingDomainSizeBytes = Swarm_PackedParticleSize( self->swarm )
 			* maxGlobalParticlesOutsideDomainCount;
 		particlesLeavingMyDomain = Memory_Alloc_Bytes( particlesLeavingDomainSizeBytes, "Particle",
 			"particlesLeavingMyDomain" );
@@ -447,6 +460,11 @@ void ParticleMovementHandler_ShareAndUpdateParticlesThatHaveMovedOutsideDomains(
 		(void)MPI_Allgather( particlesLeavingMyDomain, particlesLeavingDomainSizeBytes, MPI_BYTE,
 			globalParticlesLeavingDomains, particlesLeavingDomainSizeBytes, MPI_BYTE,
 			self->swarm->comm );
+		self->globalParticlesSentCount += self->particlesOutsideDomainTotalCount;
+		self->globalParticlesRecvdCount += (*globalParticlesOutsideDomainTotalPtr) - self->particlesOutsideDomainTotalCount;
+		self->globalCommDestCount = self->swarm->nProc - 1;
+		self->globalCommBytesSent += particlesLeavingDomainSizeBytes * (self->swarm->nProc - 1);
+		self->globalCommBytesRecvd += particlesLeavingDomainSizeBytes * (self->swarm->nProc - 1);
 
 		Journal_DPrintfL( self->debug, 2, "Checking through the global array of particles leaving domains, "
 			"and snaffling those moving into my domain:\n" );
@@ -462,7 +480,7 @@ void ParticleMovementHandler_ShareAndUpdateParticlesThatHaveMovedOutsideDomains(
 			for ( particle_I=0; particle_I < currProcParticlesOutsideDomainCount; particle_I++ ) {
 				currParticle = (GlobalParticle*)ParticleAt( globalParticlesLeavingDomains,
 					(currProcOffset + particle_I),
-					self->swarm->particleExtensionMgr->finalSize );
+					Swarm_PackedParticleSize( self->swarm ) );
 				lCell_I = CellLayout_CellOf( self->swarm->cellLayout, currParticle );
 				if ( lCell_I < self->swarm->cellLocalCount ) { 
 					#if DEBUG
@@ -483,7 +501,7 @@ void ParticleMovementHandler_ShareAndUpdateParticlesThatHaveMovedOutsideDomains(
 				else {
 					currParticle = (GlobalParticle*)ParticleAt( globalParticlesLeavingDomains, 
 						(currProcOffset + particle_I),
-						self->swarm->particleExtensionMgr->finalSize );
+						Swarm_PackedParticleSize( self->swarm ) );
 					Journal_DPrintfL( self->debug, 3, "Ignoring particle at (%.2f,%.2f,%.2f) since "
 						"not in my local cells...\n", currParticle->coord[0],
 						currParticle->coord[1], currParticle->coord[2] );
@@ -506,6 +524,173 @@ void ParticleMovementHandler_ShareAndUpdateParticlesThatHaveMovedOutsideDomains(
 }
 
 
+void ParticleMovementHandler_ShareAndUpdateParticlesThatHaveMovedOutsideDomainsSparse(
+		ParticleMovementHandler* self,
+		Particle_Index*      globalParticlesArrivingMyDomainCountPtr,
+		Particle_Index*      globalParticlesOutsideDomainTotalPtr )
+{
+	Swarm*			swarm = self->swarm;
+	Mesh*			mesh = ((ElementCellLayout*)swarm->cellLayout)->mesh;
+	SizeT			particleSize = Swarm_PackedParticleSize( swarm );
+	Processor_Index		nProc = swarm->nProc;
+	ProcDirectory*		directory;
+	unsigned*		candidates = NULL;
+	unsigned		nCandidates, candidate_I;
+	Particle_Index*		destCounts = NULL;
+	Particle_Index*		destOffsets = NULL;
+	Processor_Index*	routeProcs = NULL;
+	Particle_Index*		routeParticles = NULL;
+	Particle_Index		routeCount = 0;
+	Particle_Index		routeSize = 0;
+	char*			sendBuf = NULL;
+	MPI_Request*		sendRequests = NULL;
+	int			sendCount = 0;
+	char*			recvBuf = NULL;
+	int			recvBufSize = 0;
+	MPI_Request		barrierRequest;
+	int			barrierActive = 0;
+	int			done = 0;
+	Processor_Index		proc_I;
+	Particle_Index		particle_I, route_I;
+
+	Journal_DPrintfL( self->debug, 2, "In %s():\n", __func__ );
+	Stream_IndentBranch( Swarm_Debug );
+
+	(*globalParticlesArrivingMyDomainCountPtr) = 0;
+	(*globalParticlesOutsideDomainTotalPtr) = 0;
+
+	(void)MPI_Allreduce( &self->particlesOutsideDomainTotalCount, globalParticlesOutsideDomainTotalPtr, 1,
+		MPI_UNSIGNED, MPI_SUM, swarm->comm );
+	if ( 0 == (*globalParticlesOutsideDomainTotalPtr) ) {
+		Stream_UnIndentBranch( Swarm_Debug );
+		return;
+	}
+
+	/* The directory of each proc's (padded) local bounding box, rebuilt only once the mesh deforms. Particles on
+	 * a boundary are sent to both sides. */
+	directory = Mesh_GetProcDirectory( mesh );
+	candidates = Memory_Alloc_Array( unsigned, directory->maxCandidates + 1, "ParticleMovementHandler->candidates" );
+
+	/* Route each particle leaving my domain to every other proc whose box contains it */
+	destCounts = Memory_Alloc_Array( Particle_Index, nProc, "ParticleMovementHandler->destCounts" );
+	destOffsets = Memory_Alloc_Array( Particle_Index, nProc, "ParticleMovementHandler->destOffsets" );
+	memset( destCounts, 0, nProc * sizeof(Particle_Index) );
+	routeSize = self->particlesOutsideDomainTotalCount;
+	if ( routeSize > 0 ) {
+		routeProcs = Memory_Alloc_Array( Processor_Index, routeSize, "ParticleMovementHandler->routeProcs" );
+		routeParticles = Memory_Alloc_Array( Particle_Index, routeSize, "ParticleMovementHandler->routeParticles" );
+	}
+	for ( particle_I = 0; particle_I < self->particlesOutsideDomainTotalCount; particle_I++ ) {
+		Particle_Index  lParticle_I = self->particlesOutsideDomainIndices[particle_I];
+		GlobalParticle* currParticle = (GlobalParticle*)Swarm_ParticleAt( swarm, lParticle_I );
+
+		nCandidates = ProcDirectory_Find( directory, currParticle->coord, candidates, directory->maxCandidates + 1 );
+		for ( candidate_I = 0; candidate_I < nCandidates; candidate_I++ ) {
+			proc_I = candidates[candidate_I];
+			if ( proc_I == swarm->myRank ) continue;
+
+			if ( routeCount == routeSize ) {
+				routeSize += self->particlesOutsideDomainTotalCount;
+				routeProcs = Memory_Realloc_Array( routeProcs, Processor_Index, routeSize );
+				routeParticles = Memory_Realloc_Array( routeParticles, Particle_Index, routeSize );
+			}
+			routeProcs[routeCount] = proc_I;
+			routeParticles[routeCount] = lParticle_I;
+			routeCount++;
+			destCounts[proc_I]++;
+		}
+	}
+	Memory_Free( candidates );
+
+	/* Pack the particles contiguously by destination, then begin sending */
+	destOffsets[0] = 0;
+	for ( proc_I = 1; proc_I < nProc; proc_I++ )
+		destOffsets[proc_I] = destOffsets[proc_I - 1] + destCounts[proc_I - 1];
+	if ( routeCount > 0 )
+		sendBuf = Memory_Alloc_Bytes( routeCount * particleSize, "Particle", "ParticleMovementHandler->sendBuf" );
+	for ( route_I = 0; route_I < routeCount; route_I++ ) {
+		Swarm_CopyParticleOffSwarm( swarm, sendBuf, destOffsets[routeProcs[route_I]]++, routeParticles[route_I] );
+	}
+	sendRequests = Memory_Alloc_Array( MPI_Request, nProc, "ParticleMovementHandler->sendRequests" );
+	for ( proc_I = 0; proc_I < nProc; proc_I++ ) {
+		if ( 0 == destCounts[proc_I] ) continue;
+		/* destOffsets now point to the end of each destination's particles */
+		(void)MPI_Issend( sendBuf + ( destOffsets[proc_I] - destCounts[proc_I] ) * particleSize,
+			destCounts[proc_I] * particleSize, MPI_BYTE, proc_I, GLOBAL_PARTICLES, swarm->comm,
+			&sendRequests[sendCount++] );
+	}
+	self->globalParticlesSentCount += routeCount;
+	self->globalCommDestCount = sendCount;
+	self->globalCommBytesSent += routeCount * particleSize;
+
+	/* Receive from whoever sends to us, until all procs have had all their sends matched (NBX). Synchronous
+	 * sends complete only once received, so once every proc has entered the barrier there is nothing left
+	 * in flight. */
+	while ( !done ) {
+		MPI_Status status;
+		int        arrived = 0;
+
+		(void)MPI_Iprobe( MPI_ANY_SOURCE, GLOBAL_PARTICLES, swarm->comm, &arrived, &status );
+		if ( arrived ) {
+			int            bytes;
+			Particle_Index recvCount;
+
+			(void)MPI_Get_count( &status, MPI_BYTE, &bytes );
+			if ( bytes > recvBufSize ) {
+				recvBuf = Memory_Realloc_Array( recvBuf, char, bytes );
+				recvBufSize = bytes;
+			}
+			(void)MPI_Recv( recvBuf, bytes, MPI_BYTE, status.MPI_SOURCE, GLOBAL_PARTICLES, swarm->comm,
+				MPI_STATUS_IGNORE );
+			recvCount = bytes / particleSize;
+			self->globalParticlesRecvdCount += recvCount;
+			self->globalCommBytesRecvd += bytes;
+
+			/* Take those particles which are within my local cells */
+			for ( particle_I = 0; particle_I < recvCount; particle_I++ ) {
+				GlobalParticle*  currParticle = (GlobalParticle*)ParticleAt( recvBuf, particle_I, particleSize );
+				Cell_DomainIndex lCell_I = CellLayout_CellOf( swarm->cellLayout, currParticle );
+				Particle_Index   lParticle_I;
+
+				if ( lCell_I >= swarm->cellLocalCount ) continue;
+
+				lParticle_I = ParticleMovementHandler_FindFreeSlotAndPrepareForInsertion( (ParticleCommHandler*)self );
+				Swarm_CopyParticleOntoSwarm( swarm, lParticle_I, recvBuf, particle_I );
+				Swarm_AddParticleToCell( swarm, lCell_I, lParticle_I );
+				(*globalParticlesArrivingMyDomainCountPtr)++;
+			}
+		}
+
+		if ( barrierActive ) {
+			(void)MPI_Test( &barrierRequest, &done, MPI_STATUS_IGNORE );
+		}
+		else {
+			int sent = 0;
+
+			(void)MPI_Testall( sendCount, sendRequests, &sent, MPI_STATUSES_IGNORE );
+			if ( sent ) {
+				(void)MPI_Ibarrier( swarm->comm, &barrierRequest );
+				barrierActive = 1;
+			}
+		}
+	}
+
+	Memory_Free( sendRequests );
+	if ( sendBuf ) Memory_Free( sendBuf );
+	if ( recvBuf ) Memory_Free( recvBuf );
+	if ( routeProcs ) Memory_Free( routeProcs );
+	if ( routeParticles ) Memory_Free( routeParticles );
+	Memory_Free( destOffsets );
+	Memory_Free( destCounts );
+
+	/* Defensive check to make sure particles not lost/created accidentally somehow */
+	if( self->defensive == True ) {
+		ParticleMovementHandler_EnsureParticleCountLeavingDomainsEqualsCountEnteringGlobally( self );
+	}
+	Stream_UnIndentBranch( Swarm_Debug );
+}
+
+
 void ParticleMovementHandler_EnsureParticleCountLeavingDomainsEqualsCountEnteringGlobally( ParticleMovementHandler* self ) {
 	Particle_Index		totalParticlesFoundEnteringDomains = 0;
 
@@ -631,7 +816,7 @@ void ParticleMovementHandler_FinishReceiveAndUpdateShadowParticlesEnteringMyDoma
 							currParticle = (GlobalParticle*)ParticleAt(
 								self->particlesArrivingFromNbrShadowCells[nbr_I],
 								incomingParticle_I,
-								self->swarm->particleExtensionMgr->finalSize );
+								Swarm_PackedParticleSize( self->swarm ) );
 							Journal_DPrintfL( self->debug, 3, "Handling its PIC %d: - at "
 								"(%.2f,%.2f,%.2f)\n", cParticle_I,
 								currParticle->coord[0], currParticle->coord[1],
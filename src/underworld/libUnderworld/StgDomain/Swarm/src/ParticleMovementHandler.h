@@ -105,6 +105,13 @@
 		Particle_Index*      globalParticlesArrivingMyDomainCountPtr,
 		Particle_Index*      globalParticlesOutsideDomainTotalPtr );
 
+	/** Sends particles which have left my domain only to those processors whose domain bounding box contains
+	 *  them, using a sparse (NBX) exchange. Requires the swarm to use an ElementCellLayout. */
+	void ParticleMovementHandler_ShareAndUpdateParticlesThatHaveMovedOutsideDomainsSparse(
+		ParticleMovementHandler* self,
+		Particle_Index*      globalParticlesArrivingMyDomainCountPtr,
+		Particle_Index*      globalParticlesOutsideDomainTotalPtr );
+
 	void ParticleMovementHandler_EnsureParticleCountLeavingDomainsEqualsCountEnteringGlobally( ParticleMovementHandler* self );
 
 	void ParticleMovementHandler_ZeroGlobalCommStrategyCounters( ParticleMovementHandler* self );
@@ -299,7 +299,7 @@ void _ParticleShadowSync_BeginReceiveOfIncomingParticles( ParticleCommHandler* p
 	}
 
 	self->swarm->shadowParticles = Memory_Realloc( self->swarm->shadowParticles,
-			self->swarm->particleExtensionMgr->finalSize*(self->swarm->shadowParticleCount) );
+			Swarm_PackedParticleSize( self->swarm )*(self->swarm->shadowParticleCount) );
 	
 	recvLocation = (char*)self->swarm->shadowParticles;
 	for ( nbr_I=0; nbr_I < procNbrInfo->procNbrCnt; nbr_I++ ) {
@@ -308,7 +308,7 @@ void _ParticleShadowSync_BeginReceiveOfIncomingParticles( ParticleCommHandler* p
 			proc_I = procNbrInfo->procNbrTbl[nbr_I];
 
 			/* start non-blocking recv of particles */
-			incomingViaShadowArrayBytes = self->swarm->particleExtensionMgr->finalSize * 
+			incomingViaShadowArrayBytes = Swarm_PackedParticleSize( self->swarm ) * 
 				self->particlesArrivingFromNbrShadowCellsTotalCounts[nbr_I];
 			
 			/*printf( "receiving %ld bytes\n", incomingViaShadowArrayBytes );*/
@@ -375,7 +375,7 @@ void _ParticleShadowSync_SendShadowParticles( ParticleCommHandler *self )
 
 			self->shadowParticlesLeavingMeHandles[i] = Memory_Alloc_Array_Unnamed( MPI_Request, 1 );
 
-			arraySize =  self->swarm->particleExtensionMgr->finalSize * self->shadowParticlesLeavingMeTotalCounts[i];
+			arraySize =  Swarm_PackedParticleSize( self->swarm ) * self->shadowParticlesLeavingMeTotalCounts[i];
 			self->shadowParticlesLeavingMe[i] = Memory_Alloc_Bytes( arraySize, "Particle", "pCommHandler->outgoingPArray" );
 			memset( self->shadowParticlesLeavingMe[i], 0, arraySize );
 
@@ -392,9 +392,9 @@ void _ParticleShadowSync_SendShadowParticles( ParticleCommHandler *self )
 				}
 			}
 			
-			/*printf( "sending %ld bytes\n", self->shadowParticlesLeavingMeTotalCounts[i] * self->swarm->particleExtensionMgr->finalSize );*/
+			/*printf( "sending %ld bytes\n", self->shadowParticlesLeavingMeTotalCounts[i] * Swarm_PackedParticleSize( self->swarm ) );*/
 			MPI_Issend( self->shadowParticlesLeavingMe[i],
-			self->shadowParticlesLeavingMeTotalCounts[i] * self->swarm->particleExtensionMgr->finalSize,
+			self->shadowParticlesLeavingMeTotalCounts[i] * Swarm_PackedParticleSize( self->swarm ),
 			MPI_BYTE, proc_I, SHADOW_PARTICLES, self->swarm->comm,
 			self->shadowParticlesLeavingMeHandles[i] );
 		}
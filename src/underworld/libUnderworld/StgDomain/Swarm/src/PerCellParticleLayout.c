@@ -104,6 +104,7 @@ void _PerCellParticleLayout_SetInitialCounts( void* particleLayout, void* _swarm
 	Swarm*			swarm = (Swarm*)_swarm;
 	Cell_DomainIndex	cell_I = 0;
 
+	Swarm_ReleaseCellTables( swarm );
 	for( cell_I = 0; cell_I < swarm->cellLocalCount; cell_I++ ) {
 		swarm->cellParticleCountTbl[cell_I] = PerCellParticleLayout_InitialCount( self, swarm->cellLayout, cell_I );
 		
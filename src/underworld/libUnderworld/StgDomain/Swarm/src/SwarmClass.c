@@ -22,6 +22,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 
 const Type Swarm_Type = "Swarm";
 const Name defaultSwarmParticleCommHandlerName = "defaultSwarmPHandlerName";
@@ -33,6 +34,15 @@ const double DEFAULT_EXTRA_PARTICLES_FACTOR = 0.05;
 const unsigned int MINIMUM_PARTICLES_ARRAY_DELTA = 100;
 const unsigned int DEFAULT_CELL_PARTICLE_TBL_DELTA = 4;
 
+static Bool _Swarm_ReallocContiguousVariables(Swarm *self);
+static int _Swarm_CmpSortKey(const void *l, const void *r);
+
+typedef struct {
+  Cell_DomainIndex cell;
+  unsigned long long key;
+  Particle_Index particle_I;
+} Swarm_SortKey;
+
 /* --- Function Definitions --- */
 
 Swarm *Swarm_New(Name name, AbstractContext *context, void *cellLayout,
@@ -69,6 +79,10 @@ Swarm *_Swarm_New(SWARM_DEFARGS) {
   self->commHandlerList = Stg_ObjectList_New();
   self->nSwarmVars = 0;
   self->swarmVars = NULL;
+  self->contiguousVarCount = 0;
+  self->contiguousVars = NULL;
+  self->contiguousParticleSize = 0;
+  self->packedParticleSize = particleSize;
   self->owningCellVariable = NULL;
   self->globalIdVariable = NULL;
   self->gidExtHandle = (unsigned)-1;
@@ -125,6 +139,8 @@ void _Swarm_Init(Swarm *self, AbstractContext *context, void *cellLayout,
   self->shadowCellParticleCountTbl = NULL;
   self->shadowParticleCount = 0;
   self->cellParticleTblDelta = cellParticleTblDelta;
+  self->cellTablesOwner = NULL;
+  self->cellTablesSharer = NULL;
 
   self->particles = NULL;
   self->shadowParticles = NULL;
@@ -539,12 +555,13 @@ void *_Swarm_Copy(void *swarm, void *dest, Bool deep, Name nameExt,
       if ((newSwarm->shadowParticles =
                PtrMap_Find(map, self->shadowParticles)) == NULL) {
         if (self->shadowParticles) {
-          newSwarm->shadowParticles = (Particle_List)ExtensionManager_Malloc(
-              newSwarm->particleExtensionMgr, newSwarm->shadowParticleCount);
+          /* shadow particles are packed */
+          newSwarm->shadowParticles = (Particle_List)Memory_Alloc_Bytes(
+              newSwarm->shadowParticleCount * Swarm_PackedParticleSize(self),
+              "Particle", "Swarm->shadowParticles");
           memcpy(newSwarm->shadowParticles, self->shadowParticles,
                  newSwarm->shadowParticleCount *
-                     ExtensionManager_GetFinalSize(
-                         newSwarm->particleExtensionMgr));
+                     Swarm_PackedParticleSize(self));
           PtrMap_Append(map, self->shadowParticles, newSwarm->shadowParticles);
         } else {
           newSwarm->shadowParticles = NULL;
@@ -739,9 +756,20 @@ void _Swarm_Execute(void *swarm, void *data) {}
 void _Swarm_Destroy(void *swarm, void *data) {
   Swarm *self = (Swarm *)swarm;
   Cell_LocalIndex cell_I;
+  Index v_i;
+
+  /* Shared cell tables belong to their owner. */
+  if (self->cellTablesOwner) {
+    self->cellTablesOwner->cellTablesSharer = NULL;
+    self->cellParticleTbl = NULL;
+    self->cellParticleCountTbl = NULL;
+    self->cellParticleSizeTbl = NULL;
+    self->cellTablesOwner = NULL;
+  }
+  Swarm_ReleaseCellTables(self);
 
   for (cell_I = 0; cell_I < self->cellDomainCount; cell_I++) {
-    if (self->cellParticleTbl[cell_I]) {
+    if (self->cellParticleTbl && self->cellParticleTbl[cell_I]) {
       Memory_Free(self->cellParticleTbl[cell_I]);
       self->cellParticleTbl[cell_I] = NULL;
     }
@@ -765,11 +793,14 @@ void _Swarm_Destroy(void *swarm, void *data) {
     }
   }
 
-  Memory_Free(self->cellParticleTbl);
+  if (self->cellParticleTbl)
+    Memory_Free(self->cellParticleTbl);
   self->cellParticleTbl = NULL;
-  Memory_Free(self->cellParticleCountTbl);
+  if (self->cellParticleCountTbl)
+    Memory_Free(self->cellParticleCountTbl);
   self->cellParticleCountTbl = NULL;
-  Memory_Free(self->cellParticleSizeTbl);
+  if (self->cellParticleSizeTbl)
+    Memory_Free(self->cellParticleSizeTbl);
   self->cellParticleSizeTbl = NULL;
   if (self->particles) {
     ExtensionManager_Free(self->particleExtensionMgr, self->particles);
@@ -781,6 +812,18 @@ void _Swarm_Destroy(void *swarm, void *data) {
   FreeArray(self->swarmVars);
   self->swarmVars = NULL;
 
+  for (v_i = 0; v_i < self->contiguousVarCount; v_i++) {
+    SwarmVariable *swarmVar = self->contiguousVars[v_i];
+
+    if (swarmVar->contiguousData)
+      Memory_Free(swarmVar->contiguousData);
+    swarmVar->contiguousData = NULL;
+    swarmVar->contiguousArraySize = 0;
+  }
+  FreeArray(self->contiguousVars);
+  self->contiguousVars = NULL;
+  self->contiguousVarCount = 0;
+
   Memory_Free(self->cellPointTbl);
   self->cellPointTbl = NULL;
   Memory_Free(self->cellPointCountTbl);
@@ -873,6 +916,7 @@ void _Swarm_BuildParticles(void *swarm, void *data) {
 
   self->particles = (Particle_List)ExtensionManager_Malloc(
       self->particleExtensionMgr, self->particlesArraySize);
+  _Swarm_ReallocContiguousVariables(self);
   /*
   ** NEED TO UPDATE THINGS IF ARRAYS ARE REALLOC'D
   */
@@ -950,6 +994,10 @@ void Swarm_UpdateAllParticleOwners(void *swarm) {
   Progress *prog;
   int v_i;
 
+  /* Particles moved between processes are removed from the cell tables
+   * directly by the comm handlers. */
+  Swarm_ReleaseCellTables(self);
+
   prog = Progress_New();
   Progress_SetTitle(prog, "Updating particle owners");
   Progress_SetPrefix(prog, "\t");
@@ -1016,9 +1064,13 @@ void Swarm_UpdateParticleOwner(void *swarm, Particle_Index particle_I) {
 void Swarm_RemoveParticleFromCell(void *swarm, Cell_DomainIndex dCell_I,
                                   Particle_InCellIndex cParticle_I) {
   Swarm *self = (Swarm *)swarm;
-  Particle_InCellIndex *sizePtr = &self->cellParticleSizeTbl[dCell_I];
-  Particle_InCellIndex *countPtr = &self->cellParticleCountTbl[dCell_I];
+  Particle_InCellIndex *sizePtr;
+  Particle_InCellIndex *countPtr;
 
+  Swarm_ReleaseCellTables(self);
+
+  sizePtr = &self->cellParticleSizeTbl[dCell_I];
+  countPtr = &self->cellParticleCountTbl[dCell_I];
   self->cellParticleTbl[dCell_I][cParticle_I] =
       self->cellParticleTbl[dCell_I][*countPtr - 1];
   (*countPtr)--;
@@ -1035,7 +1087,6 @@ void Swarm_DeleteParticle(void *swarm, Particle_Index particleToDelete_lI) {
   Particle_Index lastParticle_I = 0;
   GlobalParticle *lastParticle = NULL;
   GlobalParticle *particleToDelete = NULL;
-  SizeT particleSize = self->particleExtensionMgr->finalSize;
   Stream *errorStr = Journal_Register(Error_Type, (Name)self->type);
 
   Journal_Firewall(particleToDelete_lI < self->particleLocalCount, errorStr,
@@ -1043,6 +1094,7 @@ void Swarm_DeleteParticle(void *swarm, Particle_Index particleToDelete_lI) {
                    "swarm's local particle count %u.\n",
                    __func__, particleToDelete_lI, self->particleLocalCount);
 
+  Swarm_ReleaseCellTables(self);
   particleToDelete =
       (GlobalParticle *)Swarm_ParticleAt(self, particleToDelete_lI);
   cParticle_I = Swarm_GetParticleIndexWithinCell(
@@ -1067,7 +1119,7 @@ void Swarm_DeleteParticle(void *swarm, Particle_Index particleToDelete_lI) {
         self, lastParticle_CellIndex, lastParticle_I);
 
     /* Copy over particle */
-    memcpy(particleToDelete, lastParticle, particleSize);
+    Swarm_CopyParticle(self, particleToDelete_lI, lastParticle_I);
 
     /* Change value in cell particle table to point to new index in array */
     self->cellParticleTbl[lastParticle_CellIndex]
@@ -1076,7 +1128,7 @@ void Swarm_DeleteParticle(void *swarm, Particle_Index particleToDelete_lI) {
 
   /* re-set memory at location of last particle to zero so it is clear that it's
    * been deleted */
-  memset(lastParticle, 0, particleSize);
+  Swarm_ZeroParticle(self, lastParticle_I);
 
   self->particleLocalCount--;
   /* Call the memory management function in case we need to re-allocate the
@@ -1097,6 +1149,7 @@ void Swarm_DeleteParticleAndReplaceWithNew(
                    "swarm's local particle count %u.\n",
                    __func__, particleToDelete_lI, self->particleLocalCount);
 
+  Swarm_ReleaseCellTables(self);
   particleToDelete =
       (GlobalParticle *)Swarm_ParticleAt(self, particleToDelete_lI);
   cParticle_I = Swarm_GetParticleIndexWithinCell(
@@ -1109,9 +1162,8 @@ void Swarm_DeleteParticleAndReplaceWithNew(
                    "adding it to cell %u\n",
                    particleToDelete_lI, replacementParticle_cellIndex);
 
-  /* Copy over particle to delete with it's replacement */
-  memcpy(particleToDelete, replacementParticle,
-         self->particleExtensionMgr->finalSize);
+  /* Copy over particle to delete with it's (packed) replacement */
+  Swarm_UnpackParticle(self, particleToDelete_lI, replacementParticle);
 
   /* Add a reference to replacement particle in appropriate cell entry */
   Swarm_AddParticleToCell(self, replacementParticle_cellIndex,
@@ -1121,11 +1173,14 @@ void Swarm_DeleteParticleAndReplaceWithNew(
 void Swarm_AddParticleToCell(void *swarm, Cell_DomainIndex dCell_I,
                              Particle_Index particle_I) {
   Swarm *self = (Swarm *)swarm;
-  Particle_InCellIndex *newCountPtr = &self->cellParticleCountTbl[dCell_I];
-  Particle_InCellIndex *newSizePtr = &self->cellParticleSizeTbl[dCell_I];
+  Particle_InCellIndex *newCountPtr;
+  Particle_InCellIndex *newSizePtr;
 
   Swarm_ParticleAt(self, particle_I)->owningCell = dCell_I;
+  Swarm_ReleaseCellTables(self);
 
+  newCountPtr = &self->cellParticleCountTbl[dCell_I];
+  newSizePtr = &self->cellParticleSizeTbl[dCell_I];
   if (*newCountPtr == *newSizePtr) {
     (*newSizePtr) += self->cellParticleTblDelta;
     self->cellParticleTbl[dCell_I] = Memory_Realloc_Array(
@@ -1135,6 +1190,90 @@ void Swarm_AddParticleToCell(void *swarm, Cell_DomainIndex dCell_I,
   (*newCountPtr)++;
 }
 
+void Swarm_ShareCellTables(void *swarm, void *_owner) {
+  Swarm *self = (Swarm *)swarm;
+  Swarm *owner = (Swarm *)_owner;
+  Cell_DomainIndex cell_I;
+
+  if (self->cellTablesOwner == owner)
+    return;
+  Journal_Firewall(!self->cellTablesOwner && !owner->cellTablesOwner &&
+                       !self->cellTablesSharer && !owner->cellTablesSharer,
+                   Swarm_Error,
+                   "Error - in %s(): swarm \"%s\" cannot share the cell tables "
+                   "of swarm \"%s\" as one of them already shares tables.\n",
+                   __func__, self->name, owner->name);
+  Journal_Firewall(self->cellDomainCount == owner->cellDomainCount &&
+                       owner->cellParticleTbl,
+                   Swarm_Error,
+                   "Error - in %s(): swarm \"%s\" (%u cells) cannot share the "
+                   "cell tables of swarm \"%s\" (%u cells).\n",
+                   __func__, self->name, self->cellDomainCount, owner->name,
+                   owner->cellDomainCount);
+
+  if (self->cellParticleTbl) {
+    for (cell_I = 0; cell_I < self->cellDomainCount; cell_I++) {
+      if (self->cellParticleTbl[cell_I])
+        Memory_Free(self->cellParticleTbl[cell_I]);
+    }
+    Memory_Free(self->cellParticleTbl);
+  }
+  if (self->cellParticleCountTbl)
+    Memory_Free(self->cellParticleCountTbl);
+  if (self->cellParticleSizeTbl)
+    Memory_Free(self->cellParticleSizeTbl);
+
+  self->cellParticleTbl = owner->cellParticleTbl;
+  self->cellParticleCountTbl = owner->cellParticleCountTbl;
+  self->cellParticleSizeTbl = owner->cellParticleSizeTbl;
+  self->cellTablesOwner = owner;
+  owner->cellTablesSharer = self;
+}
+
+void Swarm_UnshareCellTables(void *swarm) {
+  Swarm *self = (Swarm *)swarm;
+  Swarm *owner = self->cellTablesOwner;
+  Cell_DomainIndex cell_I;
+  Particle_InCellIndex count;
+
+  if (!owner)
+    return;
+
+  self->cellParticleCountTbl =
+      Memory_Alloc_Array(Particle_InCellIndex, self->cellDomainCount,
+                         "Swarm->cellParticleCountTbl");
+  self->cellParticleSizeTbl =
+      Memory_Alloc_Array(Particle_InCellIndex, self->cellDomainCount,
+                         "Swarm->cellParticleSizeTbl");
+  self->cellParticleTbl = Memory_Alloc_Array(
+      Cell_Particles, self->cellDomainCount, "Swarm->cellParticleTbl");
+  for (cell_I = 0; cell_I < self->cellDomainCount; cell_I++) {
+    count = owner->cellParticleCountTbl[cell_I];
+    self->cellParticleCountTbl[cell_I] = count;
+    self->cellParticleSizeTbl[cell_I] = count;
+    self->cellParticleTbl[cell_I] = NULL;
+    if (count) {
+      self->cellParticleTbl[cell_I] = Memory_Alloc_Array(
+          Particle_Index, count, "Swarm->cellParticleTbl[]");
+      memcpy(self->cellParticleTbl[cell_I], owner->cellParticleTbl[cell_I],
+             count * sizeof(Particle_Index));
+    }
+  }
+
+  owner->cellTablesSharer = NULL;
+  self->cellTablesOwner = NULL;
+}
+
+void Swarm_ReleaseCellTables(void *swarm) {
+  Swarm *self = (Swarm *)swarm;
+
+  /* Whichever of the two swarms modifies the tables first, the other must
+   * keep the tables as they stood, as its particles still match them. */
+  if (self->cellTablesSharer)
+    Swarm_UnshareCellTables(self->cellTablesSharer);
+  Swarm_UnshareCellTables(self);
+}
+
 void Swarm_AddShadowParticleToShadowCell(void *swarm, Cell_DomainIndex dCell_I,
                                          Particle_Index shadowParticle_I) {
   Swarm *self = (Swarm *)swarm;
@@ -1517,13 +1656,78 @@ SwarmVariable *Swarm_NewVectorVariable(void *_swarm, Name nameExt,
   return swarmVariable;
 }
 
+SwarmVariable *Swarm_NewContiguousVariable(void *_swarm, Name nameExt,
+                                           StgVariable_DataType dataType,
+                                           Index dataTypeCount) {
+  Swarm *self = (Swarm *)_swarm;
+  SwarmVariable *swarmVariable;
+  StgVariable *variable;
+  SizeT dataSize = StgVariable_SizeOfDataType(dataType);
+  Index comp_I;
+
+  /* Create as we would any other vector variable (at a valid, but unused,
+   * offset of zero), then point it at its own storage. Data is held
+   * contiguously per particle, so offsets are relative to the particle's
+   * entry within the variable's array. */
+  swarmVariable = Swarm_NewVectorVariable(self, nameExt, 0, dataType,
+                                          dataTypeCount, (Name)NULL);
+  swarmVariable->isContiguous = True;
+  swarmVariable->contiguousData = NULL;
+  swarmVariable->contiguousStride = dataTypeCount * dataSize;
+  swarmVariable->contiguousArraySize = 0;
+  swarmVariable->packedOffset = self->contiguousParticleSize;
+
+  variable = swarmVariable->variable;
+  variable->offsets[0] = 0;
+  variable->structSizePtr = &swarmVariable->contiguousStride;
+  variable->arrayPtrPtr = &swarmVariable->contiguousData;
+  for (comp_I = 0; comp_I < variable->subVariablesCount; comp_I++) {
+    StgVariable *component = variable->components[comp_I];
+
+    if (!component || component == variable)
+      continue;
+    component->offsets[0] = comp_I * dataSize;
+    component->structSizePtr = &swarmVariable->contiguousStride;
+    component->arrayPtrPtr = &swarmVariable->contiguousData;
+  }
+
+  self->contiguousVars =
+      MemRearray(self->contiguousVars, SwarmVariable *,
+                 self->contiguousVarCount + 1, SwarmClass_Type);
+  self->contiguousVars[self->contiguousVarCount] = swarmVariable;
+  self->contiguousVarCount++;
+  self->contiguousParticleSize += swarmVariable->contiguousStride;
+
+  /* If particles are already allocated, allocate to match */
+  if (self->particles)
+    Swarm_Realloc(self);
+
+  return swarmVariable;
+}
+
 StgVariable *Swarm_GetShadowVariable(void *_swarm, StgVariable *variable) {
   Swarm *self = (Swarm *)_swarm;
+  SizeT offsets[] = {0};
+  Index v_i;
+
+  /* Shadow particles are packed, so contiguous variable data follows the
+   * particle itself */
+  self->packedParticleSize = Swarm_PackedParticleSize(self);
+  offsets[0] = variable->offsets[0];
+  for (v_i = 0; v_i < self->contiguousVarCount; v_i++) {
+    SwarmVariable *swarmVar = self->contiguousVars[v_i];
+
+    if (variable->arrayPtrPtr == &swarmVar->contiguousData) {
+      offsets[0] += self->particleExtensionMgr->finalSize +
+                    swarmVar->packedOffset;
+      break;
+    }
+  }
   /* Construct */
   return StgVariable_New(
-      NULL, NULL, 1, variable->offsets, variable->dataTypes,
-      variable->dataTypeCounts, NULL, &self->particleExtensionMgr->finalSize,
-      &self->shadowParticleCount, NULL, (void **)&self->shadowParticles, NULL);
+      NULL, NULL, 1, offsets, variable->dataTypes, variable->dataTypeCounts,
+      NULL, &self->packedParticleSize, &self->shadowParticleCount, NULL,
+      (void **)&self->shadowParticles, NULL);
 }
 
 void Swarm_Realloc(void *swarm) {
@@ -1584,6 +1788,11 @@ void Swarm_Realloc(void *swarm) {
     //        }
   }
 
+  /* Contiguous variables track the size of the particles array */
+  if (_Swarm_ReallocContiguousVariables(self))
+    reallocSwarm = True;
+  self->packedParticleSize = Swarm_PackedParticleSize(self);
+
   if (reallocSwarm) {
     /*
     ** NEED TO UPDATE THINGS IF ARRAYS ARE REALLOC'D
@@ -1608,6 +1817,203 @@ void Swarm_Realloc(void *swarm) {
   }
 }
 
+static Bool _Swarm_ReallocContiguousVariables(Swarm *self) {
+  Bool reallocd = False;
+  Index v_i;
+
+  for (v_i = 0; v_i < self->contiguousVarCount; v_i++) {
+    SwarmVariable *swarmVar = self->contiguousVars[v_i];
+    Particle_Index oldSize = swarmVar->contiguousArraySize;
+    SizeT stride = swarmVar->contiguousStride;
+
+    if (oldSize == self->particlesArraySize)
+      continue;
+
+    swarmVar->contiguousData = Memory_Realloc_Array_Bytes(
+        swarmVar->contiguousData, stride, self->particlesArraySize);
+    /* New entries are zeroed, as they are for particles added via
+     * Swarm_DeleteParticle() holes */
+    if (self->particlesArraySize > oldSize)
+      memset((char *)swarmVar->contiguousData + oldSize * stride, 0,
+             (self->particlesArraySize - oldSize) * stride);
+    swarmVar->contiguousArraySize = self->particlesArraySize;
+    reallocd = True;
+  }
+
+  return reallocd;
+}
+
+void Swarm_PackParticle(void *swarm, void *dest, Particle_Index lParticle_I) {
+  Swarm *self = (Swarm *)swarm;
+  SizeT particleSize = self->particleExtensionMgr->finalSize;
+  char *packed = (char *)dest + particleSize;
+  Index v_i;
+
+  memcpy(dest, Swarm_ParticleAt(self, lParticle_I), particleSize);
+  for (v_i = 0; v_i < self->contiguousVarCount; v_i++) {
+    SwarmVariable *swarmVar = self->contiguousVars[v_i];
+    SizeT stride = swarmVar->contiguousStride;
+
+    memcpy(packed + swarmVar->packedOffset,
+           (char *)swarmVar->contiguousData + lParticle_I * stride, stride);
+  }
+}
+
+void Swarm_UnpackParticle(void *swarm, Particle_Index lParticle_I, void *src) {
+  Swarm *self = (Swarm *)swarm;
+  SizeT particleSize = self->particleExtensionMgr->finalSize;
+  char *packed = (char *)src + particleSize;
+  Index v_i;
+
+  memcpy(Swarm_ParticleAt(self, lParticle_I), src, particleSize);
+  for (v_i = 0; v_i < self->contiguousVarCount; v_i++) {
+    SwarmVariable *swarmVar = self->contiguousVars[v_i];
+    SizeT stride = swarmVar->contiguousStride;
+
+    memcpy((char *)swarmVar->contiguousData + lParticle_I * stride,
+           packed + swarmVar->packedOffset, stride);
+  }
+}
+
+void Swarm_CopyParticle(void *swarm, Particle_Index destIndex,
+                        Particle_Index srcIndex) {
+  Swarm *self = (Swarm *)swarm;
+  Index v_i;
+
+  CopyParticle(self->particles, destIndex, self->particles, srcIndex,
+               self->particleExtensionMgr->finalSize);
+  for (v_i = 0; v_i < self->contiguousVarCount; v_i++) {
+    SwarmVariable *swarmVar = self->contiguousVars[v_i];
+
+    CopyParticle(swarmVar->contiguousData, destIndex, swarmVar->contiguousData,
+                 srcIndex, swarmVar->contiguousStride);
+  }
+}
+
+void Swarm_ZeroParticle(void *swarm, Particle_Index lParticle_I) {
+  Swarm *self = (Swarm *)swarm;
+  Index v_i;
+
+  memset(Swarm_ParticleAt(self, lParticle_I), 0,
+         self->particleExtensionMgr->finalSize);
+  for (v_i = 0; v_i < self->contiguousVarCount; v_i++) {
+    SwarmVariable *swarmVar = self->contiguousVars[v_i];
+    SizeT stride = swarmVar->contiguousStride;
+
+    memset((char *)swarmVar->contiguousData + lParticle_I * stride, 0, stride);
+  }
+}
+
+void Swarm_SortParticles(void *swarm) {
+  Swarm *self = (Swarm *)swarm;
+  Particle_Index particleLocalCount = self->particleLocalCount;
+  SizeT particleSize = self->particleExtensionMgr->finalSize;
+  Bool useCoords = (self->particleLayout->coordSystem == GlobalCoordSystem);
+  const unsigned maxInd = (1u << 21) - 1;
+  double min[3], max[3], scale[3];
+  unsigned inds[3];
+  Swarm_SortKey *keys;
+  char *tmp;
+  Particle_Index lParticle_I;
+  Cell_LocalIndex cell_I;
+  Index v_i;
+  Dimension_Index d_i;
+
+  if (particleLocalCount < 2)
+    return;
+  Swarm_ReleaseCellTables(self);
+
+  /* Particle coordinates are quantised against the local particle bounding box
+   * so that the Morton keys use the full available resolution. */
+  if (useCoords) {
+    for (d_i = 0; d_i < self->dim; d_i++) {
+      min[d_i] = HUGE_VAL;
+      max[d_i] = -HUGE_VAL;
+    }
+    for (lParticle_I = 0; lParticle_I < particleLocalCount; lParticle_I++) {
+      double *coord =
+          ((GlobalParticle *)Swarm_ParticleAt(self, lParticle_I))->coord;
+      for (d_i = 0; d_i < self->dim; d_i++) {
+        if (coord[d_i] < min[d_i])
+          min[d_i] = coord[d_i];
+        if (coord[d_i] > max[d_i])
+          max[d_i] = coord[d_i];
+      }
+    }
+    for (d_i = 0; d_i < self->dim; d_i++)
+      scale[d_i] =
+          (max[d_i] > min[d_i]) ? (double)maxInd / (max[d_i] - min[d_i]) : 0.0;
+  }
+
+  /* Order is cell-major, so that particles belonging to the same cell are
+   * adjacent in memory and cells are visited in their local numbering order.
+   * Within each cell particles follow a Morton curve through their coords. */
+  keys = Memory_Alloc_Array(Swarm_SortKey, particleLocalCount, "Swarm_SortKey");
+  for (lParticle_I = 0; lParticle_I < particleLocalCount; lParticle_I++) {
+    StandardParticle *particle = Swarm_ParticleAt(self, lParticle_I);
+
+    keys[lParticle_I].cell = particle->owningCell;
+    keys[lParticle_I].key = 0;
+    keys[lParticle_I].particle_I = lParticle_I;
+    if (useCoords) {
+      double *coord = ((GlobalParticle *)particle)->coord;
+      for (d_i = 0; d_i < self->dim; d_i++)
+        inds[d_i] = (unsigned)((coord[d_i] - min[d_i]) * scale[d_i]);
+      keys[lParticle_I].key = StG_MortonKey(self->dim, inds);
+    }
+  }
+  qsort(keys, particleLocalCount, sizeof(Swarm_SortKey), _Swarm_CmpSortKey);
+
+  /* Permute the particles array and each contiguous variable via a scratch
+   * buffer, so the arrays themselves (and any pointers to them) are kept. */
+  tmp = Memory_Alloc_Array_Bytes_Unnamed(particleSize, particleLocalCount,
+                                         "char");
+  for (lParticle_I = 0; lParticle_I < particleLocalCount; lParticle_I++)
+    memcpy(tmp + lParticle_I * particleSize,
+           Swarm_ParticleAt(self, keys[lParticle_I].particle_I), particleSize);
+  memcpy(self->particles, tmp, particleLocalCount * particleSize);
+  for (v_i = 0; v_i < self->contiguousVarCount; v_i++) {
+    SwarmVariable *swarmVar = self->contiguousVars[v_i];
+    SizeT stride = swarmVar->contiguousStride;
+    char *data = (char *)swarmVar->contiguousData;
+
+    tmp = Memory_Realloc_Array_Bytes(tmp, stride, particleLocalCount);
+    for (lParticle_I = 0; lParticle_I < particleLocalCount; lParticle_I++)
+      memcpy(tmp + lParticle_I * stride,
+             data + keys[lParticle_I].particle_I * stride, stride);
+    memcpy(data, tmp, particleLocalCount * stride);
+  }
+  Memory_Free(tmp);
+  Memory_Free(keys);
+
+  /* Rebuild the cell particle tables. Cell counts are unchanged, so the tables
+   * need no reallocation. */
+  for (cell_I = 0; cell_I < self->cellLocalCount; cell_I++)
+    self->cellParticleCountTbl[cell_I] = 0;
+  for (lParticle_I = 0; lParticle_I < particleLocalCount; lParticle_I++) {
+    Cell_DomainIndex owningCell = Swarm_ParticleAt(self, lParticle_I)->owningCell;
+
+    if (owningCell < self->cellLocalCount)
+      self->cellParticleTbl[owningCell]
+                           [self->cellParticleCountTbl[owningCell]++] =
+          lParticle_I;
+  }
+}
+
+static int _Swarm_CmpSortKey(const void *l, const void *r) {
+  const Swarm_SortKey *left = (const Swarm_SortKey *)l;
+  const Swarm_SortKey *right = (const Swarm_SortKey *)r;
+
+  if (left->cell != right->cell)
+    return (left->cell < right->cell) ? -1 : 1;
+  if (left->key != right->key)
+    return (left->key < right->key) ? -1 : 1;
+  /* Keep the sort stable for particles sharing a key */
+  if (left->particle_I != right->particle_I)
+    return (left->particle_I < right->particle_I) ? -1 : 1;
+  return 0;
+}
+
 void Swarm_CheckCoordsAreFinite(void *swarm) {
   Swarm *self = (Swarm *)swarm;
   GlobalParticle *particle;
@@ -93,6 +93,11 @@
 		Stg_ObjectList                  *commHandlerList; \
 		int				nSwarmVars; \
 		SwarmVariable			**swarmVars; \
+		/** Variables stored in their own contiguous arrays rather than within the particle */ \
+		Index				contiguousVarCount; \
+		SwarmVariable			**contiguousVars; \
+		SizeT				contiguousParticleSize; /**< Bytes per particle held by contiguous variables */ \
+		SizeT				packedParticleSize;     /**< Size of a particle when packed for transfer */ \
 		\
 		VariableCondition*		ics; \
 		Index                           swarmReg_I; /**< Own index inside the Swarm_Register */ \
@@ -102,6 +107,8 @@
 		int                             expanding;  \
 		Bool                            isAdvecting;     \
 		Swarm*                          mirroredSwarm;          /* swarm this swarm mirrors (if any) */ \
+		Swarm*                          cellTablesOwner;        /* swarm whose cell particle tables are shared (if any) */ \
+		Swarm*                          cellTablesSharer;       /* swarm sharing this swarm's cell particle tables (if any) */ \
 		Bool                            allow_parallel_nn;
 
 	struct Swarm { __Swarm };
@@ -167,8 +174,13 @@
 	#define Swarm_ParticleAt( self, dParticle_I ) \
 		( ParticleAt( (self)->particles, (dParticle_I), (self)->particleExtensionMgr->finalSize ) )
 	
+	/** Size of a particle packed for transfer: the particle itself, followed by its contiguous variable data */
+	#define Swarm_PackedParticleSize( self ) \
+		( (self)->particleExtensionMgr->finalSize + (self)->contiguousParticleSize )
+
+	/** Shadow particles are held packed */
 	#define Swarm_ShadowParticleAt( self, dParticle_I ) \
-		( ParticleAt( (self)->shadowParticles, (dParticle_I), (self)->particleExtensionMgr->finalSize ) )
+		( ParticleAt( (self)->shadowParticles, (dParticle_I), Swarm_PackedParticleSize( self ) ) )
 
 	#define ParticleAt( array, particle_I, particleSize ) \
 		((StandardParticle*)((ArithPointer)(array) + (particle_I) * (particleSize)))
@@ -177,13 +189,14 @@
 		(memcpy( ParticleAt( (destArray), (destIndex), (pSize) ), ParticleAt( (srcArray), (srcIndex), (pSize) ), (pSize) ))
 
 	#define Swarm_CopyParticleWithinSwarm( self, destIndex, srcIndex ) \
-		( CopyParticle( (self)->particles, (destIndex), (self)->particles, (srcIndex), (self)->particleExtensionMgr->finalSize ) )
+		( Swarm_CopyParticle( (self), (destIndex), (srcIndex) ) )
 
+	/* Arrays of particles exchanged with other swarms/processors are packed */
 	#define Swarm_CopyParticleOntoSwarm( self, destIndex, srcArray, srcIndex ) \
-		( CopyParticle( (self)->particles, destIndex, srcArray, srcIndex, (self)->particleExtensionMgr->finalSize ) )
+		( Swarm_UnpackParticle( (self), (destIndex), ParticleAt( (srcArray), (srcIndex), Swarm_PackedParticleSize( self ) ) ) )
 
 	#define Swarm_CopyParticleOffSwarm( self, destArray, destIndex, srcIndex ) \
-		( CopyParticle( (destArray), (destIndex), (self)->particles, (srcIndex), (self)->particleExtensionMgr->finalSize ) )
+		( Swarm_PackParticle( (self), ParticleAt( (destArray), (destIndex), Swarm_PackedParticleSize( self ) ), (srcIndex) ) )
 
 	void* _Swarm_ParticleAt( void* swarm, Particle_Index dParticle_I );
 	
@@ -270,8 +283,46 @@
 		Index                           dataTypeCount,
 		...                         /* vector component names */ );
 
+	/** Creates a variable whose data is stored in its own contiguous array (structure-of-arrays),
+	 *  rather than as an extension of the particle structure. */
+	SwarmVariable* Swarm_NewContiguousVariable(
+		void*                           _swarm,
+		Name                            nameExt,
+		StgVariable_DataType               dataType,
+		Index                           dataTypeCount );
+
 	void Swarm_Realloc( void* swarm ) ;
 
+	/** Copies a local particle, including its contiguous variable data, into/out of a packed buffer
+	 *  of size Swarm_PackedParticleSize() */
+	void Swarm_PackParticle( void* swarm, void* dest, Particle_Index lParticle_I );
+	void Swarm_UnpackParticle( void* swarm, Particle_Index lParticle_I, void* src );
+
+	/** Copies a local particle, including its contiguous variable data, to another local index */
+	void Swarm_CopyParticle( void* swarm, Particle_Index destIndex, Particle_Index srcIndex );
+
+	/** Zeroes a local particle, including its contiguous variable data */
+	void Swarm_ZeroParticle( void* swarm, Particle_Index lParticle_I );
+
+	/** Reorders the local particles, cell by cell, along a Morton space-filling curve through their
+	 *  coordinates, and rebuilds the cell particle tables to match. Particle indices held elsewhere
+	 *  (e.g. mappers or kd-tree indices) are invalidated. */
+	void Swarm_SortParticles( void* swarm );
+
+	/** Makes this swarm use the cell particle tables of 'owner' rather than its own, for swarms whose particles
+	 *  coincide index for index (e.g. integration swarms mirroring a material swarm). Once either swarm modifies
+	 *  the tables, this swarm is first given its own copy of them (see Swarm_ReleaseCellTables), so that each
+	 *  swarm remains consistent with its own particles until it is next mapped. */
+	void Swarm_ShareCellTables( void* swarm, void* owner );
+
+	/** Gives a swarm sharing the cell particle tables of another its own copy of them, as they currently stand. */
+	void Swarm_UnshareCellTables( void* swarm );
+
+	/** Must be called before a swarm modifies its cell particle tables, so that any swarm sharing them, or the swarm
+	 *  itself if it shares another's, first takes its own copy. Swarm functions which modify the tables call this
+	 *  themselves. */
+	void Swarm_ReleaseCellTables( void* swarm );
+
 	void Swarm_CheckCoordsAreFinite( void* swarm ) ;
 
 	void Swarm_AssignIndexWithinShape( void* swarm, void* _shape, StgVariable* variableToAssign, Index indexToAssign ) ;
@@ -97,6 +97,11 @@ void _SwarmVariable_Init( void* swarmVariable,
    self->dim                         = swarm->dim;
    self->useCacheMaxMin              = useCacheMaxMin;
    self->addToSwarmParticleExtension = addToSwarmParticleExtension;
+   self->isContiguous                = False;
+   self->contiguousData              = NULL;
+   self->contiguousStride            = 0;
+   self->contiguousArraySize         = 0;
+   self->packedOffset                = 0;
 	
    if( variable ){  //OK: This seems dodgy but if condition removed causes DirectorSuite tests to fail...
       Swarm_AddVariable( swarm, self );
@@ -39,7 +39,13 @@
       double                                    magnitudeMax;  \
       Bool                                      useCacheMaxMin; \
       Bool                                      useKDTree; \
-	  Bool                                      addToSwarmParticleExtension;
+	  Bool                                      addToSwarmParticleExtension; \
+      /* Contiguous (structure-of-arrays) storage, see Swarm_NewContiguousVariable() */ \
+      Bool                                      isContiguous; \
+      void*                                     contiguousData; \
+      SizeT                                     contiguousStride;    /**< Bytes per particle */ \
+      Index                                     contiguousArraySize; /**< Particles allocated for */ \
+      SizeT                                     packedOffset;        /**< Offset within the packed particle */
 
 	struct SwarmVariable { __SwarmVariable };	
 
@@ -152,5 +152,10 @@ PetscErrorCode Stg_VecLoad(PetscViewer viewer, const VecType outtype,Vec *newvec
     #define PetscOptionsInsertFile(arg1,arg2,arg3) PetscOptionsInsertFile(arg1, NULL, arg2, arg3)
 #endif
 
+#if ( (PETSC_VERSION_MAJOR == 3) && (PETSC_VERSION_MINOR < 8 ) )
+    #define MatCreateSubMatrices MatGetSubMatrices
+    #define MatDestroySubMatrices(n, mats) MatDestroyMatrices(n, mats)
+#endif
+
 #endif /* __StgDomain_Utils_PETScCompatibility_h__ */
 
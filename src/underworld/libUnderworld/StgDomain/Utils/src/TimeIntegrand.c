@@ -59,6 +59,8 @@ TimeIntegrand* _TimeIntegrand_New(  TIMEINTEGRAND_DEFARGS  )
 	/* virtual info */
 	self->_calculateTimeDeriv = _calculateTimeDeriv;
 	self->_intermediate = _intermediate;
+	/* Children which can evaluate all their time derivatives at once set this after construction */
+	self->_calculateTimeDerivs = NULL;
 
 	/* Create empty string. Children classes might add something useful */
 	Stg_asprintf(&self->error_msg, "");
@@ -213,6 +215,11 @@ void TimeIntegrand_FirstOrder( void* timeIntegrand, StgVariable* startValue, dou
 	Bool            successFlag = False;
 	Stream*         errorStream = Journal_Register( Error_Type, (Name)self->type  );
 
+	if ( self->_calculateTimeDerivs ) {
+		_TimeIntegrand_RungeKuttaBatched( self, startValue, dt, 1 );
+		return;
+	}
+
 	Journal_DPrintf( self->debug, "In func %s for %s '%s'\n", __func__, self->type, self->name );
 
 	/* Update Variables */
@@ -261,6 +268,11 @@ void TimeIntegrand_SecondOrder( void* timeIntegrand, StgVariable* startValue, do
 	Bool            successFlag = False;
 	Stream*         errorStream = Journal_Register( Error_Type, (Name)self->type  );
 
+	if ( self->_calculateTimeDerivs ) {
+		_TimeIntegrand_RungeKuttaBatched( self, startValue, dt, 2 );
+		return;
+	}
+
 	timeDeriv = Memory_Alloc_Array( double, componentCount, "Time Deriv" );
 	startData = Memory_Alloc_Array( double, componentCount, "StartData" );
 	memset( timeDeriv, 0, componentCount * sizeof( double ) );
@@ -334,6 +346,11 @@ void TimeIntegrand_FourthOrder( void* timeIntegrand, StgVariable* startValue, do
 	Bool            successFlag = False;
 	Stream*         errorStream = Journal_Register( Error_Type, (Name)self->type  );
 
+	if ( self->_calculateTimeDerivs ) {
+		_TimeIntegrand_RungeKuttaBatched( self, startValue, dt, 4 );
+		return;
+	}
+
 	timeDeriv      = Memory_Alloc_Array( double, componentCount, "Time Deriv" );
 	startData      = Memory_Alloc_Array( double, componentCount, "StartData" );
 	finalTimeDeriv = Memory_Alloc_Array( double, componentCount, "StartData" );
@@ -468,6 +485,121 @@ void _TimeIntegrand_RewindToStartAndApplyFirstOrderUpdate(
 }
 
 
+/* Stage-by-stage Runge-Kutta update for integrands providing _calculateTimeDerivs. Rather than
+ * taking every item through all of its stages in turn, each stage is one batched derivative
+ * evaluation over all items. Items whose derivative cannot be found get a single retry through
+ * _calculateTimeDeriv (which also sets error_msg) before the usual fallback/error handling. */
+void _TimeIntegrand_RungeKuttaBatched( TimeIntegrand* self, StgVariable* startValue, double dt, Index order ) {
+	/* Stage times (as fractions of dt) and final weights of the explicit midpoint and classic RK4
+	 * schemes. The item positions for stage s+1 are start + stageTime[s+1] * dt * k_s. */
+	static const double firstOrderTime[]   = { 0.0 };
+	static const double firstOrderWeight[] = { 1.0 };
+	static const double secondOrderTime[]   = { 0.0, 0.5 };
+	static const double secondOrderWeight[] = { 0.0, 1.0 };
+	static const double fourthOrderTime[]   = { 0.0, 0.5, 0.5, 1.0 };
+	static const double fourthOrderWeight[] = { 1.0/6.0, 2.0/6.0, 2.0/6.0, 1.0/6.0 };
+	StgVariable*       variable       = self->variable;
+	const double*   stageTime;
+	const double*   stageWeight;
+	Index           stageCount;
+	Index           stage_I;
+	double*         arrayDataPtr;
+	double*         startData;
+	double*         firstTimeDeriv;
+	double*         timeDeriv;
+	double*         finalTimeDeriv;
+	Bool*           successFlags;
+	Bool*           done;
+	Index           component_I; 
+	Index           componentCount = *variable->dataTypeCounts;
+	Index           array_I; 
+	Index           arrayCount;
+	double          startTime      = TimeIntegrator_GetTime( self->timeIntegrator );
+	Stream*         errorStream = Journal_Register( Error_Type, (Name)self->type  );
+
+	switch( order ) {
+		case 1:  stageTime = firstOrderTime;  stageWeight = firstOrderWeight;  stageCount = 1; break;
+		case 2:  stageTime = secondOrderTime; stageWeight = secondOrderWeight; stageCount = 2; break;
+		default: stageTime = fourthOrderTime; stageWeight = fourthOrderWeight; stageCount = 4; break;
+	}
+
+	/* Update Variables */
+	StgVariable_Update( variable );
+	StgVariable_Update( startValue );
+	arrayCount     = variable->arraySize;
+	if ( arrayCount == 0 )
+		return;
+
+	startData      = Memory_Alloc_Array( double, arrayCount * componentCount, "StartData" );
+	firstTimeDeriv = Memory_Alloc_Array( double, arrayCount * componentCount, "First Time Deriv" );
+	timeDeriv      = Memory_Alloc_Array( double, arrayCount * componentCount, "Time Deriv" );
+	finalTimeDeriv = Memory_Alloc_Array( double, arrayCount * componentCount, "Final Time Deriv" );
+	successFlags   = Memory_Alloc_Array( Bool, arrayCount, "successFlags" );
+	done           = Memory_Alloc_Array( Bool, arrayCount, "done" );
+	memset( finalTimeDeriv, 0, arrayCount * componentCount * sizeof( double ) );
+	memset( done, 0, arrayCount * sizeof( Bool ) );
+
+	/* Store Original Values in case startValue == self->variable */
+	for ( array_I = 0 ; array_I < arrayCount ; array_I++ )
+		memcpy( &startData[ array_I * componentCount ], StgVariable_GetPtrDouble( startValue, array_I ), sizeof( double ) * componentCount );
+
+	for ( stage_I = 0 ; stage_I < stageCount ; stage_I++ ) {
+		double* k = ( stage_I == 0 ) ? firstTimeDeriv : timeDeriv;
+
+		TimeIntegrator_SetTime( self->timeIntegrator, startTime + stageTime[ stage_I ] * dt );
+		self->_calculateTimeDerivs( self, arrayCount, k, successFlags );
+
+		for ( array_I = 0 ; array_I < arrayCount ; array_I++ ) {
+			double* k_I     = &k[ array_I * componentCount ];
+			double* start_I = &startData[ array_I * componentCount ];
+			double* final_I = &finalTimeDeriv[ array_I * componentCount ];
+
+			if ( done[ array_I ] )
+				continue;
+			arrayDataPtr = StgVariable_GetPtrDouble( variable, array_I );
+
+			if ( !successFlags[ array_I ] && !TimeIntegrand_CalculateTimeDeriv( self, array_I, k_I ) ) {
+				Journal_Firewall( stage_I > 0, errorStream,
+					"Error - in %s(), for TimeIntegrand \"%s\" of type %s: When trying to find time "
+					"deriv for item %u in step %u, *failed*.\n\n%s",
+					__func__, self->name, self->type, array_I, 1, self->error_msg );
+				Journal_Firewall( True == self->allowFallbackToFirstOrder, errorStream,
+					"Error - in %s(), for TimeIntegrand \"%s\" of type %s: When trying to find time "
+					"deriv for item %u in step %u, *failed*, and self->allowFallbackToFirstOrder "
+					"not enabled.\n\n%s", __func__, self->name, self->type, array_I, stage_I + 1, self->error_msg );
+
+				/* Apply a full dt first order update from the start, using the first stage's derivative */
+				for ( component_I = 0 ; component_I < componentCount ; component_I++ ) 
+					arrayDataPtr[ component_I ] = start_I[ component_I ] + dt * firstTimeDeriv[ array_I * componentCount + component_I ];
+				TimeIntegrand_Intermediate( self, array_I );
+				done[ array_I ] = True;
+				continue;
+			}
+
+			for ( component_I = 0 ; component_I < componentCount ; component_I++ ) 
+				final_I[ component_I ] += stageWeight[ stage_I ] * k_I[ component_I ];
+
+			if ( stage_I + 1 < stageCount ) {
+				for ( component_I = 0 ; component_I < componentCount ; component_I++ ) 
+					arrayDataPtr[ component_I ] = start_I[ component_I ] + stageTime[ stage_I + 1 ] * dt * k_I[ component_I ];
+			}
+			else {
+				for ( component_I = 0 ; component_I < componentCount ; component_I++ ) 
+					arrayDataPtr[ component_I ] = start_I[ component_I ] + dt * final_I[ component_I ];
+			}
+			TimeIntegrand_Intermediate( self, array_I );
+		}
+	}
+
+	Memory_Free( startData );
+	Memory_Free( firstTimeDeriv );
+	Memory_Free( timeDeriv );
+	Memory_Free( finalTimeDeriv );
+	Memory_Free( successFlags );
+	Memory_Free( done );
+}
+
+
 /** +++ Sample Time Deriv Functions +++ **/
 
 
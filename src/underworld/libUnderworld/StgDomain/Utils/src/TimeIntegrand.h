@@ -13,6 +13,9 @@
 	
 	typedef Bool (TimeIntegrand_CalculateTimeDerivFunction) ( void* timeIntegrator, Index array_I, double* timeDeriv );
 	typedef void (TimeIntegrand_IntermediateFunction) ( void* timeIntegrator, Index array_I );
+	/* Optional batched form of _calculateTimeDeriv: evaluates the time derivative of every item
+	 * (writing item array_I's to timeDerivs + array_I * componentCount) and flags failures */
+	typedef void (TimeIntegrand_CalculateTimeDerivsFunction) ( void* timeIntegrator, Index arrayCount, double* timeDerivs, Bool* successFlags );
 
 	extern const Type TimeIntegrand_Type;
 	
@@ -25,6 +28,7 @@
 		/* Virtual info */ \
 		TimeIntegrand_CalculateTimeDerivFunction* _calculateTimeDeriv;  \
 		TimeIntegrand_IntermediateFunction*       _intermediate;  \
+		TimeIntegrand_CalculateTimeDerivsFunction* _calculateTimeDerivs;  \
 		/* Other info */ \
 		TimeIntegrator*                            timeIntegrator;       \
 		StgVariable*                                  variable;             \
@@ -106,6 +110,7 @@ void _TimeIntegrand_Init(
 		double          dt,
 		double*         timeDeriv,
 		Index           array_I );
+	void _TimeIntegrand_RungeKuttaBatched( TimeIntegrand* self, StgVariable* startValue, double dt, Index order );
 
 	/* +++ Public Functions +++ */
 	void TimeIntegrand_FirstOrder( void* timeIntegrator, StgVariable* startValue, double dt );
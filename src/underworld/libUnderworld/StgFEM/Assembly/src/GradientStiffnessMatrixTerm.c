@@ -49,6 +49,9 @@ GradientStiffnessMatrixTerm* _GradientStiffnessMatrixTerm_New(  GRADIENTSTIFFNES
 	
 	/* Virtual info */
 	
+	/* Element workspace is on the stack, so elements may be assembled concurrently */
+	self->threadSafe = True;
+	
 	return self;
 }
 
@@ -150,8 +153,9 @@ void _GradientStiffnessMatrixTerm_AssembleElement(
 	Node_ElementLocalIndex              rowNode_I;
 	Node_ElementLocalIndex              colNode_I;
 	Dof_Index                           rowDof_I, colDof_I;
-	double**                            GNx_row;
-	double*                             Ni_col;
+	double                              GNxData[3][MAX_ELEMENT_NODES];
+	double*                             GNx_row[3] = { GNxData[0], GNxData[1], GNxData[2] };
+	double                              Ni_col[MAX_ELEMENT_NODES];
 	double                              detJac;
 	IntegrationPoint*                   currIntegrationPoint;
 	
@@ -169,19 +173,7 @@ void _GradientStiffnessMatrixTerm_AssembleElement(
 	dofPerNode_row = dim;	/* velocity */
 	dofPerNode_col = 1;	/* pressure */
 	
-	if( nodesPerEl_row > self->max_nElNodes ) {
-		/* reallocate */
-		self->GNx = ReallocArray2D( self->GNx, double, dim, nodesPerEl_row );
-		self->max_nElNodes = nodesPerEl_row;
-	}
-	GNx_row = self->GNx;
-
-	if( nodesPerEl_col > self->max_nElNodes_col ) {
-   /* allocate */
-		self->Ni_col = ReallocArray( self->Ni_col, double, nodesPerEl_col );
-		self->max_nElNodes_col = nodesPerEl_col;
-	}
-	Ni_col = self->Ni_col;
+	assert( nodesPerEl_row <= MAX_ELEMENT_NODES && nodesPerEl_col <= MAX_ELEMENT_NODES );
 	
 	cell_I = CellLayout_MapElementIdToCellId( swarm->cellLayout, lElement_I );
 	cellParticleCount = swarm->cellParticleCountTbl[ cell_I ];
@@ -218,6 +218,7 @@ void C0Generator_BuildGeometry( C0Generator* self, FeMesh* mesh ) {
 		memcpy( vert, centroid, nDims * sizeof(double) );
 	}
 	FreeArray( centroid );
+	mesh->deformVersion++;
 }
 
 void C0Generator_BuildElementTypes( C0Generator* self, FeMesh* mesh ) {
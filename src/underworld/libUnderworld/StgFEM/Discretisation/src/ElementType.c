@@ -44,12 +44,19 @@ ElementType* _ElementType_New(  ELEMENTTYPE_DEFARGS  ) {
 }
 
 void _ElementType_Init( ElementType* self, Index nodeCount ) {
+	unsigned thread_i;
+
 	/* General and Virtual info should already be set */
 	self->dim = 0;
 	/* ElementType info */
 	self->nodeCount = nodeCount;
 	self->debug = Stream_RegisterChild( StgFEM_Discretisation_Debug, ElementType_Type );
 	self->inc = IArray_New();
+	/* Incidence is fetched into per thread arrays, so that elements may be evaluated concurrently */
+	self->threadInc = Memory_Alloc_Array( IArray*, Threads_GetMaxCount(), "ElementType_threadInc" );
+	self->threadInc[0] = self->inc;
+	for( thread_i = 1; thread_i < Threads_GetMaxCount(); thread_i++ )
+		self->threadInc[thread_i] = IArray_New();
 	/* Using 3 here instead of dim so that you can pass in dim = 2 and use axes 0 and 2 for your jacobian */
 	self->_jacobian = Memory_Alloc_2DArray( double, 3, 3, (Name)"Temporary Jacobian"  );
 
@@ -58,9 +65,13 @@ void _ElementType_Init( ElementType* self, Index nodeCount ) {
 
 void _ElementType_Destroy( void* elementType, void* data ){
 	ElementType* self = (ElementType*)elementType;
+	unsigned     thread_i;
 
 	Memory_Free(self->_jacobian); self->_jacobian = NULL;
 	
+	for( thread_i = 1; thread_i < Threads_GetMaxCount(); thread_i++ )
+		Stg_Class_Delete( self->threadInc[thread_i] );
+	Memory_Free( self->threadInc );
 	Stg_Class_Delete( self->inc );
 }
 
@@ -318,7 +329,9 @@ void ElementType_ShapeFunctionsGlobalDerivs(
 	double jac[3][3];
 	int rows;		/* max dimensions */
 	int cols;		/* max nodes per el */
-	double** GNi; 
+	double GNiData[3][MAX_ELEMENT_NODES];
+	double* GNi[3] = { GNiData[0], GNiData[1], GNiData[2] };
+	IArray* incArray = self->threadInc[Threads_GetIndex()];
 	int n, i, j;
 	double globalSF_DerivVal;
 	int dx, dxi;
@@ -331,13 +344,13 @@ void ElementType_ShapeFunctionsGlobalDerivs(
 	rows=Mesh_GetDimSize( mesh );
 	cols=self->nodeCount;	
 	
-	GNi = self->GNi;
+	assert( self->nodeCount <= MAX_ELEMENT_NODES );
 
 	nodesPerEl = self->nodeCount;
 
-	Mesh_GetIncidence( mesh, Mesh_GetDimSize( mesh ), elId, MT_VERTEX, self->inc );
-	nInc = IArray_GetSize( self->inc );
-	inc = IArray_GetPtr( self->inc );
+	Mesh_GetIncidence( mesh, Mesh_GetDimSize( mesh ), elId, MT_VERTEX, incArray );
+	nInc = IArray_GetSize( incArray );
+	inc = IArray_GetPtr( incArray );
 	
 	/*
 	If constant shape function gets passed in here, getLocalDeriv will
@@ -466,10 +479,11 @@ void ElementType_Jacobian_AxisIndependent(
 	Node_Index   node_I;
 	unsigned	 nInc;
 	int          *inc;
+	IArray*      incArray    = self->threadInc[Threads_GetIndex()];
 
-	Mesh_GetIncidence( mesh, Mesh_GetDimSize( mesh ), elId, MT_VERTEX, self->inc );
-	nInc = IArray_GetSize( self->inc );
-	inc = IArray_GetPtr( self->inc );
+	Mesh_GetIncidence( mesh, Mesh_GetDimSize( mesh ), elId, MT_VERTEX, incArray );
+	nInc = IArray_GetSize( incArray );
+	inc = IArray_GetPtr( incArray );
 	
 	/* If GNi isn't passed in - then evaluate them for you */
 	if (_GNi == NULL) {
@@ -558,9 +572,12 @@ double ElementType_JacobianDeterminant_AxisIndependent(
 		Coord_Index         B_axis, 
 		Coord_Index         C_axis ) 
 {
-	ElementType*	self = (ElementType*)elementType;
-	ElementType_Jacobian_AxisIndependent( elementType, _mesh, elId, xi, dim, self->_jacobian, NULL, A_axis, B_axis, C_axis );
-	return StGermain_MatrixDeterminant_AxisIndependent( self->_jacobian, dim, A_axis, B_axis, C_axis );
+	/* local jacobian rather than self->_jacobian, as this is called concurrently during threaded assembly */
+	double  jacobianData[3][3];
+	double* jacobian[3] = { jacobianData[0], jacobianData[1], jacobianData[2] };
+
+	ElementType_Jacobian_AxisIndependent( elementType, _mesh, elId, xi, dim, jacobian, NULL, A_axis, B_axis, C_axis );
+	return StGermain_MatrixDeterminant_AxisIndependent( jacobian, dim, A_axis, B_axis, C_axis );
 }
 
 double ElementType_SurfaceJacobianDeterminant_AxisIndependent(
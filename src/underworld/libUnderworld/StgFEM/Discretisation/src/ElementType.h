@@ -13,6 +13,9 @@
 	
 	/** Type of this classes */
 	extern const Type ElementType_Type;
+
+	/** Largest node count of any element type, for sizing stack workspaces */
+	#define MAX_ELEMENT_NODES 27
 	
 	/* Child classes must define these abstract functions */
 	typedef void	(ElementType_EvaluateShapeFunctionsAtFunction)			( void* elementType, const double localCoord[],
@@ -50,6 +53,7 @@
 		Index								dim; \
 		Stream*								debug;	\
 		IArray* 							inc; \
+		IArray**							threadInc; /* per thread incidence, threadInc[0] == inc */ \
 		unsigned**							faceNodes; \
 		/* below are temporary storage data structures */ \
 		double     **GNi; \
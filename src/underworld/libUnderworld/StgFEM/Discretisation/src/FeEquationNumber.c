@@ -38,6 +38,8 @@ int GenerateEquationNumbering(
 		int periodic_x_gnode_id[], int periodic_y_gnode_id[], int periodic_z_gnode_id[],
 		int eqnums[], int *neqnums );
 
+static void _FeEquationNumber_BuildDirectory( FeEquationNumber* self );
+
 
 int stgCmpInt( const void *l, const void *r ) {
    return *(int*)l - *(int*)r;
@@ -153,7 +155,9 @@ void _FeEquationNumber_Init(
    self->isBuilt = False;
    self->locationMatrixBuilt = False;
    self->_lowestLocalEqNum = -1;
-   self->_lowestGlobalEqNums = NULL;
+   self->nDirEntries = 0;
+   self->dirFirsts = NULL;
+   self->dirRanks = NULL;
    self->_highestLocalEqNum = -1;
    self->dofLayout = dofLayout;
    self->bcs = bcs;
@@ -164,6 +168,7 @@ void _FeEquationNumber_Init(
    self->debugLM = Stream_RegisterChild( self->debug, "LM" );
    self->warning = Stream_RegisterChild( StgFEM_Warning, FeEquationNumber_Type );
    self->removeBCs = True;
+   self->version = 0;
    self->bcEqNums = STree_New();
    STree_SetIntCallbacks( self->bcEqNums );
    STree_SetItemSize( self->bcEqNums, sizeof(int) );
@@ -181,13 +186,14 @@ void _FeEquationNumber_Execute( void* feEquationNumber, void *data ){
 
 }
 
-void _FeEquationNumber_Destroy( void* feEquationNumber, void *data ){
-   FeEquationNumber* self = (FeEquationNumber*) feEquationNumber;
+/* Frees the destination array and location matrix. */
+static void _FeEquationNumber_FreeNumbering( FeEquationNumber* self ) {
    Index ii;
 
    /* free destination array memory */
    Journal_DPrintfL( self->debug, 2, "Freeing I.D. Array\n" );
    FreeArray( self->mapNodeDof2Eq );
+   self->mapNodeDof2Eq = NULL;
 
    if (self->locationMatrix) {
       Journal_DPrintfL( self->debug, 2, "Freeing Full L.M. Array\n" );
@@ -195,13 +201,24 @@ void _FeEquationNumber_Destroy( void* feEquationNumber, void *data ){
          FreeArray( self->locationMatrix[ii] );
 
       FreeArray( self->locationMatrix );
+      self->locationMatrix = NULL;
    }
+   self->locationMatrixBuilt = False;
+}
+
+void _FeEquationNumber_Destroy( void* feEquationNumber, void *data ){
+   FeEquationNumber* self = (FeEquationNumber*) feEquationNumber;
+
+   _FeEquationNumber_FreeNumbering( self );
 
    if( self->bcEqNums )
       Stg_Class_Delete( self->bcEqNums );
 
    if( self->ownedMap )
       Stg_Class_Delete( self->ownedMap );
+
+   FreeArray( self->dirFirsts );
+   FreeArray( self->dirRanks );
 }
 
 /* Copy */
@@ -248,21 +265,13 @@ void* _FeEquationNumber_Copy( void* feEquationNumber, void* dest, Bool deep, Nam
    abort();
 }
 
-void _FeEquationNumber_Build( void* feEquationNumber, void* data ) {
-   FeEquationNumber* self = (FeEquationNumber*) feEquationNumber;
-
-   assert(self);
-
-   Journal_DPrintf( self->debug, "In %s:\n",  __func__ );
-   Stream_IndentBranch( StgFEM_Debug );
-
-   Stg_Component_Build( self->feMesh   , data, False );
-   Stg_Component_Build( self->dofLayout, data, False );
-   if ( self->linkedDofInfo ) Stg_Component_Build( self->dofLayout, data, False );
-   if ( self->bcs )           Stg_Component_Build( self->bcs      , data, False );
-	/* If we have new mesh topology information, do this differently. */
-   /* if( self->feMesh->topo->domains && self->feMesh->topo->domains[MT_VERTEX] ) { */
+/* Whether the dof is one of the BCs. */
+static Bool _FeEquationNumber_IsCondition( FeEquationNumber* self, unsigned node, unsigned dof ) {
+   return self->bcs && VariableCondition_IsCondition( self->bcs, node, self->dofLayout->varIndices[node][dof] );
+}
 
+/* Builds the destination array, location matrix, owned mapping and owner directory from scratch. */
+static void _FeEquationNumber_Number( FeEquationNumber* self ) {
    if( Mesh_HasExtension( self->feMesh, "vertexGrid" ) )
       FeEquationNumber_BuildWithDave( self );
    else
@@ -272,15 +281,13 @@ void _FeEquationNumber_Build( void* feEquationNumber, void* data ) {
    if( !self->removeBCs ) {
       FeMesh* mesh = self->feMesh;
       DofLayout* dofLayout = self->dofLayout;
-      VariableCondition* bcs = self->bcs;
-      int nDofs, varInd;
+      int nDofs;
       int ii, jj;
 
       for( ii = 0; ii < FeMesh_GetNodeLocalSize( mesh ); ii++ ) {
          nDofs = dofLayout->dofCounts[ii];
          for( jj = 0; jj < nDofs; jj++ ) {
-            varInd = dofLayout->varIndices[ii][jj];
-            if( bcs && VariableCondition_IsCondition( bcs, ii, varInd ) ) {
+            if( _FeEquationNumber_IsCondition( self, ii, jj ) ) {
                if( !STree_Has( self->bcEqNums, self->mapNodeDof2Eq[ii] + jj ) )
                   STree_Insert( self->bcEqNums, self->mapNodeDof2Eq[ii] + jj );
             }
@@ -288,10 +295,31 @@ void _FeEquationNumber_Build( void* feEquationNumber, void* data ) {
       }
    }
 
+   _FeEquationNumber_BuildDirectory( self );
+}
+
+void _FeEquationNumber_Build( void* feEquationNumber, void* data ) {
+   FeEquationNumber* self = (FeEquationNumber*) feEquationNumber;
+
+   assert(self);
+
+   Journal_DPrintf( self->debug, "In %s:\n",  __func__ );
+   Stream_IndentBranch( StgFEM_Debug );
+
+   Stg_Component_Build( self->feMesh   , data, False );
+   Stg_Component_Build( self->dofLayout, data, False );
+   if ( self->linkedDofInfo ) Stg_Component_Build( self->dofLayout, data, False );
+   if ( self->bcs )           Stg_Component_Build( self->bcs      , data, False );
+	/* If we have new mesh topology information, do this differently. */
+   /* if( self->feMesh->topo->domains && self->feMesh->topo->domains[MT_VERTEX] ) { */
+
+   _FeEquationNumber_Number( self );
+
    if ( Stream_IsPrintableLevel( self->debug, 3 ) ) {
       FeEquationNumber_PrintmapNodeDof2Eq( self, self->debug );
    }
 
+   self->version++;
    Stream_UnIndentBranch( StgFEM_Debug );
 }
 
@@ -552,22 +580,323 @@ void FeEquationNumber_PrintLocationMatrix( void* feFeEquationNumber, Stream* str
    }
 }
 
-Partition_Index FeEquationNumber_CalculateOwningProcessorOfEqNum( void* feEquationNumber, Dof_EquationNumber eqNum ) {
+/* The processor holding the directory entries for eqNum, and the block of equation numbers it holds. The
+   blocks divide the global equation numbers evenly in rank order. A negative eqNum gives this processor's block. */
+static int _FeEquationNumber_DirectoryRank( FeEquationNumber* self, MPI_Comm comm, int eqNum, int* begin, int* end ) {
+   int nGlobals = self->globalSumUnconstrainedDofs;
+   int nRanks, rank;
+   int size, nLarger;
+
+   insist( MPI_Comm_size( comm, &nRanks ), == MPI_SUCCESS );
+   size = nGlobals / nRanks;
+   nLarger = nGlobals % nRanks;
+   if( eqNum < 0 )
+      insist( MPI_Comm_rank( comm, &rank ), == MPI_SUCCESS );
+   else if( eqNum < nLarger * (size + 1) )
+      rank = eqNum / (size + 1);
+   else
+      rank = nLarger + (eqNum - nLarger * (size + 1)) / size;
+
+   *begin = rank * size + (rank < nLarger ? rank : nLarger);
+   *end = *begin + size + (rank < nLarger ? 1 : 0);
+   return rank;
+}
+
+/* Registers this processor's owned range with each processor whose directory block it overlaps. The owned
+   ranges must tile the global equation numbers in rank order. */
+static void _FeEquationNumber_BuildDirectory( FeEquationNumber* self ) {
+   MPI_Comm mpiComm = Comm_GetMPIComm( Mesh_GetCommTopology( self->feMesh, MT_VERTEX ) );
+   int first = self->firstOwnedEqNum;
+   int nDsts, *dsts;
+   unsigned *sizes;
+   int **ptrs;
+   unsigned nSrcs, *srcSizes;
+   int *srcs, **srcFirsts;
+   int eqNum, begin, end;
+   unsigned ii;
+
+   nDsts = 0;
+   dsts = NULL;
+   sizes = NULL;
+   ptrs = NULL;
+   for( eqNum = first; eqNum < first + self->localEqNumsOwnedCount; eqNum = end ) {
+      dsts = ReallocArray( dsts, int, nDsts + 1 );
+      sizes = ReallocArray( sizes, unsigned, nDsts + 1 );
+      ptrs = ReallocArray( ptrs, int*, nDsts + 1 );
+      dsts[nDsts] = _FeEquationNumber_DirectoryRank( self, mpiComm, eqNum, &begin, &end );
+      sizes[nDsts] = 1;
+      ptrs[nDsts++] = &first;
+   }
+
+   MPIArray_SparseExchange( nDsts, dsts, sizes, (void**)ptrs,
+                            &nSrcs, &srcs, &srcSizes, (void***)&srcFirsts,
+                            sizeof(int), mpiComm );
+   FreeArray( dsts );
+   FreeArray( sizes );
+   FreeArray( ptrs );
+
+   /* Entries arrive in rank order, which is also the order of their ranges. */
+   self->nDirEntries = nSrcs;
+   self->dirFirsts = ReallocArray( self->dirFirsts, Dof_EquationNumber, nSrcs );
+   self->dirRanks = ReallocArray( self->dirRanks, int, nSrcs );
+   for( ii = 0; ii < nSrcs; ii++ ) {
+      self->dirFirsts[ii] = srcFirsts[ii][0];
+      self->dirRanks[ii] = srcs[ii];
+      MemFree( srcFirsts[ii] );
+   }
+   MemFree( srcFirsts );
+   MemFree( srcSizes );
+   MemFree( srcs );
+}
+
+/* Looks up the owner of an equation number in this processor's directory block. */
+static int _FeEquationNumber_DirectoryLookup( FeEquationNumber* self, Dof_EquationNumber eqNum ) {
+   int lower = 0, upper = self->nDirEntries - 1, mid;
+
+   Journal_Firewall( self->nDirEntries > 0 && self->dirFirsts[0] <= eqNum, 
+                     Journal_Register( Error_Type, (Name)self->type ),
+                     "Error in '%s': equation number %d is not in the directory block of this processor.\n",
+                     __func__, eqNum );
+   while( lower < upper ) {
+      mid = (lower + upper + 1) / 2;
+      if( self->dirFirsts[mid] <= eqNum )
+         lower = mid;
+      else
+         upper = mid - 1;
+   }
+   return self->dirRanks[lower];
+}
+
+void FeEquationNumber_FindOwners( void* feEquationNumber, int nEqNums, const Dof_EquationNumber* eqNums,
+                                  int* owners )
+{
    FeEquationNumber* self = (FeEquationNumber*)feEquationNumber;
-   /* Partition_Index ownerProc = (unsigned int)-1; */
-   Comm*	comm = Mesh_GetCommTopology( self->feMesh, MT_VERTEX );
-   MPI_Comm	mpiComm = Comm_GetMPIComm( comm );
-   unsigned	nProcs;
-   unsigned	p_i;
-
-   MPI_Comm_size( mpiComm, (int*)&nProcs );
-   for( p_i = 1; p_i < nProcs; p_i++ ) {
-      if( eqNum < self->_lowestGlobalEqNums[p_i] )
-         break;
+   MPI_Comm mpiComm = Comm_GetMPIComm( Mesh_GetCommTopology( self->feMesh, MT_VERTEX ) );
+   int nPairItems, *pairs, *ord;
+   int nDsts, *dsts, **ptrs;
+   unsigned *sizes;
+   unsigned nSrcs, *recvSizes, nReps, *repSizes;
+   int *srcs, **recvArrays, *reps, **repOwners;
+   int pos, len, begin, end;
+   unsigned r_i, i_i;
+   int ii;
+
+   assert( self && (!nEqNums || (eqNums && owners)) );
+
+   /* Sort the queries, keeping their positions, so each directory block is asked once. */
+   nPairItems = 2 * nEqNums;
+   pairs = AllocArray( int, nPairItems );
+   for( ii = 0; ii < nEqNums; ii++ ) {
+      pairs[2 * ii] = eqNums[ii];
+      pairs[2 * ii + 1] = ii;
+   }
+   qsort( pairs, nEqNums, 2 * sizeof(int), stgCmpInt );
+   ord = AllocArray( int, nEqNums );
+   for( ii = 0; ii < nEqNums; ii++ )
+      ord[ii] = pairs[2 * ii];
+
+   dsts = AllocArray( int, nEqNums );
+   ptrs = AllocArray( int*, nEqNums );
+   sizes = AllocArray( unsigned, nEqNums );
+   nDsts = 0;
+   for( pos = 0; pos < nEqNums; pos += len ) {
+      dsts[nDsts] = _FeEquationNumber_DirectoryRank( self, mpiComm, ord[pos], &begin, &end );
+      for( len = 0; pos + len < nEqNums && ord[pos + len] < end; len++ );
+      ptrs[nDsts] = ord + pos;
+      sizes[nDsts++] = len;
+   }
+
+   MPIArray_SparseExchange( nDsts, dsts, sizes, (void**)ptrs,
+                            &nSrcs, &srcs, &recvSizes, (void***)&recvArrays,
+                            sizeof(int), mpiComm );
+   for( r_i = 0; r_i < nSrcs; r_i++ ) {
+      for( i_i = 0; i_i < recvSizes[r_i]; i_i++ )
+         recvArrays[r_i][i_i] = _FeEquationNumber_DirectoryLookup( self, recvArrays[r_i][i_i] );
+   }
+
+   MPIArray_SparseExchange( nSrcs, srcs, recvSizes, (void**)recvArrays,
+                            &nReps, &reps, &repSizes, (void***)&repOwners,
+                            sizeof(int), mpiComm );
+   for( r_i = 0; r_i < nSrcs; r_i++ )
+      MemFree( recvArrays[r_i] );
+   MemFree( recvArrays );
+   MemFree( recvSizes );
+   MemFree( srcs );
+
+   /* Replies arrive in rank order, matching the order the directory blocks were asked in. */
+   assert( nReps == (unsigned)nDsts );
+   for( pos = 0, r_i = 0; r_i < nReps; r_i++ ) {
+      assert( reps[r_i] == dsts[r_i] && repSizes[r_i] == sizes[r_i] );
+      for( i_i = 0; i_i < repSizes[r_i]; i_i++, pos++ )
+         owners[pairs[2 * pos + 1]] = repOwners[r_i][i_i];
+      MemFree( repOwners[r_i] );
+   }
+   MemFree( repOwners );
+   MemFree( repSizes );
+   MemFree( reps );
+
+   FreeArray( dsts );
+   FreeArray( ptrs );
+   FreeArray( sizes );
+   FreeArray( ord );
+   FreeArray( pairs );
+}
+
+/* Whether any direction is periodic, in which case opposing boundary dofs share equation numbers. */
+static Bool _FeEquationNumber_IsPeriodic( FeEquationNumber* self ) {
+   int* periodic = NULL;
+   unsigned ii;
+
+   if( Mesh_HasExtension( self->feMesh, "vertexGrid" ) )
+      periodic = Mesh_GetExtension( self->feMesh, int*, self->feMesh->periodicId );
+   for( ii = 0; ii < Mesh_GetDimSize( self->feMesh ); ii++ ) {
+      if( self->periodic[ii] || (periodic && periodic[ii]) )
+         return True;
+   }
+   return False;
+}
+
+Bool FeEquationNumber_Renumber( void* feEquationNumber ) {
+   FeEquationNumber*	self = (FeEquationNumber*)feEquationNumber;
+   FeMesh*		feMesh = self->feMesh;
+   int**		dstArray = self->mapNodeDof2Eq;
+   MPI_Comm		mpiComm;
+   int			rank;
+   unsigned		nLocalNodes, nDomainNodes;
+   unsigned*		nNodalDofs;
+   unsigned		maxDofs, nTuples;
+   int			nChanged, nGlobalChanged;
+   int			nOwned, nGlobal, base, shift, curEqNum;
+   int*			tuples;
+   Bool			isCond, wasCond;
+   Sync*		sync;
+   IArray*		inc;
+   unsigned		nElNodes;
+   int*			elNodes;
+   unsigned		e_i, n_i, dof_i;
+   int			ii;
+
+   assert( self && self->mapNodeDof2Eq );
+
+   mpiComm = Comm_GetMPIComm( Mesh_GetCommTopology( feMesh, MT_VERTEX ) );
+   MPI_Comm_rank( mpiComm, &rank );
+   nLocalNodes = FeMesh_GetNodeLocalSize( feMesh );
+   nDomainNodes = FeMesh_GetNodeDomainSize( feMesh );
+   nNodalDofs = self->dofLayout->dofCounts;
+
+   /* Linked and periodic dofs share numbers across processors, so they are renumbered in full. */
+   if( self->linkedDofInfo || _FeEquationNumber_IsPeriodic( self ) ) {
+      _FeEquationNumber_FreeNumbering( self );
+      STree_Clear( self->bcEqNums );
+      _FeEquationNumber_Number( self );
+      self->version++;
+      return True;
    }
 
-   return p_i - 1;
+   /* Find the local dofs whose BC status no longer matches the numbering. */
+   nChanged = 0;
+   nOwned = self->localEqNumsOwnedCount;
+   for( n_i = 0; n_i < nLocalNodes; n_i++ ) {
+      for( dof_i = 0; dof_i < nNodalDofs[n_i]; dof_i++ ) {
+         isCond = _FeEquationNumber_IsCondition( self, n_i, dof_i );
+         if( self->removeBCs )
+            wasCond = (dstArray[n_i][dof_i] == -1);
+         else
+            wasCond = STree_Has( self->bcEqNums, dstArray[n_i] + dof_i );
+         if( isCond == wasCond )
+            continue;
+
+         nChanged++;
+         if( !self->removeBCs ) {
+            if( isCond )
+               STree_Insert( self->bcEqNums, dstArray[n_i] + dof_i );
+            else
+               STree_Remove( self->bcEqNums, dstArray[n_i] + dof_i );
+         }
+         else
+            nOwned += isCond ? -1 : 1;
+      }
+   }
+   (void)MPI_Allreduce( &nChanged, &nGlobalChanged, 1, MPI_INT, MPI_SUM, mpiComm );
+   if( !nGlobalChanged )
+      return False;
 
+   /* When BCs are retained the numbers themselves are unaffected. */
+   if( !self->removeBCs ) {
+      self->version++;
+      return True;
+   }
+
+   /* Order the new ranges by processor rank. */
+   base = 0;
+   (void)MPI_Exscan( &nOwned, &base, 1, MPI_INT, MPI_SUM, mpiComm );
+   if( rank == 0 )
+      base = 0;
+   (void)MPI_Allreduce( &nOwned, &nGlobal, 1, MPI_INT, MPI_SUM, mpiComm );
+   shift = base - self->firstOwnedEqNum;
+
+   /* Recount the local dofs only if their BCs changed, otherwise shift them to the new base. */
+   maxDofs = 1;
+   for( n_i = 0; n_i < nDomainNodes; n_i++ ) {
+      if( nNodalDofs[n_i] > maxDofs )
+         maxDofs = nNodalDofs[n_i];
+   }
+   nTuples = nDomainNodes * maxDofs;
+   tuples = AllocArray( int, nTuples );
+   curEqNum = base;
+   for( n_i = 0; n_i < nLocalNodes; n_i++ ) {
+      for( dof_i = 0; dof_i < nNodalDofs[n_i]; dof_i++ ) {
+         if( nChanged )
+            dstArray[n_i][dof_i] = _FeEquationNumber_IsCondition( self, n_i, dof_i ) ? -1 : curEqNum++;
+         else if( dstArray[n_i][dof_i] != -1 )
+            dstArray[n_i][dof_i] += shift;
+         tuples[n_i * maxDofs + dof_i] = dstArray[n_i][dof_i];
+      }
+   }
+
+   /* Update shadow nodes from their owners. */
+   sync = Mesh_GetSync( feMesh, MT_VERTEX );
+   Sync_SyncArray( sync, tuples, maxDofs * sizeof(int),
+                   tuples + nLocalNodes * maxDofs, maxDofs * sizeof(int),
+                   maxDofs * sizeof(int) );
+   for( n_i = nLocalNodes; n_i < nDomainNodes; n_i++ ) {
+      for( dof_i = 0; dof_i < nNodalDofs[n_i]; dof_i++ ) {
+         if( _FeEquationNumber_IsCondition( self, n_i, dof_i ) )
+            dstArray[n_i][dof_i] = -1;
+         else
+            dstArray[n_i][dof_i] = tuples[n_i * maxDofs + dof_i];
+      }
+   }
+   FreeArray( tuples );
+
+   if( self->locationMatrixBuilt ) {
+      inc = IArray_New();
+      for( e_i = 0; e_i < self->nDomainEls; e_i++ ) {
+         FeMesh_GetElementNodes( feMesh, e_i, inc );
+         nElNodes = IArray_GetSize( inc );
+         elNodes = IArray_GetPtr( inc );
+         for( n_i = 0; n_i < nElNodes; n_i++ ) {
+            for( dof_i = 0; dof_i < nNodalDofs[elNodes[n_i]]; dof_i++ )
+               self->locationMatrix[e_i][n_i][dof_i] = dstArray[elNodes[n_i]][dof_i];
+         }
+      }
+      Stg_Class_Delete( inc );
+   }
+
+   self->localEqNumsOwnedCount = nOwned;
+   self->firstOwnedEqNum = base;
+   self->lastOwnedEqNum = base + nOwned - 1;
+   self->_lowestLocalEqNum = base;
+   self->globalSumUnconstrainedDofs = nGlobal;
+   STree_Clear( self->ownedMap );
+   for( ii = self->firstOwnedEqNum; ii <= self->lastOwnedEqNum; ii++ ) {
+      int val = ii - self->firstOwnedEqNum;
+      STreeMap_Insert( self->ownedMap, &ii, &val );
+   }
+   _FeEquationNumber_BuildDirectory( self );
+
+   self->version++;
+   return True;
 }
 
 void FeEquationNumber_BuildWithTopology( FeEquationNumber* self ) {
@@ -577,7 +906,7 @@ void FeEquationNumber_BuildWithTopology( FeEquationNumber* self ) {
    Sync*		sync;
    Comm*		comm;
    MPI_Comm		mpiComm;
-   unsigned		rank, nProcs;
+   unsigned		rank;
    unsigned		nDims;
    unsigned		nDomainNodes;
    unsigned		nLocalNodes;
@@ -589,7 +918,6 @@ void FeEquationNumber_BuildWithTopology( FeEquationNumber* self ) {
    unsigned		curEqNum;
    unsigned		base;
    unsigned		subTotal;
-   MPI_Status		status;
    unsigned		maxDofs;
    unsigned*		tuples;
    LinkedDofInfo*	links;
@@ -620,7 +948,6 @@ void FeEquationNumber_BuildWithTopology( FeEquationNumber* self ) {
    feMesh = self->feMesh;
    comm = Mesh_GetCommTopology( feMesh, MT_VERTEX );
    mpiComm = Comm_GetMPIComm( comm );
-   MPI_Comm_size( mpiComm, (int*)&nProcs );
    MPI_Comm_rank( mpiComm, (int*)&rank );
    nDims = Mesh_GetDimSize( feMesh );
    nDomainNodes = FeMesh_GetNodeDomainSize( feMesh );
@@ -685,13 +1012,12 @@ void FeEquationNumber_BuildWithTopology( FeEquationNumber* self ) {
       }
    }
 
-   /* Order the equation numbers based on processor rank; cascade counts forward. */
+   /* Order the equation numbers based on processor rank, with a prefix sum of the counts. */
    base = 0;
-   if( rank > 0 )
-      (void)MPI_Recv( &base, 1, MPI_UNSIGNED, rank - 1, 6669, mpiComm, &status );
+   (void)MPI_Exscan( &curEqNum, &base, 1, MPI_UNSIGNED, MPI_SUM, mpiComm );
+   if( rank == 0 )
+      base = 0;
    subTotal = base + curEqNum;
-   if( rank < nProcs - 1 )
-      (void)MPI_Send( &subTotal, 1, MPI_UNSIGNED, rank + 1, 6669, mpiComm );
 
    if( links ) {
       /* Reduce to find lowest linked DOFs. */
@@ -779,14 +1105,8 @@ void FeEquationNumber_BuildWithTopology( FeEquationNumber* self ) {
       STreeMap_Insert( self->ownedMap, &ii, &val );
    }
 
-   /* Bcast global sum from highest rank. */
-   if( rank == nProcs - 1 )
-      self->globalSumUnconstrainedDofs = self->lastOwnedEqNum + 1;
-   (void)MPI_Bcast( &self->globalSumUnconstrainedDofs, 1, MPI_UNSIGNED, nProcs - 1, mpiComm );
-
-   /* Construct lowest global equation number list. */
-   self->_lowestGlobalEqNums = AllocArray( int, nProcs );
-   (void)MPI_Allgather( &self->firstOwnedEqNum, 1, MPI_UNSIGNED, self->_lowestGlobalEqNums, 1, MPI_UNSIGNED, mpiComm );
+   /* Sum the counts for the global total. */
+   (void)MPI_Allreduce( &curEqNum, &self->globalSumUnconstrainedDofs, 1, MPI_UNSIGNED, MPI_SUM, mpiComm );
 
 //   endTime = MPI_Wtime();
 
@@ -817,7 +1137,7 @@ void FeEquationNumber_BuildWithDave( FeEquationNumber* self ) {
    int *elNodes;
    Comm *comm;
    MPI_Comm mpiComm;
-   int nRanks, rank;
+   int rank;
    Sync *sync;
    Bool isCond;
    int nPeriodicInds[3];
@@ -831,7 +1151,6 @@ void FeEquationNumber_BuildWithDave( FeEquationNumber* self ) {
 
    comm = Mesh_GetCommTopology( self->feMesh, 0 );
    mpiComm = Comm_GetMPIComm( comm );
-   MPI_Comm_size( mpiComm, &nRanks );
    MPI_Comm_rank( mpiComm, &rank );
 
    /* Setup an array containing global indices of all locally owned nodes. */
@@ -1026,11 +1345,13 @@ void FeEquationNumber_BuildWithDave( FeEquationNumber* self ) {
    /* Bcast global sum from highest rank. */
    self->globalSumUnconstrainedDofs = nEqNums;
 
-   /* Construct lowest global equation number list. */
-   self->_lowestGlobalEqNums = AllocArray( int, nRanks );
-   (void)MPI_Allgather( &self->_lowestLocalEqNum, 1, MPI_UNSIGNED,
-                        self->_lowestGlobalEqNums, 1, MPI_UNSIGNED,
-                        mpiComm );
+   /* Owned numbers are assigned in rank order, so a prefix sum of the counts gives the range. */
+   self->firstOwnedEqNum = 0;
+   (void)MPI_Exscan( &nLocalEqNums, &self->firstOwnedEqNum, 1, MPI_INT, MPI_SUM, mpiComm );
+   if( rank == 0 )
+      self->firstOwnedEqNum = 0;
+   self->lastOwnedEqNum = self->firstOwnedEqNum + nLocalEqNums - 1;
+   self->_lowestLocalEqNum = self->firstOwnedEqNum;
 
    FreeArray( locals );
 
@@ -1113,9 +1434,6 @@ int GenerateEquationNumbering(
 	PetscInt d,idx[10];
 	PetscInt *to_fetch,cnt,number_to_fetch;
 	PetscInt eq_cnt;
-	Vec offset_list;
-	VecScatter vscat_offset;
-	Vec seq_offset_list;
 	PetscInt offset, inc;
 
 	PetscInt spanx,spany,spanz,total;
@@ -1287,33 +1605,12 @@ int GenerateEquationNumbering(
 	}
 	VecRestoreArray( local_eqnum, &_local_eqnum );
 
-    VecCreate( PETSC_COMM_WORLD, &offset_list );
-    VecSetSizes( offset_list, PETSC_DECIDE, size );
-    VecSetFromOptions( offset_list );
-    VecSetValue( offset_list, rank, eq_cnt, INSERT_VALUES );
-    VecAssemblyBegin(offset_list);
-    VecAssemblyEnd(offset_list);
-    /*
-    PetscPrintf(PETSC_COMM_WORLD, "offset_list \n");
-    VecView( offset_list, PETSC_VIEWER_STDOUT_WORLD );
-    */
-
-    VecScatterCreateToAll(offset_list,&vscat_offset,&seq_offset_list);
-    _VecScatterBeginEnd( vscat_offset, offset_list, seq_offset_list, INSERT_VALUES, SCATTER_FORWARD );
-
-    {
-        PetscScalar *_seq_offset_list;
-
-        VecGetArray( seq_offset_list, &_seq_offset_list );
+    /* offset is the sum of the counts on lower ranks */
+    offset = 0;
+    (void)MPI_Exscan( &eq_cnt, &offset, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD );
+    if( rank == 0 ) {
         offset = 0;
-        for (i=0; i<rank; i++) {
-            offset+=_seq_offset_list[ i ];
-        }
-        VecRestoreArray( seq_offset_list, &_seq_offset_list );
     }
-    Stg_VecScatterDestroy(&vscat_offset);
-    Stg_VecDestroy(&offset_list);
-    Stg_VecDestroy(&seq_offset_list);
 
 //    PetscPrintf( PETSC_COMM_SELF, "[%d]: offset = %d \n", rank, offset ); 
 
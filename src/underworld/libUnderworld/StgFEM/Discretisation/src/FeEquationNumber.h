@@ -20,11 +20,16 @@
 **	the eqNums should be decomposed between processors in the matrices and
 **	vectors.
 **
-**	If Mesh connectivity or which nodes BCs are applied to changes,
-**	this component needs to be rebuilt. TODO: provide an interface
-**	for this:- maybe using the loop we are up to to make sure it doesn't
-**	happen multiple times? A variable on the mesh and bcs could be
-**	set when they change connectivity/BC dofs.
+**	If Mesh connectivity changes, this component needs to be rebuilt.
+**	If only which nodes BCs are applied to changes, call
+**	FeEquationNumber_Renumber(), which renumbers just the processors
+**	whose BCs changed and shifts the ranges of the others.
+**
+**	Each processor owns a contiguous range of equation numbers, in
+**	rank order. The range bases come from a prefix sum, and the owner
+**	of an arbitrary equation number is found through a directory
+**	distributed over the processors (see FeEquationNumber_FindOwners()),
+**	so no per-processor arrays are replicated.
 **
 **	Qtn to verify- maybe the exchange of locally known set end
 **	CPs is pointless? they only turn out to be the interfaces in
@@ -82,7 +87,11 @@
 		Dof_EquationNumber		_highestLocalEqNum;\
 		/** Used to determine which procs hold which numbers */ \
 		Dof_EquationNumber		_lowestLocalEqNum;\
-		Dof_EquationNumber*		_lowestGlobalEqNums;\
+		/** Directory entries for this proc's block of the global eq nums: the first eq num */ \
+		/** owned by each proc whose range overlaps the block, in rank order */ \
+		int						nDirEntries; \
+		Dof_EquationNumber*		dirFirsts; \
+		int*						dirRanks; \
 		unsigned int				_eqNumsPerProcDivisor; \
 		unsigned int				_eqNumsRemainder; \
 		Dof_EquationNumber		_remNotAddedChangeover; \
@@ -105,7 +114,9 @@
                 Bool    periodic[3];                                                    \
 		STree*						bcEqNums;  \
 		/** nDomainEls is required during the destroy phase */ \
-		Index                   nDomainEls;
+		Index                   nDomainEls; \
+		/** Incremented each time the numbering is built, so users can tell when it has changed. */ \
+		unsigned                version;
 
 	struct FeEquationNumber { __FeEquationNumber };
 
@@ -191,9 +202,16 @@
 	(\see FiniteElement_Init() ).
 	void FeEquationNumber_Create_CritPointInfo_MPI_Datatype( void ); */
 
-	/* Next few lines are a function, in case the alg. for calculating boundaries changes once we start
-	trying ghosting again */
-	Partition_Index FeEquationNumber_CalculateOwningProcessorOfEqNum( void* self, Dof_EquationNumber eqNum );
+	/** Finds the processor owning each of the given equation numbers, by querying the processors
+	holding the directory entries for them. Must be called collectively. */
+	void FeEquationNumber_FindOwners( void* feEquationNumber, int nEqNums, const Dof_EquationNumber* eqNums,
+					  int* owners );
+
+	/** Brings the numbering up to date with the BCs, after the set of constrained dofs has changed.
+	Only processors whose BCs changed recount their equations; the others shift their range to the new
+	base. Returns whether the numbering changed on any processor, in which case the version is
+	incremented. Must be called collectively. */
+	Bool FeEquationNumber_Renumber( void* feEquationNumber );
 
 	/** build the processor's location matrix mapping elements, element node, dof -> eq num */
 	void FeEquationNumber_BuildLocationMatrix( void* feEquationNumber );
@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <math.h>
 #include <mpi.h>
 
 #include <StGermain/libStGermain/src/StGermain.h>
@@ -20,6 +21,25 @@
 /* Textual name of this class */
 const Type FeMesh_Type = "FeMesh";
 
+/* Integration point cache. Each element's entries are only touched by the thread assembling
+   that element, so only the memory total (and the per thread statistics) are shared. Entries
+   are allocated with malloc as they may be created within threaded assembly. */
+struct FeMesh_ShapeFuncCache {
+	ElementType*	elementType;	/* element type the entries were evaluated for */
+	unsigned	nEls;
+	unsigned*	versions;	/* Mesh::deformVersion each element's entries were evaluated at */
+	unsigned*	nPoints;
+	double**	entries;	/* per element, nPoints records of [ xi | detJac | Ni | GNx ] */
+	size_t		bytes;
+	size_t		budget;
+	unsigned long*	hits;		/* per thread */
+	unsigned long*	misses;		/* per thread */
+};
+
+#define FEMESH_DEFAULT_SHAPEFUNC_CACHE_SIZE 256.0 /* megabytes */
+
+static void _FeMesh_FreeShapeFuncCacheEntries( FeMesh* self );
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ** Constructors
 */
@@ -65,6 +85,7 @@ FeMesh* _FeMesh_New(  FEMESH_DEFARGS  ) {
 
 void _FeMesh_Init( FeMesh* self, ElementType* elType, const char* family, Bool elementMesh ) {
 	Stream*	stream;
+	unsigned	thread_i;
 
 	assert( self && Stg_CheckType( self, FeMesh ) );
 
@@ -75,6 +96,17 @@ void _FeMesh_Init( FeMesh* self, ElementType* elType, const char* family, Bool e
 	self->feElFamily = family;
 	self->elementMesh = elementMesh;	
 	self->inc = IArray_New();
+	self->threadInc = Memory_Alloc_Array( IArray*, Threads_GetMaxCount(), "FeMesh_threadInc" );
+	self->threadInc[0] = self->inc;
+	for( thread_i = 1; thread_i < Threads_GetMaxCount(); thread_i++ )
+		self->threadInc[thread_i] = IArray_New();
+
+	self->shapeFuncCache = Memory_Alloc( FeMesh_ShapeFuncCache, "FeMesh_ShapeFuncCache" );
+	memset( self->shapeFuncCache, 0, sizeof(FeMesh_ShapeFuncCache) );
+	self->shapeFuncCache->hits = Memory_Alloc_Array( unsigned long, Threads_GetMaxCount(), "FeMesh_ShapeFuncCache_hits" );
+	self->shapeFuncCache->misses = Memory_Alloc_Array( unsigned long, Threads_GetMaxCount(), "FeMesh_ShapeFuncCache_misses" );
+	FeMesh_SetShapeFuncCacheSize( self, FEMESH_DEFAULT_SHAPEFUNC_CACHE_SIZE );
+	FeMesh_ResetShapeFuncCacheStats( self );
 }
 
 
@@ -107,6 +139,9 @@ void _FeMesh_AssignFromXML( void* feMesh, Stg_ComponentFactory* cf, void* data )
 
 	_FeMesh_Init( self, NULL, Stg_ComponentFactory_GetString( cf, self->name, (Dictionary_Entry_Key)"elementType", "linear"  ), 
 		Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"isElementMesh", False )  );
+
+	FeMesh_SetShapeFuncCacheSize( self, Stg_ComponentFactory_GetDouble( cf, self->name, (Dictionary_Entry_Key)"shapeFunctionCacheSize",
+		FEMESH_DEFAULT_SHAPEFUNC_CACHE_SIZE ) );
 }
 
 void _FeMesh_Build( void* feMesh, void* data ) {
@@ -195,6 +230,19 @@ void _FeMesh_Build( void* feMesh, void* data ) {
         Mesh_ElementType_Update( self->elTypes[0] );
     }
 
+	/* Allocate the per element cache tables here, as entries may be added within threaded assembly */
+	_FeMesh_FreeShapeFuncCacheEntries( self );
+	self->shapeFuncCache->elementType = self->feElType;
+	self->shapeFuncCache->nEls = FeMesh_GetElementDomainSize( self );
+	if( self->shapeFuncCache->nEls ) {
+		self->shapeFuncCache->versions = Memory_Alloc_Array( unsigned, self->shapeFuncCache->nEls, "FeMesh_ShapeFuncCache_versions" );
+		self->shapeFuncCache->nPoints = Memory_Alloc_Array( unsigned, self->shapeFuncCache->nEls, "FeMesh_ShapeFuncCache_nPoints" );
+		self->shapeFuncCache->entries = Memory_Alloc_Array( double*, self->shapeFuncCache->nEls, "FeMesh_ShapeFuncCache_entries" );
+		memset( self->shapeFuncCache->versions, 0, self->shapeFuncCache->nEls * sizeof(unsigned) );
+		memset( self->shapeFuncCache->nPoints, 0, self->shapeFuncCache->nEls * sizeof(unsigned) );
+		memset( self->shapeFuncCache->entries, 0, self->shapeFuncCache->nEls * sizeof(double*) );
+	}
+
 //	Journal_Printf( stream, "... FE element types are '%s',\n", elType->type );
 //	Journal_Printf( stream, "... done.\n" );
 	Stream_UnIndent( stream );
@@ -217,8 +265,16 @@ void _FeMesh_Execute( void* feMesh, void* data ) {
 
 void _FeMesh_Destroy( void* feMesh, void* data ) {
 	FeMesh*	self = (FeMesh*)feMesh;
+	unsigned	thread_i;
    
 	FeMesh_Destruct( self );
+	_FeMesh_FreeShapeFuncCacheEntries( self );
+	Memory_Free( self->shapeFuncCache->hits );
+	Memory_Free( self->shapeFuncCache->misses );
+	Memory_Free( self->shapeFuncCache );
+	for( thread_i = 1; thread_i < Threads_GetMaxCount(); thread_i++ )
+		Stg_Class_Delete( self->threadInc[thread_i] );
+	Memory_Free( self->threadInc );
 	Stg_Class_Delete( self->inc );
    _Mesh_Destroy( self, data );
 }
@@ -334,7 +390,8 @@ void FeMesh_CoordLocalToGlobal( void* feMesh, unsigned element, const double* lo
 	FeMesh*		self = (FeMesh*)feMesh;
 	unsigned	nDims;
 	ElementType*	elType;
-	double*		basis;
+	double		basis[MAX_ELEMENT_NODES];
+	IArray*		incArray = self->threadInc[Threads_GetIndex()];
 	unsigned	nElNodes, *elNodes;
 	double		dimBasis;
 	double*		vert;
@@ -347,10 +404,10 @@ void FeMesh_CoordLocalToGlobal( void* feMesh, unsigned element, const double* lo
 
 	nDims = Mesh_GetDimSize( self );
 	elType = FeMesh_GetElementType( self, element );
-	FeMesh_GetElementNodes( self, element, self->inc );
-	nElNodes = IArray_GetSize( self->inc );
-	elNodes = IArray_GetPtr( self->inc );
-	basis = AllocArray( double, nElNodes );
+	FeMesh_GetElementNodes( self, element, incArray );
+	nElNodes = IArray_GetSize( incArray );
+	elNodes = IArray_GetPtr( incArray );
+	assert( nElNodes <= MAX_ELEMENT_NODES );
 	ElementType_EvaluateShapeFunctionsAt( elType, local, basis );
 
 	memset( global, 0, nDims * sizeof(double) );
@@ -360,8 +417,6 @@ void FeMesh_CoordLocalToGlobal( void* feMesh, unsigned element, const double* lo
 		for( d_i = 0; d_i < nDims; d_i++ )
 			global[d_i] += dimBasis * vert[d_i];
 	}
-
-	FreeArray( basis );
 }
 
 void FeMesh_EvalBasis( void* feMesh, unsigned element, double* localCoord, double* basis ) {
@@ -405,11 +460,174 @@ void FeMesh_EvalGlobalDerivs( void* feMesh, unsigned element, double* localCoord
 		*jacDet = jd;
 }
 
+void FeMesh_GetIntegrationPointShapeFuncs( void* feMesh, ElementType* elementType, unsigned element, unsigned point,
+					   double* xi, double* Ni, double** GNx, double* detJac )
+{
+	FeMesh*			self = (FeMesh*)feMesh;
+	FeMesh_ShapeFuncCache*	cache = self->shapeFuncCache;
+	unsigned		nDims = Mesh_GetDimSize( self );
+	unsigned		nNodes = elementType->nodeCount;
+	unsigned		recSize = nDims + 1 + nNodes * ( nDims + 1 );
+	unsigned		thread = Threads_GetIndex();
+	double			GNxData[3][MAX_ELEMENT_NODES];
+	double*			GNxEval[3] = { GNxData[0], GNxData[1], GNxData[2] };
+	double			NiEval[MAX_ELEMENT_NODES];
+	double*			rec = NULL;
+	unsigned		d_i, p_i;
+
+	assert( self && cache );
+	assert( xi && detJac );
+
+	if( elementType == cache->elementType && element < cache->nEls ) {
+		/* Discard the element's entries if the geometry has changed since they were evaluated */
+		if( cache->versions[element] != self->deformVersion ) {
+			for( p_i = 0; p_i < cache->nPoints[element]; p_i++ )
+				cache->entries[element][p_i * recSize] = HUGE_VAL;
+			cache->versions[element] = self->deformVersion;
+		}
+
+		if( point >= cache->nPoints[element] ) {
+			unsigned	nPoints = ( point / 8 + 1 ) * 8;
+			size_t		extra = (size_t)( nPoints - cache->nPoints[element] ) * recSize * sizeof(double);
+			size_t		total;
+
+#ifdef HAVE_OPENMP
+			#pragma omp atomic capture
+#endif
+			total = cache->bytes += extra;
+
+			if( total <= cache->budget ) {
+				cache->entries[element] = (double*)realloc( cache->entries[element], nPoints * recSize * sizeof(double) );
+				for( p_i = cache->nPoints[element]; p_i < nPoints; p_i++ )
+					cache->entries[element][p_i * recSize] = HUGE_VAL;
+				cache->nPoints[element] = nPoints;
+			}
+			else {
+#ifdef HAVE_OPENMP
+				#pragma omp atomic
+#endif
+				cache->bytes -= extra;
+			}
+		}
+
+		if( point < cache->nPoints[element] )
+			rec = cache->entries[element] + point * recSize;
+	}
+
+	if( rec ) {
+		for( d_i = 0; d_i < nDims; d_i++ ) {
+			if( rec[d_i] != xi[d_i] )
+				break;
+		}
+		if( d_i == nDims ) {
+			cache->hits[thread]++;
+			*detJac = rec[nDims];
+			if( Ni )
+				memcpy( Ni, rec + nDims + 1, nNodes * sizeof(double) );
+			if( GNx ) {
+				for( d_i = 0; d_i < nDims; d_i++ )
+					memcpy( GNx[d_i], rec + nDims + 1 + nNodes * ( d_i + 1 ), nNodes * sizeof(double) );
+			}
+			return;
+		}
+	}
+	cache->misses[thread]++;
+
+	ElementType_ShapeFunctionsGlobalDerivs( elementType, self, element, xi, nDims, detJac, GNxEval );
+	ElementType_EvaluateShapeFunctionsAt( elementType, xi, NiEval );
+
+	if( rec ) {
+		memcpy( rec, xi, nDims * sizeof(double) );
+		rec[nDims] = *detJac;
+		memcpy( rec + nDims + 1, NiEval, nNodes * sizeof(double) );
+		for( d_i = 0; d_i < nDims; d_i++ )
+			memcpy( rec + nDims + 1 + nNodes * ( d_i + 1 ), GNxEval[d_i], nNodes * sizeof(double) );
+	}
+	if( Ni )
+		memcpy( Ni, NiEval, nNodes * sizeof(double) );
+	if( GNx ) {
+		for( d_i = 0; d_i < nDims; d_i++ )
+			memcpy( GNx[d_i], GNxEval[d_i], nNodes * sizeof(double) );
+	}
+}
+
+void FeMesh_SetShapeFuncCacheSize( void* feMesh, double megabytes ) {
+	FeMesh*	self = (FeMesh*)feMesh;
+
+	assert( self && self->shapeFuncCache );
+
+	self->shapeFuncCache->budget = ( megabytes > 0.0 ) ? (size_t)( megabytes * 1024.0 * 1024.0 ) : 0;
+}
+
+double FeMesh_GetShapeFuncCacheSize( void* feMesh ) {
+	FeMesh*	self = (FeMesh*)feMesh;
+
+	assert( self && self->shapeFuncCache );
+
+	return (double)self->shapeFuncCache->budget / ( 1024.0 * 1024.0 );
+}
+
+double FeMesh_GetShapeFuncCacheUsage( void* feMesh ) {
+	FeMesh*	self = (FeMesh*)feMesh;
+
+	assert( self && self->shapeFuncCache );
+
+	return (double)self->shapeFuncCache->bytes / ( 1024.0 * 1024.0 );
+}
+
+unsigned long FeMesh_GetShapeFuncCacheHits( void* feMesh ) {
+	FeMesh*		self = (FeMesh*)feMesh;
+	unsigned long	hits = 0;
+	unsigned	thread_i;
+
+	assert( self && self->shapeFuncCache );
+
+	for( thread_i = 0; thread_i < Threads_GetMaxCount(); thread_i++ )
+		hits += self->shapeFuncCache->hits[thread_i];
+	return hits;
+}
+
+unsigned long FeMesh_GetShapeFuncCacheMisses( void* feMesh ) {
+	FeMesh*		self = (FeMesh*)feMesh;
+	unsigned long	misses = 0;
+	unsigned	thread_i;
+
+	assert( self && self->shapeFuncCache );
+
+	for( thread_i = 0; thread_i < Threads_GetMaxCount(); thread_i++ )
+		misses += self->shapeFuncCache->misses[thread_i];
+	return misses;
+}
+
+void FeMesh_ResetShapeFuncCacheStats( void* feMesh ) {
+	FeMesh*	self = (FeMesh*)feMesh;
+
+	assert( self && self->shapeFuncCache );
+
+	memset( self->shapeFuncCache->hits, 0, Threads_GetMaxCount() * sizeof(unsigned long) );
+	memset( self->shapeFuncCache->misses, 0, Threads_GetMaxCount() * sizeof(unsigned long) );
+}
+
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ** Private Functions
 */
 
+static void _FeMesh_FreeShapeFuncCacheEntries( FeMesh* self ) {
+	FeMesh_ShapeFuncCache*	cache = self->shapeFuncCache;
+	unsigned		e_i;
+
+	for( e_i = 0; e_i < cache->nEls; e_i++ )
+		free( cache->entries[e_i] );
+	if( cache->nEls ) {
+		Memory_Free( cache->versions );
+		Memory_Free( cache->nPoints );
+		Memory_Free( cache->entries );
+	}
+	cache->nEls = 0;
+	cache->bytes = 0;
+}
+
 void FeMesh_Destruct( FeMesh* self ) {
    Stg_Class_Delete( self->feElType );
 	self->feElFamily = NULL;
@@ -29,8 +29,10 @@
 		Bool		elementMesh;		\
                 Bool useFeAlgorithms; \
 		IArray*	inc; \
+		IArray**	threadInc; /* per thread incidence, threadInc[0] == inc */ \
 		IndexSet*           bndNodeSet;   	  /* IndexSet for mesh boundary nodes */ \
 		IndexSet*           bndElementSet;	  /* IndexSet for mesh boundary elements */ \
+		FeMesh_ShapeFuncCache*	shapeFuncCache;	  /* integration point values, see FeMesh_GetIntegrationPointShapeFuncs() */ \
 		
 
 	struct FeMesh { __FeMesh };
@@ -103,6 +105,22 @@
 	void FeMesh_EvalLocalDerivs( void* feMesh, unsigned element, double* localCoord, double** derivs );
 	void FeMesh_EvalGlobalDerivs( void* feMesh, unsigned element, double* localCoord, double** derivs, double* jacDet );
 
+	/** Evaluates the shape functions (Ni), their global derivatives (GNx) and the jacobian determinant at
+	 *  local coordinate xi, the point'th integration point of the element. Results are cached per
+	 *  (element, point), and reused while xi and the mesh geometry (Mesh::deformVersion) are unchanged.
+	 *  Ni and GNx may be NULL where they are not required. */
+	void FeMesh_GetIntegrationPointShapeFuncs( void* feMesh, ElementType* elementType, unsigned element, unsigned point,
+						   double* xi, double* Ni, double** GNx, double* detJac );
+	/** Memory budget of the integration point cache, in megabytes. Zero disables caching. */
+	void FeMesh_SetShapeFuncCacheSize( void* feMesh, double megabytes );
+	double FeMesh_GetShapeFuncCacheSize( void* feMesh );
+	/** Memory currently used by the integration point cache, in megabytes. */
+	double FeMesh_GetShapeFuncCacheUsage( void* feMesh );
+	/** Cache lookups which found / did not find valid values since the last reset. */
+	unsigned long FeMesh_GetShapeFuncCacheHits( void* feMesh );
+	unsigned long FeMesh_GetShapeFuncCacheMisses( void* feMesh );
+	void FeMesh_ResetShapeFuncCacheStats( void* feMesh );
+
 	/*--------------------------------------------------------------------------------------------------------------------------
 	** Private Member functions
 	*/
@@ -182,6 +182,8 @@ void _FeVariable_Init(
    Bool        isReferenceSolution,
    Bool        loadReferenceEachTimestep )
 {
+   unsigned thread_i;
+
    /* General and Virtual info should already be set */
 
    /* FeVariable info */
@@ -201,6 +203,10 @@ void _FeVariable_Init(
       self->templateFeVariable = Stg_CheckType( templateFeVariable, FeVariable );
 
    self->inc = IArray_New();
+   self->threadInc = Memory_Alloc_Array( IArray*, Threads_GetMaxCount(), "FeVariable_threadInc" );
+   self->threadInc[0] = self->inc;
+   for( thread_i = 1; thread_i < Threads_GetMaxCount(); thread_i++ )
+      self->threadInc[thread_i] = IArray_New();
 
    self->tempData = malloc(self->fieldComponentCount*sizeof(double));
 }
@@ -363,11 +369,16 @@ void _FeVariable_Execute( void* variable, void* data ) {
 
 void _FeVariable_Destroy( void* variable, void* data ) {
    FeVariable* self = (FeVariable*)variable;
+   unsigned    thread_i;
 
    Memory_Free( self->GNx );
 
    /* FeMesh bc and doflayout are purposely not deleted */
    if( self->inc != NULL ) {
+      for( thread_i = 1; thread_i < Threads_GetMaxCount(); thread_i++ )
+         Stg_Class_Delete( self->threadInc[thread_i] );
+      Memory_Free( self->threadInc );
+      self->threadInc = NULL;
       Stg_Class_Delete( self->inc );
       self->inc = NULL;
    }
@@ -599,6 +610,146 @@ InterpolationResult FeVariable_GetElementLocalCoordAtGlobalCoord(
    return retValue;
 }
 
+typedef struct {
+   unsigned element;
+   unsigned point;
+} FeVariable_PointInElement;
+
+static int _FeVariable_CmpPointInElement( const void* _a, const void* _b ) {
+   const FeVariable_PointInElement* a = (const FeVariable_PointInElement*)_a;
+   const FeVariable_PointInElement* b = (const FeVariable_PointInElement*)_b;
+
+   if( a->element != b->element )
+      return ( a->element < b->element ) ? -1 : 1;
+   return ( a->point < b->point ) ? -1 : ( a->point > b->point );
+}
+
+void FeVariable_InterpolateValuesAt(
+   void*                feVariable,
+   Index                count,
+   const double*        coords,
+   double*              values,
+   Index                valueStride,
+   InterpolationResult* results )
+{
+   FeVariable*                self = (FeVariable*)feVariable;
+   FeMesh*                    mesh = self->feMesh;
+   Dimension_Index            dim = self->dim;
+   Bool                       useHint = !((Mesh*)mesh)->isRegular;
+   Bool                       haveGlobalBox = False;
+   Bool                       defaultInterpolation;
+   unsigned                   localElCount = FeMesh_GetElementLocalSize( mesh );
+   unsigned                   hint = (unsigned)-1;
+   unsigned                   nLocated = 0;
+   FeVariable_PointInElement* located;
+   double                     min[3], max[3];
+   double                     shapeFuncsEvaluated[MAX_ELEMENT_NODES];
+   double*                    nodeValues;
+   Dof_Index                  dofCount;
+   Index                      point_I, run_I, loc_I;
+
+   if( count == 0 )
+      return;
+
+   located = Memory_Alloc_Array( FeVariable_PointInElement, count, "FeVariable_PointInElement" );
+
+   /* Locate each point's element. On irregular meshes a full search is expensive, so first try the
+    * element of the previous point, which is cheap and usually correct for spatially ordered input.
+    * Only a hit strictly inside the element is accepted, so points on shared faces still resolve
+    * through the search and pick the same owner as the point-wise path. */
+   for( point_I = 0; point_I < count; point_I++ ) {
+      double*          coord = (double*)coords + point_I * dim;
+      MeshTopology_Dim elDim;
+      unsigned         elInd;
+
+      if( !( useHint && hint != (unsigned)-1 &&
+             Mesh_ElementHasPoint( mesh, hint, coord, &elDim, &elInd ) && elDim == dim ) )
+      {
+         if( !Mesh_SearchElements( mesh, coord, &elInd ) ) {
+            Bool            outsideGlobal = False;
+            Dimension_Index dim_I;
+
+            if( !haveGlobalBox ) {
+               FieldVariable_GetMinAndMaxGlobalCoords( self, min, max );
+               haveGlobalBox = True;
+            }
+            for( dim_I = 0; dim_I < dim; dim_I++ ) {
+               if( ( coord[dim_I] < min[dim_I] ) || ( coord[dim_I] > max[dim_I] ) )
+                  outsideGlobal = True;
+            }
+            results[point_I] = outsideGlobal ? OUTSIDE_GLOBAL : OTHER_PROC;
+            continue;
+         }
+      }
+      hint = elInd;
+      results[point_I] = ( elInd < localElCount ) ? LOCAL : SHADOW;
+      located[nLocated].element = elInd;
+      located[nLocated].point = point_I;
+      nLocated++;
+   }
+
+   /* Group the points by element, then interpolate one element at a time */
+   qsort( located, nLocated, sizeof(FeVariable_PointInElement), _FeVariable_CmpPointInElement );
+
+   defaultInterpolation = ( self->_interpolateWithinElement == _FeVariable_InterpolateNodeValuesToElLocalCoord );
+   dofCount = self->dofLayout->dofCounts[0];
+   nodeValues = Memory_Alloc_Array( double, MAX_ELEMENT_NODES * dofCount, "nodeValues" );
+
+   for( run_I = 0; run_I < nLocated; ) {
+      unsigned     element = located[run_I].element;
+      ElementType* elementType = FeMesh_GetElementType( mesh, element );
+      unsigned     nInc = 0;
+      Index        runEnd = run_I;
+
+      while( runEnd < nLocated && located[runEnd].element == element )
+         runEnd++;
+
+      if( defaultInterpolation ) {
+         IArray*                incArray = self->threadInc[Threads_GetIndex()];
+         int*                   inc;
+         Node_ElementLocalIndex elLocalNode_I;
+         Dof_Index              dof_I;
+
+         /* Gather the element's nodal values once for all of its points */
+         FeMesh_GetElementNodes( mesh, element, incArray );
+         nInc = IArray_GetSize( incArray );
+         inc = IArray_GetPtr( incArray );
+         for( elLocalNode_I = 0; elLocalNode_I < nInc; elLocalNode_I++ ) {
+            for( dof_I = 0; dof_I < dofCount; dof_I++ ) {
+               nodeValues[elLocalNode_I * dofCount + dof_I] = StgVariable_GetValueDouble(
+                  DofLayout_GetVariable( self->dofLayout, inc[elLocalNode_I], dof_I ), inc[elLocalNode_I] );
+            }
+         }
+      }
+
+      for( loc_I = run_I; loc_I < runEnd; loc_I++ ) {
+         unsigned point = located[loc_I].point;
+         double*  value = values + point * valueStride;
+         Coord    elLocalCoord = { 0, 0, 0 };
+
+         ElementType_ConvertGlobalCoordToElLocal( elementType, mesh, element, coords + point * dim, elLocalCoord );
+
+         if( defaultInterpolation ) {
+            Node_ElementLocalIndex elLocalNode_I;
+            Dof_Index              dof_I;
+
+            ElementType_EvaluateShapeFunctionsAt( elementType, elLocalCoord, shapeFuncsEvaluated );
+            memset( value, 0, dofCount * sizeof(double) );
+            for( elLocalNode_I = 0; elLocalNode_I < nInc; elLocalNode_I++ ) {
+               for( dof_I = 0; dof_I < dofCount; dof_I++ )
+                  value[dof_I] += nodeValues[elLocalNode_I * dofCount + dof_I] * shapeFuncsEvaluated[elLocalNode_I];
+            }
+         }
+         else
+            self->_interpolateWithinElement( self, element, elLocalCoord, value );
+      }
+      run_I = runEnd;
+   }
+
+   Memory_Free( nodeValues );
+   Memory_Free( located );
+}
+
 void FeVariable_SetValueAtNode( void* feVariable, Node_DomainIndex dNode_I, double* componentValues ) {
    FeVariable* self = (FeVariable*)feVariable;
    Dof_Index   dofCountThisNode = 0;
@@ -790,12 +941,11 @@ void FeVariable_InterpolateDerivativesToElLocalCoord(
 {
    FeVariable*     self = (FeVariable*)_feVariable;
    ElementType*    elementType = FeMesh_GetElementType( self->feMesh, lElement_I );
-   double**        GNx;
+   double          GNxData[3][MAX_ELEMENT_NODES];
+   double*         GNx[3] = { GNxData[0], GNxData[1], GNxData[2] };
    double          detJac;
    Dimension_Index dim = self->dim;
 
-   GNx = self->GNx;
-
    /* Evaluate Global Shape Functions */
    ElementType_ShapeFunctionsGlobalDerivs(
       elementType,
@@ -824,6 +974,7 @@ void FeVariable_InterpolateDerivatives_WithGNx(
    /* StgVariable*           dofVariable; */
    unsigned               nInc;
    int                    *inc;
+   IArray*                incArray = self->threadInc[Threads_GetIndex()];
    Dimension_Index        dim = self->dim;
 
    /* Gets number of degrees of freedom - assuming it is the same throughout the mesh */
@@ -832,9 +983,9 @@ void FeVariable_InterpolateDerivatives_WithGNx(
    /* Initialise */
    memset( value, 0, sizeof( double ) * dofCount * dim );
 
-   FeMesh_GetElementNodes( self->feMesh, lElement_I, self->inc );
-   nInc = IArray_GetSize( self->inc );
-   inc = IArray_GetPtr( self->inc );
+   FeMesh_GetElementNodes( self->feMesh, lElement_I, incArray );
+   nInc = IArray_GetSize( incArray );
+   inc = IArray_GetPtr( incArray );
 
    /* get fevariable top data pointer */
    /* note that we now assume much simpler memory layouts */
@@ -865,6 +1016,7 @@ void FeVariable_InterpolateValue_WithNi( void* _feVariable, Element_LocalIndex l
    double                 nodeValue;
    unsigned               nInc;
    int                    *inc;
+   IArray*                incArray = self->threadInc[Threads_GetIndex()];
 
    /* Gets number of degrees of freedom - assuming it is the same throughout the mesh */
    dofCount = self->dofLayout->dofCounts[0];
@@ -872,9 +1024,9 @@ void FeVariable_InterpolateValue_WithNi( void* _feVariable, Element_LocalIndex l
    /* Initialise */
    memset( value, 0, sizeof( double ) * dofCount );
 
-   FeMesh_GetElementNodes( self->feMesh, lElement_I, self->inc );
-   nInc = IArray_GetSize( self->inc );
-   inc = IArray_GetPtr( self->inc );
+   FeMesh_GetElementNodes( self->feMesh, lElement_I, incArray );
+   nInc = IArray_GetSize( incArray );
+   inc = IArray_GetPtr( incArray );
 
    for( dof_I = 0 ; dof_I < dofCount ; dof_I++ ) {
       /* Interpolate derivative from nodes */
@@ -899,7 +1051,9 @@ void _FeVariable_SyncShadowValues( void* feVariable ) {
    FeVariable* self = (FeVariable*)feVariable;
    DofLayout*  dofLayout;
    Sync*       vertSync;
-   unsigned    var_i;
+   SyncPlan**  plans;
+   unsigned    nPlans = 0;
+   unsigned    var_i, plan_i;
 
    assert( self );
 
@@ -916,8 +1070,15 @@ void _FeVariable_SyncShadowValues( void* feVariable ) {
 
    /*
     * For each variable in the dof layout, we need to create a distributed array and update
-    * shadow values.
+    * shadow values. All the exchanges are begun before any is waited upon, so their
+    * messages are in flight together.
     */
+   for( var_i = 0; var_i < dofLayout->_totalVarCount; var_i++ ) {
+      StgVariable* var = Variable_Register_GetByIndex( dofLayout->_variableRegister, dofLayout->_varIndicesMapping[var_i] );
+      nPlans += var->offsetCount;
+   }
+   plans = Memory_Alloc_Array_Unnamed( SyncPlan*, nPlans + 1 );
+   nPlans = 0;
    for( var_i = 0; var_i < dofLayout->_totalVarCount; var_i++ ) {
       unsigned  varInd;
       StgVariable* var;
@@ -938,7 +1099,7 @@ void _FeVariable_SyncShadowValues( void* feVariable ) {
          arrayStart = (Stg_Byte*)var->arrayPtr + offs;
          arrayEnd = arrayStart + var->structSize * FeMesh_GetNodeLocalSize( self->feMesh );
 
-         Sync_SyncArray(
+         plans[nPlans++] = Sync_SyncArrayBegin(
             vertSync,
             arrayStart,
             var->structSize,
@@ -947,6 +1108,9 @@ void _FeVariable_SyncShadowValues( void* feVariable ) {
             size );
       }
    }
+   for( plan_i = 0; plan_i < nPlans; plan_i++ )
+      Sync_SyncArrayEnd( vertSync, plans[plan_i] );
+   Memory_Free( plans );
 
    self->shadowValuesSynchronised = True;
 
@@ -1002,7 +1166,6 @@ void FeVariable_PrintCoordsAndValues( void* _feVariable, Stream* stream ) {
    }
 }
 
-#define MAX_ELEMENT_NODES 27
 /* --- Private Functions --- */
 void _FeVariable_InterpolateNodeValuesToElLocalCoord(
    void*               feVariable,
@@ -1020,11 +1183,12 @@ void _FeVariable_InterpolateNodeValuesToElLocalCoord(
    double                 dofValueAtCurrNode=0;
    unsigned               nInc;
    int                    *inc;
+   IArray*                incArray = self->threadInc[Threads_GetIndex()];
    double                 shapeFuncsEvaluated[MAX_ELEMENT_NODES];
 
-   FeMesh_GetElementNodes( self->feMesh, element_lI, self->inc );
-   nInc = IArray_GetSize( self->inc );
-   inc = IArray_GetPtr( self->inc );
+   FeMesh_GetElementNodes( self->feMesh, element_lI, incArray );
+   nInc = IArray_GetSize( incArray );
+   inc = IArray_GetPtr( incArray );
 
    /* Gets number of degrees of freedom - assuming it is the same throughout the mesh */
    dofCountThisNode = self->dofLayout->dofCounts[lNode_I];
@@ -62,6 +62,8 @@
       /* A "template" feVariable this one is based on - ie this one's mesh and BCs is based off that one */ \
       FeVariable*                                  templateFeVariable; \
       IArray*                                      inc; \
+      /* Per thread incidence, for interpolation during threaded assembly. threadInc[0] == inc */ \
+      IArray**                                     threadInc; \
 			/* boolean is true if the FeVariable contains non axis-aligned bc, i.e. spherical mesh */ \
       Bool                                         nonAABCs; \
       /* some temp data space */ \
@@ -251,6 +253,21 @@
       double*              elLocalCoord,
       Element_DomainIndex* elementCoordInPtr );
 
+   /*
+    * Interpolates the field at 'count' global coords (packed 'dim' doubles per coord), writing
+    * the value for the i'th coord to 'values + i*valueStride' and its status to 'results[i]'.
+    * Points are grouped by element so each element's nodal values are gathered only once, and
+    * on irregular meshes the previous point's element is tried before a full search.
+    * Values are only written for points with a LOCAL or SHADOW result.
+    */
+   void FeVariable_InterpolateValuesAt(
+      void*                feVariable,
+      Index                count,
+      const double*        coords,
+      double*              values,
+      Index                valueStride,
+      InterpolationResult* results );
+
    /* Updates a single component of the value at a certain node */
    #define FeVariable_SetComponentAtNode( feVariable, dNode_I, dof_I, componentVal ) \
       DofLayout_SetValueDouble( (feVariable)->dofLayout, dNode_I, dof_I, componentVal );
@@ -350,6 +350,7 @@ void Inner2DGenerator_BuildGeometry( Inner2DGenerator* self, FeMesh* mesh ) {
 			memcpy( vert, globalCrd3D, nDims * sizeof(double) );
 		}
 	}
+	mesh->deformVersion++;
 }
 
 void Inner2DGenerator_BuildElementTypes( Inner2DGenerator* self, FeMesh* mesh ) {
@@ -307,6 +307,7 @@ void dQ1Generator_BuildGeometry( dQ1Generator* self, FeMesh* mesh ) {
         }
       }//for
 	}//else nDims == 3
+	mesh->deformVersion++;
 }
 
 void dQ1Generator_BuildElementTypes( dQ1Generator* self, FeMesh* mesh ) {
@@ -26,6 +26,7 @@
    typedef struct dQ13DElType               dQ13DElType;
    typedef struct FiniteElement_Element     FiniteElement_Element;
    typedef struct FeMesh                    FeMesh;
+   typedef struct FeMesh_ShapeFuncCache     FeMesh_ShapeFuncCache;
    typedef struct C0Generator               C0Generator;
    typedef struct C2Generator               C2Generator;
    typedef struct P1Generator               P1Generator;
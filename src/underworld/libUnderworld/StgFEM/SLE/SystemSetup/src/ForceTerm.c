@@ -71,6 +71,8 @@ ForceTerm* _ForceTerm_New(  FORCETERM_DEFARGS  ) {
 	self = (ForceTerm*)_Stg_Component_New(  STG_COMPONENT_PASSARGS  );
 
 	self->_assembleElement = _assembleElement;
+	/* Children which support threaded assembly set this after construction */
+	self->threadSafe = False;
 	
 	return self;
 }
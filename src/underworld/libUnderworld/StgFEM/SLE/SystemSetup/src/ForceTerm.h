@@ -34,7 +34,9 @@
       Stream*										debug; \
       ForceVector*                        forceVector; \
       Swarm*										integrationSwarm; \
-      Stg_Component*								extraInfo;
+      Stg_Component*								extraInfo; \
+      /* True where _assembleElement may be called concurrently for different elements */ \
+      Bool                                threadSafe;
 	
 	struct ForceTerm { __ForceTerm };
 
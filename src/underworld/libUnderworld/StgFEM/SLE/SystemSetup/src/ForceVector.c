@@ -97,6 +97,7 @@ void _ForceVector_Init( void* forceVector, Dimension_Index dim, EntryPoint_Regis
 	self->forceTermList = Stg_ObjectList_New();
 
 	self->inc = IArray_New();
+	self->threadedAssembly = False;
 
 }
 
@@ -125,6 +126,8 @@ void _ForceVector_AssignFromXML( void* forceVector, Stg_ComponentFactory* cf, vo
 	dim = Stg_ComponentFactory_GetUnsignedInt( cf, self->name, (Dictionary_Entry_Key)"dim", dim );
 
 	_ForceVector_Init( self, dim, entryPointRegister );
+
+	self->threadedAssembly = Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"threadedAssembly", False );
 }
 
 void _ForceVector_Build( void* forceVector, void* data ) {
@@ -228,6 +231,83 @@ void _ForceVector_VectorView( Vec v, Stream* stream ) {
 	VecRestoreArray( v, &array );
 }
 
+/* As for stiffness matrices, elements are assembled in batches. Element force vectors for a batch
+   are computed first, concurrently where threaded assembly is enabled, and then added to the PETSc
+   vector in element order. */
+#define FORCEVECTOR_BATCH_SIZE 256
+
+static Bool _ForceVector_TermsThreadSafe( ForceVector* self ) {
+	Index term_I;
+
+	for( term_I = 0; term_I < Stg_ObjectList_Count( self->forceTermList ); term_I++ ) {
+		if( !((ForceTerm*)Stg_ObjectList_At( self->forceTermList, term_I ))->threadSafe )
+			return False;
+	}
+	return True;
+}
+
+/* Assembles the force vector for a single element, and clears BC entries where BCs are kept.
+   This may be called concurrently for different elements. */
+static void _ForceVector_AssembleBatchElement( ForceVector* self, IArray* incArray, Element_LocalIndex element_lI,
+					       double* elForceVecToAdd, Dof_Index totalDofsThisElement )
+{
+	FeVariable*        feVar = self->feVariable;
+	FeEquationNumber*  eqNum = self->eqNum;
+
+	/* Initialise Values to Zero */
+	memset( elForceVecToAdd, 0, totalDofsThisElement * sizeof(double) );
+
+	/* Assemble this element's element force vector: going through each force term in list */
+	ForceVector_AssembleElement( self, element_lI, elForceVecToAdd );
+
+	/* When keeping BCs in we come across a bit of a problem in parallel. We're not
+	   allowed to add entries to the force vector here and then clobber it later with
+	   an insert in order to set the BC. So, what we'll do is just add zero here, that
+	   way later we can add the BC and it will be the same as inserting it.
+	   --- Luke, 20 May 2008 */
+	if( !eqNum->removeBCs ) {
+	   DofLayout* dofs;
+	   unsigned nInc, *inc;
+	   int nDofs, curInd;
+	   int ii, jj;
+
+	   FeMesh_GetElementNodes( feVar->feMesh, element_lI, incArray );
+	   nInc = IArray_GetSize( incArray );
+	   inc = IArray_GetPtr( incArray );
+
+	   dofs = feVar->dofLayout; /* shortcut to the dof layout */
+	   curInd = 0; /* need a counter to track where we are in the element force vector */
+	   for( ii = 0; ii < nInc; ii++ ) {
+	      nDofs = dofs->dofCounts[inc[ii]]; /* number of dofs on this node */
+	      for( jj = 0; jj < nDofs; jj++ ) {
+	         if( !FeVariable_IsBC( feVar, inc[ii], jj ) ) {
+	            curInd++;
+	            continue; /* only need to clear it if it's a bc */
+	         }
+	         elForceVecToAdd[curInd] = 0.0;
+	         curInd++;
+	      }
+	   }
+	}
+}
+
+/* Arguments of _ForceVector_AssembleBatchSlot, which assembles a batch over threads. */
+typedef struct {
+	ForceVector*  self;
+	IArray**      incArrays;   /* per thread */
+	Index         first;       /* first element of the batch */
+	double*       elForceVecs;
+	Index*        offsets;
+	Dof_Index*    totalDofs;
+} ForceVector_BatchLoop;
+
+static void _ForceVector_AssembleBatchSlot( void* data, int slot ) {
+	ForceVector_BatchLoop* loop = (ForceVector_BatchLoop*)data;
+
+	_ForceVector_AssembleBatchElement( loop->self, loop->incArrays[Threads_GetIndex()], loop->first + slot,
+					   loop->elForceVecs + loop->offsets[slot], loop->totalDofs[slot] );
+}
+
 void ForceVector_GlobalAssembly_General( void* forceVector ) {
 	ForceVector*            self                 = (ForceVector*) forceVector;
 	FeVariable*             feVar                = self->feVariable;
@@ -236,94 +316,110 @@ void ForceVector_GlobalAssembly_General( void* forceVector ) {
 	Element_LocalIndex      elementLocalCount;
 	Node_ElementLocalIndex  nodeCountCurrElement = 0;
 	Element_Nodes           nodeIdsInCurrElement = 0;
-	Dof_Index               totalDofsThisElement = 0;
-	Dof_Index               totalDofsPrevElement = 0;
 	Dof_Index               dofCountLastNode     = 0;
 	Dof_EquationNumber**    elementLM            = NULL;
-	double*                 elForceVecToAdd      = NULL;
-	/* For output printing */
-	double                  outputPercentage=10;	/* Controls how often to give a status update of assembly progress */
-	int                     outputInterval;
+	double*                 elForceVecs          = NULL;
+	Index                   elForceVecsSize      = 0;
+	Dof_Index               totalDofs[FORCEVECTOR_BATCH_SIZE];
+	Index                   offsets[FORCEVECTOR_BATCH_SIZE];
+	Index                   first, count, slot, size;
+	unsigned                nThreads, thread_i;
+	IArray**                incArrays;
+	ForceVector_BatchLoop   loop;
+	Bool                    threaded;
 
 	Journal_DPrintf( self->debug, "In %s - for vector \"%s\"\n", __func__, self->name );
 
 	Stream_IndentBranch( StgFEM_Debug );
 
+	/* follow any renumbering since the vector was created */
+	SolutionVector_UpdateSize( self );
+	self->localSize = eqNum->localEqNumsOwnedCount;
+
 	if ( Stg_ObjectList_Count( self->forceTermList ) > 0 ) {
 		elementLocalCount = FeMesh_GetElementLocalSize( feVar->feMesh );
 
-		/* Initialise Vector */
-		outputInterval = (int)( (outputPercentage/100.0)*(double)(elementLocalCount) );
-		if( outputInterval == 0 ) { outputInterval = elementLocalCount; }
-
-		for( element_lI = 0; element_lI < elementLocalCount; element_lI++ ) {
-			unsigned	nInc, *inc;
-
-			FeMesh_GetElementNodes( feVar->feMesh, element_lI, self->inc );
-			nInc = IArray_GetSize( self->inc );
-			inc = IArray_GetPtr( self->inc );
-			nodeCountCurrElement = nInc;
-			/* Get the local node ids */
-			nodeIdsInCurrElement = inc;
-
-			/* Set value of elementLM: will automatically just index into global LM table if built */
-			elementLM = eqNum->locationMatrix[element_lI];
-
-			/* work out number of dofs at the node, using LM */
-			/* Since: Number of entries in LM table for this element = (by defn.) Number of dofs this element */
-			dofCountLastNode = feVar->dofLayout->dofCounts[nodeIdsInCurrElement[nodeCountCurrElement-1]];
-			totalDofsThisElement = &elementLM[nodeCountCurrElement-1][dofCountLastNode-1] - &elementLM[0][0] + 1;
+		/* Only thread where requested, and where all terms allow it. */
+		threaded = False;
+#ifdef HAVE_OPENMP
+		if( self->threadedAssembly && Threads_GetMaxCount() > 1 ) {
+			threaded = _ForceVector_TermsThreadSafe( self );
+			if( !threaded )
+				Journal_DPrintf( self->debug, "Not all terms of vector \"%s\" are thread safe, so assembling serially.\n", self->name );
+		}
+#endif
+		nThreads = threaded ? Threads_GetMaxCount() : 1;
+		incArrays = Memory_Alloc_Array( IArray*, nThreads, "ForceVector_incArrays" );
+		incArrays[0] = self->inc;
+		for( thread_i = 1; thread_i < nThreads; thread_i++ )
+			incArrays[thread_i] = IArray_New();
+
+		for( first = 0; first < elementLocalCount; first += count ) {
+			count = (elementLocalCount - first < FORCEVECTOR_BATCH_SIZE) ? elementLocalCount - first : FORCEVECTOR_BATCH_SIZE;
+
+			/* Record the size of each element force vector */
+			size = 0;
+			for( slot = 0; slot < count; slot++ ) {
+				unsigned	nInc, *inc;
+
+				element_lI = first + slot;
+				FeMesh_GetElementNodes( feVar->feMesh, element_lI, self->inc );
+				nInc = IArray_GetSize( self->inc );
+				inc = IArray_GetPtr( self->inc );
+				nodeCountCurrElement = nInc;
+				/* Get the local node ids */
+				nodeIdsInCurrElement = inc;
+
+				/* Set value of elementLM: will automatically just index into global LM table if built */
+				elementLM = eqNum->locationMatrix[element_lI];
+
+				/* work out number of dofs at the node, using LM */
+				/* Since: Number of entries in LM table for this element = (by defn.) Number of dofs this element */
+				dofCountLastNode = feVar->dofLayout->dofCounts[nodeIdsInCurrElement[nodeCountCurrElement-1]];
+				totalDofs[slot] = &elementLM[nodeCountCurrElement-1][dofCountLastNode-1] - &elementLM[0][0] + 1;
+				offsets[slot] = size;
+				size += totalDofs[slot];
+			}
 
-			if ( totalDofsThisElement > totalDofsPrevElement ) {
-				if (elForceVecToAdd) Memory_Free( elForceVecToAdd );
-				Journal_DPrintfL( self->debug, 2, "Reallocating elForceVecToAdd to size %d\n", totalDofsThisElement );
-				elForceVecToAdd = Memory_Alloc_Array( double, totalDofsThisElement, "elForceVecToAdd" );
+			if ( size > elForceVecsSize ) {
+				if (elForceVecs) Memory_Free( elForceVecs );
+				Journal_DPrintfL( self->debug, 2, "Reallocating elForceVecs to size %d\n", size );
+				elForceVecs = Memory_Alloc_Array( double, size, "elForceVecs" );
+				elForceVecsSize = size;
 			}
 
-			/* Initialise Values to Zero */
-			memset( elForceVecToAdd, 0, totalDofsThisElement * sizeof(double) );
-
-			/* Assemble this element's element force vector: going through each force term in list */
-			ForceVector_AssembleElement( self, element_lI, elForceVecToAdd );
-
-
-	        /* When keeping BCs in we come across a bit of a problem in parallel. We're not
-	           allowed to add entries to the force vector here and then clobber it later with
-	           an insert in order to set the BC. So, what we'll do is just add zero here, that
-	           way later we can add the BC and it will be the same as inserting it.
-	           --- Luke, 20 May 2008 */
-	        if( !eqNum->removeBCs ) {
-	           DofLayout* dofs;
-	           int nDofs, curInd;
-	           int ii, jj;
-
-	           dofs = feVar->dofLayout; /* shortcut to the dof layout */
-	           curInd = 0; /* need a counter to track where we are in the element force vector */
-	           for( ii = 0; ii < nodeCountCurrElement; ii++ ) {
-	              nDofs = dofs->dofCounts[inc[ii]]; /* number of dofs on this node */
-	              for( jj = 0; jj < nDofs; jj++ ) {
-	                 if( !FeVariable_IsBC( feVar, inc[ii], jj ) ) {
-	                    curInd++;
-	                    continue; /* only need to clear it if it's a bc */
-	                 }
-	                 elForceVecToAdd[curInd] = 0.0;
-	                 curInd++;
-	              }
-	           }
-	        }
+			/* The first batch is always assembled serially, so that any term errors are reported as usual. */
+#ifdef HAVE_OPENMP
+			if( threaded && first > 0 ) {
+				loop.self = self;
+				loop.incArrays = incArrays;
+				loop.first = first;
+				loop.elForceVecs = elForceVecs;
+				loop.offsets = offsets;
+				loop.totalDofs = totalDofs;
+				Threads_ParallelFor( (int)count, nThreads, _ForceVector_AssembleBatchSlot, &loop );
+			}
+			else
+#endif
+			for( slot = 0; slot < count; slot++ )
+				_ForceVector_AssembleBatchElement( self, incArrays[0], first + slot, elForceVecs + offsets[slot], totalDofs[slot] );
 
 			/* Ok, assemble into global matrix */
-			//Vector_AddEntries( self->vector, totalDofsThisElement, (Index*)(elementLM[0]), elForceVecToAdd );
-			VecSetValues( self->vector, totalDofsThisElement, (PetscInt*)elementLM[0], elForceVecToAdd, ADD_VALUES );
-
-			/* Cleanup: If we haven't built the big LM for all elements, free the temporary one */
-			if ( False == eqNum->locationMatrixBuilt ) {
-				Memory_Free( elementLM );
+			for( slot = 0; slot < count; slot++ ) {
+				elementLM = eqNum->locationMatrix[first + slot];
+				VecSetValues( self->vector, totalDofs[slot], (PetscInt*)elementLM[0], elForceVecs + offsets[slot], ADD_VALUES );
+
+				/* Cleanup: If we haven't built the big LM for all elements, free the temporary one */
+				if ( False == eqNum->locationMatrixBuilt ) {
+					Memory_Free( elementLM );
+				}
 			}
-			totalDofsPrevElement = totalDofsThisElement;
 		}
 
-		Memory_Free( elForceVecToAdd );
+		for( thread_i = 1; thread_i < nThreads; thread_i++ )
+			Stg_Class_Delete( incArrays[thread_i] );
+		Memory_Free( incArrays );
+		if (elForceVecs) Memory_Free( elForceVecs );
 	}
 	else {
 		Journal_DPrintf( self->debug, "No ForceTerms registered - returning.\n" );
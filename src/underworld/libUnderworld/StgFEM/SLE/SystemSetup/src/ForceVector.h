@@ -31,6 +31,8 @@
 		Stg_ObjectList*			forceTermList;  \
 		Stg_Component*				applicationDepExtraInfo; /**< Default is NULL: passed to elForceVec during assembly */\
 		IArray*						inc;  \
+		/** Opt-in thread parallel element assembly (requires HAVE_OPENMP, and thread safe terms) */ \
+		Bool							threadedAssembly;  \
 
 
 	struct ForceVector { __ForceVector };
@@ -113,6 +113,7 @@ void _PETScMGSolver_Init( PETScMGSolver* self ) {
 	self->opGen = NULL;
 	self->solversChanged = True;
 	self->opsChanged = True;
+	self->telescopeRows = 0;
 }
 
 
@@ -153,6 +154,7 @@ void _PETScMGSolver_AssignFromXML( void* matrixSolver, Stg_ComponentFactory* cf,
 	unsigned	nLevels;
 	unsigned	nCycles;
 	unsigned	nDownIts, nUpIts;
+	unsigned	telescopeRows;
 
 	assert( self && Stg_CheckType( self, PETScMGSolver ) );
 	assert( cf );
@@ -164,6 +166,7 @@ void _PETScMGSolver_AssignFromXML( void* matrixSolver, Stg_ComponentFactory* cf,
 	nCycles = Stg_ComponentFactory_GetUnsignedInt( cf, self->name, (Dictionary_Entry_Key)"cycles", 1  );
 	nDownIts = Stg_ComponentFactory_GetUnsignedInt( cf, self->name, (Dictionary_Entry_Key)"downIterations", 1  );
 	nUpIts = Stg_ComponentFactory_GetUnsignedInt( cf, self->name, (Dictionary_Entry_Key)"upIterations", 1  );
+	telescopeRows = Stg_ComponentFactory_GetUnsignedInt( cf, self->name, (Dictionary_Entry_Key)"telescopeRows", 0  );
    
    Journal_Firewall( nLevels>1, NULL, "In func %s: Multigrid required mgLevels>1", __func__ );
 
@@ -172,6 +175,7 @@ void _PETScMGSolver_AssignFromXML( void* matrixSolver, Stg_ComponentFactory* cf,
 	PETScMGSolver_SetLevelCycles( self, nLevels - 1, nCycles );
 	PETScMGSolver_SetAllDownIterations( self, nDownIts );
 	PETScMGSolver_SetAllUpIterations( self, nUpIts );
+	PETScMGSolver_SetTelescopeRows( self, telescopeRows );
 
 	self->opGen = Stg_ComponentFactory_ConstructByKey( cf, self->name, (Dictionary_Entry_Key)"opGenerator", MGOpGenerator, True, data  );
 	MGOpGenerator_SetMatrixSolver( self->opGen, self );
@@ -274,6 +278,7 @@ void PETScMGSolver_Setup( void* matrixSolver, void* rhs, void* solution ) {
 		wallTime = MPI_Wtime();
 		PETScMGSolver_UpdateMatrices( self );
 		PETScMGSolver_UpdateWorkVectors( self );
+		PETScMGSolver_UpdateTelescoping( self );
 		PetscPrintf( PETSC_COMM_WORLD, "PETScMGSolver_UpdateMats-WorkVecs %g\n", MPI_Wtime() - wallTime); 
 	}
 
@@ -431,6 +436,14 @@ unsigned PETScMGSolver_GetNumLevels( void* matrixSolver ) {
 	return self->nLevels;
 }
 
+void PETScMGSolver_SetTelescopeRows( void* matrixSolver, unsigned nRows ) {
+	PETScMGSolver*	self = (PETScMGSolver*)matrixSolver;
+
+	assert( self && Stg_CheckType( self, PETScMGSolver ) );
+
+	self->telescopeRows = nRows;
+}
+
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ** Private Functions
@@ -475,6 +488,8 @@ void PETScMGSolver_UpdateMatrices( PETScMGSolver* self ) {
 	PETScMGSolver_Level*	level;
 	PC			pc;
 	KSP			levelKSP;
+	PC			levelPC;
+	StiffnessMatrix*	matrixFree;
 	PetscErrorCode		ec;
 	unsigned		l_i;
 
@@ -493,6 +508,11 @@ void PETScMGSolver_UpdateMatrices( PETScMGSolver* self ) {
 		if( l_i == self->nLevels - 1 )
 			//level->A = (PETScMatrix*)self->matrix;
 			level->A = self->mgData->matrix;
+		else if( l_i == self->nLevels - 2 && (matrixFree = StiffnessMatrix_GetMatrixFreeOwner( self->levels[l_i + 1].A )) ) {
+			/* A matrix-free operator can't be multiplied out, so the first coarse level comes from its elements. */
+			StiffnessMatrix_AssembleGalerkin( matrixFree, self->levels[l_i + 1].P,
+							  level->A ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX, &level->A );
+		}
 		else {
                     if( level->A )
                         MatPtAP( self->levels[l_i + 1].A, self->levels[l_i + 1].P, MAT_REUSE_MATRIX, 1.0, &level->A );
@@ -516,12 +536,23 @@ void PETScMGSolver_UpdateMatrices( PETScMGSolver* self ) {
 		//ec = PCMGSetResidual( pc, l_i, PCMGDefaultResidual, level->A->petscMat );
 		ec = PCMGSetResidual( pc, l_i, Stg_PCMGDefaultResidual, level->A );
 		CheckPETScError( ec );
+		/* SOR and ILU need entries; Jacobi only needs the diagonal. Options may still override. */
+		if( StiffnessMatrix_GetMatrixFreeOwner( level->A ) ) {
+			ec = KSPGetPC( levelKSP, &levelPC ); CheckPETScError( ec );
+			ec = PCSetType( levelPC, PCJACOBI ); CheckPETScError( ec );
+			ec = PCSetFromOptions( levelPC ); CheckPETScError( ec );
+		}
 
 		if( l_i > 0 ) {
 			PCMGGetSmootherUp( pc, l_i, &levelKSP );
 			//ec = Stg_KSPSetOperators( levelKSP, level->A->petscMat, level->A->petscMat, DIFFERENT_NONZERO_PATTERN );
 			ec = Stg_KSPSetOperators( levelKSP, level->A, level->A, DIFFERENT_NONZERO_PATTERN );
 			CheckPETScError( ec );
+			if( StiffnessMatrix_GetMatrixFreeOwner( level->A ) ) {
+				ec = KSPGetPC( levelKSP, &levelPC ); CheckPETScError( ec );
+				ec = PCSetType( levelPC, PCJACOBI ); CheckPETScError( ec );
+				ec = PCSetFromOptions( levelPC ); CheckPETScError( ec );
+			}
 		}
 	}
 
@@ -695,6 +726,74 @@ void PETScMGSolver_UpdateSolvers( PETScMGSolver* self ) {
 	}
 }
 
+void PETScMGSolver_UpdateTelescoping( PETScMGSolver* self ) {
+#if( ((PETSC_VERSION_MAJOR==3) && (PETSC_VERSION_MINOR>=7)) || (PETSC_VERSION_MAJOR>3) )
+	Stream*			stream;
+	PC			pc;
+	KSP			levelKSP;
+	PC			levelPC;
+	const char*		prefix;
+	char			optName[256];
+	PetscTruth		isSet;
+	PetscInt		nRows;
+	PetscMPIInt		nProcs;
+	MPI_Comm		comm;
+	PetscErrorCode		ec;
+	int			nActive, factor;
+	unsigned		l_i;
+
+	assert( self && Stg_CheckType( self, PETScMGSolver ) );
+
+	if( !self->telescopeRows || self->nLevels < 2 )
+		return;
+
+	stream = Journal_Register( InfoStream_Type, (Name)"general" );
+	ec = KSPGetPC( self->mgData->ksp, &pc ); CheckPETScError( ec );
+	ec = PetscObjectGetComm( (PetscObject)pc, &comm ); CheckPETScError( ec );
+	MPI_Comm_size( comm, &nProcs );
+	if( nProcs == 1 )
+		return;
+
+	for( l_i = 0; l_i < self->nLevels - 1; l_i++ ) {
+		/* A coarse level has a row for each column of the prolongation from it. */
+		ec = MatGetSize( self->levels[l_i + 1].P, PETSC_NULL, &nRows ); CheckPETScError( ec );
+		if( nRows >= (PetscInt)self->telescopeRows * nProcs )
+			continue;
+
+		/* PCTELESCOPE keeps one processor in every "factor". */
+		nActive = nRows / self->telescopeRows;
+		if( nActive < 1 )
+			nActive = 1;
+		factor = (nProcs + nActive - 1) / nActive;
+		if( factor < 2 )
+			continue;
+
+		ec = PCMGGetSmootherDown( pc, l_i, &levelKSP ); CheckPETScError( ec );
+		ec = KSPGetPC( levelKSP, &levelPC ); CheckPETScError( ec );
+		ec = PCSetType( levelPC, PCTELESCOPE ); CheckPETScError( ec );
+		ec = PCTelescopeSetReductionFactor( levelPC, factor ); CheckPETScError( ec );
+		if( l_i == 0 ) {
+			/* The coarse solve stays direct, on the remaining processors, unless options say otherwise. */
+			ec = KSPGetOptionsPrefix( levelKSP, &prefix ); CheckPETScError( ec );
+			sprintf( optName, "-%stelescope_pc_type", prefix ? prefix : "" );
+			ec = PetscOptionsHasName( PETSC_NULL, optName, &isSet ); CheckPETScError( ec );
+			if( !isSet ) {
+				ec = PetscOptionsSetValue( optName, PCREDUNDANT ); CheckPETScError( ec );
+			}
+		}
+		else {
+			ec = PCMGGetSmootherUp( pc, l_i, &levelKSP ); CheckPETScError( ec );
+			ec = KSPGetPC( levelKSP, &levelPC ); CheckPETScError( ec );
+			ec = PCSetType( levelPC, PCTELESCOPE ); CheckPETScError( ec );
+			ec = PCTelescopeSetReductionFactor( levelPC, factor ); CheckPETScError( ec );
+		}
+
+		Journal_Printf( stream, "Telescoping MG level %u (%d rows) onto %d of %d processors\n",
+				l_i, (int)nRows, (nProcs + factor - 1) / factor, (int)nProcs );
+	}
+#endif
+}
+
 void PETScMGSolver_Destruct( PETScMGSolver* self ) {
 	assert( self && Stg_CheckType( self, PETScMGSolver ) );
 
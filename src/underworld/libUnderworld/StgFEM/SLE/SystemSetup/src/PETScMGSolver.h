@@ -58,6 +58,8 @@
 		MGOpGenerator*		opGen;		\
 		Bool			solversChanged;	\
 		Bool			opsChanged;	\
+		/* levels averaging fewer rows per processor than this are telescoped onto fewer processors */ \
+		unsigned		telescopeRows;	\
 		/* this stuff was previously stored in the */ \
 		/* multigridSolver class, from which this inherited */ \
 		MGSolver_PETScData*	mgData;
@@ -139,6 +141,10 @@
 
 	unsigned PETScMGSolver_GetNumLevels( void* matrixSolver );
 
+	/** Coarse levels averaging fewer than nRows rows per processor are solved (or smoothed) on as few processors as
+	    keep about nRows rows each, through PCTELESCOPE. 0, the default, disables telescoping. */
+	void PETScMGSolver_SetTelescopeRows( void* matrixSolver, unsigned nRows );
+
 	/*--------------------------------------------------------------------------------------------------------------------------
 	** Private Member functions
 	*/
@@ -147,6 +153,7 @@
 	void PETScMGSolver_UpdateMatrices( PETScMGSolver* self );
 	void PETScMGSolver_UpdateWorkVectors( PETScMGSolver* self );
 	void PETScMGSolver_UpdateSolvers( PETScMGSolver* self );
+	void PETScMGSolver_UpdateTelescoping( PETScMGSolver* self );
 
 	void PETScMGSolver_Destruct( PETScMGSolver* self );
 	void PETScMGSolver_DestructLevels( PETScMGSolver* self );
@@ -116,6 +116,18 @@ void _SolutionVector_AssignFromXML( void* solutionVector, Stg_ComponentFactory*
 	_SolutionVector_Init( self, MPI_COMM_WORLD, (FeVariable*)feVariable );
 }
 
+static void _SolutionVector_CreateVector( SolutionVector* self ) {
+   VecCreate( self->comm, &self->vector );
+   VecSetSizes( self->vector, self->eqNum->localEqNumsOwnedCount, PETSC_DECIDE );
+   VecSetFromOptions( self->vector );
+#if( PETSC_VERSION_MAJOR <= 2 && PETSC_VERSION_MINOR >= 3 && PETSC_VERSION_SUBMINOR >= 3 )
+   VecSetOption( self->vector, VEC_IGNORE_NEGATIVE_INDICES );
+#elif( PETSC_VERSION_MAJOR >= 3 )
+   VecSetOption( self->vector, VEC_IGNORE_NEGATIVE_INDICES, PETSC_TRUE );
+#endif
+   self->eqNumVersion = self->eqNum->version;
+}
+
 void _SolutionVector_Build( void* solutionVector, void* data ) {
    SolutionVector* self = (SolutionVector*)solutionVector;
 
@@ -128,18 +140,28 @@ void _SolutionVector_Build( void* solutionVector, void* data ) {
 
    Journal_Firewall( (self->eqNum!=NULL), NULL, "Solution vector could not be built as provided FeVariable does not appear to have an equation number object.\nPlease contact developers." );
    /* Allocate the vector */
-   VecCreate( self->comm, &self->vector );
-   VecSetSizes( self->vector, self->eqNum->localEqNumsOwnedCount, PETSC_DECIDE );
-   VecSetFromOptions( self->vector );
-#if( PETSC_VERSION_MAJOR <= 2 && PETSC_VERSION_MINOR >= 3 && PETSC_VERSION_SUBMINOR >= 3 )
-   VecSetOption( self->vector, VEC_IGNORE_NEGATIVE_INDICES );
-#elif( PETSC_VERSION_MAJOR >= 3 )
-   VecSetOption( self->vector, VEC_IGNORE_NEGATIVE_INDICES, PETSC_TRUE );
-#endif
+   _SolutionVector_CreateVector( self );
 
    Stream_UnIndentBranch( StgFEM_Debug );
 }
 
+void SolutionVector_UpdateSize( void* solutionVector ) {
+   SolutionVector* self = (SolutionVector*)solutionVector;
+   PetscInt        localSize;
+
+   if( self->eqNum->version == self->eqNumVersion )
+      return;
+
+   VecGetLocalSize( self->vector, &localSize );
+   if( localSize != self->eqNum->localEqNumsOwnedCount ) {
+      Journal_DPrintfL( self->debug, 1, "Resizing \"%s\" to %d local entries after renumbering.\n",
+                        self->name, self->eqNum->localEqNumsOwnedCount );
+      Stg_VecDestroy( &self->vector );
+      _SolutionVector_CreateVector( self );
+   }
+   self->eqNumVersion = self->eqNum->version;
+}
+
 void _SolutionVector_Initialise( void* solutionVector, void* data ) {
 	SolutionVector*          self = (SolutionVector *)solutionVector;
 
@@ -213,6 +235,9 @@ void SolutionVector_UpdateSolutionOntoNodes( void* solutionVector ) {
 	double			initialGuessAtNonLocalEqNumsRatio = 0.1;
 	double			ratioToIncreaseRequestArraySize = 1.5;
 	Index			newReqFromOthersSize;
+	Index			nNonLocal, nonLocal_I;
+	Dof_EquationNumber*	nonLocalEqNums;
+	int*			nonLocalOwners;
 
 	Journal_DPrintf( self->debug, "In %s - for \"%s\"\n", __func__, self->name );
 	Stream_IndentBranch( StgFEM_Debug );
@@ -229,6 +254,28 @@ void SolutionVector_UpdateSolutionOntoNodes( void* solutionVector ) {
 	MPI_Comm_size( mpiComm, (int*)&nProc );
 	MPI_Comm_rank( mpiComm, (int*)&myRank );
 
+	/* look up the owners of all the non-local eqNums at once */
+	nNonLocal = 0;
+	for( lNode_I=0; lNode_I < Mesh_GetLocalSize( feMesh, MT_VERTEX ); lNode_I++ ) {
+		for ( nodeLocalDof_I = 0; nodeLocalDof_I < feVar->dofLayout->dofCounts[ lNode_I ]; nodeLocalDof_I++ ) {
+			currEqNum = eqNum->mapNodeDof2Eq[lNode_I][nodeLocalDof_I];
+			if( currEqNum != -1 && !STreeMap_HasKey( eqNum->ownedMap, &currEqNum ) )
+				nNonLocal++;
+		}
+	}
+	nonLocalEqNums = Memory_Alloc_Array( Dof_EquationNumber, nNonLocal + 1, "nonLocalEqNums" );
+	nonLocalOwners = Memory_Alloc_Array( int, nNonLocal + 1, "nonLocalOwners" );
+	nNonLocal = 0;
+	for( lNode_I=0; lNode_I < Mesh_GetLocalSize( feMesh, MT_VERTEX ); lNode_I++ ) {
+		for ( nodeLocalDof_I = 0; nodeLocalDof_I < feVar->dofLayout->dofCounts[ lNode_I ]; nodeLocalDof_I++ ) {
+			currEqNum = eqNum->mapNodeDof2Eq[lNode_I][nodeLocalDof_I];
+			if( currEqNum != -1 && !STreeMap_HasKey( eqNum->ownedMap, &currEqNum ) )
+				nonLocalEqNums[nNonLocal++] = currEqNum;
+		}
+	}
+	FeEquationNumber_FindOwners( eqNum, nNonLocal, nonLocalEqNums, nonLocalOwners );
+	nonLocal_I = 0;
+
 	/* allocate arrays for nodes that I want on each processor */
 	reqFromOthersCounts = Memory_Alloc_Array( Index, nProc, "reqFromOthersCounts" );
 	reqFromOthersSizes = Memory_Alloc_Array( Index, nProc, "reqFromOthersSizes" );
@@ -279,7 +326,7 @@ void SolutionVector_UpdateSolutionOntoNodes( void* solutionVector ) {
 					RequestInfo*	requestInfo;
 
 					Journal_DPrintfL( self->debug, 3, "nonlocal -> add to req list " );
-					ownerProc = FeEquationNumber_CalculateOwningProcessorOfEqNum( eqNum, currEqNum );
+					ownerProc = nonLocalOwners[nonLocal_I++];
 					Journal_DPrintfL( self->debug, 3, "from proc %d\n", ownerProc );
 					/* first check count & realloc if necessary */
 					if (reqFromOthersCounts[ownerProc] == reqFromOthersSizes[ownerProc] ) {
@@ -327,6 +374,8 @@ void SolutionVector_UpdateSolutionOntoNodes( void* solutionVector ) {
 	Memory_Free( reqFromOthersInfos );
 	Memory_Free( reqFromOthersCounts );
 	Memory_Free( reqFromOthersSizes );
+	Memory_Free( nonLocalEqNums );
+	Memory_Free( nonLocalOwners );
 
 	//Vector_RestoreArray( self->vector, &localSolnVecValues );
 	VecRestoreArray( self->vector, &localSolnVecValues );
@@ -662,6 +711,8 @@ void SolutionVector_LoadCurrentFeVariableValuesOntoVector( void* solutionVector
 	double			value = 0;
 	PetscInt		insertionIndex = 0;
 
+	SolutionVector_UpdateSize( self );
+
 	for ( node_lI = 0; node_lI < FeMesh_GetNodeLocalSize( feMesh ); node_lI++ ) {
 		for ( dof_I = 0; dof_I < feVar->dofLayout->dofCounts[node_lI]; dof_I++ ) {
 			value = DofLayout_GetValueDouble( feVar->dofLayout, node_lI, dof_I );
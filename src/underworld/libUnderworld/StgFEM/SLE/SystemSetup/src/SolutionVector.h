@@ -24,7 +24,8 @@
 		Vec							vector; \
 		MPI_Comm						comm; \
 		FeVariable*					feVariable; /** need to get # of global unconstrained dofs */\
-    FeEquationNumber*   eqNum; /* eqNum is passed in from python layer */
+    FeEquationNumber*   eqNum; /* eqNum is passed in from python layer */ \
+		unsigned					eqNumVersion; /* version of eqNum the vector was sized for */
 
 	struct SolutionVector { __SolutionVector };
 
@@ -87,6 +88,10 @@
 
 	void SolutionVector_UpdateSolutionOntoNodes( void* solutionVector );
 
+	/** Recreates the vector if the equation numbering has been renumbered to a different size since it was
+	created. Must be called collectively. */
+	void SolutionVector_UpdateSize( void* solutionVector );
+
 	/** Loads the current value at each dof of the feVariable related to this solution vector onto the vector itself */
 	void SolutionVector_LoadCurrentFeVariableValuesOntoVector( void* solutionVector );
 
@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
+#include <math.h>
 #include <mpi.h>
 
 #include <StGermain/libStGermain/src/StGermain.h>
@@ -29,6 +30,11 @@
 #include "ForceVector.h"
 
 void __StiffnessMatrix_NewAssemble( void* stiffnessMatrix,void* _sle, void* _context );
+static void _StiffnessMatrix_CreateMatrixFree( StiffnessMatrix* self );
+static void _StiffnessMatrix_DestroyMatrixFree( StiffnessMatrix* self );
+static Bool _StiffnessMatrix_UpdateStructure( StiffnessMatrix* self );
+static Bool _StiffnessMatrix_GeometryChanged( StiffnessMatrix* self );
+static void _StiffnessMatrix_AssembleBCCorrections( StiffnessMatrix* self, SystemLinearEquations* sle, void* _context );
 
 /* Textual name of this class */
 const Type StiffnessMatrix_Type = "StiffnessMatrix";
@@ -191,6 +197,23 @@ void _StiffnessMatrix_Init(
 
     self->rowInc = IArray_New();
     self->colInc = IArray_New();
+    self->threadedAssembly = False;
+    self->matrixFree = False;
+    self->matrixFreeData = NULL;
+    self->reuseStructure = True;
+    self->rowEqNumVersion = 0;
+    self->colEqNumVersion = 0;
+    self->assembleOnce = False;
+    self->valuesAssembled = False;
+    self->valuesModified = False;
+    self->rowDeformVersion = 0;
+    self->colDeformVersion = 0;
+    self->bcElements = NULL;
+    self->nBcElements = 0;
+    self->bcElementsValid = False;
+    self->structureCount = 0;
+    self->assemblyCount = 0;
+    self->reuseCount = 0;
 
     self->matrix = PETSC_NULL;
 }
@@ -252,6 +275,17 @@ void _StiffnessMatrix_AssignFromXML( void* stiffnessMatrix, Stg_ComponentFactory
     /* Do we need to use the transpose? */
     self->transRHS = Stg_ComponentFactory_ConstructByKey( cf, self->name, (Dictionary_Entry_Key)"transposeRHS", ForceVector, False, data  );
 
+    self->threadedAssembly = Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"threadedAssembly", False  );
+
+    self->matrixFree = Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"matrixFree", False  );
+    Journal_Firewall( !(self->matrixFree && self->assembleOnNodes), Journal_Register( Error_Type, (Name)self->type  ),
+                      "Error: \"%s\" %s cannot be both matrix-free and assembled on nodes.\n", self->name, self->type );
+
+    self->reuseStructure = Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"reuseStructure", True  );
+    self->assembleOnce = Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"assembleOnce", False  );
+    Journal_Firewall( !(self->assembleOnce && self->assembleOnNodes), Journal_Register( Error_Type, (Name)self->type  ),
+                      "Error: \"%s\" %s cannot be both assembled once and assembled on nodes.\n", self->name, self->type );
+
     /* Setup the stream. */
     stream = Journal_Register( Info_Type, (Name)self->type  );
     if( Dictionary_GetBool_WithDefault( cf->rootDict, (Dictionary_Entry_Key)"watchAll", False ) == True  )
@@ -343,9 +377,11 @@ void _StiffnessMatrix_Destroy( void* stiffnessMatrix, void* data ) {
     Journal_DPrintf( self->debug, "In %s - for matrix %s\n", __func__, self->name );
 
     Stg_MatDestroy(&self->matrix );
+    _StiffnessMatrix_DestroyMatrixFree( self );
     FreeObject( self->stiffnessMatrixTermList );
     FreeArray( self->diagonalNonZeroIndices );
     FreeArray( self->offDiagonalNonZeroIndices );
+    FreeArray( self->bcElements );
 
     /* Don't delete entry points: E.P. register will delete them automatically */
     Stg_Class_Delete( self->rowInc );
@@ -356,12 +392,26 @@ void _StiffnessMatrix_Destroy( void* stiffnessMatrix, void* data ) {
 
 void StiffnessMatrix_Assemble( void* stiffnessMatrix, void* _sle, void* _context ) {
     StiffnessMatrix* self = (StiffnessMatrix*)stiffnessMatrix;
-    int ii;
 
-    StiffnessMatrix_RefreshMatrix( self );
+    if( _StiffnessMatrix_UpdateStructure( self ) ) {
+        StiffnessMatrix_RefreshMatrix( self );
+    }
+    else if( self->valuesAssembled ) {
+        if( self->assembleOnce && !self->valuesModified && !_StiffnessMatrix_GeometryChanged( self ) ) {
+            _StiffnessMatrix_AssembleBCCorrections( self, (SystemLinearEquations*)_sle, _context );
+            self->reuseCount++;
+            return;
+        }
+        MatZeroEntries( self->matrix );
+    }
 
     self->_assemblyFunction( self, _sle, _context );
 
+    self->valuesAssembled = True;
+    self->valuesModified = False;
+    self->rowDeformVersion = self->rowVariable->feMesh->deformVersion;
+    self->colDeformVersion = (self->columnVariable ? self->columnVariable : self->rowVariable)->feMesh->deformVersion;
+    self->assemblyCount++;
 }
 
 
@@ -548,172 +598,400 @@ void __StiffnessMatrix_NewAssembleNodeWise( void* stiffnessMatrix, void* _sle, v
 
 #endif
 }
-/* Callback version */
-void __StiffnessMatrix_NewAssemble( void* stiffnessMatrix, void* _sle, void* _context ) {
-    const double one = 1.0;
-    StiffnessMatrix*		self = (StiffnessMatrix*)stiffnessMatrix;
-    SystemLinearEquations*		sle = (SystemLinearEquations*)_sle;
-    FeVariable			*rowVar, *colVar;
-    FeMesh				*rowMesh, *colMesh;
-    FeEquationNumber		*rowEqNum, *colEqNum;
-    DofLayout			*rowDofs, *colDofs;
-    unsigned			nRowEls;
-    int			nRowNodes, *rowNodes;
-    int			nColNodes, *colNodes;
-    unsigned			maxDofs, maxRCDofs, nDofs, nRowDofs, nColDofs;
-    double**			elStiffMat;
-    double*				bcVals;
-    Mat                             matrix = self->matrix;
-    Vec				vector, transVector;
-    int nRowNodeDofs, nColNodeDofs;
-    int rowInd, colInd;
-    double bc;
-    unsigned			e_i, n_i, dof_i, n_j, dof_j;
+/* Elements are assembled in batches. The element matrices and boundary condition corrections
+   for a batch are computed first, concurrently where threaded assembly is enabled, and are then
+   added to the PETSc objects in element order, as PETSc insertion is not thread safe. */
+#define STIFFNESSMATRIX_BATCH_SIZE 256
+
+/* A matrix-free StiffnessMatrix never stores its global matrix. Its MATSHELL recomputes the element
+   matrices with the usual terms each time it is applied, using the same batches as assembly, and
+   applies them to values gathered over the domain (local and shadow) dofs. */
+struct StiffnessMatrix_MatrixFree {
+    SystemLinearEquations* sle;        /* as last passed to StiffnessMatrix_Assemble */
+    void*                  context;
+    int*                   rowOffsets; /* first domain value of each domain node */
+    int*                   colOffsets;
+    Vec                    rowLocal;   /* values over the domain dofs */
+    Vec                    colLocal;
+    VecScatter             rowScatter; /* from the global vector to the domain values */
+    VecScatter             colScatter;
+};
+
+typedef struct {
+    unsigned e_i;         /* local element */
+    unsigned nRowDofs;
+    unsigned nColDofs;
+    unsigned matOffset;   /* offset into batch mats */
+    unsigned rowOffset;   /* offset into batch rowBcVals */
+    unsigned colOffset;   /* offset into batch colBcVals */
+} StiffnessMatrix_BatchElement;
+
+typedef struct {
+    StiffnessMatrix_BatchElement elements[STIFFNESSMATRIX_BATCH_SIZE];
+    double*   mats;
+    unsigned  matSize;
+    double*   rowBcVals;
+    double*   colBcVals;
+    unsigned  rowSize;
+    unsigned  colSize;
+    /* per thread workspace */
+    unsigned  nThreads;
+    IArray**  rowInc;
+    IArray**  colInc;
+    double*** rows;        /* element matrix row pointers */
+    unsigned  maxRowDofs;
+    Bool      operatorOnly; /* only the element matrices are wanted, not the BC corrections */
+} StiffnessMatrix_Batch;
+
+/* Called serially, in element order, with each element of a computed batch. */
+typedef void (StiffnessMatrix_BatchElementFunc)( StiffnessMatrix* self, StiffnessMatrix_Batch* batch, unsigned e_i, unsigned slot, void* data );
+
+static Bool _StiffnessMatrix_TermsThreadSafe( StiffnessMatrix* self ) {
+    Index term_I;
+
+    for( term_I = 0; term_I < Stg_ObjectList_Count( self->stiffnessMatrixTermList ); term_I++ ) {
+        if( !((StiffnessMatrixTerm*)Stg_ObjectList_At( self->stiffnessMatrixTermList, term_I ))->threadSafe )
+            return False;
+    }
+    return True;
+}
 
-    assert( self && Stg_CheckType( self, StiffnessMatrix ) );
+/* Records the dof counts of each element of the batch, and sizes storage. This is done serially. */
+static void _StiffnessMatrix_SizeBatch( StiffnessMatrix* self, StiffnessMatrix_Batch* batch, const unsigned* elements,
+                                        unsigned first, unsigned count ) {
+    FeVariable* rowVar = self->rowVariable;
+    FeVariable* colVar = self->columnVariable ? self->columnVariable : rowVar;
+    unsigned    matSize = 0, rowSize = 0, colSize = 0, maxRowDofs = batch->maxRowDofs;
+    int         nNodes, *nodes;
+    unsigned    slot, n_i, thread_i;
+
+    for( slot = 0; slot < count; slot++ ) {
+        StiffnessMatrix_BatchElement* element = batch->elements + slot;
+
+        element->e_i = elements ? elements[first + slot] : first + slot;
+        FeMesh_GetElementNodes( rowVar->feMesh, element->e_i, batch->rowInc[0] );
+        nNodes = IArray_GetSize( batch->rowInc[0] );
+        nodes = IArray_GetPtr( batch->rowInc[0] );
+        element->nRowDofs = 0;
+        for( n_i = 0; n_i < nNodes; n_i++ )
+            element->nRowDofs += rowVar->dofLayout->dofCounts[nodes[n_i]];
+
+        FeMesh_GetElementNodes( colVar->feMesh, element->e_i, batch->colInc[0] );
+        nNodes = IArray_GetSize( batch->colInc[0] );
+        nodes = IArray_GetPtr( batch->colInc[0] );
+        element->nColDofs = 0;
+        for( n_i = 0; n_i < nNodes; n_i++ )
+            element->nColDofs += colVar->dofLayout->dofCounts[nodes[n_i]];
+
+        element->matOffset = matSize;
+        element->rowOffset = rowSize;
+        element->colOffset = colSize;
+        matSize += element->nRowDofs * element->nColDofs;
+        rowSize += element->nRowDofs;
+        colSize += element->nColDofs;
+        if( element->nRowDofs > maxRowDofs )
+            maxRowDofs = element->nRowDofs;
+    }
+
+    if( matSize > batch->matSize ) {
+        batch->mats = ReallocArray( batch->mats, double, matSize );
+        batch->matSize = matSize;
+    }
+    if( rowSize > batch->rowSize ) {
+        batch->rowBcVals = ReallocArray( batch->rowBcVals, double, rowSize );
+        batch->rowSize = rowSize;
+    }
+    if( colSize > batch->colSize ) {
+        batch->colBcVals = ReallocArray( batch->colBcVals, double, colSize );
+        batch->colSize = colSize;
+    }
+    if( maxRowDofs > batch->maxRowDofs ) {
+        for( thread_i = 0; thread_i < batch->nThreads; thread_i++ )
+            batch->rows[thread_i] = ReallocArray( batch->rows[thread_i], double*, maxRowDofs );
+        batch->maxRowDofs = maxRowDofs;
+    }
+}
+
+/* Computes the element matrix and boundary condition corrections for a single element of the
+   batch. This may be called concurrently for different elements. */
+static void _StiffnessMatrix_AssembleBatchElement( StiffnessMatrix* self, StiffnessMatrix_Batch* batch, unsigned e_i, unsigned slot,
+                                                   SystemLinearEquations* sle, void* _context )
+{
+    unsigned                      thread = Threads_GetIndex();
+    StiffnessMatrix_BatchElement* element = batch->elements + slot;
+    FeVariable                    *rowVar, *colVar;
+    FeEquationNumber              *rowEqNum, *colEqNum;
+    DofLayout                     *rowDofs, *colDofs;
+    int                           nRowNodes, *rowNodes;
+    int                           nColNodes, *colNodes;
+    unsigned                      nRowDofs = element->nRowDofs, nColDofs = element->nColDofs;
+    double**                      elStiffMat = batch->rows[thread];
+    double*                       bcVals;
+    int                           nRowNodeDofs, nColNodeDofs;
+    int                           rowInd, colInd;
+    double                        bc;
+    unsigned                      n_i, dof_i, n_j, dof_j;
 
     rowVar = self->rowVariable;
     colVar = self->columnVariable ? self->columnVariable : rowVar;
     rowEqNum = self->rowEqNum;
     colEqNum = self->colEqNum;
-    rowMesh = rowVar->feMesh;
-    colMesh = colVar->feMesh;
     rowDofs = rowVar->dofLayout;
     colDofs = colVar->dofLayout;
-    nRowEls = FeMesh_GetElementLocalSize( rowMesh );
-    assert( (rowVar == colVar) ? !self->transRHS : 1 );
 
-    //matrix = self->matrix;
-    vector = self->rhs ? self->rhs->vector : NULL;
-    transVector = self->transRHS ? self->transRHS->vector : NULL;
-    elStiffMat = NULL;
-    bcVals = NULL;
-    maxDofs = 0;
-
-    /* Begin assembling each element. */
-    for( e_i = 0; e_i < nRowEls; e_i++ ) {
-        FeMesh_GetElementNodes( rowMesh, e_i, self->rowInc );
-        nRowNodes = IArray_GetSize( self->rowInc );
-        rowNodes = IArray_GetPtr( self->rowInc );
-        FeMesh_GetElementNodes( colMesh, e_i, self->colInc );
-        nColNodes = IArray_GetSize( self->colInc );
-        colNodes = IArray_GetPtr( self->colInc );
-
-        /* Do we need more space to assemble this element? */
-        nRowDofs = 0;
-        for( n_i = 0; n_i < nRowNodes; n_i++ )
-            nRowDofs += rowDofs->dofCounts[rowNodes[n_i]];
-        nColDofs = 0;
-        for( n_i = 0; n_i < nColNodes; n_i++ )
-            nColDofs += colDofs->dofCounts[colNodes[n_i]];
-        nDofs = nRowDofs * nColDofs;
-        self->nRowDofs = nRowDofs;
-
-        self->nColDofs = nColDofs;
-        if( nDofs > maxDofs ) {
-            maxRCDofs = (nRowDofs > nColDofs) ? nRowDofs : nColDofs;
-            elStiffMat = ReallocArray2D( elStiffMat, double, nRowDofs, nColDofs );
-            bcVals = ReallocArray( bcVals, double, maxRCDofs );
-            maxDofs = nDofs;
-            self->elStiffMat = elStiffMat;
-            self->bcVals = bcVals;
-        }
-
-        /* Assemble the element. */
-        memset( elStiffMat[0], 0, nDofs * sizeof(double) );
-        StiffnessMatrix_AssembleElement( self, e_i, sle, _context, elStiffMat );
-
-        /* Correct for BCs providing I'm not keeping them in. */
-        if( vector ) {
-            memset( bcVals, 0, nRowDofs * sizeof(double) );
-
-            rowInd = 0;
-            for( n_i = 0; n_i < nRowNodes; n_i++ ) {
-                nRowNodeDofs = rowDofs->dofCounts[rowNodes[n_i]];
-                for( dof_i = 0; dof_i < nRowNodeDofs; dof_i++ ) {
-                    if( !FeVariable_IsBC( rowVar, rowNodes[n_i], dof_i ) ) {
-                        colInd = 0;
-                        for( n_j = 0; n_j < nColNodes; n_j++ ) {
-                            nColNodeDofs = colDofs->dofCounts[colNodes[n_j]];
-                            for( dof_j = 0; dof_j < nColNodeDofs; dof_j++ ) {
-                                if( FeVariable_IsBC( colVar, colNodes[n_j], dof_j ) ) {
-                                    bc = DofLayout_GetValueDouble( colDofs, colNodes[n_j], dof_j );
-                                    bcVals[rowInd] -= bc * elStiffMat[rowInd][colInd];
-                                }
-                                colInd++;
+    FeMesh_GetElementNodes( rowVar->feMesh, e_i, batch->rowInc[thread] );
+    nRowNodes = IArray_GetSize( batch->rowInc[thread] );
+    rowNodes = IArray_GetPtr( batch->rowInc[thread] );
+    FeMesh_GetElementNodes( colVar->feMesh, e_i, batch->colInc[thread] );
+    nColNodes = IArray_GetSize( batch->colInc[thread] );
+    colNodes = IArray_GetPtr( batch->colInc[thread] );
+
+    /* Assemble the element. */
+    for( rowInd = 0; rowInd < nRowDofs; rowInd++ )
+        elStiffMat[rowInd] = batch->mats + element->matOffset + rowInd * nColDofs;
+    memset( batch->mats + element->matOffset, 0, nRowDofs * nColDofs * sizeof(double) );
+    StiffnessMatrix_AssembleElement( self, e_i, sle, _context, elStiffMat );
+
+    /* Correct for BCs providing I'm not keeping them in. */
+    if( !batch->operatorOnly && self->rhs && self->rhs->vector ) {
+        bcVals = batch->rowBcVals + element->rowOffset;
+        memset( bcVals, 0, nRowDofs * sizeof(double) );
+
+        rowInd = 0;
+        for( n_i = 0; n_i < nRowNodes; n_i++ ) {
+            nRowNodeDofs = rowDofs->dofCounts[rowNodes[n_i]];
+            for( dof_i = 0; dof_i < nRowNodeDofs; dof_i++ ) {
+                if( !FeVariable_IsBC( rowVar, rowNodes[n_i], dof_i ) ) {
+                    colInd = 0;
+                    for( n_j = 0; n_j < nColNodes; n_j++ ) {
+                        nColNodeDofs = colDofs->dofCounts[colNodes[n_j]];
+                        for( dof_j = 0; dof_j < nColNodeDofs; dof_j++ ) {
+                            if( FeVariable_IsBC( colVar, colNodes[n_j], dof_j ) ) {
+                                bc = DofLayout_GetValueDouble( colDofs, colNodes[n_j], dof_j );
+                                bcVals[rowInd] -= bc * elStiffMat[rowInd][colInd];
                             }
+                            colInd++;
                         }
                     }
-                    rowInd++;
                 }
+                rowInd++;
             }
-
-            VecSetValues( vector, nRowDofs, (int*)rowEqNum->locationMatrix[e_i][0], bcVals, ADD_VALUES );
         }
-        if( transVector ) {
-            memset( bcVals, 0, nColDofs * sizeof(double) );
-
-            colInd = 0;
-            for( n_i = 0; n_i < nColNodes; n_i++ ) {
-                nColNodeDofs = colDofs->dofCounts[colNodes[n_i]];
-                for( dof_i = 0; dof_i < nColNodeDofs; dof_i++ ) {
-                    if( !FeVariable_IsBC( colVar, colNodes[n_i], dof_i ) ) {
-                        rowInd = 0;
-                        for( n_j = 0; n_j < nRowNodes; n_j++ ) {
-                            nRowNodeDofs = rowDofs->dofCounts[rowNodes[n_j]];
-                            for( dof_j = 0; dof_j < nRowNodeDofs; dof_j++ ) {
-                                if( FeVariable_IsBC( rowVar, rowNodes[n_j], dof_j ) ) {
-                                    bc = DofLayout_GetValueDouble( rowDofs, rowNodes[n_j], dof_j );
-                                    bcVals[colInd] -= bc * elStiffMat[rowInd][colInd];
-                                }
-                                rowInd++;
+    }
+    if( !batch->operatorOnly && self->transRHS && self->transRHS->vector ) {
+        bcVals = batch->colBcVals + element->colOffset;
+        memset( bcVals, 0, nColDofs * sizeof(double) );
+
+        colInd = 0;
+        for( n_i = 0; n_i < nColNodes; n_i++ ) {
+            nColNodeDofs = colDofs->dofCounts[colNodes[n_i]];
+            for( dof_i = 0; dof_i < nColNodeDofs; dof_i++ ) {
+                if( !FeVariable_IsBC( colVar, colNodes[n_i], dof_i ) ) {
+                    rowInd = 0;
+                    for( n_j = 0; n_j < nRowNodes; n_j++ ) {
+                        nRowNodeDofs = rowDofs->dofCounts[rowNodes[n_j]];
+                        for( dof_j = 0; dof_j < nRowNodeDofs; dof_j++ ) {
+                            if( FeVariable_IsBC( rowVar, rowNodes[n_j], dof_j ) ) {
+                                bc = DofLayout_GetValueDouble( rowDofs, rowNodes[n_j], dof_j );
+                                bcVals[colInd] -= bc * elStiffMat[rowInd][colInd];
                             }
+                            rowInd++;
                         }
                     }
-                    colInd++;
                 }
+                colInd++;
             }
-
-            VecSetValues( transVector, nColDofs, (int*)colEqNum->locationMatrix[e_i][0], bcVals, ADD_VALUES );
         }
+    }
 
-        /* If keeping BCs in, zero corresponding entries in the element stiffness matrix. */
-        if( !rowEqNum->removeBCs || !colEqNum->removeBCs ) {
-            rowInd = 0;
-            for( n_i = 0; n_i < nRowNodes; n_i++ ) {
-                nRowNodeDofs = rowDofs->dofCounts[rowNodes[n_i]];
-                for( dof_i = 0; dof_i < nRowNodeDofs; dof_i++ ) {
-                    if( FeVariable_IsBC( rowVar, rowNodes[n_i], dof_i ) ) {
-                        memset( elStiffMat[rowInd], 0, nColDofs * sizeof(double) );
-                    }
-                    else {
-                        colInd = 0;
-                        for( n_j = 0; n_j < nColNodes; n_j++ ) {
-                            nColNodeDofs = colDofs->dofCounts[colNodes[n_j]];
-                            for( dof_j = 0; dof_j < nColNodeDofs; dof_j++ ) {
-                                if( FeVariable_IsBC( colVar, colNodes[n_j], dof_j ) )
-                                    elStiffMat[rowInd][colInd] = 0.0;
-                                colInd++;
-                            }
+    /* If keeping BCs in, zero corresponding entries in the element stiffness matrix. */
+    if( !rowEqNum->removeBCs || !colEqNum->removeBCs ) {
+        rowInd = 0;
+        for( n_i = 0; n_i < nRowNodes; n_i++ ) {
+            nRowNodeDofs = rowDofs->dofCounts[rowNodes[n_i]];
+            for( dof_i = 0; dof_i < nRowNodeDofs; dof_i++ ) {
+                if( FeVariable_IsBC( rowVar, rowNodes[n_i], dof_i ) ) {
+                    memset( elStiffMat[rowInd], 0, nColDofs * sizeof(double) );
+                }
+                else {
+                    colInd = 0;
+                    for( n_j = 0; n_j < nColNodes; n_j++ ) {
+                        nColNodeDofs = colDofs->dofCounts[colNodes[n_j]];
+                        for( dof_j = 0; dof_j < nColNodeDofs; dof_j++ ) {
+                            if( FeVariable_IsBC( colVar, colNodes[n_j], dof_j ) )
+                                elStiffMat[rowInd][colInd] = 0.0;
+                            colInd++;
                         }
                     }
-                    rowInd++;
                 }
+                rowInd++;
             }
         }
+    }
+}
+
+/* Arguments of _StiffnessMatrix_AssembleBatchSlot, which assembles a batch over threads. */
+typedef struct {
+    StiffnessMatrix*       self;
+    StiffnessMatrix_Batch* batch;
+    SystemLinearEquations* sle;
+    void*                  context;
+} StiffnessMatrix_BatchLoop;
+
+static void _StiffnessMatrix_AssembleBatchSlot( void* data, int slot ) {
+    StiffnessMatrix_BatchLoop* loop = (StiffnessMatrix_BatchLoop*)data;
+
+    _StiffnessMatrix_AssembleBatchElement( loop->self, loop->batch, loop->batch->elements[slot].e_i, slot, loop->sle, loop->context );
+}
+
+/* Computes the element matrices of the given local elements (all of them if "elements" is NULL) a
+   batch at a time, and passes each to "func". */
+static void _StiffnessMatrix_ForEachElementOf( StiffnessMatrix* self, SystemLinearEquations* sle, void* _context, Bool operatorOnly,
+                                               const unsigned* elements, unsigned nElements,
+                                               StiffnessMatrix_BatchElementFunc* func, void* data )
+{
+    StiffnessMatrix_Batch		batch;
+    StiffnessMatrix_BatchLoop	loop;
+    Bool				threaded;
+    unsigned			first, count, slot, thread_i;
+
+    /* Only thread where requested, and where all terms allow it. */
+    threaded = False;
+#ifdef HAVE_OPENMP
+    if( self->threadedAssembly && Threads_GetMaxCount() > 1 ) {
+        threaded = _StiffnessMatrix_TermsThreadSafe( self );
+        if( !threaded )
+            Journal_DPrintf( self->debug, "%s: not all terms of matrix \"%s\" are thread safe, so assembling serially.\n",
+                             __func__, self->name );
+    }
+#endif
+
+    memset( &batch, 0, sizeof(StiffnessMatrix_Batch) );
+    batch.operatorOnly = operatorOnly;
+    batch.nThreads = threaded ? Threads_GetMaxCount() : 1;
+    batch.rowInc = Memory_Alloc_Array( IArray*, batch.nThreads, "StiffnessMatrix_rowInc" );
+    batch.colInc = Memory_Alloc_Array( IArray*, batch.nThreads, "StiffnessMatrix_colInc" );
+    batch.rows = Memory_Alloc_Array( double**, batch.nThreads, "StiffnessMatrix_rows" );
+    batch.rowInc[0] = self->rowInc;
+    batch.colInc[0] = self->colInc;
+    batch.rows[0] = NULL;
+    loop.self = self;
+    loop.batch = &batch;
+    loop.sle = sle;
+    loop.context = _context;
+    for( thread_i = 1; thread_i < batch.nThreads; thread_i++ ) {
+        batch.rowInc[thread_i] = IArray_New();
+        batch.colInc[thread_i] = IArray_New();
+        batch.rows[thread_i] = NULL;
+    }
+
+    /* Begin assembling each batch of elements. */
+    for( first = 0; first < nElements; first += count ) {
+        count = (nElements - first < STIFFNESSMATRIX_BATCH_SIZE) ? nElements - first : STIFFNESSMATRIX_BATCH_SIZE;
+        _StiffnessMatrix_SizeBatch( self, &batch, elements, first, count );
+
+        /* The first batch is always assembled serially, so that any term errors (which are
+           generally raised on first evaluation) are reported as usual. */
+#ifdef HAVE_OPENMP
+        if( threaded && first > 0 )
+            Threads_ParallelFor( (int)count, batch.nThreads, _StiffnessMatrix_AssembleBatchSlot, &loop );
+        else
+#endif
+        for( slot = 0; slot < count; slot++ )
+            _StiffnessMatrix_AssembleBatchElement( self, &batch, batch.elements[slot].e_i, slot, sle, _context );
+
+        for( slot = 0; slot < count; slot++ )
+            func( self, &batch, batch.elements[slot].e_i, slot, data );
+    }
+
+    for( thread_i = 1; thread_i < batch.nThreads; thread_i++ ) {
+        Stg_Class_Delete( batch.rowInc[thread_i] );
+        Stg_Class_Delete( batch.colInc[thread_i] );
+    }
+    for( thread_i = 0; thread_i < batch.nThreads; thread_i++ )
+        FreeArray( batch.rows[thread_i] );
+    Memory_Free( batch.rowInc );
+    Memory_Free( batch.colInc );
+    Memory_Free( batch.rows );
+    FreeArray( batch.mats );
+    FreeArray( batch.rowBcVals );
+    FreeArray( batch.colBcVals );
+}
+
+/* Computes the element matrices of all local elements a batch at a time, and passes each to "func". */
+static void _StiffnessMatrix_ForEachElement( StiffnessMatrix* self, SystemLinearEquations* sle, void* _context, Bool operatorOnly,
+                                             StiffnessMatrix_BatchElementFunc* func, void* data )
+{
+    _StiffnessMatrix_ForEachElementOf( self, sle, _context, operatorOnly, NULL, FeMesh_GetElementLocalSize( self->rowVariable->feMesh ),
+                                       func, data );
+}
+
+typedef struct {
+    Mat matrix;
+    Vec vector;
+    Vec transVector;
+} StiffnessMatrix_AddTargets;
+
+/* Adds an element matrix and its BC corrections to the stiffness matrix and vectors. */
+static void _StiffnessMatrix_AddBatchElement( StiffnessMatrix* self, StiffnessMatrix_Batch* batch, unsigned e_i, unsigned slot, void* data ) {
+    StiffnessMatrix_AddTargets*   targets = (StiffnessMatrix_AddTargets*)data;
+    StiffnessMatrix_BatchElement* element = batch->elements + slot;
+
+    if( targets->vector )
+        VecSetValues( targets->vector, element->nRowDofs, (int*)self->rowEqNum->locationMatrix[e_i][0],
+                      batch->rowBcVals + element->rowOffset, ADD_VALUES );
+    if( targets->transVector )
+        VecSetValues( targets->transVector, element->nColDofs, (int*)self->colEqNum->locationMatrix[e_i][0],
+                      batch->colBcVals + element->colOffset, ADD_VALUES );
+    if( targets->matrix )
+        MatSetValues( targets->matrix,
+                      element->nRowDofs, (int*)self->rowEqNum->locationMatrix[e_i][0],
+                      element->nColDofs, (int*)self->colEqNum->locationMatrix[e_i][0],
+                      batch->mats + element->matOffset, ADD_VALUES );
+}
+
+/* Callback version */
+void __StiffnessMatrix_NewAssemble( void* stiffnessMatrix, void* _sle, void* _context ) {
+    const double one = 1.0;
+    StiffnessMatrix*		self = (StiffnessMatrix*)stiffnessMatrix;
+    SystemLinearEquations*		sle = (SystemLinearEquations*)_sle;
+    FeVariable			*rowVar, *colVar;
+    FeMesh				*colMesh;
+    FeEquationNumber		*colEqNum;
+    DofLayout			*colDofs;
+    StiffnessMatrix_AddTargets	targets;
+    Mat                             matrix;
+    Vec				vector, transVector;
+    int nColNodeDofs;
+    unsigned			n_i, dof_i;
+
+    assert( self && Stg_CheckType( self, StiffnessMatrix ) );
+
+    rowVar = self->rowVariable;
+    colVar = self->columnVariable ? self->columnVariable : rowVar;
+    colEqNum = self->colEqNum;
+    colMesh = colVar->feMesh;
+    colDofs = colVar->dofLayout;
+    assert( (rowVar == colVar) ? !self->transRHS : 1 );
 
-        /* Add to stiffness matrix. */
-        MatSetValues( matrix,
-                      nRowDofs, (int*)rowEqNum->locationMatrix[e_i][0],
-                      nColDofs, (int*)colEqNum->locationMatrix[e_i][0],
-                      elStiffMat[0], ADD_VALUES );
+    /* A matrix-free operator is applied later, with whatever SLE and context it was last assembled with,
+       so only its BC corrections are assembled here. */
+    if( self->matrixFree ) {
+        self->matrixFreeData->sle = sle;
+        self->matrixFreeData->context = _context;
     }
+    matrix = self->matrixFree ? PETSC_NULL : self->matrix;
+    vector = self->rhs ? self->rhs->vector : NULL;
+    transVector = self->transRHS ? self->transRHS->vector : NULL;
 
-    FreeArray( elStiffMat );
-    FreeArray( bcVals );
+    targets.matrix = matrix;
+    targets.vector = vector;
+    targets.transVector = transVector;
+    if( matrix || vector || transVector )
+        _StiffnessMatrix_ForEachElement( self, sle, _context, False, _StiffnessMatrix_AddBatchElement, &targets );
 
     /* If keeping BCs in and rows and columnns use the same variable, put ones in all BC'd diagonals. */
-    if( !colEqNum->removeBCs && rowVar == colVar ) {
+    if( matrix && !colEqNum->removeBCs && rowVar == colVar ) {
         for( n_i = 0; n_i < FeMesh_GetNodeLocalSize( colMesh ); n_i++ ) {
             nColNodeDofs = colDofs->dofCounts[n_i];
             for( dof_i = 0; dof_i < nColNodeDofs; dof_i++ ) {
@@ -728,8 +1006,10 @@ void __StiffnessMatrix_NewAssemble( void* stiffnessMatrix, void* _sle, void* _co
     }
 
     /* Reassemble the matrix and vectors. */
-    MatAssemblyBegin( matrix, MAT_FINAL_ASSEMBLY );
-    MatAssemblyEnd( matrix, MAT_FINAL_ASSEMBLY );
+    if( matrix ) {
+        MatAssemblyBegin( matrix, MAT_FINAL_ASSEMBLY );
+        MatAssemblyEnd( matrix, MAT_FINAL_ASSEMBLY );
+    }
     if( vector ) {
         VecAssemblyBegin( vector );
         VecAssemblyEnd( vector );
@@ -738,9 +1018,126 @@ void __StiffnessMatrix_NewAssemble( void* stiffnessMatrix, void* _sle, void* _co
         VecAssemblyBegin( transVector );
         VecAssemblyEnd( transVector );
     }
+}
+
+/* Brings the non-zero pattern up to date with the equation numbering, returning whether the matrix needs to be
+   recreated. */
+static Bool _StiffnessMatrix_UpdateStructure( StiffnessMatrix* self ) {
+    FeEquationNumber* rowEqNum = self->rowEqNum;
+    FeEquationNumber* colEqNum = self->colEqNum;
+
+    if( rowEqNum->version != self->rowEqNumVersion || colEqNum->version != self->colEqNumVersion ) {
+        self->rowLocalSize = rowEqNum->localEqNumsOwnedCount;
+        self->colLocalSize = colEqNum->localEqNumsOwnedCount;
+        FreeArray( self->diagonalNonZeroIndices );
+        FreeArray( self->offDiagonalNonZeroIndices );
+        self->diagonalNonZeroIndices = NULL;
+        self->offDiagonalNonZeroIndices = NULL;
+        StiffnessMatrix_CalcNonZeros( self );
+        self->bcElementsValid = False;
+        return True;
+    }
+
+    return !self->reuseStructure || self->matrixFree || self->matrix == PETSC_NULL;
+}
+
+/* Whether either mesh has been deformed since the values were assembled, on any process. */
+static Bool _StiffnessMatrix_GeometryChanged( StiffnessMatrix* self ) {
+    FeVariable* colVar = self->columnVariable ? self->columnVariable : self->rowVariable;
+    int         localChanged, changed;
+
+    localChanged = ( self->rowVariable->feMesh->deformVersion != self->rowDeformVersion ||
+                     colVar->feMesh->deformVersion != self->colDeformVersion );
+    (void)MPI_Allreduce( &localChanged, &changed, 1, MPI_INT, MPI_LOR, self->comm );
+
+    return changed ? True : False;
+}
+
+static Bool _StiffnessMatrix_ElementHasBC( FeVariable* var, unsigned e_i, IArray* inc ) {
+    int      nNodes, *nodes;
+    unsigned n_i, dof_i;
+
+    FeMesh_GetElementNodes( var->feMesh, e_i, inc );
+    nNodes = IArray_GetSize( inc );
+    nodes = IArray_GetPtr( inc );
+    for( n_i = 0; n_i < nNodes; n_i++ ) {
+        for( dof_i = 0; dof_i < var->dofLayout->dofCounts[nodes[n_i]]; dof_i++ ) {
+            if( FeVariable_IsBC( var, nodes[n_i], dof_i ) )
+                return True;
+        }
+    }
+    return False;
+}
+
+/* Lists the local elements with a BC on any of their row or column dofs. BCs are fixed by the equation
+   numbering, so the list is kept until that is rebuilt. */
+static void _StiffnessMatrix_BuildBCElements( StiffnessMatrix* self ) {
+    FeVariable* rowVar = self->rowVariable;
+    FeVariable* colVar = self->columnVariable ? self->columnVariable : rowVar;
+    unsigned    nElements = FeMesh_GetElementLocalSize( rowVar->feMesh );
+    unsigned    e_i;
+
+    FreeArray( self->bcElements );
+    self->bcElements = AllocArray( unsigned, nElements ? nElements : 1 );
+    self->nBcElements = 0;
+    for( e_i = 0; e_i < nElements; e_i++ ) {
+        if( _StiffnessMatrix_ElementHasBC( rowVar, e_i, self->rowInc ) ||
+            ( colVar != rowVar && _StiffnessMatrix_ElementHasBC( colVar, e_i, self->colInc ) ) )
+        {
+            self->bcElements[self->nBcElements++] = e_i;
+        }
+    }
+    self->bcElementsValid = True;
+}
+
+/* Adds the right hand side BC corrections of an operator whose values are being reused. Only the elements
+   with BCs contribute, and the matrix itself is untouched. */
+static void _StiffnessMatrix_AssembleBCCorrections( StiffnessMatrix* self, SystemLinearEquations* sle, void* _context ) {
+    StiffnessMatrix_AddTargets targets;
+
+    targets.matrix = PETSC_NULL;
+    targets.vector = self->rhs ? self->rhs->vector : NULL;
+    targets.transVector = self->transRHS ? self->transRHS->vector : NULL;
+    if( !targets.vector && !targets.transVector )
+        return;
+
+    if( !self->bcElementsValid )
+        _StiffnessMatrix_BuildBCElements( self );
+    _StiffnessMatrix_ForEachElementOf( self, sle, _context, False, self->bcElements, self->nBcElements,
+                                       _StiffnessMatrix_AddBatchElement, &targets );
+
+    if( targets.vector ) {
+        VecAssemblyBegin( targets.vector );
+        VecAssemblyEnd( targets.vector );
+    }
+    if( targets.transVector ) {
+        VecAssemblyBegin( targets.transVector );
+        VecAssemblyEnd( targets.transVector );
+    }
+}
+
+unsigned StiffnessMatrix_GetStructureCount( void* stiffnessMatrix ) {
+    return ((StiffnessMatrix*)stiffnessMatrix)->structureCount;
+}
+
+unsigned StiffnessMatrix_GetAssemblyCount( void* stiffnessMatrix ) {
+    return ((StiffnessMatrix*)stiffnessMatrix)->assemblyCount;
+}
+
+unsigned StiffnessMatrix_GetReuseCount( void* stiffnessMatrix ) {
+    return ((StiffnessMatrix*)stiffnessMatrix)->reuseCount;
+}
+
+void StiffnessMatrix_ResetStats( void* stiffnessMatrix ) {
+    StiffnessMatrix* self = (StiffnessMatrix*)stiffnessMatrix;
+
+    self->structureCount = 0;
+    self->assemblyCount = 0;
+    self->reuseCount = 0;
+}
 
-    MatAssemblyBegin( matrix, MAT_FINAL_ASSEMBLY );
-    MatAssemblyEnd( matrix, MAT_FINAL_ASSEMBLY );
+void StiffnessMatrix_SetValuesModified( void* stiffnessMatrix ) {
+    ((StiffnessMatrix*)stiffnessMatrix)->valuesModified = True;
 }
 
 /* +++ PRIVATE FUNCTIONS +++ */
@@ -822,7 +1219,8 @@ void StiffnessMatrix_AddStiffnessMatrixTerm( void* stiffnessMatrix, void* stiffn
 
 void StiffnessMatrix_RefreshMatrix( StiffnessMatrix* self ) {
 	/*@
-		StiffnessMatrix_RefreshMatrix - creates, or recreates if preexisting, the PETSC AIJ matrix for the StiffnessMatrix.
+		StiffnessMatrix_RefreshMatrix - creates, or recreates if preexisting, the PETSC AIJ matrix for the StiffnessMatrix,
+		or its MATSHELL if the StiffnessMatrix is matrix-free.
 
 		The appropriate size and non-zero structure for the matrix is taken from the precalculated StiffnessMatrix data structure
 	@*/
@@ -832,6 +1230,13 @@ void StiffnessMatrix_RefreshMatrix( StiffnessMatrix* self ) {
 
     if( self->matrix != PETSC_NULL )
         Stg_MatDestroy(&self->matrix );
+    self->valuesAssembled = False;
+    self->structureCount++;
+
+    if( self->matrixFree ) {
+        _StiffnessMatrix_CreateMatrixFree( self );
+        return;
+    }
 
     MatCreate( self->comm, &self->matrix );
     MatSetSizes( self->matrix, self->rowLocalSize, self->colLocalSize, PETSC_DETERMINE, PETSC_DETERMINE );
@@ -942,9 +1347,534 @@ void StiffnessMatrix_CalcNonZeros( void* stiffnessMatrix ) {
     }
     self->diagonalNonZeroIndices = nDiagNonZeros;
     self->offDiagonalNonZeroIndices = nOffDiagNonZeros;
+    self->rowEqNumVersion = rowEqNum->version;
+    self->colEqNumVersion = colEqNum->version;
 
     Stream_UnIndent( stream );
     Stream_UnIndent( stream );
 
     Stg_Class_Delete( candColEqs );
 }
+
+/* +++ Matrix-free operator +++ */
+
+typedef struct {
+    double*   x;          /* domain values the element matrices are applied to */
+    double*   y;          /* domain values the results are added to */
+    Bool      transpose;
+    int*      rowInds;
+    unsigned  rowSize;
+    int*      colInds;
+    unsigned  colSize;
+} StiffnessMatrix_Product;
+
+typedef struct {
+    Mat        P;         /* sequential copy of the prolongation rows of every domain dof */
+    PetscInt*  rows;      /* sorted fine equation numbers of those rows */
+    PetscInt   nRows;
+    Mat        coarse;
+    PetscInt*  cols;      /* coarse columns touched by the current element */
+    unsigned   colSize;
+    double*    Pe;        /* element prolongation */
+    double*    KP;
+    double*    Ac;
+    unsigned   workSize;
+    unsigned   AcSize;
+} StiffnessMatrix_Galerkin;
+
+/* Sets up the domain values of a variable, and the scatter filling them from a global vector. */
+static void _StiffnessMatrix_MatrixFreeLayout( FeVariable* var, FeEquationNumber* eqNum, Vec global,
+                                               int** offsets, Vec* local, VecScatter* scatter )
+{
+    DofLayout* dofs = var->dofLayout;
+    unsigned   nNodes = FeMesh_GetNodeDomainSize( var->feMesh );
+    PetscInt   *from, *to;
+    IS         isFrom, isTo;
+    int        nValues, nEqs, eq;
+    unsigned   n_i, dof_i;
+
+    *offsets = Memory_Alloc_Array( int, nNodes + 1, "StiffnessMatrix_offsets" );
+    nValues = 0;
+    for( n_i = 0; n_i < nNodes; n_i++ ) {
+        (*offsets)[n_i] = nValues;
+        nValues += dofs->dofCounts[n_i];
+    }
+    (*offsets)[nNodes] = nValues;
+
+    /* Removed BCs have no equation, so their values are left at zero. */
+    from = Memory_Alloc_Array( PetscInt, nValues + 1, "StiffnessMatrix_from" );
+    to = Memory_Alloc_Array( PetscInt, nValues + 1, "StiffnessMatrix_to" );
+    nEqs = 0;
+    for( n_i = 0; n_i < nNodes; n_i++ ) {
+        for( dof_i = 0; dof_i < dofs->dofCounts[n_i]; dof_i++ ) {
+            eq = eqNum->mapNodeDof2Eq[n_i][dof_i];
+            if( eq == -1 ) continue;
+            from[nEqs] = eq;
+            to[nEqs] = (*offsets)[n_i] + dof_i;
+            nEqs++;
+        }
+    }
+
+    VecCreate( PETSC_COMM_SELF, local );
+    VecSetSizes( *local, PETSC_DECIDE, nValues );
+    VecSetFromOptions( *local );
+
+    ISCreateGeneralWithArray( PETSC_COMM_SELF, nEqs, from, &isFrom );
+    ISCreateGeneralWithArray( PETSC_COMM_SELF, nEqs, to, &isTo );
+    VecScatterCreate( global, isFrom, *local, isTo, scatter );
+    Stg_ISDestroy( &isFrom );
+    Stg_ISDestroy( &isTo );
+    Memory_Free( from );
+    Memory_Free( to );
+}
+
+/* Lists the domain values of an element's dofs, in element matrix order. */
+static void _StiffnessMatrix_ElementValues( FeVariable* var, unsigned e_i, IArray* inc, const int* offsets,
+                                             int** inds, unsigned* size )
+{
+    int      nNodes, *nodes;
+    unsigned nDofs, n_i, dof_i;
+
+    FeMesh_GetElementNodes( var->feMesh, e_i, inc );
+    nNodes = IArray_GetSize( inc );
+    nodes = IArray_GetPtr( inc );
+    nDofs = 0;
+    for( n_i = 0; n_i < nNodes; n_i++ )
+        nDofs += var->dofLayout->dofCounts[nodes[n_i]];
+    if( nDofs > *size ) {
+        *inds = ReallocArray( *inds, int, nDofs );
+        *size = nDofs;
+    }
+
+    nDofs = 0;
+    for( n_i = 0; n_i < nNodes; n_i++ ) {
+        for( dof_i = 0; dof_i < var->dofLayout->dofCounts[nodes[n_i]]; dof_i++ )
+            (*inds)[nDofs++] = offsets[nodes[n_i]] + dof_i;
+    }
+}
+
+static void _StiffnessMatrix_ProductElementValues( StiffnessMatrix* self, unsigned e_i, StiffnessMatrix_Product* product ) {
+    FeVariable* colVar = self->columnVariable ? self->columnVariable : self->rowVariable;
+
+    _StiffnessMatrix_ElementValues( self->rowVariable, e_i, self->rowInc, self->matrixFreeData->rowOffsets,
+                                    &product->rowInds, &product->rowSize );
+    _StiffnessMatrix_ElementValues( colVar, e_i, self->colInc, self->matrixFreeData->colOffsets,
+                                    &product->colInds, &product->colSize );
+}
+
+static void _StiffnessMatrix_MultBatchElement( StiffnessMatrix* self, StiffnessMatrix_Batch* batch, unsigned e_i, unsigned slot, void* data ) {
+    StiffnessMatrix_Product*      product = (StiffnessMatrix_Product*)data;
+    StiffnessMatrix_BatchElement* element = batch->elements + slot;
+    unsigned                      nRowDofs = element->nRowDofs, nColDofs = element->nColDofs;
+    const double*                 mat;
+    double                        sum, xr;
+    unsigned                      r_i, c_i;
+
+    _StiffnessMatrix_ProductElementValues( self, e_i, product );
+    for( r_i = 0; r_i < nRowDofs; r_i++ ) {
+        mat = batch->mats + element->matOffset + r_i * nColDofs;
+        if( product->transpose ) {
+            xr = product->x[product->rowInds[r_i]];
+            for( c_i = 0; c_i < nColDofs; c_i++ )
+                product->y[product->colInds[c_i]] += mat[c_i] * xr;
+        }
+        else {
+            sum = 0.0;
+            for( c_i = 0; c_i < nColDofs; c_i++ )
+                sum += mat[c_i] * product->x[product->colInds[c_i]];
+            product->y[product->rowInds[r_i]] += sum;
+        }
+    }
+}
+
+static void _StiffnessMatrix_DiagonalBatchElement( StiffnessMatrix* self, StiffnessMatrix_Batch* batch, unsigned e_i, unsigned slot, void* data ) {
+    StiffnessMatrix_Product*      product = (StiffnessMatrix_Product*)data;
+    StiffnessMatrix_BatchElement* element = batch->elements + slot;
+    unsigned                      r_i;
+
+    _StiffnessMatrix_ProductElementValues( self, e_i, product );
+    for( r_i = 0; r_i < element->nRowDofs; r_i++ )
+        product->y[product->rowInds[r_i]] += batch->mats[element->matOffset + r_i * element->nColDofs + r_i];
+}
+
+/* Sums the magnitudes of the element entries by row, or by column if transposed. */
+static void _StiffnessMatrix_AbsSumBatchElement( StiffnessMatrix* self, StiffnessMatrix_Batch* batch, unsigned e_i, unsigned slot, void* data ) {
+    StiffnessMatrix_Product*      product = (StiffnessMatrix_Product*)data;
+    StiffnessMatrix_BatchElement* element = batch->elements + slot;
+    const double*                 mat;
+    unsigned                      r_i, c_i;
+
+    _StiffnessMatrix_ProductElementValues( self, e_i, product );
+    for( r_i = 0; r_i < element->nRowDofs; r_i++ ) {
+        mat = batch->mats + element->matOffset + r_i * element->nColDofs;
+        for( c_i = 0; c_i < element->nColDofs; c_i++ ) {
+            if( product->transpose )
+                product->y[product->colInds[c_i]] += fabs( mat[c_i] );
+            else
+                product->y[product->rowInds[r_i]] += fabs( mat[c_i] );
+        }
+    }
+}
+
+/* Applies the unit diagonal entries of kept BCs, as added on assembly. With no "x", ones are added. */
+static void _StiffnessMatrix_MatrixFreeBCDiagonal( StiffnessMatrix* self, const double* x, double* y ) {
+    FeVariable* rowVar = self->rowVariable;
+    FeVariable* colVar = self->columnVariable ? self->columnVariable : rowVar;
+    unsigned    n_i, dof_i;
+    int         ind;
+
+    if( self->colEqNum->removeBCs || rowVar != colVar )
+        return;
+
+    for( n_i = 0; n_i < FeMesh_GetNodeLocalSize( colVar->feMesh ); n_i++ ) {
+        for( dof_i = 0; dof_i < colVar->dofLayout->dofCounts[n_i]; dof_i++ ) {
+            if( FeVariable_IsBC( colVar, n_i, dof_i ) ) {
+                ind = self->matrixFreeData->colOffsets[n_i] + dof_i;
+                y[ind] += x ? x[ind] : 1.0;
+            }
+        }
+    }
+}
+
+/* Runs "func" over all elements, adding into the row (or column, if transposed) domain values, which
+   are then summed into "result". If "x" is given, it is first gathered into the other domain values. */
+static void _StiffnessMatrix_MatrixFreeApply( StiffnessMatrix* self, Vec x, Vec result, Bool transpose,
+                                              StiffnessMatrix_BatchElementFunc* func )
+{
+    StiffnessMatrix_MatrixFree* data = self->matrixFreeData;
+    StiffnessMatrix_Product     product;
+    Vec                         in = transpose ? data->rowLocal : data->colLocal;
+    Vec                         out = transpose ? data->colLocal : data->rowLocal;
+    VecScatter                  inScatter = transpose ? data->rowScatter : data->colScatter;
+    VecScatter                  outScatter = transpose ? data->colScatter : data->rowScatter;
+
+    Journal_Firewall( data->sle != NULL, Journal_Register( Error_Type, (Name)self->type  ),
+                      "Error in func %s: matrix-free \"%s\" was applied before being assembled.\n", __func__, self->name );
+
+    memset( &product, 0, sizeof(StiffnessMatrix_Product) );
+    product.transpose = transpose;
+    if( x ) {
+        VecSet( in, 0.0 );
+        VecScatterBegin( inScatter, x, in, INSERT_VALUES, SCATTER_FORWARD );
+        VecScatterEnd( inScatter, x, in, INSERT_VALUES, SCATTER_FORWARD );
+        VecGetArray( in, &product.x );
+    }
+    VecSet( out, 0.0 );
+    VecGetArray( out, &product.y );
+
+    _StiffnessMatrix_ForEachElement( self, data->sle, data->context, True, func, &product );
+    _StiffnessMatrix_MatrixFreeBCDiagonal( self, product.x, product.y );
+
+    VecRestoreArray( out, &product.y );
+    if( x )
+        VecRestoreArray( in, &product.x );
+    FreeArray( product.rowInds );
+    FreeArray( product.colInds );
+
+    VecSet( result, 0.0 );
+    VecScatterBegin( outScatter, out, result, ADD_VALUES, SCATTER_REVERSE );
+    VecScatterEnd( outScatter, out, result, ADD_VALUES, SCATTER_REVERSE );
+}
+
+static PetscErrorCode _StiffnessMatrix_MatrixFreeMult( Mat A, Vec x, Vec y ) {
+    StiffnessMatrix* self;
+
+    MatShellGetContext( A, (void**)&self );
+    _StiffnessMatrix_MatrixFreeApply( self, x, y, False, _StiffnessMatrix_MultBatchElement );
+    return 0;
+}
+
+static PetscErrorCode _StiffnessMatrix_MatrixFreeMultTranspose( Mat A, Vec x, Vec y ) {
+    StiffnessMatrix* self;
+
+    MatShellGetContext( A, (void**)&self );
+    _StiffnessMatrix_MatrixFreeApply( self, x, y, True, _StiffnessMatrix_MultBatchElement );
+    return 0;
+}
+
+static PetscErrorCode _StiffnessMatrix_MatrixFreeGetDiagonal( Mat A, Vec diag ) {
+    StiffnessMatrix* self;
+
+    MatShellGetContext( A, (void**)&self );
+    _StiffnessMatrix_MatrixFreeApply( self, NULL, diag, False, _StiffnessMatrix_DiagonalBatchElement );
+    return 0;
+}
+
+/* Entries are only ever summed from element contributions, so the summed element magnitudes bound the
+   infinity and one norms from above. These are used for scaling, where a bound serves. */
+static PetscErrorCode _StiffnessMatrix_MatrixFreeNorm( Mat A, NormType type, PetscReal* norm ) {
+    StiffnessMatrix* self;
+    Vec              left, right;
+
+    if( type != NORM_INFINITY && type != NORM_1 )
+        Stg_SETERRQ( PETSC_ERR_SUP, "Only NORM_1 and NORM_INFINITY are available for matrix-free StiffnessMatrix operators" );
+
+    MatShellGetContext( A, (void**)&self );
+    MatGetVecs( A, &right, &left );
+    _StiffnessMatrix_MatrixFreeApply( self, NULL, (type == NORM_1) ? right : left, (Bool)(type == NORM_1),
+                                      _StiffnessMatrix_AbsSumBatchElement );
+    VecMax( (type == NORM_1) ? right : left, PETSC_NULL, norm );
+    Stg_VecDestroy( &left );
+    Stg_VecDestroy( &right );
+    return 0;
+}
+
+static void _StiffnessMatrix_CreateMatrixFree( StiffnessMatrix* self ) {
+    FeVariable* rowVar = self->rowVariable;
+    FeVariable* colVar = self->columnVariable ? self->columnVariable : rowVar;
+    Vec         rowVec, colVec;
+
+    /* Keep the SLE and context, should the operator be refreshed without being reassembled. */
+    if( !self->matrixFreeData ) {
+        self->matrixFreeData = Memory_Alloc( StiffnessMatrix_MatrixFree, "StiffnessMatrix_MatrixFree" );
+        memset( self->matrixFreeData, 0, sizeof(StiffnessMatrix_MatrixFree) );
+    }
+    else {
+        SystemLinearEquations* sle = self->matrixFreeData->sle;
+        void*                  context = self->matrixFreeData->context;
+
+        _StiffnessMatrix_DestroyMatrixFree( self );
+        self->matrixFreeData = Memory_Alloc( StiffnessMatrix_MatrixFree, "StiffnessMatrix_MatrixFree" );
+        memset( self->matrixFreeData, 0, sizeof(StiffnessMatrix_MatrixFree) );
+        self->matrixFreeData->sle = sle;
+        self->matrixFreeData->context = context;
+    }
+
+    MatCreateShell( self->comm, self->rowLocalSize, self->colLocalSize, PETSC_DETERMINE, PETSC_DETERMINE, self, &self->matrix );
+    MatShellSetOperation( self->matrix, MATOP_MULT, (void(*)(void))_StiffnessMatrix_MatrixFreeMult );
+    MatShellSetOperation( self->matrix, MATOP_MULT_TRANSPOSE, (void(*)(void))_StiffnessMatrix_MatrixFreeMultTranspose );
+    MatShellSetOperation( self->matrix, MATOP_NORM, (void(*)(void))_StiffnessMatrix_MatrixFreeNorm );
+    if( rowVar == colVar )
+        MatShellSetOperation( self->matrix, MATOP_GET_DIAGONAL, (void(*)(void))_StiffnessMatrix_MatrixFreeGetDiagonal );
+
+    MatGetVecs( self->matrix, &colVec, &rowVec );
+    _StiffnessMatrix_MatrixFreeLayout( rowVar, self->rowEqNum, rowVec, &self->matrixFreeData->rowOffsets,
+                                       &self->matrixFreeData->rowLocal, &self->matrixFreeData->rowScatter );
+    _StiffnessMatrix_MatrixFreeLayout( colVar, self->colEqNum, colVec, &self->matrixFreeData->colOffsets,
+                                       &self->matrixFreeData->colLocal, &self->matrixFreeData->colScatter );
+    Stg_VecDestroy( &rowVec );
+    Stg_VecDestroy( &colVec );
+}
+
+static void _StiffnessMatrix_DestroyMatrixFree( StiffnessMatrix* self ) {
+    StiffnessMatrix_MatrixFree* data = self->matrixFreeData;
+
+    if( !data )
+        return;
+
+    FreeArray( data->rowOffsets );
+    FreeArray( data->colOffsets );
+    if( data->rowLocal )
+        Stg_VecDestroy( &data->rowLocal );
+    if( data->colLocal )
+        Stg_VecDestroy( &data->colLocal );
+    if( data->rowScatter )
+        Stg_VecScatterDestroy( &data->rowScatter );
+    if( data->colScatter )
+        Stg_VecScatterDestroy( &data->colScatter );
+    Memory_Free( data );
+    self->matrixFreeData = NULL;
+}
+
+StiffnessMatrix* StiffnessMatrix_GetMatrixFreeOwner( Mat matrix ) {
+    void      (*mult)(void) = NULL;
+    PetscTruth isShell = PETSC_FALSE;
+    void*      owner = NULL;
+
+    if( !matrix )
+        return NULL;
+
+    Stg_PetscObjectTypeCompare( (PetscObject)matrix, MATSHELL, &isShell );
+    if( !isShell )
+        return NULL;
+
+    /* Only our shells apply our multiply. */
+    MatShellGetOperation( matrix, MATOP_MULT, &mult );
+    if( mult != (void(*)(void))_StiffnessMatrix_MatrixFreeMult )
+        return NULL;
+
+    MatShellGetContext( matrix, (void**)&owner );
+    return (StiffnessMatrix*)owner;
+}
+
+static PetscInt _StiffnessMatrix_GalerkinRow( StiffnessMatrix_Galerkin* galerkin, int eq ) {
+    PetscInt row;
+
+    if( eq == -1 )
+        return -1;
+    PetscFindInt( eq, galerkin->nRows, galerkin->rows, &row );
+    return row;
+}
+
+/* Adds Pe^T Ke Pe to the coarse operator, where Pe holds the prolongation rows of the element's dofs. */
+static void _StiffnessMatrix_GalerkinBatchElement( StiffnessMatrix* self, StiffnessMatrix_Batch* batch, unsigned e_i, unsigned slot, void* data ) {
+    StiffnessMatrix_Galerkin*     galerkin = (StiffnessMatrix_Galerkin*)data;
+    StiffnessMatrix_BatchElement* element = batch->elements + slot;
+    const double*                 mat = batch->mats + element->matOffset;
+    int*                          eqs = (int*)self->rowEqNum->locationMatrix[e_i][0];
+    unsigned                      nDofs = element->nRowDofs;
+    const PetscInt*               cols;
+    const PetscScalar*            vals;
+    PetscInt                      row, nz, z_i;
+    unsigned                      nCols, r_i, c_i, k_i;
+    double                        sum;
+
+    /* Collect the coarse columns the element's dofs are prolongated from. */
+    nCols = 0;
+    for( r_i = 0; r_i < nDofs; r_i++ ) {
+        if( (row = _StiffnessMatrix_GalerkinRow( galerkin, eqs[r_i] )) < 0 ) continue;
+        MatGetRow( galerkin->P, row, &nz, &cols, PETSC_NULL );
+        for( z_i = 0; z_i < nz; z_i++ ) {
+            for( c_i = 0; c_i < nCols; c_i++ )
+                if( galerkin->cols[c_i] == cols[z_i] ) break;
+            if( c_i < nCols ) continue;
+            if( nCols == galerkin->colSize ) {
+                galerkin->colSize = galerkin->colSize ? 2 * galerkin->colSize : 64;
+                galerkin->cols = ReallocArray( galerkin->cols, PetscInt, galerkin->colSize );
+            }
+            galerkin->cols[nCols++] = cols[z_i];
+        }
+        MatRestoreRow( galerkin->P, row, &nz, &cols, PETSC_NULL );
+    }
+    if( !nCols )
+        return;
+
+    if( nDofs * nCols > galerkin->workSize ) {
+        galerkin->workSize = nDofs * nCols;
+        galerkin->Pe = ReallocArray( galerkin->Pe, double, galerkin->workSize );
+        galerkin->KP = ReallocArray( galerkin->KP, double, galerkin->workSize );
+    }
+    if( nCols * nCols > galerkin->AcSize ) {
+        galerkin->AcSize = nCols * nCols;
+        galerkin->Ac = ReallocArray( galerkin->Ac, double, galerkin->AcSize );
+    }
+
+    memset( galerkin->Pe, 0, nDofs * nCols * sizeof(double) );
+    for( r_i = 0; r_i < nDofs; r_i++ ) {
+        if( (row = _StiffnessMatrix_GalerkinRow( galerkin, eqs[r_i] )) < 0 ) continue;
+        MatGetRow( galerkin->P, row, &nz, &cols, &vals );
+        for( z_i = 0; z_i < nz; z_i++ ) {
+            for( c_i = 0; galerkin->cols[c_i] != cols[z_i]; c_i++ );
+            galerkin->Pe[r_i * nCols + c_i] = vals[z_i];
+        }
+        MatRestoreRow( galerkin->P, row, &nz, &cols, &vals );
+    }
+
+    for( r_i = 0; r_i < nDofs; r_i++ ) {
+        for( c_i = 0; c_i < nCols; c_i++ ) {
+            sum = 0.0;
+            for( k_i = 0; k_i < nDofs; k_i++ )
+                sum += mat[r_i * nDofs + k_i] * galerkin->Pe[k_i * nCols + c_i];
+            galerkin->KP[r_i * nCols + c_i] = sum;
+        }
+    }
+    for( r_i = 0; r_i < nCols; r_i++ ) {
+        for( c_i = 0; c_i < nCols; c_i++ ) {
+            sum = 0.0;
+            for( k_i = 0; k_i < nDofs; k_i++ )
+                sum += galerkin->Pe[k_i * nCols + r_i] * galerkin->KP[k_i * nCols + c_i];
+            galerkin->Ac[r_i * nCols + c_i] = sum;
+        }
+    }
+
+    MatSetValues( galerkin->coarse, nCols, galerkin->cols, nCols, galerkin->cols, galerkin->Ac, ADD_VALUES );
+}
+
+void StiffnessMatrix_AssembleGalerkin( void* stiffnessMatrix, Mat P, MatReuse reuse, Mat* coarse ) {
+    StiffnessMatrix*            self = (StiffnessMatrix*)stiffnessMatrix;
+    StiffnessMatrix_MatrixFree* data = self->matrixFreeData;
+    FeVariable*                 var = self->rowVariable;
+    FeEquationNumber*           eqNum = self->rowEqNum;
+    StiffnessMatrix_Galerkin    galerkin;
+    IS                          isRow, isCol;
+    Mat*                        sub;
+    const PetscInt*             cols;
+    const PetscScalar*          vals;
+    PetscInt                    nCoarse, nLocalCoarse, maxNonZeros, row, nz, z_i, z_j;
+    unsigned                    nNodes, n_i, dof_i;
+    int                         eq, r_i;
+
+    assert( self && Stg_CheckType( self, StiffnessMatrix ) );
+    Journal_Firewall( data && (!self->columnVariable || self->columnVariable == var) && self->colEqNum == eqNum,
+                      Journal_Register( Error_Type, (Name)self->type  ),
+                      "Error in func %s: \"%s\" must be a square matrix-free operator.\n", __func__, self->name );
+    Journal_Firewall( data->sle != NULL, Journal_Register( Error_Type, (Name)self->type  ),
+                      "Error in func %s: matrix-free \"%s\" was applied before being assembled.\n", __func__, self->name );
+
+    memset( &galerkin, 0, sizeof(StiffnessMatrix_Galerkin) );
+
+    /* Fetch the prolongation rows of all domain dofs, including those owned elsewhere. */
+    nNodes = FeMesh_GetNodeDomainSize( var->feMesh );
+    galerkin.rows = Memory_Alloc_Array( PetscInt, data->rowOffsets[nNodes] + 1, "StiffnessMatrix_rows" );
+    for( n_i = 0; n_i < nNodes; n_i++ ) {
+        for( dof_i = 0; dof_i < var->dofLayout->dofCounts[n_i]; dof_i++ ) {
+            if( (eq = eqNum->mapNodeDof2Eq[n_i][dof_i]) != -1 )
+                galerkin.rows[galerkin.nRows++] = eq;
+        }
+    }
+    PetscSortRemoveDupsInt( &galerkin.nRows, galerkin.rows );
+
+    MatGetSize( P, PETSC_NULL, &nCoarse );
+    ISCreateGeneralWithArray( PETSC_COMM_SELF, galerkin.nRows, galerkin.rows, &isRow );
+    ISCreateStride( PETSC_COMM_SELF, nCoarse, 0, 1, &isCol );
+    MatCreateSubMatrices( P, 1, &isRow, &isCol, MAT_INITIAL_MATRIX, &sub );
+    galerkin.P = sub[0];
+
+    /* The coarse stencil is no wider, in coarse dofs, than the fine one. */
+    if( reuse == MAT_INITIAL_MATRIX ) {
+        maxNonZeros = 0;
+        for( r_i = 0; r_i < self->rowLocalSize; r_i++ ) {
+            if( self->diagonalNonZeroIndices[r_i] + self->offDiagonalNonZeroIndices[r_i] > maxNonZeros )
+                maxNonZeros = self->diagonalNonZeroIndices[r_i] + self->offDiagonalNonZeroIndices[r_i];
+        }
+        MPI_Allreduce( MPI_IN_PLACE, &maxNonZeros, 1, MPIU_INT, MPI_MAX, self->comm );
+
+        MatGetLocalSize( P, PETSC_NULL, &nLocalCoarse );
+        MatCreate( self->comm, coarse );
+        MatSetSizes( *coarse, nLocalCoarse, nLocalCoarse, PETSC_DETERMINE, PETSC_DETERMINE );
+        MatSetType( *coarse, MATAIJ );
+        MatSeqAIJSetPreallocation( *coarse, maxNonZeros, PETSC_NULL );
+        MatMPIAIJSetPreallocation( *coarse, maxNonZeros, PETSC_NULL, maxNonZeros, PETSC_NULL );
+#if ( (PETSC_VERSION_MAJOR>=3) && (PETSC_VERSION_MINOR>=3) )
+        MatSetOption( *coarse, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE );
+#endif
+    }
+    else
+        MatZeroEntries( *coarse );
+    galerkin.coarse = *coarse;
+
+    _StiffnessMatrix_ForEachElement( self, data->sle, data->context, True, _StiffnessMatrix_GalerkinBatchElement, &galerkin );
+
+    /* Kept BCs have unit diagonals, contributing the outer product of their prolongation rows. */
+    if( !eqNum->removeBCs ) {
+        for( n_i = 0; n_i < FeMesh_GetNodeLocalSize( var->feMesh ); n_i++ ) {
+            for( dof_i = 0; dof_i < var->dofLayout->dofCounts[n_i]; dof_i++ ) {
+                if( !FeVariable_IsBC( var, n_i, dof_i ) ) continue;
+                if( (row = _StiffnessMatrix_GalerkinRow( &galerkin, eqNum->mapNodeDof2Eq[n_i][dof_i] )) < 0 ) continue;
+                MatGetRow( galerkin.P, row, &nz, &cols, &vals );
+                if( nz * nz > galerkin.AcSize ) {
+                    galerkin.AcSize = nz * nz;
+                    galerkin.Ac = ReallocArray( galerkin.Ac, double, galerkin.AcSize );
+                }
+                for( z_i = 0; z_i < nz; z_i++ ) {
+                    for( z_j = 0; z_j < nz; z_j++ )
+                        galerkin.Ac[z_i * nz + z_j] = vals[z_i] * vals[z_j];
+                }
+                MatSetValues( galerkin.coarse, nz, cols, nz, cols, galerkin.Ac, ADD_VALUES );
+                MatRestoreRow( galerkin.P, row, &nz, &cols, &vals );
+            }
+        }
+    }
+
+    MatAssemblyBegin( *coarse, MAT_FINAL_ASSEMBLY );
+    MatAssemblyEnd( *coarse, MAT_FINAL_ASSEMBLY );
+
+    MatDestroySubMatrices( 1, &sub );
+    Stg_ISDestroy( &isRow );
+    Stg_ISDestroy( &isCol );
+    Memory_Free( galerkin.rows );
+    FreeArray( galerkin.cols );
+    FreeArray( galerkin.Pe );
+    FreeArray( galerkin.KP );
+    FreeArray( galerkin.Ac );
+}
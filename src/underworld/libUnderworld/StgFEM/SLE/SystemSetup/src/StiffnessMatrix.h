@@ -66,6 +66,32 @@
 									                  \
 		IArray* rowInc;	                \
 		IArray* colInc;                 \
+		/* Opt-in thread parallel element assembly (requires HAVE_OPENMP, and thread safe terms) */ \
+		Bool    threadedAssembly;       \
+		/* Opt-in matrix-free application; "matrix" is then a MATSHELL applied element by element */ \
+		Bool                        matrixFree;    \
+		StiffnessMatrix_MatrixFree* matrixFreeData; \
+		/* Keep the PETSc matrix and its non-zero pattern between assemblies, zeroing only its values. It is \
+		   recreated when either equation numbering is rebuilt (FeEquationNumber::version). */ \
+		Bool                        reuseStructure;   \
+		unsigned                    rowEqNumVersion;  \
+		unsigned                    colEqNumVersion;  \
+		/* Values depend only on the mesh geometry (not on changing functions), so are only reassembled once \
+		   the mesh is deformed (Mesh::deformVersion). Right hand side BC corrections are still redone, over \
+		   the elements with BCs only. */ \
+		Bool                        assembleOnce;     \
+		Bool                        valuesAssembled;  \
+		/* Values were changed in place outside assembly (for example scaled and unscaled by a solver), \
+		   so must be reassembled rather than reused. */ \
+		Bool                        valuesModified;   \
+		unsigned                    rowDeformVersion; \
+		unsigned                    colDeformVersion; \
+		unsigned*                   bcElements;       \
+		unsigned                    nBcElements;      \
+		Bool                        bcElementsValid;  \
+		unsigned                    structureCount;   \
+		unsigned                    assemblyCount;    \
+		unsigned                    reuseCount;       \
 
 	struct StiffnessMatrix { __StiffnessMatrix };
 
@@ -194,4 +220,23 @@
 
 	void StiffnessMatrix_CalcNonZeros( void* stiffnessMatrix );
 
+	/** Number of times the PETSc matrix was created, its values assembled, and its values reused (see
+	    assembleOnce), since creation or the last reset. */
+	unsigned StiffnessMatrix_GetStructureCount( void* stiffnessMatrix );
+	unsigned StiffnessMatrix_GetAssemblyCount( void* stiffnessMatrix );
+	unsigned StiffnessMatrix_GetReuseCount( void* stiffnessMatrix );
+	void StiffnessMatrix_ResetStats( void* stiffnessMatrix );
+
+	/** Marks the values as changed in place outside assembly, so the next assembly does not reuse them
+	    even where assembleOnce is set. Must be called on every process. */
+	void StiffnessMatrix_SetValuesModified( void* stiffnessMatrix );
+
+	/** Returns the StiffnessMatrix whose matrix-free operator is "matrix", or NULL if "matrix" is not
+	    a matrix-free StiffnessMatrix operator. */
+	StiffnessMatrix* StiffnessMatrix_GetMatrixFreeOwner( Mat matrix );
+
+	/** Assembles the Galerkin coarse operator P^T A P of a matrix-free StiffnessMatrix one element at a
+	    time, without forming A. "reuse" follows MatPtAP. */
+	void StiffnessMatrix_AssembleGalerkin( void* stiffnessMatrix, Mat P, MatReuse reuse, Mat* coarse );
+
 #endif /* __StgFEM_SLE_SystemSetup_StiffnessMatrix_h__ */
@@ -57,6 +57,8 @@ StiffnessMatrixTerm* _StiffnessMatrixTerm_New(  STIFFNESSMATRIXTERM_DEFARGS  )
 	self = (StiffnessMatrixTerm*)_Stg_Component_New(  STG_COMPONENT_PASSARGS  );
 
 	self->_assembleElement = _assembleElement;
+	/* Children which support threaded assembly set this after construction */
+	self->threadSafe = False;
 	
 	return self;
 }
@@ -40,7 +40,9 @@
 		/* Data for GNx storage */ \
 	  double                   **GNx; /* store globalDerivative ptr here */ \
 	  double                   *N; /* store array for shape functions here */ \
-		int                      max_nElNodes;  /* holds the maxNumNodes per element */ 
+		int                      max_nElNodes;  /* holds the maxNumNodes per element */ \
+		/* True where _assembleElement may be called concurrently for different elements */ \
+		Bool                     threadSafe;
 	
 	struct StiffnessMatrixTerm { __StiffnessMatrixTerm };
 	
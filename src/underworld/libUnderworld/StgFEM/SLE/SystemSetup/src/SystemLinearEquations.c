@@ -159,6 +159,9 @@ void _SystemLinearEquations_Init(
    self->nonLinearMinIterations    = nonLinearMinIterations;
    self->curResidual               = 0.0;
    self->curSolveTime              = 0.0;
+   self->nonLinearAndersonDepth    = 0;
+   self->nonLinearAndersonRestarts = 0;
+   self->nonLinearWallTime         = 0.0;
                                 /* _  /0 */
    optionsName = Memory_Alloc_Array_Unnamed( char, strlen(optionsPrefix) + 1 + 1 );
    sprintf( optionsName, "%s_", optionsPrefix );
@@ -379,6 +382,8 @@ void _SystemLinearEquations_AssignFromXML( void* sle, Stg_ComponentFactory* cf,
       entryPointRegister,
       MPI_COMM_WORLD );
 
+   self->nonLinearAndersonDepth = Stg_ComponentFactory_GetUnsignedInt( cf, self->name, (Dictionary_Entry_Key)"nonLinearAndersonDepth", 0  );
+
    VecCreate( self->comm, &self->X );
    VecCreate( self->comm, &self->F );
    MatCreate( self->comm, &self->A );
@@ -744,6 +749,208 @@ void SystemLinearEquations_NewtonMFFDExecute( void* sle, void* _context ) {
    // call non linear solver func (SNES wrapper)
 }
 
+/*
+** Anderson acceleration of the non linear iterations. Each Picard iteration is treated as a fixed point map
+** g = G(x), and the next iterate is the combination of the latest outputs which minimises the linearised
+** residual f = g - x over the last 'depth' iterations. The least squares problem is solved through its (small)
+** normal equations, with each solution vector weighted by its norm so velocity and pressure contribute equally.
+*/
+typedef struct {
+   unsigned       depth;
+   unsigned       nBlocks;
+   unsigned       nHist;
+   unsigned       next;
+   Bool           havePrev;
+   Vec*           x;     /* [block] iterate passed to the linear solve */
+   Vec*           f;     /* [block] g - x */
+   Vec*           gPrev; /* [block] */
+   Vec*           fPrev; /* [block] */
+   Vec*           dG;    /* [block * depth + slot] differences of successive g */
+   Vec*           dF;    /* [block * depth + slot] differences of successive f */
+   PetscScalar*   gram;
+   PetscScalar*   rhs;
+   PetscScalar*   dots;
+} SystemLinearEquations_Anderson;
+
+static void _SystemLinearEquations_AndersonCreate( SystemLinearEquations* self, SystemLinearEquations_Anderson* aa ) {
+   unsigned block_I, slot_I;
+   Vec      vector;
+
+   aa->depth = self->nonLinearAndersonDepth;
+   aa->nBlocks = self->solutionVectors->count;
+   aa->nHist = 0;
+   aa->next = 0;
+   aa->havePrev = False;
+   aa->x = Memory_Alloc_Array( Vec, aa->nBlocks, "SystemLinearEquations_Anderson" );
+   aa->f = Memory_Alloc_Array( Vec, aa->nBlocks, "SystemLinearEquations_Anderson" );
+   aa->gPrev = Memory_Alloc_Array( Vec, aa->nBlocks, "SystemLinearEquations_Anderson" );
+   aa->fPrev = Memory_Alloc_Array( Vec, aa->nBlocks, "SystemLinearEquations_Anderson" );
+   aa->dG = Memory_Alloc_Array( Vec, aa->nBlocks * aa->depth, "SystemLinearEquations_Anderson" );
+   aa->dF = Memory_Alloc_Array( Vec, aa->nBlocks * aa->depth, "SystemLinearEquations_Anderson" );
+   aa->gram = Memory_Alloc_Array( PetscScalar, aa->depth * aa->depth, "SystemLinearEquations_Anderson" );
+   aa->rhs = Memory_Alloc_Array( PetscScalar, aa->depth, "SystemLinearEquations_Anderson" );
+   aa->dots = Memory_Alloc_Array( PetscScalar, aa->depth, "SystemLinearEquations_Anderson" );
+
+   for( block_I = 0; block_I < aa->nBlocks; block_I++ ) {
+      vector = SystemLinearEquations_GetSolutionVectorAt( self, block_I )->vector;
+      VecDuplicate( vector, &aa->x[block_I] );
+      VecDuplicate( vector, &aa->f[block_I] );
+      VecDuplicate( vector, &aa->gPrev[block_I] );
+      VecDuplicate( vector, &aa->fPrev[block_I] );
+      for( slot_I = 0; slot_I < aa->depth; slot_I++ ) {
+         VecDuplicate( vector, &aa->dG[block_I * aa->depth + slot_I] );
+         VecDuplicate( vector, &aa->dF[block_I * aa->depth + slot_I] );
+      }
+   }
+}
+
+static void _SystemLinearEquations_AndersonDestroy( SystemLinearEquations_Anderson* aa ) {
+   unsigned ii;
+
+   for( ii = 0; ii < aa->nBlocks; ii++ ) {
+      Stg_VecDestroy( &aa->x[ii] );
+      Stg_VecDestroy( &aa->f[ii] );
+      Stg_VecDestroy( &aa->gPrev[ii] );
+      Stg_VecDestroy( &aa->fPrev[ii] );
+   }
+   for( ii = 0; ii < aa->nBlocks * aa->depth; ii++ ) {
+      Stg_VecDestroy( &aa->dG[ii] );
+      Stg_VecDestroy( &aa->dF[ii] );
+   }
+   Memory_Free( aa->x );
+   Memory_Free( aa->f );
+   Memory_Free( aa->gPrev );
+   Memory_Free( aa->fPrev );
+   Memory_Free( aa->dG );
+   Memory_Free( aa->dF );
+   Memory_Free( aa->gram );
+   Memory_Free( aa->rhs );
+   Memory_Free( aa->dots );
+}
+
+/* Discards the history, so the next iteration is a plain Picard step. */
+static void _SystemLinearEquations_AndersonRestart( SystemLinearEquations_Anderson* aa ) {
+   aa->nHist = 0;
+   aa->next = 0;
+   aa->havePrev = False;
+}
+
+/* Records the iterate about to be passed to the linear solve. */
+static void _SystemLinearEquations_AndersonStore( SystemLinearEquations* self, SystemLinearEquations_Anderson* aa ) {
+   unsigned block_I;
+
+   for( block_I = 0; block_I < aa->nBlocks; block_I++ )
+      VecCopy( SystemLinearEquations_GetSolutionVectorAt( self, block_I )->vector, aa->x[block_I] );
+}
+
+/* Solves the n x n system in place by Gaussian elimination with partial pivoting, returning False if it is
+   numerically singular. The solution is returned in 'rhs'. */
+static Bool _SystemLinearEquations_AndersonSolve( PetscScalar* mat, PetscScalar* rhs, unsigned n ) {
+   PetscScalar tmp, factor;
+   double      maxDiag = 0.0;
+   unsigned    ii, jj, kk, pivot;
+
+   for( ii = 0; ii < n; ii++ )
+      maxDiag = PetscMax( maxDiag, PetscAbsScalar( mat[ii * n + ii] ) );
+   if( maxDiag == 0.0 )
+      return False;
+
+   for( kk = 0; kk < n; kk++ ) {
+      pivot = kk;
+      for( ii = kk + 1; ii < n; ii++ ) {
+         if( PetscAbsScalar( mat[ii * n + kk] ) > PetscAbsScalar( mat[pivot * n + kk] ) )
+            pivot = ii;
+      }
+      if( PetscAbsScalar( mat[pivot * n + kk] ) <= 1.0e-14 * maxDiag )
+         return False;
+      if( pivot != kk ) {
+         for( jj = 0; jj < n; jj++ ) {
+            tmp = mat[kk * n + jj]; mat[kk * n + jj] = mat[pivot * n + jj]; mat[pivot * n + jj] = tmp;
+         }
+         tmp = rhs[kk]; rhs[kk] = rhs[pivot]; rhs[pivot] = tmp;
+      }
+      for( ii = kk + 1; ii < n; ii++ ) {
+         factor = mat[ii * n + kk] / mat[kk * n + kk];
+         for( jj = kk; jj < n; jj++ )
+            mat[ii * n + jj] -= factor * mat[kk * n + jj];
+         rhs[ii] -= factor * rhs[kk];
+      }
+   }
+   for( kk = n; kk-- > 0; ) {
+      for( jj = kk + 1; jj < n; jj++ )
+         rhs[kk] -= mat[kk * n + jj] * rhs[jj];
+      rhs[kk] /= mat[kk * n + kk];
+   }
+   return True;
+}
+
+/* Replaces the solution vectors (the latest g) with the accelerated iterate, and updates the nodes. */
+static void _SystemLinearEquations_AndersonMix( SystemLinearEquations* self, SystemLinearEquations_Anderson* aa, void* _context ) {
+   unsigned    block_I, ii, jj, nHist;
+   Vec         g;
+   PetscReal   gNorm;
+   double      weight, trace;
+
+   /* Update the history with the differences from the previous iteration. */
+   for( block_I = 0; block_I < aa->nBlocks; block_I++ ) {
+      g = SystemLinearEquations_GetSolutionVectorAt( self, block_I )->vector;
+      VecWAXPY( aa->f[block_I], -1.0, aa->x[block_I], g );
+      if( aa->havePrev ) {
+         VecWAXPY( aa->dF[block_I * aa->depth + aa->next], -1.0, aa->fPrev[block_I], aa->f[block_I] );
+         VecWAXPY( aa->dG[block_I * aa->depth + aa->next], -1.0, aa->gPrev[block_I], g );
+      }
+      VecCopy( aa->f[block_I], aa->fPrev[block_I] );
+      VecCopy( g, aa->gPrev[block_I] );
+   }
+   if( aa->havePrev ) {
+      aa->next = ( aa->next + 1 ) % aa->depth;
+      if( aa->nHist < aa->depth )
+         aa->nHist++;
+   }
+   aa->havePrev = True;
+
+   nHist = aa->nHist;
+   if( nHist == 0 )
+      return;
+
+   /* Weighted normal equations of min |f - dF gamma|. */
+   memset( aa->gram, 0, nHist * nHist * sizeof(PetscScalar) );
+   memset( aa->rhs, 0, nHist * sizeof(PetscScalar) );
+   for( block_I = 0; block_I < aa->nBlocks; block_I++ ) {
+      g = SystemLinearEquations_GetSolutionVectorAt( self, block_I )->vector;
+      VecNorm( g, NORM_2, &gNorm );
+      weight = ( gNorm > 0.0 ) ? 1.0 / ( (double)gNorm * (double)gNorm ) : 1.0;
+      for( ii = 0; ii < nHist; ii++ ) {
+         VecMDot( aa->dF[block_I * aa->depth + ii], nHist, aa->dF + block_I * aa->depth, aa->dots );
+         for( jj = 0; jj < nHist; jj++ )
+            aa->gram[ii * nHist + jj] += weight * aa->dots[jj];
+      }
+      VecMDot( aa->f[block_I], nHist, aa->dF + block_I * aa->depth, aa->dots );
+      for( ii = 0; ii < nHist; ii++ )
+         aa->rhs[ii] += weight * aa->dots[ii];
+   }
+   trace = 0.0;
+   for( ii = 0; ii < nHist; ii++ )
+      trace += PetscRealPart( aa->gram[ii * nHist + ii] );
+   for( ii = 0; ii < nHist; ii++ )
+      aa->gram[ii * nHist + ii] += 1.0e-12 * trace / nHist;
+
+   if( !_SystemLinearEquations_AndersonSolve( aa->gram, aa->rhs, nHist ) ) {
+      _SystemLinearEquations_AndersonRestart( aa );
+      self->nonLinearAndersonRestarts++;
+      return;
+   }
+
+   /* x = g - dG gamma */
+   for( ii = 0; ii < nHist; ii++ )
+      aa->rhs[ii] = -aa->rhs[ii];
+   for( block_I = 0; block_I < aa->nBlocks; block_I++ ) {
+      g = SystemLinearEquations_GetSolutionVectorAt( self, block_I )->vector;
+      VecMAXPY( g, nHist, aa->rhs, aa->dG + block_I * aa->depth );
+   }
+   self->_updateSolutionOntoNodes( self, _context );
+}
+
 void SystemLinearEquations_NonLinearExecute( void* sle, void* _context ) {
    SystemLinearEquations*   self            = (SystemLinearEquations*) sle;
    Vec                     previousVector;
@@ -756,6 +963,10 @@ void SystemLinearEquations_NonLinearExecute( void* sle, void* _context ) {
    double                  wallTime;
    Iteration_Index         minIterations   = self->nonLinearMinIterations;
    SLE_Solver*             solver;
+   Bool                    accelerate      = ( self->nonLinearAndersonDepth > 0 );
+   SystemLinearEquations_Anderson anderson;
+   double                  prevResidual    = 0.0;
+   Index                   block_I;
 
    PetscScalar      currVecNorm, prevVecNorm;
 
@@ -795,6 +1006,7 @@ void SystemLinearEquations_NonLinearExecute( void* sle, void* _context ) {
 //   }
 
    self->nonLinearIteration_I = 0;
+   self->nonLinearAndersonRestarts = 0;
    Journal_Printf(self->info,"\nNon linear solver - iteration %d\n", self->nonLinearIteration_I);
 
         /* More of Luke's stuff. I need an entry point for a non-linear setup operation. */
@@ -818,6 +1030,8 @@ void SystemLinearEquations_NonLinearExecute( void* sle, void* _context ) {
    /* TODO - Give option which solution vector to test */
    currentVector   = SystemLinearEquations_GetSolutionVectorAt( self, 0 )->vector;
    VecDuplicate( currentVector, &previousVector );
+   if( accelerate )
+      _SystemLinearEquations_AndersonCreate( self, &anderson );
 
    for ( self->nonLinearIteration_I = 1 ; self->nonLinearIteration_I < maxIterations ; self->nonLinearIteration_I++ ) {
       /* get initial wall time for nonlinear loop */
@@ -840,10 +1054,17 @@ void SystemLinearEquations_NonLinearExecute( void* sle, void* _context ) {
 
       //Vector_CopyEntries( currentVector, previousVector );
       VecCopy( currentVector, previousVector );
+      if( accelerate )
+         _SystemLinearEquations_AndersonStore( self, &anderson );
 
       Journal_Printf(self->info,"Non linear solver - iteration %d\n", self->nonLinearIteration_I);
 
       self->linearExecute( self, _context );
+      /* The post solve callback may have modified the fields, so take the accelerated step from those. */
+      if( accelerate ) {
+         for( block_I = 0; block_I < self->solutionVectors->count; block_I++ )
+            SolutionVector_LoadCurrentFeVariableValuesOntoVector( SystemLinearEquations_GetSolutionVectorAt( self, block_I ) );
+      }
 //      PetscPrintf( PETSC_COMM_WORLD, "|Xn+1| = %12.12e \n", Vector_L2Norm(SystemLinearEquations_GetSolutionVectorAt(self,1)->vector) );
 
       /* Calculate Residual */
@@ -897,6 +1118,17 @@ void SystemLinearEquations_NonLinearExecute( void* sle, void* _context ) {
          if( result )
             break;
       }
+
+      /* Accelerate, unless this was the last iteration (which should leave a solved state). A growing residual
+         indicates the history no longer describes the problem, so it is discarded. */
+      if( accelerate && self->nonLinearIteration_I + 1 < maxIterations ) {
+         if( self->nonLinearIteration_I > 1 && residual > prevResidual ) {
+            _SystemLinearEquations_AndersonRestart( &anderson );
+            self->nonLinearAndersonRestarts++;
+         }
+         _SystemLinearEquations_AndersonMix( self, &anderson, _context );
+      }
+      prevResidual = residual;
    }
 
    /* Print Info */
@@ -915,6 +1147,9 @@ void SystemLinearEquations_NonLinearExecute( void* sle, void* _context ) {
    Stream_UnIndentBranch( StgFEM_Debug );
 
    Stg_VecDestroy(&previousVector );
+   if( accelerate )
+      _SystemLinearEquations_AndersonDestroy( &anderson );
+   self->nonLinearWallTime = MPI_Wtime() - wallTime;
 
    /*Set all the printout variables */
         if( solver->totalnumnonlinearits ) {
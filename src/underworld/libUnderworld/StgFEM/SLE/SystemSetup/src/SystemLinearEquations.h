@@ -70,6 +70,10 @@
 		Iteration_Index												nonLinearMinIterations; \
 		double															curResidual; \
 		double															curSolveTime; \
+		/* Anderson acceleration of the non linear (Picard) iterations. A depth of zero disables it. */ \
+		unsigned															nonLinearAndersonDepth; \
+		unsigned															nonLinearAndersonRestarts; \
+		double															nonLinearWallTime; \
 		/* BEGIN LUKE'S FRICTIONAL BCS BIT */ \
 		char*																nlSetupEPName; \
 		EntryPoint*														nlSetupEP; \
@@ -15,6 +15,7 @@
 	typedef struct FeEntryPoint                 FeEntryPoint;
 	typedef struct StiffnessMatrix              StiffnessMatrix;
 	typedef struct StiffnessMatrixTerm          StiffnessMatrixTerm;
+	typedef struct StiffnessMatrix_MatrixFree   StiffnessMatrix_MatrixFree;
 	typedef struct ForceVector                  ForceVector;
 	typedef struct ForceTerm                    ForceTerm;
 	typedef struct SolutionVector               SolutionVector;
@@ -133,6 +133,8 @@ void _IrregularMeshParticleLayout_InitialiseParticles( void* particleLayout, voi
 	Swarm*			swarm = (Swarm*)_swarm;
 	Cell_Index		cell_I;
 	Particle_InCellIndex	cellParticle_I;
+
+	Swarm_ReleaseCellTables( swarm );
 	
 	/* Allocate a guess at the particle size to prevent a TONNE of unnecessary
 	   reallocation. */
@@ -12,6 +12,7 @@
 #include "FunctionIO.hpp"
 #include "Function.hpp"
 #include "Binary.hpp"
+#include "Compiler.hpp"
 
 Fn::Binary::Binary( Function *fn1, Function *fn2 )
 { _fn[0] = fn1; _fn[1]=fn2;};
@@ -291,3 +292,251 @@ Fn::Max::func Fn::Max::getFunction( IOsptr sample_input )
 }
 
 
+
+// Batched evaluation.  Where possible the first operand is evaluated directly
+// into the output buffer, and the second operand into a scratch buffer, with
+// the operation then applied in place.
+void Fn::Binary::initGetBlockFunction( IOsptr sample_input, unsigned (&size)[2], blockfunc (&_blockfunc)[2] )
+{
+    const IO_double* doubleio[2];
+    func _func[2];
+    // use point-wise setup to perform all type checking
+    initGetFunction( sample_input, doubleio, _func );
+    for (unsigned ii=0; ii<2; ii++) {
+        size[ii]       = doubleio[ii]->size();
+        _blockfunc[ii] = _fn[ii]->getBlockFunction( sample_input );
+    }
+}
+
+Fn::Add::blockfunc Fn::Add::getBlockFunction( IOsptr sample_input )
+{
+    unsigned size[2];
+    blockfunc _blockfunc[2];
+    initGetBlockFunction( sample_input, size, _blockfunc );
+
+    if (size[0] != size[1])
+        throw std::invalid_argument(_pyfnerrorheader+"Added functions must return identical sized objects.");
+
+    auto _scratch = std::make_shared<std::vector<double>>();
+    unsigned vsize = size[0];
+    return [_blockfunc, _scratch, vsize](const InputBlock& block, double* output, std::size_t stride) {
+        std::size_t count = block.size();
+        if (_scratch->size() < count*vsize)
+            _scratch->resize(count*vsize);
+        double* io2 = _scratch->data();
+        _blockfunc[0](block, output, stride);
+        _blockfunc[1](block, io2,    vsize );
+
+        for (std::size_t ii=0; ii<count; ii++)
+            for (unsigned jj=0; jj<vsize; jj++)
+                output[ii*stride+jj] += io2[ii*vsize+jj];
+    };
+}
+
+Fn::Subtract::blockfunc Fn::Subtract::getBlockFunction( IOsptr sample_input )
+{
+    unsigned size[2];
+    blockfunc _blockfunc[2];
+    initGetBlockFunction( sample_input, size, _blockfunc );
+
+    if (size[0] != size[1])
+        throw std::invalid_argument(_pyfnerrorheader+"Subtracted functions must return identical sized objects.");
+
+    auto _scratch = std::make_shared<std::vector<double>>();
+    unsigned vsize = size[0];
+    return [_blockfunc, _scratch, vsize](const InputBlock& block, double* output, std::size_t stride) {
+        std::size_t count = block.size();
+        if (_scratch->size() < count*vsize)
+            _scratch->resize(count*vsize);
+        double* io2 = _scratch->data();
+        _blockfunc[0](block, output, stride);
+        _blockfunc[1](block, io2,    vsize );
+
+        for (std::size_t ii=0; ii<count; ii++)
+            for (unsigned jj=0; jj<vsize; jj++)
+                output[ii*stride+jj] -= io2[ii*vsize+jj];
+    };
+}
+
+Fn::Multiply::blockfunc Fn::Multiply::getBlockFunction( IOsptr sample_input )
+{
+    unsigned size[2];
+    blockfunc _blockfunc[2];
+    initGetBlockFunction( sample_input, size, _blockfunc );
+
+    unsigned _minGuy = size[0] < size[1] ? 0 : 1;
+    unsigned _maxGuy = size[0] > size[1] ? 0 : 1;
+    bool _identicalSize = ( _minGuy == _maxGuy );
+
+    if ( !_identicalSize && (size[_minGuy]!=1) )
+        throw std::invalid_argument(_pyfnerrorheader+"Function multiplication is only possible between functions of identical " \
+                                                     "size (for pointwise operation) or where one function is scalar.");
+
+    auto _scratch = std::make_shared<std::vector<double>>();
+    unsigned vsize = size[_maxGuy];
+    unsigned ssize = size[_minGuy];
+    // evaluate the larger operand into the output, and the (possibly scalar)
+    // smaller operand into scratch. for the identical case, _maxGuy is 1.
+    blockfunc _maxfunc = _blockfunc[_maxGuy];
+    blockfunc _minfunc = _blockfunc[_identicalSize ? 0 : _minGuy];
+    return [_maxfunc, _minfunc, _scratch, vsize, ssize](const InputBlock& block, double* output, std::size_t stride) {
+        std::size_t count = block.size();
+        if (_scratch->size() < count*ssize)
+            _scratch->resize(count*ssize);
+        double* io2 = _scratch->data();
+        _maxfunc(block, output, stride);
+        _minfunc(block, io2,    ssize );
+
+        if (ssize == vsize) {
+            for (std::size_t ii=0; ii<count; ii++)
+                for (unsigned jj=0; jj<vsize; jj++)
+                    output[ii*stride+jj] *= io2[ii*vsize+jj];
+        } else {
+            for (std::size_t ii=0; ii<count; ii++)
+                for (unsigned jj=0; jj<vsize; jj++)
+                    output[ii*stride+jj] *= io2[ii];
+        }
+    };
+}
+
+Fn::Divide::blockfunc Fn::Divide::getBlockFunction( IOsptr sample_input )
+{
+    unsigned size[2];
+    blockfunc _blockfunc[2];
+    initGetBlockFunction( sample_input, size, _blockfunc );
+
+    bool _identicalSize = size[0] == size[1];
+    if ( !_identicalSize && (size[1]!=1) )
+        throw std::invalid_argument(_pyfnerrorheader+"Function division is only possible between functions of identical " \
+                                                     "size (for pointwise operation) or where the denominator function returns scalars.");
+
+    auto _scratch = std::make_shared<std::vector<double>>();
+    unsigned vsize = size[0];
+    unsigned ssize = size[1];
+    return [_blockfunc, _scratch, vsize, ssize](const InputBlock& block, double* output, std::size_t stride) {
+        std::size_t count = block.size();
+        if (_scratch->size() < count*ssize)
+            _scratch->resize(count*ssize);
+        double* io2 = _scratch->data();
+        _blockfunc[0](block, output, stride);
+        _blockfunc[1](block, io2,    ssize );
+
+        if (ssize == vsize) {
+            for (std::size_t ii=0; ii<count; ii++)
+                for (unsigned jj=0; jj<vsize; jj++)
+                    output[ii*stride+jj] /= io2[ii*vsize+jj];
+        } else {
+            for (std::size_t ii=0; ii<count; ii++)
+                for (unsigned jj=0; jj<vsize; jj++)
+                    output[ii*stride+jj] /= io2[ii];
+        }
+    };
+}
+
+Fn::Dot::blockfunc Fn::Dot::getBlockFunction( IOsptr sample_input )
+{
+    unsigned size[2];
+    blockfunc _blockfunc[2];
+    initGetBlockFunction( sample_input, size, _blockfunc );
+
+    auto _scratch = std::make_shared<std::vector<double>>();
+    unsigned vsize = size[0];
+    return [_blockfunc, _scratch, vsize](const InputBlock& block, double* output, std::size_t stride) {
+        std::size_t count = block.size();
+        if (_scratch->size() < 2*count*vsize)
+            _scratch->resize(2*count*vsize);
+        double* io1 = _scratch->data();
+        double* io2 = _scratch->data() + count*vsize;
+        _blockfunc[0](block, io1, vsize);
+        _blockfunc[1](block, io2, vsize);
+
+        for (std::size_t ii=0; ii<count; ii++) {
+            double sum = 0.;
+            for (unsigned jj=0; jj<vsize; jj++)
+                sum += io1[ii*vsize+jj] * io2[ii*vsize+jj];
+            output[ii*stride] = sum;
+        }
+    };
+}
+
+Fn::Pow::blockfunc Fn::Pow::getBlockFunction( IOsptr sample_input )
+{
+    unsigned size[2];
+    blockfunc _blockfunc[2];
+    initGetBlockFunction( sample_input, size, _blockfunc );
+
+    if (size[1] != 1 )
+        throw std::invalid_argument(_pyfnerrorheader+"Power function exponent must be a scalar.");
+
+    auto _scratch = std::make_shared<std::vector<double>>();
+    unsigned vsize = size[0];
+    return [_blockfunc, _scratch, vsize](const InputBlock& block, double* output, std::size_t stride) {
+        std::size_t count = block.size();
+        if (_scratch->size() < count)
+            _scratch->resize(count);
+        double* power = _scratch->data();
+        _blockfunc[0](block, output, stride);
+        _blockfunc[1](block, power,  1     );
+
+        for (std::size_t ii=0; ii<count; ii++)
+            for (unsigned jj=0; jj<vsize; jj++)
+                output[ii*stride+jj] = std::pow( output[ii*stride+jj], power[ii] );
+    };
+}
+
+Fn::Min::blockfunc Fn::Min::getBlockFunction( IOsptr sample_input )
+{
+    unsigned size[2];
+    blockfunc _blockfunc[2];
+    initGetBlockFunction( sample_input, size, _blockfunc );
+
+    if ( (size[0]!=1) || (size[1]!=1) )
+        throw std::invalid_argument(_pyfnerrorheader+"Min function requires scalar inputs.");
+
+    auto _scratch = std::make_shared<std::vector<double>>();
+    return [_blockfunc, _scratch](const InputBlock& block, double* output, std::size_t stride) {
+        std::size_t count = block.size();
+        if (_scratch->size() < count)
+            _scratch->resize(count);
+        double* io2 = _scratch->data();
+        _blockfunc[0](block, output, stride);
+        _blockfunc[1](block, io2,    1     );
+
+        for (std::size_t ii=0; ii<count; ii++)
+            output[ii*stride] = std::fmin( output[ii*stride], io2[ii] );
+    };
+}
+
+Fn::Max::blockfunc Fn::Max::getBlockFunction( IOsptr sample_input )
+{
+    unsigned size[2];
+    blockfunc _blockfunc[2];
+    initGetBlockFunction( sample_input, size, _blockfunc );
+
+    if ( (size[0]!=1) || (size[1]!=1) )
+        throw std::invalid_argument(_pyfnerrorheader+"Max function requires scalar inputs.");
+
+    auto _scratch = std::make_shared<std::vector<double>>();
+    return [_blockfunc, _scratch](const InputBlock& block, double* output, std::size_t stride) {
+        std::size_t count = block.size();
+        if (_scratch->size() < count)
+            _scratch->resize(count);
+        double* io2 = _scratch->data();
+        _blockfunc[0](block, output, stride);
+        _blockfunc[1](block, io2,    1     );
+
+        for (std::size_t ii=0; ii<count; ii++)
+            output[ii*stride] = std::fmax( output[ii*stride], io2[ii] );
+    };
+}
+
+
+// Compilation. Operand checking is performed by the compiler.
+unsigned Fn::Add::compile( Compiler& compiler )      { return compiler.emitBinary( Compiler::OP_ADD,      _fn[0], _fn[1] ); }
+unsigned Fn::Subtract::compile( Compiler& compiler ) { return compiler.emitBinary( Compiler::OP_SUBTRACT, _fn[0], _fn[1] ); }
+unsigned Fn::Multiply::compile( Compiler& compiler ) { return compiler.emitBinary( Compiler::OP_MULTIPLY, _fn[0], _fn[1] ); }
+unsigned Fn::Divide::compile( Compiler& compiler )   { return compiler.emitBinary( Compiler::OP_DIVIDE,   _fn[0], _fn[1] ); }
+unsigned Fn::Dot::compile( Compiler& compiler )      { return compiler.emitBinary( Compiler::OP_DOT,      _fn[0], _fn[1] ); }
+unsigned Fn::Pow::compile( Compiler& compiler )      { return compiler.emitBinary( Compiler::OP_POW,      _fn[0], _fn[1] ); }
+unsigned Fn::Min::compile( Compiler& compiler )      { return compiler.emitBinary( Compiler::OP_MIN,      _fn[0], _fn[1] ); }
+unsigned Fn::Max::compile( Compiler& compiler )      { return compiler.emitBinary( Compiler::OP_MAX,      _fn[0], _fn[1] ); }
@@ -27,6 +27,9 @@ namespace Fn {
         protected:
             Function* _fn[2];
             void initGetFunction( IOsptr sample_input, const IO_double* doubleio[2], func (&_func)[2] );
+#if !defined(SWIG_DO_NOT_WRAP)
+            void initGetBlockFunction( IOsptr sample_input, unsigned (&size)[2], blockfunc (&_blockfunc)[2] );
+#endif
     };
 
     class Add: public Binary
@@ -34,6 +37,10 @@ namespace Fn {
         public:
             Add( Function *fn1, Function *fn2 ) : Binary( fn1, fn2) {};
             virtual func getFunction( IOsptr sample_input );
+#if !defined(SWIG_DO_NOT_WRAP)
+            virtual blockfunc getBlockFunction( IOsptr sample_input );
+            virtual unsigned compile( Compiler& compiler );
+#endif
             virtual ~Add(){};
     };
 
@@ -42,6 +49,10 @@ namespace Fn {
         public:
             Subtract( Function *fn1, Function *fn2 ) : Binary( fn1, fn2) {};
             virtual func getFunction( IOsptr sample_input );
+#if !defined(SWIG_DO_NOT_WRAP)
+            virtual blockfunc getBlockFunction( IOsptr sample_input );
+            virtual unsigned compile( Compiler& compiler );
+#endif
             virtual ~Subtract(){};
     };
 
@@ -50,6 +61,10 @@ namespace Fn {
         public:
             Multiply( Function *fn1, Function *fn2 ) : Binary( fn1, fn2) {};
             virtual func getFunction( IOsptr sample_input );
+#if !defined(SWIG_DO_NOT_WRAP)
+            virtual blockfunc getBlockFunction( IOsptr sample_input );
+            virtual unsigned compile( Compiler& compiler );
+#endif
             virtual ~Multiply(){};
     };
 
@@ -58,6 +73,10 @@ namespace Fn {
         public:
             Divide( Function *fn1, Function *fn2 ) : Binary( fn1, fn2) {};
             virtual func getFunction( IOsptr sample_input );
+#if !defined(SWIG_DO_NOT_WRAP)
+            virtual blockfunc getBlockFunction( IOsptr sample_input );
+            virtual unsigned compile( Compiler& compiler );
+#endif
             virtual ~Divide(){};
     };
 
@@ -66,6 +85,10 @@ namespace Fn {
         public:
             Dot( Function *fn1, Function *fn2 ) : Binary( fn1, fn2) {};
             virtual func getFunction( IOsptr sample_input );
+#if !defined(SWIG_DO_NOT_WRAP)
+            virtual blockfunc getBlockFunction( IOsptr sample_input );
+            virtual unsigned compile( Compiler& compiler );
+#endif
             virtual ~Dot(){};
     };
 
@@ -74,6 +97,10 @@ namespace Fn {
         public:
             Pow( Function *fn1, Function *fn2 ) : Binary( fn1, fn2) {};
             virtual func getFunction( IOsptr sample_input );
+#if !defined(SWIG_DO_NOT_WRAP)
+            virtual blockfunc getBlockFunction( IOsptr sample_input );
+            virtual unsigned compile( Compiler& compiler );
+#endif
             virtual ~Pow(){};
     };
 
@@ -82,6 +109,10 @@ namespace Fn {
         public:
             Min( Function *fn1, Function *fn2 ) : Binary( fn1, fn2) {};
             virtual func getFunction( IOsptr sample_input );
+#if !defined(SWIG_DO_NOT_WRAP)
+            virtual blockfunc getBlockFunction( IOsptr sample_input );
+            virtual unsigned compile( Compiler& compiler );
+#endif
             virtual ~Min(){};
     };
 
@@ -90,6 +121,10 @@ namespace Fn {
         public:
             Max( Function *fn1, Function *fn2 ) : Binary( fn1, fn2) {};
             virtual func getFunction( IOsptr sample_input );
+#if !defined(SWIG_DO_NOT_WRAP)
+            virtual blockfunc getBlockFunction( IOsptr sample_input );
+            virtual unsigned compile( Compiler& compiler );
+#endif
             virtual ~Max(){};
     };
 
@@ -0,0 +1,455 @@
+/*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*
+**                                                                                  **
+** This file forms part of the Underworld geophysics modelling application.         **
+**                                                                                  **
+** For full license and copyright information, please refer to the LICENSE.md file  **
+** located at the project root, or contact the authors.                             **
+**                                                                                  **
+**~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*/
+#include <cmath>
+#include <sstream>
+#include <algorithm>
+#include <mutex>
+
+#include "Constant.hpp"
+#include "Compiler.hpp"
+
+// by default, functions are treated as opaque operations
+unsigned Fn::Function::compile( Compiler& compiler )
+{
+    return compiler.emitOpaque( this );
+}
+
+
+/* element-wise operation kernel. literal operands have a zero point stride,
+   and scalar operands are broadcast via a zero component increment. */
+template <typename OP>
+static void _elementwise( OP op, std::size_t count, unsigned size,
+                          const double* a, std::size_t astride, unsigned ainc,
+                          const double* b, std::size_t bstride, unsigned binc,
+                          double* output )
+{
+    for (std::size_t ii=0; ii<count; ii++, a+=astride, b+=bstride, output+=size)
+        for (unsigned jj=0; jj<size; jj++)
+            output[jj] = op( a[jj*ainc], b[jj*binc] );
+}
+
+static unsigned _operandCount( Fn::Compiler::OpCode op )
+{
+    switch (op) {
+        case Fn::Compiler::OP_UNARY:
+        case Fn::Compiler::OP_AT:
+            return 1;
+        case Fn::Compiler::OP_OPAQUE:
+        case Fn::Compiler::OP_BRANCH:
+            return 0;
+        default:
+            return 2;
+    }
+}
+
+
+// compiled programs are private to the returned block function, but
+// rebuilding walks the shared function graph, so is serialised.
+static std::mutex _rebuildMutex;
+
+Fn::Function::blockfunc Fn::Compiler::compile( Function* fn, IOsptr sample_input )
+{
+    // setup the point-wise function first, so that any errors with the
+    // graph are reported exactly as they would be otherwise.
+    fn->getFunction( sample_input );
+
+    auto _program = std::make_shared< std::shared_ptr<Program> >( build( fn, sample_input ) );
+    return [fn, _program](const InputBlock& block, double* output, std::size_t stride) {
+        if (block.size() == 0)
+            return;
+        // constants have been modified since compilation, so rebuild
+        if ((*_program)->stale()) {
+            std::lock_guard<std::mutex> lock( _rebuildMutex );
+            *_program = build( fn, block.get(0) );
+        }
+        (*_program)->execute( block, output, stride );
+    };
+}
+
+std::shared_ptr<Fn::Program> Fn::Compiler::build( Function* fn, IOsptr sample_input )
+{
+    Compiler compiler( sample_input );
+    std::shared_ptr<Program> program;
+    try {
+        program = compiler.subprogram( fn );
+    } catch (const std::exception& e) {
+        // the graph cannot be compiled at this input (for example, where
+        // an opaque function cannot be evaluated at the sample input), so
+        // revert to the standard batched evaluation.
+        program = std::make_shared<Program>();
+        program->_fallback = fn->getBlockFunction( sample_input );
+        return program;
+    }
+    program->_dependencies = compiler._dependencies;
+    return program;
+}
+
+std::shared_ptr<Fn::Program> Fn::Compiler::subprogram( Function* fn )
+{
+    auto program = std::make_shared<Program>();
+    Program* parent = _program;
+    _program = program.get();
+    try {
+        program->_result = emit( fn );
+    } catch (...) {
+        _program = parent;
+        throw;
+    }
+    _program = parent;
+    finalise( program.get() );
+    return program;
+}
+
+void Fn::Compiler::finalise( Program* program )
+{
+    // remove instructions whose results are never used. these generally
+    // arise where branch conditions were found to be constant.
+    std::vector<bool> live( program->_register.size(), false );
+    live[program->_result] = true;
+    for (auto it=program->_code.rbegin(); it!=program->_code.rend(); ++it)
+        if (live[it->out])
+            for (unsigned ii=0; ii<_operandCount(it->op); ii++)
+                live[it->in[ii]] = true;
+    program->_code.erase( std::remove_if( program->_code.begin(), program->_code.end(),
+                                          [&live](const Instruction& instr){ return !live[instr.out]; } ),
+                          program->_code.end() );
+
+    // lookups no longer required
+    program->_memo.clear();
+    program->_valueNumber.clear();
+}
+
+unsigned Fn::Compiler::instruction( Instruction& instr, unsigned size )
+{
+    Program* program = _program;
+    unsigned noperands = _operandCount( instr.op );
+
+    // identical operations on identical operands need only be performed once
+    std::vector<std::uintptr_t> key;
+    if (noperands > 0) {
+        key = { (std::uintptr_t)instr.op, instr.in[0], noperands>1 ? instr.in[1] : 0,
+                reinterpret_cast<std::uintptr_t>(instr.unary),
+                reinterpret_cast<std::uintptr_t>(instr.relational),
+                instr.component };
+        auto it = program->_valueNumber.find( key );
+        if (it != program->_valueNumber.end())
+            return it->second;
+    }
+
+    Program::Register reg;
+    reg.size    = size;
+    reg.literal = false;
+    instr.out   = program->_register.size();
+    program->_register.push_back( reg );
+
+    // fold where all operands are known
+    bool fold = (noperands > 0);
+    for (unsigned ii=0; ii<noperands; ii++)
+        fold &= program->_register[instr.in[ii]].literal;
+    if (fold) {
+        Program::Register& out = program->_register[instr.out];
+        out.value.resize( size );
+        program->evaluate( instr, 1, out.value.data() );
+        out.literal = true;
+    } else {
+        program->_code.push_back( instr );
+    }
+
+    if (noperands > 0)
+        program->_valueNumber[key] = instr.out;
+    return instr.out;
+}
+
+unsigned Fn::Compiler::emit( Function* fn )
+{
+    auto it = _program->_memo.find( fn );
+    if (it != _program->_memo.end())
+        return it->second;
+    unsigned reg = fn->compile( *this );
+    _program->_memo[fn] = reg;
+    return reg;
+}
+
+unsigned Fn::Compiler::emitOpaque( Function* fn )
+{
+    // test evaluation for result size
+    Function::func _func = fn->getFunction( _sample_input );
+    unsigned outsize = _func( _sample_input )->size();
+
+    Instruction instr;
+    instr.op        = OP_OPAQUE;
+    instr.blockfunc = fn->getBlockFunction( _sample_input );
+    return instruction( instr, outsize );
+}
+
+unsigned Fn::Compiler::emitConstant( const Constant* fn, const FunctionIO* value, unsigned version )
+{
+    // record so that we can rebuild if the constant value changes
+    _dependencies.push_back( std::pair<const Constant*,unsigned>(fn, version) );
+
+    Program::Register reg;
+    reg.size    = value->size();
+    reg.literal = true;
+    reg.value.resize( reg.size );
+    for (unsigned ii=0; ii<reg.size; ii++)
+        reg.value[ii] = value->at<double>(ii);
+    _program->_register.push_back( reg );
+    return _program->_register.size()-1;
+}
+
+unsigned Fn::Compiler::emitBinary( OpCode op, Function* fn1, Function* fn2 )
+{
+    Instruction instr;
+    instr.op    = op;
+    instr.in[0] = emit( fn1 );
+    instr.in[1] = emit( fn2 );
+    unsigned size0 = size( instr.in[0] );
+    unsigned size1 = size( instr.in[1] );
+
+    bool valid;
+    unsigned outsize;
+    switch (op) {
+        case OP_ADD:
+        case OP_SUBTRACT:
+            valid   = (size0 == size1);
+            outsize = size0;
+            break;
+        case OP_MULTIPLY:
+            valid   = (size0 == size1) || (size0 == 1) || (size1 == 1);
+            outsize = std::max( size0, size1 );
+            break;
+        case OP_DIVIDE:
+            valid   = (size0 == size1) || (size1 == 1);
+            outsize = size0;
+            break;
+        case OP_DOT:
+            valid   = (size0 == size1);
+            outsize = 1;
+            break;
+        case OP_POW:
+            valid   = (size1 == 1);
+            outsize = size0;
+            break;
+        case OP_MIN:
+        case OP_MAX:
+            valid   = (size0 == 1) && (size1 == 1);
+            outsize = 1;
+            break;
+        default:
+            valid   = false;
+            outsize = 0;
+    }
+    if (!valid)
+        throw std::invalid_argument( "Unable to compile binary operation for operands of size " +
+                                     std::to_string(size0) + " and " + std::to_string(size1) + "." );
+    return instruction( instr, outsize );
+}
+
+unsigned Fn::Compiler::emitUnary( double (*F)( double ), Function* fn )
+{
+    Instruction instr;
+    instr.op    = OP_UNARY;
+    instr.unary = F;
+    instr.in[0] = emit( fn );
+    return instruction( instr, size( instr.in[0] ) );
+}
+
+unsigned Fn::Compiler::emitRelational( bool (*F)( double, double ), Function* fn1, Function* fn2 )
+{
+    Instruction instr;
+    instr.op         = OP_RELATIONAL;
+    instr.relational = F;
+    instr.in[0]      = emit( fn1 );
+    instr.in[1]      = emit( fn2 );
+    if (size( instr.in[0] ) != size( instr.in[1] ))
+        throw std::invalid_argument( "Unable to compile relational operation for operands of differing size." );
+    return instruction( instr, 1 );
+}
+
+unsigned Fn::Compiler::emitAt( Function* fn, unsigned component )
+{
+    Instruction instr;
+    instr.op        = OP_AT;
+    instr.component = component;
+    instr.in[0]     = emit( fn );
+    if (component >= size( instr.in[0] ))
+        throw std::invalid_argument( "Unable to compile component extraction, as component is out of range." );
+    return instruction( instr, 1 );
+}
+
+unsigned Fn::Compiler::emitBranch( selector select, const std::vector< std::shared_ptr<Program> >& branches, unsigned size )
+{
+    for (auto& program : branches)
+        if (program->size() != size)
+            throw std::invalid_argument( "Unable to compile branch, as branch results are of differing size." );
+    Instruction instr;
+    instr.op       = OP_BRANCH;
+    instr.select   = select;
+    instr.branches = branches;
+    return instruction( instr, size );
+}
+
+unsigned Fn::Compiler::size( unsigned reg ) const
+{
+    return _program->_register[reg].size;
+}
+
+bool Fn::Compiler::literal( unsigned reg, std::vector<double>& value ) const
+{
+    const Program::Register& regi = _program->_register[reg];
+    if (regi.literal)
+        value = regi.value;
+    return regi.literal;
+}
+
+
+bool Fn::Program::stale() const
+{
+    for (auto& dependency : _dependencies)
+        if (dependency.first->version() != dependency.second)
+            return true;
+    return false;
+}
+
+void Fn::Program::execute( const InputBlock& block, double* output, std::size_t stride )
+{
+    if (_fallback) {
+        _fallback( block, output, stride );
+        return;
+    }
+    std::size_t count = block.size();
+    if (count == 0)
+        return;
+
+    for (auto& instr : _code)
+    {
+        Register& reg = _register[instr.out];
+        if (reg.buffer.size() < count*reg.size)
+            reg.buffer.resize( count*reg.size );
+        switch (instr.op) {
+            case Compiler::OP_OPAQUE:
+                instr.blockfunc( block, reg.buffer.data(), reg.size );
+                break;
+            case Compiler::OP_BRANCH:
+                branch( instr, block, reg.buffer.data() );
+                break;
+            default:
+                evaluate( instr, count, reg.buffer.data() );
+        }
+    }
+
+    const Register& result = _register[_result];
+    const double* data = result.data();
+    std::size_t rstride = result.literal ? 0 : result.size;
+    for (std::size_t ii=0; ii<count; ii++)
+        std::copy( data + ii*rstride, data + ii*rstride + result.size, output + ii*stride );
+}
+
+void Fn::Program::evaluate( const Instruction& instr, std::size_t count, double* output ) const
+{
+    const Register& reg0 = _register[instr.in[0]];
+    const Register& reg1 = _register[ _operandCount(instr.op) > 1 ? instr.in[1] : instr.in[0] ];
+    const double* a = reg0.data();
+    const double* b = reg1.data();
+    std::size_t astride = reg0.literal ? 0 : reg0.size;
+    std::size_t bstride = reg1.literal ? 0 : reg1.size;
+    unsigned ainc = reg0.size == 1 ? 0 : 1;
+    unsigned binc = reg1.size == 1 ? 0 : 1;
+    unsigned size = _register[instr.out].size;
+
+    switch (instr.op) {
+        case Compiler::OP_ADD:
+            _elementwise( [](double x, double y){ return x + y; }, count, size, a, astride, ainc, b, bstride, binc, output );
+            break;
+        case Compiler::OP_SUBTRACT:
+            _elementwise( [](double x, double y){ return x - y; }, count, size, a, astride, ainc, b, bstride, binc, output );
+            break;
+        case Compiler::OP_MULTIPLY:
+            _elementwise( [](double x, double y){ return x * y; }, count, size, a, astride, ainc, b, bstride, binc, output );
+            break;
+        case Compiler::OP_DIVIDE:
+            _elementwise( [](double x, double y){ return x / y; }, count, size, a, astride, ainc, b, bstride, binc, output );
+            break;
+        case Compiler::OP_POW:
+            _elementwise( [](double x, double y){ return std::pow( x, y ); }, count, size, a, astride, ainc, b, bstride, binc, output );
+            break;
+        case Compiler::OP_MIN:
+            _elementwise( [](double x, double y){ return std::fmin( x, y ); }, count, size, a, astride, ainc, b, bstride, binc, output );
+            break;
+        case Compiler::OP_MAX:
+            _elementwise( [](double x, double y){ return std::fmax( x, y ); }, count, size, a, astride, ainc, b, bstride, binc, output );
+            break;
+        case Compiler::OP_DOT:
+            for (std::size_t ii=0; ii<count; ii++, a+=astride, b+=bstride) {
+                double sum = 0.;
+                for (unsigned jj=0; jj<reg0.size; jj++)
+                    sum += a[jj] * b[jj];
+                output[ii] = sum;
+            }
+            break;
+        case Compiler::OP_UNARY:
+            for (std::size_t ii=0; ii<count; ii++, a+=astride, output+=size)
+                for (unsigned jj=0; jj<size; jj++)
+                    output[jj] = instr.unary( a[jj] );
+            break;
+        case Compiler::OP_RELATIONAL:
+            // AND behaviour for vector objects, as per the point-wise version
+            for (std::size_t ii=0; ii<count; ii++, a+=astride, b+=bstride) {
+                bool result = true;
+                for (unsigned jj=0; jj<reg0.size && result; jj++)
+                    result = instr.relational( a[jj], b[jj] );
+                output[ii] = result ? 1. : 0.;
+            }
+            break;
+        case Compiler::OP_AT:
+            for (std::size_t ii=0; ii<count; ii++, a+=astride)
+                output[ii] = a[instr.component];
+            break;
+        default:
+            throw std::runtime_error( "Unexpected operation encountered in compiled function." );
+    }
+}
+
+void Fn::Program::branch( const Instruction& instr, const InputBlock& block, double* output )
+{
+    std::size_t count = block.size();
+    unsigned size = _register[instr.out].size;
+
+    // select branch for each input
+    _branchIndex.resize( count );
+    bool uniform = true;
+    for (std::size_t jj=0; jj<count; jj++) {
+        _branchIndex[jj] = instr.select( block.get(jj) );
+        uniform &= (_branchIndex[jj] == _branchIndex[0]);
+    }
+
+    if (uniform) {
+        instr.branches[_branchIndex[0]]->execute( block, output, size );
+        return;
+    }
+
+    // evaluate each selected branch over its own sub-block
+    for (unsigned ii=0; ii<instr.branches.size(); ii++)
+    {
+        _group.clear();
+        for (std::size_t jj=0; jj<count; jj++)
+            if (_branchIndex[jj] == ii)
+                _group.push_back(jj);
+        if (_group.size() == 0)
+            continue;
+        if (_scratch.size() < _group.size()*size)
+            _scratch.resize( _group.size()*size );
+        double* result = _scratch.data();
+        std::vector<std::size_t>& group = _group;
+        InputBlock subblock( group.size(), [&block,&group](std::size_t idx){ return block.get(group[idx]); } );
+        instr.branches[ii]->execute( subblock, result, size );
+        for (std::size_t jj=0; jj<group.size(); jj++)
+            std::copy( result + jj*size, result + (jj+1)*size, output + group[jj]*size );
+    }
+}
@@ -0,0 +1,129 @@
+/*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*
+**                                                                                  **
+** This file forms part of the Underworld geophysics modelling application.         **
+**                                                                                  **
+** For full license and copyright information, please refer to the LICENSE.md file  **
+** located at the project root, or contact the authors.                             **
+**                                                                                  **
+**~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*/
+
+#ifndef __Underworld_Function_Compiler_hpp__
+#define __Underworld_Function_Compiler_hpp__
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include "Function.hpp"
+
+namespace Fn {
+
+#if !defined(SWIG_DO_NOT_WRAP)
+    class Constant;
+    class Program;
+
+    // The compiler flattens a function graph into a register based program
+    // which is then evaluated over blocks of inputs. While compiling,
+    // repeated subexpressions are evaluated only once, expressions over
+    // constants are folded, and conditional/map branches which can never be
+    // taken are removed. Function classes describe themselves to the compiler
+    // via `Function::compile()`. Those that don't are treated as opaque, and
+    // are evaluated via their own batched path.
+    class Compiler
+    {
+        public:
+            typedef Function::IOsptr IOsptr;
+            enum OpCode { OP_ADD, OP_SUBTRACT, OP_MULTIPLY, OP_DIVIDE, OP_DOT, OP_POW, OP_MIN, OP_MAX,
+                          OP_UNARY, OP_RELATIONAL, OP_AT, OP_OPAQUE, OP_BRANCH };
+            // returns the branch to be taken for a given input
+            typedef std::function<unsigned( IOsptr input )> selector;
+
+            // Returns a block function for the compiled version of `fn`.
+            // The program is recompiled if any constant within the graph
+            // is modified, and where compilation is not possible this simply
+            // returns `fn->getBlockFunction()`.
+            static Function::blockfunc compile( Function* fn, IOsptr sample_input );
+
+            // Emission interface, for use within `Function::compile()`. Each
+            // method returns the register holding the generated result.
+            IOsptr   sample_input() const { return _sample_input; };
+            unsigned emit( Function* fn );
+            unsigned emitOpaque( Function* fn );
+            unsigned emitConstant( const Constant* fn, const FunctionIO* value, unsigned version );
+            unsigned emitBinary( OpCode op, Function* fn1, Function* fn2 );
+            unsigned emitUnary( double (*F)( double ), Function* fn );
+            unsigned emitRelational( bool (*F)( double, double ), Function* fn1, Function* fn2 );
+            unsigned emitAt( Function* fn, unsigned component );
+            // Each branch is compiled to a separate program, which is only
+            // evaluated for those inputs selecting it.
+            std::shared_ptr<Program> subprogram( Function* fn );
+            unsigned emitBranch( selector select, const std::vector< std::shared_ptr<Program> >& branches, unsigned size );
+            // register queries
+            unsigned size( unsigned reg ) const;
+            bool     literal( unsigned reg, std::vector<double>& value ) const;
+        private:
+            friend class Program;
+            struct Instruction
+            {
+                Instruction(): op(OP_OPAQUE), out(0), unary(NULL), relational(NULL), component(0) { in[0] = in[1] = 0; };
+                OpCode              op;
+                unsigned            out;
+                unsigned            in[2];
+                double            (*unary)( double );
+                bool              (*relational)( double, double );
+                unsigned            component;
+                Function::blockfunc blockfunc;
+                selector            select;
+                std::vector< std::shared_ptr<Program> > branches;
+            };
+            Compiler( IOsptr sample_input ): _sample_input(sample_input), _program(NULL) {};
+            static std::shared_ptr<Program> build( Function* fn, IOsptr sample_input );
+            unsigned instruction( Instruction& instr, unsigned size );
+            void finalise( Program* program );
+            IOsptr   _sample_input;
+            Program* _program;
+            std::vector< std::pair<const Constant*,unsigned> > _dependencies;
+    };
+
+    class Program
+    {
+        public:
+            Program(): _result(0) {};
+            // Evaluates the program for each input of the block, writing
+            // the result for the idx'th input to `output + idx*stride`.
+            void execute( const InputBlock& block, double* output, std::size_t stride );
+            unsigned size() const { return _register[_result].size; };
+            bool stale() const;
+        private:
+            friend class Compiler;
+            struct Register
+            {
+                unsigned            size;
+                bool                literal;
+                std::vector<double> value;   // literal registers only
+                std::vector<double> buffer;  // block results
+                const double* data() const { return literal ? value.data() : buffer.data(); };
+            };
+            typedef Compiler::Instruction Instruction;
+            void evaluate( const Instruction& instr, std::size_t count, double* output ) const;
+            void branch( const Instruction& instr, const InputBlock& block, double* output );
+
+            std::vector<Register>    _register;
+            std::vector<Instruction> _code;
+            unsigned                 _result;
+            std::vector< std::pair<const Constant*,unsigned> > _dependencies;
+            Function::blockfunc      _fallback;
+            // compile time lookups, by function and by value number
+            std::map<Function*,unsigned> _memo;
+            std::map<std::vector<std::uintptr_t>,unsigned> _valueNumber;
+            // branch workspace
+            std::vector<unsigned>    _branchIndex;
+            std::vector<std::size_t> _group;
+            std::vector<double>      _scratch;
+    };
+#endif
+
+}
+
+#endif /* __Underworld_Function_Compiler_hpp__ */
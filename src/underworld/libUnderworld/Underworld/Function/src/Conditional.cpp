@@ -8,24 +8,26 @@
 **~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*/
 #include <typeindex>
 #include <sstream>
+#include <algorithm>
 
 #include "Conditional.hpp"
+#include "Compiler.hpp"
 
 void Fn::Conditional::insert( Function* condition, Function* value )
 {
     _clause.push_back( std::pair<Function*,Function*>(condition,value) );
 }
 
-Fn::Conditional::func Fn::Conditional::getFunction( IOsptr sample_input )
+void Fn::Conditional::initGetFunction( IOsptr sample_input, std::vector< std::pair<func,func> >& _funcfuncArray, unsigned& outputSize, std::type_index& outputType )
 {
     // are there any clauses?
     if (_clause.size() == 0)
         throw std::invalid_argument( _pyfnerrorheader+"It does not appear that any clauses have been set for the conditional function." );
 
-    unsigned outputSize =(unsigned)-1;
-    std::type_index outputType = typeid(NULL);
+    outputSize =(unsigned)-1;
+    outputType = typeid(NULL);
     
-    std::vector< std::pair<Fn::Function::func,Fn::Function::func> > _funcfuncArray(_clause.size());
+    _funcfuncArray.resize(_clause.size());
     // test function returned values...
     // all the 'condition functions' must return type bool.
     // all the 'consequent functions' must return types identical to each other.
@@ -73,9 +75,35 @@ Fn::Conditional::func Fn::Conditional::getFunction( IOsptr sample_input )
 
     if(outputSize == (unsigned)-1) // at least one of the consequent functions should have evaluated successfully.
         throw std::invalid_argument(_pyfnerrorheader+"It seems that none of the consequent functions were able to be successfully evaluated during testing.");
-    
-    
-    
+}
+
+void Fn::Conditional::checkClauseOutput( unsigned ii, const FunctionIO* io, unsigned outputSize, std::type_index outputType )
+{
+    if (outputSize != io->size()){
+        std::stringstream ss;
+        ss << "Issue with clause " << ii << " of conditional function.\n";
+        ss << "Consequent function appears to return result of size " << io->size() << ".\n";
+        ss << "Previous function returned result of size " << outputSize << ".\n";
+        ss << "All consequent function must return results of identical size.";
+        throw std::invalid_argument( _pyfnerrorheader+ss.str() );
+    }
+    if (outputType != io->dataType()){
+        std::stringstream ss;
+        ss << "Issue with clause " << ii << " of conditional function.\n";
+        ss << "Consequent function appears to return result of type " << functionio_get_type_name(io->dataType()) << ".\n";
+        ss << "Previous function returned result of type " << functionio_get_type_name(outputType) << ".\n";
+        ss << "All consequent function must return results of identical type.";
+        throw std::invalid_argument( _pyfnerrorheader+ss.str() );
+    }
+}
+
+Fn::Conditional::func Fn::Conditional::getFunction( IOsptr sample_input )
+{
+    unsigned outputSize;
+    std::type_index outputType = typeid(NULL);
+    std::vector< std::pair<Fn::Function::func,Fn::Function::func> > _funcfuncArray;
+    initGetFunction( sample_input, _funcfuncArray, outputSize, outputType );
+
     unsigned totalClauses = _funcfuncArray.size();
     std::vector<bool> clauseTested(_clause.size(),false);
 
@@ -91,23 +119,7 @@ Fn::Conditional::func Fn::Conditional::getFunction( IOsptr sample_input )
                 if (!clauseTested[ii])
                 {
                     clauseTested[ii] = true;
-
-                    if (outputSize != (int)io->size()){
-                        std::stringstream ss;
-                        ss << "Issue with clause " << ii << " of conditional function.\n";
-                        ss << "Consequent function appears to return result of size " << io->size() << ".\n";
-                        ss << "Previous function returned result of size " << outputSize << ".\n";
-                        ss << "All consequent function must return results of identical size.";
-                        throw std::invalid_argument( _pyfnerrorheader+ss.str() );
-                    }
-                    if (outputType != io->dataType()){
-                        std::stringstream ss;
-                        ss << "Issue with clause " << ii << " of conditional function.\n";
-                        ss << "Consequent function appears to return result of type " << functionio_get_type_name(io->dataType()) << ".\n";
-                        ss << "Previous function returned result of type " << functionio_get_type_name(outputType) << ".\n";
-                        ss << "All consequent function must return results of identical type.";
-                        throw std::invalid_argument( _pyfnerrorheader+ss.str() );
-                    }
+                    this->checkClauseOutput( ii, io, outputSize, outputType );
                 }
 
                 return io;
@@ -117,3 +129,161 @@ Fn::Conditional::func Fn::Conditional::getFunction( IOsptr sample_input )
         throw std::runtime_error( _pyfnerrorheader+"Reached end of conditional statement. At least one of the clause conditions must evaluate to 'True'." );
     };
 }
+
+Fn::Conditional::blockfunc Fn::Conditional::getBlockFunction( IOsptr sample_input )
+{
+    unsigned outputSize;
+    std::type_index outputType = typeid(NULL);
+    std::vector< std::pair<Fn::Function::func,Fn::Function::func> > _funcfuncArray;
+    initGetFunction( sample_input, _funcfuncArray, outputSize, outputType );
+
+    // batched evaluation is only supported for 'double' type consequents
+    if (outputType != std::type_index(typeid(double)))
+        return Function::getBlockFunction( sample_input );
+
+    std::vector<blockfunc> _blockfuncArray(_clause.size());
+    try {
+        for (unsigned ii=0; ii<_clause.size(); ii++ )
+            _blockfuncArray[ii] = _clause.at(ii).second->getBlockFunction( sample_input );
+    } catch (const std::domain_error& e) {
+        // consequent not valid at sample input, so we cannot setup its
+        // batched version. revert to point-wise evaluation.
+        return Function::getBlockFunction( sample_input );
+    }
+
+    unsigned totalClauses = _funcfuncArray.size();
+    auto clauseTested = std::make_shared<std::vector<bool>>(_clause.size(),false);
+    auto _clauseIndex = std::make_shared<std::vector<unsigned>>();
+    auto _group       = std::make_shared<std::vector<std::size_t>>();
+    auto _scratch     = std::make_shared<std::vector<double>>();
+
+    return [_funcfuncArray, _blockfuncArray, totalClauses, clauseTested, outputSize, outputType, _clauseIndex, _group, _scratch, this]
+           (const InputBlock& block, double* output, std::size_t stride)
+    {
+        std::size_t count = block.size();
+        if (count == 0)
+            return;
+
+        // determine which clause is active for each input
+        std::vector<unsigned>& clauseIndex = *_clauseIndex;
+        clauseIndex.resize(count);
+        bool uniform = true;
+        for (std::size_t jj=0; jj<count; jj++)
+        {
+            IOsptr input = block.get(jj);
+            unsigned ii;
+            for (ii=0; ii<totalClauses; ii++)
+                if ((_funcfuncArray[ii].first(input))->at<bool>())
+                    break;
+            if (ii == totalClauses)
+                throw std::runtime_error( _pyfnerrorheader+"Reached end of conditional statement. At least one of the clause conditions must evaluate to 'True'." );
+            // check consequent output on first usage
+            if (!(*clauseTested)[ii])
+            {
+                (*clauseTested)[ii] = true;
+                this->checkClauseOutput( ii, _funcfuncArray[ii].second(input), outputSize, outputType );
+            }
+            clauseIndex[jj] = ii;
+            uniform &= (ii == clauseIndex[0]);
+        }
+
+        if (uniform) {
+            _blockfuncArray[clauseIndex[0]](block, output, stride);
+            return;
+        }
+
+        // evaluate each active clause over its own sub-block
+        std::vector<std::size_t>& group = *_group;
+        for (unsigned ii=0; ii<totalClauses; ii++)
+        {
+            group.clear();
+            for (std::size_t jj=0; jj<count; jj++)
+                if (clauseIndex[jj] == ii)
+                    group.push_back(jj);
+            if (group.size() == 0)
+                continue;
+            if (_scratch->size() < group.size()*outputSize)
+                _scratch->resize(group.size()*outputSize);
+            double* result = _scratch->data();
+            InputBlock subblock( group.size(), [&block,&group](std::size_t idx){ return block.get(group[idx]); } );
+            _blockfuncArray[ii](subblock, result, outputSize);
+            for (std::size_t jj=0; jj<group.size(); jj++)
+                std::copy( result + jj*outputSize, result + (jj+1)*outputSize, output + group[jj]*stride );
+        }
+    };
+}
+
+unsigned Fn::Conditional::compile( Compiler& compiler )
+{
+    IOsptr sample_input = compiler.sample_input();
+    unsigned outputSize;
+    std::type_index outputType = typeid(NULL);
+    std::vector< std::pair<Fn::Function::func,Fn::Function::func> > _funcfuncArray;
+    initGetFunction( sample_input, _funcfuncArray, outputSize, outputType );
+
+    if (outputType != std::type_index(typeid(double)))
+        return compiler.emitOpaque( this );
+
+    try {
+        // resolve clauses with constant conditions. those which are never
+        // true are removed, and those following an always true clause can
+        // never be reached. an empty condition denotes 'always true'.
+        std::vector<unsigned> clauseIndex;
+        std::vector<func> conditions;
+        for (unsigned ii=0; ii<_clause.size(); ii++ )
+        {
+            std::vector<double> value;
+            if (compiler.literal( compiler.emit( _clause[ii].first ), value )) {
+                if (value[0] == 0.)
+                    continue;
+                clauseIndex.push_back(ii);
+                conditions.push_back( func() );
+                break;
+            }
+            clauseIndex.push_back(ii);
+            conditions.push_back( _funcfuncArray[ii].first );
+        }
+
+        // conditional reduces to a single consequent
+        if ( (clauseIndex.size() > 0) && !conditions[0] )
+        {
+            unsigned ii = clauseIndex[0];
+            try {
+                checkClauseOutput( ii, _funcfuncArray[ii].second(sample_input), outputSize, outputType );
+            } catch (const std::domain_error& e) {}
+            unsigned reg = compiler.emit( _clause[ii].second );
+            if (compiler.size(reg) != outputSize)
+                throw std::invalid_argument( "Consequent result size mismatch." );
+            return reg;
+        }
+
+        std::vector< std::shared_ptr<Program> > branches;
+        for (unsigned ii : clauseIndex)
+            branches.push_back( compiler.subprogram( _clause[ii].second ) );
+
+        auto clauseTested = std::make_shared<std::vector<bool>>(_clause.size(),false);
+        auto select = [_funcfuncArray, conditions, clauseIndex, clauseTested, outputSize, outputType, this](IOsptr input)->unsigned
+        {
+            for (unsigned ii=0; ii<conditions.size(); ii++)
+            {
+                if (!conditions[ii] || (conditions[ii](input))->at<bool>())
+                {
+                    // check consequent output on first usage
+                    unsigned clause = clauseIndex[ii];
+                    if (!(*clauseTested)[clause])
+                    {
+                        (*clauseTested)[clause] = true;
+                        this->checkClauseOutput( clause, _funcfuncArray[clause].second(input), outputSize, outputType );
+                    }
+                    return ii;
+                }
+            }
+            throw std::runtime_error( _pyfnerrorheader+"Reached end of conditional statement. At least one of the clause conditions must evaluate to 'True'." );
+        };
+        return compiler.emitBranch( select, branches, outputSize );
+    } catch (const std::exception& e) {
+        // consequents which may not be compiled at the sample input are
+        // handled by the standard batched evaluation.
+        return compiler.emitOpaque( this );
+    }
+}
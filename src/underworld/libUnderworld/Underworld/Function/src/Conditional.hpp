@@ -10,6 +10,8 @@
 #ifndef __Underworld_Function_Conditional_h__
 #define __Underworld_Function_Conditional_h__
 
+#include <typeindex>
+
 #include "Function.hpp"
 
 namespace Fn {
@@ -19,9 +21,17 @@ namespace Fn {
         public:
             Conditional(){};
             virtual func getFunction( IOsptr sample_input );
+#if !defined(SWIG_DO_NOT_WRAP)
+            virtual blockfunc getBlockFunction( IOsptr sample_input );
+            virtual unsigned compile( Compiler& compiler );
+#endif
             void insert( Function* condition, Function* value );
             virtual ~Conditional(){}
         private:
+#if !defined(SWIG_DO_NOT_WRAP)
+            void initGetFunction( IOsptr sample_input, std::vector< std::pair<func,func> >& funcfuncArray, unsigned& outputSize, std::type_index& outputType );
+            void checkClauseOutput( unsigned clause, const FunctionIO* io, unsigned outputSize, std::type_index outputType );
+#endif
             std::vector< std::pair<Function*,Function*> > _clause;
     };
 
@@ -6,7 +6,10 @@
 ** located at the project root, or contact the authors.                             **
 **                                                                                  **
 **~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*/
+#include <algorithm>
+
 #include "Constant.hpp"
+#include "Compiler.hpp"
 
 Fn::Constant::func Fn::Constant::getFunction( IOsptr sample_input )
 {
@@ -15,3 +18,25 @@ Fn::Constant::func Fn::Constant::getFunction( IOsptr sample_input )
     };
 }
 
+
+Fn::Constant::blockfunc Fn::Constant::getBlockFunction( IOsptr sample_input )
+{
+    // note that the value is read at evaluation time, as it may be
+    // modified via `set_value()` after the function is generated.
+    return [this](const InputBlock& block, double* output, std::size_t stride) {
+        if (block.size() == 0)
+            return;
+        const FunctionIO* constIO = this->_constIO;
+        unsigned size = constIO->size();
+        double* value = output;
+        for (unsigned jj=0; jj<size; jj++)
+            value[jj] = constIO->at<double>(jj);
+        for (std::size_t ii=1; ii<block.size(); ii++)
+            std::copy( value, value + size, output + ii*stride );
+    };
+}
+
+unsigned Fn::Constant::compile( Compiler& compiler )
+{
+    return compiler.emitConstant( this, this->_constIO, _version );
+}
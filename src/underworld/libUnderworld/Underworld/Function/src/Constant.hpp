@@ -17,13 +17,20 @@ namespace Fn {
     class Constant: public Function
     {
         public:
-            Constant( const FunctionIO& constio ): Function() { _constIO_sp = std::shared_ptr<FunctionIO>(constio.clone()); _constIO = _constIO_sp.get(); };
+            Constant( const FunctionIO& constio ): Function(), _version(0) { _constIO_sp = std::shared_ptr<FunctionIO>(constio.clone()); _constIO = _constIO_sp.get(); };
             virtual func getFunction( IOsptr sample_input );
-            void set_value( const FunctionIO& value ){ _constIO_sp = std::shared_ptr<FunctionIO>(value.clone()); _constIO = _constIO_sp.get(); };
+#if !defined(SWIG_DO_NOT_WRAP)
+            virtual blockfunc getBlockFunction( IOsptr sample_input );
+            virtual unsigned compile( Compiler& compiler );
+#endif
+            void set_value( const FunctionIO& value ){ _constIO_sp = std::shared_ptr<FunctionIO>(value.clone()); _constIO = _constIO_sp.get(); _version++; };
+            // incremented each time the value is modified
+            unsigned version() const { return _version; };
             virtual ~Constant(){};
         private:
             std::shared_ptr<FunctionIO> _constIO_sp;
             FunctionIO* _constIO;
+            unsigned _version;
     };
 
 };
@@ -29,6 +29,8 @@ namespace Fn {
                 // what it itself returns) after this `getFunction` returns. 
                 // I'm not 100% how robust this is. JM.
                 count-=1;
+                // every evaluation updates the count held by this object
+                NotThreadSafe();
                 return [func_input,this](IOsptr input)->IOsptr 
                     { 
                         count+=1; 
@@ -7,6 +7,8 @@
 **                                                                                  **
 **~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*/
 #include <sstream> 
+#include <vector>
+#include <algorithm>
 
 #include <mpi.h>
 #include <petsc.h>
@@ -76,6 +78,8 @@ Fn::FeVariableFn::func Fn::FeVariableFn::getFunction( IOsptr sample_input )
             streamguy << "does not appear to match mesh variable dimensionality (" << fevar->dim << ").";
             throw std::runtime_error(_pyfnerrorheader+streamguy.str());
         }
+        // the element search uses the mesh's shared work arrays
+        NotThreadSafe();
         return [_output,_output_sp,fevar,this](IOsptr input)->IOsptr {
             const IO_double* iodouble = debug_dynamic_cast<const IO_double*>(input);            
 
@@ -102,3 +106,69 @@ Fn::FeVariableFn::func Fn::FeVariableFn::getFunction( IOsptr sample_input )
 }
 
 
+Fn::FeVariableFn::blockfunc Fn::FeVariableFn::getBlockFunction( IOsptr sample_input )
+{
+    FeVariable* fevar = (FeVariable*)_fevariable;
+
+    // results are interpolated directly into the output buffer
+    const FEMCoordinate* femCoord = dynamic_cast<const FEMCoordinate*>(sample_input);
+    if ( femCoord ){
+        if( femCoord->mesh() == (void*) (fevar->feMesh->parentMesh ) )
+            return [fevar](const InputBlock& block, double* output, std::size_t stride) {
+                for (std::size_t ii=0; ii<block.size(); ii++) {
+                    const FEMCoordinate* femCoord = debug_dynamic_cast<const FEMCoordinate*>(block.get(ii));
+                    FeVariable_InterpolateWithinElement( fevar, femCoord->index(), femCoord->localCoord()->data(), output + ii*stride );
+                }
+            };
+    };
+
+    const MeshCoordinate* meshCoord = dynamic_cast<const MeshCoordinate*>(sample_input);
+    if ( meshCoord ){
+        if( meshCoord->object() == (void*) (fevar->feMesh) )
+            return [fevar](const InputBlock& block, double* output, std::size_t stride) {
+                for (std::size_t ii=0; ii<block.size(); ii++) {
+                    const MeshCoordinate* meshCoord = debug_dynamic_cast<const MeshCoordinate*>(block.get(ii));
+                    FeVariable_GetValueAtNode( fevar, meshCoord->index(), output + ii*stride );
+                }
+            };
+    }
+
+    // global coordinates are located and interpolated as a batch, grouped by element
+    const IO_double* iodouble = dynamic_cast<const IO_double*>(sample_input);
+    if ( iodouble ){
+        if ( iodouble->size() != fevar->dim )
+        {
+            std::stringstream streamguy;
+            streamguy << "Function input dimensionality (" << iodouble->size() << ") ";
+            streamguy << "does not appear to match mesh variable dimensionality (" << fevar->dim << ").";
+            throw std::runtime_error(_pyfnerrorheader+streamguy.str());
+        }
+        NotThreadSafe();
+        return [fevar,this](const InputBlock& block, double* output, std::size_t stride) {
+            unsigned dim = fevar->dim;
+            std::vector<double> coords(block.size()*dim);
+            std::vector<InterpolationResult> results(block.size());
+            for (std::size_t ii=0; ii<block.size(); ii++) {
+                const IO_double* iodouble = debug_dynamic_cast<const IO_double*>(block.get(ii));
+                std::copy( iodouble->data(), iodouble->data()+dim, coords.begin()+ii*dim );
+            }
+
+            FeVariable_InterpolateValuesAt( fevar, block.size(), coords.data(), output, stride, results.data() );
+
+            for (std::size_t ii=0; ii<block.size(); ii++) {
+                if (! ( (results[ii] == LOCAL) || (results[ii] == SHADOW) ) ){
+                    std::stringstream streamguy;
+                    streamguy << "FeVariable interpolation at location (" << coords[ii*dim];
+                    for (unsigned jj=1; jj<dim; jj++)
+                        streamguy << ", "<< coords[ii*dim+jj];
+                    streamguy << ") does not appear to be valid.\nLocation is probably outside local domain.";
+
+                    throw std::range_error(_pyfnerrorheader+streamguy.str());
+                }
+            }
+        };
+    }
+
+    // if we get here, fall back to the point-wise path (which includes all checks and error reporting)
+    return Function::getBlockFunction( sample_input );
+}
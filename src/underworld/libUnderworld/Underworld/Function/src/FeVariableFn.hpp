@@ -20,6 +20,9 @@ namespace Fn {
             FeVariableFn( void* fevariable );
             virtual ~FeVariableFn(){};
             virtual func getFunction( IOsptr sample_input );
+#if !defined(SWIG_DO_NOT_WRAP)
+            virtual blockfunc getBlockFunction( IOsptr sample_input );
+#endif
         private:
             void* _fevariable;
     };
@@ -18,17 +18,74 @@
 
 namespace Fn {
 
+#if !defined(SWIG_DO_NOT_WRAP)
+    // A block of inputs for batched evaluation. The block does not own its
+    // inputs, but instead provides access to the idx'th input via a getter.
+    // This allows callers to either reposition a single proxy input object
+    // (as is done for the point-wise evaluation path), or to hand out
+    // independent input objects.
+    class InputBlock
+    {
+        public:
+            typedef std::function<const FunctionIO*( std::size_t idx )> getter;
+            InputBlock( std::size_t count, getter get ): _count(count), _get(get) {};
+            std::size_t size() const { return _count; };
+            const FunctionIO* get( std::size_t idx ) const { return _get(idx); };
+        private:
+            std::size_t _count;
+            getter      _get;
+    };
+
+    class Compiler;
+#endif
+
     class Function
     {
         public:
             typedef const FunctionIO* IOsptr;
             typedef std::function<IOsptr( const IOsptr &input )> func;
             virtual func getFunction( IOsptr input )=0;
+#if !defined(SWIG_DO_NOT_WRAP)
+            // Batched evaluation path. The returned function evaluates every
+            // input of the block, writing the result for the idx'th input
+            // to `output + idx*stride`. Results are always written as doubles.
+            // The default implementation simply wraps the point-wise function,
+            // and should be overridden where a class can do better.
+            typedef std::function<void( const InputBlock& block, double* output, std::size_t stride )> blockfunc;
+            virtual blockfunc getBlockFunction( IOsptr sample_input )
+            {
+                func _func = getFunction( sample_input );
+                return [_func](const InputBlock& block, double* output, std::size_t stride) {
+                    for (std::size_t ii=0; ii<block.size(); ii++) {
+                        const FunctionIO* io = _func(block.get(ii));
+                        double* out = output + ii*stride;
+                        for (unsigned jj=0; jj<io->size(); jj++)
+                            out[jj] = io->at<double>(jj);
+                    }
+                };
+            };
+            // Expression compilation (see Compiler.hpp). Classes which are
+            // simple operations on their operands should emit themselves
+            // accordingly. By default functions are treated as opaque.
+            virtual unsigned compile( Compiler& compiler );
+            // Thread safety. Functions whose evaluation lazily builds shared
+            // state (for example a swarm's nearest neighbour index) call
+            // NotThreadSafe() when their function is created. Callers which
+            // evaluate concurrently call ResetThreadSafe() before creating
+            // their functions, and check ThreadSafe() afterwards.
+            static void ResetThreadSafe(){ _threadSafe() = true; };
+            static bool ThreadSafe(){ return _threadSafe(); };
+#endif
             virtual ~Function(){};
             void set_pyfnerrorheader( char* pyfnerrorheader ){ _pyfnerrorheader = pyfnerrorheader; }
         protected:
             Function(): _pyfnerrorheader("Error in function of class 'Function'\nError message:\n"){};
             std::string _pyfnerrorheader;  // this member records the python stack error message at construction time
+#if !defined(SWIG_DO_NOT_WRAP)
+            static void NotThreadSafe(){ _threadSafe() = false; };
+        private:
+            static bool& _threadSafe(){ static bool threadSafe = true; return threadSafe; };
+#endif
     };
 
     class Input: public Function
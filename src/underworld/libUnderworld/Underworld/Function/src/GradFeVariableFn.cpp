@@ -103,6 +103,8 @@ Fn::GradFeVariableFn::func Fn::GradFeVariableFn::getFunction( IOsptr sample_inpu
             streamguy << "does not appear to match mesh variable dimensionality (" << fevar->dim << ").";
             throw std::runtime_error(_pyfnerrorheader+streamguy.str());
         }
+        // the element search uses the mesh's shared work arrays
+        NotThreadSafe();
         return [_output,_output_sp,fevar,this](IOsptr input)->IOsptr {
             const IO_double* iodouble = debug_dynamic_cast<const IO_double*>(input);            
 
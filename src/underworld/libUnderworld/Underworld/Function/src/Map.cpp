@@ -7,7 +7,9 @@
 **                                                                                  **
 **~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*~*/
 #include <sstream>
+#include <algorithm>
 #include "Map.hpp"
+#include "Compiler.hpp"
 
 
 Fn::Map::Map(Function* keyFunc, Function* defaultFunc)
@@ -27,10 +29,10 @@ void Fn::Map::insert( unsigned key, Function* value )
     
 }
 
-Fn::Map::func Fn::Map::getFunction( IOsptr sample_input )
+unsigned Fn::Map::initGetFunction( IOsptr sample_input, func& _keyFuncFunc, func& _defaultFuncFunc, std::vector<func>& _funcfuncArray )
 {
     // get key function
-    auto _keyFuncFunc = _keyFunc->getFunction( sample_input );
+    _keyFuncFunc = _keyFunc->getFunction( sample_input );
     // now do test eval
     auto keyfuncout   = _keyFuncFunc( sample_input );
     if (keyfuncout->size() != 1)
@@ -39,7 +41,6 @@ Fn::Map::func Fn::Map::getFunction( IOsptr sample_input )
     // ensure correct default func
     int outputSize = -1;
     
-    Fn::Function::func _defaultFuncFunc;
     if (_defaultFunc)
     {
         // get key function
@@ -54,7 +55,7 @@ Fn::Map::func Fn::Map::getFunction( IOsptr sample_input )
         outputSize = _defaultFuncOut->size();
     }
 
-    std::vector<Fn::Map::func> _funcfuncArray(_funcArray.size());
+    _funcfuncArray.resize(_funcArray.size());
 
     // ensure correct other funcs
     for (unsigned ii=0; ii<_isIndexInMap.size(); ii++ )
@@ -101,6 +102,25 @@ Fn::Map::func Fn::Map::getFunction( IOsptr sample_input )
     if (outputSize == -1)
         throw std::invalid_argument( _pyfnerrorheader+"It does not appear that any functions have been set for the 'map' function." );
 
+    return (unsigned)outputSize;
+}
+
+std::string Fn::Map::keyErrorMessage( unsigned key )
+{
+    std::stringstream ss;
+    ss << "Error evaluating 'map' function.\n";
+    ss << "Key function evaluates to key (" << key << ") which\n";
+    ss << "does not appear to map to any functions, and no default function has been set.";
+    return _pyfnerrorheader+ss.str();
+}
+
+Fn::Map::func Fn::Map::getFunction( IOsptr sample_input )
+{
+    func _keyFuncFunc;
+    func _defaultFuncFunc;
+    std::vector<func> _funcfuncArray;
+    initGetFunction( sample_input, _keyFuncFunc, _defaultFuncFunc, _funcfuncArray );
+
     // grab copy of this guy
     std::vector<bool>  isIndexInMap = _isIndexInMap;
     return [_keyFuncFunc, _defaultFuncFunc, _funcfuncArray, isIndexInMap, this](IOsptr input)->IOsptr {
@@ -115,13 +135,138 @@ Fn::Map::func Fn::Map::getFunction( IOsptr sample_input )
             // no func for key, so use default
             return _defaultFuncFunc(input);
         else
-        {
-            std::stringstream ss;
-            ss << "Error evaluating 'map' function.\n";
-            ss << "Key function evaluates to key (" << key << ") which\n";
-            ss << "does not appear to map to any functions, and no default function has been set.";
             // something aint right
-            throw std::runtime_error( _pyfnerrorheader+ss.str() );
+            throw std::runtime_error( this->keyErrorMessage(key) );
+    };
+}
+
+Fn::Map::blockfunc Fn::Map::getBlockFunction( IOsptr sample_input )
+{
+    // keys are evaluated point-wise (they are generally not 'double' type),
+    // and inputs are then grouped by key so that each mapped function may
+    // be evaluated over its own sub-block.
+    func _keyFuncFunc;
+    func _defaultFuncFunc;
+    std::vector<func> _funcfuncArray;
+    unsigned outputSize = initGetFunction( sample_input, _keyFuncFunc, _defaultFuncFunc, _funcfuncArray );
+
+    blockfunc _defaultBlockFunc;
+    if (_defaultFunc)
+        _defaultBlockFunc = _defaultFunc->getBlockFunction( sample_input );
+    std::vector<blockfunc> _blockfuncArray(_funcArray.size());
+    for (unsigned ii=0; ii<_isIndexInMap.size(); ii++ )
+        if (_isIndexInMap[ii])
+            _blockfuncArray[ii] = _funcArray[ii]->getBlockFunction( sample_input );
+
+    auto _keys    = std::make_shared<std::vector<unsigned>>();
+    auto _done    = std::make_shared<std::vector<char>>();
+    auto _group   = std::make_shared<std::vector<std::size_t>>();
+    auto _scratch = std::make_shared<std::vector<double>>();
+    std::vector<bool>  isIndexInMap = _isIndexInMap;
+    return [_keyFuncFunc, _defaultBlockFunc, _blockfuncArray, isIndexInMap, outputSize, _keys, _done, _group, _scratch, this]
+           (const InputBlock& block, double* output, std::size_t stride) {
+        std::size_t count = block.size();
+        if (count == 0)
+            return;
+
+        // evaluate keys
+        std::vector<unsigned>& keys = *_keys;
+        keys.resize(count);
+        bool uniform = true;
+        for (std::size_t ii=0; ii<count; ii++) {
+            keys[ii] = _keyFuncFunc( block.get(ii) )->at<unsigned>();
+            uniform &= (keys[ii] == keys[0]);
+        }
+
+        auto getBlockFunc = [&](unsigned key)->const blockfunc& {
+            if (key<isIndexInMap.size() && isIndexInMap[key])
+                return _blockfuncArray[key];
+            else if ( _defaultBlockFunc )
+                return _defaultBlockFunc;
+            else
+                throw std::runtime_error( this->keyErrorMessage(key) );
+        };
+
+        // common case (eg, single material in element), evaluate directly
+        if (uniform) {
+            getBlockFunc(keys[0])(block, output, stride);
+            return;
+        }
+
+        // otherwise process each distinct key in turn
+        std::vector<std::size_t>& group = *_group;
+        std::vector<char>& done = *_done;
+        done.assign(count, 0);
+        for (std::size_t ii=0; ii<count; ii++) {
+            if (done[ii])
+                continue;
+            unsigned key = keys[ii];
+            group.clear();
+            for (std::size_t jj=ii; jj<count; jj++)
+                if (!done[jj] && keys[jj] == key) {
+                    group.push_back(jj);
+                    done[jj] = 1;
+                }
+            if (_scratch->size() < group.size()*outputSize)
+                _scratch->resize(group.size()*outputSize);
+            double* result = _scratch->data();
+            InputBlock subblock( group.size(), [&block,&group](std::size_t idx){ return block.get(group[idx]); } );
+            getBlockFunc(key)(subblock, result, outputSize);
+            // scatter results
+            for (std::size_t jj=0; jj<group.size(); jj++)
+                std::copy( result + jj*outputSize, result + (jj+1)*outputSize, output + group[jj]*stride );
         }
     };
 }
+
+unsigned Fn::Map::compile( Compiler& compiler )
+{
+    func _keyFuncFunc;
+    func _defaultFuncFunc;
+    std::vector<func> _funcfuncArray;
+    unsigned outputSize = initGetFunction( compiler.sample_input(), _keyFuncFunc, _defaultFuncFunc, _funcfuncArray );
+
+    try {
+        // constant keys select a single function
+        std::vector<double> value;
+        if (compiler.literal( compiler.emit( _keyFunc ), value ) && value[0] >= 0.)
+        {
+            unsigned key = (unsigned)value[0];
+            if (key<_isIndexInMap.size() && _isIndexInMap[key])
+                return compiler.emit( _funcArray[key] );
+            else if ( _defaultFunc )
+                return compiler.emit( _defaultFunc );
+        }
+
+        std::vector< std::shared_ptr<Program> > branches;
+        std::vector<unsigned> branchIndex( _isIndexInMap.size(), (unsigned)-1 );
+        for (unsigned ii=0; ii<_isIndexInMap.size(); ii++ )
+            if (_isIndexInMap[ii])
+            {
+                branchIndex[ii] = branches.size();
+                branches.push_back( compiler.subprogram( _funcArray[ii] ) );
+            }
+        unsigned defaultIndex = (unsigned)-1;
+        if (_defaultFunc)
+        {
+            defaultIndex = branches.size();
+            branches.push_back( compiler.subprogram( _defaultFunc ) );
+        }
+
+        auto select = [_keyFuncFunc, branchIndex, defaultIndex, this](IOsptr input)->unsigned
+        {
+            const unsigned key = _keyFuncFunc( input )->at<unsigned>();
+            if (key<branchIndex.size() && branchIndex[key] != (unsigned)-1)
+                return branchIndex[key];
+            else if ( defaultIndex != (unsigned)-1 )
+                return defaultIndex;
+            else
+                throw std::runtime_error( this->keyErrorMessage(key) );
+        };
+        return compiler.emitBranch( select, branches, outputSize );
+    } catch (const std::exception& e) {
+        // mapped functions which may not be compiled at the sample input
+        // are handled by the standard batched evaluation.
+        return compiler.emitOpaque( this );
+    }
+}
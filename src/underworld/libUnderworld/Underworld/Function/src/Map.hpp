@@ -19,9 +19,15 @@ namespace Fn {
         public:
             Map(Function* keyFunc, Function* defaultFunc=NULL);
             virtual func getFunction( IOsptr sample_input );
+#if !defined(SWIG_DO_NOT_WRAP)
+            virtual blockfunc getBlockFunction( IOsptr sample_input );
+            virtual unsigned compile( Compiler& compiler );
+#endif
             void insert( unsigned key, Function* value );
             virtual ~Map(){}
         private:
+            unsigned initGetFunction( IOsptr sample_input, func& keyFuncFunc, func& defaultFuncFunc, std::vector<func>& funcfuncArray );
+            std::string keyErrorMessage( unsigned key );
             std::vector<Function*> _funcArray;
             std::vector<bool>      _isIndexInMap;
             Function*              _keyFunc;
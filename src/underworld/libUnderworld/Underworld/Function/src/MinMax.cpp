@@ -60,7 +60,9 @@ Fn::MinMax::func Fn::MinMax::getFunction( IOsptr sample_input )
         _fn_auxiliary_io_min        = std::shared_ptr<FunctionIO>(dynamic_cast<FunctionIO*>(_func_auxiliary(sample_input)->cloneType()));
         _fn_auxiliary_io_max        = std::shared_ptr<FunctionIO>(dynamic_cast<FunctionIO*>(_func_auxiliary(sample_input)->cloneType()));
     }
-    
+
+    // every evaluation updates the extrema held by this object
+    NotThreadSafe();
     return [_func,_func_norm,_func_auxiliary,this](IOsptr input)->IOsptr {
         
         // perform func
@@ -16,6 +16,12 @@ extern "C" {
 }
 
 #include "Query.hpp"
+#include "DiscreteCoordinate.hpp"
+#include "MeshCoordinate.hpp"
+#include "ParticleCoordinate.hpp"
+
+// number of inputs processed per batched evaluation
+static const unsigned QUERY_BLOCK_SIZE = 256;
 
 
 PyObject* Fn::Query::query( IOIterator& iterator )
@@ -60,6 +66,10 @@ PyObject* Fn::Query::query( IOIterator& iterator )
     
     // allocate numpy array
     PyObject* pyobj = PyArray_New(&PyArray_Type, 2, dims, numtype, NULL, NULL, sizeitem, (int)NULL, NULL);
+
+    // use the batched path where possible
+    if ( (numtype == NPY_DOUBLE) && _queryBlocked( iterator, (double*)PyArray_DATA((PyArrayObject*)pyobj), iosize ) )
+        return pyobj;
  
     // setup numpy iterator for output
     NpyIter* iter;
@@ -119,4 +129,46 @@ PyObject* Fn::Query::query( IOIterator& iterator )
     NpyIter_Deallocate(iter);
 
     return pyobj;
-}
\ No newline at end of file
+}
+
+bool Fn::Query::_queryBlocked( IOIterator& iterator, double* output, unsigned iosize )
+{
+    // Batched evaluation requires independent copies of the inputs, which
+    // we can only safely construct for plain arrays and discrete coordinates.
+    // Note that FEMCoordinate clones share their local coordinate object.
+    Function::IOsptr sample = iterator.get();
+    bool isDiscrete = dynamic_cast<const MeshCoordinate*>(sample) || dynamic_cast<const ParticleCoordinate*>(sample);
+    bool isArray    = std::type_index(typeid(*sample)) == std::type_index(typeid(IO_double));
+    if ( !isDiscrete && !isArray )
+        return false;
+
+    auto blockfunc = _function.getBlockFunction( sample );
+
+    // setup pool of input objects
+    unsigned size = iterator.size();
+    unsigned poolSize = std::min( size, QUERY_BLOCK_SIZE );
+    std::vector< std::shared_ptr<FunctionIO> > pool(poolSize);
+    for (unsigned ii=0; ii<poolSize; ii++)
+        pool[ii] = std::shared_ptr<FunctionIO>(sample->clone());
+    Fn::InputBlock::getter poolget = [&pool](std::size_t idx)->const FunctionIO* { return pool[idx].get(); };
+    std::size_t bytes = sample->_dataSize*sample->size();
+
+    unsigned done = 0;
+    while (done < size) {
+        unsigned count = std::min( size - done, poolSize );
+        // copy current inputs into pool
+        for (unsigned ii=0; ii<count; ii++) {
+            Function::IOsptr io = iterator.get();
+            if (isDiscrete)
+                std::static_pointer_cast<DiscreteCoordinate>(pool[ii])->index() = debug_dynamic_cast<const DiscreteCoordinate*>(io)->index();
+            else
+                memcpy( pool[ii]->dataRaw(), io->dataRaw(), bytes );
+            iterator++;
+        }
+        // evaluate directly into numpy array
+        blockfunc( Fn::InputBlock(count, poolget), output + (std::size_t)done*iosize, iosize );
+        done += count;
+    }
+
+    return true;
+}
@@ -26,6 +26,9 @@ class Query
         PyObject* query( IOIterator& iterator );
     private:
         Function& _function;
+#if !defined(SWIG_DO_NOT_WRAP)
+        bool _queryBlocked( IOIterator& iterator, double* output, unsigned iosize );
+#endif
 };
 
 }
@@ -15,6 +15,7 @@
 #include <functional>
 
 #include "Function.hpp"
+#include "Compiler.hpp"
 
 namespace Fn {
 
@@ -86,9 +87,16 @@ namespace Fn {
                         return debug_dynamic_cast<const FunctionIO*>(_output);
                     };
                 }
+#if !defined(SWIG_DO_NOT_WRAP)
+            virtual unsigned compile( Compiler& compiler )
+                {
+                    return compiler.emitRelational( &_relate, _fn[0], _fn[1] );
+                }
+#endif
             virtual ~MathRelational(){};
         protected:
             Function* _fn[2];
+            static bool _relate( double a, double b ){ return F()( a, b ); };
 
     };
     
@@ -76,6 +76,10 @@ Fn::SwarmVariableFn::func Fn::SwarmVariableFn::getFunction( IOsptr sample_input
         if (!partCoord)
             throw std::invalid_argument( _pyfnerrorheader+"Provided 'FEMCoordinate' input to SwarmVariableFn does not appear to have 'ParticleInCellCoordinate' type local coordinate." );
 
+        // integration swarms which do not mirror this swarm are mapped via a SwarmMap, which is
+        // filled as points are evaluated
+        if( ((SwarmVariable*)partCoord->object())->swarm->mirroredSwarm != (Swarm*)swarmvar->swarm )
+            NotThreadSafe();
         
         // return the lambda
         return [_output, _output_sp, swarmvar,this](IOsptr input)->IOsptr {
@@ -153,6 +157,8 @@ Fn::SwarmVariableFn::func Fn::SwarmVariableFn::getFunction( IOsptr sample_input
             throw std::runtime_error(_pyfnerrorheader+streamguy.str());
             
         }
+        // the nearest neighbour index is built and updated on demand
+        NotThreadSafe();
         return [_output,_output_sp,swarmvar,this](IOsptr input)->IOsptr {
             const IO_double* iodouble = debug_dynamic_cast<const IO_double*>(input);
             
@@ -173,3 +179,74 @@ Fn::SwarmVariableFn::func Fn::SwarmVariableFn::getFunction( IOsptr sample_input
 }
 
 
+// copies the swarm variable datum for the given particle into `output`, converting to double
+static inline void _SwarmVariableFn_CopyAsDouble( SwarmVariable* swarmvar, unsigned particleIndex, double* output )
+{
+    void* dataPtr = __StgVariable_GetStructPtr( swarmvar->variable, particleIndex );
+    unsigned dofCount = swarmvar->dofCount;
+    switch( swarmvar->variable->dataTypes[0] ) {
+        case StgVariable_DataType_Double:
+            memcpy( output, dataPtr, sizeof(double)*dofCount );
+            break;
+        case StgVariable_DataType_Int:
+            for (unsigned jj=0; jj<dofCount; jj++) output[jj] = ((int*)dataPtr)[jj];
+            break;
+        case StgVariable_DataType_Long:
+            for (unsigned jj=0; jj<dofCount; jj++) output[jj] = ((long*)dataPtr)[jj];
+            break;
+        case StgVariable_DataType_Char:
+            for (unsigned jj=0; jj<dofCount; jj++) output[jj] = ((char*)dataPtr)[jj];
+            break;
+        case StgVariable_DataType_Float:
+            for (unsigned jj=0; jj<dofCount; jj++) output[jj] = ((float*)dataPtr)[jj];
+            break;
+        case StgVariable_DataType_Short:
+            for (unsigned jj=0; jj<dofCount; jj++) output[jj] = ((short*)dataPtr)[jj];
+            break;
+        default:
+            throw std::invalid_argument( "SwarmVariable datatype does not appear to be supported." );
+    }
+}
+
+Fn::SwarmVariableFn::blockfunc Fn::SwarmVariableFn::getBlockFunction( IOsptr sample_input )
+{
+    SwarmVariable* swarmvar = (SwarmVariable*)_swarmvariable;
+
+    // run point-wise setup for checks
+    getFunction( sample_input );
+
+    const FEMCoordinate*  meshCoord = dynamic_cast<const FEMCoordinate*>(sample_input);
+    if( meshCoord && !swarmvar->useKDTree )
+    {
+        return [swarmvar,this](const InputBlock& block, double* output, std::size_t stride) {
+            for (std::size_t ii=0; ii<block.size(); ii++) {
+                const FEMCoordinate*            meshCoord = debug_dynamic_cast<const FEMCoordinate*>(block.get(ii));
+                const ParticleInCellCoordinate* partCoord = debug_dynamic_cast<const ParticleInCellCoordinate*>(meshCoord->localCoord());
+
+                IntegrationPointsSwarm* intSwarm = (IntegrationPointsSwarm*)((SwarmVariable*)partCoord->object())->swarm;
+                unsigned swarmVarLocalIndex = GeneralSwarm_IntegrationPointMap( swarmvar->swarm, intSwarm, partCoord->index(), partCoord->particle_cellId() );
+                if ( swarmVarLocalIndex == (unsigned)-1 )
+                    throw std::domain_error(  _pyfnerrorheader+"Error occurred while trying to evaluate swarm variable. "\
+                                               "This can occur when there are no particles found in a given element. "\
+                                               "You may wish to add population control mechanisms. "\
+                                               "Please contact developers if this does not appear to be the issue." );
+
+                _SwarmVariableFn_CopyAsDouble( swarmvar, swarmVarLocalIndex, output + ii*stride );
+            }
+        };
+    }
+
+    const ParticleCoordinate* partCoord = dynamic_cast<const ParticleCoordinate*>(sample_input);
+    if (partCoord)
+    {
+        return [swarmvar](const InputBlock& block, double* output, std::size_t stride) {
+            for (std::size_t ii=0; ii<block.size(); ii++) {
+                const ParticleCoordinate* partCoord = debug_dynamic_cast<const ParticleCoordinate*>(block.get(ii));
+                _SwarmVariableFn_CopyAsDouble( swarmvar, partCoord->index(), output + ii*stride );
+            }
+        };
+    }
+
+    // nearest neighbour evaluations go via the point-wise path
+    return Function::getBlockFunction( sample_input );
+}
@@ -19,6 +19,9 @@ namespace Fn {
         public:
             SwarmVariableFn( void* swarmvariable );
             virtual func getFunction( IOsptr sample_input );
+#if !defined(SWIG_DO_NOT_WRAP)
+            virtual blockfunc getBlockFunction( IOsptr sample_input );
+#endif
             virtual ~SwarmVariableFn(){}
         private:
             void* _swarmvariable;
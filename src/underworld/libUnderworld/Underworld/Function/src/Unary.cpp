@@ -52,3 +52,10 @@ Fn::At::func Fn::At::getFunction( IOsptr sample_input )
         return _output;
     };
 }
+
+unsigned Fn::At::compile( Compiler& compiler )
+{
+    if (!_fn)
+        return Function::compile( compiler );
+    return compiler.emitAt( _fn, _component );
+}
@@ -12,6 +12,7 @@
 
 #include <cmath>
 #include "Function.hpp"
+#include "Compiler.hpp"
 
 namespace Fn {
 
@@ -62,6 +63,43 @@ namespace Fn {
                         };
                     }
                 }
+#if !defined(SWIG_DO_NOT_WRAP)
+            virtual blockfunc getBlockFunction( IOsptr sample_input )
+                {
+                    if (_fn) {
+                        // check argument type via the point-wise path
+                        func _func = _fn->getFunction( sample_input );
+                        const IO_double* doubleio = dynamic_cast<const IO_double*>(_func(sample_input));
+                        if (!doubleio)
+                            throw std::invalid_argument(_pyfnerrorheader+"Argument function is expected to return 'double' type object.");
+                        unsigned outsize = doubleio->size();
+                        blockfunc _blockfunc = _fn->getBlockFunction( sample_input );
+
+                        // evaluate argument directly into output, then apply function in place
+                        return [_blockfunc,outsize](const InputBlock& block, double* output, std::size_t stride) {
+                            _blockfunc(block, output, stride);
+                            for (std::size_t ii=0; ii<block.size(); ii++)
+                                for (unsigned jj=0; jj<outsize; jj++)
+                                    output[ii*stride+jj] = F( output[ii*stride+jj] );
+                        };
+                    } else {
+                        unsigned outsize = sample_input->size();
+                        return [outsize](const InputBlock& block, double* output, std::size_t stride) {
+                            for (std::size_t ii=0; ii<block.size(); ii++) {
+                                const IO_double* io = debug_dynamic_cast<const IO_double*>( block.get(ii) ) ;
+                                for (unsigned jj=0; jj<outsize; jj++)
+                                    output[ii*stride+jj] = F( io->at(jj) );
+                            }
+                        };
+                    }
+                }
+            virtual unsigned compile( Compiler& compiler )
+                {
+                    if (!_fn)
+                        return Function::compile( compiler );
+                    return compiler.emitUnary( F, _fn );
+                }
+#endif
             virtual ~MathUnary(){};
         protected:
             Function* _fn;
@@ -73,6 +111,9 @@ namespace Fn {
         public:
             At(Function* fn, unsigned component): _fn(fn),_component(component){};
             virtual func getFunction( IOsptr sample_input );
+#if !defined(SWIG_DO_NOT_WRAP)
+            virtual unsigned compile( Compiler& compiler );
+#endif
             virtual ~At(){};
         protected:
             Function* _fn;
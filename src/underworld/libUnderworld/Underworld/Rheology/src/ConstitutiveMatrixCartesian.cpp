@@ -20,6 +20,7 @@
 #include <Underworld/Function/src/FEMCoordinate.hpp>
 #include <Underworld/Function/src/ParticleInCellCoordinate.hpp>
 #include <Underworld/Function/src/Function.hpp>
+#include <Underworld/Function/src/Compiler.hpp>
 
 #include <mpi.h>
 #include <petsc.h>
@@ -38,6 +39,32 @@ extern "C" {
 /* Textual name of this class - This is a global pointer which is used for times when you need to refer to class and not a particular instance of a class */
 const Type ConstitutiveMatrixCartesian_Type = (char*) "ConstitutiveMatrixCartesian";
 
+/* These operate on an explicit D matrix, rather than self->matrixData, so
+   that elements may be assembled concurrently. */
+static void _ConstitutiveMatrixCartesian_AddIsotropicViscosity( Dimension_Index dim, double** D, double viscosity );
+static void _ConstitutiveMatrixCartesian2D_AddSecondViscosity( double** D, double deltaViscosity, const XYZ director );
+static void _ConstitutiveMatrixCartesian3D_AddSecondViscosity( double** D, double deltaViscosity, const XYZ director );
+static void _ConstitutiveMatrixCartesian2D_Form_D_B( double** D, Bool isDiagonal, double** GNx, Node_Index node_I, double** D_B );
+static void _ConstitutiveMatrixCartesian3D_Form_D_B( double** D, Bool isDiagonal, double** GNx, Node_Index node_I, double** D_B );
+
+static void _ConstitutiveMatrixCartesian_SetupThreads( ConstitutiveMatrixCartesian* self ){
+    ConstitutiveMatrixCartesian_cppdata* cppdata = (ConstitutiveMatrixCartesian_cppdata*) self->cppdata;
+    IntegrationPointsSwarm* swarm = (IntegrationPointsSwarm*)self->integrationSwarm;
+
+    if( cppdata->thread.size() )
+        return;
+    cppdata->thread.resize( Threads_GetMaxCount() );
+    for( auto& thread : cppdata->thread )
+        thread.input = std::make_shared<FEMCoordinate>((void*)swarm->mesh, std::make_shared<ParticleInCellCoordinate>( swarm->localCoordVariable ));
+}
+
+/* The matrix is assembled serially where any of its functions builds shared state lazily. */
+static void _ConstitutiveMatrixCartesian_SetThreadSafe( ConstitutiveMatrixCartesian* self ){
+    ConstitutiveMatrixCartesian_cppdata* cppdata = (ConstitutiveMatrixCartesian_cppdata*) self->cppdata;
+
+    self->threadSafe = ( cppdata->threadSafe_visc1 && cppdata->threadSafe_visc2 && cppdata->threadSafe_director ) ? True : False;
+}
+
 void _ConstitutiveMatrixCartesian_Set_Fn_Visc1( void* _self, Fn::Function* fn_visc1 ){
     ConstitutiveMatrixCartesian*  self = (ConstitutiveMatrixCartesian*)_self;
     
@@ -49,6 +76,7 @@ void _ConstitutiveMatrixCartesian_Set_Fn_Visc1( void* _self, Fn::Function* fn_vi
     std::shared_ptr<ParticleInCellCoordinate> localCoord = std::make_shared<ParticleInCellCoordinate>( swarm->localCoordVariable );
     cppdata->input = std::make_shared<FEMCoordinate>((void*)swarm->mesh, localCoord);
 
+    Fn::Function::ResetThreadSafe();
     cppdata->func_visc1 = fn_visc1->getFunction(cppdata->input.get());
     // check output conforms
     const IO_double* iodub = dynamic_cast<const IO_double*>(cppdata->func_visc1(cppdata->input.get()));
@@ -57,6 +85,12 @@ void _ConstitutiveMatrixCartesian_Set_Fn_Visc1( void* _self, Fn::Function* fn_vi
     if( iodub->size() != 1 )
         throw std::invalid_argument("Viscosity function is expected to return scalar values.");
 
+    _ConstitutiveMatrixCartesian_SetupThreads( self );
+    for( auto& thread : cppdata->thread )
+        thread.blockfunc_visc1 = Fn::Compiler::compile(fn_visc1, thread.input.get());
+    cppdata->threadSafe_visc1 = Fn::Function::ThreadSafe();
+    _ConstitutiveMatrixCartesian_SetThreadSafe( self );
+
 }
 
 void _ConstitutiveMatrixCartesian_Set_Fn_Visc2( void* _self, Fn::Function* fn_visc2 ){
@@ -70,12 +104,22 @@ void _ConstitutiveMatrixCartesian_Set_Fn_Visc2( void* _self, Fn::Function* fn_vi
     std::shared_ptr<ParticleInCellCoordinate> localCoord = std::make_shared<ParticleInCellCoordinate>( swarm->localCoordVariable );
     cppdata->input = std::make_shared<FEMCoordinate>((void*)swarm->mesh, localCoord);
 
+    Fn::Function::ResetThreadSafe();
     cppdata->func_visc2 = fn_visc2->getFunction(cppdata->input.get());
     const IO_double* iodub = dynamic_cast<const IO_double*>(cppdata->func_visc2(cppdata->input.get()));
     if( !iodub )
         throw std::invalid_argument("Second viscosity function is expected to return 'double' type values.");
     if( iodub->size() != 1 )
         throw std::invalid_argument("Second viscosity function is expected to return scalar values.");
+
+    _ConstitutiveMatrixCartesian_SetupThreads( self );
+    for( auto& thread : cppdata->thread )
+        thread.blockfunc_visc2 = Fn::Compiler::compile(fn_visc2, thread.input.get());
+    cppdata->threadSafe_visc2 = Fn::Function::ThreadSafe();
+    _ConstitutiveMatrixCartesian_SetThreadSafe( self );
+
+    // the second viscosity generally yields a non diagonal constitutive matrix
+    self->isDiagonal = False;
     
 }
 
@@ -91,6 +135,7 @@ void _ConstitutiveMatrixCartesian_Set_Fn_Director( void* _self, Fn::Function* fn
     cppdata->input = std::make_shared<FEMCoordinate>((void*)swarm->mesh, localCoord);
     
     // now setup director
+    Fn::Function::ResetThreadSafe();
     cppdata->func_director = fn_director->getFunction(cppdata->input.get());
     const IO_double* iodub = dynamic_cast<const IO_double*>(cppdata->func_director(cppdata->input.get()));
     if( !iodub )
@@ -102,6 +147,12 @@ void _ConstitutiveMatrixCartesian_Set_Fn_Director( void* _self, Fn::Function* fn
            << "Function provided returns values with size " << iodub->size() << ".";
         throw std::invalid_argument(ss.str());
     }
+
+    _ConstitutiveMatrixCartesian_SetupThreads( self );
+    for( auto& thread : cppdata->thread )
+        thread.blockfunc_director = Fn::Compiler::compile(fn_director, thread.input.get());
+    cppdata->threadSafe_director = Fn::Function::ThreadSafe();
+    _ConstitutiveMatrixCartesian_SetThreadSafe( self );
 }
 
 
@@ -118,6 +169,7 @@ ConstitutiveMatrixCartesian* _ConstitutiveMatrixCartesian_New(  CONSTITUTIVEMATR
 
    self->beenHere = 0;
    self->cppdata = (void*) new ConstitutiveMatrixCartesian_cppdata;
+   self->threadSafe = True;
 
    return self;
 }
@@ -253,7 +305,8 @@ void _ConstitutiveMatrixCartesian_AssembleElement(
    Element_NodeIndex       elementNodeCount;
    Node_ElementLocalIndex  rowNode_I;
    Node_ElementLocalIndex  colNode_I;
-   double**                GNx;
+   double                  GNxData[3][MAX_ELEMENT_NODES];
+   double*                 GNx[3] = { GNxData[0], GNxData[1], GNxData[2] };
    double                  detJac;
    Cell_Index              cell_I;
    ElementType*            elementType;
@@ -264,8 +317,13 @@ void _ConstitutiveMatrixCartesian_AssembleElement(
    Dof_Index               rowNodeDof_I;
    Dof_Index               colNodeDof_I;
    Dof_Index               nodeDofCount;
-   double**                Dtilda_B;
-   double                  vel[3], velDerivs[9], *Ni, eta;
+   double                  Dtilda_BData[6][3];
+   double*                 Dtilda_B[6] = { Dtilda_BData[0], Dtilda_BData[1], Dtilda_BData[2], Dtilda_BData[3], Dtilda_BData[4], Dtilda_BData[5] };
+   double*                 D[6];
+   Bool                    isDiagonal;
+   double                  vel[3], velDerivs[9], Ni[MAX_ELEMENT_NODES], eta;
+   /* viscosity derivatives are not available for function based viscosities */
+   double                  derivs[9] = { 0 };
 
    self->sle = sle;
 
@@ -274,15 +332,7 @@ void _ConstitutiveMatrixCartesian_AssembleElement(
    elementNodeCount  = elementType->nodeCount;
    nodeDofCount      = dim;
 
-   /* allocate */
-   if( elementNodeCount > self->max_nElNodes ) {
-       self->max_nElNodes = elementNodeCount;
-       self->GNx = Memory_Realloc_2DArray( self->GNx, double, dim, elementNodeCount );
-       self->Ni =  Memory_Realloc_Array( self->Ni, double, elementNodeCount );
-   }
-   GNx = self->GNx;
-   Ni = self->Ni;
-   Dtilda_B = self->Dtilda_B;
+   assert( elementNodeCount <= MAX_ELEMENT_NODES );
 
    /* Get number of particles per element */
    cell_I            = CellLayout_MapElementIdToCellId( swarm->cellLayout, lElement_I );
@@ -313,19 +363,43 @@ void _ConstitutiveMatrixCartesian_AssembleElement(
     if( cppdata->func_visc2 && !cppdata->func_director )
         throw std::invalid_argument("You do not appear to have a director set. If you have specified a second viscosity, you must also set a director.");
 
-   debug_dynamic_cast<ParticleInCellCoordinate*>(cppdata->input->localCoord())->index() = lElement_I;  // set the elementId as the owning cell for the particleCoord
-   cppdata->input->index() = lElement_I;  // set the elementId for the fem coordinate
-   
+   ConstitutiveMatrixCartesian_cppdata::Thread& thread = cppdata->thread[Threads_GetIndex()];
+   for( unsigned row_I = 0; row_I < 6; row_I++ )
+      D[row_I] = thread.DData[row_I];
+   isDiagonal = self->isDiagonal;
+
+   debug_dynamic_cast<ParticleInCellCoordinate*>(thread.input->localCoord())->index() = lElement_I;  // set the elementId as the owning cell for the particleCoord
+   thread.input->index() = lElement_I;  // set the elementId for the fem coordinate
+
+   /* evaluate functions for all particles in the element. results are stored
+      as [ visc1 | visc2 | director ] within the block output buffer. */
+   std::size_t blockOutputSize = cellParticleCount*( cppdata->func_visc2 ? 2 + dim : 1 );
+   if( thread.blockOutput.size() < blockOutputSize )
+      thread.blockOutput.resize( blockOutputSize );
+   double* visc1Values    = thread.blockOutput.data();
+   double* visc2Values    = visc1Values + cellParticleCount;
+   double* directorValues = visc2Values + cellParticleCount;
+   {
+      Fn::InputBlock block( cellParticleCount, [&thread](std::size_t idx)->const FunctionIO* {
+         debug_dynamic_cast<ParticleInCellCoordinate*>(thread.input->localCoord())->particle_cellId(idx);  // set the particleCoord cellId
+         return thread.input.get();
+      } );
+      thread.blockfunc_visc1( block, visc1Values, 1 );
+      if ( cppdata->func_visc2 ){
+         thread.blockfunc_visc2(    block, visc2Values,    1   );
+         thread.blockfunc_director( block, directorValues, dim );
+      }
+   }
+
 
    /* Loop over points to build Stiffness Matrix */
    for ( cParticle_I = 0 ; cParticle_I < cellParticleCount ; cParticle_I++ ) {
       particle = (IntegrationPoint*) Swarm_ParticleInCellAt( swarm, cell_I, cParticle_I );
 
-      /* Calculate Determinant of Jacobian and Shape Function Global Derivatives */
-      ElementType_ShapeFunctionsGlobalDerivs(
-         elementType,
-         variable1->feMesh, lElement_I,
-         particle->xi, dim, &detJac, GNx );
+      /* Calculate Determinant of Jacobian and Shape Function Global Derivatives (cached while the mesh is unchanged) */
+      FeMesh_GetIntegrationPointShapeFuncs(
+         variable1->feMesh, elementType, lElement_I, cParticle_I,
+         particle->xi, NULL, GNx, &detJac );
 
         /* Evalulate velocity and velocity derivatives at this particle. */
         FeVariable_InterpolateWithinElement(
@@ -333,23 +407,22 @@ void _ConstitutiveMatrixCartesian_AssembleElement(
         FeVariable_InterpolateDerivatives_WithGNx(
            variable1, lElement_I, GNx, velDerivs );
 
-        debug_dynamic_cast<ParticleInCellCoordinate*>(cppdata->input->localCoord())->particle_cellId(cParticle_I);  // set the particleCoord cellId
-
-        /* evaluate function */
-        const IO_double* visc1 = debug_dynamic_cast<const IO_double*>(cppdata->func_visc1(cppdata->input.get()));
-
-        ConstitutiveMatrix_SetIsotropicViscosity( self, visc1->at() );
+        memset( thread.DData, 0, sizeof(thread.DData) );
+        _ConstitutiveMatrixCartesian_AddIsotropicViscosity( dim, D, visc1Values[cParticle_I] );
        
-        if ( cppdata->func_visc2 ){
-            const IO_double* visc2    = debug_dynamic_cast<const IO_double*>(cppdata->func_visc2(cppdata->input.get()));
-            const IO_double* director = debug_dynamic_cast<const IO_double*>(cppdata->func_director(cppdata->input.get()));
-            ConstitutiveMatrix_SetSecondViscosity( self, visc2->at(), director->data() );
+        if ( cppdata->func_visc2 ) {
+            if ( dim == 2 )
+                _ConstitutiveMatrixCartesian2D_AddSecondViscosity( D, visc2Values[cParticle_I], directorValues + cParticle_I*dim );
+            else
+                _ConstitutiveMatrixCartesian3D_AddSecondViscosity( D, visc2Values[cParticle_I], directorValues + cParticle_I*dim );
         }
 
-		eta = self->matrixData[2][2];
+		eta = D[2][2];
 
       /* Turn D Matrix into D~ Matrix by multiplying in the weight and the detJac (this is a shortcut for speed) */
-      ConstitutiveMatrix_MultiplyByValue( constitutiveMatrix, detJac * particle->weight );
+      for( unsigned row_I = 0; row_I < self->rowSize; row_I++ )
+         for( unsigned col_I = 0; col_I < self->columnSize; col_I++ )
+            D[row_I][col_I] *= detJac * particle->weight;
 
       for( rowNode_I = 0 ; rowNode_I < elementNodeCount ; rowNode_I++ ) {
          rowNodeDof_I = rowNode_I*nodeDofCount;
@@ -357,7 +430,10 @@ void _ConstitutiveMatrixCartesian_AssembleElement(
                         Bj_y = GNx[1][rowNode_I];
 
          /* Build D~ * B */
-         ConstitutiveMatrix_Assemble_D_B( constitutiveMatrix, GNx, rowNode_I, Dtilda_B );
+         if ( dim == 2 )
+            _ConstitutiveMatrixCartesian2D_Form_D_B( D, isDiagonal, GNx, rowNode_I, Dtilda_B );
+         else
+            _ConstitutiveMatrixCartesian3D_Form_D_B( D, isDiagonal, GNx, rowNode_I, Dtilda_B );
 
          for( colNode_I = 0 ; colNode_I < elementNodeCount ; colNode_I++ ) {
             colNodeDof_I = colNode_I*nodeDofCount;
@@ -381,8 +457,8 @@ void _ConstitutiveMatrixCartesian_AssembleElement(
 
              DuDx = velDerivs[0]; DuDy = velDerivs[1];
              DvDx = velDerivs[2]; DvDy = velDerivs[3];
-             DetaDu = self->derivs[0] * Bj_x + self->derivs[1] * Bj_y + self->derivs[2] * Ni[rowNode_I];
-             DetaDv = self->derivs[3] * Bj_x + self->derivs[4] * Bj_y + self->derivs[5] * Ni[rowNode_I];
+             DetaDu = derivs[0] * Bj_x + derivs[1] * Bj_y + derivs[2] * Ni[rowNode_I];
+             DetaDv = derivs[3] * Bj_x + derivs[4] * Bj_y + derivs[5] * Ni[rowNode_I];
              intFac = particle->weight * detJac;
 
              fac = eta * Bj_y + DuDy * DetaDu + DvDx * DetaDu;
@@ -475,31 +551,43 @@ double _ConstitutiveMatrixCartesian3D_GetIsotropicViscosity( void* constitutiveM
    return self->matrixData[3][3];
 }
 
+static void _ConstitutiveMatrixCartesian_AddIsotropicViscosity( Dimension_Index dim, double** D, double viscosity ) {
+   if ( dim == 2 ) {
+      D[0][0] += 2.0 * viscosity;
+      D[1][1] += 2.0 * viscosity;
+      D[2][2] += viscosity;
+   }
+   else {
+      D[0][0] += 2.0 * viscosity;
+      D[1][1] += 2.0 * viscosity;
+      D[2][2] += 2.0 * viscosity;
+
+      D[3][3] += viscosity;
+      D[4][4] += viscosity;
+      D[5][5] += viscosity;
+   }
+}
+
 void _ConstitutiveMatrixCartesian2D_IsotropicCorrection( void* constitutiveMatrix, double isotropicCorrection ) {
    ConstitutiveMatrix* self   = (ConstitutiveMatrix*) constitutiveMatrix;
-   double**            D      = self->matrixData;
 
-   D[0][0] += 2.0 * isotropicCorrection;
-   D[1][1] += 2.0 * isotropicCorrection;
-   D[2][2] += isotropicCorrection;
+   _ConstitutiveMatrixCartesian_AddIsotropicViscosity( 2, self->matrixData, isotropicCorrection );
 }
 
 void _ConstitutiveMatrixCartesian3D_IsotropicCorrection( void* constitutiveMatrix, double isotropicCorrection ) {
    ConstitutiveMatrix* self   = (ConstitutiveMatrix*) constitutiveMatrix;
-   double**            D      = self->matrixData;
 
-   D[0][0] += 2.0 * isotropicCorrection;
-   D[1][1] += 2.0 * isotropicCorrection;
-   D[2][2] += 2.0 * isotropicCorrection;
-
-   D[3][3] += isotropicCorrection;
-   D[4][4] += isotropicCorrection;
-   D[5][5] += isotropicCorrection;
+   _ConstitutiveMatrixCartesian_AddIsotropicViscosity( 3, self->matrixData, isotropicCorrection );
 }
 
 void _ConstitutiveMatrixCartesian2D_SetSecondViscosity( void* constitutiveMatrix, double deltaViscosity, const XYZ director ) {
    ConstitutiveMatrix* self      = (ConstitutiveMatrix*) constitutiveMatrix;
-   double**            D         = self->matrixData;
+
+   _ConstitutiveMatrixCartesian2D_AddSecondViscosity( self->matrixData, deltaViscosity, director );
+   self->isDiagonal = False;
+}
+
+static void _ConstitutiveMatrixCartesian2D_AddSecondViscosity( double** D, double deltaViscosity, const XYZ director ) {
    double              n1        = director[ I_AXIS ];
    double              n2        = director[ J_AXIS ];
    double              a0;
@@ -511,13 +599,16 @@ void _ConstitutiveMatrixCartesian2D_SetSecondViscosity( void* constitutiveMatrix
    D[0][0] += -a0 ;  D[0][1] +=  a0 ;  D[0][2] += -a1 ;
    D[1][0] +=  a0 ;  D[1][1] += -a0 ;  D[1][2] +=  a1 ;
    D[2][0] += -a1 ;  D[2][1] +=  a1 ;  D[2][2] +=  a0 - deltaViscosity ;
-
-   self->isDiagonal = False;
 }
 
 void _ConstitutiveMatrixCartesian3D_SetSecondViscosity( void* constitutiveMatrix, double deltaViscosity, const XYZ director ) {
    ConstitutiveMatrix* self      = (ConstitutiveMatrix*) constitutiveMatrix;
-   double**            D         = self->matrixData;
+
+   _ConstitutiveMatrixCartesian3D_AddSecondViscosity( self->matrixData, deltaViscosity, director );
+   self->isDiagonal = False;
+}
+
+static void _ConstitutiveMatrixCartesian3D_AddSecondViscosity( double** D, double deltaViscosity, const XYZ director ) {
    double              n1        = director[ I_AXIS ];
    double              n2        = director[ J_AXIS ];
    double              n3        = director[ K_AXIS ];
@@ -562,8 +653,6 @@ void _ConstitutiveMatrixCartesian3D_SetSecondViscosity( void* constitutiveMatrix
    D[3][0] += a03 ; D[3][1] += a13 ; D[3][2] += a23 ; D[3][3] += a33 ; D[3][4] += a34 ; D[3][5] += a35 ;
    D[4][0] += a04 ; D[4][1] += a14 ; D[4][2] += a24 ; D[4][3] += a34 ; D[4][4] += a44 ; D[4][5] += a45 ;
    D[5][0] += a05 ; D[5][1] += a15 ; D[5][2] += a25 ; D[5][3] += a35 ; D[5][4] += a45 ; D[5][5] += a55 ;
-
-   self->isDiagonal = False;
 }
 
 /*
@@ -572,11 +661,15 @@ void _ConstitutiveMatrixCartesian3D_SetSecondViscosity( void* constitutiveMatrix
       [ d/dy,  d/dx  ]  */
 void _ConstitutiveMatrixCartesian2D_Assemble_D_B( void* constitutiveMatrix, double** GNx, Node_Index node_I, double** D_B ){
    ConstitutiveMatrix* self = (ConstitutiveMatrix*) constitutiveMatrix;
-   double**            D    = self->matrixData;
+
+   _ConstitutiveMatrixCartesian2D_Form_D_B( self->matrixData, self->isDiagonal, GNx, node_I, D_B );
+}
+
+static void _ConstitutiveMatrixCartesian2D_Form_D_B( double** D, Bool isDiagonal, double** GNx, Node_Index node_I, double** D_B ){
    double              d_dx = GNx[ I_AXIS ][ node_I ];
    double              d_dy = GNx[ J_AXIS ][ node_I ];
 
-   if (self->isDiagonal) {
+   if (isDiagonal) {
       D_B[0][0] = D[0][0] * d_dx;
       D_B[0][1] = 0.0;
 
@@ -608,12 +701,16 @@ void _ConstitutiveMatrixCartesian2D_Assemble_D_B( void* constitutiveMatrix, doub
       [    0,  d/dz,   d/dy  ] */
 void _ConstitutiveMatrixCartesian3D_Assemble_D_B( void* constitutiveMatrix, double** GNx, Node_Index node_I, double** D_B ){
    ConstitutiveMatrix* self = (ConstitutiveMatrix*) constitutiveMatrix;
-   double**            D    = self->matrixData;
+
+   _ConstitutiveMatrixCartesian3D_Form_D_B( self->matrixData, self->isDiagonal, GNx, node_I, D_B );
+}
+
+static void _ConstitutiveMatrixCartesian3D_Form_D_B( double** D, Bool isDiagonal, double** GNx, Node_Index node_I, double** D_B ){
    double              d_dx = GNx[ I_AXIS ][ node_I ];
    double              d_dy = GNx[ J_AXIS ][ node_I ];
    double              d_dz = GNx[ K_AXIS ][ node_I ];
 
-   if (self->isDiagonal) {
+   if (isDiagonal) {
       D_B[0][0] = D[0][0] * d_dx;
       D_B[0][1] = 0.0;
       D_B[0][2] = 0.0;
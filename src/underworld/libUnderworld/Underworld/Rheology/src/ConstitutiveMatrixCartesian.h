@@ -23,6 +23,21 @@ struct ConstitutiveMatrixCartesian_cppdata
     Fn::Function::func func_visc2;
     Fn::Function::func func_director;
     std::shared_ptr<FEMCoordinate> input;
+    // whether each function may be evaluated concurrently (see Fn::Function::ThreadSafe)
+    bool threadSafe_visc1    = true;
+    bool threadSafe_visc2    = true;
+    bool threadSafe_director = true;
+    // evaluation state and constitutive matrix for each assembly thread
+    struct Thread
+    {
+        std::shared_ptr<FEMCoordinate> input;
+        Fn::Function::blockfunc blockfunc_visc1;
+        Fn::Function::blockfunc blockfunc_visc2;
+        Fn::Function::blockfunc blockfunc_director;
+        std::vector<double> blockOutput;
+        double DData[6][6];
+    };
+    std::vector<Thread> thread;
 };
 
 void _ConstitutiveMatrixCartesian_Set_Fn_Visc1(    void* _self, Fn::Function* fn_visc1    );
@@ -18,6 +18,7 @@
 #include <Underworld/Function/src/FEMCoordinate.hpp>
 #include <Underworld/Function/src/ParticleInCellCoordinate.hpp>
 #include <Underworld/Function/src/Function.hpp>
+#include <Underworld/Function/src/Compiler.hpp>
 
 #include "Fn_Integrate.h"
 
@@ -81,6 +82,7 @@ void _Fn_Integrate_SetFn( void* _self, Fn::Function* fn ){
     std::shared_ptr<ParticleInCellCoordinate> localCoord = std::make_shared<ParticleInCellCoordinate>( self->integrationSwarm->localCoordVariable );
     cppdata->input = std::make_shared<FEMCoordinate>((void*)self->mesh, localCoord);
     cppdata->func  = fn->getFunction(cppdata->input.get());
+    cppdata->blockfunc = Fn::Compiler::compile(fn, cppdata->input.get());
     
     // check output conforms
     const FunctionIO* io = dynamic_cast<const FunctionIO*>(cppdata->func(cppdata->input.get()));
@@ -126,6 +128,14 @@ IO_double* Fn_Integrate_Integrate( void* fn_integrate ) {
     int                        lElement_I;
 
     Fn_Integrate_cppdata* cppdata = (Fn_Integrate_cppdata*)self->cppdata;
+    unsigned                   fnSize = cppdata->sumLocal->size();
+    double*                    fnValue;
+
+    /* block input simply repositions the fem coordinate onto the required particle */
+    Fn::InputBlock::getter seek = [cppdata](std::size_t idx)->const FunctionIO* {
+        debug_dynamic_cast<ParticleInCellCoordinate*>(cppdata->input->localCoord())->particle_cellId(idx);
+        return cppdata->input.get();
+    };
     
     // init to zero
     for( unsigned ii = 0 ; ii < cppdata->sumLocal->size() ; ii++ )
@@ -144,28 +154,29 @@ IO_double* Fn_Integrate_Integrate( void* fn_integrate ) {
     
         debug_dynamic_cast<ParticleInCellCoordinate*>(cppdata->input->localCoord())->index() = lElement_I;  // set the elementId as the owning cell for the particleCoord
         cppdata->input->index()                                                             = lElement_I;    // set the elementId for the fem coordinate
+
+        /* evaluate function for all particles in element */
+        if ( cppdata->blockOutput.size() < cellParticleCount*fnSize )
+            cppdata->blockOutput.resize( cellParticleCount*fnSize );
+        cppdata->blockfunc( Fn::InputBlock( cellParticleCount, seek ), cppdata->blockOutput.data(), fnSize );
         
         for ( cParticle_I = 0 ; cParticle_I < cellParticleCount ; cParticle_I++ ) {
-            debug_dynamic_cast<ParticleInCellCoordinate*>(cppdata->input->localCoord())->particle_cellId(cParticle_I);  // set the particleCoord cellId
-
             particle = (IntegrationPoint*) Swarm_ParticleInCellAt( swarm, cell_I, cParticle_I );
             xi       = particle->xi;
 
             /* Calculate Determinant of Jacobian and Shape Functions */
             if (!self->isSurfaceIntegral) {
-                jacDet = ElementType_JacobianDeterminant( elementType, mesh, lElement_I, xi, self->dim );
+                FeMesh_GetIntegrationPointShapeFuncs( mesh, elementType, lElement_I, cParticle_I, xi, NULL, NULL, &jacDet );
             } else {
                 double localNormal[3];
                 ElementType_SurfaceNormal( elementType, lElement_I, self->dim, xi, localNormal );
                 jacDet = ElementType_SurfaceJacobianDeterminant( elementType, mesh, lElement_I, xi, self->dim, localNormal );
             }
-            /* evaluate function */
-            const FunctionIO* funcout = debug_dynamic_cast<const FunctionIO*>(cppdata->func(cppdata->input.get()));
-
-            factor = jacDet * particle->weight;
-            for( unsigned ii = 0 ; ii < funcout->size() ; ii++ )
+            factor  = jacDet * particle->weight;
+            fnValue = cppdata->blockOutput.data() + cParticle_I*fnSize;
+            for( unsigned ii = 0 ; ii < fnSize ; ii++ )
             {
-                cppdata->sumLocal->at(ii) += funcout->at<double>(ii)*factor;
+                cppdata->sumLocal->at(ii) += fnValue[ii]*factor;
             }
 
         }
@@ -24,6 +24,8 @@ struct Fn_Integrate_cppdata
     IO_double* sumLocal;
     IO_double* sumGlobal;
     Fn::Function::func func;
+    Fn::Function::blockfunc blockfunc;
+    std::vector<double> blockOutput;
     std::shared_ptr<FEMCoordinate> input;
 };
 
@@ -33,6 +33,7 @@ MatrixAssemblyTerm_NA__NB__Fn* _MatrixAssemblyTerm_NA__NB__Fn_New(  MATRIXASSEMB
 
 /* Virtual info */
     self->cppdata = (void*) new MatrixAssemblyTerm_NA__NB__Fn_cppdata;
+    self->threadSafe = True;
     self->max_nElNodes_col = 0;
     self->max_nElNodes_row = 0;
     self->Ni = NULL;
@@ -53,7 +54,15 @@ void MatrixAssemblyTerm_NA__NB__Fn_SetFn( void* _self, Fn::Function* fn ){
     IntegrationPointsSwarm* swarm = (IntegrationPointsSwarm*)self->integrationSwarm;
     std::shared_ptr<ParticleInCellCoordinate> localCoord = std::make_shared<ParticleInCellCoordinate>( swarm->localCoordVariable );
     cppdata->input = std::make_shared<FEMCoordinate>((void*)swarm->mesh, localCoord);
+    Fn::Function::ResetThreadSafe();
     cppdata->func = fn->getFunction(cppdata->input.get());
+    cppdata->thread.resize( Threads_GetMaxCount() );
+    for( auto& thread : cppdata->thread ) {
+        thread.input = std::make_shared<FEMCoordinate>((void*)swarm->mesh, std::make_shared<ParticleInCellCoordinate>( swarm->localCoordVariable ));
+        thread.func  = fn->getFunction(thread.input.get());
+    }
+    // terms whose function builds shared state lazily are assembled serially
+    self->threadSafe = Fn::Function::ThreadSafe() ? True : False;
 
     // check output conforms
     const IO_double* iodub = dynamic_cast<const IO_double*>(cppdata->func(cppdata->input.get()));
@@ -147,6 +156,7 @@ void _MatrixAssemblyTerm_NA__NB__Fn_AssembleElement(
    Node_ElementLocalIndex              rowNode_I, colNode_I;
    Dof_Index                           colDof_I;
    double                              *xi, *Ni, *Mi;
+   double                              NiData[MAX_ELEMENT_NODES], MiData[MAX_ELEMENT_NODES];
    double                              detJac, weight, F, factor;
    IntegrationPoint*                   intPoint;
    Cell_Index                          cell_I;
@@ -155,8 +165,9 @@ void _MatrixAssemblyTerm_NA__NB__Fn_AssembleElement(
 
 
    MatrixAssemblyTerm_NA__NB__Fn_cppdata* cppdata = (MatrixAssemblyTerm_NA__NB__Fn_cppdata*)self->cppdata;
-   debug_dynamic_cast<ParticleInCellCoordinate*>(cppdata->input->localCoord())->index() = lElement_I;  // set the elementId as the owning cell for the particleCoord
-   cppdata->input->index() = lElement_I;
+   MatrixAssemblyTerm_NA__NB__Fn_cppdata::Thread& thread = cppdata->thread[Threads_GetIndex()];
+   debug_dynamic_cast<ParticleInCellCoordinate*>(thread.input->localCoord())->index() = lElement_I;  // set the elementId as the owning cell for the particleCoord
+   thread.input->index() = lElement_I;
 
    FeMesh*                 geometryMesh = ( self->geometryMesh ? self->geometryMesh : variable_row->feMesh );
    ElementType*            geometryElementType;
@@ -171,28 +182,15 @@ void _MatrixAssemblyTerm_NA__NB__Fn_AssembleElement(
 
    dofPerNode_col = variable_col->fieldComponentCount;
 
-   // allocate shape function array, Mi and Ni
-   if( nodesPerEl_row > self->max_nElNodes_row ) {
-      /* reallocate */
-      if (self->Mi) free(self->Mi);
-      self->Mi = (double*)AllocArray( double, nodesPerEl_row );
-      self->max_nElNodes_row = nodesPerEl_row;
-   }
-
-   if( nodesPerEl_col > self->max_nElNodes_col ) {
-      if( self->Ni) free(self->Ni);
-      self->Ni = (double*)AllocArray(double, nodesPerEl_col );
-      self->max_nElNodes_col = nodesPerEl_col;
-   }
-   Ni = self->Ni;
-   if (elementType_row == elementType_col)
-      Mi = Ni;
+   assert( nodesPerEl_row <= MAX_ELEMENT_NODES && nodesPerEl_col <= MAX_ELEMENT_NODES );
+   Ni = NiData;
+   Mi = ( elementType_row == elementType_col ) ? Ni : MiData;
 
    cell_I = CellLayout_MapElementIdToCellId( swarm->cellLayout, lElement_I );
    cellParticleCount = swarm->cellParticleCountTbl[ cell_I ];
 
    for ( cParticle_I = 0 ; cParticle_I < cellParticleCount ; cParticle_I++ ) {
-      debug_dynamic_cast<ParticleInCellCoordinate*>(cppdata->input->localCoord())->particle_cellId(cParticle_I);  // set the particleCoord cellId
+      debug_dynamic_cast<ParticleInCellCoordinate*>(thread.input->localCoord())->particle_cellId(cParticle_I);  // set the particleCoord cellId
       /* get integration point information */
       intPoint = (IntegrationPoint*)Swarm_ParticleInCellAt( swarm, cell_I, cParticle_I );
       xi = intPoint->xi;
@@ -205,7 +203,7 @@ void _MatrixAssemblyTerm_NA__NB__Fn_AssembleElement(
          ElementType_EvaluateShapeFunctionsAt( elementType_row, xi, Mi );
 
       // /* evaluate function */
-      const IO_double* funcout = debug_dynamic_cast<const IO_double*>(cppdata->func(cppdata->input.get()));
+      const IO_double* funcout = debug_dynamic_cast<const IO_double*>(thread.func(thread.input.get()));
       F = funcout->at();
 
       factor = weight*detJac*F;
@@ -23,6 +23,13 @@
        Fn::Function* fn;
        Fn::Function::func func;
        std::shared_ptr<FEMCoordinate> input;
+       // evaluation state for each assembly thread
+       struct Thread
+       {
+           std::shared_ptr<FEMCoordinate> input;
+           Fn::Function::func func;
+       };
+       std::vector<Thread> thread;
    };
 
    void MatrixAssemblyTerm_NA__NB__Fn_SetFn( void* _self, Fn::Function* fn );
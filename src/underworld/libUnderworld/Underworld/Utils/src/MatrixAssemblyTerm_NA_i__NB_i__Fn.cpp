@@ -32,6 +32,7 @@ MatrixAssemblyTerm_NA_i__NB_i__Fn* _MatrixAssemblyTerm_NA_i__NB_i__Fn_New(  MATR
 
    /* Virtual info */
    self->cppdata = (void*) new MatrixAssemblyTerm_NA_i__NB_i__Fn_cppdata;
+   self->threadSafe = True;
 
    return self;
 }
@@ -47,7 +48,15 @@ void MatrixAssemblyTerm_NA_i__NB_i__Fn_SetFn( void* _self, Fn::Function* fn ){
     IntegrationPointsSwarm* swarm = (IntegrationPointsSwarm*)self->integrationSwarm;
     std::shared_ptr<ParticleInCellCoordinate> localCoord = std::make_shared<ParticleInCellCoordinate>( swarm->localCoordVariable );
     cppdata->input = std::make_shared<FEMCoordinate>((void*)swarm->mesh, localCoord);
+    Fn::Function::ResetThreadSafe();
     cppdata->func = fn->getFunction(cppdata->input.get());
+    cppdata->thread.resize( Threads_GetMaxCount() );
+    for( auto& thread : cppdata->thread ) {
+        thread.input = std::make_shared<FEMCoordinate>((void*)swarm->mesh, std::make_shared<ParticleInCellCoordinate>( swarm->localCoordVariable ));
+        thread.func  = fn->getFunction(thread.input.get());
+    }
+    // terms whose function builds shared state lazily are assembled serially
+    self->threadSafe = Fn::Function::ThreadSafe() ? True : False;
 
     // check output conforms
     const IO_double* iodub = dynamic_cast<const IO_double*>(cppdata->func(cppdata->input.get()));
@@ -142,7 +151,8 @@ void _MatrixAssemblyTerm_NA_i__NB_i__Fn_AssembleElement(
    Index                               nodesPerEl;
    Index                               A,B;
    Index                               i;
-   double**                            GNx;
+   double                              GNxData[3][MAX_ELEMENT_NODES];
+   double*                             GNx[3] = { GNxData[0], GNxData[1], GNxData[2] };
    double                              detJac;
    double                              F;
    Cell_Index                          cell_I;
@@ -151,26 +161,19 @@ void _MatrixAssemblyTerm_NA_i__NB_i__Fn_AssembleElement(
    /* Set the element type */
    elementType = FeMesh_GetElementType( variable1->feMesh, lElement_I );
    nodesPerEl = elementType->nodeCount;
-
-   if( nodesPerEl > self->max_nElNodes ) {
-      /* reallocate */
-      if (self->GNx)
-         free(self->GNx);
-      self->GNx = (double**)AllocArray2D( double, dim, nodesPerEl );
-      self->max_nElNodes = nodesPerEl;
-   }
-   GNx = self->GNx;
+   assert( nodesPerEl <= MAX_ELEMENT_NODES );
 
    MatrixAssemblyTerm_NA_i__NB_i__Fn_cppdata* cppdata = (MatrixAssemblyTerm_NA_i__NB_i__Fn_cppdata*)self->cppdata;
+   MatrixAssemblyTerm_NA_i__NB_i__Fn_cppdata::Thread& thread = cppdata->thread[Threads_GetIndex()];
 
-   debug_dynamic_cast<ParticleInCellCoordinate*>(cppdata->input->localCoord())->index() = lElement_I;  // set the elementId as the owning cell for the particleCoord
-   cppdata->input->index() = lElement_I;  // set the elementId for the fem coordinate
+   debug_dynamic_cast<ParticleInCellCoordinate*>(thread.input->localCoord())->index() = lElement_I;  // set the elementId as the owning cell for the particleCoord
+   thread.input->index() = lElement_I;  // set the elementId for the fem coordinate
 
    cell_I = CellLayout_MapElementIdToCellId( swarm->cellLayout, lElement_I );
    cellParticleCount = swarm->cellParticleCountTbl[ cell_I ];
 
    for( cParticle_I = 0 ; cParticle_I < cellParticleCount ; cParticle_I++ ) {
-      debug_dynamic_cast<ParticleInCellCoordinate*>(cppdata->input->localCoord())->particle_cellId(cParticle_I);  // set the particleCoord cellId
+      debug_dynamic_cast<ParticleInCellCoordinate*>(thread.input->localCoord())->particle_cellId(cParticle_I);  // set the particleCoord cellId
       currIntegrationPoint = (IntegrationPoint*)Swarm_ParticleInCellAt( swarm, cell_I, cParticle_I );
 
       xi = currIntegrationPoint->xi;
@@ -182,7 +185,7 @@ void _MatrixAssemblyTerm_NA_i__NB_i__Fn_AssembleElement(
          xi, dim, &detJac, GNx );
 
       /* evaluate function */
-      const IO_double* funcout = debug_dynamic_cast<const IO_double*>(cppdata->func(cppdata->input.get()));
+      const IO_double* funcout = debug_dynamic_cast<const IO_double*>(thread.func(thread.input.get()));
       F = funcout->at();
 
       for( A=0; A<nodesPerEl; A++ )
@@ -19,6 +19,7 @@
 #include <Underworld/Function/src/FEMCoordinate.hpp>
 #include <Underworld/Function/src/ParticleInCellCoordinate.hpp>
 #include <Underworld/Function/src/Function.hpp>
+#include <Underworld/Function/src/Compiler.hpp>
 
 #include "VectorAssemblyTerm_NA__Fn.h"
 
@@ -41,6 +42,7 @@ VectorAssemblyTerm_NA__Fn* _VectorAssemblyTerm_NA__Fn_New(  FORCEASSEMBLYTERM_NA
 
    /* Virtual info */
    self->cppdata = (void*) new VectorAssemblyTerm_NA__Fn_cppdata;
+   self->threadSafe = True;
    self->geometryMesh = NULL;
 
    return self;
@@ -61,7 +63,15 @@ void _VectorAssemblyTerm_NA__Fn_SetFn( void* _self, Fn::Function* fn ){
     // setup fn
     std::shared_ptr<ParticleInCellCoordinate> localCoord = std::make_shared<ParticleInCellCoordinate>( swarm->localCoordVariable );
     cppdata->input = std::make_shared<FEMCoordinate>((void*)mesh, localCoord);
+    Fn::Function::ResetThreadSafe();
     cppdata->func = fn->getFunction(cppdata->input.get());
+    cppdata->thread.resize( Threads_GetMaxCount() );
+    for( auto& thread : cppdata->thread ) {
+        thread.input = std::make_shared<FEMCoordinate>((void*)mesh, std::make_shared<ParticleInCellCoordinate>( swarm->localCoordVariable ));
+        thread.blockfunc = Fn::Compiler::compile(fn, thread.input.get());
+    }
+    // terms whose function builds shared state lazily are assembled serially
+    self->threadSafe = Fn::Function::ThreadSafe() ? True : False;
     
     // check output conforms
     const FunctionIO* sampleguy = cppdata->func(cppdata->input.get());
@@ -162,9 +172,10 @@ void _VectorAssemblyTerm_NA__Fn_AssembleElement( void* forceTerm, ForceVector* f
    mesh = forceVector->feVariable->feMesh;
 
    VectorAssemblyTerm_NA__Fn_cppdata* cppdata = (VectorAssemblyTerm_NA__Fn_cppdata*)self->cppdata;
+   VectorAssemblyTerm_NA__Fn_cppdata::Thread& thread = cppdata->thread[Threads_GetIndex()];
     
-   debug_dynamic_cast<ParticleInCellCoordinate*>(cppdata->input->localCoord())->index() = lElement_I;  // set the elementId as the owning cell for the particleCoord
-   cppdata->input->index()   = lElement_I;  // set the elementId for the fem coordinate
+   debug_dynamic_cast<ParticleInCellCoordinate*>(thread.input->localCoord())->index() = lElement_I;  // set the elementId as the owning cell for the particleCoord
+   thread.input->index()   = lElement_I;  // set the elementId for the fem coordinate
 
    /* Set the element type */
    elementType = FeMesh_GetElementType( mesh, lElement_I );
@@ -177,8 +188,15 @@ void _VectorAssemblyTerm_NA__Fn_AssembleElement( void* forceTerm, ForceVector* f
    cell_I = CellLayout_MapElementIdToCellId( swarm->cellLayout, lElement_I );
    cellParticleCount = swarm->cellParticleCountTbl[ cell_I ];
 
+   /* evaluate function for all particles in the element */
+   if( thread.blockOutput.size() < cellParticleCount*dofsPerNode )
+      thread.blockOutput.resize( cellParticleCount*dofsPerNode );
+   thread.blockfunc( Fn::InputBlock( cellParticleCount, [&thread](std::size_t idx)->const FunctionIO* {
+         debug_dynamic_cast<ParticleInCellCoordinate*>(thread.input->localCoord())->particle_cellId(idx);  // set the particleCoord cellId
+         return thread.input.get();
+      } ), thread.blockOutput.data(), dofsPerNode );
+
    for ( cParticle_I = 0 ; cParticle_I < cellParticleCount ; cParticle_I++ ) {
-      debug_dynamic_cast<ParticleInCellCoordinate*>(cppdata->input->localCoord())->particle_cellId(cParticle_I);  // set the particleCoord cellId
       particle = (IntegrationPoint*) Swarm_ParticleInCellAt( swarm, cell_I, cParticle_I );
       xi       = particle->xi;
 
@@ -190,13 +208,12 @@ void _VectorAssemblyTerm_NA__Fn_AssembleElement( void* forceTerm, ForceVector* f
 
       ElementType_EvaluateShapeFunctionsAt( elementType, xi, N );
 
-      /* evaluate function */
-      const FunctionIO* funcout = debug_dynamic_cast<const FunctionIO*>(cppdata->func(cppdata->input.get()));
+      const double* funcout = thread.blockOutput.data() + cParticle_I*dofsPerNode;
 
       factor = detJac * particle->weight;
       for( A = 0 ; A < nodesPerEl ; A++ )
          for( i = 0 ; i < dofsPerNode ; i++ )
-            elForceVec[A * dofsPerNode + i ] += factor * funcout->at<double>(i) * N[A] ;
+            elForceVec[A * dofsPerNode + i ] += factor * funcout[i] * N[A] ;
 
    }
 }
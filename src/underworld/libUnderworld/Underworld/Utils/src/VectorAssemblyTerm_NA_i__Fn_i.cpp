@@ -19,6 +19,7 @@
 #include <Underworld/Function/src/FEMCoordinate.hpp>
 #include <Underworld/Function/src/ParticleInCellCoordinate.hpp>
 #include <Underworld/Function/src/Function.hpp>
+#include <Underworld/Function/src/Compiler.hpp>
 
 #include "VectorAssemblyTerm_NA_i__Fn_i.h"
 
@@ -41,6 +42,7 @@ VectorAssemblyTerm_NA_i__Fn_i* _VectorAssemblyTerm_NA_i__Fn_i_New(  FORCEASSEMBL
 
    /* Virtual info */
    self->cppdata = (void*) new VectorAssemblyTerm_NA_i__Fn_i_cppdata;
+   self->threadSafe = True;
    self->geometryMesh = NULL;
 
    return self;
@@ -61,7 +63,15 @@ void _VectorAssemblyTerm_NA_i__Fn_i_SetFn( void* _self, Fn::Function* fn ){
     // setup fn
     std::shared_ptr<ParticleInCellCoordinate> localCoord = std::make_shared<ParticleInCellCoordinate>( swarm->localCoordVariable );
     cppdata->input = std::make_shared<FEMCoordinate>((void*)mesh, localCoord);
+    Fn::Function::ResetThreadSafe();
     cppdata->func = fn->getFunction(cppdata->input.get());
+    cppdata->thread.resize( Threads_GetMaxCount() );
+    for( auto& thread : cppdata->thread ) {
+        thread.input = std::make_shared<FEMCoordinate>((void*)mesh, std::make_shared<ParticleInCellCoordinate>( swarm->localCoordVariable ));
+        thread.blockfunc = Fn::Compiler::compile(fn, thread.input.get());
+    }
+    // terms whose function builds shared state lazily are assembled serially
+    self->threadSafe = Fn::Function::ThreadSafe() ? True : False;
     
     // check output conforms
     const FunctionIO* sampleguy = cppdata->func(cppdata->input.get());
@@ -156,23 +166,22 @@ void _VectorAssemblyTerm_NA_i__Fn_i_AssembleElement( void* forceTerm, ForceVecto
    Cell_Index                 cell_I;
    double                     detJac;
    double                     factor;
+   double                     GNxData[3][MAX_ELEMENT_NODES];
+   double*                    GNx[3] = { GNxData[0], GNxData[1], GNxData[2] };
 
    /* Since we are integrating over the velocity mesh - we want the velocity mesh here and not the temperature mesh */
    mesh = forceVector->feVariable->feMesh;
 
    VectorAssemblyTerm_NA_i__Fn_i_cppdata* cppdata = (VectorAssemblyTerm_NA_i__Fn_i_cppdata*)self->cppdata;
+   VectorAssemblyTerm_NA_i__Fn_i_cppdata::Thread& thread = cppdata->thread[Threads_GetIndex()];
     
-   debug_dynamic_cast<ParticleInCellCoordinate*>(cppdata->input->localCoord())->index() = lElement_I;  // set the elementId as the owning cell for the particleCoord
-   cppdata->input->index()   = lElement_I;  // set the elementId for the fem coordinate
+   debug_dynamic_cast<ParticleInCellCoordinate*>(thread.input->localCoord())->index() = lElement_I;  // set the elementId as the owning cell for the particleCoord
+   thread.input->index()   = lElement_I;  // set the elementId for the fem coordinate
 
    /* Set the element type */
    elementType = FeMesh_GetElementType( mesh, lElement_I );
    nodesPerEl  = elementType->nodeCount;
-   if( nodesPerEl > self->maxNodesPerEl ) { // test if reallocation is required
-      Memory_Free( self->GNx );
-      self->GNx = Memory_Alloc_2DArray_Unnamed( double, dim, nodesPerEl );
-      self->maxNodesPerEl = nodesPerEl;
-   }
+   assert( nodesPerEl <= MAX_ELEMENT_NODES );
 
    /* assumes constant number of dofs per element */
    dofsPerNode = forceVector->feVariable->fieldComponentCount;
@@ -180,16 +189,22 @@ void _VectorAssemblyTerm_NA_i__Fn_i_AssembleElement( void* forceTerm, ForceVecto
    cell_I = CellLayout_MapElementIdToCellId( swarm->cellLayout, lElement_I );
    cellParticleCount = swarm->cellParticleCountTbl[ cell_I ];
 
+   /* evaluate function for all particles in the element */
+   if( thread.blockOutput.size() < cellParticleCount*dim )
+      thread.blockOutput.resize( cellParticleCount*dim );
+   thread.blockfunc( Fn::InputBlock( cellParticleCount, [&thread](std::size_t idx)->const FunctionIO* {
+         debug_dynamic_cast<ParticleInCellCoordinate*>(thread.input->localCoord())->particle_cellId(idx);  // set the particleCoord cellId
+         return thread.input.get();
+      } ), thread.blockOutput.data(), dim );
+
    for ( cParticle_I = 0 ; cParticle_I < cellParticleCount ; cParticle_I++ ) {
-      debug_dynamic_cast<ParticleInCellCoordinate*>(cppdata->input->localCoord())->particle_cellId(cParticle_I);  // set the particleCoord cellId
       particle = (IntegrationPoint*) Swarm_ParticleInCellAt( swarm, cell_I, cParticle_I );
       xi       = particle->xi;
 
       /* Calculate Determinant of Jacobian and Shape Functions */
-      ElementType_ShapeFunctionsGlobalDerivs( elementType, mesh, lElement_I, xi, dim, &detJac, self->GNx );
+      ElementType_ShapeFunctionsGlobalDerivs( elementType, mesh, lElement_I, xi, dim, &detJac, GNx );
 
-      /* evaluate function */
-      const FunctionIO* funcout = debug_dynamic_cast<const FunctionIO*>(cppdata->func(cppdata->input.get()));
+      const double* funcout = thread.blockOutput.data() + cParticle_I*dim;
 
       factor = detJac * particle->weight;
       for( i = 0; i < dofsPerNode; i++ )
@@ -198,7 +213,7 @@ void _VectorAssemblyTerm_NA_i__Fn_i_AssembleElement( void* forceTerm, ForceVecto
          {
             unsigned row = A * dofsPerNode + i;
             for( unsigned dim_i = 0; dim_i < dim; dim_i++ )
-               elForceVec[row] += factor * self->GNx[dim_i][A] * funcout->at<double>(dim_i);
+               elForceVec[row] += factor * GNx[dim_i][A] * funcout[dim_i];
          }
       }
    }
@@ -19,6 +19,7 @@
 #include <Underworld/Function/src/FEMCoordinate.hpp>
 #include <Underworld/Function/src/ParticleInCellCoordinate.hpp>
 #include <Underworld/Function/src/Function.hpp>
+#include <Underworld/Function/src/Compiler.hpp>
 
 #include "VectorAssemblyTerm_NA_j__Fn_ij.h"
 
@@ -41,6 +42,7 @@ VectorAssemblyTerm_NA_j__Fn_ij* _VectorAssemblyTerm_NA_j__Fn_ij_New(  FORCEASSEM
 
    /* Virtual info */
    self->funeForce = (void*) new VectorAssemblyTerm_NA_j__Fn_ij_cppdata;
+   self->threadSafe = True;
 
    return self;
 }
@@ -63,7 +65,15 @@ void _VectorAssemblyTerm_NA_j__Fn_ij_SetFn( void* _self, Fn::Function* fn ){
     // setup fn
     std::shared_ptr<ParticleInCellCoordinate> localCoord = std::make_shared<ParticleInCellCoordinate>( swarm->localCoordVariable );
     funeForce->input = std::make_shared<FEMCoordinate>((void*)mesh, localCoord);
+    Fn::Function::ResetThreadSafe();
     funeForce->func = fn->getFunction(funeForce->input.get());
+    funeForce->thread.resize( Threads_GetMaxCount() );
+    for( auto& thread : funeForce->thread ) {
+        thread.input = std::make_shared<FEMCoordinate>((void*)mesh, std::make_shared<ParticleInCellCoordinate>( swarm->localCoordVariable ));
+        thread.blockfunc = Fn::Compiler::compile(fn, thread.input.get());
+    }
+    // terms whose function builds shared state lazily are assembled serially
+    self->threadSafe = Fn::Function::ThreadSafe() ? True : False;
     
     // check output conforms
     const FunctionIO* sampleguy = funeForce->func(funeForce->input.get());
@@ -175,27 +185,24 @@ void _VectorAssemblyTerm_NA_j__Fn_ij_AssembleElement( void* forceTerm, ForceVect
    Cell_Index                 cell_I;
    double                     detJac;
    double                     factor;
-   double                     **GNx;
+   double                     GNxData[3][MAX_ELEMENT_NODES];
+   double*                    GNx[3] = { GNxData[0], GNxData[1], GNxData[2] };
    const double *             eForce;
  
    /* Since we are integrating over the velocity mesh - we want the velocity mesh here and not the temperature mesh */
    mesh = forceVector->feVariable->feMesh;
 
    VectorAssemblyTerm_NA_j__Fn_ij_cppdata* funeForce      = (VectorAssemblyTerm_NA_j__Fn_ij_cppdata*)self->funeForce;
+   VectorAssemblyTerm_NA_j__Fn_ij_cppdata::Thread& thread = funeForce->thread[Threads_GetIndex()];
     
-   debug_dynamic_cast<ParticleInCellCoordinate*>(funeForce->input->localCoord())->index()      = lElement_I;  // set the elementId as the owning cell for the particleCoord
+   debug_dynamic_cast<ParticleInCellCoordinate*>(thread.input->localCoord())->index()      = lElement_I;  // set the elementId as the owning cell for the particleCoord
 
-   funeForce->input->index()        = lElement_I;  // set the elementId for the fem coordinate
+   thread.input->index()        = lElement_I;  // set the elementId for the fem coordinate
 
    /* Set the element type */
    elementType = FeMesh_GetElementType( mesh, lElement_I );
    nodesPerEl  = elementType->nodeCount;
-   if( nodesPerEl > self->maxNodesPerEl ) { // test if reallocation is required
-       Memory_Free( self->GNx );
-       self->GNx = Memory_Alloc_2DArray_Unnamed( double, dim, nodesPerEl );
-       self->maxNodesPerEl = nodesPerEl;
-   }
-   GNx = self->GNx;
+   assert( nodesPerEl <= MAX_ELEMENT_NODES );
    
    /* assumes constant number of dofs per element */
    dofsPerNode = forceVector->feVariable->fieldComponentCount;
@@ -203,8 +210,16 @@ void _VectorAssemblyTerm_NA_j__Fn_ij_AssembleElement( void* forceTerm, ForceVect
    cell_I = CellLayout_MapElementIdToCellId( swarm->cellLayout, lElement_I );
    cellParticleCount = swarm->cellParticleCountTbl[ cell_I ];
 
+   /* evaluate function for all particles in the element */
+   unsigned fnSize = ( dim == 2 ) ? 3 : 6;
+   if( thread.blockOutput.size() < cellParticleCount*fnSize )
+      thread.blockOutput.resize( cellParticleCount*fnSize );
+   thread.blockfunc( Fn::InputBlock( cellParticleCount, [&thread](std::size_t idx)->const FunctionIO* {
+         debug_dynamic_cast<ParticleInCellCoordinate*>(thread.input->localCoord())->particle_cellId(idx);  // set the particleCoord cellId
+         return thread.input.get();
+      } ), thread.blockOutput.data(), fnSize );
+
    for ( cParticle_I = 0 ; cParticle_I < cellParticleCount ; cParticle_I++ ) {
-      debug_dynamic_cast<ParticleInCellCoordinate*>(funeForce->input->localCoord())->particle_cellId(cParticle_I);  // set the particleCoord cellId
       particle = (IntegrationPoint*) Swarm_ParticleInCellAt( swarm, cell_I, cParticle_I );
       xi       = particle->xi;
      
@@ -212,10 +227,7 @@ void _VectorAssemblyTerm_NA_j__Fn_ij_AssembleElement( void* forceTerm, ForceVect
       /* Calculate Determinant of Jacobian and Shape Functions */
       ElementType_ShapeFunctionsGlobalDerivs( elementType, mesh, lElement_I, xi, dim, &detJac, GNx );
 
-      /* evaluate function */
-      const IO_double* funeForceout      = debug_dynamic_cast<const IO_double*>(funeForce->func(funeForce->input.get()));
-      
-      eForce = funeForceout->data();
+      eForce = thread.blockOutput.data() + cParticle_I*fnSize;
         	  	
       factor = detJac * particle->weight;
  
@@ -23,6 +23,15 @@ struct VectorAssemblyTerm_NA_j__Fn_ij_cppdata
     Fn::Function* fn;
     Fn::Function::func func;
     std::shared_ptr<FEMCoordinate> input;
+    // block evaluation state for each assembly thread, as function
+    // closures and their inputs may not be shared across threads.
+    struct Thread
+    {
+        std::shared_ptr<FEMCoordinate> input;
+        Fn::Function::blockfunc blockfunc;
+        std::vector<double> blockOutput;
+    };
+    std::vector<Thread> thread;
 };
 
 void _VectorAssemblyTerm_NA_j__Fn_ij_SetFn( void* _self, Fn::Function* fn );
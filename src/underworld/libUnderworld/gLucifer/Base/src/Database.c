@@ -32,6 +32,12 @@ char SQL[MAX_QUERY_LEN];
 
 const Type lucDatabase_Type = "lucDatabase";
 
+/* Geometry table, in the database and in each of its shards */
+static const char* lucGeometryTableSQL = "create table IF NOT EXISTS geometry (id INTEGER PRIMARY KEY ASC, object_id INTEGER, timestep INTEGER, rank INTEGER, idx INTEGER, type INTEGER, data_type INTEGER, size INTEGER, count INTEGER, width INTEGER, minimum REAL, maximum REAL, dim_factor REAL, units VARCHAR(32), minX REAL, minY REAL, minZ REAL, maxX REAL, maxY REAL, maxZ REAL, labels VARCHAR(2048), properties VARCHAR(2048), data BLOB, FOREIGN KEY (object_id) REFERENCES object (id) ON DELETE CASCADE ON UPDATE CASCADE, FOREIGN KEY (timestep) REFERENCES timestep (id) ON DELETE CASCADE ON UPDATE CASCADE)";
+
+/* Per shard summary gathered to root for the manifest: bytes saved, bytes written, bounding box */
+#define LUC_SHARD_SUMMARY 8
+
 lucDatabase* _lucDatabase_New(  LUCDATABASE_DEFARGS  )
 {
    lucDatabase*    self;
@@ -51,6 +57,8 @@ lucDatabase* _lucDatabase_New(  LUCDATABASE_DEFARGS  )
    self->memdb     = NULL;
    self->vfs       = NULL;
    self->timeStep  = -1;
+   self->sharddb   = NULL;
+   self->shardComm = MPI_COMM_SELF;
 
    return self;
 }
@@ -85,6 +93,8 @@ void _lucDatabase_Init(
    Bool                 splitTransactions,
    Bool                 compressed,
    Bool                 singleFile,
+   Bool                 sharded,
+   Bool                 aggregate,
    char*                filename,
    char*                vfs,
    Bool                 viewonly )
@@ -143,6 +153,24 @@ void _lucDatabase_Init(
       MPI_Comm_size( self->communicator, &self->nproc );
    }
 
+   /* Sharded output: each processor writes its own geometry to a shard file, or with aggregate
+    * the processors sharing a node gather to the first of them, which writes the node's shard */
+   self->sharded = sharded && self->filename && strlen(self->filename);
+   if (sharded && !self->sharded)
+      Journal_Printf(lucError, "Sharded output requires a filename, gathering to root instead. %s '%s'.\n", self->type, self->name );
+   self->aggregate = self->sharded && aggregate;
+   self->shardComm = MPI_COMM_SELF;
+   self->shardRank = 0;
+   self->shardSize = 1;
+   self->shardPath[0] = 0;
+#if MPI_VERSION >= 3
+   if (self->aggregate)
+   {
+      MPI_Comm_split_type( self->communicator, MPI_COMM_TYPE_SHARED, self->rank, MPI_INFO_NULL, &self->shardComm );
+      MPI_Comm_rank( self->shardComm, &self->shardRank );
+      MPI_Comm_size( self->shardComm, &self->shardSize );
+   }
+#endif
 }
 
 lucDatabase* lucDatabase_New(
@@ -155,13 +183,14 @@ lucDatabase* lucDatabase_New(
    char*             vfs)
 {
    lucDatabase* self = (lucDatabase*)_lucDatabase_DefaultNew("database");
-   _lucDatabase_Init(self, context, NULL, 0, deleteAfter, splitTransactions, compressed, singleFile, filename, vfs, False);
+   _lucDatabase_Init(self, context, NULL, 0, deleteAfter, splitTransactions, compressed, singleFile, False, False, filename, vfs, False);
    return self;
 }
 
 void _lucDatabase_Delete( void* database )
 {
    lucDatabase* self = (lucDatabase*)database;
+   int finalised;
 
    /* Delete geometry data stores */
    lucGeometryType type;
@@ -175,6 +204,10 @@ void _lucDatabase_Delete( void* database )
    if (self->db) sqlite3_close(self->db);
    if (self->db2) sqlite3_close(self->db2);
    if (self->memdb) sqlite3_close(self->memdb);
+   if (self->sharddb) sqlite3_close(self->sharddb);
+   /* Databases may be garbage collected after MPI has been finalised */
+   MPI_Finalized(&finalised);
+   if (self->shardComm != MPI_COMM_SELF && !finalised) MPI_Comm_free(&self->shardComm);
 
    if (self->filename) Memory_Free(self->filename);
    if (self->vfs) Memory_Free(self->vfs);
@@ -200,6 +233,8 @@ void _lucDatabase_AssignFromXML( void* database, Stg_ComponentFactory* cf, void*
       Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"splitTransactions", True),
       Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"compressed", True),
       Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"singleFile", True),
+      Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"sharded", False),
+      Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"aggregate", False),
       Stg_ComponentFactory_GetString( cf, self->name, (Dictionary_Entry_Key)"filename", NULL),
       Stg_ComponentFactory_GetString( cf, self->name, (Dictionary_Entry_Key)"vfs", NULL),
       Stg_ComponentFactory_GetBool( cf, self->name, (Dictionary_Entry_Key)"viewonly", False  )
@@ -210,6 +245,20 @@ void _lucDatabase_Build( void* database, void* data ) {}
 
 void _lucDatabase_Initialise( void* database, void* data ) {}
 
+static void lucDatabase_DeleteExpired(lucDatabase* self)
+{
+   /* If a data window is set, delete expired geometry */
+   if (self->deleteAfter > 0 )
+   {
+      int deleteEnd = self->timeStep - self->deleteAfter - 1;
+      if (deleteEnd >= 0)
+         lucDatabase_DeleteGeometry(self, -1, deleteEnd);
+   }
+
+   /* Remove any geometry at current timestep before insertion */
+   lucDatabase_DeleteGeometry(self, self->timeStep, self->timeStep);
+}
+
 void _lucDatabase_Execute( void* database, void* data ) 
 {
    /* This begins the transaction, if drawing objects assigned
@@ -247,6 +296,22 @@ void _lucDatabase_Execute( void* database, void* data )
       }
    }
 
+   if (self->sharded)
+   {
+      /* Shard writers label their geometry with the object ids assigned on root */
+      if (objectCount)
+      {
+         int* ids = Memory_Alloc_Array(int, objectCount, "object ids");
+         for ( object_I = 0 ; object_I < objectCount ; object_I++ )
+            ids[object_I] = ((lucDrawingObject*)NamedObject_Register_GetByIndex( dr, object_I ))->id;
+         MPI_Bcast(ids, objectCount, MPI_INT, 0, self->communicator);
+         for ( object_I = 0 ; object_I < objectCount ; object_I++ )
+            ((lucDrawingObject*)NamedObject_Register_GetByIndex( dr, object_I ))->id = ids[object_I];
+         Memory_Free(ids);
+      }
+      lucDatabase_OpenShard(self);
+   }
+
    /* Call setup on drawing objects (if any) !This must be called on all procs! */
    for ( object_I = 0 ; object_I < objectCount ; object_I++ )
    {
@@ -273,6 +338,7 @@ void _lucDatabase_Execute( void* database, void* data )
             /* Remove any existing data in the memory copy (can only be one timestep) */
             lucDatabase_IssueSQL(self->memdb, "delete from geometry");
             lucDatabase_IssueSQL(self->memdb, "delete from timestep");
+            if (self->sharded) lucDatabase_IssueSQL(self->memdb, "delete from shard");
          }
  
          if (self->timeStep > 0)
@@ -289,16 +355,7 @@ void _lucDatabase_Execute( void* database, void* data )
       if (!self->splitTransactions)
          Journal_Firewall(lucDatabase_BeginTransaction(self), lucError, "Begin transaction failed! %s '%s'.\n", self->type, self->name );
 
-      /* If a data window is set, delete expired geometry */
-      if (self->deleteAfter > 0 )
-      {
-         int deleteEnd = self->timeStep - self->deleteAfter - 1;
-         if (deleteEnd >= 0)
-            lucDatabase_DeleteGeometry(self, -1, deleteEnd);
-      }
-
-      /* Remove any geometry at current timestep before insertion */
-      lucDatabase_DeleteGeometry(self, self->timeStep, self->timeStep);
+      lucDatabase_DeleteExpired(self);
 
       /* Enter timestep in database */
       /* Write and update timestep */
@@ -309,6 +366,11 @@ void _lucDatabase_Execute( void* database, void* data )
       if (!self->singleFile && self->timeStep > 0)
         if (!lucDatabase_IssueSQL(self->db2, SQL)) return;
    }
+   else if (self->sharded)
+   {
+      /* Shards hold their own geometry */
+      lucDatabase_DeleteExpired(self);
+   }
 
    /* If we have global list of drawing objects to output, process them here */
    for ( object_I = 0 ; object_I < objectCount ; object_I++ )
@@ -433,6 +495,8 @@ void lucDatabase_ClearGeometry(lucDatabase* self)
       if (self->labels[type]) self->labels[type][0] = 0;
 }
 
+static void lucDatabase_OutputShards(lucDatabase* self, int object_id);
+
 void lucDatabase_OutputGeometry(lucDatabase* self, int object_id)
 {
    lucGeometryType type;
@@ -442,6 +506,13 @@ void lucDatabase_OutputGeometry(lucDatabase* self, int object_id)
    double time, gtotal = 0, wtotal = 0;
    //Journal_Printf(lucDebug, "gLucifer: writing geometry to database ...\n");
 
+   if (self->sharded)
+   {
+      lucDatabase_OutputShards(self, object_id);
+      lucDatabase_ClearGeometry(self);
+      return;
+   }
+
    /* Write geometry to database */
    time = MPI_Wtime();
    if (self->rank > 0 || !self->splitTransactions || lucDatabase_BeginTransaction(self))
@@ -498,68 +569,80 @@ void lucDatabase_OutputGeometry(lucDatabase* self, int object_id)
  *  offsets: per proc offsets return array
  *  returns total elements to be received on root
  ***/
-int lucDatabase_GatherCounts(lucDatabase* self, int count, int* counts, int* offsets)
+static int _lucDatabase_GatherCounts(MPI_Comm comm, int count, int* counts, int* offsets)
 {
    /* Get the count on each proc */
    int p, total = 0;
-   (void)MPI_Gather(&count, 1, MPI_INT, counts, 1, MPI_INT, 0, self->communicator);
+   int rank, nproc;
+   MPI_Comm_rank(comm, &rank);
+   MPI_Comm_size(comm, &nproc);
+   (void)MPI_Gather(&count, 1, MPI_INT, counts, 1, MPI_INT, 0, comm);
 
    /* Now we have count per proc, calculate offsets and total */
-   if (self->rank == 0)
+   if (rank == 0)
    {
-      for (p=0; p<self->nproc; p++) /* Get offset */
+      for (p=0; p<nproc; p++) /* Get offset */
       {
          offsets[p] = p==0 ? 0 : offsets[p-1] + counts[p-1];
       }
-      total = offsets[self->nproc-1] + counts[self->nproc-1];
+      total = offsets[nproc-1] + counts[nproc-1];
       /* All values already on root? no gather required */
       //if (total == count) total = 0;
    }
 
    /* Return total elements to be received */
-   MPI_Bcast(&total, 1, MPI_INT, 0, self->communicator);
+   MPI_Bcast(&total, 1, MPI_INT, 0, comm);
    return total;
 }
 
-void lucDatabase_GatherGeometry(lucDatabase* self, lucGeometryType type, lucGeometryDataType data_type)
+int lucDatabase_GatherCounts(lucDatabase* self, int count, int* counts, int* offsets)
+{
+   return _lucDatabase_GatherCounts(self->communicator, count, counts, offsets);
+}
+
+/* Gathers a geometry block to the first processor of comm */
+static void _lucDatabase_GatherGeometry(lucDatabase* self, MPI_Comm comm, lucGeometryType type, lucGeometryDataType data_type)
 {
    lucGeometryData* block = self->data[type][data_type];
    /* Get the count on each proc */
    int *counts = NULL, *offsets = NULL;
    int p, total = 0;
+   int rank, nproc;
    float *data = NULL;
-   if (self->rank == 0)
+   MPI_Comm_rank(comm, &rank);
+   MPI_Comm_size(comm, &nproc);
+   if (rank == 0)
    {
-      counts = Memory_Alloc_Array(int, self->nproc, "counts");
-      offsets = Memory_Alloc_Array(int, self->nproc, "offsets");
+      counts = Memory_Alloc_Array(int, nproc, "counts");
+      offsets = Memory_Alloc_Array(int, nproc, "offsets");
    }
 
-   total = lucDatabase_GatherCounts(self, block->count, counts, offsets);
+   total = _lucDatabase_GatherCounts(comm, block->count, counts, offsets);
 
    if (total > 0)
    {
-      if (self->rank == 0)
+      if (rank == 0)
          data = Memory_Alloc_Array(float, total, "FloatData");
 
-      (void)MPI_Gatherv(block->data, block->count, MPI_FLOAT, data, counts, offsets, MPI_FLOAT, 0, self->communicator);
+      (void)MPI_Gatherv(block->data, block->count, MPI_FLOAT, data, counts, offsets, MPI_FLOAT, 0, comm);
 
       /* Reduce to get minimum & maximum from all procs */
       float min, max;
       float bmin[3], bmax[3];
       int width = 0;
-      MPI_Reduce( &block->minimum, &min, 1, MPI_FLOAT, MPI_MIN, 0, self->communicator );
-      MPI_Reduce( &block->maximum, &max, 1, MPI_FLOAT, MPI_MAX, 0, self->communicator );
-      MPI_Reduce( block->min, &bmin, 3, MPI_FLOAT, MPI_MIN, 0, self->communicator );
-      MPI_Reduce( block->max, &bmax, 3, MPI_FLOAT, MPI_MAX, 0, self->communicator );
+      MPI_Reduce( &block->minimum, &min, 1, MPI_FLOAT, MPI_MIN, 0, comm );
+      MPI_Reduce( &block->maximum, &max, 1, MPI_FLOAT, MPI_MAX, 0, comm );
+      MPI_Reduce( block->min, &bmin, 3, MPI_FLOAT, MPI_MIN, 0, comm );
+      MPI_Reduce( block->max, &bmax, 3, MPI_FLOAT, MPI_MAX, 0, comm );
       memcpy(block->min, bmin, sizeof(float) * 3);
       memcpy(block->max, bmax, sizeof(float) * 3);
       if (data_type == lucVertexData)
-         MPI_Reduce( &block->width, &width, 1, MPI_INT, MPI_SUM, 0, self->communicator );
-      if (self->rank == 0)
+         MPI_Reduce( &block->width, &width, 1, MPI_INT, MPI_SUM, 0, comm );
+      if (rank == 0)
       {
          //Journal_Printf(lucDebug, "Gathered %d values, took %f sec\n", total, MPI_Wtime() - time);
          /* Add new data on master */
-         for (p=1; p<self->nproc; p++)
+         for (p=1; p<nproc; p++)
          {
             if (counts[p] == 0) continue;
 
@@ -578,32 +661,40 @@ void lucDatabase_GatherGeometry(lucDatabase* self, lucGeometryType type, lucGeom
    Memory_Free(offsets);
 }
 
-void lucDatabase_GatherLabels(lucDatabase* self, lucGeometryType type)
+void lucDatabase_GatherGeometry(lucDatabase* self, lucGeometryType type, lucGeometryDataType data_type)
+{
+   _lucDatabase_GatherGeometry(self, self->communicator, type, data_type);
+}
+
+static void _lucDatabase_GatherLabels(lucDatabase* self, MPI_Comm comm, lucGeometryType type)
 {
    /* Get the count on each proc */
    int p;
    int *counts = NULL, *offsets = NULL;
    int total = 0;
+   int rank, nproc;
    char *data = NULL;
-   if (self->rank == 0)
+   MPI_Comm_rank(comm, &rank);
+   MPI_Comm_size(comm, &nproc);
+   if (rank == 0)
    {
-      counts = Memory_Alloc_Array(int, self->nproc, "counts");
-      offsets = Memory_Alloc_Array(int, self->nproc, "offsets");
+      counts = Memory_Alloc_Array(int, nproc, "counts");
+      offsets = Memory_Alloc_Array(int, nproc, "offsets");
    }
    int length = self->labels[type] ? strlen(self->labels[type])+1 : 0;
-   total = lucDatabase_GatherCounts(self, length, counts, offsets);
+   total = _lucDatabase_GatherCounts(comm, length, counts, offsets);
 
    /* Gather labels */
    if (total > 0)
    {
-      if (self->rank == 0)
+      if (rank == 0)
          data = Memory_Alloc_Array(char, total, "LabelData");
 
-      (void)MPI_Gatherv(self->labels[type], length, MPI_CHAR, data, counts, offsets, MPI_CHAR, 0, self->communicator);
-      if (self->rank == 0)
+      (void)MPI_Gatherv(self->labels[type], length, MPI_CHAR, data, counts, offsets, MPI_CHAR, 0, comm);
+      if (rank == 0)
       {
          /* Add new data on master */
-         for (p=1; p<self->nproc; p++)/* Get displacements */
+         for (p=1; p<nproc; p++)/* Get displacements */
          {
             if (counts[p] == 0) continue;
             lucDatabase_AddLabel(self, type, &data[offsets[p]]);
@@ -616,6 +707,119 @@ void lucDatabase_GatherLabels(lucDatabase* self, lucGeometryType type)
    Memory_Free(offsets);
 }
 
+void lucDatabase_GatherLabels(lucDatabase* self, lucGeometryType type)
+{
+   _lucDatabase_GatherLabels(self, self->communicator, type);
+}
+
+/* Writes geometry to the shards, gathering it to each node's writer first when aggregating, then records
+ * the shards holding it in the manifest on root */
+static void lucDatabase_OutputShards(lucDatabase* self, int object_id)
+{
+   lucGeometryType type;
+   lucGeometryDataType data_type;
+   float range[lucMaxType][lucMaxDataType][2];
+   float grange[lucMaxType][lucMaxDataType][2];
+   double summary[LUC_SHARD_SUMMARY] = {0, 0, HUGE_VAL, HUGE_VAL, HUGE_VAL, -HUGE_VAL, -HUGE_VAL, -HUGE_VAL};
+   double* summaries = NULL;
+   double time = MPI_Wtime();
+   int p, d;
+
+   /* Value ranges are global so every shard is coloured alike (minima and negated maxima reduced together) */
+   for (type=lucMinType; type<lucMaxType; type++)
+   {
+      for (data_type=lucMinDataType; data_type<lucMaxDataType; data_type++)
+      {
+         range[type][data_type][0] = self->data[type][data_type]->minimum;
+         range[type][data_type][1] = -self->data[type][data_type]->maximum;
+      }
+   }
+   (void)MPI_Allreduce(range, grange, 2 * lucMaxType * lucMaxDataType, MPI_FLOAT, MPI_MIN, self->communicator);
+   for (type=lucMinType; type<lucMaxType; type++)
+      for (data_type=lucMinDataType; data_type<lucMaxDataType; data_type++)
+         lucGeometryData_Setup(self->data[type][data_type], grange[type][data_type][0], -grange[type][data_type][1]);
+
+   if (self->shardSize > 1)
+   {
+      for (type=lucMinType; type<lucMaxType; type++)
+      {
+         for (data_type=lucMinDataType; data_type<lucMaxDataType; data_type++)
+            _lucDatabase_GatherGeometry(self, self->shardComm, type, data_type);
+         _lucDatabase_GatherLabels(self, self->shardComm, type);
+      }
+   }
+
+   /* Each writer commits its own shard */
+   if (self->shardRank == 0 && self->sharddb)
+   {
+      lucDatabase_IssueSQL(self->sharddb, "BEGIN EXCLUSIVE TRANSACTION");
+      for (type=lucMinType; type<lucMaxType; type++)
+      {
+         lucGeometryData* vertices = self->data[type][lucVertexData];
+         if (vertices->count)
+         {
+            for (d=0; d<3; d++)
+            {
+               summary[2+d] = fmin(summary[2+d], vertices->min[d]);
+               summary[5+d] = fmax(summary[5+d], vertices->max[d]);
+            }
+         }
+
+         for (data_type=lucMinDataType; data_type<lucMaxDataType; data_type++)
+         {
+            lucGeometryData* data = self->data[type][data_type];
+            summary[0] += data->count * sizeof(float);
+            if (self->labels[type]) data->labels = self->labels[type];
+            summary[1] += lucDatabase_WriteGeometry(self, 0, type, data_type, object_id, data);
+         }
+      }
+      lucDatabase_IssueSQL(self->sharddb, "COMMIT");
+   }
+
+   /* Manifest, written once every shard is committed */
+   if (self->rank == 0)
+      summaries = Memory_Alloc_Array(double, LUC_SHARD_SUMMARY * self->nproc, "shard summaries");
+   (void)MPI_Gather(summary, LUC_SHARD_SUMMARY, MPI_DOUBLE, summaries, LUC_SHARD_SUMMARY, MPI_DOUBLE, 0, self->communicator);
+   if (self->rank == 0)
+   {
+      sqlite3* db = self->db2 ? self->db2 : self->db;
+      double bytes = 0, outbytes = 0;
+      int shards = 0;
+      char path[MAX_PATH];
+      char* name;
+
+      if (!self->splitTransactions || lucDatabase_BeginTransaction(self))
+      {
+         for (p=0; p<self->nproc; p++)
+         {
+            double* shard = &summaries[p * LUC_SHARD_SUMMARY];
+            if (shard[0] == 0) continue;
+
+            /* Paths are relative to the manifest */
+            lucDatabase_ShardPath(self, p, self->timeStep, path);
+            name = strrchr(path, '/');
+            name = name ? name + 1 : path;
+            for (d=0; d<3; d++)
+               if (shard[2+d] > shard[5+d]) shard[2+d] = shard[5+d] = 0;
+
+            snprintf(SQL, MAX_QUERY_LEN, "insert into shard (object_id, timestep, rank, path, bytes, minX, minY, minZ, maxX, maxY, maxZ) values (%d, %d, %d, '%s', %d, %g, %g, %g, %g, %g, %g)", object_id, self->timeStep, p, name, (int)shard[1], shard[2], shard[3], shard[4], shard[5], shard[6], shard[7]);
+            lucDatabase_IssueSQL(db, SQL);
+
+            bytes += shard[0];
+            outbytes += shard[1];
+            shards++;
+         }
+
+         if (self->splitTransactions)
+            lucDatabase_Commit(self);
+      }
+
+      if (bytes > 0)
+         Journal_Printf(lucInfo, "    %.3f kb of geometry data saved, %.3f kb written to %d shards, took %f sec.\n", bytes/1000.0f, outbytes/1000.0f, shards, MPI_Wtime() - time);
+      Memory_Free(summaries);
+   }
+}
+
 /* Direct write functions to enter data into geom data store */
 void lucDatabase_AddGridVertices(lucDatabase* self, int n, int width, float* data)
 {
@@ -847,10 +1051,48 @@ void lucDatabase_OpenDatabase(lucDatabase* self)
    }
 }
 
+void lucDatabase_ShardPath(lucDatabase* self, int rank, int timeStep, char* path)
+{
+   /* Shards follow the per timestep files of a multi-file database */
+   if (!self->singleFile && timeStep > 0)
+      snprintf(path, MAX_PATH, "%s%05d.p%05d.gldb", self->filename, timeStep, rank);
+   else
+      snprintf(path, MAX_PATH, "%s.p%05d.gldb", self->filename, rank);
+}
+
+void lucDatabase_OpenShard(lucDatabase* self)
+{
+   char path[MAX_PATH];
+   if (!self->sharded || self->shardRank > 0) return;
+
+   /* Skip if shard already open */
+   lucDatabase_ShardPath(self, self->rank, self->timeStep, path);
+   if (self->sharddb && strcmp(path, self->shardPath) == 0) return;
+
+   if (self->sharddb)
+      sqlite3_close(self->sharddb);
+
+   if (sqlite3_open_v2(path, &self->sharddb, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, self->vfs))
+   {
+      Journal_Printf(lucError, "Can't open database: (%s) %s\n", path, sqlite3_errmsg(self->sharddb));
+      self->sharddb = NULL;
+      return;
+   }
+   strcpy(self->shardPath, path);
+
+   sqlite3_busy_timeout(self->sharddb, 10000);
+   lucDatabase_IssueSQL(self->sharddb, lucGeometryTableSQL);
+   Journal_Printf(lucDebug, "Database shard %s opened\n", path);
+}
+
 void lucDatabase_CreateDatabase(lucDatabase* self)
 {
    /* Create database tables */
-   lucDatabase_IssueSQL(self->db, "create table IF NOT EXISTS geometry (id INTEGER PRIMARY KEY ASC, object_id INTEGER, timestep INTEGER, rank INTEGER, idx INTEGER, type INTEGER, data_type INTEGER, size INTEGER, count INTEGER, width INTEGER, minimum REAL, maximum REAL, dim_factor REAL, units VARCHAR(32), minX REAL, minY REAL, minZ REAL, maxX REAL, maxY REAL, maxZ REAL, labels VARCHAR(2048), properties VARCHAR(2048), data BLOB, FOREIGN KEY (object_id) REFERENCES object (id) ON DELETE CASCADE ON UPDATE CASCADE, FOREIGN KEY (timestep) REFERENCES timestep (id) ON DELETE CASCADE ON UPDATE CASCADE)");
+   lucDatabase_IssueSQL(self->db, lucGeometryTableSQL);
+
+   /* Manifest of the shards holding each object's geometry */
+   if (self->sharded)
+      lucDatabase_IssueSQL(self->db, "create table IF NOT EXISTS shard (id INTEGER PRIMARY KEY ASC, object_id INTEGER, timestep INTEGER, rank INTEGER, path VARCHAR(1024), bytes INTEGER, minX REAL, minY REAL, minZ REAL, maxX REAL, maxY REAL, maxZ REAL, FOREIGN KEY (object_id) REFERENCES object (id) ON DELETE CASCADE ON UPDATE CASCADE, FOREIGN KEY (timestep) REFERENCES timestep (id) ON DELETE CASCADE ON UPDATE CASCADE)");
 
    /* Delete structure tables, always recreated */
    lucDatabase_IssueSQL(self->db, "drop table IF EXISTS object_colourmap");
@@ -919,14 +1161,27 @@ void lucDatabase_AttachDatabase(lucDatabase* self)
 
 void lucDatabase_DeleteGeometry(lucDatabase* self, int start_timestep, int end_timestep)
 {
-   if (self->rank > 0) return;
+   char range[64];
    /* Remove data over timestep range */
    if (start_timestep < 0)
-      snprintf(SQL, MAX_QUERY_LEN,  "delete from geometry where timestep <= %d; delete from timestep where id <= %d;", end_timestep, end_timestep);
+      snprintf(range, sizeof(range), "<= %d", end_timestep);
    else if (end_timestep < 0)
-      snprintf(SQL, MAX_QUERY_LEN,  "delete from geometry where timestep >= %d; delete from timestep where id >= %d;", start_timestep, start_timestep);
+      snprintf(range, sizeof(range), ">= %d", start_timestep);
+   else
+      snprintf(range, sizeof(range), "between %d and %d", start_timestep, end_timestep);
+
+   /* Shard writers remove their own geometry */
+   if (self->sharded && self->sharddb)
+   {
+      snprintf(SQL, MAX_QUERY_LEN,  "delete from geometry where timestep %s;", range);
+      lucDatabase_IssueSQL(self->sharddb, SQL);
+   }
+
+   if (self->rank > 0) return;
+   if (self->sharded)
+      snprintf(SQL, MAX_QUERY_LEN,  "delete from shard where timestep %s; delete from timestep where id %s;", range, range);
    else
-      snprintf(SQL, MAX_QUERY_LEN,  "delete from geometry where timestep between %d and %d; delete from timestep where id between %d and %d;", start_timestep, end_timestep, start_timestep, end_timestep);
+      snprintf(SQL, MAX_QUERY_LEN,  "delete from geometry where timestep %s; delete from timestep where id %s;", range, range);
 
    lucDatabase_IssueSQL(self->db, SQL);
 }
@@ -935,6 +1190,7 @@ int lucDatabase_WriteGeometry(lucDatabase* self, int index, lucGeometryType type
 {
    sqlite3* db = self->db;
    if (self->db2) db = self->db2; //Use secondary per-timestep database
+   if (self->sharded) db = self->sharddb; //Use own shard
    sqlite3_stmt* statement;
    if (!block->count) return 0;
    
@@ -968,7 +1224,7 @@ int lucDatabase_WriteGeometry(lucDatabase* self, int index, lucGeometryType type
    if (block->min[1] > block->max[1]) block->min[1] = block->max[1] = 0;
    if (block->min[2] > block->max[2]) block->min[2] = block->max[2] = 0;
 
-   snprintf(SQL, MAX_QUERY_LEN, "insert into geometry (object_id, timestep, rank, idx, type, data_type, size, count, width, minimum, maximum, dim_factor, units, minX, minY, minZ, maxX, maxY, maxZ, labels, data) values (%d, %d, %d, %d, %d, %d, %d, %d, %d, %g, %g, %g, '%s', %g, %g, %g, %g, %g, %g, ?, ?)", object_id, self->timeStep, 0, index, type, data_type, block->size, block->count, block->width, block->minimum, block->maximum, 1.0, "", block->min[0], block->min[1], block->min[2], block->max[0], block->max[1], block->max[2]);
+   snprintf(SQL, MAX_QUERY_LEN, "insert into geometry (object_id, timestep, rank, idx, type, data_type, size, count, width, minimum, maximum, dim_factor, units, minX, minY, minZ, maxX, maxY, maxZ, labels, data) values (%d, %d, %d, %d, %d, %d, %d, %d, %d, %g, %g, %g, '%s', %g, %g, %g, %g, %g, %g, ?, ?)", object_id, self->timeStep, self->sharded ? self->rank : 0, index, type, data_type, block->size, block->count, block->width, block->minimum, block->maximum, 1.0, "", block->min[0], block->min[1], block->min[2], block->max[0], block->max[1], block->max[2]);
 
    /* Prepare statement... */
    if (sqlite3_prepare_v2(db, SQL, -1, &statement, NULL) != SQLITE_OK)
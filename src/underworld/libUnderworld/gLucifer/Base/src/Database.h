@@ -66,7 +66,15 @@ extern const Type lucDatabase_Type;
       int               rank;                   \
       int               nproc;                  \
       MPI_Comm          communicator;           \
-      int               timeStep;
+      int               timeStep;               \
+      /* Sharded output: geometry written by shard writers, root writes a manifest */ \
+      Bool              sharded;                \
+      Bool              aggregate;              \
+      MPI_Comm          shardComm;              \
+      int               shardRank;              \
+      int               shardSize;              \
+      sqlite3*          sharddb;                \
+      char              shardPath[MAX_PATH];
 
 struct lucDatabase
 {
@@ -139,6 +147,10 @@ void lucGeometryData_Read(lucGeometryData* self, int items, float* data); //, in
 void lucGeometryData_Setup(lucGeometryData* self, float min, float max);
 
 void lucDatabase_OpenDatabase(lucDatabase* self);
+/** Opens this processor's shard of a sharded database, if it writes one, for the current timestep. */
+void lucDatabase_OpenShard(lucDatabase* self);
+/** Writes the path of a shard, for the processor (rank) writing it, to path. */
+void lucDatabase_ShardPath(lucDatabase* self, int rank, int timeStep, char* path);
 void lucDatabase_CreateDatabase(lucDatabase* self);
 Bool lucDatabase_IssueSQL(sqlite3* db, const char* SQL);
 Bool lucDatabase_BeginTransaction(lucDatabase* self);
@@ -114,9 +114,11 @@ lucSwarmViewer* _lucSwarmViewer_New(  LUCSWARMVIEWER_DEFARGS  )
 void _lucSwarmViewer_Init(
    lucSwarmViewer*            self,
    GeneralSwarm*              swarm,
-   lucColourMap*              opacityColourMap)
+   lucColourMap*              opacityColourMap,
+   unsigned                   maxPoints)
 {
    self->swarm               = swarm;
+   self->maxPoints           = maxPoints;
 
    /* Create a default colour component mapping, full range black->white */
    self->opacityColourMap = opacityColourMap;
@@ -194,7 +196,8 @@ void _lucSwarmViewer_AssignFromXML( void* drawingObject, Stg_ComponentFactory* c
    _lucSwarmViewer_Init(
       self,
       swarm,
-      Stg_ComponentFactory_ConstructByKey( cf, self->name, (Dictionary_Entry_Key)"OpacityColourMap", lucColourMap, False, data) );
+      Stg_ComponentFactory_ConstructByKey( cf, self->name, (Dictionary_Entry_Key)"OpacityColourMap", lucColourMap, False, data),
+      Stg_ComponentFactory_GetUnsignedInt( cf, self->name, (Dictionary_Entry_Key)"maxPoints", 0 ) );
 }
 
 void _lucSwarmViewer_Build( void* drawingObject, void* data )
@@ -225,6 +228,7 @@ void _lucSwarmViewer_Draw( void* drawingObject, lucDatabase* database, void* _co
    GeneralSwarm*        swarm               = self->swarm;
    Particle_Index           particleLocalCount  = swarm->particleLocalCount;
    Particle_Index           lParticle_I;
+   Particle_Index           stride              = 1;
    
    lucSwarmViewer_cppdata* cppdata = (lucSwarmViewer_cppdata*) self->cppdata;
 
@@ -239,7 +243,17 @@ void _lucSwarmViewer_Draw( void* drawingObject, lucDatabase* database, void* _co
    // setup fn_io.
    std::shared_ptr<ParticleCoordinate> particleCoord = std::make_shared<ParticleCoordinate>( self->swarm->particleCoordVariable );
 
-   for ( lParticle_I = 0 ; lParticle_I < particleLocalCount ; lParticle_I++)
+   /* Level of detail: each processor draws every stride'th of its particles, so the decimation is
+      done before anything is gathered or written */
+   if (self->maxPoints > 0)
+   {
+      unsigned long localCount = particleLocalCount, globalCount;
+      (void)MPI_Allreduce(&localCount, &globalCount, 1, MPI_UNSIGNED_LONG, MPI_SUM, self->comm);
+      if (globalCount > self->maxPoints)
+         stride = (globalCount + self->maxPoints - 1) / self->maxPoints;
+   }
+
+   for ( lParticle_I = 0 ; lParticle_I < particleLocalCount ; lParticle_I += stride)
    {
       particleCoord->index() = lParticle_I;
       /* note we need to cast object to const version to ensure it selects const data() method */
@@ -62,6 +62,8 @@ extern const Type lucSwarmViewer_Type;
       /* Opacity Stuff */ \
       lucColourMap*                                      opacityColourMap;       \
       lucGeometryType                                    geomType;               \
+      /* Level of detail: about this many particles drawn over all processors, 0 for all */ \
+      unsigned                                           maxPoints;              \
       void*                                              cppdata;                \
 
 struct lucSwarmViewer
@@ -63,4 +63,10 @@ extern "C" {
     PyObject* GeneralSwarm_AddParticlesFromCoordArray( int DIM1, int DIM2, double* IN_ARRAY2 ){
         return GeneralSwarm_AddParticlesFromCoordArray( $self, DIM1, DIM2, IN_ARRAY2 );
     }
+    PyObject* GeneralSwarm_GetClosestParticlesBatch( int DIM1, int DIM2, double* IN_ARRAY2, int num_parts ){
+        return GeneralSwarm_GetClosestParticlesBatch( $self, DIM1, DIM2, IN_ARRAY2, num_parts );
+    }
+    PyObject* GeneralSwarm_GetParticlesWithinRadius( int DIM1, int DIM2, double* IN_ARRAY2, double radius ){
+        return GeneralSwarm_GetParticlesWithinRadius( $self, DIM1, DIM2, IN_ARRAY2, radius );
+    }
 }
@@ -85,6 +85,11 @@ import_array();
 %include "StGermain/Base/IO/src/Dictionary_Entry.h"
 %include "StGermain/Base/IO/src/Dictionary_Entry_Value.h"
 %include "StGermain/Base/Foundation/src/ObjectList.h"       
+%include "StGermain/Base/Foundation/src/MemoryAccounting.h"
+
+%apply (unsigned char* IN_ARRAY1, int DIM1) {(unsigned char* data, int size)};
+%apply (long* IN_ARRAY1, int DIM1) {(long* offsets, int nOffsets), (long* lengths, int nLengths)};
+%include "StGermain/Base/IO/src/AsyncWriter.h"
 
 
 /* # The following allows us to add values to IndexSets from numpy arrays */
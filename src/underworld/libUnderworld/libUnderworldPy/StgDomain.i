@@ -18,6 +18,7 @@
 
 %{
 /* Includes the header in the wrapper code */
+#define SWIG_FILE_WITH_INIT
 #include <mpi.h>
 #include <petsc.h>
 extern "C" {
@@ -37,6 +38,11 @@ extern "C" {
 #endif
 
 
+%include "numpy.i"
+%init %{
+import_array();
+%}
+
 %include "StgDomain_Typemaps.i"
 %include "StgDomain/Geometry/src/types.h"
 %include "StgDomain/Geometry/src/units.h"
@@ -46,6 +52,10 @@ extern "C" {
 %include "StgDomain/Mesh/src/MeshVariable.h"
 %include "StgDomain/Mesh/src/Mesh_Algorithms.h"
 %include "StgDomain/Mesh/src/Mesh_RegularAlgorithms.h"
+%apply (double* IN_ARRAY2, int DIM1, int DIM2) {(double* coords, int nCoords, int dim)};
+%apply (int* INPLACE_ARRAY2, int DIM1, int DIM2) {(int* procs, int nRows, int maxProcs)};
+%apply (int* INPLACE_ARRAY1, int DIM1) {(int* elements, int nElements)};
+%include "StgDomain/Mesh/src/ProcDirectory.h"
 %include "StgDomain/Mesh/src/types.h"
 %include "StgDomain/Swarm/src/ParticleLayout.h"
 %include "StgDomain/Swarm/src/GlobalParticleLayout.h"
@@ -439,6 +439,122 @@ class FeMesh(_stgermain.StgCompoundComponent, function.FunctionInput):
         if hasattr(self,"subMesh") and self.subMesh:
             self.subMesh.reset()
 
+    @property
+    def shape_function_cache_size(self):
+        """
+        The memory budget (in megabytes, per process) for caching shape
+        functions, their global derivatives and jacobian determinants at
+        integration points. Cached values are reused by integrals and viscous
+        assembly until the mesh is deformed. Set to zero to disable caching.
+
+        Example
+        -------
+        >>> import underworld as uw
+        >>> mesh = uw.mesh.FeMesh_Cartesian(elementRes=(4,4))
+        >>> mesh.shape_function_cache_size
+        256.0
+        >>> mesh.shape_function_cache_size = 0.
+        >>> mesh.shape_function_cache_size
+        0.0
+        """
+        return libUnderworld.StgFEM.FeMesh_GetShapeFuncCacheSize(self._cself)
+    @shape_function_cache_size.setter
+    def shape_function_cache_size(self, value):
+        if value < 0.:
+            raise ValueError("'shape_function_cache_size' must be non-negative.")
+        libUnderworld.StgFEM.FeMesh_SetShapeFuncCacheSize(self._cself, float(value))
+
+    def shape_function_cache_info(self, reset=False):
+        """
+        Returns local statistics for the integration point shape function
+        cache (see `shape_function_cache_size`).
+
+        Parameters
+        ----------
+        reset : bool
+            If True, the hit and miss counts are zeroed after being read.
+
+        Returns
+        -------
+        dict
+            'hits' and 'misses' counts for cache lookups, and 'memory'
+            (in megabytes) currently used.
+
+        Example
+        -------
+        >>> import underworld as uw
+        >>> mesh = uw.mesh.FeMesh_Cartesian(elementRes=(4,4))
+        >>> integral = uw.utils.Integral(fn=1.,mesh=mesh)
+        >>> area = integral.evaluate()
+        >>> mesh.shape_function_cache_info(reset=True)["misses"] > 0
+        True
+        >>> area = integral.evaluate()
+        >>> info = mesh.shape_function_cache_info()
+        >>> info["hits"] > 0, info["misses"]
+        (True, 0)
+
+        Deforming the mesh invalidates the cache:
+
+        >>> with mesh.deform_mesh():
+        ...     mesh.data[:] *= 1.1
+        >>> area = integral.evaluate()
+        >>> mesh.shape_function_cache_info()["misses"] > 0
+        True
+        """
+        stgfem = libUnderworld.StgFEM
+        return _stgermain.ReadStats( self._cself,
+                                     { "hits"   : stgfem.FeMesh_GetShapeFuncCacheHits,
+                                       "misses" : stgfem.FeMesh_GetShapeFuncCacheMisses,
+                                       "memory" : stgfem.FeMesh_GetShapeFuncCacheUsage },
+                                     stgfem.FeMesh_ResetShapeFuncCacheStats, reset )
+
+    def find_processes(self, coords):
+        """
+        Returns the processes whose part of the mesh may contain each of the
+        provided global coordinates. Processes are found via a directory of
+        every process's bounding box, which is shared on first use and again
+        only once the mesh has been deformed.
+
+        Parameters
+        ----------
+        coords : numpy.ndarray
+            Array of global coordinates, of shape (n, dim).
+
+        Returns
+        -------
+        numpy.ndarray
+            Integer array of shape (n, m), with the candidate processes of
+            each coordinate in ascending order, padded with -1. A candidate
+            need not actually own the coordinate, as bounding boxes overlap.
+
+        Notes
+        -----
+        This method must be called collectively by all processes.
+
+        Example
+        -------
+        >>> import underworld as uw
+        >>> import numpy as np
+        >>> mesh = uw.mesh.FeMesh_Cartesian(elementRes=(4,4))
+        >>> procs = mesh.find_processes(np.array([[0.5,0.5],[2.,2.]]))
+        >>> procs[:,0].tolist()
+        [0, -1]
+
+        """
+        from mpi4py import MPI
+        coords = np.ascontiguousarray(coords, dtype=np.float64)
+        if coords.ndim != 2 or coords.shape[1] != self.dim:
+            raise ValueError("'coords' must be an array of {} dimensional coordinates.".format(self.dim))
+        maxProcs = 4
+        while True:
+            procs = np.empty((len(coords), maxProcs), dtype=np.int32)
+            needed = libUnderworld.StgDomain.Mesh_FindProcs(self._cself, coords, procs)
+            # agree on a size, as each call must be collective
+            needed = uw.mpi.comm.allreduce(needed, op=MPI.MAX)
+            if needed <= maxProcs:
+                return procs[:,0:max(needed,1)]
+            maxProcs = needed
+
 
     @property
     def specialSets(self):
@@ -737,9 +853,21 @@ class CartesianMeshGenerator(MeshGenerator):
         docstring for further information.
     periodic: list, tuple
         List or tuple of bools, specifying mesh periodicity in each direction.
+    sfcElementOrdering: bool
+        If True, each processor's local elements are numbered along a Morton
+        (Z-order) space-filling curve instead of lexicographically. This improves
+        memory locality during element loops. Global element numbering is
+        unchanged.
+    decomposition: list, tuple
+        Optional explicit processor decomposition. Provide one list of ints per
+        direction, giving the first element index of each processor slab in that
+        direction. The product of the slab counts must equal the number of
+        processes. If not provided, elements are split evenly. See
+        FeMesh_Cartesian.balanced_decomposition() for generating a cost-weighted
+        decomposition.
 
     """
-    def __init__(self, elementRes, minCoord, maxCoord, periodic=None, **kwargs):
+    def __init__(self, elementRes, minCoord, maxCoord, periodic=None, sfcElementOrdering=False, decomposition=None, **kwargs):
 
         if not isinstance(elementRes,(list,tuple)):
             raise TypeError("'elementRes' object passed in must be of type 'list' or 'tuple'")
@@ -780,6 +908,31 @@ class CartesianMeshGenerator(MeshGenerator):
                 raise ValueError("'periodic' tuple length ({}) must be the same as that of 'elementRes' ({}).".format(len(periodic),len(elementRes)))
         self._periodic = periodic
 
+        if not isinstance(sfcElementOrdering,bool):
+            raise TypeError("'sfcElementOrdering' parameter must be of type 'bool'.")
+        self._sfcElementOrdering = sfcElementOrdering
+
+        if decomposition is not None:
+            if not isinstance(decomposition,(list,tuple)):
+                raise TypeError("'decomposition' object passed in must be of type 'list' or 'tuple'")
+            if len(decomposition) != len(elementRes):
+                raise ValueError("'decomposition' length ({}) must be the same as that of 'elementRes' ({}).".format(len(decomposition),len(elementRes)))
+            nSlabs = 1
+            for ii, starts in enumerate(decomposition):
+                if not isinstance(starts,(list,tuple)) or len(starts) == 0:
+                    raise TypeError("'decomposition[{}]' must be a non-empty 'list' or 'tuple' of slab start indices.".format(ii))
+                starts = [ int(item) for item in starts ]
+                if starts[0] != 0:
+                    raise ValueError("'decomposition[{}]' must start at element 0.".format(ii))
+                for prev, item in zip(starts[:-1],starts[1:]):
+                    if item <= prev or item >= elementRes[ii]:
+                        raise ValueError("'decomposition[{}]' must be strictly increasing and less than 'elementRes[{}]' ({}).".format(ii,ii,elementRes[ii]))
+                nSlabs *= len(starts)
+            if nSlabs != uw.mpi.size:
+                raise ValueError("'decomposition' provides {} processor slabs, but {} processes are in use.".format(nSlabs,uw.mpi.size))
+            decomposition = tuple( tuple(int(item) for item in starts) for starts in decomposition )
+        self._decomposition = decomposition
+
         for ii in range(0,self.dim):
             if minCoord[ii] >= maxCoord[ii]:
                 raise ValueError("'minCoord[{}]' must be less than 'maxCoord[{}]'".format(ii,ii))
@@ -830,6 +983,42 @@ class CartesianMeshGenerator(MeshGenerator):
             advecting.
         """
         return self._maxCoord
+    @property
+    def decomposition(self):
+        """
+        Returns
+        -------
+        tuple
+            The explicit processor decomposition provided at construction, as
+            one tuple of slab start element indices per direction, or None if
+            the default even decomposition is used.
+        """
+        return self._decomposition
+
+    def generation_info(self):
+        """
+        Returns the local time spent in each stage of mesh generation, for
+        diagnosing startup costs at large process counts.
+
+        Returns
+        -------
+        dict
+            Seconds spent in each of the 'decomposition', 'entities',
+            'incidence', 'shadow', 'complete' and 'geometry' stages.
+
+        Example
+        -------
+        >>> import underworld as uw
+        >>> mesh = uw.mesh.FeMesh_Cartesian(elementRes=(4,4))
+        >>> info = mesh.generation_info()
+        >>> sorted(info.keys())
+        ['complete', 'decomposition', 'entities', 'geometry', 'incidence', 'shadow']
+        >>> min(info.values()) >= 0.
+        True
+        """
+        stg = libUnderworld.StgDomain
+        return { stg.CartesianGenerator_GetStageName(ii) : stg.CartesianGenerator_GetStageTime(self._gen, ii)
+                 for ii in range(stg.CartesianGenerator_NumStages) }
 
     def _add_to_stg_dict(self,componentDictionary):
         # call parents method
@@ -844,6 +1033,10 @@ class CartesianMeshGenerator(MeshGenerator):
             componentDictionary[self._gen.name]["periodic_y"] = self._periodic[1]
             if self._dim == 3:
                 componentDictionary[self._gen.name]["periodic_z"] = self._periodic[2]
+        componentDictionary[self._gen.name]["sfcElementOrdering"] = self._sfcElementOrdering
+        if self._decomposition:
+            for axis, starts in zip("xyz",self._decomposition):
+                componentDictionary[self._gen.name]["decompositionStarts_"+axis] = list(starts)
 
     def _reset(self,mesh):
         """
@@ -1225,6 +1418,181 @@ class FeMesh_Cartesian(FeMesh, CartesianMeshGenerator):
         _volume_integral = uw.utils.Integral(mesh=self, fn=fn)
         return _volume_integral.evaluate()
 
+    def _local_element_grid_indices(self):
+        """
+        Returns the (i,j,k) element grid index of each local element, as an
+        array of shape (elementsLocal,dim).
+        """
+        gIds = self.data_elgId[0:self.elementsLocal].astype(np.int64)
+        ijk  = np.empty((len(gIds),self.dim), dtype=np.int64)
+        for dd in range(self.dim):
+            ijk[:,dd] = gIds % self.elementRes[dd]
+            gIds      = gIds // self.elementRes[dd]
+        return ijk
+
+    def _current_decomposition(self):
+        """
+        Returns the processor decomposition currently in use, as one tuple of
+        slab start element indices per direction. This is determined from the
+        lowest local element index of every process in each direction.
+        """
+        ijk = self._local_element_grid_indices()
+        mins = uw.mpi.comm.allgather( tuple(int(val) for val in ijk.min(axis=0)) if len(ijk) else None )
+        mins = [ item for item in mins if item is not None ]
+        return tuple( tuple(sorted(set(item[dd] for item in mins))) for dd in range(self.dim) )
+
+    def element_costs(self, swarms=None, assembly_time=None):
+        """
+        Returns an estimate of the computational cost of each local element,
+        for use with balanced_decomposition().
+
+        The cost of an element is modelled as a + b*n, where n is the number of
+        particles the element holds. If the measured assembly (or timestep)
+        wall time of each process is provided, a and b are fitted across all
+        processes by least squares. Otherwise an element holding the average
+        number of particles is taken to cost twice an empty element.
+
+        This method must be called collectively.
+
+        Parameters
+        ----------
+        swarms : list, underworld.swarm.Swarm
+            Swarms whose particles contribute to the element cost.
+        assembly_time : float
+            Wall time measured on this process for the work to be balanced.
+
+        Returns
+        -------
+        numpy.ndarray
+            Array of length elementsLocal containing the element costs.
+
+        Example
+        -------
+        >>> mesh = uw.mesh.FeMesh_Cartesian( elementRes=(4,4) )
+        >>> swarm = uw.swarm.Swarm(mesh)
+        >>> swarm.populate_using_layout(uw.swarm.layouts.PerCellGaussLayout(swarm,2))
+        >>> costs = mesh.element_costs(swarm)
+        >>> np.allclose(costs, 2.)
+        True
+
+        """
+        if swarms is None:
+            swarms = []
+        if not isinstance(swarms,(list,tuple)):
+            swarms = [swarms,]
+        counts = np.zeros(self.elementsLocal)
+        for swarm in swarms:
+            if not isinstance(swarm, uw.swarm.Swarm):
+                raise TypeError("'swarms' must only contain objects of type 'underworld.swarm.Swarm'.")
+            if swarm.mesh is not self:
+                raise ValueError("Swarm provided to 'element_costs' must be supported by this mesh.")
+            cells = swarm.owningCell.data[0:swarm.particleLocalCount].ravel()
+            counts += np.bincount(cells, minlength=self.elementsLocal)[0:self.elementsLocal]
+
+        from mpi4py import MPI
+        if assembly_time is None:
+            nParticles = uw.mpi.comm.allreduce(counts.sum(), op=MPI.SUM)
+            if nParticles == 0.:
+                return np.ones(self.elementsLocal)
+            return 1. + counts*(self.elementsGlobal/nParticles)
+
+        # fit time = a*elements + b*particles across processes
+        samples = np.array( uw.mpi.comm.allgather( (self.elementsLocal, counts.sum(), float(assembly_time)) ) )
+        coeffs = np.linalg.lstsq(samples[:,0:2], samples[:,2], rcond=None)[0]
+        coeffs = np.maximum(coeffs, 0.)
+        if coeffs[0] == 0. and coeffs[1] == 0.:
+            coeffs[0] = 1.
+        return coeffs[0] + coeffs[1]*counts
+
+    def balanced_decomposition(self, costs=None):
+        """
+        Computes a processor decomposition which balances the provided element
+        costs, keeping the current number of processor slabs in each direction.
+        The decomposition is returned in the form accepted by the
+        'decomposition' parameter, so a rebalanced mesh may be constructed
+        and existing data moved across using uw.utils.redistribute_meshvariable()
+        and uw.utils.redistribute_swarm().
+
+        Slab boundaries are chosen independently in each direction so that each
+        slab carries an equal share of the total cost projected onto that
+        direction.
+
+        This method must be called collectively.
+
+        Parameters
+        ----------
+        costs : numpy.ndarray
+            Cost of each local element. If not provided, all elements are
+            considered of equal cost. See element_costs().
+
+        Returns
+        -------
+        decomposition : tuple
+            Slab start element indices for each direction.
+        info : dict
+            Load imbalance (maximum over mean process cost) of the current
+            decomposition ('imbalance_before') and as predicted for the new
+            decomposition ('imbalance_after').
+
+        Example
+        -------
+        >>> mesh = uw.mesh.FeMesh_Cartesian( elementRes=(8,8) )
+        >>> decomposition, info = mesh.balanced_decomposition()
+        >>> decomposition == mesh._current_decomposition()
+        True
+
+        """
+        if costs is None:
+            costs = np.ones(self.elementsLocal)
+        costs = np.asarray(costs, dtype=float)
+        if costs.shape != (self.elementsLocal,):
+            raise ValueError("'costs' must be an array of length {} (local element count).".format(self.elementsLocal))
+
+        from mpi4py import MPI
+        ijk     = self._local_element_grid_indices()
+        current = self._current_decomposition()
+
+        decomposition = []
+        for dd in range(self.dim):
+            res       = self.elementRes[dd]
+            nSlabs    = len(current[dd])
+            marginal  = np.bincount(ijk[:,dd], weights=costs, minlength=res)
+            marginal  = uw.mpi.comm.allreduce(marginal, op=MPI.SUM)
+            cumulative = np.cumsum(marginal)
+            targets   = cumulative[-1]*np.arange(1,nSlabs)/nSlabs
+            # slab s starts after the element where the running cost crosses its target
+            starts    = [0,] + list(np.searchsorted(cumulative, targets, side='left') + 1)
+            # every slab must hold at least one element
+            for ss in range(1,nSlabs):
+                starts[ss] = min( max(starts[ss], starts[ss-1]+1), res-(nSlabs-ss) )
+            decomposition.append( tuple(int(val) for val in starts) )
+        decomposition = tuple(decomposition)
+
+        def _imbalance(decomp):
+            rankCosts = np.zeros(uw.mpi.size)
+            np.add.at(rankCosts, _decomposition_owners(decomp, ijk), costs)
+            rankCosts = uw.mpi.comm.allreduce(rankCosts, op=MPI.SUM)
+            mean = rankCosts.mean()
+            return rankCosts.max()/mean if mean > 0. else 1.
+
+        info = { "imbalance_before" : _imbalance(current),
+                 "imbalance_after"  : _imbalance(decomposition) }
+        return decomposition, info
+
+def _decomposition_owners(decomposition, ijk):
+    """
+    Returns the owning process of each element, given the element grid indices
+    as an (n,dim) array and a decomposition of slab start indices. Processes are
+    ordered with the first direction varying fastest.
+    """
+    owners = np.zeros(len(ijk), dtype=np.int64)
+    stride = 1
+    for dd, starts in enumerate(decomposition):
+        slab    = np.searchsorted(np.asarray(starts), ijk[:,dd], side='right') - 1
+        owners += stride*slab
+        stride *= len(starts)
+    return owners
+
 class FeMesh_IndexSet(uw.container.ObjectifiedIndexSet, function.FunctionInput):
     """
     This class ties the FeMesh instance to an index set, and stores other
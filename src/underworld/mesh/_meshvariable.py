@@ -327,7 +327,7 @@ class MeshVariable(_stgermain.StgCompoundComponent,uw.function.Function,_stgerma
             xdmfFH.write(string)
             xdmfFH.close()
 
-    def save( self, filename, meshHandle=None, units=None, **kwargs):
+    def save( self, filename, meshHandle=None, units=None, asynchronous=False, **kwargs):
         """
         Save the MeshVariable to disk.
 
@@ -346,6 +346,11 @@ class MeshVariable(_stgermain.StgCompoundComponent,uw.function.Function,_stgerma
             The units are saved as a HDF attribute. 
             Note if units are in celsius (see scaling.pint_degc_labels) 
             the data is scaled and save to degrees kelvin. 
+        asynchronous : bool
+            If True, the data is copied and written to the file in the background,
+            and this method returns once the file has been created. Call
+            `uw.utils.checkpoint_wait()` before the file is used by anything
+            other than Underworld's own loaders.
 
         Additional keyword arguments are saved as string attributes.
 
@@ -409,10 +414,39 @@ class MeshVariable(_stgermain.StgCompoundComponent,uw.function.Function,_stgerma
             raise TypeError("Expected 'filename' to be provided as a string")
 
         mesh = self.mesh
+        # ugly global shape def
+        globalShape = ( mesh.nodesGlobal, self.data.shape[1] )
+        local = mesh.nodesLocal
+
+        if units:
+            xxx = dimensionalise( self.data[0:local], units ).m
+            # if values are celsius then convert to kelvin
+            if units in pint_degc_labels:
+                units = 'degK'
+                xxx = xxx + 273.15
+        else:
+            xxx = self.data[0:local]
+
+        if asynchronous:
+            from ..utils._io import h5_write_async
+            attrs = { str(kwarg) : str(val) for kwarg, val in kwargs.items() }
+            attrs['units'] = str(units)
+            attrs["elementType"] = np.string_(mesh.elementType)
+            links = {}
+            if meshHandle:
+                if not isinstance(meshHandle, (str, uw.utils.SavedFileData)):
+                    raise TypeError("Expected 'meshHandle' to be of type 'uw.utils.SavedFileData'")
+                if not os.path.exists(meshHandle.filename):
+                    raise ValueError("You are trying to link against the mesh file '{}'\n\
+                                      that does not appear to exist. If you need to link \n\
+                                      against a mesh file, please make sure it is created first.".format(meshHandle.filename))
+                links["mesh"] = (meshHandle.filename, ".")
+            # rows are written by global node id
+            h5_write_async(filename, "data", globalShape, xxx, mesh.data_nodegId[0:local], attrs, links)
+            return uw.utils.SavedFileData(self, filename)
+
         with h5File(name=filename, mode="w") as h5f:
 
-            # ugly global shape def
-            globalShape = ( mesh.nodesGlobal, self.data.shape[1] )
             # create dataset
             dset = h5_require_dataset(h5f, "data",
                                       shape=globalShape,
@@ -422,17 +456,6 @@ class MeshVariable(_stgermain.StgCompoundComponent,uw.function.Function,_stgerma
                 h5f.attrs[str(kwarg)] = str(val)
 
             # write to the dset using the global node ids
-            local = mesh.nodesLocal
-
-            if units:
-                xxx = dimensionalise( self.data[0:local], units ).m
-                # if values are celsius then convert to kelvin
-                if units in pint_degc_labels:
-                    units = 'degK'
-                    xxx = xxx + 273.15
-            else:
-                xxx = self.data[0:local]
-
             with dset.collective:
                 dset[mesh.data_nodegId[0:local],:] = xxx
 
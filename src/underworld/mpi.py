@@ -81,3 +81,30 @@ class call_pattern():
 
 
 
+
+def _sparse_exchange(sends, tag):
+    """
+    Sends each array in `sends`, a dictionary of destination ranks to
+    contiguous float64 arrays, and returns a dictionary of source ranks to
+    the arrays received. Processes need not know who sends to them, and no
+    collective of size proportional to the number of processes is used
+    (non-blocking consensus). Must be called collectively.
+    """
+    import numpy as np
+    requests = [ comm.Issend([buf, _MPI.DOUBLE], dest=dest, tag=tag) for dest, buf in sends.items() ]
+    received = {}
+    status = _MPI.Status()
+    barrier = None
+    while True:
+        if comm.Iprobe(source=_MPI.ANY_SOURCE, tag=tag, status=status):
+            source = status.Get_source()
+            buf = np.empty(status.Get_count(_MPI.DOUBLE), dtype=np.float64)
+            comm.Recv([buf, _MPI.DOUBLE], source=source, tag=tag)
+            received[source] = buf
+        # synchronous sends complete only once received, so once every process
+        # has entered the barrier nothing remains in flight
+        if barrier is None:
+            if _MPI.Request.Testall(requests):
+                barrier = comm.Ibarrier()
+        elif barrier.Test():
+            return received
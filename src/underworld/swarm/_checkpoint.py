@@ -0,0 +1,253 @@
+##~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~##
+##                                                                                   ##
+##  This file forms part of the Underworld geophysics modelling application.         ##
+##                                                                                   ##
+##  For full license and copyright information, please refer to the LICENSE.md file  ##
+##  located at the project root, or contact the authors.                             ##
+##                                                                                   ##
+##~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~##
+"""
+Routines to checkpoint a swarm, along with its variables, to a single h5 file.
+
+Particles are written in Hilbert curve order, in blocks of spatially
+neighbouring particles, and the bounding box of each block is stored in the
+file. On restart each process reads only those blocks which overlap its part
+of the domain, so a checkpoint may be reloaded on any number of processes
+without every process reading every particle. Datasets are chunked by block
+and may be compressed.
+"""
+import underworld as uw
+import numpy as np
+from mpi4py import MPI
+
+_CHECKPOINT_VERSION = 1
+
+def _hilbert_keys(coords, minCoord, maxCoord, bits=None):
+    """
+    Returns the Hilbert curve key of each coordinate within the provided box,
+    using Skilling's transpose algorithm. Each direction is resolved to 'bits'
+    bits, by default the most that fit a 64 bit key.
+    """
+    npoints, dim = coords.shape
+    if bits is None:
+        bits = 31 if dim == 2 else 21
+    scale = np.where(maxCoord > minCoord, maxCoord - minCoord, 1.)
+    cells = np.clip((coords - minCoord) / scale, 0., 1.) * ((1 << bits) - 1)
+    X = [ cells[:,dd].astype(np.uint64) for dd in range(dim) ]
+
+    # inverse undo excess work
+    Q = np.uint64(1 << (bits-1))
+    while Q > 1:
+        P = Q - np.uint64(1)
+        for dd in range(dim):
+            hasQ = (X[dd] & Q) != 0
+            t = (X[0] ^ X[dd]) & P
+            X[0] = np.where(hasQ, X[0] ^ P, X[0] ^ t)
+            if dd > 0:
+                X[dd] = np.where(hasQ, X[dd], X[dd] ^ t)
+        Q = Q >> np.uint64(1)
+    # gray encode
+    for dd in range(1, dim):
+        X[dd] ^= X[dd-1]
+    t = np.zeros(npoints, dtype=np.uint64)
+    Q = np.uint64(1 << (bits-1))
+    while Q > 1:
+        t = np.where((X[dim-1] & Q) != 0, t ^ (Q - np.uint64(1)), t)
+        Q = Q >> np.uint64(1)
+    for dd in range(dim):
+        X[dd] ^= t
+
+    # interleave the transposed bits
+    keys = np.zeros(npoints, dtype=np.uint64)
+    for bit in range(bits-1, -1, -1):
+        for dd in range(dim):
+            keys = (keys << np.uint64(1)) | ((X[dd] >> np.uint64(bit)) & np.uint64(1))
+    return keys
+
+def _domain_box(mesh):
+    """
+    Returns the global bounding box of the mesh, allowing for deformation.
+    """
+    coords = mesh.data
+    localMin = coords.min(axis=0) if len(coords) else np.full(mesh.dim,  np.inf)
+    localMax = coords.max(axis=0) if len(coords) else np.full(mesh.dim, -np.inf)
+    return uw.mpi.comm.allreduce(localMin, op=MPI.MIN), uw.mpi.comm.allreduce(localMax, op=MPI.MAX)
+
+def _checkpoint_variables(swarm, variables):
+    """
+    Returns the (name, variable) pairs to checkpoint, in a fixed order.
+    """
+    if variables is None:
+        intrinsic = [ swarm.particleCoordinates, swarm.owningCell ]
+        if hasattr(swarm, "_globalId"):
+            intrinsic.append(swarm._globalId)
+        return [ ("variable_{}".format(ii), var) for ii, var in enumerate(swarm.variables)
+                 if not any(var is item for item in intrinsic) ]
+    if not isinstance(variables, dict):
+        raise TypeError("'variables' must be a dictionary of names to 'SwarmVariable' objects, or None.")
+    pairs = []
+    for name in sorted(variables.keys()):
+        var = variables[name]
+        if not isinstance(name, str) or name in ("coordinates", "index"):
+            raise ValueError("'variables' names must be strings, and may not be 'coordinates' or 'index'.")
+        if not isinstance(var, uw.swarm.SwarmVariable) or var.swarm is not swarm:
+            raise TypeError("'variables' values must be 'SwarmVariable' objects belonging to the swarm.")
+        pairs.append( (name, var) )
+    return pairs
+
+def save_checkpoint(swarm, filename, variables=None, blockSize=65536, compression="gzip"):
+    from ..utils._io import h5File, h5_require_dataset
+
+    if not isinstance(filename, str):
+        raise TypeError("'filename' parameter must be of type 'str'")
+    if not isinstance(blockSize, int) or blockSize < 1:
+        raise ValueError("'blockSize' must be a positive integer.")
+    if compression not in (None, "gzip", "lzf"):
+        raise ValueError("'compression' must be one of None, 'gzip' or 'lzf'.")
+    pairs = _checkpoint_variables(swarm, variables)
+    comm = uw.mpi.comm
+    dim = swarm.mesh.dim
+
+    # order the local particles along the curve, and split into blocks
+    nLocal = swarm.particleLocalCount
+    coords = swarm.particleCoordinates.data[0:nLocal]
+    minCoord, maxCoord = _domain_box(swarm.mesh)
+    order = np.argsort(_hilbert_keys(coords, minCoord, maxCoord), kind="stable")
+    coords = coords[order]
+    starts = np.arange(0, nLocal, blockSize, dtype=np.int64)
+    counts = np.minimum(blockSize, nLocal - starts)
+    blockMin = np.array([ coords[ss:ss+cc].min(axis=0) for ss, cc in zip(starts,counts) ]).reshape(-1,dim)
+    blockMax = np.array([ coords[ss:ss+cc].max(axis=0) for ss, cc in zip(starts,counts) ]).reshape(-1,dim)
+
+    procCount  = np.array(comm.allgather(nLocal), dtype=np.int64)
+    procBlocks = np.array(comm.allgather(len(starts)), dtype=np.int64)
+    offset      = int(procCount[:uw.mpi.rank].sum())
+    blockOffset = int(procBlocks[:uw.mpi.rank].sum())
+    globalCount = int(procCount.sum())
+    nBlocks     = int(procBlocks.sum())
+
+    def create(h5f, name, shape, dtype):
+        kwargs = {}
+        if shape[0] > 0:
+            kwargs["chunks"] = (min(blockSize, shape[0]),) + tuple(shape[1:])
+            if compression:
+                kwargs["compression"] = compression
+                kwargs["shuffle"] = True
+        return h5_require_dataset(h5f, name, shape=shape, dtype=dtype, **kwargs)
+
+    # gather variable data outside the file block, which may run sequentially
+    values = [ var.data[0:nLocal][order] for name, var in pairs ]
+    index  = np.stack((starts + offset, counts), axis=1) if len(starts) else np.zeros((0,2), dtype=np.int64)
+
+    with h5File(name=filename, mode="w") as h5f:
+        dset = create(h5f, "coordinates", (globalCount, dim), coords.dtype)
+        with dset.collective:
+            dset[offset:offset+nLocal] = coords
+        for (name, var), vals in zip(pairs, values):
+            dset = create(h5f, name, (globalCount, vals.shape[1]), vals.dtype)
+            with dset.collective:
+                dset[offset:offset+nLocal] = vals
+        # the spatial index: global start and count of each block, and its bounding box
+        for name, vals in (("index", index), ("index_min", blockMin), ("index_max", blockMax)):
+            dset = h5_require_dataset(h5f, name, shape=(nBlocks, vals.shape[1]), dtype=vals.dtype)
+            with dset.collective:
+                dset[blockOffset:blockOffset+len(vals)] = vals
+        h5f.attrs["swarm_checkpoint"] = _CHECKPOINT_VERSION
+        h5f.attrs["proc_offset"] = procCount
+        h5f.attrs["variables"] = [ name for name, var in pairs ]
+
+    return uw.utils.SavedFileData( swarm, filename )
+
+def _runs(blocks, index):
+    """
+    Returns the (start, end) file ranges covered by the provided blocks,
+    merging blocks which are contiguous in the file.
+    """
+    runs = []
+    for block in blocks:
+        start = int(index[block,0])
+        end   = start + int(index[block,1])
+        if runs and runs[-1][1] == start:
+            runs[-1] = (runs[-1][0], end)
+        else:
+            runs.append( (start, end) )
+    return runs
+
+def _read_runs(dset, runs):
+    """
+    Reads the provided ranges from the dataset, in a single read of their
+    union. Where the file is open for collective access, every process must
+    call this, and a process without ranges makes the read with an empty
+    selection. The high level h5py interface returns early for empty
+    selections, so would leave the other processes waiting.
+    """
+    import h5py
+    rest  = tuple(dset.shape[1:])
+    total = sum( end - start for start, end in runs )
+    data  = np.empty((total,) + rest, dtype=dset.dtype)
+
+    fspace = dset.id.get_space()
+    fspace.select_none()
+    for start, end in runs:
+        fspace.select_hyperslab((start,) + (0,)*len(rest), (end - start,) + rest, op=h5py.h5s.SELECT_OR)
+    if total:
+        mspace, buf = h5py.h5s.create_simple(data.shape), data
+    else:
+        # an empty selection of a single item, as dataspaces may not be empty
+        buf = np.empty((1,) + rest, dtype=dset.dtype)
+        mspace = h5py.h5s.create_simple(buf.shape)
+        mspace.select_none()
+
+    dxpl = None
+    if dset.file.driver == "mpio":
+        dxpl = h5py.h5p.create(h5py.h5p.DATASET_XFER)
+        dxpl.set_dxpl_mpio(h5py.h5fd.MPIO_COLLECTIVE)
+    dset.id.read(mspace, fspace, buf, dxpl=dxpl)
+    return data
+
+def load_checkpoint(swarm, filename, variables=None):
+    from ..utils._io import h5File, h5_get_dataset
+
+    if not isinstance(filename, str):
+        raise TypeError("'filename' parameter must be of type 'str'")
+    pairs = _checkpoint_variables(swarm, variables)
+    comm = uw.mpi.comm
+    dim = swarm.mesh.dim
+
+    # local domain box, including shadow space, slightly enlarged for round off
+    meshCoords = swarm.mesh.data
+    if len(meshCoords):
+        localMin = meshCoords.min(axis=0)
+        localMax = meshCoords.max(axis=0)
+        tol = 1.0e-10*np.max(localMax - localMin)
+        localMin, localMax = localMin - tol, localMax + tol
+    else:
+        localMin, localMax = np.full(dim, np.inf), np.full(dim, -np.inf)
+
+    # the spatial index is read first, to find the blocks to read
+    with h5File(name=filename, mode="r") as h5f:
+        if h5f.attrs.get("swarm_checkpoint") is None:
+            raise RuntimeError("File '{}' does not appear to be a swarm checkpoint.".format(filename))
+        names = [ name.decode() if isinstance(name, bytes) else str(name) for name in h5f.attrs["variables"] ]
+        for name, var in pairs:
+            if name not in names:
+                raise RuntimeError("Swarm checkpoint '{}' does not contain variable '{}'.".format(filename, name))
+        shape    = h5_get_dataset(h5f, "coordinates").shape
+        index    = h5_get_dataset(h5f, "index")[:]
+        blockMin = h5_get_dataset(h5f, "index_min")[:]
+        blockMax = h5_get_dataset(h5f, "index_max")[:]
+    if shape[1] != dim:
+        raise RuntimeError("Swarm checkpoint '{}' has {} dimensional coordinates, but the swarm is {} dimensional.".format(filename, shape[1], dim))
+    overlap = np.all(blockMax >= localMin, axis=1) & np.all(blockMin <= localMax, axis=1)
+    runs = _runs(np.nonzero(overlap)[0], index)
+
+    with h5File(name=filename, mode="r") as h5f:
+        coords = _read_runs(h5_get_dataset(h5f, "coordinates"), runs)
+        values = [ _read_runs(h5_get_dataset(h5f, name), runs) for name, var in pairs ]
+
+    indices = swarm.add_particles_with_coordinates(np.ascontiguousarray(coords))
+    placed  = indices >= 0
+    for (name, var), vals in zip(pairs, values):
+        var.data[indices[placed]] = vals[placed]
+
+    return shape[0] - comm.allreduce(int(np.count_nonzero(placed)))
@@ -64,6 +64,12 @@ class VoronoiIntegrationSwarm(IntegrationSwarm,function.FunctionInput):
     ----------
     swarm : underworld.swarm.Swarm
         The PIC integration swarm maps to this user provided swarm.
+    share_cell_tables : bool
+        If True, this swarm uses the cell particle tables of the provided
+        swarm rather than maintaining a copy, as its particles coincide with
+        the provided swarm's index for index. Where the provided swarm is
+        modified (for example, advected) before this swarm is repopulated,
+        this swarm takes its own copy of the tables as they were.
 
     Example
     -------
@@ -87,10 +93,13 @@ class VoronoiIntegrationSwarm(IntegrationSwarm,function.FunctionInput):
                           "_mapper" : "CoincidentMapper"
                     }
 
-    def __init__(self, swarm, **kwargs):
+    def __init__(self, swarm, share_cell_tables=True, **kwargs):
 
         if not isinstance(swarm, uw.swarm.Swarm):
             raise ValueError("Provided swarm must be of class 'Swarm'.")
+        if not isinstance(share_cell_tables, bool):
+            raise TypeError("'share_cell_tables' must be of type 'bool'.")
+        self._share_cell_tables = share_cell_tables
         
         self._mappedSwarm = weakref.ref(swarm)  # keep weakref to avoid circular dependency
         self._weights = uw.swarm._weights.DVC()
@@ -111,6 +120,7 @@ class VoronoiIntegrationSwarm(IntegrationSwarm,function.FunctionInput):
 
         componentDictionary[ self._mapper.name ][          "GeneralSwarm"] = self._mappedSwarm()._cself.name  # note _mappedSwarm is a weakref
         componentDictionary[ self._mapper.name ]["IntegrationPointsSwarm"] = self._swarm.name
+        componentDictionary[ self._mapper.name ][       "ShareCellTables"] = self._share_cell_tables
 
         componentDictionary[ self._swarm.name ][             "CellLayout"] = self._cellLayout.name
         componentDictionary[ self._swarm.name ][ "IntegrationPointMapper"] = self._mapper.name
@@ -142,6 +152,50 @@ class VoronoiIntegrationSwarm(IntegrationSwarm,function.FunctionInput):
             libUnderworld.PICellerator.IntegrationPointsSwarm_ClearSwarmMaps( self._cself )
 
         self._mappedToState = self._mappedSwarm().stateId
+
+    def remap_info(self, reset=False):
+        """
+        Returns local statistics for the mapping of swarm particles to
+        integration points. Only particles which have moved (or changed
+        element) since the last repopulation, or all particles if the mesh
+        has been deformed, require their element local coordinates to be
+        recomputed.
+
+        Parameters
+        ----------
+        reset : bool
+            If True, the counts are zeroed after being read.
+
+        Returns
+        -------
+        dict
+            'mapped' count of particles mapped, 'remapped' count of those
+            requiring a new local coordinate, and the remap 'fraction'.
+
+        Example
+        -------
+        >>> import underworld as uw
+        >>> mesh = uw.mesh.FeMesh_Cartesian()
+        >>> swarm = uw.swarm.Swarm(mesh)
+        >>> swarm.populate_using_layout(uw.swarm.layouts.PerCellGaussLayout(swarm,2))
+        >>> vswarm = uw.swarm.VoronoiIntegrationSwarm(swarm)
+        >>> vswarm.repopulate()
+        >>> vswarm.remap_info(reset=True)["fraction"]
+        1.0
+        >>> with swarm.deform_swarm():
+        ...     swarm.data[0] += 0.001
+        >>> vswarm.repopulate()
+        >>> info = vswarm.remap_info()
+        >>> info["mapped"], info["remapped"]
+        (64, 1)
+
+        """
+        pic = libUnderworld.PICellerator
+        return _stgermain.ReadStats( self._mapper,
+                                     { "mapped"   : pic.CoincidentMapper_GetMapCount,
+                                       "remapped" : pic.CoincidentMapper_GetRemapCount },
+                                     pic.CoincidentMapper_ResetStats, reset,
+                                     fraction=("remapped", ("mapped",)) )
             
 
     def _get_iterator(self):
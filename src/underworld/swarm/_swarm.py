@@ -36,6 +36,11 @@ class Swarm(_swarmabstract.SwarmAbstract, function.FunctionInput, _stgermain.Sav
     particleEscape : bool
         If set to true, particles are deleted when they leave the domain. This
         may occur during particle advection, or when the mesh is deformed.
+    particleSortInterval : int
+        If non-zero, the local particles are reordered along a space-filling
+        curve (see Swarm.sort_particles()) every `particleSortInterval` calls
+        to `update_particle_owners()`. This improves memory locality as
+        particles mix over many advection steps. Disabled by default.
 
 
     Example
@@ -103,9 +108,13 @@ class Swarm(_swarmabstract.SwarmAbstract, function.FunctionInput, _stgermain.Sav
        "_particleShadowSync": "ParticleShadowSync"
        }
 
-    def __init__(self, mesh, particleEscape=False, **kwargs):
+    def __init__(self, mesh, particleEscape=False, particleSortInterval=0, **kwargs):
 
         self.particleEscape = particleEscape
+        if not isinstance(particleSortInterval, int) or particleSortInterval < 0:
+            raise TypeError("'particleSortInterval' must be a non-negative integer.")
+        self.particleSortInterval = particleSortInterval
+        self._ownerUpdateCount = 0
         # escape routine will be used during swarm advection, but lets also add
         # it to the mesh post deform hook so that when the mesh is deformed,
         # any particles that are found wanting are culled accordingly.
@@ -418,6 +427,103 @@ class Swarm(_swarmabstract.SwarmAbstract, function.FunctionInput, _stgermain.Sav
         # record which swarm state this corresponds to
         self._checkpointMapsToState = self.stateId
 
+    def save_checkpoint(self, filename, variables=None, blockSize=65536, compression="gzip"):
+        """
+        Save the swarm, and its variables, to a single checkpoint file.
+
+        Particles are written along a Hilbert curve in blocks of spatially
+        neighbouring particles, with the bounding box of each block recorded.
+        When reloaded (see load_checkpoint()), each process reads only the
+        blocks overlapping its part of the domain, so checkpoints may be
+        restarted efficiently on any number of processes. Datasets are
+        chunked by block and optionally compressed. Note that compression
+        with parallel h5py requires HDF5 1.10.2 or later.
+
+        Parameters
+        ----------
+        filename : str
+            The filename for the saved file. Relative or absolute paths may be
+            used, but all directories must exist.
+        variables : dict
+            Dictionary of names to the swarm variables to save. If None, all
+            swarm variables (other than the coordinates and owning cells) are
+            saved, named by their order of creation. The same variables must
+            then be created in the same order before reloading.
+        blockSize : int
+            Number of particles in each block (and file chunk).
+        compression : str
+            One of None, 'gzip' or 'lzf'. Data is byte shuffled before
+            compression.
+
+        Returns
+        -------
+        underworld.utils.SavedFileData
+            Data object relating to saved file.
+
+        Notes
+        -----
+        This method must be called collectively by all processes.
+
+        Example
+        -------
+        >>> mesh = uw.mesh.FeMesh_Cartesian( elementRes=(16,16) )
+        >>> swarm = uw.swarm.Swarm(mesh)
+        >>> svar = swarm.add_variable("int",1)
+        >>> swarm.populate_using_layout(uw.swarm.layouts.PerCellGaussLayout(swarm,2))
+        >>> svar.data[:,0] = 1000*swarm.data[:,0]
+        >>> ignoreMe = swarm.save_checkpoint("swarm_checkpoint.h5", blockSize=100)
+
+        Reload into a new swarm, which must have the same variables:
+
+        >>> clone_swarm = uw.swarm.Swarm(mesh)
+        >>> clone_svar = clone_swarm.add_variable("int",1)
+        >>> clone_swarm.load_checkpoint("swarm_checkpoint.h5")
+        0
+        >>> import numpy as np
+        >>> np.all(clone_svar.data[:,0] == (1000*clone_swarm.data[:,0]).astype(int))
+        True
+        >>> clone_swarm.particleGlobalCount == swarm.particleGlobalCount
+        True
+
+        >>> # clean up:
+        >>> if uw.mpi.rank == 0:
+        ...     import os;
+        ...     os.remove( "swarm_checkpoint.h5" )
+
+        """
+        from ._checkpoint import save_checkpoint
+        return save_checkpoint(self, filename, variables, blockSize, compression)
+
+    def load_checkpoint(self, filename, variables=None):
+        """
+        Load particles, and their variables, from a checkpoint written by
+        save_checkpoint(). As for load(), particles are added to any already
+        existing. Each process reads only the blocks of particles overlapping
+        its part of the domain.
+
+        Parameters
+        ----------
+        filename : str
+            The checkpoint file.
+        variables : dict
+            Dictionary of names to the swarm variables to load, matching those
+            used when saving. If None, all swarm variables (other than the
+            coordinates and owning cells) are loaded by their order of creation.
+
+        Returns
+        -------
+        int
+            Global number of checkpointed particles which could not be placed
+            in the swarm. This should be zero.
+
+        Notes
+        -----
+        This method must be called collectively by all processes.
+
+        """
+        from ._checkpoint import load_checkpoint
+        return load_checkpoint(self, filename, variables)
+
     def fn_particle_found(self):
         """
         This function returns True where a particle is able to be found using 
@@ -586,6 +692,104 @@ class Swarm(_swarmabstract.SwarmAbstract, function.FunctionInput, _stgermain.Sav
             if update_owners:
                 self.update_particle_owners()
 
+    def _toggle_state(self):
+        # particle positions and/or population may have changed, so the nearest
+        # particle index will require (incremental) update before its next use.
+        libUnderworld.PICellerator.GeneralSwarm_InvalidateIndex( self._cself )
+        super(Swarm,self)._toggle_state()
+
+    def nearest_particles(self, coords, k=1):
+        """
+        Finds the `k` closest local particles to each of the provided
+        coordinates. The search uses a spatial index which is maintained
+        incrementally as the swarm changes, so repeated calls are cheap.
+
+        Parameters
+        ----------
+        coords : array_like
+            Array of shape (n, dim) of query coordinates.
+        k : int
+            Number of neighbours to return for each coordinate.
+
+        Returns
+        -------
+        indices : numpy.ndarray
+            Integer array of shape (n, k) of local particle indices, ordered
+            from nearest to farthest. Where fewer than `k` local particles
+            exist, the remaining entries are -1.
+        distances : numpy.ndarray
+            Array of shape (n, k) of the corresponding distances. Missing
+            entries are `inf`.
+
+        Notes
+        -----
+        Only particles local to the current process are considered. Shadow
+        particles are not searched.
+
+        Example
+        -------
+        >>> mesh = uw.mesh.FeMesh_Cartesian( elementType='Q1/dQ0', elementRes=(16,16), minCoord=(0.,0.), maxCoord=(1.,1.) )
+        >>> swarm = uw.swarm.Swarm(mesh)
+        >>> swarm.populate_using_layout(uw.swarm.layouts.PerCellGaussLayout(swarm,2))
+        >>> indices, distances = swarm.nearest_particles( [[0.,0.],[0.1,0.1]], k=2 )
+        >>> indices.shape
+        (2, 2)
+        >>> np.allclose( swarm.data[indices[0,0]], (0.0132078,0.0132078) )
+        True
+
+        """
+        coords = np.ascontiguousarray(coords, dtype=np.float64)
+        if coords.ndim == 1:
+            coords = coords.reshape(1,-1)
+        if coords.ndim != 2 or coords.shape[1] != self.mesh.dim:
+            raise ValueError("'coords' must be an array of shape (n, {}).".format(self.mesh.dim))
+        if not isinstance(k, int) or k < 1:
+            raise ValueError("'k' must be a positive integer.")
+        return self._cself.GeneralSwarm_GetClosestParticlesBatch( coords, k )
+
+    def particles_within_radius(self, coords, radius):
+        """
+        Finds the local particles within distance `radius` of each of the
+        provided coordinates.
+
+        Parameters
+        ----------
+        coords : array_like
+            Array of shape (n, dim) of query coordinates.
+        radius : float
+            Search radius.
+
+        Returns
+        -------
+        list
+            List of `n` integer arrays of local particle indices, each
+            ordered from nearest to farthest.
+
+        Notes
+        -----
+        Only particles local to the current process are considered. Shadow
+        particles are not searched.
+
+        Example
+        -------
+        >>> mesh = uw.mesh.FeMesh_Cartesian( elementType='Q1/dQ0', elementRes=(16,16), minCoord=(0.,0.), maxCoord=(1.,1.) )
+        >>> swarm = uw.swarm.Swarm(mesh)
+        >>> swarm.populate_using_layout(uw.swarm.layouts.PerCellGaussLayout(swarm,2))
+        >>> found = swarm.particles_within_radius( [[0.5,0.5]], 0.05 )
+        >>> len(found[0])
+        4
+
+        """
+        coords = np.ascontiguousarray(coords, dtype=np.float64)
+        if coords.ndim == 1:
+            coords = coords.reshape(1,-1)
+        if coords.ndim != 2 or coords.shape[1] != self.mesh.dim:
+            raise ValueError("'coords' must be an array of shape (n, {}).".format(self.mesh.dim))
+        if not isinstance(radius, (int,float)) or radius < 0.:
+            raise ValueError("'radius' must be a non-negative number.")
+        offsets, indices = self._cself.GeneralSwarm_GetParticlesWithinRadius( coords, float(radius) )
+        return [ indices[offsets[ii]:offsets[ii+1]] for ii in range(len(coords)) ]
+
     def shadow_particles_fetch(self):
         """
         When called, neighbouring processor particles which have coordinates 
@@ -648,7 +852,43 @@ class Swarm(_swarmabstract.SwarmAbstract, function.FunctionInput, _stgermain.Sav
                                "Check your velocity field or your particle relocation routines, or set the "
                                "`particleEscape` swarm constructor parameter to True to allow escape.")
 
+        self._ownerUpdateCount += 1
+        if self.particleSortInterval and (self._ownerUpdateCount % self.particleSortInterval == 0):
+            libUnderworld.StgDomain.Swarm_SortParticles( self._cself )
+
+        libUnderworld.PICellerator.GeneralSwarm_ClearSwarmMaps( self._cself )
+        self._toggle_state()
 
+    def sort_particles(self):
+        """
+        Reorders the local particles so that particles within the same
+        element are contiguous in memory, with elements visited in their
+        local order and particles within each element following a Morton
+        (Z-order) space-filling curve. Particle data is unchanged, only its
+        local ordering. Any particle maps or nearest neighbour indices are
+        brought up to date on next use.
+
+        Notes
+        -----
+        This method only reorders local data and so need not be called
+        collectively, although it typically will be.
+
+        Example
+        -------
+        >>> mesh = uw.mesh.FeMesh_Cartesian( elementType='Q1/dQ0', elementRes=(16,16), minCoord=(0.,0.), maxCoord=(1.,1.) )
+        >>> swarm = uw.swarm.Swarm(mesh)
+        >>> swarm.populate_using_layout(uw.swarm.layouts.PerCellGaussLayout(swarm,2))
+        >>> coords = swarm.data.copy()
+        >>> swarm.sort_particles()
+        >>> swarm.particleLocalCount == len(coords)
+        True
+        >>> import numpy as np
+        >>> np.allclose(np.sort(swarm.data,axis=0), np.sort(coords,axis=0))
+        True
+        >>> np.all(np.diff(swarm.owningCell.data[:,0]) >= 0)
+        True
+
+        """
+        libUnderworld.StgDomain.Swarm_SortParticles( self._cself )
         libUnderworld.PICellerator.GeneralSwarm_ClearSwarmMaps( self._cself )
-        libUnderworld.PICellerator.GeneralSwarm_DeleteIndex( self._cself )
         self._toggle_state()
@@ -129,7 +129,7 @@ class SwarmAbstract(_stgermain.StgCompoundComponent, metaclass = abc.ABCMeta):
 
         componentDictionary[ self._cellLayout.name ]["Mesh"]            = self._mesh._cself.name
 
-    def add_variable(self, dataType, count):
+    def add_variable(self, dataType, count, contiguous=False):
         """ 
         Add a variable to each particle in this swarm. Variables can be added
         at any point. Removal of variables is however not currently supported.
@@ -142,6 +142,9 @@ class SwarmAbstract(_stgermain.StgCompoundComponent, metaclass = abc.ABCMeta):
             "short", "int", "float" or "double".
         count: unsigned
             The number of values to be stored for each particle.
+        contiguous: bool
+            If True, the variable's data is stored in its own contiguous
+            array rather than within each particle.
         
         Returns
         -------
@@ -164,7 +167,7 @@ class SwarmAbstract(_stgermain.StgCompoundComponent, metaclass = abc.ABCMeta):
         >>> svar = swarm.add_variable("double",5)
 
         """
-        return svar.SwarmVariable( self, dataType, count )
+        return svar.SwarmVariable( self, dataType, count, contiguous=contiguous )
 
     def populate_using_layout( self, layout ):
         """ 
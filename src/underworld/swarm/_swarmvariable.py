@@ -28,8 +28,12 @@ class SwarmVariable(_stgermain.StgClass, function.Function):
     The SwarmVariable class allows users to add data to swarm particles. The data
     can be of type "char", "short", "int", "long, "float" or "double".
 
-    Note that the swarm allocates one block of contiguous memory for all the particles.
-    The per particle variable datums is then interlaced across this memory block.
+    Note that by default the swarm allocates one block of contiguous memory for all
+    the particles. The per particle variable datums is then interlaced across this
+    memory block. Variables created with `contiguous=True` instead store their data
+    in a separate array (structure-of-arrays layout), which is more cache efficient
+    where only a handful of variables are accessed at a time, and which does not
+    require the existing particle data to be restrided when added.
 
     The recommended practise is to add all swarm variables before populating the swarm
     to avoid costly reallocations.
@@ -47,10 +51,13 @@ class SwarmVariable(_stgermain.StgClass, function.Function):
         The number of values to be stored for each particle.
     writeable: bool
         Signifies if the variable should be writeable.
+    contiguous: bool
+        If True, the variable's data is stored in its own contiguous array
+        rather than interlaced with the other particle data.
     """
     _supportedDataTypes = ["char", "short", "int", "long", "float", "double"]
 
-    def __init__(self, swarm, dataType, count, writeable=True, **kwargs):
+    def __init__(self, swarm, dataType, count, writeable=True, contiguous=False, **kwargs):
 
         if not isinstance(swarm, sab.SwarmAbstract):
             raise TypeError("'swarm' object passed in must be of type 'Swarm'")
@@ -86,6 +93,10 @@ class SwarmVariable(_stgermain.StgClass, function.Function):
             raise TypeError("Provided 'count' must be a positive integer.")
         self._count = count
 
+        if not isinstance(contiguous,bool):
+            raise TypeError("Provided 'contiguous' must be of type 'bool'.")
+        self._contiguous = contiguous
+
         if self._dataType == "double" :
             dtype = libUnderworld.StGermain.StgVariable_DataType_Double;
         elif self._dataType == "float" :
@@ -109,7 +120,10 @@ class SwarmVariable(_stgermain.StgClass, function.Function):
             # note that we aren't checking the datatype
         else:
             varname = self.swarm._cself.name+"_"+str(len(self.swarm.variables))
-            self._cself = libUnderworld.StgDomain.Swarm_NewVectorVariable(self.swarm._cself, varname, -1, dtype, count )
+            if self._contiguous:
+                self._cself = libUnderworld.StgDomain.Swarm_NewContiguousVariable(self.swarm._cself, varname, dtype, count )
+            else:
+                self._cself = libUnderworld.StgDomain.Swarm_NewVectorVariable(self.swarm._cself, varname, -1, dtype, count )
             libUnderworld.StGermain.Stg_Component_Build( self._cself, None, False );
             libUnderworld.StGermain.Stg_Component_Initialise( self._cself, None, False );
 
@@ -359,7 +373,7 @@ class SwarmVariable(_stgermain.StgClass, function.Function):
             else:
                 self.data[:] = non_dimensionalise(self.data * iunits)
 
-    def save( self, filename, collective=False, swarmHandle=None, units=None, **kwargs):
+    def save( self, filename, collective=False, swarmHandle=None, units=None, asynchronous=False, **kwargs):
         """
         Save the swarm variable to disk.
 
@@ -379,6 +393,11 @@ class SwarmVariable(_stgermain.StgClass, function.Function):
             Define the units that must be used to save the data.
             The data will be dimensionalise and saved with the defined units.
             The units are saved as a HDF attribute.
+        asynchronous : bool
+            If True, the data is copied and written to the file in the background,
+            and this method returns once the file has been created. Call
+            `uw.utils.checkpoint_wait()` before the file is used by anything
+            other than Underworld's own loaders.
 
         Additional keyword arguments are saved as string attributes.
 
@@ -451,19 +470,36 @@ class SwarmVariable(_stgermain.StgClass, function.Function):
         for i in range(comm.rank):
             offset += procCount[i]
 
+        globalShape = (particleGlobalCount, self.data.shape[1])
+        if units:
+            xxx = dimensionalise( self.data[:], units=units ).m
+            # if save in celsius then -273.15
+            if units in pint_degc_labels:
+                xxx = xxx - 273.15
+        else:
+            xxx = self.data[:]
+
+        if asynchronous:
+            from ..utils._io import h5_write_async
+            attrs = { str(kwarg) : str(val) for kwarg, val in kwargs.items() }
+            attrs["proc_offset"] = procCount
+            attrs["units"] = str(units)
+            links = {}
+            if swarmHandle is not None:
+                if not isinstance(swarmHandle, (str, uw.utils.SavedFileData)):
+                    raise TypeError("Expected 'swarmHandle' to be of type 'uw.utils.SavedFileData'")
+                if not os.path.exists(swarmHandle.filename):
+                    raise ValueError("You are trying to link against the swarm file '{}'\n\
+                                      that does not appear to exist.".format(swarmHandle.filename))
+                links["swarm"] = (swarmHandle.filename, "./")
+            rows = np.arange(offset, offset+swarm.particleLocalCount)
+            h5_write_async(filename, "data", globalShape, xxx, rows, attrs, links)
+            return uw.utils.SavedFileData( self, filename )
+
         with h5File(name=filename, mode="w") as h5f:
             # write the entire local swarm to the appropriate offset position
-            globalShape = (particleGlobalCount, self.data.shape[1])
             dset = h5_require_dataset(h5f, "data", shape=globalShape, dtype=self.data.dtype)
 
-            if units:
-                xxx = dimensionalise( self.data[:], units=units ).m
-                # if save in celsius then -273.15
-                if units in pint_degc_labels:
-                    xxx = xxx - 273.15
-            else:
-                xxx = self.data[:]
-
             if collective:
                 with dset.collective:
                     dset[offset:offset+swarm.particleLocalCount] = xxx
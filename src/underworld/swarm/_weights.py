@@ -7,6 +7,7 @@
 ##                                                                                   ##
 ##~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~##
 import underworld._stgermain as _stgermain
+import underworld.libUnderworld as libUnderworld
 from . import _swarm
 
 class DVC(_stgermain.StgCompoundComponent):
@@ -17,16 +18,23 @@ class DVC(_stgermain.StgCompoundComponent):
     ----------
     resolutionX, resolutionY, resolutionZ : int
         The resolution of the grid used for the discrete voronoi algorithm.
+    threadedCalculation : bool
+        If True, cells are processed concurrently where built with OpenMP
+        support (see the `UW_ENABLE_OPENMP` CMake option). Ignored for
+        population control (PCDVC), which must process cells in order.
 
     """
     _objectsDict = { "_weights": "DVCWeights" }
     _selfObjectName = "_weights"
 
         # build parent
-    def __init__(self, resx=15,resy=15,resz=15, **kwargs):
+    def __init__(self, resx=15,resy=15,resz=15, threadedCalculation=False, **kwargs):
         self.resx=resx
         self.resy=resy
         self.resz=resz
+        if not isinstance( threadedCalculation, bool ):
+            raise TypeError("'threadedCalculation' must be of type 'bool'.")
+        self.threadedCalculation = threadedCalculation
         # build parent
         super(DVC,self).__init__(**kwargs)
 
@@ -36,6 +44,51 @@ class DVC(_stgermain.StgCompoundComponent):
         componentDictionary[ self._weights.name ]["resolutionX"] = self.resx
         componentDictionary[ self._weights.name ]["resolutionY"] = self.resy
         componentDictionary[ self._weights.name ]["resolutionZ"] = self.resz
+        componentDictionary[ self._weights.name ]["threadedCalculation"] = self.threadedCalculation
+
+    def calculation_info(self, reset=False):
+        """
+        Returns local statistics for the weights calculation. Cells whose
+        particles, and their element local coordinates, are exactly those of
+        the previous calculation reuse its results rather than reconstructing
+        their Voronoi diagram.
+
+        Parameters
+        ----------
+        reset : bool
+            If True, the counts are zeroed after being read.
+
+        Returns
+        -------
+        dict
+            'calculated' count of cells whose Voronoi diagram was constructed,
+            'reused' count of cells which reused previous results, and the
+            reuse 'fraction'.
+
+        Example
+        -------
+        >>> import underworld as uw
+        >>> mesh = uw.mesh.FeMesh_Cartesian()
+        >>> swarm = uw.swarm.Swarm(mesh)
+        >>> swarm.populate_using_layout(uw.swarm.layouts.PerCellGaussLayout(swarm,2))
+        >>> vswarm = uw.swarm.VoronoiIntegrationSwarm(swarm)
+        >>> vswarm.repopulate()
+        >>> vswarm._weights.calculation_info(reset=True)["calculated"]
+        16
+        >>> with swarm.deform_swarm():
+        ...     swarm.data[0] += 0.001
+        >>> vswarm.repopulate()
+        >>> info = vswarm._weights.calculation_info()
+        >>> info["calculated"], info["reused"]
+        (1, 15)
+
+        """
+        pic = libUnderworld.PICellerator
+        return _stgermain.ReadStats( self._cself,
+                                     { "calculated" : pic.DVCWeights_GetCalculatedCellCount,
+                                       "reused"     : pic.DVCWeights_GetReusedCellCount },
+                                     pic.DVCWeights_ResetStats, reset,
+                                     fraction=("reused", ("calculated","reused")) )
 
 class PCDVC(DVC):
     """
@@ -60,6 +60,10 @@ class AdvectionDiffusion(object):
         Allow the integration to perform over a non Q1 element mesh. (Under Q2
         elements instabilities have been observed as the implementation is only
         for Q1 elements)
+    threaded_assembly : bool
+        If True, element matrices and vectors are evaluated concurrently
+        where underworld is built with OpenMP. Terms whose functions are
+        not thread safe are still assembled serially.
 
 
     Notes
@@ -76,12 +80,15 @@ class AdvectionDiffusion(object):
 
     def __init__(self, phiField=None, velocityField=None, fn_diffusivity=None,
                  fn_sourceTerm=None, method="SUPG", conditions=[],
-                 phiDotField=None, allow_non_q1=False, gauss_swarm=None, **kwargs):
+                 phiDotField=None, allow_non_q1=False, gauss_swarm=None, threaded_assembly=False, **kwargs):
 
         if not isinstance(method, str) or method.upper() not in ("SUPG","SLCN"):
             raise ValueError("'method' parameter must be 'SUPG' or 'SLCN'")
         self.method = method.upper()
 
+        if not isinstance( threaded_assembly, bool ):
+            raise TypeError( "Provided 'threaded_assembly' must be of type 'bool'." )
+
         if self.method == "SLCN" and phiDotField:
             import warnings
             warnings.warn("'phiDotField' doesn't influence the 'SLCN' method."+
@@ -111,12 +118,12 @@ class AdvectionDiffusion(object):
             self.system = _SUPG_AdvectionDiffusion(
                                 phiField, phiDotField, velocityField, 
                                 fn_diffusivity, fn_sourceTerm, conditions, 
-                                gauss_swarm = gauss_swarm)
+                                gauss_swarm = gauss_swarm, threaded_assembly = threaded_assembly)
         elif self.method == "SLCN":
             self.system = _SLCN_AdvectionDiffusion(
                                 phiField, velocityField, fn_diffusivity, 
                                 fn_sourceTerm, conditions, 
-                                gauss_swarm = gauss_swarm)
+                                gauss_swarm = gauss_swarm, threaded_assembly = threaded_assembly)
 
     @property
     def velocityField(self):
@@ -151,7 +158,7 @@ class AdvectionDiffusion(object):
 
 
 class _SLCN_AdvectionDiffusion(object):
-    def __init__(self, phiField, velocityField, fn_diffusivity, fn_sourceTerm=None, conditions=[], gauss_swarm=None):
+    def __init__(self, phiField, velocityField, fn_diffusivity, fn_sourceTerm=None, conditions=[], gauss_swarm=None, threaded_assembly=False):
         """Implements the Spiegelman / Katz   Semi-lagrangian Advection / Crank Nicholson Diffusion algorithm"""
 
         mesh = velocityField.mesh
@@ -211,8 +218,8 @@ class _SLCN_AdvectionDiffusion(object):
         # build matrices and vectors
         phi_eqnums        = uw.systems.sle.EqNumber(phiField)
         solv = self._solv = uw.systems.sle.SolutionVector(phiField, phi_eqnums)
-        f    = self._f    = uw.systems.sle.AssembledVector(phiField, phi_eqnums)
-        K    = self._K    = uw.systems.sle.AssembledMatrix(solv, solv, f)
+        f    = self._f    = uw.systems.sle.AssembledVector(phiField, phi_eqnums, threadedAssembly=threaded_assembly)
+        K    = self._K    = uw.systems.sle.AssembledMatrix(solv, solv, f, threadedAssembly=threaded_assembly)
 
         fn_dt = self.fn_dt
 
@@ -874,6 +881,9 @@ class _SUPG_AdvectionDiffusion(_stgermain.StgCompoundComponent):
     conditions : underworld.conditions.SystemCondition
         Numerical conditions to impose on the system. This should be supplied as
         the condition itself, or a list object containing the conditions.
+    threaded_assembly : bool
+        If True, element vectors are evaluated concurrently where the
+        assembly terms support it.
     
     Notes
     -----
@@ -884,7 +894,7 @@ class _SUPG_AdvectionDiffusion(_stgermain.StgCompoundComponent):
                       "_solver": "AdvDiffMulticorrector" }
     _selfObjectName = "_system"
 
-    def __init__(self, phiField, phiDotField, velocityField, fn_diffusivity, fn_sourceTerm=None, conditions=[], gauss_swarm=None):
+    def __init__(self, phiField, phiDotField, velocityField, fn_diffusivity, fn_sourceTerm=None, conditions=[], gauss_swarm=None, threaded_assembly=False):
 
         self._diffusivity   = fn_diffusivity
         self._source        = fn_sourceTerm
@@ -944,8 +954,8 @@ class _SUPG_AdvectionDiffusion(_stgermain.StgCompoundComponent):
         self._phiDotSolution = sle.SolutionVector( phiDotField, self._eqNumPhiDot )
 
         # create force vectors
-        self._residualVector = sle.AssembledVector(phiField, self._eqNumPhi )
-        self._massVector     = sle.AssembledVector(phiField, self._eqNumPhi )
+        self._residualVector = sle.AssembledVector(phiField, self._eqNumPhi, threadedAssembly=threaded_assembly )
+        self._massVector     = sle.AssembledVector(phiField, self._eqNumPhi, threadedAssembly=threaded_assembly )
 
         super(_SUPG_AdvectionDiffusion, self).__init__()
 
@@ -39,6 +39,8 @@ class OptionsMG(Options):
 
     active = <True,False>                             : activates Multigrid
     levels = <n>                                      : Multigrid grid levels
+    telescope_rows = <n>                              : Gather coarse levels averaging fewer than n rows per process
+                                                        onto fewer processes (0 disables)
     pc_mg_type <additive,multiplicative,full,kaskade> : multiplicative is default
     pc_mg_cycle_type <v,w>                            : v or w
     pc_mg_multiplicative_cycles <n>                   : Sets the number of cycles to use for each preconditioner step of multigrid
@@ -57,6 +59,7 @@ class OptionsMG(Options):
         self.__dict__.clear()
         self.levels=0
         self.active=True
+        self.telescope_rows=0
         # add to A11 ksp when MG active
         #self.pc_mg_type="multiplicative"
         #self.pc_mg_type="additive"
@@ -323,6 +326,7 @@ class StokesSolver(_stgermain.StgCompoundComponent):
               nonLinearKillNonConvergent=False,
               nonLinearMinIterations=1,
               nonLinearMaxIterations=500,
+              nonLinearAndersonDepth=0,
               callback_post_solve=None,
               print_stats=False, reinitialise=True, **kwargs):
         """
@@ -339,6 +343,12 @@ class StokesSolver(_stgermain.StgCompoundComponent):
         nonLinearMaxIterations: int, Default=500
             Maximum number of non linear iteration to perform
 
+        nonLinearAndersonDepth: int, Default=0
+            Number of previous non linear iterations combined to accelerate
+            convergence (Anderson acceleration). Values of 3 to 5 commonly
+            reduce the iterations required by yielding and strain rate
+            dependent rheologies. 0 uses plain Picard iterations.
+
         callback_post_sovle: func, Default=None
             Optional callback function to be performed at the end of a linear solve iteration.
             Commonly this will be used to perform operations between non linear iterations, for example,
@@ -377,12 +387,16 @@ class StokesSolver(_stgermain.StgCompoundComponent):
         if not isinstance(nonLinearTolerance, float) or nonLinearTolerance < 0.0:
             raise ValueError("'nonLinearTolerance' option must be of type 'float' and greater than 0.0")
 
+        if not isinstance(nonLinearAndersonDepth, int) or nonLinearAndersonDepth < 0:
+            raise ValueError("'nonLinearAndersonDepth' option must be of type 'int' and non-negative")
+
         # Set up options string from dictionaries.
         # We set up here so that we can set/change terms on the dictionaries before we run solve
         # self.options.A11._mg_active is True by default but can be changed before here via
         # functions like set_lu
 
         self._setup_options(**kwargs)
+        self._check_matrix_free()
         petsc.OptionsClear() # reset the petsc options
         petsc.OptionsInsertString(self._optionsStr)
 
@@ -400,6 +414,7 @@ class StokesSolver(_stgermain.StgCompoundComponent):
             self._stokesSLE._cself.nonLinearMinIterations = nonLinearMinIterations
             self._stokesSLE._cself.nonLinearMaxIterations = nonLinearMaxIterations
             self._stokesSLE._cself.killNonConvergent = nonLinearKillNonConvergent
+            self._stokesSLE._cself.nonLinearAndersonDepth = nonLinearAndersonDepth
 
         else:
             libUnderworld.StgFEM.SystemLinearEquations_SetToNonLinear(self._stokesSLE._cself, False )
@@ -595,7 +610,7 @@ class StokesSolver(_stgermain.StgCompoundComponent):
 
         if self.options.mg.active:
             for key, value in self.options.mg.__dict__.items():
-                if key != 'active' and key != 'levels':
+                if key not in ('active', 'levels', 'telescope_rows'):
                     self._optionsStr = self._optionsStr+" "+"-A11_"+key+" "+str(str(value))
             self.options._mgLevels=self.options.mg.levels # todo dynamically set mgLevels.
         else:
@@ -610,6 +625,20 @@ class StokesSolver(_stgermain.StgCompoundComponent):
             self._optionsStr = self._optionsStr+" "+"-"+key+" "+str(value)
 
 
+    def _check_matrix_free(self):
+        # matrix-free operators have no entries, so anything which reads them is unavailable
+        if not self._stokesSLE._matrix_free:
+            return
+        if isinstance(self.options.main.penalty, float) and self.options.main.penalty > 0.0:
+            raise ValueError("The 'penalty' method cannot be used with a 'matrix_free' Stokes system.")
+        if self.options.main.rescale_equations:
+            raise ValueError("'rescale_equations' cannot be used with a 'matrix_free' Stokes system.")
+        if self.options.main.Q22_pc_type != "uw":
+            raise ValueError("Only the 'uw' Q22_pc_type may be used with a 'matrix_free' Stokes system.")
+        if not self.options.mg.active and getattr(self.options.A11, "pc_type", "none") not in ("jacobi", "none"):
+            raise ValueError("Without multigrid, a 'matrix_free' Stokes system can only use 'jacobi' or 'none' "\
+                             "for the velocity preconditioner, as direct solvers need an assembled matrix.")
+
     ########################################################################
     ### check functional dependence of objects in solve
     ########################################################################
@@ -661,11 +690,16 @@ class StokesSolver(_stgermain.StgCompoundComponent):
         if self.options.mg.levels == 0:
             self.options.mg.set_levels(field=field)
 
+        if not isinstance(self.options.mg.telescope_rows, int) or self.options.mg.telescope_rows < 0:
+            raise ValueError("The multigrid 'telescope_rows' option must be a non-negative 'int'.")
+
         mgObj=MGSolver(field,eqNum,self.options.mg.levels)
         # attach MG object to Solver struct
         self.mgObj=mgObj # must attach object here: else immediately goes out of scope and is destroyed
         self._cself.mg = mgObj._cself
 
+        libUnderworld.StgFEM.PETScMGSolver_SetTelescopeRows(mgObj._cself, self.options.mg.telescope_rows)
+
     def set_inner_method(self, solve_type="mg"):
         """
         Configure velocity/inner solver (A11 PETSc prefix).
@@ -734,6 +768,9 @@ class StokesSolver(_stgermain.StgCompoundComponent):
 
         a.picard_iterations = self._stokesSLE._cself.nonLinearIteration_I
         a.picard_residual =   self._stokesSLE._cself.curResidual
+        a.picard_walltime =   self._stokesSLE._cself.nonLinearWallTime
+        a.anderson_depth =    self._stokesSLE._cself.nonLinearAndersonDepth
+        a.anderson_restarts = self._stokesSLE._cself.nonLinearAndersonRestarts
 
         return a
 
@@ -92,6 +92,18 @@ class Stokes(_stgermain.StgCompoundComponent):
     conditions : underworld.conditions.SystemCondition
         Numerical conditions to impose on the system. This should be supplied as
         the condition itself, or a list object containing the conditions.
+    matrix_free : bool
+        If True, the velocity operators (K and G) are never stored, but
+        recomputed element by element each time they are applied. This
+        trades solve time for memory on large 3D problems. Only the
+        iterative (multigrid or Jacobi preconditioned) velocity solvers
+        are then available, and the 'penalty' method and equation
+        rescaling may not be used.
+    threaded_assembly : bool
+        If True, element matrices and vectors are evaluated concurrently
+        where underworld is built with OpenMP. Terms whose functions are
+        not thread safe (such as swarm variables evaluated by nearest
+        neighbour) are still assembled serially.
 
     Notes
     -----
@@ -104,7 +116,7 @@ class Stokes(_stgermain.StgCompoundComponent):
 
 
     def __init__(self, velocityField, pressureField, fn_viscosity, fn_bodyforce=None, fn_one_on_lambda=None,
-                fn_source=None, voronoi_swarm=None, conditions=[], gauss_swarm=None,
+                fn_source=None, voronoi_swarm=None, conditions=[], gauss_swarm=None, matrix_free=False, threaded_assembly=False,
                 _removeBCs=True, _fn_viscosity2=None, _fn_director=None, fn_stresshistory=None, _fn_stresshistory=None,
                 _fn_v0=None, _fn_p0=None, _fn_fssa=None, _callback_post_solve=None, **kwargs):
 
@@ -122,6 +134,12 @@ class Stokes(_stgermain.StgCompoundComponent):
             raise ValueError( "Provided 'pressureField' must be a scalar field (ie pressureField.nodeDofCount==1)." )
         self._pressureField = pressureField
 
+        if not isinstance( matrix_free, bool ):
+            raise TypeError( "Provided 'matrix_free' must be of type 'bool'." )
+        self._matrix_free = matrix_free
+        if not isinstance( threaded_assembly, bool ):
+            raise TypeError( "Provided 'threaded_assembly' must be of type 'bool'." )
+
         _fn_viscosity  = uw.function.Function.convert(fn_viscosity)
         if not isinstance( _fn_viscosity, uw.function.Function):
             raise TypeError( "Provided 'fn_viscosity' must be of or convertible to 'Function' class." )
@@ -239,13 +257,14 @@ class Stokes(_stgermain.StgCompoundComponent):
             self.callback_post_solve = _callback_post_solve
 
         # create force vectors
-        self._fvector = sle.AssembledVector(velocityField, self._eqNums[velocityField] )
-        self._hvector = sle.AssembledVector(pressureField, self._eqNums[pressureField] )
+        self._fvector = sle.AssembledVector(velocityField, self._eqNums[velocityField], threadedAssembly=threaded_assembly )
+        self._hvector = sle.AssembledVector(pressureField, self._eqNums[pressureField], threadedAssembly=threaded_assembly )
 
         # and matrices
-        self._kmatrix = sle.AssembledMatrix( self._velocitySol, self._velocitySol, rhs=self._fvector )
-        self._gmatrix = sle.AssembledMatrix( self._velocitySol, self._pressureSol, rhs=self._fvector, rhs_T=self._hvector )
-        self._preconditioner = sle.AssembledMatrix( self._pressureSol, self._pressureSol, rhs=self._hvector )
+        self._kmatrix = sle.AssembledMatrix( self._velocitySol, self._velocitySol, rhs=self._fvector, matrixFree=matrix_free, threadedAssembly=threaded_assembly )
+        # the gradient operator depends only on the mesh geometry, so is only reassembled once the mesh deforms
+        self._gmatrix = sle.AssembledMatrix( self._velocitySol, self._pressureSol, rhs=self._fvector, rhs_T=self._hvector, matrixFree=matrix_free, assembleOnce=True, threadedAssembly=threaded_assembly )
+        self._preconditioner = sle.AssembledMatrix( self._pressureSol, self._pressureSol, rhs=self._hvector, threadedAssembly=threaded_assembly )
 
         # create assembly terms which always use gauss integration
         self._gradStiffMatTerm = sle.GradientStiffnessMatrixTerm(   integrationSwarm=gaussSwarm,
@@ -298,7 +317,7 @@ class Stokes(_stgermain.StgCompoundComponent):
         if self._fn_minus_one_on_lambda != None:
             # add matrix and associated assembly term for compressible stokes formulation
             # a mass matrix goes into the lower right block of the stokes system coeff matrix
-            self._mmatrix = sle.AssembledMatrix( self._pressureSol, self._pressureSol, rhs=self._hvector )
+            self._mmatrix = sle.AssembledMatrix( self._pressureSol, self._pressureSol, rhs=self._hvector, threadedAssembly=threaded_assembly )
             # -1. as per Hughes, The Finite Element Method, 1987, Table 4.3.1, [M]
 
             self._compressibleTerm = sle.MatrixAssemblyTerm_NA__NB__Fn(  integrationSwarm=intswarm,
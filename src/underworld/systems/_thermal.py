@@ -68,6 +68,10 @@ class SteadyStateHeat(_stgermain.StgCompoundComponent):
     conditions : underworld.conditions.SystemCondition
         Numerical conditions to impose on the system. This should be supplied as
         the condition itself, or a list object containing the conditions.
+    threaded_assembly : bool
+        If True, element matrices and vectors are evaluated concurrently
+        where underworld is built with OpenMP. Terms whose functions are
+        not thread safe are still assembled serially.
 
     Notes
     -----
@@ -105,7 +109,7 @@ class SteadyStateHeat(_stgermain.StgCompoundComponent):
     _selfObjectName = "_system"
 
     def __init__(self, temperatureField, fn_diffusivity, fn_heating=0., voronoi_swarm=None, conditions=[], 
-                 gauss_swarm=None, _removeBCs=True, **kwargs):
+                 gauss_swarm=None, threaded_assembly=False, _removeBCs=True, **kwargs):
 
         if not isinstance( temperatureField, uw.mesh.MeshVariable):
             raise TypeError( "Provided 'temperatureField' must be of 'MeshVariable' class." )
@@ -123,6 +127,9 @@ class SteadyStateHeat(_stgermain.StgCompoundComponent):
 
         if voronoi_swarm and not isinstance(voronoi_swarm, uw.swarm.Swarm):
             raise TypeError( "Provided 'swarm' must be of 'Swarm' class." )
+
+        if not isinstance( threaded_assembly, bool ):
+            raise TypeError( "Provided 'threaded_assembly' must be of type 'bool'." )
         self._swarm = voronoi_swarm
         if voronoi_swarm and temperatureField.mesh.elementType=='Q2':
             import warnings
@@ -176,10 +183,10 @@ class SteadyStateHeat(_stgermain.StgCompoundComponent):
         libUnderworld.StgFEM.SolutionVector_LoadCurrentFeVariableValuesOntoVector( self._solutionVector._cself )
 
         # create force vectors
-        self._fvector = sle.AssembledVector(temperatureField, tEqNums )
+        self._fvector = sle.AssembledVector(temperatureField, tEqNums, threadedAssembly=threaded_assembly )
 
         # and matrices
-        self._kmatrix = sle.AssembledMatrix( self._solutionVector, self._solutionVector, rhs=self._fvector )
+        self._kmatrix = sle.AssembledMatrix( self._solutionVector, self._solutionVector, rhs=self._fvector, threadedAssembly=threaded_assembly )
 
 
         self._kMatTerm = sle.MatrixAssemblyTerm_NA_i__NB_i__Fn(  integrationSwarm=intswarm,
@@ -22,12 +22,37 @@ class AssembledMatrix(_stgermain.StgCompoundComponent):
         MeshVariable object for matrix row.
     meshVariableCol: underworld.mesh.MeshVariable
         MeshVariable object for matrix column.
+    threadedAssembly: bool
+        If True, element matrices are evaluated concurrently where
+        underworld is built with OpenMP and all assembly terms support
+        it. Functions used within terms must then not be stateful
+        (for example, min_max). Terms whose functions build shared
+        state as they are evaluated (swarm variables evaluated by
+        nearest neighbour, or mapped to an integration swarm which
+        does not mirror their swarm) are assembled serially.
+    matrixFree: bool
+        If True, the matrix is never stored. Its element matrices are
+        instead recomputed each time it is applied. Solvers which need
+        the matrix entries (direct solvers, ILU/SOR preconditioners,
+        equation scaling) are then unavailable.
+    reuseStructure: bool
+        If True, the PETSc matrix and its non-zero pattern are kept
+        between assemblies, and only its values are zeroed. The matrix
+        is recreated where the equation numbering is rebuilt.
+    assembleOnce: bool
+        If True, the matrix values are only reassembled once the mesh has
+        been deformed. This is only valid where the assembly terms do not
+        depend on functions which change between solves (for example, the
+        Stokes gradient operator). Boundary condition contributions to the
+        right hand side vectors are always reassembled. Ignored where
+        matrixFree is set.
         
     """
     _objectsDict = { "_matrix": "StiffnessMatrix" }
     _selfObjectName = "_matrix"
 
-    def __init__(self, rowVector, colVector, rhs=None, rhs_T=None, assembleOnNodes=False, **kwargs):
+    def __init__(self, rowVector, colVector, rhs=None, rhs_T=None, assembleOnNodes=False, threadedAssembly=False, matrixFree=False,
+                 reuseStructure=True, assembleOnce=False, **kwargs):
         if not isinstance(rowVector, uw.systems.sle.SolutionVector):
             raise TypeError("'rowVector' object passed in must be of type 'SolutionVector'")
 
@@ -50,6 +75,26 @@ class AssembledMatrix(_stgermain.StgCompoundComponent):
             raise TypeError("'assembleOnNodes' must be of type 'bool'.")
         self.assembleOnNodes = assembleOnNodes
 
+        if not isinstance( threadedAssembly, bool ):
+            raise TypeError("'threadedAssembly' must be of type 'bool'.")
+        self.threadedAssembly = threadedAssembly
+
+        if not isinstance( matrixFree, bool ):
+            raise TypeError("'matrixFree' must be of type 'bool'.")
+        if matrixFree and assembleOnNodes:
+            raise ValueError("'matrixFree' cannot be used with 'assembleOnNodes'.")
+        self.matrixFree = matrixFree
+
+        if not isinstance( reuseStructure, bool ):
+            raise TypeError("'reuseStructure' must be of type 'bool'.")
+        self.reuseStructure = reuseStructure
+
+        if not isinstance( assembleOnce, bool ):
+            raise TypeError("'assembleOnce' must be of type 'bool'.")
+        if assembleOnce and assembleOnNodes:
+            raise ValueError("'assembleOnce' cannot be used with 'assembleOnNodes'.")
+        self.assembleOnce = assembleOnce
+
         # build parent
         super(AssembledMatrix,self).__init__(**kwargs)
 
@@ -63,6 +108,50 @@ class AssembledMatrix(_stgermain.StgCompoundComponent):
     def meshVariableCol(self):
         return self._meshVariableCol
 
+    def assembly_info(self, reset=False):
+        """
+        Returns local statistics for the assembly of this matrix.
+
+        Parameters
+        ----------
+        reset : bool
+            If True, the counts are zeroed after being read.
+
+        Returns
+        -------
+        dict
+            'structure_builds' count of times the PETSc matrix was created,
+            'assemblies' count of times its values were assembled, and
+            'reused' count of times its values were reused (see
+            assembleOnce).
+
+        Example
+        -------
+        >>> import underworld as uw
+        >>> mesh = uw.mesh.FeMesh_Cartesian("Q1/dQ0", (4,4))
+        >>> velocity = mesh.add_variable(2)
+        >>> pressure = mesh.subMesh.add_variable(1)
+        >>> walls = mesh.specialSets["AllWalls_VertexSet"]
+        >>> bcs = uw.conditions.DirichletCondition(velocity, (walls,walls))
+        >>> stokes = uw.systems.Stokes(velocity, pressure, 1., (0.,1.), conditions=bcs)
+        >>> solver = uw.systems.Solver(stokes)
+        >>> solver.solve()
+        >>> solver.solve()
+        >>> info = stokes._kmatrix.assembly_info()
+        >>> info["structure_builds"], info["assemblies"], info["reused"]
+        (1, 2, 0)
+        >>> info = stokes._gmatrix.assembly_info()
+        >>> info["structure_builds"], info["assemblies"], info["reused"]
+        (1, 1, 1)
+
+        """
+        stgfem = libUnderworld.StgFEM
+        return _stgermain.ReadStats( self._cself,
+                                     { "structure_builds" : stgfem.StiffnessMatrix_GetStructureCount,
+                                       "assemblies"       : stgfem.StiffnessMatrix_GetAssemblyCount,
+                                       "reused"           : stgfem.StiffnessMatrix_GetReuseCount },
+                                     stgfem.StiffnessMatrix_ResetStats, reset )
+
     def _add_to_stg_dict(self,componentDictionary):
         # call parents method
         super(AssembledMatrix,self)._add_to_stg_dict(componentDictionary)
@@ -78,6 +167,10 @@ class AssembledMatrix(_stgermain.StgCompoundComponent):
             componentDictionary[ self._matrix.name ]["assembleOnNodes"] = "False"
         else:
             componentDictionary[ self._matrix.name ]["assembleOnNodes"] = "True"
+        componentDictionary[ self._matrix.name ]["threadedAssembly"] = str(self.threadedAssembly)
+        componentDictionary[ self._matrix.name ]["matrixFree"] = str(self.matrixFree)
+        componentDictionary[ self._matrix.name ]["reuseStructure"] = str(self.reuseStructure)
+        componentDictionary[ self._matrix.name ]["assembleOnce"] = str(self.assembleOnce)
 
 
 #    def _setup(self):
@@ -16,14 +16,29 @@ class AssembledVector(SolutionVector):
     Vector object, generally assembled as a result of the FEM
     framework.
     
-    See parent class for parameters.
+    See parent class for further parameters.
+
+    Parameters
+    ----------
+    threadedAssembly: bool
+        If True, element vectors are evaluated concurrently where
+        underworld is built with OpenMP and all assembly terms support
+        it. Functions used within terms must then not be stateful
+        (for example, min_max). Terms whose functions build shared
+        state as they are evaluated (swarm variables evaluated by
+        nearest neighbour, or mapped to an integration swarm which
+        does not mirror their swarm) are assembled serially.
 
     """
     _objectsDict = { "_vector": "ForceVector" }
     _selfObjectName = "_vector"
 
 
-    def __init__(self, meshVariable, eqNum, **kwargs):
+    def __init__(self, meshVariable, eqNum, threadedAssembly=False, **kwargs):
+        if not isinstance( threadedAssembly, bool ):
+            raise TypeError("'threadedAssembly' must be of type 'bool'.")
+        self.threadedAssembly = threadedAssembly
+
         super(AssembledVector,self).__init__(meshVariable, eqNum, **kwargs)
 
     @property
@@ -43,6 +58,7 @@ class AssembledVector(SolutionVector):
         super(AssembledVector,self)._add_to_stg_dict(componentDictionary)
         #
         componentDictionary[ self._vector.name ][       "dim"] = self._meshVariable.mesh.generator.dim
+        componentDictionary[ self._vector.name ]["threadedAssembly"] = str(self.threadedAssembly)
 
 #    def _setup(self):
 #        # add terms to vector
@@ -45,3 +45,34 @@ class EqNumber(_stgermain.StgClass):
     @property
     def meshVariable(self):
         return self._meshVariable
+
+    def renumber(self):
+        """
+        Brings the equation numbering up to date after the boundary
+        condition index sets of the mesh variable have been modified.
+        Only processes whose conditions changed recount their equations,
+        while the others shift their range of equation numbers. Matrices
+        and vectors using this numbering are resized when next assembled.
+        Must be called collectively.
+
+        Returns
+        -------
+        bool
+            True if the numbering changed on any process.
+
+        Example
+        -------
+        >>> import underworld as uw
+        >>> mesh = uw.mesh.FeMesh_Cartesian( elementRes=(4,4) )
+        >>> tField = uw.mesh.MeshVariable( mesh, 1 )
+        >>> walls = mesh.specialSets["MinJ_VertexSet"]
+        >>> tbcs = uw.conditions.DirichletCondition( tField, walls )
+        >>> uw.libUnderworld.StgFEM.FeVariable_SetBC( tField._cself, tbcs._cself )
+        >>> teqNum = uw.systems.sle.EqNumber( tField )
+        >>> teqNum.renumber()
+        False
+        >>> walls += mesh.specialSets["MaxJ_VertexSet"]
+        >>> teqNum.renumber()
+        True
+        """
+        return bool(uw.libUnderworld.StgFEM.FeEquationNumber_Renumber( self._cself ))
@@ -18,7 +18,10 @@ from ._utils import SavedFileData
 from ._utils import _createMeshName, _spacetimeschema, _fieldschema, _swarmspacetimeschema, _swarmvarschema, _xdmfheader, _xdmffooter, _nps_2norm
 from ._utils import is_kernel
 from ._meshvariable_projection import MeshVariable_Projection, SolveLinearSystem
+from ._redistribute import redistribute_meshvariable, redistribute_swarm
+from ._memory import memory_accounting, memory_info
 from . import _io
+from ._io import checkpoint_wait, checkpoint_staging, checkpoint_info
 
 def _run_from_ipython():
     """
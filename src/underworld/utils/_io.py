@@ -18,15 +18,28 @@ required behaviour:
 2 - collective
 
 You may alternatively set the `PATTERN` module variable directly.
+
+Datasets may also be written asynchronously (see `h5_write_async`). The file
+and its dataset are created by the root process, after which each process's
+rows are copied to a staging area and written into the file by a background
+thread while computation continues. Use `checkpoint_wait` to complete writes.
+Files opened through `h5File` first wait for any outstanding writes to them.
 """
 
 
 import underworld as uw
 import h5py
 from mpi4py import MPI
+import numpy as np
 import os
 PATTERN = int(os.getenv('UW_IO_PATTERN', 0))
 
+# Largest block passed to the background writer in one call.
+_ASYNC_BLOCK_BYTES = 1 << 30
+# Set once any asynchronous write has been made. Writes are collective, so this
+# agrees across processes.
+_async_used = False
+
 class h5File(uw.mpi.call_pattern):
     """
     This class provides a context manager for h5py file lifecycle management. The
@@ -82,6 +95,9 @@ class h5File(uw.mpi.call_pattern):
 
         super(h5File, self).__init__(pattern=pattern)
 
+        # complete any background writes to the file before it is reopened
+        _async_fence(kwargs["name"] if "name" in kwargs else args[0])
+
     def __enter__(self):
         # Call parent __enter__.  This will effect the
         # sequential/collective behaviour.
@@ -188,3 +204,174 @@ def h5_get_dataset(h5f, name):
     if not hasattr(dset, "collective") or (h5f.driver!="mpio"):
         dset.__class__ = _PatchedDataset
     return dset
+
+
+def _async_fence(filename):
+    """
+    Waits for background writes to the file on all processes. Must be called
+    collectively.
+    """
+    if _async_used:
+        uw.libUnderworld.StGermain.AsyncWriter_WaitFor(os.path.abspath(filename))
+        uw.mpi.barrier()
+
+def h5_write_async(filename, name, shape, data, rows, attrs=None, links=None):
+    """
+    Writes a two dimensional dataset to a new file in the background. The root
+    process creates the file, with the dataset stored contiguously and its space
+    allocated, along with any attributes and external links. Each process then
+    stages its rows, which are written directly into the dataset's space once
+    the call returns. Must be called collectively.
+
+    Parameters
+    ----------
+    filename: str
+        File to create. Any existing file is replaced.
+    name: str
+        Name for the dataset.
+    shape: tuple
+        Global shape of the dataset.
+    data: numpy.ndarray
+        The local rows. These are copied before the call returns.
+    rows: numpy.ndarray
+        The global row index of each local row.
+    attrs: dict
+        Attributes for the file.
+    links: dict
+        Names to (filename, path) pairs, to be created as external links.
+    """
+    global _async_used
+    _async_used = True
+    path = os.path.abspath(filename)
+    data = np.asarray(data)
+    dtype = data.dtype.newbyteorder("=")
+
+    # the file is about to be replaced, so earlier writes to it must complete
+    _async_fence(filename)
+    offset = None
+    error = None
+    if uw.mpi.rank == 0:
+        try:
+            with h5py.File(filename, "w") as h5f:
+                dcpl = h5py.h5p.create(h5py.h5p.DATASET_CREATE)
+                dcpl.set_layout(h5py.h5d.CONTIGUOUS)
+                dcpl.set_alloc_time(h5py.h5d.ALLOC_TIME_EARLY)
+                dcpl.set_fill_time(h5py.h5d.FILL_TIME_NEVER)
+                space = h5py.h5s.create_simple(tuple(shape))
+                dsid = h5py.h5d.create(h5f.id, name.encode(), h5py.h5t.py_create(dtype), space, dcpl=dcpl)
+                offset = dsid.get_offset()
+                for key, val in (attrs or {}).items():
+                    h5f.attrs[key] = val
+                for key, (target, targetPath) in (links or {}).items():
+                    h5f[key] = h5py.ExternalLink(target, targetPath)
+        except Exception as e:
+            error = str(e)
+    offset, error = uw.mpi.comm.bcast((offset, error), root=0)
+    if error is not None:
+        raise RuntimeError("Unable to create file '{}' for writing: {}".format(filename, error))
+
+    rows = np.asarray(rows, dtype=np.int64).reshape(-1)
+    if len(rows) == 0 or offset is None:
+        return
+    # order rows by position in the file, and write each contiguous run as a segment
+    order = np.argsort(rows, kind="stable")
+    rows = rows[order]
+    data = np.ascontiguousarray(data.reshape(len(rows),-1)[order], dtype=dtype)
+    rowBytes = data.strides[0]
+    breaks = np.nonzero(np.diff(rows) != 1)[0] + 1
+    starts = np.concatenate(([0], breaks))
+    ends   = np.concatenate((breaks, [len(rows)]))
+    # split into blocks of a bounded size
+    maxRows = max(1, _ASYNC_BLOCK_BYTES // rowBytes)
+    segments = [ (ss, min(ss+maxRows, ee)) for ss0, ee in zip(starts, ends) for ss in range(ss0, ee, maxRows) ]
+    raw = data.reshape(-1).view(np.uint8)
+    first = 0
+    while first < len(segments):
+        last = first
+        while last < len(segments) and segments[last][1] - segments[first][0] <= maxRows:
+            last += 1
+        block = segments[first:last]
+        offsets = np.array([ offset + rows[ss]*rowBytes for ss, ee in block ], dtype=np.int64)
+        lengths = np.array([ (ee - ss)*rowBytes for ss, ee in block ], dtype=np.int64)
+        if not uw.libUnderworld.StGermain.AsyncWriter_Write(path, raw[block[0][0]*rowBytes:block[-1][1]*rowBytes],
+                                                              offsets, lengths):
+            raise RuntimeError("Unable to stage data for writing to '{}'.".format(filename))
+        first = last
+
+def checkpoint_wait():
+    """
+    Completes all background writes made with `asynchronous=True`, on all
+    processes. Files written asynchronously are complete once this returns.
+    Must be called collectively.
+
+    Example
+    -------
+    >>> import underworld as uw
+    >>> mesh = uw.mesh.FeMesh_Cartesian(elementRes=(8,8))
+    >>> var = mesh.add_variable(1)
+    >>> var.data[:,0] = mesh.data[:,0]
+    >>> handle = var.save("async_var.h5", asynchronous=True)
+    >>> var.data[:] = 0.
+    >>> uw.utils.checkpoint_wait()
+    >>> var.load("async_var.h5")
+    >>> import numpy as np
+    >>> np.allclose(var.data[:,0], mesh.data[:,0])
+    True
+    >>> if uw.mpi.rank == 0:
+    ...     import os
+    ...     os.remove("async_var.h5")
+
+    """
+    errors = uw.libUnderworld.StGermain.AsyncWriter_Wait()
+    errors = uw.mpi.comm.allreduce(errors)
+    if errors:
+        raise RuntimeError("{} background write(s) failed.".format(errors))
+
+def checkpoint_staging(capacity):
+    """
+    Sets the maximum number of bytes each process holds staged for background
+    writing. Once full, further asynchronous writes wait for earlier writes to
+    complete. The default is 1GB.
+
+    Parameters
+    ----------
+    capacity : int
+        Staging capacity in bytes.
+    """
+    if not isinstance(capacity, int) or capacity < 0:
+        raise TypeError("'capacity' must be a non-negative integer.")
+    uw.libUnderworld.StGermain.AsyncWriter_SetCapacity(capacity)
+
+def checkpoint_info(reset=False):
+    """
+    Returns statistics of the background writes on the local process.
+
+    Parameters
+    ----------
+    reset : bool
+        If True, the written bytes and blocked time are reset after being read.
+
+    Returns
+    -------
+    dict
+        'staged' bytes and 'pending' blocks not yet written, staging
+        'capacity', bytes 'written', and 'blocked' seconds spent waiting for
+        staging capacity.
+
+    Example
+    -------
+    >>> import underworld as uw
+    >>> info = uw.utils.checkpoint_info()
+    >>> sorted(info.keys())
+    ['blocked', 'capacity', 'pending', 'staged', 'written']
+
+    """
+    stg = uw.libUnderworld.StGermain
+    info = { "staged"   : stg.AsyncWriter_GetStagedBytes(),
+             "pending"  : stg.AsyncWriter_GetPendingCount(),
+             "capacity" : stg.AsyncWriter_GetCapacity(),
+             "written"  : stg.AsyncWriter_GetWrittenBytes(),
+             "blocked"  : stg.AsyncWriter_GetBlockedTime() }
+    if reset:
+        stg.AsyncWriter_ResetStats()
+    return info
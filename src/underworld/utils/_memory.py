@@ -0,0 +1,83 @@
+##~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~##
+##                                                                                   ##
+##  This file forms part of the Underworld geophysics modelling application.         ##
+##                                                                                   ##
+##  For full license and copyright information, please refer to the LICENSE.md file  ##
+##  located at the project root, or contact the authors.                             ##
+##                                                                                   ##
+##~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~##
+"""
+Routines to query the memory used by Underworld's native objects and arrays,
+grouped by allocation type. Accounting is disabled by default, and may be
+enabled with memory_accounting(), by setting the 'UW_MEMORY_ACCOUNTING'
+environment variable before importing underworld, or by building with the
+'UW_ENABLE_MEMORY_ACCOUNTING' CMake option. Only allocations made while
+accounting is enabled are recorded. Memory held by PETSc and numpy is not
+included.
+"""
+import underworld.libUnderworld as libUnderworld
+
+def memory_accounting(enable=True):
+    """
+    Enables or disables the recording of native allocations. Allocations
+    already recorded continue to be accounted for when released.
+
+    Parameters
+    ----------
+    enable : bool
+        Whether new allocations are recorded.
+
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("'enable' must be of type 'bool'.")
+    libUnderworld.StGermain.MemoryAccounting_Enable(enable)
+
+def memory_info(top=10, reset_peaks=False):
+    """
+    Returns the native memory usage recorded on the local process. Comparing
+    the 'current' values across timesteps is a cheap way of detecting leaks.
+
+    Parameters
+    ----------
+    top : int
+        Number of types to report, largest current usage first. Use None for
+        all types.
+    reset_peaks : bool
+        If True, the peak values are set to the current values after being
+        read.
+
+    Returns
+    -------
+    dict
+        'enabled' state, total 'current' and 'peak' bytes, and 'types', a
+        list of (name, current bytes, peak bytes, allocation count) tuples.
+
+    Example
+    -------
+    >>> import underworld as uw
+    >>> uw.utils.memory_accounting(True)
+    >>> mesh = uw.mesh.FeMesh_Cartesian(elementRes=(16,16))
+    >>> info = uw.utils.memory_info(top=5)
+    >>> info["current"] > 0, len(info["types"]) <= 5
+    (True, True)
+    >>> uw.utils.memory_accounting(False)
+
+    """
+    if top is not None and (not isinstance(top, int) or top < 0):
+        raise TypeError("'top' must be a non-negative integer, or None.")
+    stg = libUnderworld.StGermain
+    types = []
+    for ii in range(stg.MemoryAccounting_GetTypeCount()):
+        current = stg.MemoryAccounting_GetTypeCurrentBytes(ii)
+        peak    = stg.MemoryAccounting_GetTypePeakBytes(ii)
+        if peak:
+            types.append( (stg.MemoryAccounting_GetTypeName(ii), current, peak,
+                           stg.MemoryAccounting_GetTypeAllocationCount(ii)) )
+    types.sort(key=lambda item: item[1], reverse=True)
+    info = { "enabled" : bool(stg.MemoryAccounting_IsEnabled()),
+             "current" : stg.MemoryAccounting_GetCurrentBytes(),
+             "peak"    : stg.MemoryAccounting_GetPeakBytes(),
+             "types"   : types[:top] if top is not None else types }
+    if reset_peaks:
+        stg.MemoryAccounting_ResetPeaks()
+    return info
@@ -0,0 +1,188 @@
+##~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~##
+##                                                                                   ##
+##  This file forms part of the Underworld geophysics modelling application.         ##
+##                                                                                   ##
+##  For full license and copyright information, please refer to the LICENSE.md file  ##
+##  located at the project root, or contact the authors.                             ##
+##                                                                                   ##
+##~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~#~##
+"""
+Routines for moving data between two meshes (or swarms) which share the same
+global element layout but differ in their parallel decomposition. These are
+used together with FeMesh_Cartesian.balanced_decomposition() to rebalance a
+model: a new mesh is constructed with the balanced decomposition, and existing
+mesh variables and swarms are copied across.
+"""
+import underworld as uw
+import numpy as np
+from underworld.mesh._mesh import _decomposition_owners
+
+def _geometry_mesh(mesh):
+    """
+    Returns the cartesian mesh which defines the element layout of the
+    provided mesh (itself, or the geometry mesh of a sub-mesh).
+    """
+    if isinstance(mesh, uw.mesh.FeMesh_Cartesian):
+        return mesh
+    generator = mesh.generator
+    if isinstance(generator, uw.mesh._mesh.TemplatedMeshGenerator) and isinstance(generator.geometryMesh, uw.mesh.FeMesh_Cartesian):
+        return generator.geometryMesh
+    raise TypeError("Redistribution is only supported for meshes of type 'FeMesh_Cartesian' and their sub-meshes.")
+
+def _local_element_owners(mesh, decomposition):
+    """
+    Returns the process owning each local element of 'mesh' under the provided
+    decomposition.
+    """
+    geometry = _geometry_mesh(mesh)
+    gIds = mesh.data_elgId[0:mesh.elementsLocal].astype(np.int64)
+    ijk  = np.empty((len(gIds),geometry.dim), dtype=np.int64)
+    for dd in range(geometry.dim):
+        ijk[:,dd] = gIds % geometry.elementRes[dd]
+        gIds      = gIds // geometry.elementRes[dd]
+    return _decomposition_owners(decomposition, ijk)
+
+def _check_compatible(sourceMesh, targetMesh):
+    sourceGeometry = _geometry_mesh(sourceMesh)
+    targetGeometry = _geometry_mesh(targetMesh)
+    if tuple(sourceGeometry.elementRes) != tuple(targetGeometry.elementRes):
+        raise ValueError("Source and target meshes must have the same element resolution.")
+    if sourceMesh.elementType != targetMesh.elementType:
+        raise ValueError("Source and target meshes must have the same element type.")
+    if sourceMesh.elementsGlobal != targetMesh.elementsGlobal:
+        raise ValueError("Source and target meshes must have the same number of elements.")
+    return targetGeometry._current_decomposition()
+
+def redistribute_meshvariable(source, target):
+    """
+    Copies nodal data from 'source' into 'target', where the two are defined on
+    meshes which differ only in their parallel decomposition. Where 'source'
+    and 'target' are meshes, the mesh vertex coordinates are copied, which is
+    required for deformed meshes.
+
+    Every process sends the nodes of each of its local elements to the process
+    which owns that element in the target decomposition. The target shadow
+    space is then syncronised. This function must be called collectively.
+
+    Parameters
+    ----------
+    source : underworld.mesh.MeshVariable, underworld.mesh.FeMesh_Cartesian
+        Object to copy data from.
+    target : underworld.mesh.MeshVariable, underworld.mesh.FeMesh_Cartesian
+        Object to copy data into.
+
+    Example
+    -------
+    >>> mesh = uw.mesh.FeMesh_Cartesian( elementRes=(8,8) )
+    >>> var  = mesh.add_variable(1)
+    >>> var.data[:,0] = mesh.data[:,0]
+    >>> decomposition, info = mesh.balanced_decomposition()
+    >>> newMesh = uw.mesh.FeMesh_Cartesian( elementRes=(8,8), decomposition=decomposition )
+    >>> newVar  = newMesh.add_variable(1)
+    >>> uw.utils.redistribute_meshvariable(mesh, newMesh)
+    >>> uw.utils.redistribute_meshvariable(var, newVar)
+    >>> np.allclose(newVar.data[:,0], newMesh.data[:,0])
+    True
+
+    """
+    isMesh = isinstance(source, uw.mesh.FeMesh)
+    if isMesh != isinstance(target, uw.mesh.FeMesh):
+        raise TypeError("'source' and 'target' must both be meshes or both be mesh variables.")
+    if isMesh:
+        sourceMesh, targetMesh = source, target
+    else:
+        if not isinstance(source, uw.mesh.MeshVariable) or not isinstance(target, uw.mesh.MeshVariable):
+            raise TypeError("'source' and 'target' must be of type 'underworld.mesh.MeshVariable'.")
+        if source.nodeDofCount != target.nodeDofCount:
+            raise ValueError("Source and target mesh variables must have the same nodeDofCount.")
+        sourceMesh, targetMesh = source.mesh, target.mesh
+    decomposition = _check_compatible(sourceMesh, targetMesh)
+
+    data     = source.data
+    owners   = _local_element_owners(sourceMesh, decomposition)
+    elNodes  = sourceMesh.data_elementNodes
+    nodegIds = sourceMesh.data_nodegId
+    order    = np.argsort(nodegIds)
+
+    sends = []
+    for proc in range(uw.mpi.size):
+        gIds  = np.unique(elNodes[owners == proc])
+        local = order[np.searchsorted(nodegIds, gIds, sorter=order)]
+        sends.append( (gIds, data[local]) )
+    recvs = uw.mpi.comm.alltoall(sends)
+
+    gIds = np.concatenate([ item[0] for item in recvs ])
+    vals = np.concatenate([ item[1] for item in recvs ])
+    gIds, first = np.unique(gIds, return_index=True)
+    vals = vals[first]
+
+    nLocal     = targetMesh.nodesLocal
+    targetgIds = targetMesh.data_nodegId[0:nLocal]
+    pos = np.searchsorted(gIds, targetgIds)
+    if np.any(pos >= len(gIds)) or np.any(gIds[np.minimum(pos,len(gIds)-1)] != targetgIds):
+        raise RuntimeError("Redistribution did not provide values for all local nodes of the target.")
+
+    if isMesh:
+        with targetMesh.deform_mesh():
+            targetMesh.data[0:nLocal] = vals[pos]
+    else:
+        target.data[0:nLocal] = vals[pos]
+        target.syncronise()
+
+def redistribute_swarm(source, target, variables=()):
+    """
+    Moves the particles of 'source' into 'target', where the swarms are
+    supported by meshes which differ only in their parallel decomposition.
+    Each particle is sent to the process which owns its current element in the
+    target decomposition, and the data of each provided swarm variable pair is
+    carried with it. The target mesh should have the same vertex coordinates as
+    the source mesh (see redistribute_meshvariable()). This function must be
+    called collectively.
+
+    Parameters
+    ----------
+    source : underworld.swarm.Swarm
+        Swarm to copy particles from.
+    target : underworld.swarm.Swarm
+        Swarm to add particles to.
+    variables : list
+        List of (sourceVariable, targetVariable) swarm variable pairs.
+
+    Returns
+    -------
+    int
+        Global number of particles which could not be placed in the target
+        swarm. This should be zero.
+
+    """
+    if not isinstance(source, uw.swarm.Swarm) or not isinstance(target, uw.swarm.Swarm):
+        raise TypeError("'source' and 'target' must be of type 'underworld.swarm.Swarm'.")
+    for pair in variables:
+        if len(pair) != 2:
+            raise TypeError("'variables' must be a list of (sourceVariable, targetVariable) pairs.")
+        if pair[0].swarm is not source or pair[1].swarm is not target:
+            raise ValueError("'variables' pairs must belong to the source and target swarms respectively.")
+        if pair[0].count != pair[1].count:
+            raise ValueError("Swarm variable pairs must have the same count.")
+    decomposition = _check_compatible(source.mesh, target.mesh)
+
+    nParticles = source.particleLocalCount
+    cells  = source.owningCell.data[0:nParticles].ravel()
+    owners = _local_element_owners(source.mesh, decomposition)[cells]
+    coords = source.particleCoordinates.data[0:nParticles]
+    values = [ pair[0].data[0:nParticles] for pair in variables ]
+
+    sends = []
+    for proc in range(uw.mpi.size):
+        mask = owners == proc
+        sends.append( (coords[mask], [ val[mask] for val in values ]) )
+    recvs = uw.mpi.comm.alltoall(sends)
+
+    coords = np.concatenate([ item[0] for item in recvs ])
+    values = [ np.concatenate([ item[1][ii] for item in recvs ]) for ii in range(len(variables)) ]
+    indices = target.add_particles_with_coordinates(coords)
+    placed  = indices >= 0
+    for pair, val in zip(variables, values):
+        pair[1].data[indices[placed]] = val[placed]
+
+    return uw.mpi.comm.allreduce(int(np.count_nonzero(~placed)))
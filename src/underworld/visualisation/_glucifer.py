@@ -76,6 +76,13 @@ class Store(_stgermain.StgCompoundComponent):
         Set to true and pass filename if loading a saved database for re-visualisation
     compress: bool
         Set to true to enable database compression.
+    sharded: bool
+        Set to true for each process to write its own geometry to a shard file,
+        with the root process writing only a manifest of the shards. Use merge()
+        to combine the shards into a single database for viewing.
+    aggregate: bool
+        Set to true with sharded for the processes on each node to gather their
+        geometry to the first of them, which writes a single shard for the node.
 
     Example
     -------
@@ -115,7 +122,7 @@ class Store(_stgermain.StgCompoundComponent):
     _selfObjectName = "_db"
     viewer = None
 
-    def __init__(self, filename=None, split=False, compress=True, **kwargs):
+    def __init__(self, filename=None, split=False, compress=True, sharded=False, aggregate=False, **kwargs):
 
         self.step = 0
         if filename is None:
@@ -128,6 +135,8 @@ class Store(_stgermain.StgCompoundComponent):
         if not self.filename: split = False
         self._split = split
         self.compress = compress
+        self._sharded = sharded
+        self._aggregate = aggregate
         super(Store,self).__init__(**kwargs)
 
     def _add_to_stg_dict(self,componentDictionary):
@@ -150,6 +159,8 @@ class Store(_stgermain.StgCompoundComponent):
                             "splitTransactions" :True,
                             "singleFile"        :not self._split,
                             "compressed"        :self.compress,
+                            "sharded"           :self._sharded,
+                            "aggregate"         :self._aggregate,
         } )
 
     def save(self,filename):
@@ -166,10 +177,54 @@ class Store(_stgermain.StgCompoundComponent):
                 raise TypeError("Provided parameter 'filename' must be of type 'str'. ")
             if not filename.lower().endswith('.gldb') and not filename.lower().endswith('.db'):
                 filename += '.gldb'
+            if self._sharded:
+                return self.merge(filename)
             if filename != self.filename:
                 libUnderworld.gLucifer.lucDatabase_BackupDbFile(self._db, filename)
             return filename
 
+    def merge(self, filename=None):
+        """
+        Merges the shards of a sharded store into a single database, as read by
+        the viewer. The shards are left in place. Only the root process merges.
+
+        Parameters
+        ----------
+        filename :str
+            Filename to save the merged database to. Defaults to the store
+            filename with a '_merged' suffix.
+
+        Returns
+        -------
+        filename: str
+            The merged database filename, on the root process only.
+        """
+        if uw.mpi.rank > 0:
+            return
+        if not self._sharded:
+            raise RuntimeError("Only sharded stores are merged, use save() instead.")
+        manifest = self._db.path
+        if filename is None:
+            filename = os.path.splitext(manifest)[0] + "_merged.gldb"
+        elif not filename.lower().endswith('.gldb') and not filename.lower().endswith('.db'):
+            filename += '.gldb'
+
+        import sqlite3
+        src = sqlite3.connect(manifest)
+        dst = sqlite3.connect(filename)
+        src.backup(dst)
+        src.close()
+        #Shard paths are relative to the manifest
+        folder = os.path.dirname(manifest)
+        columns = ", ".join(row[1] for row in dst.execute("pragma table_info(geometry)") if row[1] != "id")
+        for (path,) in dst.execute("select distinct path from shard").fetchall():
+            dst.execute("attach database ? as part", (os.path.join(folder, path),))
+            dst.execute("insert into geometry ({0}) select {0} from part.geometry".format(columns))
+            dst.commit()
+            dst.execute("detach database part")
+        dst.close()
+        return filename
+
     def lvget(self):
         #Get existing viewer, if any, otherwuse create one
         if not self.viewer:
@@ -179,7 +234,7 @@ class Store(_stgermain.StgCompoundComponent):
     def lvrun(self, db=None, *args, **kwargs):
         #Create and execute a new viewer with passed args
         if not db:
-            db = self._db.path
+            db = self.merge() if self._sharded else self._db.path
         if 'UW_VIS_PORT' in os.environ:
             kwargs['port'] = int(os.environ['UW_VIS_PORT'])
         self.viewer = lavavu.Viewer(cache=False, clearstep=True, database=db, timestep=self.step, *args, **kwargs)
@@ -614,18 +614,25 @@ class Points(Drawing):
     fn_size : underworld.function.Function
         Function used to determine size to render particle.
         This function should return float/double values.
+    maxPoints : int
+        Level of detail. When set, every n'th particle on each process is drawn,
+        so that about this many particles are drawn in total.
         
 
     """
     _objectsDict = { "_dr": "lucSwarmViewer" }
 
     def __init__(self, swarm, fn_colour=None, fn_mask=None, fn_size=None, colourVariable=None,
-                       colourBar=True, *args, **kwargs):
+                       colourBar=True, maxPoints=None, *args, **kwargs):
 
         if not isinstance(swarm,_swarmMod.Swarm):
             raise TypeError("'swarm' object passed in must be of type 'Swarm'")
         self._swarm = swarm
 
+        if maxPoints is not None and (not isinstance(maxPoints, int) or maxPoints < 1):
+            raise TypeError("'maxPoints' parameter must be a positive integer.")
+        self._maxPoints = maxPoints if maxPoints else 0
+
         self._fn_colour = None
         if fn_colour != None:
            self._fn_colour = _underworld.function.Function.convert(fn_colour)
@@ -647,6 +654,7 @@ class Points(Drawing):
         super(Points,self)._add_to_stg_dict(componentDictionary)
 
         componentDictionary[ self._cself.name ][ "Swarm" ] = self._swarm._cself.name
+        componentDictionary[ self._cself.name ][ "maxPoints" ] = self._maxPoints
         
     def _setup(self):
         fnc_ptr = None